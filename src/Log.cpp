@@ -30,8 +30,11 @@
 */
 #include "Log.h"
 #include "network/Network.h"
+#include "MPSCQueue.h"
+#include "Thread.h"
 
 #include <sys/time.h>
+#include <unistd.h>
 
 #if defined(CATCH2_TEST_COMPILATION)
 #include <catch2/catch_test_macros.hpp>
@@ -43,6 +46,11 @@
 #include <ctime>
 #include <cassert>
 #include <cstring>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 
 // ---------------------------------------------------------------------------
 //  Constants
@@ -53,6 +61,44 @@
 const uint32_t ACT_LOG_BUFFER_LEN = 501U;
 const uint32_t LOG_BUFFER_LEN = 4096U;
 
+const uint32_t LOG_ASYNC_QUEUE_LEN = 2048U;
+const uint32_t LOG_ASYNC_RECORD_LEN = 512U;
+const uint32_t LOG_ASYNC_BATCH_LEN = 16384U;
+const uint32_t LOG_ASYNC_FLUSH_MS = 50U;
+
+const uint8_t LOG_DEST_FILE = 0x01U;
+const uint8_t LOG_DEST_ACT_FILE = 0x02U;
+const uint8_t LOG_DEST_STDOUT = 0x04U;
+
+// ---------------------------------------------------------------------------
+//  Structure Declaration
+//      Preformatted log entry waiting for the asynchronous log writer.
+// ---------------------------------------------------------------------------
+
+struct LogRecord {
+    uint8_t dest;
+    uint32_t length;
+    char text[LOG_ASYNC_RECORD_LEN];
+    char* longText;                                 // entries that don't fit in text are allocated
+};
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+//      Implements the asynchronous log writer thread.
+// ---------------------------------------------------------------------------
+
+class LogWriter : public Thread {
+public:
+    /// <summary>Initializes a new instance of the LogWriter class.</summary>
+    LogWriter(MPSCQueue<LogRecord>& queue) : Thread(), m_queue(queue) { /* stub */ }
+
+    /// <summary>Asynchronous log writer thread main.</summary>
+    void entry() override;
+
+private:
+    MPSCQueue<LogRecord>& m_queue;
+};
+
 // ---------------------------------------------------------------------------
 //  Global Variables
 // ---------------------------------------------------------------------------
@@ -78,6 +124,16 @@ static std::ostream m_outStream{std::cerr.rdbuf()};
 
 static char LEVELS[] = " DMIWEF";
 
+static MPSCQueue<LogRecord>* m_asyncQueue = nullptr;
+static LogWriter* m_asyncWriter = nullptr;
+static std::atomic<bool> m_asyncEnabled{false};
+static std::atomic<bool> m_asyncRunning{false};
+static std::atomic<uint32_t> m_asyncDropped{0U};
+
+static std::mutex m_asyncMutex;
+static std::condition_variable m_asyncWake;
+static std::atomic<bool> m_asyncSleeping{false};
+
 // ---------------------------------------------------------------------------
 //  Global Functions
 // ---------------------------------------------------------------------------
@@ -146,6 +202,220 @@ static bool ActivityLogOpen()
     return m_actFpLog != nullptr;
 }
 
+/// <summary>
+/// Helper to format the level, time and module prefix of a log entry.
+/// </summary>
+/// <param name="buffer">Buffer to format the prefix into.</param>
+/// <param name="level">Log level.</param>
+/// <param name="module">Module name the log entry was generated from.</param>
+static void LogPrefix(char* buffer, uint32_t level, const char* module)
+{
+    if (!g_disableTimeDisplay) {
+        struct timeval now;
+        ::gettimeofday(&now, NULL);
+
+        struct tm* tm = ::gmtime(&now.tv_sec);
+
+        if (module != nullptr) {
+            ::sprintf(buffer, "%c: %04d-%02d-%02d %02d:%02d:%02d.%03lu (%s) ", LEVELS[level], tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour, tm->tm_min, tm->tm_sec, now.tv_usec / 1000U, module);
+        }
+        else {
+            ::sprintf(buffer, "%c: %04d-%02d-%02d %02d:%02d:%02d.%03lu ", LEVELS[level], tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour, tm->tm_min, tm->tm_sec, now.tv_usec / 1000U);
+        }
+    }
+    else {
+        if (module != nullptr) {
+            ::sprintf(buffer, "%c: (%s) ", LEVELS[level], module);
+        }
+        else {
+            if (level >= 9999U) {
+                ::sprintf(buffer, "U: ");
+            }
+            else {
+                ::sprintf(buffer, "%c: ", LEVELS[level]);
+            }
+        }
+    }
+}
+
+/// <summary>
+/// Helper to wake the asynchronous log writer if it is waiting for log entries.
+/// </summary>
+static void LogWakeWriter()
+{
+    // pairs with the fence in LogWriter::entry(), so either the writer sees the queued entry or this sees it waiting
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!m_asyncSleeping.load(std::memory_order_relaxed))
+        return;
+
+    std::lock_guard<std::mutex> lock(m_asyncMutex);
+    m_asyncSleeping = false;
+    m_asyncWake.notify_one();
+}
+
+/// <summary>
+/// Helper to queue a formatted log entry for the asynchronous log writer.
+/// </summary>
+/// <param name="dest">Destinations of the log entry.</param>
+/// <param name="buffer">Formatted log entry.</param>
+static void LogEnqueue(uint8_t dest, const char* buffer)
+{
+    uint32_t length = (uint32_t)::strlen(buffer);
+    bool ret = m_asyncQueue->tryPush([&](LogRecord& record) {
+        record.dest = dest;
+        record.length = length;
+        if (length <= LOG_ASYNC_RECORD_LEN) {
+            ::memcpy(record.text, buffer, length);
+            record.longText = nullptr;
+        }
+        else {
+            record.longText = new char[length];
+            ::memcpy(record.longText, buffer, length);
+        }
+    });
+
+    if (!ret) {
+        m_asyncDropped++;
+    }
+
+    LogWakeWriter();
+}
+
+/// <summary>
+/// Helper to write a whole buffer to a file descriptor.
+/// </summary>
+/// <param name="fd">File descriptor.</param>
+/// <param name="data">Data to write.</param>
+static void LogWriteAll(int fd, const std::string& data)
+{
+    const char* p = data.c_str();
+    size_t remaining = data.size();
+    while (remaining > 0U) {
+        ssize_t written = ::write(fd, p, remaining);
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            return;
+        }
+
+        p += written;
+        remaining -= (size_t)written;
+    }
+}
+
+/// <summary>
+/// Asynchronous log writer thread main.
+/// </summary>
+void LogWriter::entry()
+{
+    std::string logBatch, actBatch, outBatch;
+    logBatch.reserve(LOG_ASYNC_BATCH_LEN * 2U);
+    actBatch.reserve(LOG_ASYNC_BATCH_LEN);
+    outBatch.reserve(LOG_ASYNC_BATCH_LEN * 2U);
+
+    uint32_t reportedDropped = m_asyncDropped.load();
+    std::chrono::steady_clock::time_point oldest;
+
+    // writes out (and empties) the batches; the log files are opened (or rotated) here as well
+    auto flush = [&]() {
+        if (!logBatch.empty()) {
+            if (::LogOpen() && m_fpLog != nullptr)
+                LogWriteAll(::fileno(m_fpLog), logBatch);
+            logBatch.clear();
+        }
+
+        if (!actBatch.empty()) {
+            if (::ActivityLogOpen() && m_actFpLog != nullptr)
+                LogWriteAll(::fileno(m_actFpLog), actBatch);
+            actBatch.clear();
+        }
+
+        if (!outBatch.empty()) {
+            LogWriteAll(STDOUT_FILENO, outBatch);
+            outBatch.clear();
+        }
+    };
+
+    auto append = [&](uint8_t dest, const char* text, uint32_t length) {
+        if (logBatch.empty() && actBatch.empty() && outBatch.empty())
+            oldest = std::chrono::steady_clock::now();
+
+        if ((dest & LOG_DEST_FILE) == LOG_DEST_FILE) {
+            logBatch.append(text, length);
+            logBatch += "\n";
+        }
+
+        if ((dest & LOG_DEST_ACT_FILE) == LOG_DEST_ACT_FILE) {
+            actBatch.append(text, length);
+            actBatch += "\n";
+        }
+
+        if ((dest & LOG_DEST_STDOUT) == LOG_DEST_STDOUT) {
+            outBatch.append(text, length);
+            outBatch += EOL;
+        }
+    };
+
+    while (true) {
+        bool running = m_asyncRunning.load();
+
+        bool popped = true;
+        while (popped) {
+            popped = m_queue.tryPop([&](LogRecord& record) {
+                append(record.dest, (record.longText != nullptr) ? record.longText : record.text, record.length);
+
+                delete[] record.longText;
+                record.longText = nullptr;
+            });
+
+            if (logBatch.size() >= LOG_ASYNC_BATCH_LEN || actBatch.size() >= LOG_ASYNC_BATCH_LEN || outBatch.size() >= LOG_ASYNC_BATCH_LEN) {
+                flush();
+            }
+        }
+
+        // report entries lost to a full queue in the log itself
+        uint32_t dropped = m_asyncDropped.load();
+        if (dropped != reportedDropped) {
+            char buffer[LOG_BUFFER_LEN];
+            LogPrefix(buffer, 4U, LOG_HOST);
+            ::sprintf(buffer + ::strlen(buffer), "log queue full, %u log entries dropped", dropped - reportedDropped);
+            reportedDropped = dropped;
+
+            uint8_t dest = 0U;
+            if (4U >= m_fileLevel && m_fileLevel != 0U)
+                dest |= LOG_DEST_FILE;
+            if (4U >= g_logDisplayLevel && g_logDisplayLevel != 0U)
+                dest |= LOG_DEST_STDOUT;
+            append(dest, buffer, (uint32_t)::strlen(buffer));
+        }
+
+        if (!running) {
+            flush();
+            if (m_queue.isEmpty())
+                break;
+            continue;
+        }
+
+        // wait for new entries, or until the oldest batched entry is due to be written
+        std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(LOG_ASYNC_FLUSH_MS);
+        if (!logBatch.empty() || !actBatch.empty() || !outBatch.empty()) {
+            deadline = oldest + std::chrono::milliseconds(LOG_ASYNC_FLUSH_MS);
+            if (std::chrono::steady_clock::now() >= deadline) {
+                flush();
+                continue;
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(m_asyncMutex);
+        m_asyncSleeping = true;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_queue.isEmpty() && m_asyncRunning.load()) {
+            m_asyncWake.wait_until(lock, deadline, [] { return !m_asyncSleeping.load(); });
+        }
+        m_asyncSleeping = false;
+    }
+}
+
 /// <summary>
 /// Internal helper to set an output stream to direct logging to.
 /// </summary>
@@ -233,6 +503,21 @@ void ActivityLog(const char *mode, const bool sourceRf, const char* msg, ...)
 
     va_end(vl);
 
+    if (m_asyncEnabled.load()) {
+        uint8_t dest = LOG_DEST_ACT_FILE;
+        if (2U >= m_fileLevel && m_fileLevel != 0U)
+            dest |= LOG_DEST_FILE;
+        if (2U >= g_logDisplayLevel && g_logDisplayLevel != 0U)
+            dest |= LOG_DEST_STDOUT;
+        ::LogEnqueue(dest, buffer);
+
+        if (m_network != nullptr) {
+            m_network->writeActLog(buffer);
+        }
+
+        return;
+    }
+
     bool ret = ::ActivityLogOpen();
     if (!ret)
         return;
@@ -285,6 +570,8 @@ void LogFinalise()
 #if defined(CATCH2_TEST_COMPILATION)
     return;
 #endif
+    ::LogStopAsync();
+
     if (m_fpLog != nullptr)
         ::fclose(m_fpLog);
 }
@@ -303,32 +590,7 @@ void Log(uint32_t level, const char *module, const char* fmt, ...)
     g_disableTimeDisplay = true;
 #endif
     char buffer[LOG_BUFFER_LEN];
-    if (!g_disableTimeDisplay) {
-        struct timeval now;
-        ::gettimeofday(&now, NULL);
-
-        struct tm* tm = ::gmtime(&now.tv_sec);
-
-        if (module != nullptr) {
-            ::sprintf(buffer, "%c: %04d-%02d-%02d %02d:%02d:%02d.%03lu (%s) ", LEVELS[level], tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour, tm->tm_min, tm->tm_sec, now.tv_usec / 1000U, module);
-        }
-        else {
-            ::sprintf(buffer, "%c: %04d-%02d-%02d %02d:%02d:%02d.%03lu ", LEVELS[level], tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour, tm->tm_min, tm->tm_sec, now.tv_usec / 1000U);
-        }
-    }
-    else {
-        if (module != nullptr) {
-            ::sprintf(buffer, "%c: (%s) ", LEVELS[level], module);
-        }
-        else {
-            if (level >= 9999U) {
-                ::sprintf(buffer, "U: ");
-            }
-            else {
-                ::sprintf(buffer, "%c: ", LEVELS[level]);
-            }
-        }
-    }
+    ::LogPrefix(buffer, level, module);
 
     va_list vl;
     va_start(vl, fmt);
@@ -353,23 +615,100 @@ void Log(uint32_t level, const char *module, const char* fmt, ...)
     return;
 #endif
 
-    if (level >= m_fileLevel && m_fileLevel != 0U) {
-        bool ret = ::LogOpen();
-        if (!ret)
-            return;
-
-        ::fprintf(m_fpLog, "%s\n", buffer);
-        ::fflush(m_fpLog);
+    if (m_asyncEnabled.load()) {
+        uint8_t dest = 0U;
+        if (level >= m_fileLevel && m_fileLevel != 0U)
+            dest |= LOG_DEST_FILE;
+        if (level >= g_logDisplayLevel && g_logDisplayLevel != 0U)
+            dest |= LOG_DEST_STDOUT;
+        if (dest != 0U)
+            ::LogEnqueue(dest, buffer);
     }
+    else {
+        if (level >= m_fileLevel && m_fileLevel != 0U) {
+            bool ret = ::LogOpen();
+            if (!ret)
+                return;
 
-    if (level >= g_logDisplayLevel && g_logDisplayLevel != 0U) {
-        ::fprintf(stdout, "%s" EOL, buffer);
-        ::fflush(stdout);
+            ::fprintf(m_fpLog, "%s\n", buffer);
+            ::fflush(m_fpLog);
+        }
+
+        if (level >= g_logDisplayLevel && g_logDisplayLevel != 0U) {
+            ::fprintf(stdout, "%s" EOL, buffer);
+            ::fflush(stdout);
+        }
     }
 
     // fatal error (specially allow any log levels above 9999)
     if (level >= 6U && level < 9999U) {
+        ::LogStopAsync();
         ::fclose(m_fpLog);
         exit(1);
     }
 }
+
+/// <summary>
+/// Starts the asynchronous log writer.
+/// </summary>
+/// <remarks>
+/// Once started, log entries are formatted on the calling thread and queued; a background
+/// thread batches them into the log files and the console. Start the writer after any
+/// fork(), as threads do not survive it.
+/// </remarks>
+/// <returns>True, if the log writer was started, otherwise false.</returns>
+bool LogStartAsync()
+{
+#if defined(CATCH2_TEST_COMPILATION)
+    return true;
+#endif
+    if (m_asyncWriter != nullptr)
+        return true;
+
+    // the queue is never freed; a late log call may still be pushing to it while the writer stops
+    if (m_asyncQueue == nullptr)
+        m_asyncQueue = new MPSCQueue<LogRecord>(LOG_ASYNC_QUEUE_LEN);
+
+    m_asyncRunning = true;
+    m_asyncWriter = new LogWriter(*m_asyncQueue);
+    if (!m_asyncWriter->run()) {
+        m_asyncRunning = false;
+        delete m_asyncWriter;
+        m_asyncWriter = nullptr;
+        return false;
+    }
+
+    m_asyncEnabled = true;
+    return true;
+}
+
+/// <summary>
+/// Stops the asynchronous log writer, writing out any queued log entries.
+/// </summary>
+void LogStopAsync()
+{
+    if (m_asyncWriter == nullptr)
+        return;
+
+    // new entries are written synchronously from here on; the writer drains what is queued
+    m_asyncEnabled = false;
+    m_asyncRunning = false;
+    {
+        std::lock_guard<std::mutex> lock(m_asyncMutex);
+        m_asyncSleeping = false;
+        m_asyncWake.notify_one();
+    }
+    m_asyncWriter->wait();
+
+    delete m_asyncWriter;
+    m_asyncWriter = nullptr;
+}
+
+/// <summary>
+/// Gets the count of log entries dropped because the asynchronous log queue was full.
+/// </summary>
+/// <returns></returns>
+uint32_t LogDroppedCount()
+{
+    return m_asyncDropped.load();
+}
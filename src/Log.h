@@ -92,4 +92,11 @@ extern HOST_SW_API void LogFinalise();
 /// <summary>Writes a new entry to the diagnostics log.</summary>
 extern HOST_SW_API void Log(uint32_t level, const char* module, const char* fmt, ...);
 
+/// <summary>Starts the asynchronous log writer.</summary>
+extern HOST_SW_API bool LogStartAsync();
+/// <summary>Stops the asynchronous log writer, writing out any queued log entries.</summary>
+extern HOST_SW_API void LogStopAsync();
+/// <summary>Gets the count of log entries dropped because the asynchronous log queue was full.</summary>
+extern HOST_SW_API uint32_t LogDroppedCount();
+
 #endif // __LOG_H__
@@ -0,0 +1,139 @@
+/**
+* Digital Voice Modem - Host Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software
+*
+*/
+/*
+*   Copyright (C) 2023 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#if !defined(__MPSC_QUEUE_H__)
+#define __MPSC_QUEUE_H__
+
+#include "Defines.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+//      Implements a bounded, lock-free, multi-producer single-consumer queue.
+//      Items are built and consumed in place in their cells; producers never
+//      block and a full queue simply rejects the push.
+// ---------------------------------------------------------------------------
+
+template<class T>
+class HOST_SW_API MPSCQueue {
+public:
+    /// <summary>Initializes a new instance of the MPSCQueue class.</summary>
+    /// <param name="length">Number of cells in the queue; must be a power of two.</param>
+    MPSCQueue(uint32_t length) :
+        m_cells(nullptr),
+        m_mask(length - 1U),
+        m_enqueuePos(0U),
+        m_dequeuePos(0U)
+    {
+        assert(length >= 2U && (length & (length - 1U)) == 0U);
+
+        m_cells = new Cell[length];
+        for (uint32_t i = 0U; i < length; i++) {
+            m_cells[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /// <summary>Finalizes a instance of the MPSCQueue class.</summary>
+    ~MPSCQueue()
+    {
+        delete[] m_cells;
+    }
+
+    /// <summary>Claims a cell, fills it with the given function and publishes it.</summary>
+    /// <param name="fill">Function that fills the claimed item in place.</param>
+    /// <returns>True, if the item was queued, otherwise false (the queue is full).</returns>
+    template<typename Fn>
+    bool tryPush(Fn fill)
+    {
+        size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &m_cells[pos & m_mask];
+            size_t seq = cell->seq.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+            if (diff == 0) {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1U, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0) {
+                return false;
+            }
+            else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        fill(cell->item);
+        cell->seq.store(pos + 1U, std::memory_order_release);
+        return true;
+    }
+
+    /// <summary>Passes the oldest item to the given function and releases its cell.</summary>
+    /// <remarks>Only a single thread may consume from the queue.</remarks>
+    /// <param name="consume">Function that consumes the item in place.</param>
+    /// <returns>True, if an item was consumed, otherwise false (the queue is empty).</returns>
+    template<typename Fn>
+    bool tryPop(Fn consume)
+    {
+        size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+        Cell* cell = &m_cells[pos & m_mask];
+        size_t seq = cell->seq.load(std::memory_order_acquire);
+        if ((intptr_t)seq - (intptr_t)(pos + 1U) < 0)
+            return false;
+
+        m_dequeuePos.store(pos + 1U, std::memory_order_relaxed);
+
+        consume(cell->item);
+        cell->seq.store(pos + m_mask + 1U, std::memory_order_release);
+        return true;
+    }
+
+    /// <summary>Flag indicating whether the queue is (momentarily) empty.</summary>
+    bool isEmpty() const
+    {
+        size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+        size_t seq = m_cells[pos & m_mask].seq.load(std::memory_order_acquire);
+        return (intptr_t)seq - (intptr_t)(pos + 1U) < 0;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> seq;
+        T item;
+    };
+
+    Cell* m_cells;
+    size_t m_mask;
+
+    // producers and the consumer work on different ends; keep them on separate cache lines
+    std::atomic<size_t> m_enqueuePos;
+    uint8_t m_pad[64U - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> m_dequeuePos;
+};
+
+#endif // __MPSC_QUEUE_H__
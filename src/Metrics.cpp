@@ -0,0 +1,310 @@
+/**
+* Digital Voice Modem - Host Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software
+*
+*/
+/*
+*   Copyright (C) 2023 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#include "Metrics.h"
+#include "Log.h"
+
+#include <cstdio>
+#include <map>
+#include <mutex>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Describes an exported metric; consecutive entries sharing a name form one
+/// metric family.
+/// </summary>
+struct MetricInfo {
+    const char* name;
+    const char* labels;
+    const char* help;
+};
+
+const MetricInfo COUNTER_INFO[METRIC_COUNTER_MAX] = {
+    { "dvm_rf_frames_total", "protocol=\"dmr\",direction=\"in\"", "Air interface frames read from or written to the modem." },
+    { "dvm_rf_frames_total", "protocol=\"dmr\",direction=\"out\"", nullptr },
+    { "dvm_rf_frames_total", "protocol=\"p25\",direction=\"in\"", nullptr },
+    { "dvm_rf_frames_total", "protocol=\"p25\",direction=\"out\"", nullptr },
+    { "dvm_rf_frames_total", "protocol=\"nxdn\",direction=\"in\"", nullptr },
+    { "dvm_rf_frames_total", "protocol=\"nxdn\",direction=\"out\"", nullptr },
+
+    { "dvm_net_frames_total", "direction=\"in\"", "Network frames received or sent." },
+    { "dvm_net_frames_total", "direction=\"out\"", nullptr },
+    { "dvm_net_send_errors_total", "", "Failed network frame queue flushes." },
+
+    { "dvm_fec_corrected_total", "code=\"bptc19696\"", "Codewords with bit errors corrected by FEC." },
+    { "dvm_fec_corrected_total", "code=\"golay24128\"", nullptr },
+    { "dvm_fec_corrected_total", "code=\"rs241213\"", nullptr },
+    { "dvm_fec_corrected_total", "code=\"rs24169\"", nullptr },
+    { "dvm_fec_corrected_total", "code=\"rs362017\"", nullptr },
+    { "dvm_fec_corrected_total", "code=\"trellis12\"", nullptr },
+    { "dvm_fec_corrected_total", "code=\"trellis34\"", nullptr },
+
+    { "dvm_fec_failed_total", "code=\"bptc19696\"", "Codewords FEC could not correct." },
+    { "dvm_fec_failed_total", "code=\"golay24128\"", nullptr },
+    { "dvm_fec_failed_total", "code=\"rs241213\"", nullptr },
+    { "dvm_fec_failed_total", "code=\"rs24169\"", nullptr },
+    { "dvm_fec_failed_total", "code=\"rs362017\"", nullptr },
+    { "dvm_fec_failed_total", "code=\"trellis12\"", nullptr },
+    { "dvm_fec_failed_total", "code=\"trellis34\"", nullptr },
+};
+
+const MetricInfo GAUGE_INFO[METRIC_GAUGE_MAX] = {
+    { "dvm_modem_rx_queue_bytes", "queue=\"dmr1\"", "Bytes waiting in the modem receive queues." },
+    { "dvm_modem_rx_queue_bytes", "queue=\"dmr2\"", nullptr },
+    { "dvm_modem_rx_queue_bytes", "queue=\"p25\"", nullptr },
+    { "dvm_modem_rx_queue_bytes", "queue=\"nxdn\"", nullptr },
+
+    { "dvm_fne_peers", "", "Peers connected to the FNE." },
+};
+
+const MetricInfo HISTOGRAM_INFO[METRIC_HISTOGRAM_MAX] = {
+    { "dvm_grant_latency_seconds", "protocol=\"dmr\"", "Time taken to process a channel grant request." },
+    { "dvm_grant_latency_seconds", "protocol=\"p25\"", nullptr },
+    { "dvm_grant_latency_seconds", "protocol=\"nxdn\"", nullptr },
+
+    { "dvm_grant_permit_latency_seconds", "protocol=\"dmr\"", "Round trip time of the voice channel permit for a channel grant." },
+    { "dvm_grant_permit_latency_seconds", "protocol=\"p25\"", nullptr },
+    { "dvm_grant_permit_latency_seconds", "protocol=\"nxdn\"", nullptr },
+};
+
+const uint64_t Metrics::BUCKET_BOUNDS_US[METRICS_HISTOGRAM_BUCKETS] = {
+    100U, 250U, 500U, 1000U, 2500U, 5000U, 10000U, 25000U, 50000U, 100000U, 250000U, 500000U, 1000000U, 2500000U, 5000000U
+};
+
+// ---------------------------------------------------------------------------
+//  Static Class Members
+// ---------------------------------------------------------------------------
+
+Metrics::MetricShard Metrics::m_shards[METRICS_MAX_SHARDS];
+Metrics::MetricGaugeValue Metrics::m_gauges[METRIC_GAUGE_MAX];
+std::atomic<uint32_t> Metrics::m_nextShard{0U};
+thread_local Metrics::MetricShard* Metrics::m_shard = nullptr;
+
+// ---------------------------------------------------------------------------
+//  Global Variables
+// ---------------------------------------------------------------------------
+
+struct PeerLoss {
+    uint64_t lost;
+    uint64_t outOfOrder;
+};
+
+// per-peer loss is only recorded on a sequence mismatch, so a lock is fine here
+static std::mutex m_peerLossMutex;
+static std::map<uint32_t, PeerLoss> m_peerLoss;
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Helper to append the HELP and TYPE lines of a metric family.
+/// </summary>
+/// <param name="out"></param>
+/// <param name="info"></param>
+/// <param name="type"></param>
+static void formatHeader(std::string& out, const MetricInfo& info, const char* type)
+{
+    if (info.help == nullptr)
+        return;
+
+    out += "# HELP ";
+    out += info.name;
+    out += " ";
+    out += info.help;
+    out += "\n# TYPE ";
+    out += info.name;
+    out += " ";
+    out += type;
+    out += "\n";
+}
+
+/// <summary>
+/// Helper to append a single sample.
+/// </summary>
+/// <param name="out"></param>
+/// <param name="name"></param>
+/// <param name="suffix"></param>
+/// <param name="labels"></param>
+/// <param name="extra">Additional label (i.e. le="..."), appended after the metric labels.</param>
+/// <param name="value"></param>
+static void formatSample(std::string& out, const char* name, const char* suffix, const char* labels, const char* extra, const char* value)
+{
+    out += name;
+    out += suffix;
+
+    bool hasLabels = (labels[0U] != '\0');
+    bool hasExtra = (extra[0U] != '\0');
+    if (hasLabels || hasExtra) {
+        out += "{";
+        out += labels;
+        if (hasLabels && hasExtra)
+            out += ",";
+        out += extra;
+        out += "}";
+    }
+
+    out += " ";
+    out += value;
+    out += "\n";
+}
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Records packets lost, or received out of order, from a network peer.
+/// </summary>
+/// <param name="peerId">Network peer ID.</param>
+/// <param name="lost">Number of packets missing from the sequence.</param>
+/// <param name="outOfOrder">Number of packets arriving late or duplicated.</param>
+void Metrics::peerPacketLoss(uint32_t peerId, uint32_t lost, uint32_t outOfOrder)
+{
+    std::lock_guard<std::mutex> lock(m_peerLossMutex);
+
+    PeerLoss& loss = m_peerLoss[peerId];
+    loss.lost += lost;
+    loss.outOfOrder += outOfOrder;
+}
+
+/// <summary>
+/// Discards the packet loss recorded for a network peer that has gone away.
+/// </summary>
+/// <param name="peerId">Network peer ID.</param>
+void Metrics::removePeer(uint32_t peerId)
+{
+    std::lock_guard<std::mutex> lock(m_peerLossMutex);
+    m_peerLoss.erase(peerId);
+}
+
+/// <summary>
+/// Gets the current value of the given counter.
+/// </summary>
+/// <param name="id">Counter.</param>
+/// <returns>Sum of the counter across all shards.</returns>
+uint64_t Metrics::value(MetricCounter id)
+{
+    uint64_t value = 0U;
+    for (uint32_t i = 0U; i < METRICS_MAX_SHARDS; i++)
+        value += m_shards[i].counters[id].load(std::memory_order_relaxed);
+
+    return value;
+}
+
+/// <summary>
+/// Formats all metrics in the Prometheus text exposition format.
+/// </summary>
+/// <returns>Metrics text.</returns>
+std::string Metrics::format()
+{
+    std::string out;
+    out.reserve(8192U);
+
+    char value[32U];
+
+    // counters
+    for (uint32_t i = 0U; i < METRIC_COUNTER_MAX; i++) {
+        const MetricInfo& info = COUNTER_INFO[i];
+        formatHeader(out, info, "counter");
+
+        ::snprintf(value, sizeof(value), "%llu", (unsigned long long)Metrics::value((MetricCounter)i));
+        formatSample(out, info.name, "", info.labels, "", value);
+    }
+
+    formatHeader(out, { "dvm_log_dropped_total", "", "Log entries dropped by the asynchronous log writer." }, "counter");
+    ::snprintf(value, sizeof(value), "%u", ::LogDroppedCount());
+    formatSample(out, "dvm_log_dropped_total", "", "", "", value);
+
+    // gauges
+    for (uint32_t i = 0U; i < METRIC_GAUGE_MAX; i++) {
+        const MetricInfo& info = GAUGE_INFO[i];
+        formatHeader(out, info, "gauge");
+
+        ::snprintf(value, sizeof(value), "%lld", (long long)m_gauges[i].value.load(std::memory_order_relaxed));
+        formatSample(out, info.name, "", info.labels, "", value);
+    }
+
+    // histograms
+    for (uint32_t i = 0U; i < METRIC_HISTOGRAM_MAX; i++) {
+        const MetricInfo& info = HISTOGRAM_INFO[i];
+        formatHeader(out, info, "histogram");
+
+        uint64_t buckets[METRICS_HISTOGRAM_BUCKETS + 1U];
+        uint64_t sum = 0U;
+        for (uint32_t b = 0U; b <= METRICS_HISTOGRAM_BUCKETS; b++) {
+            buckets[b] = 0U;
+            for (uint32_t s = 0U; s < METRICS_MAX_SHARDS; s++)
+                buckets[b] += m_shards[s].buckets[i][b].load(std::memory_order_relaxed);
+        }
+
+        for (uint32_t s = 0U; s < METRICS_MAX_SHARDS; s++)
+            sum += m_shards[s].sums[i].load(std::memory_order_relaxed);
+
+        // Prometheus buckets are cumulative
+        uint64_t count = 0U;
+        char le[32U];
+        for (uint32_t b = 0U; b <= METRICS_HISTOGRAM_BUCKETS; b++) {
+            count += buckets[b];
+            if (b < METRICS_HISTOGRAM_BUCKETS)
+                ::snprintf(le, sizeof(le), "le=\"%g\"", BUCKET_BOUNDS_US[b] / 1000000.0);
+            else
+                ::snprintf(le, sizeof(le), "le=\"+Inf\"");
+
+            ::snprintf(value, sizeof(value), "%llu", (unsigned long long)count);
+            formatSample(out, info.name, "_bucket", info.labels, le, value);
+        }
+
+        ::snprintf(value, sizeof(value), "%.6f", sum / 1000000.0);
+        formatSample(out, info.name, "_sum", info.labels, "", value);
+        ::snprintf(value, sizeof(value), "%llu", (unsigned long long)count);
+        formatSample(out, info.name, "_count", info.labels, "", value);
+    }
+
+    // per-peer packet loss
+    std::lock_guard<std::mutex> lock(m_peerLossMutex);
+    if (!m_peerLoss.empty()) {
+        char labels[32U];
+
+        formatHeader(out, { "dvm_fne_peer_packets_lost_total", "", "Packets missing from a peer's stream sequence." }, "counter");
+        for (auto& entry : m_peerLoss) {
+            ::snprintf(labels, sizeof(labels), "peer=\"%u\"", entry.first);
+            ::snprintf(value, sizeof(value), "%llu", (unsigned long long)entry.second.lost);
+            formatSample(out, "dvm_fne_peer_packets_lost_total", "", labels, "", value);
+        }
+
+        formatHeader(out, { "dvm_fne_peer_packets_out_of_order_total", "", "Packets arriving late or duplicated in a peer's stream sequence." }, "counter");
+        for (auto& entry : m_peerLoss) {
+            ::snprintf(labels, sizeof(labels), "peer=\"%u\"", entry.first);
+            ::snprintf(value, sizeof(value), "%llu", (unsigned long long)entry.second.outOfOrder);
+            formatSample(out, "dvm_fne_peer_packets_out_of_order_total", "", labels, "", value);
+        }
+    }
+
+    return out;
+}
@@ -0,0 +1,214 @@
+/**
+* Digital Voice Modem - Host Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software
+*
+*/
+/*
+*   Copyright (C) 2023 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#if !defined(__METRICS_H__)
+#define __METRICS_H__
+
+#include "Defines.h"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+#define METRICS_CONTENT_TYPE "text/plain; version=0.0.4"
+
+const uint32_t  METRICS_MAX_SHARDS = 16U;
+const uint32_t  METRICS_CACHE_LINE = 64U;
+const uint32_t  METRICS_HISTOGRAM_BUCKETS = 15U;
+
+/// <summary>
+/// Monotonic counters.
+/// </summary>
+enum MetricCounter {
+    METRIC_DMR_FRAMES_IN,
+    METRIC_DMR_FRAMES_OUT,
+    METRIC_P25_FRAMES_IN,
+    METRIC_P25_FRAMES_OUT,
+    METRIC_NXDN_FRAMES_IN,
+    METRIC_NXDN_FRAMES_OUT,
+
+    METRIC_NET_FRAMES_IN,
+    METRIC_NET_FRAMES_OUT,
+    METRIC_NET_SEND_ERRORS,
+
+    METRIC_FEC_BPTC19696_CORRECTED,
+    METRIC_FEC_GOLAY24128_CORRECTED,
+    METRIC_FEC_RS241213_CORRECTED,
+    METRIC_FEC_RS24169_CORRECTED,
+    METRIC_FEC_RS362017_CORRECTED,
+    METRIC_FEC_TRELLIS12_CORRECTED,
+    METRIC_FEC_TRELLIS34_CORRECTED,
+
+    METRIC_FEC_BPTC19696_FAILED,
+    METRIC_FEC_GOLAY24128_FAILED,
+    METRIC_FEC_RS241213_FAILED,
+    METRIC_FEC_RS24169_FAILED,
+    METRIC_FEC_RS362017_FAILED,
+    METRIC_FEC_TRELLIS12_FAILED,
+    METRIC_FEC_TRELLIS34_FAILED,
+
+    METRIC_COUNTER_MAX
+};
+
+/// <summary>
+/// Point-in-time values.
+/// </summary>
+enum MetricGauge {
+    METRIC_MODEM_RX_DMR1_QUEUE,
+    METRIC_MODEM_RX_DMR2_QUEUE,
+    METRIC_MODEM_RX_P25_QUEUE,
+    METRIC_MODEM_RX_NXDN_QUEUE,
+
+    METRIC_FNE_PEERS,
+
+    METRIC_GAUGE_MAX
+};
+
+/// <summary>
+/// Latency histograms.
+/// </summary>
+enum MetricHistogram {
+    METRIC_DMR_GRANT_LATENCY,
+    METRIC_P25_GRANT_LATENCY,
+    METRIC_NXDN_GRANT_LATENCY,
+
+    METRIC_DMR_PERMIT_LATENCY,
+    METRIC_P25_PERMIT_LATENCY,
+    METRIC_NXDN_PERMIT_LATENCY,
+
+    METRIC_HISTOGRAM_MAX
+};
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+//      Implements process-wide metrics, exported in the Prometheus text
+//      exposition format.
+//
+//      Counters and histograms are split into shards; each thread updates
+//      the shard it was assigned on first use, so the hot path is a single
+//      relaxed atomic add on a cache line no other thread normally writes.
+//      Shards are only summed when the metrics are exported.
+// ---------------------------------------------------------------------------
+
+class HOST_SW_API Metrics {
+public:
+    /// <summary>Increments the given counter.</summary>
+    static void add(MetricCounter id, uint64_t n = 1U)
+    {
+        shard().counters[id].fetch_add(n, std::memory_order_relaxed);
+    }
+
+    /// <summary>Sets the given gauge.</summary>
+    static void set(MetricGauge id, int64_t value)
+    {
+        m_gauges[id].value.store(value, std::memory_order_relaxed);
+    }
+
+    /// <summary>Records a latency observation (in microseconds) on the given histogram.</summary>
+    static void observe(MetricHistogram id, uint64_t us)
+    {
+        uint32_t bucket = 0U;
+        while (bucket < METRICS_HISTOGRAM_BUCKETS && us > BUCKET_BOUNDS_US[bucket])
+            bucket++;
+
+        MetricShard& s = shard();
+        s.buckets[id][bucket].fetch_add(1U, std::memory_order_relaxed);
+        s.sums[id].fetch_add(us, std::memory_order_relaxed);
+    }
+
+    /// <summary>Gets a monotonic timestamp (in microseconds) used to measure latencies.</summary>
+    static uint64_t now()
+    {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /// <summary>Records packets lost, or received out of order, from a network peer.</summary>
+    static void peerPacketLoss(uint32_t peerId, uint32_t lost, uint32_t outOfOrder);
+    /// <summary>Discards the packet loss recorded for a network peer that has gone away.</summary>
+    static void removePeer(uint32_t peerId);
+
+    /// <summary>Gets the current value of the given counter.</summary>
+    static uint64_t value(MetricCounter id);
+
+    /// <summary>Formats all metrics in the Prometheus text exposition format.</summary>
+    static std::string format();
+
+    /// <summary>Latency histogram bucket upper bounds (in microseconds).</summary>
+    static const uint64_t BUCKET_BOUNDS_US[METRICS_HISTOGRAM_BUCKETS];
+
+private:
+    /// <summary>Per-thread set of counters and histogram buckets.</summary>
+    struct alignas(METRICS_CACHE_LINE) MetricShard {
+        std::atomic<uint64_t> counters[METRIC_COUNTER_MAX];
+        std::atomic<uint64_t> buckets[METRIC_HISTOGRAM_MAX][METRICS_HISTOGRAM_BUCKETS + 1U];
+        std::atomic<uint64_t> sums[METRIC_HISTOGRAM_MAX];
+    };
+
+    /// <summary>Gauge padded to its own cache line.</summary>
+    struct alignas(METRICS_CACHE_LINE) MetricGaugeValue {
+        std::atomic<int64_t> value;
+    };
+
+    static MetricShard m_shards[METRICS_MAX_SHARDS];
+    static MetricGaugeValue m_gauges[METRIC_GAUGE_MAX];
+    static std::atomic<uint32_t> m_nextShard;
+    static thread_local MetricShard* m_shard;
+
+    /// <summary>Gets the shard of the calling thread.</summary>
+    static MetricShard& shard()
+    {
+        MetricShard* s = m_shard;
+        if (s == nullptr) {
+            s = &m_shards[m_nextShard.fetch_add(1U, std::memory_order_relaxed) % METRICS_MAX_SHARDS];
+            m_shard = s;
+        }
+
+        return *s;
+    }
+};
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+//      Records the time spent in a scope on a latency histogram.
+// ---------------------------------------------------------------------------
+
+class HOST_SW_API MetricsScopedTimer {
+public:
+    /// <summary>Initializes a new instance of the MetricsScopedTimer class.</summary>
+    explicit MetricsScopedTimer(MetricHistogram id) : m_id(id), m_start(Metrics::now()) { /* stub */ }
+    /// <summary>Finalizes a instance of the MetricsScopedTimer class.</summary>
+    ~MetricsScopedTimer() { Metrics::observe(m_id, Metrics::now() - m_start); }
+
+private:
+    MetricHistogram m_id;
+    uint64_t m_start;
+};
+
+#endif // __METRICS_H__
@@ -0,0 +1,145 @@
+/**
+* Digital Voice Modem - Host Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software
+*
+*/
+/*
+*   Copyright (C) 2023 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#if !defined(__SPSC_QUEUE_H__)
+#define __SPSC_QUEUE_H__
+
+#include "Defines.h"
+
+#include <cassert>
+#include <atomic>
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+//      Implements a bounded, lock-free, single-producer/single-consumer queue.
+//
+//      Exactly one thread may call push() and exactly one (other) thread may
+//      call pop(); the capacity is rounded up to a power of two so indices
+//      wrap with a mask.
+// ---------------------------------------------------------------------------
+
+template<class T>
+class HOST_SW_API SPSCQueue {
+public:
+    /// <summary>Initializes a new instance of the SPSCQueue class.</summary>
+    /// <param name="capacity">Minimum number of items the queue can hold.</param>
+    /// <param name="name">Name of queue.</param>
+    SPSCQueue(uint32_t capacity, const char* name) :
+        m_capacity(1U),
+        m_mask(0U),
+        m_name(name),
+        m_buffer(nullptr),
+        m_head(0U),
+        m_tail(0U)
+    {
+        assert(capacity > 0U);
+        assert(name != nullptr);
+
+        while (m_capacity < capacity)
+            m_capacity <<= 1;
+        m_mask = m_capacity - 1U;
+
+        m_buffer = new T[m_capacity];
+    }
+
+    /// <summary>Finalizes a instance of the SPSCQueue class.</summary>
+    ~SPSCQueue()
+    {
+        delete[] m_buffer;
+    }
+
+    /// <summary>Adds an item to the end of the queue. (Producer only.)</summary>
+    /// <param name="item">Item to add.</param>
+    /// <returns>True, if the item was added, otherwise false if the queue is full.</returns>
+    bool push(const T& item)
+    {
+        uint32_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) >= m_capacity)
+            return false;
+
+        m_buffer[tail & m_mask] = item;
+        m_tail.store(tail + 1U, std::memory_order_release);
+        return true;
+    }
+
+    /// <summary>Removes an item from the front of the queue. (Consumer only.)</summary>
+    /// <param name="item">Item removed from the queue.</param>
+    /// <returns>True, if an item was removed, otherwise false if the queue is empty.</returns>
+    bool pop(T& item)
+    {
+        uint32_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire))
+            return false;
+
+        item = m_buffer[head & m_mask];
+        m_head.store(head + 1U, std::memory_order_release);
+        return true;
+    }
+
+    /// <summary>Gets the number of items currently in the queue.</summary>
+    /// <remarks>This is only a snapshot when called from a thread other than the producer or consumer.</remarks>
+    /// <returns>Number of items in the queue.</returns>
+    uint32_t size() const
+    {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+
+    /// <summary>Helper to determine if the queue is empty.</summary>
+    /// <returns>True, if the queue is empty, otherwise false.</returns>
+    bool isEmpty() const
+    {
+        return size() == 0U;
+    }
+
+    /// <summary>Gets the total number of items the queue can hold.</summary>
+    /// <returns>Capacity of the queue.</returns>
+    uint32_t capacity() const
+    {
+        return m_capacity;
+    }
+
+    /// <summary>Gets the name of the queue.</summary>
+    /// <returns>Name of the queue.</returns>
+    const char* name() const
+    {
+        return m_name;
+    }
+
+private:
+    uint32_t m_capacity;
+    uint32_t m_mask;
+
+    const char* m_name;
+
+    T* m_buffer;
+
+    // head and tail are kept on separate cache lines so the producer and
+    // consumer do not invalidate each other on every operation
+    std::atomic<uint32_t> m_head;
+    uint8_t m_pad[64U - sizeof(std::atomic<uint32_t>)];
+    std::atomic<uint32_t> m_tail;
+};
+
+#endif // __SPSC_QUEUE_H__
@@ -92,3 +92,25 @@ uint32_t StopWatch::elapsed()
 
     return nowMS - m_startMS;
 }
+
+/// <summary>
+/// Gets the elapsed time since the last lap and starts the next lap.
+/// </summary>
+/// <remarks>
+/// Unlike calling elapsed() followed by start(), the next lap begins exactly where the returned
+/// interval ended, so sub-millisecond remainders carry over instead of being lost when the
+/// stopwatch is lapped at a high rate.
+/// </remarks>
+/// <returns></returns>
+uint32_t StopWatch::lap()
+{
+    struct timespec now;
+    ::clock_gettime(CLOCK_MONOTONIC, &now);
+
+    ulong64_t nowMS = now.tv_sec * 1000ULL + now.tv_nsec / 1000000ULL;
+
+    uint32_t ms = (uint32_t)(nowMS - m_startMS);
+    m_startMS += ms;
+
+    return ms;
+}
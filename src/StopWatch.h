@@ -53,6 +53,8 @@ public:
     ulong64_t start();
     /// <summary>Gets the elpased time since the stopwatch started.</summary>
     uint32_t elapsed();
+    /// <summary>Gets the elapsed time since the last lap and starts the next lap.</summary>
+    uint32_t lap();
 
 private:
     ulong64_t m_startMS;
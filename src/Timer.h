@@ -68,6 +68,19 @@ public:
         return (m_timeout - m_timer) / m_ticksPerSec;
     }
 
+    /// <summary>Gets the time remaining (in milliseconds) before the timer expires.</summary>
+    /// <returns>Milliseconds remaining before the timeout, or 0 if already expired.</returns>
+    uint32_t getRemainingMs()
+    {
+        if (m_timeout == 0U || m_timer == 0U)
+            return 0U;
+
+        if (m_timer >= m_timeout)
+            return 0U;
+
+        return (uint32_t)(((ulong64_t)(m_timeout - m_timer) * 1000ULL) / m_ticksPerSec);
+    }
+
     /// <summary>Flag indicating whether the timer is running.</summary>
     /// <returns>True, if the timer is still running, otherwise false.</returns>
     bool isRunning()
@@ -0,0 +1,176 @@
+/**
+* Digital Voice Modem - Host Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software
+*
+*/
+/*
+*   Copyright (C) 2023 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#include "Defines.h"
+#include "TimerWheel.h"
+
+#include <cassert>
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Initializes a new instance of the TimerWheel class.
+/// </summary>
+/// <param name="tickMs">Resolution of the wheel in milliseconds.</param>
+/// <param name="slots">Number of slots in the wheel.</param>
+TimerWheel::TimerWheel(uint32_t tickMs, uint32_t slots) :
+    m_tickMs(tickMs),
+    m_slots(slots),
+    m_timers(),
+    m_now(0U),
+    m_tick(0U),
+    m_seq(0U)
+{
+    assert(tickMs > 0U);
+    assert(slots > 0U);
+}
+
+/// <summary>
+/// Finalizes a instance of the TimerWheel class.
+/// </summary>
+TimerWheel::~TimerWheel()
+{
+    /* stub */
+}
+
+/// <summary>
+/// Starts (or restarts) the timer for the given ID.
+/// </summary>
+/// <remarks>A timeout of zero stops the timer, as with <see cref="Timer"/>.</remarks>
+/// <param name="id">Timer ID.</param>
+/// <param name="timeoutMs">Timeout in milliseconds.</param>
+void TimerWheel::start(uint32_t id, uint32_t timeoutMs)
+{
+    if (timeoutMs == 0U) {
+        stop(id);
+        return;
+    }
+
+    // a new sequence number orphans any slot entry left over from a previous start
+    TimerEntry& entry = m_timers[id];
+    entry.deadline = m_now + timeoutMs;
+    entry.timeout = timeoutMs;
+    entry.seq = ++m_seq;
+
+    schedule(id, entry);
+}
+
+/// <summary>
+/// Restarts a running timer for the given ID with its original timeout.
+/// </summary>
+/// <param name="id">Timer ID.</param>
+void TimerWheel::restart(uint32_t id)
+{
+    auto it = m_timers.find(id);
+    if (it == m_timers.end()) {
+        return;
+    }
+
+    // the deadline only ever moves later; the slot entry is moved along lazily when its
+    // slot comes due, so restarting a busy timer costs nothing more than this
+    it->second.deadline = m_now + it->second.timeout;
+}
+
+/// <summary>
+/// Stops the timer for the given ID.
+/// </summary>
+/// <param name="id">Timer ID.</param>
+void TimerWheel::stop(uint32_t id)
+{
+    m_timers.erase(id);
+}
+
+/// <summary>
+/// Stops all timers.
+/// </summary>
+void TimerWheel::clear()
+{
+    m_timers.clear();
+    for (auto& slot : m_slots) {
+        slot.clear();
+    }
+}
+
+/// <summary>
+/// Updates the wheel by the passed number of milliseconds.
+/// </summary>
+/// <param name="ms">Elapsed milliseconds.</param>
+/// <param name="expired">Receives the IDs of the timers that expired; they are stopped.</param>
+void TimerWheel::clock(uint32_t ms, std::vector<uint32_t>& expired)
+{
+    m_now += ms;
+
+    ulong64_t target = m_now / m_tickMs;
+    ulong64_t slots = m_slots.size();
+
+    // after a long stall every slot is due; visiting each of them once is enough
+    if (target - m_tick > slots) {
+        m_tick = target - slots;
+    }
+
+    std::vector<std::pair<uint32_t, uint32_t>> due;
+    while (m_tick < target) {
+        m_tick++;
+
+        due.clear();
+        due.swap(m_slots[m_tick % slots]);
+        for (auto entry : due) {
+            auto it = m_timers.find(entry.first);
+            if (it == m_timers.end() || it->second.seq != entry.second) {
+                continue; // stopped or restarted since this entry was made
+            }
+
+            if (it->second.deadline <= m_now) {
+                expired.push_back(entry.first);
+                m_timers.erase(it);
+            }
+            else {
+                schedule(entry.first, it->second);
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Helper to place a timer in the slot for its deadline.
+/// </summary>
+/// <param name="id">Timer ID.</param>
+/// <param name="entry">Timer entry.</param>
+void TimerWheel::schedule(uint32_t id, const TimerEntry& entry)
+{
+    // the timer expires on the first tick at or after its deadline
+    ulong64_t tick = (entry.deadline + m_tickMs - 1U) / m_tickMs;
+    if (tick <= m_tick) {
+        tick = m_tick + 1U;
+    }
+
+    m_slots[tick % m_slots.size()].push_back(std::make_pair(id, entry.seq));
+}
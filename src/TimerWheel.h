@@ -0,0 +1,85 @@
+/**
+* Digital Voice Modem - Host Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software
+*
+*/
+/*
+*   Copyright (C) 2023 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#if !defined(__TIMER_WHEEL_H__)
+#define __TIMER_WHEEL_H__
+
+#include "Defines.h"
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+//      Implements a hashed timer wheel for a large number of keyed timeouts.
+//      Starting, restarting and stopping a timer are O(1), and clocking the
+//      wheel only visits the timers in the slots that have come due.
+// ---------------------------------------------------------------------------
+
+class HOST_SW_API TimerWheel {
+public:
+    /// <summary>Initializes a new instance of the TimerWheel class.</summary>
+    TimerWheel(uint32_t tickMs = 100U, uint32_t slots = 256U);
+    /// <summary>Finalizes a instance of the TimerWheel class.</summary>
+    ~TimerWheel();
+
+    /// <summary>Starts (or restarts) the timer for the given ID.</summary>
+    void start(uint32_t id, uint32_t timeoutMs);
+    /// <summary>Restarts a running timer for the given ID with its original timeout.</summary>
+    void restart(uint32_t id);
+    /// <summary>Stops the timer for the given ID.</summary>
+    void stop(uint32_t id);
+    /// <summary>Stops all timers.</summary>
+    void clear();
+
+    /// <summary>Flag indicating whether the timer for the given ID is running.</summary>
+    bool isRunning(uint32_t id) const { return m_timers.find(id) != m_timers.end(); }
+    /// <summary>Gets the count of running timers.</summary>
+    uint32_t size() const { return (uint32_t)m_timers.size(); }
+
+    /// <summary>Updates the wheel by the passed number of milliseconds.</summary>
+    void clock(uint32_t ms, std::vector<uint32_t>& expired);
+
+private:
+    struct TimerEntry {
+        ulong64_t deadline;
+        uint32_t timeout;
+        uint32_t seq;
+    };
+
+    uint32_t m_tickMs;
+    std::vector<std::vector<std::pair<uint32_t, uint32_t>>> m_slots;
+    std::unordered_map<uint32_t, TimerEntry> m_timers;
+
+    ulong64_t m_now;
+    ulong64_t m_tick;
+    uint32_t m_seq;
+
+    /// <summary>Helper to place a timer in the slot for its deadline.</summary>
+    void schedule(uint32_t id, const TimerEntry& entry);
+};
+
+#endif // __TIMER_WHEEL_H__
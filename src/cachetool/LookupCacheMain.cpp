@@ -0,0 +1,205 @@
+/**
+* Digital Voice Modem - Host Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software
+*
+*/
+/*
+*   Copyright (C) 2023 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#include "Defines.h"
+#include "lookups/RadioIdLookup.h"
+#include "lookups/TalkgroupRulesLookup.h"
+#include "Log.h"
+
+using namespace lookups;
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+#undef __PROG_NAME__
+#define __PROG_NAME__ "Digital Voice Modem (DVM) Lookup Cache Tool"
+#undef __EXE_NAME__
+#define __EXE_NAME__ "dvmcache"
+
+// ---------------------------------------------------------------------------
+//	Macros
+// ---------------------------------------------------------------------------
+
+#define IS(s) (::strcmp(argv[i], s) == 0)
+
+// ---------------------------------------------------------------------------
+//  Global Variables
+// ---------------------------------------------------------------------------
+
+static std::string g_progExe = std::string(__EXE_NAME__);
+static std::vector<std::string> g_ridFiles = std::vector<std::string>();
+static std::vector<std::string> g_tgFiles = std::vector<std::string>();
+static bool g_force = false;
+
+// ---------------------------------------------------------------------------
+//	Global Functions
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Helper to pring usage the command line arguments. (And optionally an error.)
+/// </summary>
+/// <param name="message">Error message.</param>
+/// <param name="arg">Error message arguments.</param>
+void usage(const char* message, const char* arg)
+{
+    ::fprintf(stdout, __PROG_NAME__ " %s (built %s)\r\n", __VER__, __BUILD__);
+    ::fprintf(stdout, "Copyright (c) 2023 Bryan Biedenkapp, N2PLL and DVMProject (https://github.com/dvmproject) Authors.\n\n");
+    if (message != nullptr) {
+        ::fprintf(stderr, "%s: ", g_progExe.c_str());
+        ::fprintf(stderr, message, arg);
+        ::fprintf(stderr, "\n\n");
+    }
+
+    ::fprintf(stdout, 
+        "usage: %s [-fvh]"
+        "[-r <radio ID file>]"
+        "[-t <talkgroup rules file>]"
+        "\n\n"
+        "  -f                          rebuild the cache even if it is up to date\n"
+        "  -v                          show version information\n"
+        "  -h                          show this screen\n"
+        "\n"
+        "  -r                          radio ID (RID ACL) file to build the cache for\n"
+        "  -t                          talkgroup rules file to build the cache for\n"
+        "\n"
+        "The cache is written next to the source file as <file>.cache; -r and -t may be repeated.\n",
+        g_progExe.c_str());
+
+    exit(EXIT_FAILURE);
+}
+
+/// <summary>
+/// Helper to validate the command line arguments.
+/// </summary>
+/// <param name="argc">Argument count.</param>
+/// <param name="argv">Array of argument strings.</param>
+void checkArgs(int argc, char* argv[])
+{
+    for (int i = 1; i < argc; i++) {
+        if (IS("-r")) {
+            if (i + 1 >= argc)
+                usage("error: %s", "must specify the radio ID file");
+            g_ridFiles.push_back(std::string(argv[++i]));
+        }
+        else if (IS("-t")) {
+            if (i + 1 >= argc)
+                usage("error: %s", "must specify the talkgroup rules file");
+            g_tgFiles.push_back(std::string(argv[++i]));
+        }
+        else if (IS("-f")) {
+            g_force = true;
+        }
+        else if (IS("-v")) {
+            ::fprintf(stdout, __PROG_NAME__ " %s (built %s)\r\n", __VER__, __BUILD__);
+            ::fprintf(stdout, "Copyright (c) 2017-2023 Bryan Biedenkapp, N2PLL and DVMProject (https://github.com/dvmproject) Authors.\r\n");
+            if (argc == 2)
+                exit(EXIT_SUCCESS);
+        }
+        else if (IS("-h")) {
+            usage(nullptr, nullptr);
+        }
+        else {
+            usage("unrecognized option `%s'", argv[i]);
+        }
+    }
+}
+
+/// <summary>
+/// Helper to remove an existing cache file, forcing it to be rebuilt.
+/// </summary>
+/// <param name="filename">Full-path to the source lookup file.</param>
+void removeCache(const std::string& filename)
+{
+    std::string cacheFile = filename + ".cache";
+    if (::unlink(cacheFile.c_str()) == 0) {
+        LogMessage(LOG_HOST, "Removed existing cache %s", cacheFile.c_str());
+    }
+}
+
+// ---------------------------------------------------------------------------
+//  Program Entry Point
+// ---------------------------------------------------------------------------
+
+int main(int argc, char** argv)
+{
+    if (argv[0] != nullptr && *argv[0] != 0)
+        g_progExe = std::string(argv[0]);
+
+    checkArgs(argc, argv);
+
+    if (g_ridFiles.empty() && g_tgFiles.empty()) {
+        usage("error: %s", "must specify at least one radio ID or talkgroup rules file!");
+    }
+
+    // initialize system logging
+    bool ret = ::LogInitialise("", "", 0U, 1U, true);
+    if (!ret) {
+        ::fprintf(stderr, "unable to open the log file\n");
+        return 1;
+    }
+
+    int retCode = EXIT_SUCCESS;
+
+    // loading a lookup (with reloading disabled) builds its cache as a side effect
+    for (const std::string& filename : g_ridFiles) {
+        if (g_force) {
+            removeCache(filename);
+        }
+
+        LogMessage(LOG_HOST, "Building radio ID cache for %s", filename.c_str());
+        RadioIdLookup* ridLookup = new RadioIdLookup(filename, 0U, false);
+        if (!ridLookup->read()) {
+            LogError(LOG_HOST, "Failed to load radio ID file %s", filename.c_str());
+            retCode = EXIT_FAILURE;
+        }
+        ridLookup->stop();
+    }
+
+    for (const std::string& filename : g_tgFiles) {
+        if (g_force) {
+            removeCache(filename);
+        }
+
+        LogMessage(LOG_HOST, "Building talkgroup rules cache for %s", filename.c_str());
+        TalkgroupRulesLookup* tidLookup = new TalkgroupRulesLookup(filename, 0U, false);
+        if (!tidLookup->read()) {
+            LogError(LOG_HOST, "Failed to load talkgroup rules file %s", filename.c_str());
+            retCode = EXIT_FAILURE;
+        }
+        tidLookup->stop();
+    }
+
+    ::LogFinalise();
+    return retCode;
+}
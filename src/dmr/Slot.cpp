@@ -33,7 +33,7 @@
 #include "dmr/Sync.h"
 #include "edac/BPTC19696.h"
 #include "edac/CRC.h"
-#include "remote/RESTClient.h"
+#include "remote/RESTClientPool.h"
 #include "Log.h"
 #include "Utils.h"
 
@@ -824,8 +824,8 @@ void Slot::init(Control* dmr, bool authoritative, uint32_t colorCode, SiteData s
                 bool clear = true;
                 req["clear"].set<bool>(clear);
 
-                RESTClient::send(voiceChData.address(), voiceChData.port(), voiceChData.password(),
-                    HTTP_PUT, PUT_DMR_TSCC_PAYLOAD_ACT, req, tscc->m_debug);
+                RESTClientPool::send(voiceChData.address(), voiceChData.port(), voiceChData.password(),
+                    HTTP_PUT, PUT_DMR_TSCC_PAYLOAD_ACT, req, nullptr, tscc->m_debug);
             }
             else {
                 ::LogError(LOG_DMR, "DMR Slot %u, DT_CSBK, CSBKO_RAND (Random Access), failed to clear payload channel, chNo = %u, slot = %u", tscc->m_slotNo, chNo, slot);
@@ -841,8 +841,8 @@ void Slot::init(Control* dmr, bool authoritative, uint32_t colorCode, SiteData s
                     req["dstId"].set<uint32_t>(dstId);
                     req["slot"].set<uint8_t>(slot);
 
-                    RESTClient::send(voiceChData.address(), voiceChData.port(), voiceChData.password(),
-                        HTTP_PUT, PUT_PERMIT_TG, req, m_dmr->m_debug);
+                    RESTClientPool::send(voiceChData.address(), voiceChData.port(), voiceChData.password(),
+                        HTTP_PUT, PUT_PERMIT_TG, req, nullptr, m_dmr->m_debug);
                 }
                 else {
                     ::LogError(LOG_DMR, "DMR Slot %u, DT_CSBK, CSBKO_RAND (Random Access), failed to clear TG permit, chNo = %u, slot = %u", tscc->m_slotNo, chNo, slot);
@@ -1057,11 +1057,12 @@ void Slot::notifyCC_ReleaseGrant(uint32_t dstId)
     uint8_t slot = m_slotNo;
     req["slot"].set<uint8_t>(slot);
 
-    int ret = RESTClient::send(m_controlChData.address(), m_controlChData.port(), m_controlChData.password(),
-        HTTP_PUT, PUT_RELEASE_TG, req, m_debug);
-    if (ret != network::rest::http::HTTPPayload::StatusType::OK) {
-        ::LogError(LOG_DMR, "DMR Slot %u, failed to notify the CC %s:%u of the release of, dstId = %u", m_slotNo, m_controlChData.address().c_str(), m_controlChData.port(), dstId);
-    }
+    RESTClientPool::send(m_controlChData.address(), m_controlChData.port(), m_controlChData.password(),
+        HTTP_PUT, PUT_RELEASE_TG, req, [=](int ret, const json::object&) {
+            if (ret != network::rest::http::HTTPPayload::StatusType::OK) {
+                ::LogError(LOG_DMR, "DMR Slot %u, failed to notify the CC %s:%u of the release of, dstId = %u", m_slotNo, m_controlChData.address().c_str(), m_controlChData.port(), dstId);
+            }
+        }, m_debug);
 }
 
 /// <summary>
@@ -1090,11 +1091,12 @@ void Slot::notifyCC_TouchGrant(uint32_t dstId)
     uint8_t slot = m_slotNo;
     req["slot"].set<uint8_t>(slot);
 
-    int ret = RESTClient::send(m_controlChData.address(), m_controlChData.port(), m_controlChData.password(),
-        HTTP_PUT, PUT_TOUCH_TG, req, m_debug);
-    if (ret != network::rest::http::HTTPPayload::StatusType::OK) {
-        ::LogError(LOG_DMR, "DMR Slot %u, failed to notify the CC %s:%u of the touch of, dstId = %u", m_slotNo, m_controlChData.address().c_str(), m_controlChData.port(), dstId);
-    }
+    RESTClientPool::send(m_controlChData.address(), m_controlChData.port(), m_controlChData.password(),
+        HTTP_PUT, PUT_TOUCH_TG, req, [=](int ret, const json::object&) {
+            if (ret != network::rest::http::HTTPPayload::StatusType::OK) {
+                ::LogError(LOG_DMR, "DMR Slot %u, failed to notify the CC %s:%u of the touch of, dstId = %u", m_slotNo, m_controlChData.address().c_str(), m_controlChData.port(), dstId);
+            }
+        }, m_debug);
 }
 
 /// <summary>
@@ -1312,7 +1314,7 @@ void Slot::writeRF_ControlData(uint16_t frameCnt, uint8_t n)
         {
         case 3:
         {
-            std::unordered_map<uint32_t, uint32_t> grants = m_affiliations->grantTable();
+            const std::unordered_map<uint32_t, uint32_t>& grants = m_affiliations->grantTable();
             if (grants.size() > 0) {
                 uint32_t j = 0U;
                 if (m_lastLateEntry > grants.size()) {
@@ -45,6 +45,8 @@ namespace dmr
 
             /// <summary>Decodes 3/4 rate Trellis.</summary>
             bool decode(const uint8_t* data, uint8_t* payload);
+            /// <summary>Decodes 3/4 rate Trellis from soft symbols.</summary>
+            bool decodeSoft(const int8_t* symbols, uint8_t* payload);
             /// <summary>Encodes 3/4 rate Trellis.</summary>
             void encode(const uint8_t* payload, uint8_t* data);
 
@@ -62,8 +64,8 @@ namespace dmr
             /// <summary>Helper to convert tribits into a byte payload.</summary>
             void tribitsToBits(const uint8_t* tribits, uint8_t* payload) const;
 
-            /// <summary>Helper to fix errors in Trellis coding.</summary>
-            bool fixCode(uint8_t* points, uint32_t failPos, uint8_t* payload) const;
+            /// <summary>Helper to decode deinterleaved soft symbols.</summary>
+            bool decodeSymbols(const int8_t* symbols, uint8_t* payload) const;
             /// <summary>Helper to detect errors in Trellis coding.</summary>
             uint32_t checkCode(const uint8_t* points, uint8_t* tribits) const;
         };
@@ -109,8 +109,7 @@ bool DMRAffiliationLookup::grantChSlot(uint32_t dstId, uint32_t srcId, uint8_t s
     m_grantChSlotTable[dstId] = std::make_tuple(chNo, slot);
     m_rfGrantChCnt++;
 
-    m_grantTimers[dstId] = Timer(1000U, grantTimeout);
-    m_grantTimers[dstId].start();
+    m_grantTimers.start(dstId, grantTimeout * 1000U);
 
     if (m_verbose) {
         LogMessage(LOG_HOST, "%s, granting channel, chNo = %u, slot = %u, dstId = %u",
@@ -179,7 +178,7 @@ bool DMRAffiliationLookup::releaseGrant(uint32_t dstId, bool releaseAll)
             m_rfGrantChCnt = 0U;
         }
 
-        m_grantTimers[dstId].stop();
+        m_grantTimers.stop(dstId);
         return true;
     }
 
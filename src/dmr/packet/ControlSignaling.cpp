@@ -39,7 +39,9 @@
 #include "edac/BPTC19696.h"
 #include "edac/CRC.h"
 #include "remote/RESTClient.h"
+#include "remote/RESTClientPool.h"
 #include "Log.h"
+#include "Metrics.h"
 #include "Utils.h"
 
 using namespace dmr;
@@ -668,7 +670,8 @@ ControlSignaling::ControlSignaling(Slot * slot, network::BaseNetwork * network,
     m_slot(slot),
     m_dumpCSBKData(dumpCSBKData),
     m_verbose(verbose),
-    m_debug(debug)
+    m_debug(debug),
+    m_pendingPermits()
 {
     /* stub */
 }
@@ -776,15 +779,12 @@ void ControlSignaling::writeRF_CSBK_NACK_RSP(uint32_t dstId, uint8_t reason, uin
 /// <returns></returns>
 bool ControlSignaling::writeRF_CSBK_Grant(uint32_t srcId, uint32_t dstId, uint8_t serviceOptions, bool grp, bool net, bool skip, uint32_t chNo)
 {
+    MetricsScopedTimer grantTimer(METRIC_DMR_GRANT_LATENCY);
+
     Slot *m_tscc = m_slot->m_dmr->getTSCCSlot();
 
     uint8_t slot = 0U;
 
-    bool emergency = ((serviceOptions & 0xFFU) & 0x80U) == 0x80U;           // Emergency Flag
-    bool privacy = ((serviceOptions & 0xFFU) & 0x40U) == 0x40U;             // Privacy Flag
-    bool broadcast = ((serviceOptions & 0xFFU) & 0x10U) == 0x10U;           // Broadcast Flag
-    uint8_t priority = ((serviceOptions & 0xFFU) & 0x03U);                  // Priority
-
     if (dstId == DMR_WUID_ALL) {
         return true; // do not generate grant packets for $FFFF (All Call) TGID
     }
@@ -896,160 +896,156 @@ bool ControlSignaling::writeRF_CSBK_Grant(uint32_t srcId, uint32_t dstId, uint8_
         }
     }
 
-    if (grp) {
-        if (!net) {
+    if (!net) {
+        if (grp) {
             ::ActivityLog("DMR", true, "Slot %u group grant request from %u to TG %u", m_tscc->m_slotNo, srcId, dstId);
         }
-
-        // callback REST API to permit the granted TG on the specified voice channel
-        if (m_tscc->m_authoritative && m_tscc->m_supervisor) {
-            ::lookups::VoiceChData voiceChData = m_tscc->m_affiliations->getRFChData(chNo);
-            if (voiceChData.isValidCh() && !voiceChData.address().empty() && voiceChData.port() > 0) {
-                json::object req = json::object();
-                int state = modem::DVM_STATE::STATE_DMR;
-                req["state"].set<int>(state);
-                req["dstId"].set<uint32_t>(dstId);
-                req["slot"].set<uint8_t>(slot);
-
-                int ret = RESTClient::send(voiceChData.address(), voiceChData.port(), voiceChData.password(),
-                    HTTP_PUT, PUT_PERMIT_TG, req, m_tscc->m_debug);
-                if (ret != network::rest::http::HTTPPayload::StatusType::OK) {
-                    ::LogError(LOG_RF, "DMR Slot %u, DT_CSBK, CSBKO_RAND (Random Access), failed to permit TG for use, chNo = %u, slot = %u", m_tscc->m_slotNo, chNo, slot);
-                    m_tscc->m_affiliations->releaseGrant(dstId, false);
-                    if (!net) {
-                        writeRF_CSBK_ACK_RSP(srcId, TS_DENY_RSN_TGT_BUSY, (grp) ? 1U : 0U);
-                        m_slot->m_rfState = RS_RF_REJECTED;
-                    }
-
-                    return false;
-                }
-            }
-            else {
-                ::LogError(LOG_RF, "DMR Slot %u, DT_CSBK, CSBKO_RAND (Random Access), failed to permit TG for use, chNo = %u, slot = %u", m_tscc->m_slotNo, chNo, slot);
-            }
+        else {
+            ::ActivityLog("DMR", true, "Slot %u individual grant request from %u to TG %u", m_tscc->m_slotNo, srcId, dstId);
         }
+    }
 
-        writeRF_CSBK_ACK_RSP(srcId, TS_ACK_RSN_MSG, (grp) ? 1U : 0U);
+    // callback REST API to permit the granted TG on the specified voice channel
+    if (m_tscc->m_authoritative && m_tscc->m_supervisor) {
+        ::lookups::VoiceChData voiceChData = m_tscc->m_affiliations->getRFChData(chNo);
+        if (voiceChData.isValidCh() && !voiceChData.address().empty() && voiceChData.port() > 0) {
+            // the radio retried its request while the permit is in flight; the grant goes out once it completes
+            auto pending = m_pendingPermits.find(dstId);
+            if (pending != m_pendingPermits.end() && pending->second == std::make_tuple(chNo, slot)) {
+                return true;
+            }
 
-        std::unique_ptr<CSBK_TV_GRANT> csbk = new_unique(CSBK_TV_GRANT);
-        if (broadcast)
-            csbk->setCSBKO(CSBKO_BTV_GRANT);
-        csbk->setLogicalCh1(chNo);
-        csbk->setSlotNo(slot);
+            json::object req = json::object();
+            int state = modem::DVM_STATE::STATE_DMR;
+            req["state"].set<int>(state);
+            req["dstId"].set<uint32_t>(dstId);
+            req["slot"].set<uint8_t>(slot);
+
+            // the grant is held back until the voice channel accepts the permit, without blocking the
+            // RF path on the request; the completion then transmits either the grant or the deny
+            m_pendingPermits[dstId] = std::make_tuple(chNo, slot);
+            uint64_t permitStart = Metrics::now();
+            RESTClientPool::CompletionCallback permitted = [this, m_tscc, srcId, dstId, serviceOptions, grp, net, chNo, slot, permitStart](int ret, const json::object&) {
+                Metrics::observe(METRIC_DMR_PERMIT_LATENCY, Metrics::now() - permitStart);
+
+                // a later permit for the destination (on another channel) supersedes this one
+                auto pending = m_pendingPermits.find(dstId);
+                if (pending == m_pendingPermits.end() || pending->second != std::make_tuple(chNo, slot)) {
+                    return;
+                }
+                m_pendingPermits.erase(pending);
 
-        if (m_verbose) {
-            LogMessage((net) ? LOG_NET : LOG_RF, "DMR Slot %u, DT_CSBK, %s, emerg = %u, privacy = %u, broadcast = %u, prio = %u, chNo = %u, slot = %u, srcId = %u, dstId = %u",
-                m_tscc->m_slotNo, csbk->toString().c_str(), emergency, privacy, broadcast, priority, csbk->getLogicalCh1(), csbk->getSlotNo(), srcId, dstId);
-        }
+                bool granted = m_tscc->m_affiliations->getGrantedCh(dstId) == chNo &&
+                    m_tscc->m_affiliations->getGrantedSlot(dstId) == slot;
+                if (ret == network::rest::http::HTTPPayload::StatusType::OK && granted) {
+                    writeRF_CSBK_Voice_Grant(srcId, dstId, serviceOptions, grp, net, chNo, slot);
+                    return;
+                }
 
-        csbk->setEmergency(emergency);
-        csbk->setSrcId(srcId);
-        csbk->setDstId(dstId);
+                if (!granted) {
+                    ::LogWarning(LOG_RF, "DMR Slot %u, DT_CSBK, CSBKO_RAND (Random Access), grant released before the TG was permitted, chNo = %u, slot = %u, dstId = %u", m_tscc->m_slotNo, chNo, slot, dstId);
+                }
+                else {
+                    ::LogError(LOG_RF, "DMR Slot %u, DT_CSBK, CSBKO_RAND (Random Access), failed to permit TG for use, chNo = %u, slot = %u", m_tscc->m_slotNo, chNo, slot);
+                    m_tscc->m_affiliations->releaseGrant(dstId, false);
+                }
 
-        // transmit group grant (x2)
-        for (uint8_t i = 0; i < 2U; i++)
-            writeRF_CSBK_Imm(csbk.get());
+                if (!net) {
+                    writeRF_CSBK_ACK_RSP(srcId, TS_DENY_RSN_TGT_BUSY, (grp) ? 1U : 0U);
 
-        // if the channel granted isn't the same as the TSCC; remote activate the payload channel
-        if (chNo != m_tscc->m_channelNo) {
-            ::lookups::VoiceChData voiceChData = m_tscc->m_affiliations->getRFChData(chNo);
-            if (voiceChData.isValidCh() && !voiceChData.address().empty() && voiceChData.port() > 0) {
-                json::object req = json::object();
-                req["dstId"].set<uint32_t>(dstId);
-                req["srcId"].set<uint32_t>(srcId);
-                req["slot"].set<uint8_t>(slot);
-                req["group"].set<bool>(grp);
-                bool voice = true;
-                req["voice"].set<bool>(voice);
+                    // don't disturb traffic the slot has picked up since the request
+                    if (m_slot->m_rfState == RS_RF_LISTENING) {
+                        m_slot->m_rfState = RS_RF_REJECTED;
+                    }
+                }
+            };
 
-                RESTClient::send(voiceChData.address(), voiceChData.port(), voiceChData.password(),
-                                 HTTP_PUT, PUT_DMR_TSCC_PAYLOAD_ACT, req, m_tscc->m_debug);
-            }
-            else {
-                ::LogError(LOG_RF, "DMR Slot %u, DT_CSBK, CSBKO_RAND (Random Access), failed to activate payload channel, chNo = %u, slot = %u", m_tscc->m_slotNo, chNo, slot);
+            if (!RESTClientPool::send(voiceChData.address(), voiceChData.port(), voiceChData.password(),
+                HTTP_PUT, PUT_PERMIT_TG, req, permitted, m_tscc->m_debug)) {
+                permitted(ERRNO_INTERNAL_ERROR, json::object());
             }
+
+            // without a running client pool the completion has already run
+            return m_tscc->m_affiliations->isGranted(dstId);
         }
         else {
-            m_slot->m_dmr->tsccActivateSlot(slot, dstId, srcId, grp, true);
+            ::LogError(LOG_RF, "DMR Slot %u, DT_CSBK, CSBKO_RAND (Random Access), failed to permit TG for use, chNo = %u, slot = %u", m_tscc->m_slotNo, chNo, slot);
         }
     }
-    else {
-        if (!net) {
-            ::ActivityLog("DMR", true, "Slot %u individual grant request from %u to TG %u", m_tscc->m_slotNo, srcId, dstId);
-        }
 
-        // callback REST API to permit the granted TG on the specified voice channel
-        if (m_tscc->m_authoritative && m_tscc->m_supervisor) {
-            ::lookups::VoiceChData voiceChData = m_tscc->m_affiliations->getRFChData(chNo);
-            if (voiceChData.isValidCh() && !voiceChData.address().empty() && voiceChData.port() > 0) {
-                json::object req = json::object();
-                int state = modem::DVM_STATE::STATE_DMR;
-                req["state"].set<int>(state);
-                req["dstId"].set<uint32_t>(dstId);
-                req["slot"].set<uint8_t>(slot);
-
-                int ret = RESTClient::send(voiceChData.address(), voiceChData.port(), voiceChData.password(),
-                    HTTP_PUT, PUT_PERMIT_TG, req, m_tscc->m_debug);
-                if (ret != network::rest::http::HTTPPayload::StatusType::OK) {
-                    ::LogError(LOG_RF, "DMR Slot %u, DT_CSBK, CSBKO_RAND (Random Access), failed to permit TG for use, chNo = %u, slot = %u", m_tscc->m_slotNo, chNo, slot);
-                    m_tscc->m_affiliations->releaseGrant(dstId, false);
-                    if (!net) {
-                        writeRF_CSBK_ACK_RSP(srcId, TS_DENY_RSN_TGT_BUSY, (grp) ? 1U : 0U);
-                        m_slot->m_rfState = RS_RF_REJECTED;
-                    }
+    writeRF_CSBK_Voice_Grant(srcId, dstId, serviceOptions, grp, net, chNo, slot);
+    return true;
+}
 
-                    return false;
-                }
-            }
-            else {
-                ::LogError(LOG_RF, "DMR Slot %u, DT_CSBK, CSBKO_RAND (Random Access), failed to permit TG for use, chNo = %u, slot = %u", m_tscc->m_slotNo, chNo, slot);
-            }
-        }
+/// <summary>
+/// Helper to write a voice grant packet for a permitted channel grant.
+/// </summary>
+/// <param name="srcId"></param>
+/// <param name="dstId"></param>
+/// <param name="serviceOptions"></param>
+/// <param name="grp"></param>
+/// <param name="net"></param>
+/// <param name="chNo"></param>
+/// <param name="slot"></param>
+void ControlSignaling::writeRF_CSBK_Voice_Grant(uint32_t srcId, uint32_t dstId, uint8_t serviceOptions, bool grp, bool net, uint32_t chNo, uint8_t slot)
+{
+    Slot *m_tscc = m_slot->m_dmr->getTSCCSlot();
 
-        writeRF_CSBK_ACK_RSP(srcId, TS_ACK_RSN_MSG, (grp) ? 1U : 0U);
+    bool emergency = ((serviceOptions & 0xFFU) & 0x80U) == 0x80U;           // Emergency Flag
+    bool privacy = ((serviceOptions & 0xFFU) & 0x40U) == 0x40U;             // Privacy Flag
+    bool broadcast = ((serviceOptions & 0xFFU) & 0x10U) == 0x10U;           // Broadcast Flag
+    uint8_t priority = ((serviceOptions & 0xFFU) & 0x03U);                  // Priority
 
-        std::unique_ptr<CSBK_PV_GRANT> csbk = new_unique(CSBK_PV_GRANT);
-        csbk->setLogicalCh1(chNo);
-        csbk->setSlotNo(slot);
+    writeRF_CSBK_ACK_RSP(srcId, TS_ACK_RSN_MSG, (grp) ? 1U : 0U);
 
-        if (m_verbose) {
-            LogMessage((net) ? LOG_NET : LOG_RF, "DMR Slot %u, DT_CSBK, %s, emerg = %u, privacy = %u, broadcast = %u, prio = %u, chNo = %u, slot = %u, srcId = %u, dstId = %u",
-                m_tscc->m_slotNo, csbk->toString().c_str(), emergency, privacy, broadcast, priority, csbk->getLogicalCh1(), csbk->getSlotNo(), srcId, dstId);
-        }
+    std::unique_ptr<lc::CSBK> csbk = nullptr;
+    if (grp) {
+        csbk = new_unique(CSBK_TV_GRANT);
+        if (broadcast)
+            csbk->setCSBKO(CSBKO_BTV_GRANT);
+    }
+    else {
+        csbk = new_unique(CSBK_PV_GRANT);
+    }
 
-        csbk->setEmergency(emergency);
-        csbk->setSrcId(srcId);
-        csbk->setDstId(dstId);
+    csbk->setLogicalCh1(chNo);
+    csbk->setSlotNo(slot);
 
-        // transmit private grant (x2)
-        for (uint8_t i = 0; i < 2U; i++)
-            writeRF_CSBK_Imm(csbk.get());
+    if (m_verbose) {
+        LogMessage((net) ? LOG_NET : LOG_RF, "DMR Slot %u, DT_CSBK, %s, emerg = %u, privacy = %u, broadcast = %u, prio = %u, chNo = %u, slot = %u, srcId = %u, dstId = %u",
+            m_tscc->m_slotNo, csbk->toString().c_str(), emergency, privacy, broadcast, priority, csbk->getLogicalCh1(), csbk->getSlotNo(), srcId, dstId);
+    }
 
-        // if the channel granted isn't the same as the TSCC; remote activate the payload channel
-        if (chNo != m_tscc->m_channelNo) {
-            ::lookups::VoiceChData voiceChData = m_tscc->m_affiliations->getRFChData(chNo);
-            if (voiceChData.isValidCh() && !voiceChData.address().empty() && voiceChData.port() > 0) {
-                json::object req = json::object();
-                req["dstId"].set<uint32_t>(dstId);
-                req["srcId"].set<uint32_t>(srcId);
-                req["slot"].set<uint8_t>(slot);
-                req["group"].set<bool>(grp);
-                bool voice = true;
-                req["voice"].set<bool>(voice);
+    csbk->setEmergency(emergency);
+    csbk->setSrcId(srcId);
+    csbk->setDstId(dstId);
 
-                RESTClient::send(voiceChData.address(), voiceChData.port(), voiceChData.password(),
-                    HTTP_PUT, PUT_DMR_TSCC_PAYLOAD_ACT, req, m_tscc->m_debug);
-            }
-            else {
-                ::LogError(LOG_RF, "DMR Slot %u, DT_CSBK, CSBKO_RAND (Random Access), failed to activate payload channel, chNo = %u, slot = %u", m_tscc->m_slotNo, chNo, slot);
-            }
+    // transmit group/private grant (x2)
+    for (uint8_t i = 0; i < 2U; i++)
+        writeRF_CSBK_Imm(csbk.get());
+
+    // if the channel granted isn't the same as the TSCC; remote activate the payload channel
+    if (chNo != m_tscc->m_channelNo) {
+        ::lookups::VoiceChData voiceChData = m_tscc->m_affiliations->getRFChData(chNo);
+        if (voiceChData.isValidCh() && !voiceChData.address().empty() && voiceChData.port() > 0) {
+            json::object req = json::object();
+            req["dstId"].set<uint32_t>(dstId);
+            req["srcId"].set<uint32_t>(srcId);
+            req["slot"].set<uint8_t>(slot);
+            req["group"].set<bool>(grp);
+            bool voice = true;
+            req["voice"].set<bool>(voice);
+
+            RESTClientPool::send(voiceChData.address(), voiceChData.port(), voiceChData.password(),
+                HTTP_PUT, PUT_DMR_TSCC_PAYLOAD_ACT, req, nullptr, m_tscc->m_debug);
         }
         else {
-            m_slot->m_dmr->tsccActivateSlot(slot, dstId, srcId, grp, true);
+            ::LogError(LOG_RF, "DMR Slot %u, DT_CSBK, CSBKO_RAND (Random Access), failed to activate payload channel, chNo = %u, slot = %u", m_tscc->m_slotNo, chNo, slot);
         }
     }
-
-    return true;
+    else {
+        m_slot->m_dmr->tsccActivateSlot(slot, dstId, srcId, grp, true);
+    }
 }
 
 /// <summary>
@@ -1195,8 +1191,8 @@ bool ControlSignaling::writeRF_CSBK_Data_Grant(uint32_t srcId, uint32_t dstId, u
                 bool voice = false;
                 req["voice"].set<bool>(voice);
 
-                RESTClient::send(voiceChData.address(), voiceChData.port(), voiceChData.password(),
-                    HTTP_PUT, PUT_DMR_TSCC_PAYLOAD_ACT, req, m_tscc->m_debug);
+                RESTClientPool::send(voiceChData.address(), voiceChData.port(), voiceChData.password(),
+                    HTTP_PUT, PUT_DMR_TSCC_PAYLOAD_ACT, req, nullptr, m_tscc->m_debug);
             }
             else {
                 ::LogError(LOG_RF, "DMR Slot %u, DT_CSBK, CSBKO_RAND (Random Access), failed to activate payload channel, chNo = %u, slot = %u", m_tscc->m_slotNo, chNo, slot);
@@ -1242,8 +1238,8 @@ bool ControlSignaling::writeRF_CSBK_Data_Grant(uint32_t srcId, uint32_t dstId, u
                 bool voice = false;
                 req["voice"].set<bool>(voice);
 
-                RESTClient::send(voiceChData.address(), voiceChData.port(), voiceChData.password(),
-                    HTTP_PUT, PUT_DMR_TSCC_PAYLOAD_ACT, req, m_tscc->m_debug);
+                RESTClientPool::send(voiceChData.address(), voiceChData.port(), voiceChData.password(),
+                    HTTP_PUT, PUT_DMR_TSCC_PAYLOAD_ACT, req, nullptr, m_tscc->m_debug);
             }
             else {
                 ::LogError(LOG_RF, "DMR Slot %u, DT_CSBK, CSBKO_RAND (Random Access), failed to activate payload channel, chNo = %u, slot = %u", m_tscc->m_slotNo, chNo, slot);
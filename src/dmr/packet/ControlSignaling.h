@@ -42,6 +42,8 @@
 #include "StopWatch.h"
 #include "Timer.h"
 
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 
 namespace dmr
@@ -80,6 +82,8 @@ namespace dmr
             bool m_verbose;
             bool m_debug;
 
+            std::unordered_map<uint32_t, std::tuple<uint32_t, uint8_t>> m_pendingPermits;
+
             /// <summary>Initializes a new instance of the ControlSignaling class.</summary>
             ControlSignaling(Slot* slot, network::BaseNetwork* network, bool dumpCSBKData, bool debug, bool verbose);
             /// <summary>Finalizes a instance of the ControlSignaling class.</summary>
@@ -96,6 +100,8 @@ namespace dmr
             void writeRF_CSBK_NACK_RSP(uint32_t dstId, uint8_t reason, uint8_t service);
             /// <summary>Helper to write a grant packet.</summary>
             bool writeRF_CSBK_Grant(uint32_t srcId, uint32_t dstId, uint8_t serviceOptions, bool grp, bool net = false, bool skip = false, uint32_t chNo = 0U);
+            /// <summary>Helper to write a voice grant packet for a permitted channel grant.</summary>
+            void writeRF_CSBK_Voice_Grant(uint32_t srcId, uint32_t dstId, uint8_t serviceOptions, bool grp, bool net, uint32_t chNo, uint8_t slot);
             /// <summary>Helper to write a data grant packet.</summary>
             bool writeRF_CSBK_Data_Grant(uint32_t srcId, uint32_t dstId, uint8_t serviceOptions, bool grp, bool net = false, bool skip = false, uint32_t chNo = 0U);
             /// <summary>Helper to write a unit registration response packet.</summary>
@@ -39,219 +39,194 @@ using namespace edac;
 
 #include <cstdio>
 #include <cassert>
+#include <cstring>
 
 // ---------------------------------------------------------------------------
-//  Public Class Members
+//  Constants
 // ---------------------------------------------------------------------------
 
+const uint32_t IMBE_PRNG_MUL = 173U;
+const uint32_t IMBE_PRNG_ADD = 13849U;
+const uint32_t IMBE_PRNG_WHITENED_BITS = 114U;
+const uint32_t IMBE_PRNG_START = 23U;
+
+// the whitening vector covers bits 23 - 136, held here as bits 16 - 143
+const uint32_t IMBE_WHITENING_OFFSET = 16U;
+
+// (DMR only) the second AMBE frame of a voice burst straddles the 48-bit sync/embedded
+// signalling field which begins at bit 108
+const uint32_t DMR_AMBE_FRAME2_OFFSET = 72U;
+const uint32_t DMR_AMBE_FRAME3_OFFSET = 192U;
+const uint32_t DMR_AMBE_SYNC_START = 108U;
+const uint32_t DMR_AMBE_SYNC_LENGTH = 48U;
+
+template <uint32_t N>
+struct BitSpreadTable {
+    uint64_t spread[N];
+};
+
 /// <summary>
-/// Initializes a new instance of the AMBEFEC class.
+/// Builds the table used to transpose the 6-bit groups of an IMBE frame into six
+/// byte lanes, one per row of the de-interleaved frame.
 /// </summary>
-AMBEFEC::AMBEFEC()
+/// <remarks>
+/// Group c of the transmitted frame carries bit r of row r, except that in the odd
+/// groups each adjacent pair of rows is exchanged (see IMBE_INTERLEAVE).
+/// </remarks>
+/// <param name="odd">Flag indicating the table is for odd groups.</param>
+/// <returns></returns>
+constexpr BitSpreadTable<64U> makeIMBEGroupTable(bool odd)
 {
-    /* stub */
+    BitSpreadTable<64U> t = {};
+    for (uint32_t g = 0U; g < 64U; g++) {
+        uint64_t v = 0U;
+        for (uint32_t r = 0U; r < 6U; r++) {
+            uint32_t bit = odd ? (r ^ 1U) : r;
+            if ((g & (0x20U >> bit)) != 0U)
+                v |= 1ULL << (r * 8U);
+        }
+
+        t.spread[g] = v;
+    }
+
+    return t;
 }
 
 /// <summary>
-/// Finalizes a instance of the AMBEFEC class.
+/// Builds the table used to split a byte of an AMBE frame into the four bit columns
+/// (bit n mod 4) of the frame, each column in its own 16-bit lane.
 /// </summary>
-AMBEFEC::~AMBEFEC()
+/// <returns></returns>
+constexpr BitSpreadTable<256U> makeAMBEColumnTable()
 {
-    /* stub */
+    BitSpreadTable<256U> t = {};
+    for (uint32_t v = 0U; v < 256U; v++) {
+        uint64_t s = 0U;
+        for (uint32_t k = 0U; k < 4U; k++) {
+            uint64_t lane = (((v >> (7U - k)) & 0x01U) << 1) | ((v >> (3U - k)) & 0x01U);
+            s |= lane << (k * 16U);
+        }
+
+        t.spread[v] = s;
+    }
+
+    return t;
 }
 
+struct IMBEWhiteningTable {
+    uint64_t vector[4096U][2U];
+};
+
 /// <summary>
-/// Regnerates the DMR AMBE FEC for the input bytes.
+/// Builds the table of IMBE whitening vectors, one for each value of the c0 data.
 /// </summary>
-/// <param name="bytes"></param>
-/// <returns>Count of errors.</returns>
-uint32_t AMBEFEC::regenerateDMR(uint8_t* bytes) const
+/// <returns></returns>
+constexpr IMBEWhiteningTable makeIMBEWhiteningTable()
 {
-    assert(bytes != nullptr);
-
-    uint32_t a1 = 0U, a2 = 0U, a3 = 0U;
-    uint32_t b1 = 0U, b2 = 0U, b3 = 0U;
-    uint32_t c1 = 0U, c2 = 0U, c3 = 0U;
-
-    uint32_t MASK = 0x800000U;
-    for (uint32_t i = 0U; i < 24U; i++, MASK >>= 1) {
-        uint32_t a1Pos = AMBE_A_TABLE[i];
-        uint32_t a2Pos = a1Pos + 72U;
-        if (a2Pos >= 108U)
-            a2Pos += 48U;
-        uint32_t a3Pos = a1Pos + 192U;
-
-        if (READ_BIT(bytes, a1Pos))
-            a1 |= MASK;
-        if (READ_BIT(bytes, a2Pos))
-            a2 |= MASK;
-        if (READ_BIT(bytes, a3Pos))
-            a3 |= MASK;
+    IMBEWhiteningTable t = {};
+    for (uint32_t c0data = 0U; c0data < 4096U; c0data++) {
+        uint32_t p = 16U * c0data;
+        for (uint32_t i = 0U; i < IMBE_PRNG_WHITENED_BITS; i++) {
+            p = ((IMBE_PRNG_MUL * p) + IMBE_PRNG_ADD) % 65536U;
+            if (p >= 32768U) {
+                uint32_t n = i + IMBE_PRNG_START - IMBE_WHITENING_OFFSET;
+                t.vector[c0data][n >> 6] |= 1ULL << (63U - (n & 63U));
+            }
+        }
     }
 
-    MASK = 0x400000U;
-    for (uint32_t i = 0U; i < 23U; i++, MASK >>= 1) {
-        uint32_t b1Pos = AMBE_B_TABLE[i];
-        uint32_t b2Pos = b1Pos + 72U;
-        if (b2Pos >= 108U)
-            b2Pos += 48U;
-        uint32_t b3Pos = b1Pos + 192U;
-
-        if (READ_BIT(bytes, b1Pos))
-            b1 |= MASK;
-        if (READ_BIT(bytes, b2Pos))
-            b2 |= MASK;
-        if (READ_BIT(bytes, b3Pos))
-            b3 |= MASK;
-    }
-
-	MASK = 0x1000000U;
-	for (uint32_t i = 0U; i < 25U; i++, MASK >>= 1) {
-		uint32_t c1Pos = AMBE_C_TABLE[i];
-		uint32_t c2Pos = c1Pos + 72U;
-		if (c2Pos >= 108U)
-			c2Pos += 48U;
-		uint32_t c3Pos = c1Pos + 192U;
-
-		if (READ_BIT(bytes, c1Pos))
-			c1 |= MASK;
-		if (READ_BIT(bytes, c2Pos))
-			c2 |= MASK;
-		if (READ_BIT(bytes, c3Pos))
-			c3 |= MASK;
-	}
-
-    uint32_t errors = regenerate(a1, b1, c1);
-    errors += regenerate(a2, b2, c2);
-    errors += regenerate(a3, b3, c3);
+    return t;
+}
 
-    MASK = 0x800000U;
-    for (uint32_t i = 0U; i < 24U; i++, MASK >>= 1) {
-        uint32_t a1Pos = AMBE_A_TABLE[i];
-        uint32_t a2Pos = a1Pos + 72U;
-        if (a2Pos >= 108U)
-            a2Pos += 48U;
-        uint32_t a3Pos = a1Pos + 192U;
-
-        WRITE_BIT(bytes, a1Pos, a1 & MASK);
-        WRITE_BIT(bytes, a2Pos, a2 & MASK);
-        WRITE_BIT(bytes, a3Pos, a3 & MASK);
-    }
+constexpr BitSpreadTable<64U> IMBE_EVEN_GROUP_TABLE = makeIMBEGroupTable(false);
+constexpr BitSpreadTable<64U> IMBE_ODD_GROUP_TABLE = makeIMBEGroupTable(true);
+constexpr BitSpreadTable<256U> AMBE_COLUMN_TABLE = makeAMBEColumnTable();
+constexpr IMBEWhiteningTable IMBE_WHITENING_TABLE = makeIMBEWhiteningTable();
 
-    MASK = 0x400000U;
-    for (uint32_t i = 0U; i < 23U; i++, MASK >>= 1) {
-        uint32_t b1Pos = AMBE_B_TABLE[i];
-        uint32_t b2Pos = b1Pos + 72U;
-        if (b2Pos >= 108U)
-            b2Pos += 48U;
-        uint32_t b3Pos = b1Pos + 192U;
-
-        WRITE_BIT(bytes, b1Pos, b1 & MASK);
-        WRITE_BIT(bytes, b2Pos, b2 & MASK);
-        WRITE_BIT(bytes, b3Pos, b3 & MASK);
-    }
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
 
-    MASK = 0x1000000U;
-    for (uint32_t i = 0U; i < 25U; i++, MASK >>= 1) {
-        uint32_t c1Pos = AMBE_C_TABLE[i];
-        uint32_t c2Pos = c1Pos + 72U;
-        if (c2Pos >= 108U)
-            c2Pos += 48U;
-        uint32_t c3Pos = c1Pos + 192U;
-
-        WRITE_BIT(bytes, c1Pos, c1 & MASK);
-        WRITE_BIT(bytes, c2Pos, c2 & MASK);
-        WRITE_BIT(bytes, c3Pos, c3 & MASK);
-    }
+/// <summary>
+/// Reads a field of up to 25 bits from a packed MSB first 192-bit word.
+/// </summary>
+/// <param name="w"></param>
+/// <param name="pos"></param>
+/// <param name="len"></param>
+/// <returns></returns>
+static inline uint32_t readField(const uint64_t* w, uint32_t pos, uint32_t len)
+{
+    uint32_t off = pos & 63U;
+    uint64_t v = w[pos >> 6] << off;
+    if (off + len > 64U)
+        v |= w[(pos >> 6) + 1U] >> (64U - off);
 
-    return errors;
+    return (uint32_t)(v >> (64U - len));
 }
 
 /// <summary>
-/// Returns the number of errors on the DMR BER input bytes.
+/// Writes a field of up to 25 bits into a packed MSB first 192-bit word.
 /// </summary>
-/// <param name="bytes"></param>
-/// <returns>Count of errors.</returns>
-uint32_t AMBEFEC::measureDMRBER(const uint8_t* bytes) const
+/// <param name="w"></param>
+/// <param name="pos"></param>
+/// <param name="len"></param>
+/// <param name="value"></param>
+static inline void writeField(uint64_t* w, uint32_t pos, uint32_t len, uint32_t value)
 {
-    assert(bytes != nullptr);
+    uint32_t off = pos & 63U;
+    uint64_t mask = (~0ULL >> (64U - len)) << (64U - len);
+    uint64_t v = (uint64_t)value << (64U - len);
 
-    uint32_t a1 = 0U, a2 = 0U, a3 = 0U;
-    uint32_t b1 = 0U, b2 = 0U, b3 = 0U;
-    uint32_t c1 = 0U, c2 = 0U, c3 = 0U;
-
-    uint32_t MASK = 0x800000U;
-    for (uint32_t i = 0U; i < 24U; i++, MASK >>= 1) {
-        uint32_t a1Pos = AMBE_A_TABLE[i];
-        uint32_t a2Pos = a1Pos + 72U;
-        if (a2Pos >= 108U)
-            a2Pos += 48U;
-        uint32_t a3Pos = a1Pos + 192U;
-
-        if (READ_BIT(bytes, a1Pos))
-            a1 |= MASK;
-        if (READ_BIT(bytes, a2Pos))
-            a2 |= MASK;
-        if (READ_BIT(bytes, a3Pos))
-            a3 |= MASK;
-    }
+    w[pos >> 6] = (w[pos >> 6] & ~(mask >> off)) | (v >> off);
+    if (off + len > 64U)
+        w[(pos >> 6) + 1U] = (w[(pos >> 6) + 1U] & ~(mask << (64U - off))) | (v << (64U - off));
+}
 
-    MASK = 0x400000U;
-    for (uint32_t i = 0U; i < 23U; i++, MASK >>= 1) {
-        uint32_t b1Pos = AMBE_B_TABLE[i];
-        uint32_t b2Pos = b1Pos + 72U;
-        if (b2Pos >= 108U)
-            b2Pos += 48U;
-        uint32_t b3Pos = b1Pos + 192U;
-
-        if (READ_BIT(bytes, b1Pos))
-            b1 |= MASK;
-        if (READ_BIT(bytes, b2Pos))
-            b2 |= MASK;
-        if (READ_BIT(bytes, b3Pos))
-            b3 |= MASK;
+/// <summary>
+/// De-interleaves an IMBE frame into a packed 192-bit word.
+/// </summary>
+/// <remarks>
+/// The 144 transmitted bits are 24 groups of 6 bits; row r of the de-interleaved frame
+/// (bits r * 24 to r * 24 + 23) is made of one bit from every group. Each run of 8 groups
+/// (6 bytes) is transposed at once into six byte lanes, one lane per row.
+/// </remarks>
+/// <param name="in">IMBE frame.</param>
+/// <param name="out">Packed de-interleaved frame.</param>
+static inline void deinterleaveIMBE(const uint8_t* in, uint64_t* out)
+{
+    uint64_t rows[6U] = { 0U, 0U, 0U, 0U, 0U, 0U };
+    for (uint32_t q = 0U; q < 3U; q++) {
+        const uint8_t* p = in + (q * 6U);
+        uint64_t w = ((uint64_t)p[0U] << 40) | ((uint64_t)p[1U] << 32) | ((uint64_t)p[2U] << 24) |
+            ((uint64_t)p[3U] << 16) | ((uint64_t)p[4U] << 8) | (uint64_t)p[5U];
+
+        uint64_t acc = 0U;
+        for (uint32_t m = 0U; m < 8U; m += 2U) {
+            acc = (acc << 1) | IMBE_EVEN_GROUP_TABLE.spread[(w >> (42U - (m * 6U))) & 0x3FU];
+            acc = (acc << 1) | IMBE_ODD_GROUP_TABLE.spread[(w >> (36U - (m * 6U))) & 0x3FU];
+        }
+
+        for (uint32_t r = 0U; r < 6U; r++)
+            rows[r] = (rows[r] << 8) | ((acc >> (r * 8U)) & 0xFFU);
     }
 
-	MASK = 0x1000000U;
-	for (uint32_t i = 0U; i < 25U; i++, MASK >>= 1) {
-		uint32_t c1Pos = AMBE_C_TABLE[i];
-		uint32_t c2Pos = c1Pos + 72U;
-		if (c2Pos >= 108U)
-			c2Pos += 48U;
-		uint32_t c3Pos = c1Pos + 192U;
-
-		if (READ_BIT(bytes, c1Pos))
-			c1 |= MASK;
-		if (READ_BIT(bytes, c2Pos))
-			c2 |= MASK;
-		if (READ_BIT(bytes, c3Pos))
-			c3 |= MASK;
-	}
-
-    uint32_t errors = regenerate(a1, b1, c1);
-    errors += regenerate(a2, b2, c2);
-    errors += regenerate(a3, b3, c3);
-
-    return errors;
+    out[0U] = (rows[0U] << 40) | (rows[1U] << 16) | (rows[2U] >> 8);
+    out[1U] = (rows[2U] << 56) | (rows[3U] << 32) | (rows[4U] << 8) | (rows[5U] >> 16);
+    out[2U] = rows[5U] << 48;
 }
 
 /// <summary>
-/// Regenerates the P25 IMBE FEC for the input bytes.
+/// Checks and fixes the FEC of a packed de-interleaved IMBE frame.
 /// </summary>
-/// <param name="bytes"></param>
+/// <param name="bytes">IMBE frame.</param>
+/// <param name="diff">Packed de-interleaved bits changed by the FEC.</param>
 /// <returns>Count of errors.</returns>
-uint32_t AMBEFEC::regenerateIMBE(uint8_t* bytes) const
+static uint32_t decodeIMBE(const uint8_t* bytes, uint64_t* diff)
 {
-    assert(bytes != nullptr);
+    uint64_t orig[3U];
+    deinterleaveIMBE(bytes, orig);
 
-    bool orig[144U];
-    bool temp[144U];
-
-    // De-interleave
-    for (uint32_t i = 0U; i < 144U; i++) {
-        uint32_t n = IMBE_INTERLEAVE[i];
-        orig[i] = temp[i] = READ_BIT(bytes, n);
-    }
+    uint64_t temp[3U] = { orig[0U], orig[1U], orig[2U] };
 
     // now ..
 
@@ -280,233 +255,264 @@ uint32_t AMBEFEC::regenerateIMBE(uint8_t* bytes) const
 
     // Process the c0 section first to allow the de-whitening to be accurate
 
-    // Check/Fix FEC
-    bool* bit = temp;
-
-    // c0
-    uint32_t g1 = 0U;
-    for (uint32_t i = 0U; i < 23U; i++)
-        g1 = (g1 << 1) | (bit[i] ? 0x01U : 0x00U);
-    uint32_t c0data = Golay24128::decode23127(g1);
-    uint32_t g2 = Golay24128::encode23127(c0data);
-    for (int i = 23; i >= 0; i--) {
-        bit[i] = (g2 & 0x01U) == 0x01U;
-        g2 >>= 1;
-    }
-    bit += 23U;
-
-    bool prn[114U];
+    // c0 (the encoded Golay word is 24 bits wide, its trailing zero overwrites the
+    // first bit of c1 exactly as the bit-wise implementation always has)
+    uint32_t c0data = Golay24128::decode23127(readField(temp, 0U, 23U));
+    writeField(temp, 0U, 24U, Golay24128::encode23127(c0data));
 
-    // Create the whitening vector and save it for future use
-    uint32_t p = 16U * c0data;
-    for (uint32_t i = 0U; i < 114U; i++) {
-        p = (173U * p + 13849U) % 65536U;
-        prn[i] = p >= 32768U;
-    }
+    // Fetch the whitening vector
+    const uint64_t* prn = IMBE_WHITENING_TABLE.vector[c0data];
+    uint64_t w[3U] = {
+        prn[0U] >> IMBE_WHITENING_OFFSET,
+        (prn[0U] << (64U - IMBE_WHITENING_OFFSET)) | (prn[1U] >> IMBE_WHITENING_OFFSET),
+        prn[1U] << (64U - IMBE_WHITENING_OFFSET) };
 
     // De-whiten some bits
-    for (uint32_t i = 0U; i < 114U; i++)
-        temp[i + 23U] ^= prn[i];
-
-    // c1
-    g1 = 0U;
-    for (uint32_t i = 0U; i < 23U; i++)
-        g1 = (g1 << 1) | (bit[i] ? 0x01U : 0x00U);
-    uint32_t c1data = Golay24128::decode23127(g1);
-    g2 = Golay24128::encode23127(c1data);
-    for (int i = 23; i >= 0; i--) {
-        bit[i] = (g2 & 0x01U) == 0x01U;
-        g2 >>= 1;
+    for (uint32_t i = 0U; i < 3U; i++)
+        temp[i] ^= w[i];
+
+    // c1 - c3
+    for (uint32_t pos = 23U; pos < 92U; pos += 23U) {
+        uint32_t data = Golay24128::decode23127(readField(temp, pos, 23U));
+        writeField(temp, pos, 24U, Golay24128::encode23127(data));
     }
-    bit += 23U;
-
-    // c2
-    g1 = 0;
-    for (uint32_t i = 0U; i < 23U; i++)
-        g1 = (g1 << 1) | (bit[i] ? 0x01U : 0x00U);
-    uint32_t c2data = Golay24128::decode23127(g1);
-    g2 = Golay24128::encode23127(c2data);
-    for (int i = 23; i >= 0; i--) {
-        bit[i] = (g2 & 0x01U) == 0x01U;
-        g2 >>= 1;
+
+    // c4 - c6
+    for (uint32_t pos = 92U; pos < 137U; pos += 15U) {
+        uint32_t code = readField(temp, pos, 15U);
+        Hamming::decode15113_1(code);
+        writeField(temp, pos, 15U, code);
     }
-    bit += 23U;
-
-    // c3
-    g1 = 0U;
-    for (uint32_t i = 0U; i < 23U; i++)
-        g1 = (g1 << 1) | (bit[i] ? 0x01U : 0x00U);
-    uint32_t c3data = Golay24128::decode23127(g1);
-    g2 = Golay24128::encode23127(c3data);
-    for (int i = 23; i >= 0; i--) {
-        bit[i] = (g2 & 0x01U) == 0x01U;
-        g2 >>= 1;
+
+    // Whiten some bits
+    uint32_t errors = 0U;
+    for (uint32_t i = 0U; i < 3U; i++) {
+        diff[i] = orig[i] ^ temp[i] ^ w[i];
+        if (diff[i] != 0U)
+            errors += Utils::countBits64(diff[i]);
     }
-    bit += 23U;
 
-    // c4
-    Hamming::decode15113_1(bit);
-    bit += 15U;
+    return errors;
+}
 
-    // c5
-    Hamming::decode15113_1(bit);
-    bit += 15U;
+/// <summary>
+/// Splits a 72-bit AMBE frame into its A, B and C words.
+/// </summary>
+/// <remarks>
+/// AMBE_A_TABLE, AMBE_B_TABLE and AMBE_C_TABLE walk the frame column by column (bit n
+/// mod 4); concatenating the four 18-bit columns gives A (24 bits), B (23 bits) and
+/// C (25 bits).
+/// </remarks>
+/// <param name="in">AMBE frame.</param>
+/// <param name="a"></param>
+/// <param name="b"></param>
+/// <param name="c"></param>
+static inline void extractAMBE(const uint8_t* in, uint32_t& a, uint32_t& b, uint32_t& c)
+{
+    uint64_t acc = 0U;
+    for (uint32_t i = 0U; i < 8U; i++)
+        acc = (acc << 2) | AMBE_COLUMN_TABLE.spread[in[i]];
 
-    // c6
-    Hamming::decode15113_1(bit);
+    uint64_t tail = AMBE_COLUMN_TABLE.spread[in[8U]];
 
-    // Whiten some bits
-    for (uint32_t i = 0U; i < 114U; i++)
-        temp[i + 23U] ^= prn[i];
+    uint32_t col[4U];
+    for (uint32_t k = 0U; k < 4U; k++)
+        col[k] = (uint32_t)((((acc >> (k * 16U)) & 0xFFFFU) << 2) | ((tail >> (k * 16U)) & 0x03U));
 
-    uint32_t errors = 0U;
-    for (uint32_t i = 0U; i < 144U; i++) {
-        if (orig[i] != temp[i])
-            errors++;
-    }
+    a = (col[0U] << 6) | (col[1U] >> 12);
+    b = ((col[1U] & 0xFFFU) << 11) | (col[2U] >> 7);
+    c = ((col[2U] & 0x7FU) << 18) | col[3U];
+}
+
+/// <summary>
+/// Gathers the second AMBE frame of a DMR voice burst, which straddles the sync/embedded
+/// signalling field, into a contiguous 72-bit frame.
+/// </summary>
+/// <param name="bytes">DMR voice burst.</param>
+/// <param name="frame">AMBE frame.</param>
+static inline void gatherDMRFrame2(const uint8_t* bytes, uint8_t* frame)
+{
+    // both halves of the frame begin and end on a nibble boundary
+    ::memcpy(frame, bytes + (DMR_AMBE_FRAME2_OFFSET / 8U), 4U);
+    frame[4U] = (bytes[DMR_AMBE_SYNC_START / 8U] & 0xF0U) | (bytes[(DMR_AMBE_SYNC_START + DMR_AMBE_SYNC_LENGTH) / 8U] & 0x0FU);
+    ::memcpy(frame + 5U, bytes + ((DMR_AMBE_SYNC_START + DMR_AMBE_SYNC_LENGTH) / 8U) + 1U, 4U);
+}
+
+/// <summary>
+/// Inverts the bits of a word of an AMBE frame.
+/// </summary>
+/// <param name="bytes"></param>
+/// <param name="diff">Bits to invert.</param>
+/// <param name="width">Width of the word.</param>
+/// <param name="table">Bit positions of the word.</param>
+/// <param name="offset">Offset of the AMBE frame.</param>
+/// <param name="split">Flag indicating the frame straddles the DMR sync/embedded signalling.</param>
+static void flipAMBEBits(uint8_t* bytes, uint32_t diff, uint32_t width, const uint32_t* table, uint32_t offset, bool split)
+{
+    for (uint32_t i = 0U; diff != 0U && i < width; i++) {
+        uint32_t mask = 1U << (width - 1U - i);
+        if ((diff & mask) == 0U)
+            continue;
+
+        diff &= ~mask;
 
-    // Interleave
-    for (uint32_t i = 0U; i < 144U; i++) {
-        uint32_t n = IMBE_INTERLEAVE[i];
-        WRITE_BIT(bytes, n, temp[i]);
+        uint32_t pos = table[i] + offset;
+        if (split && pos >= DMR_AMBE_SYNC_START)
+            pos += DMR_AMBE_SYNC_LENGTH;
+
+        bytes[pos >> 3] ^= BIT_MASK_TABLE[pos & 7U];
     }
+}
 
-    return errors;
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Initializes a new instance of the AMBEFEC class.
+/// </summary>
+AMBEFEC::AMBEFEC()
+{
+    /* stub */
 }
 
 /// <summary>
-/// Returns the number of errors on the P25 BER input bytes.
+/// Finalizes a instance of the AMBEFEC class.
+/// </summary>
+AMBEFEC::~AMBEFEC()
+{
+    /* stub */
+}
+
+/// <summary>
+/// Regnerates the DMR AMBE FEC for the input bytes.
 /// </summary>
 /// <param name="bytes"></param>
 /// <returns>Count of errors.</returns>
-uint32_t AMBEFEC::measureP25BER(const uint8_t* bytes) const
+uint32_t AMBEFEC::regenerateDMR(uint8_t* bytes) const
 {
     assert(bytes != nullptr);
 
-    bool orig[144U];
-    bool temp[144U];
+    uint8_t frame2[9U];
+    gatherDMRFrame2(bytes, frame2);
+
+    uint32_t a1, a2, a3;
+    uint32_t b1, b2, b3;
+    uint32_t c1, c2, c3;
+    extractAMBE(bytes, a1, b1, c1);
+    extractAMBE(frame2, a2, b2, c2);
+    extractAMBE(bytes + (DMR_AMBE_FRAME3_OFFSET / 8U), a3, b3, c3);
+
+    uint32_t old[9U] = { a1, b1, c1, a2, b2, c2, a3, b3, c3 };
 
-    // De-interleave
-    for (uint32_t i = 0U; i < 144U; i++) {
-        uint32_t n = IMBE_INTERLEAVE[i];
-        orig[i] = temp[i] = READ_BIT(bytes, n);
+    uint32_t errors = regenerate(a1, b1, c1);
+    errors += regenerate(a2, b2, c2);
+    errors += regenerate(a3, b3, c3);
+
+    // only the bits changed by the FEC need be written back
+    const uint32_t offsets[3U] = { 0U, DMR_AMBE_FRAME2_OFFSET, DMR_AMBE_FRAME3_OFFSET };
+    const uint32_t words[9U] = { a1, b1, c1, a2, b2, c2, a3, b3, c3 };
+    for (uint32_t n = 0U; n < 3U; n++) {
+        bool split = (n == 1U);
+        flipAMBEBits(bytes, words[(n * 3U) + 0U] ^ old[(n * 3U) + 0U], 24U, AMBE_A_TABLE, offsets[n], split);
+        flipAMBEBits(bytes, words[(n * 3U) + 1U] ^ old[(n * 3U) + 1U], 23U, AMBE_B_TABLE, offsets[n], split);
+        flipAMBEBits(bytes, words[(n * 3U) + 2U] ^ old[(n * 3U) + 2U], 25U, AMBE_C_TABLE, offsets[n], split);
     }
 
-    // now ..
+    return errors;
+}
 
-    // 12 voice bits     0
-    // 11 golay bits     12
-    //
-    // 12 voice bits     23
-    // 11 golay bits     35
-    //
-    // 12 voice bits     46
-    // 11 golay bits     58
-    //
-    // 12 voice bits     69
-    // 11 golay bits     81
-    //
-    // 11 voice bits     92
-    //  4 hamming bits   103
-    //
-    // 11 voice bits     107
-    //  4 hamming bits   118
-    //
-    // 11 voice bits     122
-    //  4 hamming bits   133
-    //
-    //  7 voice bits     137
+/// <summary>
+/// Returns the number of errors on the DMR BER input bytes.
+/// </summary>
+/// <param name="bytes"></param>
+/// <returns>Count of errors.</returns>
+uint32_t AMBEFEC::measureDMRBER(const uint8_t* bytes) const
+{
+    assert(bytes != nullptr);
 
-    // Process the c0 section first to allow the de-whitening to be accurate
+    uint8_t frame2[9U];
+    gatherDMRFrame2(bytes, frame2);
 
-    // Check/Fix FEC
-    bool* bit = temp;
-
-    // c0
-    uint32_t g1 = 0U;
-    for (uint32_t i = 0U; i < 23U; i++)
-        g1 = (g1 << 1) | (bit[i] ? 0x01U : 0x00U);
-    uint32_t c0data = Golay24128::decode23127(g1);
-    uint32_t g2 = Golay24128::encode23127(c0data);
-    for (int i = 23; i >= 0; i--) {
-        bit[i] = (g2 & 0x01U) == 0x01U;
-        g2 >>= 1;
-    }
-    bit += 23U;
+    uint32_t a1, a2, a3;
+    uint32_t b1, b2, b3;
+    uint32_t c1, c2, c3;
+    extractAMBE(bytes, a1, b1, c1);
+    extractAMBE(frame2, a2, b2, c2);
+    extractAMBE(bytes + (DMR_AMBE_FRAME3_OFFSET / 8U), a3, b3, c3);
 
-    bool prn[114U];
+    uint32_t errors = regenerate(a1, b1, c1);
+    errors += regenerate(a2, b2, c2);
+    errors += regenerate(a3, b3, c3);
 
-    // Create the whitening vector and save it for future use
-    uint32_t p = 16U * c0data;
-    for (uint32_t i = 0U; i < 114U; i++) {
-        p = (173U * p + 13849U) % 65536U;
-        prn[i] = p >= 32768U;
-    }
+    return errors;
+}
 
-    // De-whiten some bits
-    for (uint32_t i = 0U; i < 114U; i++)
-        temp[i + 23U] ^= prn[i];
-
-    // c1
-    g1 = 0U;
-    for (uint32_t i = 0U; i < 23U; i++)
-        g1 = (g1 << 1) | (bit[i] ? 0x01U : 0x00U);
-    uint32_t c1data = Golay24128::decode23127(g1);
-    g2 = Golay24128::encode23127(c1data);
-    for (int i = 23; i >= 0; i--) {
-        bit[i] = (g2 & 0x01U) == 0x01U;
-        g2 >>= 1;
-    }
-    bit += 23U;
-
-    // c2
-    g1 = 0;
-    for (uint32_t i = 0U; i < 23U; i++)
-        g1 = (g1 << 1) | (bit[i] ? 0x01U : 0x00U);
-    uint32_t c2data = Golay24128::decode23127(g1);
-    g2 = Golay24128::encode23127(c2data);
-    for (int i = 23; i >= 0; i--) {
-        bit[i] = (g2 & 0x01U) == 0x01U;
-        g2 >>= 1;
-    }
-    bit += 23U;
-
-    // c3
-    g1 = 0U;
-    for (uint32_t i = 0U; i < 23U; i++)
-        g1 = (g1 << 1) | (bit[i] ? 0x01U : 0x00U);
-    uint32_t c3data = Golay24128::decode23127(g1);
-    g2 = Golay24128::encode23127(c3data);
-    for (int i = 23; i >= 0; i--) {
-        bit[i] = (g2 & 0x01U) == 0x01U;
-        g2 >>= 1;
-    }
-    bit += 23U;
+/// <summary>
+/// Regenerates the P25 IMBE FEC for the input bytes.
+/// </summary>
+/// <param name="bytes"></param>
+/// <returns>Count of errors.</returns>
+uint32_t AMBEFEC::regenerateIMBE(uint8_t* bytes) const
+{
+    assert(bytes != nullptr);
 
-    // c4
-    Hamming::decode15113_1(bit);
-    bit += 15U;
+    uint64_t diff[3U];
+    uint32_t errors = decodeIMBE(bytes, diff);
+    if (errors == 0U)
+        return 0U;
 
-    // c5
-    Hamming::decode15113_1(bit);
-    bit += 15U;
+    // Interleave (only the bits changed by the FEC need be written back)
+    for (uint32_t k = 0U; k < 3U; k++) {
+        for (uint32_t j = 0U; diff[k] != 0U && j < 64U; j++) {
+            uint64_t mask = 1ULL << (63U - j);
+            if ((diff[k] & mask) == 0U)
+                continue;
 
-    // c6
-    Hamming::decode15113_1(bit);
+            diff[k] &= ~mask;
 
-    // Whiten some bits
-    for (uint32_t i = 0U; i < 114U; i++)
-        temp[i + 23U] ^= prn[i];
+            uint32_t n = IMBE_INTERLEAVE[(k * 64U) + j];
+            bytes[n >> 3] ^= BIT_MASK_TABLE[n & 7U];
+        }
+    }
+
+    return errors;
+}
+
+/// <summary>
+/// Regenerates the P25 IMBE FEC for a run of consecutive IMBE frames.
+/// </summary>
+/// <remarks>
+/// This is intended to process all 9 IMBE frames of a LDU at once; the frames are
+/// expected to be packed back to back, each IMBE_FEC_LENGTH_BYTES long.
+/// </remarks>
+/// <param name="bytes"></param>
+/// <param name="count">Number of IMBE frames.</param>
+/// <returns>Count of errors.</returns>
+uint32_t AMBEFEC::regenerateIMBE(uint8_t* bytes, uint32_t count) const
+{
+    assert(bytes != nullptr);
 
     uint32_t errors = 0U;
-    for (uint32_t i = 0U; i < 144U; i++) {
-        if (orig[i] != temp[i])
-            errors++;
-    }
+    for (uint32_t n = 0U; n < count; n++)
+        errors += regenerateIMBE(bytes + (n * IMBE_FEC_LENGTH_BYTES));
 
     return errors;
 }
 
+/// <summary>
+/// Returns the number of errors on the P25 BER input bytes.
+/// </summary>
+/// <param name="bytes"></param>
+/// <returns>Count of errors.</returns>
+uint32_t AMBEFEC::measureP25BER(const uint8_t* bytes) const
+{
+    assert(bytes != nullptr);
+
+    uint64_t diff[3U];
+    return decodeIMBE(bytes, diff);
+}
+
 /// <summary>
 /// Regenerates the NXDN AMBE FEC for the input bytes.
 /// </summary>
@@ -516,49 +522,17 @@ uint32_t AMBEFEC::regenerateNXDN(uint8_t* bytes) const
 {
     assert(bytes != nullptr);
 
-    uint32_t a = 0U;
-    uint32_t MASK = 0x800000U;
-    for (uint32_t i = 0U; i < 24U; i++, MASK >>= 1) {
-        uint32_t aPos = AMBE_A_TABLE[i];
-        if (READ_BIT(bytes, aPos))
-            a |= MASK;
-    }
+    uint32_t a, b, c;
+    extractAMBE(bytes, a, b, c);
+    c &= ~0x01U; // NXDN only carries the first 24 bits of C
 
-    uint32_t b = 0U;
-    MASK = 0x400000U;
-    for (uint32_t i = 0U; i < 23U; i++, MASK >>= 1) {
-        uint32_t bPos = AMBE_B_TABLE[i];
-        if (READ_BIT(bytes, bPos))
-            b |= MASK;
-    }
-
-    uint32_t c = 0U;
-    MASK = 0x1000000U;
-    for (uint32_t i = 0U; i < 24U; i++, MASK >>= 1) {
-        uint32_t cPos = AMBE_C_TABLE[i];
-        if (READ_BIT(bytes, cPos))
-            c |= MASK;
-    }
+    uint32_t oldA = a, oldB = b, oldC = c;
 
     uint32_t errors = regenerate(a, b, c);
 
-    MASK = 0x800000U;
-    for (uint32_t i = 0U; i < 24U; i++, MASK >>= 1) {
-        uint32_t aPos = AMBE_A_TABLE[i];
-        WRITE_BIT(bytes, aPos, a & MASK);
-    }
-
-    MASK = 0x400000U;
-    for (uint32_t i = 0U; i < 23U; i++, MASK >>= 1) {
-        uint32_t bPos = AMBE_B_TABLE[i];
-        WRITE_BIT(bytes, bPos, b & MASK);
-    }
-
-    MASK = 0x1000000U;
-    for (uint32_t i = 0U; i < 24U; i++, MASK >>= 1) {
-        uint32_t cPos = AMBE_C_TABLE[i];
-        WRITE_BIT(bytes, cPos, c & MASK);
-    }
+    flipAMBEBits(bytes, a ^ oldA, 24U, AMBE_A_TABLE, 0U, false);
+    flipAMBEBits(bytes, b ^ oldB, 23U, AMBE_B_TABLE, 0U, false);
+    flipAMBEBits(bytes, c ^ oldC, 25U, AMBE_C_TABLE, 0U, false);
 
     return errors;
 }
@@ -573,29 +547,9 @@ uint32_t AMBEFEC::measureNXDNBER(uint8_t* bytes) const
 {
     assert(bytes != nullptr);
 
-    uint32_t a = 0U;
-    uint32_t MASK = 0x800000U;
-    for (uint32_t i = 0U; i < 24U; i++, MASK >>= 1) {
-        uint32_t aPos = AMBE_A_TABLE[i];
-        if (READ_BIT(bytes, aPos))
-            a |= MASK;
-    }
-
-    uint32_t b = 0U;
-    MASK = 0x400000U;
-    for (uint32_t i = 0U; i < 23U; i++, MASK >>= 1) {
-        uint32_t bPos = AMBE_B_TABLE[i];
-        if (READ_BIT(bytes, bPos))
-            b |= MASK;
-    }
-
-    uint32_t c = 0U;
-    MASK = 0x1000000U;
-    for (uint32_t i = 0U; i < 24U; i++, MASK >>= 1) {
-        uint32_t cPos = AMBE_C_TABLE[i];
-        if (READ_BIT(bytes, cPos))
-            c |= MASK;
-    }
+    uint32_t a, b, c;
+    extractAMBE(bytes, a, b, c);
+    c &= ~0x01U; // NXDN only carries the first 24 bits of C
 
     uint32_t errors = regenerate(a, b, c);
     return errors;
@@ -461,6 +461,8 @@ namespace edac
         46U, 50U, 54U, 58U, 62U, 66U, 70U,  3U,  7U, 11U, 15U, 19U,
         23U, 27U, 31U, 35U, 39U, 43U, 47U, 51U, 55U, 59U, 63U, 67U, 71U };
 
+    const uint32_t IMBE_FEC_LENGTH_BYTES = 18U;
+
     const uint32_t IMBE_INTERLEAVE[] = {
         0,  7, 12, 19, 24, 31, 36, 43, 48, 55, 60, 67, 72, 79, 84, 91,  96, 103, 108, 115, 120, 127, 132, 139,
         1,  6, 13, 18, 25, 30, 37, 42, 49, 54, 61, 66, 73, 78, 85, 90,  97, 102, 109, 114, 121, 126, 133, 138,
@@ -489,6 +491,8 @@ namespace edac
 
         /// <summary>Regenerates the P25 IMBE FEC for the input bytes.</summary>
         uint32_t regenerateIMBE(uint8_t* bytes) const;
+        /// <summary>Regenerates the P25 IMBE FEC for a run of consecutive IMBE frames.</summary>
+        uint32_t regenerateIMBE(uint8_t* bytes, uint32_t count) const;
         /// <summary>Returns the number of errors on the P25 BER input bytes.</summary>
         uint32_t measureP25BER(const uint8_t* bytes) const;
 
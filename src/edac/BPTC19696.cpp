@@ -31,7 +31,7 @@
 #include "Defines.h"
 #include "edac/BPTC19696.h"
 #include "edac/Hamming.h"
-#include "Utils.h"
+#include "Metrics.h"
 
 using namespace edac;
 
@@ -40,364 +40,301 @@ using namespace edac;
 #include <cstring>
 
 // ---------------------------------------------------------------------------
-//  Public Class Members
+//  Constants
 // ---------------------------------------------------------------------------
 
+// The deinterleaved block is held as 13 rows of 15 bits (column 0 in bit 14); rows
+// 0 - 8 are Hamming (15,11,3) codewords and the 15 columns are Hamming (13,9,3)
+// codewords. Deinterleaved bit 0 is R(3) which is not used.
+const uint32_t BPTC_ROWS = 13U;
+const uint32_t BPTC_DATA_ROWS = 9U;
+const uint32_t BPTC_COLUMNS = 15U;
+const uint32_t BPTC_LENGTH_BITS = 196U;
+const uint32_t BPTC_ROW_MASK = 0x7FFFU;
+
+// Hamming (13,9,3) parity check rows (matching Hamming::decode1393()), row 0 of the
+// block in bit 12; each entry includes its own parity row
+const uint32_t BPTC_COLUMN_CHECK[] = { 0x1AC8U, 0x1D64U, 0x1EB2U, 0x1591U };
+
 /// <summary>
-/// Initializes a new instance of the BPTC19696 class.
+/// Location of each raw (interleaved) bit within the deinterleaved block, and the raw
+/// bit carried by each deinterleaved bit.
 /// </summary>
-BPTC19696::BPTC19696() :
-    m_rawData(nullptr),
-    m_deInterData(nullptr)
-{
-    m_rawData = new bool[196];
-    m_deInterData = new bool[196];
-}
+struct BPTCInterleaveTable {
+    uint8_t row[BPTC_LENGTH_BITS];
+    uint8_t shift[BPTC_LENGTH_BITS];
+    uint8_t raw[BPTC_LENGTH_BITS];
+};
 
 /// <summary>
-/// Finalizes a instance of the BPTC19696 class.
+/// Builds the interleave table.
 /// </summary>
-BPTC19696::~BPTC19696()
+/// <returns></returns>
+constexpr BPTCInterleaveTable makeBPTCInterleaveTable()
 {
-    delete[] m_rawData;
-    delete[] m_deInterData;
+    BPTCInterleaveTable t = {};
+    for (uint32_t a = 0U; a < BPTC_LENGTH_BITS; a++) {
+        uint32_t interleaveSequence = (a * 181U) % BPTC_LENGTH_BITS;
+        t.raw[a] = (uint8_t)interleaveSequence;
+        if (a == 0U) {
+            // R(3) is parked in a row past the end of the block
+            t.row[interleaveSequence] = (uint8_t)BPTC_ROWS;
+            t.shift[interleaveSequence] = 0U;
+        }
+        else {
+            t.row[interleaveSequence] = (uint8_t)((a - 1U) / BPTC_COLUMNS);
+            t.shift[interleaveSequence] = (uint8_t)(BPTC_COLUMNS - 1U - ((a - 1U) % BPTC_COLUMNS));
+        }
+    }
+
+    return t;
 }
 
 /// <summary>
-/// Decode BPTC (196,96) FEC.
+/// Single bit error syndrome of each row of a column codeword.
 /// </summary>
-/// <param name="in">Input data to decode.</param>
-/// <param name="out">Decoded data.</param>
-void BPTC19696::decode(const uint8_t* in, uint8_t* out)
-{
-    assert(in != nullptr);
-    assert(out != nullptr);
-
-    //  Get the raw binary
-    decodeExtractBinary(in);
-
-    // Deinterleave
-    decodeDeInterleave();
-
-    // Error check
-    decodeErrorCheck();
-
-    // Extract Data
-    decodeExtractData(out);
-}
+struct BPTCColumnSyndromeTable {
+    uint8_t syndrome[BPTC_ROWS];
+};
 
 /// <summary>
-/// Encode BPTC (196,96) FEC.
+/// Builds the column syndrome table.
 /// </summary>
-/// <param name="in">Input data to encode.</param>
-/// <param name="out">Encoded data.</param>
-void BPTC19696::encode(const uint8_t* in, uint8_t* out)
+/// <returns></returns>
+constexpr BPTCColumnSyndromeTable makeBPTCColumnSyndromeTable()
 {
-    assert(in != nullptr);
-    assert(out != nullptr);
-
-    // Extract Data
-    encodeExtractData(in);
-
-    // Error check
-    encodeErrorCheck();
+    BPTCColumnSyndromeTable t = {};
+    for (uint32_t a = 0U; a < BPTC_ROWS; a++) {
+        uint32_t n = 0U;
+        for (uint32_t k = 0U; k < 4U; k++) {
+            if ((BPTC_COLUMN_CHECK[k] >> (BPTC_ROWS - 1U - a)) & 0x01U)
+                n |= 1U << k;
+        }
 
-    // Deinterleave
-    encodeInterleave();
+        t.syndrome[a] = (uint8_t)n;
+    }
 
-    //  Get the raw binary
-    encodeExtractBinary(out);
+    return t;
 }
 
+constexpr BPTCInterleaveTable BPTC_INTERLEAVE_TABLE = makeBPTCInterleaveTable();
+constexpr BPTCColumnSyndromeTable BPTC_COLUMN_SYNDROME_TABLE = makeBPTCColumnSyndromeTable();
+
 // ---------------------------------------------------------------------------
-//  Private Class Members
+//  Global Functions
 // ---------------------------------------------------------------------------
 
 /// <summary>
-///
+/// Deinterleaves the raw bits into the block rows.
 /// </summary>
-/// <param name="in"></param>
-void BPTC19696::decodeExtractBinary(const uint8_t* in)
+/// <param name="raw">Raw (interleaved) bits.</param>
+/// <param name="rows">Block rows.</param>
+static inline void deinterleave(const uint8_t* raw, uint32_t* rows)
 {
-    // First block
-    Utils::byteToBitsBE(in[0U], m_rawData + 0U);
-    Utils::byteToBitsBE(in[1U], m_rawData + 8U);
-    Utils::byteToBitsBE(in[2U], m_rawData + 16U);
-    Utils::byteToBitsBE(in[3U], m_rawData + 24U);
-    Utils::byteToBitsBE(in[4U], m_rawData + 32U);
-    Utils::byteToBitsBE(in[5U], m_rawData + 40U);
-    Utils::byteToBitsBE(in[6U], m_rawData + 48U);
-    Utils::byteToBitsBE(in[7U], m_rawData + 56U);
-    Utils::byteToBitsBE(in[8U], m_rawData + 64U);
-    Utils::byteToBitsBE(in[9U], m_rawData + 72U);
-    Utils::byteToBitsBE(in[10U], m_rawData + 80U);
-    Utils::byteToBitsBE(in[11U], m_rawData + 88U);
-    Utils::byteToBitsBE(in[12U], m_rawData + 96U);
-
-    // Handle the two bits
-    bool bits[8U];
-    Utils::byteToBitsBE(in[20U], bits);
-    m_rawData[98U] = bits[6U];
-    m_rawData[99U] = bits[7U];
+    uint32_t a = 1U;
+    for (uint32_t r = 0U; r < BPTC_ROWS; r++) {
+        uint32_t w = 0U;
+        for (uint32_t c = 0U; c < BPTC_COLUMNS; c++, a++) {
+            uint32_t n = BPTC_INTERLEAVE_TABLE.raw[a];
+            w = (w << 1) | ((raw[n >> 3] >> (7U - (n & 7U))) & 0x01U);
+        }
 
-    // Second block
-    Utils::byteToBitsBE(in[21U], m_rawData + 100U);
-    Utils::byteToBitsBE(in[22U], m_rawData + 108U);
-    Utils::byteToBitsBE(in[23U], m_rawData + 116U);
-    Utils::byteToBitsBE(in[24U], m_rawData + 124U);
-    Utils::byteToBitsBE(in[25U], m_rawData + 132U);
-    Utils::byteToBitsBE(in[26U], m_rawData + 140U);
-    Utils::byteToBitsBE(in[27U], m_rawData + 148U);
-    Utils::byteToBitsBE(in[28U], m_rawData + 156U);
-    Utils::byteToBitsBE(in[29U], m_rawData + 164U);
-    Utils::byteToBitsBE(in[30U], m_rawData + 172U);
-    Utils::byteToBitsBE(in[31U], m_rawData + 180U);
-    Utils::byteToBitsBE(in[32U], m_rawData + 188U);
+        rows[r] = w;
+    }
 }
 
 /// <summary>
-///
+/// Gathers the raw (interleaved) bits from the deinterleaved block rows.
 /// </summary>
-void BPTC19696::decodeDeInterleave()
+/// <param name="rows">Block rows.</param>
+/// <param name="out">Output buffer.</param>
+/// <param name="count">Number of bits.</param>
+static inline void gatherBits(const uint32_t* rows, uint8_t* out, uint32_t count)
 {
-    for (uint32_t i = 0U; i < 196U; i++)
-        m_deInterData[i] = false;
-
-    // The first bit is R(3) which is not used so can be ignored
-    for (uint32_t a = 0U; a < 196U; a++) {
-        // Calculate the interleave sequence
-        uint32_t interleaveSequence = (a * 181U) % 196U;
-        // Shuffle the data
-        m_deInterData[a] = m_rawData[interleaveSequence];
+    for (uint32_t i = 0U; i < count; i += 8U) {
+        uint32_t byte = 0U;
+        for (uint32_t j = i; j < i + 8U; j++) {
+            uint32_t bit = (j < count) ? (rows[BPTC_INTERLEAVE_TABLE.row[j]] >> BPTC_INTERLEAVE_TABLE.shift[j]) & 0x01U : 0U;
+            byte = (byte << 1) | bit;
+        }
+
+        out[i >> 3] = (uint8_t)byte;
     }
 }
 
 /// <summary>
-///
+/// Computes the column parity checks of all 15 columns at once.
 /// </summary>
-void BPTC19696::decodeErrorCheck()
+/// <param name="rows">Block rows.</param>
+/// <param name="checks">Per column parity of each column parity check.</param>
+static inline void calcColumnChecks(const uint32_t* rows, uint32_t* checks)
 {
-    bool fixing;
-    uint32_t count = 0U;
-    do {
-        fixing = false;
-
-        // Run through each of the 15 columns
-        bool col[13U];
-        for (uint32_t c = 0U; c < 15U; c++) {
-            uint32_t pos = c + 1U;
-            for (uint32_t a = 0U; a < 13U; a++) {
-                col[a] = m_deInterData[pos];
-                pos = pos + 15U;
-            }
-
-            if (Hamming::decode1393(col)) {
-                uint32_t pos = c + 1U;
-                for (uint32_t a = 0U; a < 13U; a++) {
-                    m_deInterData[pos] = col[a];
-                    pos = pos + 15U;
-                }
-
-                fixing = true;
-            }
-        }
-
-        // Run through each of the 9 rows containing data
-        for (uint32_t r = 0U; r < 9U; r++) {
-            uint32_t pos = (r * 15U) + 1U;
-            if (Hamming::decode15113_2(m_deInterData + pos))
-                fixing = true;
+    for (uint32_t k = 0U; k < 4U; k++) {
+        uint32_t n = 0U;
+        for (uint32_t a = 0U; a < BPTC_ROWS; a++) {
+            if ((BPTC_COLUMN_CHECK[k] >> (BPTC_ROWS - 1U - a)) & 0x01U)
+                n ^= rows[a];
         }
 
-        count++;
-    } while (fixing && count < 5U);
+        checks[k] = n;
+    }
 }
 
 /// <summary>
-///
+/// Decode Hamming (13,9,3) on all 15 columns of the block at once.
 /// </summary>
-/// <param name="data"></param>
-void BPTC19696::decodeExtractData(uint8_t* data) const
+/// <param name="rows">Block rows.</param>
+/// <returns>True, if bit errors were corrected, otherwise false.</returns>
+static inline bool decodeColumns(uint32_t* rows)
 {
-    bool bData[96U];
-    uint32_t pos = 0U;
-    for (uint32_t a = 4U; a <= 11U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 16U; a <= 26U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 31U; a <= 41U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 46U; a <= 56U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 61U; a <= 71U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 76U; a <= 86U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 91U; a <= 101U; a++, pos++)
-        bData[pos] = m_deInterData[a];
+    uint32_t checks[4U];
+    calcColumnChecks(rows, checks);
+    if ((checks[0U] | checks[1U] | checks[2U] | checks[3U]) == 0U)
+        return false;
+
+    // a bit is in error when its column syndrome matches the single bit error syndrome
+    // for its row; syndromes not matching any row are left uncorrected
+    bool fixed = false;
+    for (uint32_t a = 0U; a < BPTC_ROWS; a++) {
+        uint32_t n = BPTC_COLUMN_SYNDROME_TABLE.syndrome[a];
+        uint32_t mask = BPTC_ROW_MASK;
+        for (uint32_t k = 0U; k < 4U; k++)
+            mask &= ((n >> k) & 0x01U) ? checks[k] : ~checks[k];
+
+        if (mask != 0U) {
+            rows[a] ^= mask;
+            fixed = true;
+        }
+    }
 
-    for (uint32_t a = 106U; a <= 116U; a++, pos++)
-        bData[pos] = m_deInterData[a];
+    return fixed;
+}
 
-    for (uint32_t a = 121U; a <= 131U; a++, pos++)
-        bData[pos] = m_deInterData[a];
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
 
-    Utils::bitsToByteBE(bData + 0U, data[0U]);
-    Utils::bitsToByteBE(bData + 8U, data[1U]);
-    Utils::bitsToByteBE(bData + 16U, data[2U]);
-    Utils::bitsToByteBE(bData + 24U, data[3U]);
-    Utils::bitsToByteBE(bData + 32U, data[4U]);
-    Utils::bitsToByteBE(bData + 40U, data[5U]);
-    Utils::bitsToByteBE(bData + 48U, data[6U]);
-    Utils::bitsToByteBE(bData + 56U, data[7U]);
-    Utils::bitsToByteBE(bData + 64U, data[8U]);
-    Utils::bitsToByteBE(bData + 72U, data[9U]);
-    Utils::bitsToByteBE(bData + 80U, data[10U]);
-    Utils::bitsToByteBE(bData + 88U, data[11U]);
+/// <summary>
+/// Initializes a new instance of the BPTC19696 class.
+/// </summary>
+BPTC19696::BPTC19696()
+{
+    /* stub */
 }
 
 /// <summary>
-///
+/// Finalizes a instance of the BPTC19696 class.
 /// </summary>
-/// <param name="in"></param>
-void BPTC19696::encodeExtractData(const uint8_t* in) const
+BPTC19696::~BPTC19696()
 {
-    bool bData[96U];
-    Utils::byteToBitsBE(in[0U], bData + 0U);
-    Utils::byteToBitsBE(in[1U], bData + 8U);
-    Utils::byteToBitsBE(in[2U], bData + 16U);
-    Utils::byteToBitsBE(in[3U], bData + 24U);
-    Utils::byteToBitsBE(in[4U], bData + 32U);
-    Utils::byteToBitsBE(in[5U], bData + 40U);
-    Utils::byteToBitsBE(in[6U], bData + 48U);
-    Utils::byteToBitsBE(in[7U], bData + 56U);
-    Utils::byteToBitsBE(in[8U], bData + 64U);
-    Utils::byteToBitsBE(in[9U], bData + 72U);
-    Utils::byteToBitsBE(in[10U], bData + 80U);
-    Utils::byteToBitsBE(in[11U], bData + 88U);
-
-    for (uint32_t i = 0U; i < 196U; i++)
-        m_deInterData[i] = false;
-
-    uint32_t pos = 0U;
-    for (uint32_t a = 4U; a <= 11U; a++, pos++)
-        m_deInterData[a] = bData[pos];
+    /* stub */
+}
 
-    for (uint32_t a = 16U; a <= 26U; a++, pos++)
-        m_deInterData[a] = bData[pos];
+/// <summary>
+/// Decode BPTC (196,96) FEC.
+/// </summary>
+/// <param name="in">Input data to decode.</param>
+/// <param name="out">Decoded data.</param>
+void BPTC19696::decode(const uint8_t* in, uint8_t* out)
+{
+    assert(in != nullptr);
+    assert(out != nullptr);
 
-    for (uint32_t a = 31U; a <= 41U; a++, pos++)
-        m_deInterData[a] = bData[pos];
+    // Get the raw binary and deinterleave; the first block is raw bits 0 - 97, the two
+    // bits are the low bits of byte 20 and the second block follows from byte 21
+    uint8_t raw[25U];
+    ::memcpy(raw, in, 12U);
+    raw[12U] = (in[12U] & 0xC0U) | ((in[20U] & 0x03U) << 4) | (in[21U] >> 4);
+    for (uint32_t i = 13U; i < 25U; i++)
+        raw[i] = (uint8_t)((in[i + 8U] << 4) | (i < 24U ? (in[i + 9U] >> 4) : 0U));
 
-    for (uint32_t a = 46U; a <= 56U; a++, pos++)
-        m_deInterData[a] = bData[pos];
+    uint32_t rows[BPTC_ROWS];
+    deinterleave(raw, rows);
 
-    for (uint32_t a = 61U; a <= 71U; a++, pos++)
-        m_deInterData[a] = bData[pos];
+    // Error check
+    bool fixing;
+    uint32_t count = 0U;
+    do {
+        fixing = decodeColumns(rows);
 
-    for (uint32_t a = 76U; a <= 86U; a++, pos++)
-        m_deInterData[a] = bData[pos];
+        // Run through each of the 9 rows containing data
+        for (uint32_t r = 0U; r < BPTC_DATA_ROWS; r++) {
+            if (Hamming::decode15113_2(rows[r]))
+                fixing = true;
+        }
 
-    for (uint32_t a = 91U; a <= 101U; a++, pos++)
-        m_deInterData[a] = bData[pos];
+        count++;
+    } while (fixing && count < 5U);
 
-    for (uint32_t a = 106U; a <= 116U; a++, pos++)
-        m_deInterData[a] = bData[pos];
+    if (fixing)
+        Metrics::add(METRIC_FEC_BPTC19696_FAILED);
+    else if (count > 1U)
+        Metrics::add(METRIC_FEC_BPTC19696_CORRECTED);
 
-    for (uint32_t a = 121U; a <= 131U; a++, pos++)
-        m_deInterData[a] = bData[pos];
+    // Extract Data; 8 bits from row 0 and 11 bits from each of rows 1 - 8
+    uint32_t acc = (rows[0U] >> 4) & 0xFFU;
+    uint32_t bits = 8U;
+    uint32_t pos = 0U;
+    for (uint32_t r = 1U; r < BPTC_DATA_ROWS; r++) {
+        acc = (acc << 11) | (rows[r] >> 4);
+        bits += 11U;
+        while (bits >= 8U) {
+            bits -= 8U;
+            out[pos++] = (uint8_t)(acc >> bits);
+        }
+    }
 }
 
 /// <summary>
-///
+/// Encode BPTC (196,96) FEC.
 /// </summary>
-void BPTC19696::encodeErrorCheck()
+/// <param name="in">Input data to encode.</param>
+/// <param name="out">Encoded data.</param>
+void BPTC19696::encode(const uint8_t* in, uint8_t* out)
 {
-    // Run through each of the 9 rows containing data
-    for (uint32_t r = 0U; r < 9U; r++) {
-        uint32_t pos = (r * 15U) + 1U;
-        Hamming::encode15113_2(m_deInterData + pos);
-    }
+    assert(in != nullptr);
+    assert(out != nullptr);
 
-    // Run through each of the 15 columns
-    bool col[13U];
-    for (uint32_t c = 0U; c < 15U; c++) {
-        uint32_t pos = c + 1U;
-        for (uint32_t a = 0U; a < 13U; a++) {
-            col[a] = m_deInterData[pos];
-            pos = pos + 15U;
+    // Extract Data; 8 bits into row 0 and 11 bits into each of rows 1 - 8
+    uint32_t rows[BPTC_ROWS + 1U];
+    ::memset(rows, 0x00U, sizeof(rows));
+
+    rows[0U] = (uint32_t)in[0U] << 4;
+    uint32_t acc = 0U;
+    uint32_t bits = 0U;
+    uint32_t pos = 1U;
+    for (uint32_t r = 1U; r < BPTC_DATA_ROWS; r++) {
+        while (bits < 11U) {
+            acc = (acc << 8) | in[pos++];
+            bits += 8U;
         }
 
-        Hamming::encode1393(col);
-
-        pos = c + 1U;
-        for (uint32_t a = 0U; a < 13U; a++) {
-            m_deInterData[pos] = col[a];
-            pos = pos + 15U;
-        }
+        bits -= 11U;
+        rows[r] = ((acc >> bits) & 0x7FFU) << 4;
     }
-}
 
-/// <summary>
-///
-/// </summary>
-void BPTC19696::encodeInterleave()
-{
-    for (uint32_t i = 0U; i < 196U; i++)
-        m_rawData[i] = false;
-
-    // The first bit is R(3) which is not used so can be ignored
-    for (uint32_t a = 0U; a < 196U; a++) {
-        // Calculate the interleave sequence
-        uint32_t interleaveSequence = (a * 181U) % 196U;
-        // Unshuffle the data
-        m_rawData[interleaveSequence] = m_deInterData[a];
-    }
-}
+    // Error check; rows first, then the column parity rows
+    for (uint32_t r = 0U; r < BPTC_DATA_ROWS; r++)
+        Hamming::encode15113_2(rows[r]);
+
+    uint32_t checks[4U];
+    calcColumnChecks(rows, checks);
+    for (uint32_t k = 0U; k < 4U; k++)
+        rows[BPTC_DATA_ROWS + k] = checks[k];
+
+    // Interleave and get the raw binary
+    uint8_t raw[25U];
+
+    gatherBits(rows, raw, BPTC_LENGTH_BITS);
 
-/// <summary>
-///
-/// </summary>
-/// <param name="data"></param>
-void BPTC19696::encodeExtractBinary(uint8_t* data)
-{
     // First block
-    Utils::bitsToByteBE(m_rawData + 0U, data[0U]);
-    Utils::bitsToByteBE(m_rawData + 8U, data[1U]);
-    Utils::bitsToByteBE(m_rawData + 16U, data[2U]);
-    Utils::bitsToByteBE(m_rawData + 24U, data[3U]);
-    Utils::bitsToByteBE(m_rawData + 32U, data[4U]);
-    Utils::bitsToByteBE(m_rawData + 40U, data[5U]);
-    Utils::bitsToByteBE(m_rawData + 48U, data[6U]);
-    Utils::bitsToByteBE(m_rawData + 56U, data[7U]);
-    Utils::bitsToByteBE(m_rawData + 64U, data[8U]);
-    Utils::bitsToByteBE(m_rawData + 72U, data[9U]);
-    Utils::bitsToByteBE(m_rawData + 80U, data[10U]);
-    Utils::bitsToByteBE(m_rawData + 88U, data[11U]);
+    ::memcpy(out, raw, 12U);
 
     // Handle the two bits
-    uint8_t byte;
-    Utils::bitsToByteBE(m_rawData + 96U, byte);
-    data[12U] = (data[12U] & 0x3FU) | ((byte >> 0) & 0xC0U);
-    data[20U] = (data[20U] & 0xFCU) | ((byte >> 4) & 0x03U);
+    out[12U] = (out[12U] & 0x3FU) | (raw[12U] & 0xC0U);
+    out[20U] = (out[20U] & 0xFCU) | ((raw[12U] >> 4) & 0x03U);
 
     // Second block
-    Utils::bitsToByteBE(m_rawData + 100U, data[21U]);
-    Utils::bitsToByteBE(m_rawData + 108U, data[22U]);
-    Utils::bitsToByteBE(m_rawData + 116U, data[23U]);
-    Utils::bitsToByteBE(m_rawData + 124U, data[24U]);
-    Utils::bitsToByteBE(m_rawData + 132U, data[25U]);
-    Utils::bitsToByteBE(m_rawData + 140U, data[26U]);
-    Utils::bitsToByteBE(m_rawData + 148U, data[27U]);
-    Utils::bitsToByteBE(m_rawData + 156U, data[28U]);
-    Utils::bitsToByteBE(m_rawData + 164U, data[29U]);
-    Utils::bitsToByteBE(m_rawData + 172U, data[30U]);
-    Utils::bitsToByteBE(m_rawData + 180U, data[31U]);
-    Utils::bitsToByteBE(m_rawData + 188U, data[32U]);
+    for (uint32_t i = 0U; i < 12U; i++)
+        out[21U + i] = (uint8_t)((raw[12U + i] << 4) | (raw[13U + i] >> 4));
 }
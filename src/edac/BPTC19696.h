@@ -50,28 +50,6 @@ namespace edac
         void decode(const uint8_t* in, uint8_t* out);
         /// <summary>Encode BPTC (196,96) FEC.</summary>
         void encode(const uint8_t* in, uint8_t* out);
-
-    private:
-        bool* m_rawData;
-        bool* m_deInterData;
-
-        /// <summary></summary>
-        void decodeExtractBinary(const uint8_t* in);
-        /// <summary></summary>
-        void decodeErrorCheck();
-        /// <summary></summary>
-        void decodeDeInterleave();
-        /// <summary></summary>
-        void decodeExtractData(uint8_t* data) const;
-
-        /// <summary></summary>
-        void encodeExtractData(const uint8_t* in) const;
-        /// <summary></summary>
-        void encodeInterleave();
-        /// <summary></summary>
-        void encodeErrorCheck();
-        /// <summary></summary>
-        void encodeExtractBinary(uint8_t* data);
     };
 } // namespace edac
 
@@ -37,14 +37,27 @@ using namespace edac;
 
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <cassert>
 #include <cmath>
 
+#if defined(__x86_64__) && defined(__GNUC__)
+#define CRC_ENABLE_CLMUL 1
+#include <immintrin.h>
+#endif
+#if defined(__aarch64__) && defined(__AARCH64EL__) && defined(__linux__) && defined(__GNUC__)
+#define CRC_ENABLE_ARMV8 1
+#include <sys/auxv.h>
+#if !defined(HWCAP_CRC32)
+#define HWCAP_CRC32 (1 << 7)
+#endif
+#endif
+
 // ---------------------------------------------------------------------------
 //  Constants
 // ---------------------------------------------------------------------------
 
-const uint8_t CRC8_TABLE[] = {
+constexpr uint8_t CRC8_TABLE[] = {
     0x00, 0x07, 0x0E, 0x09, 0x1C, 0x1B, 0x12, 0x15, 0x38, 0x3F, 0x36, 0x31,
     0x24, 0x23, 0x2A, 0x2D, 0x70, 0x77, 0x7E, 0x79, 0x6C, 0x6B, 0x62, 0x65,
     0x48, 0x4F, 0x46, 0x41, 0x54, 0x53, 0x5A, 0x5D, 0xE0, 0xE7, 0xEE, 0xE9,
@@ -68,7 +81,7 @@ const uint8_t CRC8_TABLE[] = {
     0xDE, 0xD9, 0xD0, 0xD7, 0xC2, 0xC5, 0xCC, 0xCB, 0xE6, 0xE1, 0xE8, 0xEF,
     0xFA, 0xFD, 0xF4, 0xF3, 0x01 };
 
-const uint16_t CRC9_TABLE[] = {
+constexpr uint16_t CRC9_TABLE[] = {
     0x1E7U, 0x1F3U, 0x1F9U, 0x1FCU, 0x0D2U, 0x045U, 0x122U, 0x0BDU, 0x15EU, 0x083,
     0x141U, 0x1A0U, 0x0FCU, 0x052U, 0x005U, 0x102U, 0x0ADU, 0x156U, 0x087U, 0x143,
     0x1A1U, 0x1D0U, 0x0C4U, 0x04EU, 0x00BU, 0x105U, 0x182U, 0x0EDU, 0x176U, 0x097,
@@ -84,7 +97,7 @@ const uint16_t CRC9_TABLE[] = {
     0x171U, 0x1B8U, 0x0F0U, 0x054U, 0x006U, 0x02FU, 0x117U, 0x18BU, 0x1C5U, 0x1E2,
     0x0DDU, 0x16EU, 0x09BU, 0x14DU, 0x1A6U };
 
-const uint16_t CCITT16_TABLE1[] = {
+constexpr uint16_t CCITT16_TABLE1[] = {
     0x0000U, 0x1189U, 0x2312U, 0x329BU, 0x4624U, 0x57ADU, 0x6536U, 0x74BFU,
     0x8C48U, 0x9DC1U, 0xAF5AU, 0xBED3U, 0xCA6CU, 0xDBE5U, 0xE97EU, 0xF8F7U,
     0x1081U, 0x0108U, 0x3393U, 0x221AU, 0x56A5U, 0x472CU, 0x75B7U, 0x643EU,
@@ -118,7 +131,7 @@ const uint16_t CCITT16_TABLE1[] = {
     0xF78FU, 0xE606U, 0xD49DU, 0xC514U, 0xB1ABU, 0xA022U, 0x92B9U, 0x8330U,
     0x7BC7U, 0x6A4EU, 0x58D5U, 0x495CU, 0x3DE3U, 0x2C6AU, 0x1EF1U, 0x0F78U };
 
-const uint16_t CCITT16_TABLE2[] = {
+constexpr uint16_t CCITT16_TABLE2[] = {
     0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
     0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
     0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
@@ -152,7 +165,7 @@ const uint16_t CCITT16_TABLE2[] = {
     0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
     0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0 };
 
-const uint32_t CRC32_TABLE[] = {
+constexpr uint32_t CRC32_TABLE[] = {
     0x00000000, 0x04C11DB7, 0x09823B6E, 0x0D4326D9, 0x130476DC, 0x17C56B6B, 0x1A864DB2, 0x1E475005,
     0x2608EDB8, 0x22C9F00F, 0x2F8AD6D6, 0x2B4BCB61, 0x350C9B64, 0x31CD86D3, 0x3C8EA00A, 0x384FBDBD,
     0x4C11DB70, 0x48D0C6C7, 0x4593E01E, 0x4152FDA9, 0x5F15ADAC, 0x5BD4B01B, 0x569796C2, 0x52568B75,
@@ -186,6 +199,395 @@ const uint32_t CRC32_TABLE[] = {
     0x89B8FD09, 0x8D79E0BE, 0x803AC667, 0x84FBDBD0, 0x9ABC8BD5, 0x9E7D9662, 0x933EB0BB, 0x97FFAD0C,
     0xAFB010B1, 0xAB710D06, 0xA6322BDF, 0xA2F33668, 0xBCB4666D, 0xB8757BDA, 0xB5365D03, 0xB1F740B4 };
 
+const uint32_t CRC_SLICE_BYTES = 4U;
+const uint32_t CRC32_SLICE_BYTES = 8U;
+const uint32_t CRC9_BYTE_TABLE_LENGTH = 18U;
+
+// buffers shorter than this are not worth the setup cost of the accelerated CRC-32 path
+const uint32_t CRC32_ACCEL_MIN_LENGTH = 64U;
+
+#if defined(CRC_ENABLE_CLMUL)
+// folding constants for the CRC-32 polynomial (0x04C11DB7); x^n mod P
+const uint64_t CRC32_FOLD_X128 = 0xE8A45605U;
+const uint64_t CRC32_FOLD_X192 = 0xC5B9CD4CU;
+const uint64_t CRC32_FOLD_X512 = 0xE6228B11U;
+const uint64_t CRC32_FOLD_X576 = 0x8833794CU;
+#endif
+
+// ---------------------------------------------------------------------------
+//  Lookup Table Generation
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Lookup tables for a slice-by-N CRC; slice k holds the CRC of a byte followed by k zero bytes.
+/// </summary>
+template <typename T, uint32_t N>
+struct CRCSliceTable {
+    T slice[N][256U];
+};
+
+/// <summary>
+/// Builds slice-by-N tables for a MSB-first CRC from its byte-wise lookup table.
+/// </summary>
+/// <param name="table">Byte-wise CRC lookup table.</param>
+/// <returns>Slice-by-N lookup tables.</returns>
+template <typename T, uint32_t WIDTH, uint32_t N>
+constexpr CRCSliceTable<T, N> makeSliceTable(const T* table)
+{
+    CRCSliceTable<T, N> t = {};
+    for (uint32_t i = 0U; i < 256U; i++)
+        t.slice[0U][i] = table[i];
+
+    for (uint32_t k = 1U; k < N; k++) {
+        for (uint32_t i = 0U; i < 256U; i++) {
+            T prev = t.slice[k - 1U][i];
+            t.slice[k][i] = T((uint64_t(prev) << 8) ^ table[(prev >> (WIDTH - 8U)) & 0xFFU]);
+        }
+    }
+
+    return t;
+}
+
+/// <summary>
+/// Builds slice-by-N tables for a reflected (LSB-first) CRC from its byte-wise lookup table.
+/// </summary>
+/// <param name="table">Byte-wise CRC lookup table.</param>
+/// <returns>Slice-by-N lookup tables.</returns>
+template <typename T, uint32_t N>
+constexpr CRCSliceTable<T, N> makeReflectedSliceTable(const T* table)
+{
+    CRCSliceTable<T, N> t = {};
+    for (uint32_t i = 0U; i < 256U; i++)
+        t.slice[0U][i] = table[i];
+
+    for (uint32_t k = 1U; k < N; k++) {
+        for (uint32_t i = 0U; i < 256U; i++) {
+            T prev = t.slice[k - 1U][i];
+            t.slice[k][i] = T((prev >> 8) ^ table[prev & 0xFFU]);
+        }
+    }
+
+    return t;
+}
+
+/// <summary>
+/// Builds the byte-wise table for a bit-oriented CRC of up to 16 bits, whose register and
+/// polynomial are left-aligned into 16 bits.
+/// </summary>
+/// <param name="poly">Left-aligned generator polynomial.</param>
+/// <returns>Byte-wise lookup table.</returns>
+constexpr CRCSliceTable<uint16_t, 1U> makeAlignedTable(uint16_t poly)
+{
+    CRCSliceTable<uint16_t, 1U> t = {};
+    for (uint32_t i = 0U; i < 256U; i++) {
+        uint16_t crc = uint16_t(i << 8);
+        for (uint32_t j = 0U; j < 8U; j++)
+            crc = (crc & 0x8000U) ? uint16_t((crc << 1) ^ poly) : uint16_t(crc << 1);
+
+        t.slice[0U][i] = crc;
+    }
+
+    return t;
+}
+
+/// <summary>
+/// Builds the per-byte-position tables for the 9-bit CRC; entry [n][v] is the combined
+/// contribution of every set bit of the value v located at byte n.
+/// </summary>
+/// <returns>Per-byte-position lookup tables.</returns>
+constexpr CRCSliceTable<uint16_t, CRC9_BYTE_TABLE_LENGTH> makeCRC9ByteTable()
+{
+    CRCSliceTable<uint16_t, CRC9_BYTE_TABLE_LENGTH> t = {};
+    for (uint32_t n = 0U; n < CRC9_BYTE_TABLE_LENGTH; n++) {
+        for (uint32_t v = 0U; v < 256U; v++) {
+            uint16_t crc = 0U;
+            for (uint32_t j = 0U; j < 8U; j++) {
+                if ((v & (0x80U >> j)) == 0U)
+                    continue;
+
+                // bits 7 - 15 are the CRC field itself and do not contribute
+                uint32_t i = (n * 8U) + j;
+                if (i < 7U) {
+                    crc ^= CRC9_TABLE[i];
+                } else if (i > 15U) {
+                    crc ^= CRC9_TABLE[i - 9U];
+                }
+            }
+
+            t.slice[n][v] = crc;
+        }
+    }
+
+    return t;
+}
+
+constexpr CRCSliceTable<uint8_t, CRC_SLICE_BYTES> CRC8_SLICE = makeSliceTable<uint8_t, 8U, CRC_SLICE_BYTES>(CRC8_TABLE);
+constexpr CRCSliceTable<uint16_t, CRC_SLICE_BYTES> CCITT161_SLICE = makeReflectedSliceTable<uint16_t, CRC_SLICE_BYTES>(CCITT16_TABLE1);
+constexpr CRCSliceTable<uint16_t, CRC_SLICE_BYTES> CCITT162_SLICE = makeSliceTable<uint16_t, 16U, CRC_SLICE_BYTES>(CCITT16_TABLE2);
+constexpr CRCSliceTable<uint32_t, CRC32_SLICE_BYTES> CRC32_SLICE = makeSliceTable<uint32_t, 32U, CRC32_SLICE_BYTES>(CRC32_TABLE);
+constexpr CRCSliceTable<uint16_t, CRC9_BYTE_TABLE_LENGTH> CRC9_BYTE_TABLE = makeCRC9ByteTable();
+
+// the bit-oriented CRCs run with their register left-aligned into 16 bits
+const uint16_t CRC6_ALIGNED_POLY = 0x27U << 10;
+const uint16_t CRC12_ALIGNED_POLY = 0x080FU << 4;
+const uint16_t CRC15_ALIGNED_POLY = 0x4CC5U << 1;
+const uint16_t CRC16_ALIGNED_POLY = 0x1021U;
+
+constexpr CRCSliceTable<uint16_t, 1U> CRC6_ALIGNED_TABLE = makeAlignedTable(CRC6_ALIGNED_POLY);
+constexpr CRCSliceTable<uint16_t, 1U> CRC12_ALIGNED_TABLE = makeAlignedTable(CRC12_ALIGNED_POLY);
+constexpr CRCSliceTable<uint16_t, 1U> CRC15_ALIGNED_TABLE = makeAlignedTable(CRC15_ALIGNED_POLY);
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Updates a 16-bit CRC CCITT-162 (polynomial 0x1021, MSB-first) using slice-by-4 lookups.
+/// </summary>
+/// <param name="crc">Current CRC register.</param>
+/// <param name="in">Input byte array.</param>
+/// <param name="length">Length of byte array.</param>
+/// <returns>Updated CRC register.</returns>
+static inline uint16_t updateCCITT162(uint16_t crc, const uint8_t* in, uint32_t length)
+{
+    const CRCSliceTable<uint16_t, CRC_SLICE_BYTES>& t = CCITT162_SLICE;
+    for (; length >= CRC_SLICE_BYTES; length -= CRC_SLICE_BYTES, in += CRC_SLICE_BYTES) {
+        uint32_t v = crc ^ ((uint32_t(in[0U]) << 8) | in[1U]);
+        crc = t.slice[3U][v >> 8] ^ t.slice[2U][v & 0xFFU] ^ t.slice[1U][in[2U]] ^ t.slice[0U][in[3U]];
+    }
+
+    for (; length > 0U; length--, in++)
+        crc = uint16_t(crc << 8) ^ t.slice[0U][(crc >> 8) ^ *in];
+
+    return crc;
+}
+
+/// <summary>
+/// Updates a 16-bit CRC CCITT-161 (polynomial 0x1189, reflected) using slice-by-4 lookups.
+/// </summary>
+/// <param name="crc">Current CRC register.</param>
+/// <param name="in">Input byte array.</param>
+/// <param name="length">Length of byte array.</param>
+/// <returns>Updated CRC register.</returns>
+static inline uint16_t updateCCITT161(uint16_t crc, const uint8_t* in, uint32_t length)
+{
+    const CRCSliceTable<uint16_t, CRC_SLICE_BYTES>& t = CCITT161_SLICE;
+    for (; length >= CRC_SLICE_BYTES; length -= CRC_SLICE_BYTES, in += CRC_SLICE_BYTES) {
+        uint32_t v = crc ^ (in[0U] | (uint32_t(in[1U]) << 8));
+        crc = t.slice[3U][v & 0xFFU] ^ t.slice[2U][v >> 8] ^ t.slice[1U][in[2U]] ^ t.slice[0U][in[3U]];
+    }
+
+    for (; length > 0U; length--, in++)
+        crc = (crc >> 8) ^ t.slice[0U][(crc & 0xFFU) ^ *in];
+
+    return crc;
+}
+
+/// <summary>
+/// Updates a 32-bit CRC (polynomial 0x04C11DB7, MSB-first) using slice-by-8 lookups.
+/// </summary>
+/// <param name="crc">Current CRC register.</param>
+/// <param name="in">Input byte array.</param>
+/// <param name="length">Length of byte array.</param>
+/// <returns>Updated CRC register.</returns>
+static uint32_t updateCRC32Table(uint32_t crc, const uint8_t* in, uint32_t length)
+{
+    const CRCSliceTable<uint32_t, CRC32_SLICE_BYTES>& t = CRC32_SLICE;
+    for (; length >= CRC32_SLICE_BYTES; length -= CRC32_SLICE_BYTES, in += CRC32_SLICE_BYTES) {
+        uint32_t hi = crc ^ ((uint32_t(in[0U]) << 24) | (uint32_t(in[1U]) << 16) | (uint32_t(in[2U]) << 8) | in[3U]);
+        uint32_t lo = (uint32_t(in[4U]) << 24) | (uint32_t(in[5U]) << 16) | (uint32_t(in[6U]) << 8) | in[7U];
+        crc = t.slice[7U][hi >> 24] ^ t.slice[6U][(hi >> 16) & 0xFFU] ^ t.slice[5U][(hi >> 8) & 0xFFU] ^ t.slice[4U][hi & 0xFFU] ^
+            t.slice[3U][lo >> 24] ^ t.slice[2U][(lo >> 16) & 0xFFU] ^ t.slice[1U][(lo >> 8) & 0xFFU] ^ t.slice[0U][lo & 0xFFU];
+    }
+
+    for (; length > 0U; length--, in++)
+        crc = (crc << 8) ^ t.slice[0U][(crc >> 24) ^ *in];
+
+    return crc;
+}
+
+#if defined(CRC_ENABLE_CLMUL)
+/// <summary>
+/// Folds a 128-bit remainder forward over the distance encoded by the given constants.
+/// </summary>
+__attribute__((target("pclmul,ssse3")))
+static inline __m128i foldCRC32CLMUL(__m128i x, __m128i k)
+{
+    return _mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x11), _mm_clmulepi64_si128(x, k, 0x00));
+}
+
+/// <summary>
+/// Updates a 32-bit CRC using carry-less multiplication (PCLMULQDQ) to fold the input four
+/// 128-bit lanes at a time; the folded remainder is finished with the lookup tables.
+/// </summary>
+/// <param name="crc">Current CRC register.</param>
+/// <param name="in">Input byte array.</param>
+/// <param name="length">Length of byte array (at least 64 bytes).</param>
+/// <returns>Updated CRC register.</returns>
+__attribute__((target("pclmul,ssse3")))
+static uint32_t updateCRC32CLMUL(uint32_t crc, const uint8_t* in, uint32_t length)
+{
+    assert(length >= CRC32_ACCEL_MIN_LENGTH);
+
+    // reverse each block so the first byte is the highest order term of the polynomial
+    const __m128i swap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const __m128i k1 = _mm_set_epi64x(CRC32_FOLD_X192, CRC32_FOLD_X128);
+    const __m128i k4 = _mm_set_epi64x(CRC32_FOLD_X576, CRC32_FOLD_X512);
+
+    const __m128i* p = (const __m128i*)in;
+    __m128i x0 = _mm_shuffle_epi8(_mm_loadu_si128(p + 0), swap);
+    __m128i x1 = _mm_shuffle_epi8(_mm_loadu_si128(p + 1), swap);
+    __m128i x2 = _mm_shuffle_epi8(_mm_loadu_si128(p + 2), swap);
+    __m128i x3 = _mm_shuffle_epi8(_mm_loadu_si128(p + 3), swap);
+    p += 4;
+    length -= 64U;
+
+    // the incoming register is equivalent to XOR'ing it over the first 4 bytes
+    x0 = _mm_xor_si128(x0, _mm_set_epi32((int)crc, 0, 0, 0));
+
+    for (; length >= 64U; length -= 64U, p += 4) {
+        x0 = _mm_xor_si128(foldCRC32CLMUL(x0, k4), _mm_shuffle_epi8(_mm_loadu_si128(p + 0), swap));
+        x1 = _mm_xor_si128(foldCRC32CLMUL(x1, k4), _mm_shuffle_epi8(_mm_loadu_si128(p + 1), swap));
+        x2 = _mm_xor_si128(foldCRC32CLMUL(x2, k4), _mm_shuffle_epi8(_mm_loadu_si128(p + 2), swap));
+        x3 = _mm_xor_si128(foldCRC32CLMUL(x3, k4), _mm_shuffle_epi8(_mm_loadu_si128(p + 3), swap));
+    }
+
+    x1 = _mm_xor_si128(foldCRC32CLMUL(x0, k1), x1);
+    x2 = _mm_xor_si128(foldCRC32CLMUL(x1, k1), x2);
+    x0 = _mm_xor_si128(foldCRC32CLMUL(x2, k1), x3);
+
+    for (; length >= 16U; length -= 16U, p++)
+        x0 = _mm_xor_si128(foldCRC32CLMUL(x0, k1), _mm_shuffle_epi8(_mm_loadu_si128(p), swap));
+
+    // the remainder is congruent to the data consumed so far; running it through the tables
+    // from a zero register yields the CRC register for that data
+    uint8_t rem[16U];
+    _mm_storeu_si128((__m128i*)rem, _mm_shuffle_epi8(x0, swap));
+
+    crc = updateCRC32Table(0U, rem, 16U);
+    return updateCRC32Table(crc, (const uint8_t*)p, length);
+}
+#endif // defined(CRC_ENABLE_CLMUL)
+
+#if defined(CRC_ENABLE_ARMV8)
+/// <summary>
+/// Reverses the bit order of a 32-bit value.
+/// </summary>
+static inline uint32_t rbit32(uint32_t v)
+{
+    uint32_t r;
+    __asm__("rbit %w0, %w1" : "=r"(r) : "r"(v));
+    return r;
+}
+
+/// <summary>
+/// Updates a 32-bit CRC using the ARMv8 CRC32 instructions.
+/// </summary>
+/// <remarks>The instructions implement the reflected form of the polynomial; the MSB-first CRC is
+/// obtained by bit reversing both the register and the (big endian) input words.</remarks>
+/// <param name="crc">Current CRC register.</param>
+/// <param name="in">Input byte array.</param>
+/// <param name="length">Length of byte array.</param>
+/// <returns>Updated CRC register.</returns>
+static uint32_t updateCRC32ARMv8(uint32_t crc, const uint8_t* in, uint32_t length)
+{
+    uint32_t r = rbit32(crc);
+    for (; length >= 8U; length -= 8U, in += 8U) {
+        uint64_t v;
+        ::memcpy(&v, in, 8U);
+        v = __builtin_bswap64(v);
+        __asm__("rbit %x0, %x0" : "+r"(v));
+        __asm__(".arch_extension crc\n\tcrc32x %w0, %w0, %x1" : "+r"(r) : "r"(v));
+    }
+
+    return updateCRC32Table(rbit32(r), in, length);
+}
+#endif // defined(CRC_ENABLE_ARMV8)
+
+typedef uint32_t (*CRC32UpdateFn)(uint32_t crc, const uint8_t* in, uint32_t length);
+
+/// <summary>
+/// Represents the CRC-32 implementation selected for this processor.
+/// </summary>
+struct CRC32Engine {
+    CRC32UpdateFn update;
+    const char* name;
+};
+
+/// <summary>
+/// Selects the fastest CRC-32 implementation supported by this processor.
+/// </summary>
+/// <returns>Selected CRC-32 implementation.</returns>
+static CRC32Engine selectCRC32Engine()
+{
+#if defined(CRC_ENABLE_CLMUL)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("pclmul") && __builtin_cpu_supports("ssse3")) {
+        return CRC32Engine { &updateCRC32CLMUL, "pclmul" };
+    }
+#endif
+#if defined(CRC_ENABLE_ARMV8)
+    if ((::getauxval(AT_HWCAP) & HWCAP_CRC32) != 0U) {
+        return CRC32Engine { &updateCRC32ARMv8, "armv8-crc" };
+    }
+#endif
+    return CRC32Engine { &updateCRC32Table, "slice-by-8" };
+}
+
+/// <summary>
+/// Gets the CRC-32 implementation selected for this processor.
+/// </summary>
+/// <returns>Selected CRC-32 implementation.</returns>
+static const CRC32Engine& getCRC32Engine()
+{
+    static const CRC32Engine engine = selectCRC32Engine();
+    return engine;
+}
+
+/// <summary>
+/// Updates a 32-bit CRC, using the accelerated implementation for longer buffers.
+/// </summary>
+/// <param name="crc">Current CRC register.</param>
+/// <param name="in">Input byte array.</param>
+/// <param name="length">Length of byte array.</param>
+/// <returns>Updated CRC register.</returns>
+static inline uint32_t updateCRC32(uint32_t crc, const uint8_t* in, uint32_t length)
+{
+    if (length >= CRC32_ACCEL_MIN_LENGTH)
+        return getCRC32Engine().update(crc, in, length);
+
+    return updateCRC32Table(crc, in, length);
+}
+
+/// <summary>
+/// Updates a bit-oriented CRC of up to 16 bits whose register is left-aligned into 16 bits;
+/// whole bytes are handled by table lookup and any trailing bits bit-by-bit.
+/// </summary>
+/// <param name="table">Byte-wise lookup table for the aligned polynomial.</param>
+/// <param name="poly">Left-aligned generator polynomial.</param>
+/// <param name="crc">Current (left-aligned) CRC register.</param>
+/// <param name="in">Input byte array.</param>
+/// <param name="bitLength">Length of byte array in bits.</param>
+/// <returns>Updated (left-aligned) CRC register.</returns>
+static inline uint16_t updateAlignedCRC(const uint16_t* table, uint16_t poly, uint16_t crc, const uint8_t* in, uint32_t bitLength)
+{
+    uint32_t length = bitLength >> 3;
+    for (uint32_t i = 0U; i < length; i++)
+        crc = uint16_t(crc << 8) ^ table[(crc >> 8) ^ in[i]];
+
+    for (uint32_t i = length << 3; i < bitLength; i++) {
+        bool bit1 = READ_BIT(in, i) != 0x00U;
+        bool bit2 = (crc & 0x8000U) == 0x8000U;
+
+        crc <<= 1;
+
+        if (bit1 ^ bit2)
+            crc ^= poly;
+    }
+
+    return crc;
+}
+
 // ---------------------------------------------------------------------------
 //  Static Class Members
 // ---------------------------------------------------------------------------
@@ -239,16 +641,7 @@ bool CRC::checkCCITT162(const uint8_t *in, uint32_t length)
     assert(in != nullptr);
     assert(length > 2U);
 
-    union {
-        uint16_t crc16;
-        uint8_t  crc8[2U];
-    };
-
-    crc16 = 0U;
-
-    for (unsigned i = 0U; i < (length - 2U); i++)
-        crc16 = (uint16_t(crc8[0U]) << 8) ^ CCITT16_TABLE2[crc8[1U] ^ in[i]];
-
+    uint16_t crc16 = updateCCITT162(0U, in, length - 2U);
     crc16 = ~crc16;
 
 #if DEBUG_CRC_CHECK
@@ -256,7 +649,7 @@ bool CRC::checkCCITT162(const uint8_t *in, uint32_t length)
     LogDebug(LOG_HOST, "CRC::checkCCITT162(), crc = $%04X, in = $%04X, len = %u", crc16, inCrc, length);
 #endif
 
-    return crc8[0U] == in[length - 1U] && crc8[1U] == in[length - 2U];
+    return uint8_t(crc16) == in[length - 1U] && uint8_t(crc16 >> 8) == in[length - 2U];
 }
 
 /// <summary>
@@ -270,24 +663,15 @@ void CRC::addCCITT162(uint8_t* in, uint32_t length)
     assert(in != nullptr);
     assert(length > 2U);
 
-    union {
-        uint16_t crc16;
-        uint8_t  crc8[2U];
-    };
-
-    crc16 = 0U;
-
-    for (unsigned i = 0U; i < (length - 2U); i++)
-        crc16 = (uint16_t(crc8[0U]) << 8) ^ CCITT16_TABLE2[crc8[1U] ^ in[i]];
-
+    uint16_t crc16 = updateCCITT162(0U, in, length - 2U);
     crc16 = ~crc16;
 
 #if DEBUG_CRC_ADD
     LogDebug(LOG_HOST, "CRC::addCCITT162(), crc = $%04X, len = %u", crc16, length);
 #endif
 
-    in[length - 1U] = crc8[0U];
-    in[length - 2U] = crc8[1U];
+    in[length - 1U] = uint8_t(crc16);
+    in[length - 2U] = uint8_t(crc16 >> 8);
 }
 
 /// <summary>
@@ -302,16 +686,7 @@ bool CRC::checkCCITT161(const uint8_t *in, uint32_t length)
     assert(in != nullptr);
     assert(length > 2U);
 
-    union {
-        uint16_t crc16;
-        uint8_t  crc8[2U];
-    };
-
-    crc16 = 0xFFFFU;
-
-    for (uint32_t i = 0U; i < (length - 2U); i++)
-        crc16 = uint16_t(crc8[1U]) ^ CCITT16_TABLE1[crc8[0U] ^ in[i]];
-
+    uint16_t crc16 = updateCCITT161(0xFFFFU, in, length - 2U);
     crc16 = ~crc16;
 
 #if DEBUG_CRC_CHECK
@@ -319,7 +694,7 @@ bool CRC::checkCCITT161(const uint8_t *in, uint32_t length)
     LogDebug(LOG_HOST, "CRC::checkCCITT161(), crc = $%04X, in = $%04X, len = %u", crc16, inCrc, length);
 #endif
 
-    return crc8[0U] == in[length - 2U] && crc8[1U] == in[length - 1U];
+    return uint8_t(crc16) == in[length - 2U] && uint8_t(crc16 >> 8) == in[length - 1U];
 }
 
 /// <summary>
@@ -333,24 +708,15 @@ void CRC::addCCITT161(uint8_t* in, uint32_t length)
     assert(in != nullptr);
     assert(length > 2U);
 
-    union {
-        uint16_t crc16;
-        uint8_t  crc8[2U];
-    };
-
-    crc16 = 0xFFFFU;
-
-    for (uint32_t i = 0U; i < (length - 2U); i++)
-        crc16 = uint16_t(crc8[1U]) ^ CCITT16_TABLE1[crc8[0U] ^ in[i]];
-
+    uint16_t crc16 = updateCCITT161(0xFFFFU, in, length - 2U);
     crc16 = ~crc16;
 
 #if DEBUG_CRC_ADD
     LogDebug(LOG_HOST, "CRC::addCCITT161(), crc = $%04X, len = %u", crc16, length);
 #endif
 
-    in[length - 2U] = crc8[0U];
-    in[length - 1U] = crc8[1U];
+    in[length - 2U] = uint8_t(crc16);
+    in[length - 1U] = uint8_t(crc16 >> 8);
 }
 
 /// <summary>
@@ -364,28 +730,15 @@ bool CRC::checkCRC32(const uint8_t *in, uint32_t length)
     assert(in != nullptr);
     assert(length > 4U);
 
-    union {
-        uint32_t crc32;
-        uint8_t  crc8[4U];
-    };
-
-    uint32_t i = 0;
-    crc32 = 0x00000000U;
-
-    for (uint32_t j = (length - 4U); j-- > 0; i++) {
-        uint32_t idx = ((crc32 >> 24) ^ in[i]) & 0xFFU;
-        crc32 = (CRC32_TABLE[idx] ^ (crc32 << 8)) & 0xFFFFFFFFU;
-    }
-
+    uint32_t crc32 = updateCRC32(0x00000000U, in, length - 4U);
     crc32 = ~crc32;
-    crc32 &= 0xFFFFFFFFU;
 
 #if DEBUG_CRC_CHECK
     uint32_t inCrc = (in[length - 4U] << 24) | (in[length - 3U] << 16) | (in[length - 2U] << 8) | (in[length - 1U] << 0);
     LogDebug(LOG_HOST, "CRC::checkCRC32(), crc = $%08X, in = $%08X, len = %u", crc32, inCrc, length);
 #endif
 
-    return crc8[0U] == in[length - 1U] && crc8[1U] == in[length - 2U] && crc8[2U] == in[length - 3U] && crc8[3U] == in[length - 4U];
+    return uint8_t(crc32) == in[length - 1U] && uint8_t(crc32 >> 8) == in[length - 2U] && uint8_t(crc32 >> 16) == in[length - 3U] && uint8_t(crc32 >> 24) == in[length - 4U];
 }
 
 /// <summary>
@@ -398,30 +751,17 @@ void CRC::addCRC32(uint8_t* in, uint32_t length)
     assert(in != nullptr);
     assert(length > 4U);
 
-    union {
-        uint32_t crc32;
-        uint8_t  crc8[4U];
-    };
-
-    uint32_t i = 0;
-    crc32 = 0x00000000U;
-
-    for (uint32_t j = (length - 4U); j-- > 0; i++) {
-        uint32_t idx = ((crc32 >> 24) ^ in[i]) & 0xFFU;
-        crc32 = (CRC32_TABLE[idx] ^ (crc32 << 8)) & 0xFFFFFFFFU;
-    }
-
+    uint32_t crc32 = updateCRC32(0x00000000U, in, length - 4U);
     crc32 = ~crc32;
-    crc32 &= 0xFFFFFFFFU;
 
 #if DEBUG_CRC_ADD
     LogDebug(LOG_HOST, "CRC::addCRC32(), crc = $%08X, len = %u", crc32, length);
 #endif
 
-    in[length - 1U] = crc8[0U];
-    in[length - 2U] = crc8[1U];
-    in[length - 3U] = crc8[2U];
-    in[length - 4U] = crc8[3U];
+    in[length - 1U] = uint8_t(crc32);
+    in[length - 2U] = uint8_t(crc32 >> 8);
+    in[length - 3U] = uint8_t(crc32 >> 16);
+    in[length - 4U] = uint8_t(crc32 >> 24);
 }
 
 /// <summary>
@@ -434,10 +774,15 @@ uint8_t CRC::crc8(const uint8_t *in, uint32_t length)
 {
     assert(in != nullptr);
 
+    const CRCSliceTable<uint8_t, CRC_SLICE_BYTES>& t = CRC8_SLICE;
     uint8_t crc = 0U;
 
-    for (uint32_t i = 0U; i < length; i++)
-        crc = CRC8_TABLE[crc ^ in[i]];
+    uint32_t i = 0U;
+    for (; i + CRC_SLICE_BYTES <= length; i += CRC_SLICE_BYTES)
+        crc = t.slice[3U][crc ^ in[i]] ^ t.slice[2U][in[i + 1U]] ^ t.slice[1U][in[i + 2U]] ^ t.slice[0U][in[i + 3U]];
+
+    for (; i < length; i++)
+        crc = t.slice[0U][crc ^ in[i]];
 
 #if DEBUG_CRC_CHECK
     LogDebug(LOG_HOST, "CRC::crc8(), crc = $%02X, len = %u", crc, length);
@@ -458,7 +803,15 @@ uint16_t CRC::crc9(const uint8_t* in, uint32_t bitLength)
 
     uint16_t crc = 0x00U;
 
-    for (uint32_t i = 0; i < bitLength; i++) {
+    // whole bytes are looked up by their position in the block
+    uint32_t length = bitLength >> 3;
+    if (length > CRC9_BYTE_TABLE_LENGTH)
+        length = CRC9_BYTE_TABLE_LENGTH;
+
+    for (uint32_t n = 0U; n < length; n++)
+        crc ^= CRC9_BYTE_TABLE.slice[n][in[n]];
+
+    for (uint32_t i = length << 3; i < bitLength; i++) {
         bool b = READ_BIT(in, i);
         if (b) {
             if (i < 7U) {
@@ -720,21 +1073,19 @@ uint16_t CRC::addCRC16(uint8_t* in, uint32_t bitLength)
 /// <returns></returns>
 uint16_t CRC::createCRC16(const uint8_t* in, uint32_t bitLength)
 {
-    uint16_t crc = 0xFFFFU;
-
-    for (uint32_t i = 0U; i < bitLength; i++) {
-        bool bit1 = READ_BIT(in, i) != 0x00U;
-        bool bit2 = (crc & 0x8000U) == 0x8000U;
-
-        crc <<= 1;
-
-        if (bit1 ^ bit2)
-            crc ^= 0x1021U;
-    }
-
+    uint16_t crc = updateAlignedCRC(CCITT16_TABLE2, CRC16_ALIGNED_POLY, 0xFFFFU, in, bitLength);
     return crc & 0xFFFFU;
 }
 
+/// <summary>
+/// Gets the name of the CRC-32 implementation selected for this processor.
+/// </summary>
+/// <returns>Name of the CRC-32 implementation.</returns>
+const char* CRC::getCRC32EngineName()
+{
+    return getCRC32Engine().name;
+}
+
 // ---------------------------------------------------------------------------
 //  Private Static Class Members
 // ---------------------------------------------------------------------------
@@ -747,19 +1098,8 @@ uint16_t CRC::createCRC16(const uint8_t* in, uint32_t bitLength)
 /// <returns></returns>
 uint8_t CRC::createCRC6(const uint8_t* in, uint32_t bitLength)
 {
-    uint8_t crc = 0x3FU;
-
-    for (uint32_t i = 0U; i < bitLength; i++) {
-        bool bit1 = READ_BIT(in, i) != 0x00U;
-        bool bit2 = (crc & 0x20U) == 0x20U;
-
-        crc <<= 1;
-
-        if (bit1 ^ bit2)
-            crc ^= 0x27U;
-    }
-
-    return crc & 0x3FU;
+    uint16_t crc = updateAlignedCRC(CRC6_ALIGNED_TABLE.slice[0U], CRC6_ALIGNED_POLY, 0x3FU << 10, in, bitLength);
+    return (crc >> 10) & 0x3FU;
 }
 
 /// <summary>
@@ -770,19 +1110,8 @@ uint8_t CRC::createCRC6(const uint8_t* in, uint32_t bitLength)
 /// <returns></returns>
 uint16_t CRC::createCRC12(const uint8_t* in, uint32_t bitLength)
 {
-    uint16_t crc = 0x0FFFU;
-
-    for (uint32_t i = 0U; i < bitLength; i++) {
-        bool bit1 = READ_BIT(in, i) != 0x00U;
-        bool bit2 = (crc & 0x0800U) == 0x0800U;
-
-        crc <<= 1;
-
-        if (bit1 ^ bit2)
-            crc ^= 0x080FU;
-    }
-
-    return crc & 0x0FFFU;
+    uint16_t crc = updateAlignedCRC(CRC12_ALIGNED_TABLE.slice[0U], CRC12_ALIGNED_POLY, 0x0FFFU << 4, in, bitLength);
+    return (crc >> 4) & 0x0FFFU;
 }
 
 /// <summary>
@@ -793,17 +1122,6 @@ uint16_t CRC::createCRC12(const uint8_t* in, uint32_t bitLength)
 /// <returns></returns>
 uint16_t CRC::createCRC15(const uint8_t* in, uint32_t bitLength)
 {
-    uint16_t crc = 0x7FFFU;
-
-    for (uint32_t i = 0U; i < bitLength; i++) {
-        bool bit1 = READ_BIT(in, i) != 0x00U;
-        bool bit2 = (crc & 0x4000U) == 0x4000U;
-
-        crc <<= 1;
-
-        if (bit1 ^ bit2)
-            crc ^= 0x4CC5U;
-    }
-
-    return crc & 0x7FFFU;
+    uint16_t crc = updateAlignedCRC(CRC15_ALIGNED_TABLE.slice[0U], CRC15_ALIGNED_POLY, 0x7FFFU << 1, in, bitLength);
+    return (crc >> 1) & 0x7FFFU;
 }
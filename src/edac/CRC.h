@@ -91,6 +91,9 @@ namespace edac
         /// <summary></summary>
         static uint16_t createCRC16(const uint8_t* in, uint32_t bitLength);
 
+        /// <summary>Gets the name of the CRC-32 implementation selected for this processor.</summary>
+        static const char* getCRC32EngineName();
+
     private:
         /// <summary></summary>
         static uint8_t createCRC6(const uint8_t* in, uint32_t bitLength);
@@ -31,6 +31,7 @@
 */
 #include "Defines.h"
 #include "edac/Golay24128.h"
+#include "Metrics.h"
 #include "Utils.h"
 
 using namespace edac;
@@ -1073,9 +1074,6 @@ static const uint32_t DECODING_TABLE_23127[] = {
     0x403000U, 0x080840U, 0x100044U, 0x011008U, 0x022800U, 0x004110U, 0x100040U, 0x100041U, 0x100042U, 0x440020U,
     0x011001U, 0x011000U, 0x080420U, 0x011002U, 0x100048U, 0x011004U, 0x204200U, 0x028080U };
 
-#define X22             0x00400000   /* vector representation of X^{22} */
-#define X11             0x00000800   /* vector representation of X^{11} */
-#define MASK12          0xfffff800   /* auxiliary vector for testing */
 #define GENPOL          0x00000c75   /* generator polinomial, g(x) */
 
 // ---------------------------------------------------------------------------
@@ -1113,6 +1111,11 @@ bool Golay24128::decode24128(uint32_t code, uint32_t& out)
     bool valid = (Utils::countBits32(syndrome) < 3U) || !(Utils::countBits32(out) & 1);
     out >>= 12;
 
+    if (!valid)
+        Metrics::add(METRIC_FEC_GOLAY24128_FAILED);
+    else if (error_pattern != 0U)
+        Metrics::add(METRIC_FEC_GOLAY24128_CORRECTED);
+
     return valid;
 }
 
@@ -1287,25 +1290,15 @@ void Golay24128::encode24128(uint8_t* data, const uint8_t* raw, uint32_t msglen)
 /// Compute the syndrome corresponding to the given pattern, i.e., the
 /// remainder after dividing the pattern (when considering it as the vector
 /// representation of a polynomial) by the generator polynomial, GENPOL.
-/// In the program this pattern has several meanings: (1) pattern = infomation
-/// bits, when constructing the encoding table; (2) pattern = error pattern,
-/// when constructing the decoding table; and (3) pattern = received vector, to
-/// obtain its syndrome in decoding.
+/// Only the low 23 bits of the pattern are considered.
 /// </remarks>
 /// <param name="pattern"></param>
 /// <returns></returns>
 uint32_t Golay24128::getSyndrome23127(uint32_t pattern)
 {
-    uint32_t aux = X22;
-
-    if (pattern >= X11) {
-        while (pattern & MASK12) {
-            while (!(aux & pattern))
-                aux = aux >> 1;
-
-            pattern ^= (aux / X11) * GENPOL;
-        }
-    }
-
-    return pattern;
+    // the (23,12) code is systematic and the encoding table holds the information bits
+    // followed by the remainder of (information << 11) modulo GENPOL; as the syndrome is
+    // linear, the remainder of the whole pattern is that remainder XOR the low 11 bits
+    uint32_t parity = ENCODING_TABLE_23127[(pattern >> 11) & 0xFFFU] >> 1;
+    return (parity ^ pattern) & 0x7FFU;
 }
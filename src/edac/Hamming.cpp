@@ -34,6 +34,141 @@ using namespace edac;
 #include <cstdio>
 #include <cassert>
 
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+// Codewords are packed MSB first; for a n bit code d[0] is bit n - 1 and d[n - 1] is
+// bit 0. Each parity check row below covers the data bits of one parity equation and
+// that equation's parity bit, so a codeword is valid when every row has even parity.
+
+// c0 = d0 ^ d1 ^ d2 ^ d3 ^ d4 ^ d5 ^ d6, c1 = d0 ^ d1 ^ d2 ^ d3 ^ d7 ^ d8 ^ d9,
+// c2 = d0 ^ d1 ^ d4 ^ d5 ^ d7 ^ d8 ^ d10, c3 = d0 ^ d2 ^ d4 ^ d6 ^ d7 ^ d9 ^ d10
+const uint32_t HAMMING_15113_1_CHECK[] = { 0x7F08U, 0x78E4U, 0x66D2U, 0x55B1U };
+// c0 = d0 ^ d1 ^ d2 ^ d3 ^ d5 ^ d7 ^ d8, c1 = d1 ^ d2 ^ d3 ^ d4 ^ d6 ^ d8 ^ d9,
+// c2 = d2 ^ d3 ^ d4 ^ d5 ^ d7 ^ d9 ^ d10, c3 = d0 ^ d1 ^ d2 ^ d4 ^ d6 ^ d7 ^ d10
+const uint32_t HAMMING_15113_2_CHECK[] = { 0x7AC8U, 0x3D64U, 0x1EB2U, 0x7591U };
+// c0 = d0 ^ d1 ^ d3 ^ d5 ^ d6, c1 = d0 ^ d1 ^ d2 ^ d4 ^ d6 ^ d7,
+// c2 = d0 ^ d1 ^ d2 ^ d3 ^ d5 ^ d7 ^ d8, c3 = d0 ^ d2 ^ d4 ^ d5 ^ d8
+const uint32_t HAMMING_1393_CHECK[] = { 0x1AC8U, 0x1D64U, 0x1EB2U, 0x1591U };
+// c0 = d0 ^ d1 ^ d2 ^ d5, c1 = d0 ^ d1 ^ d3 ^ d5, c2 = d0 ^ d2 ^ d3 ^ d4,
+// c3 = d1 ^ d2 ^ d3 ^ d4
+const uint32_t HAMMING_1063_CHECK[] = { 0x0398U, 0x0354U, 0x02E2U, 0x01E1U };
+// c0 = d0 ^ d1 ^ d2 ^ d3 ^ d5 ^ d7 ^ d8, c1 = d1 ^ d2 ^ d3 ^ d4 ^ d6 ^ d8 ^ d9,
+// c2 = d2 ^ d3 ^ d4 ^ d5 ^ d7 ^ d9 ^ d10, c3 = d0 ^ d1 ^ d2 ^ d4 ^ d6 ^ d7 ^ d10,
+// c4 = d0 ^ d2 ^ d5 ^ d6 ^ d8 ^ d9 ^ d10
+const uint32_t HAMMING_16114_CHECK[] = { 0xF590U, 0x7AC8U, 0x3D64U, 0xEB22U, 0xA6E1U };
+// c0 = d0 ^ d1 ^ d2 ^ d3 ^ d6 ^ d7 ^ d9, c1 = d0 ^ d1 ^ d2 ^ d3 ^ d4 ^ d7 ^ d8 ^ d10,
+// c2 = d1 ^ d2 ^ d3 ^ d4 ^ d5 ^ d8 ^ d9 ^ d11, c3 = d0 ^ d1 ^ d4 ^ d5 ^ d7 ^ d10,
+// c4 = d0 ^ d1 ^ d2 ^ d5 ^ d6 ^ d8 ^ d11
+const uint32_t HAMMING_17123_CHECK[] = { 0x1E690U, 0x1F348U, 0x0F9A4U, 0x19A42U, 0x1CD21U };
+
+/// <summary>
+/// Syndrome and error pattern tables for a Hamming code.
+/// </summary>
+/// <remarks>
+/// The syndrome is linear, so it is gathered a byte at a time. Syndrome bits are
+/// ordered so that the syndrome of the data bits alone is the parity field itself (c0 in
+/// the most significant syndrome bit); error[] holds the single bit error for each
+/// syndrome, or 0 when the syndrome does not match a single bit error.
+/// </remarks>
+struct HammingCodeTable {
+    uint8_t syndrome[3U][256U];
+    uint32_t error[32U];
+};
+
+/// <summary>
+/// Computes the syndrome of a packed codeword directly from the parity check rows.
+/// </summary>
+/// <param name="checks">Parity check rows.</param>
+/// <param name="count">Number of parity check rows.</param>
+/// <param name="code">Packed codeword.</param>
+/// <returns></returns>
+constexpr uint32_t calcHammingSyndrome(const uint32_t* checks, uint32_t count, uint32_t code)
+{
+    uint32_t n = 0U;
+    for (uint32_t k = 0U; k < count; k++) {
+        uint32_t v = code & checks[k];
+        uint32_t parity = 0U;
+        for (; v != 0U; v &= v - 1U)
+            parity ^= 1U;
+
+        n = (n << 1) | parity;
+    }
+
+    return n;
+}
+
+/// <summary>
+/// Builds the syndrome and error pattern tables for a Hamming code.
+/// </summary>
+/// <param name="checks">Parity check rows.</param>
+/// <param name="count">Number of parity check rows.</param>
+/// <param name="length">Length of the codeword in bits.</param>
+/// <returns></returns>
+constexpr HammingCodeTable makeHammingCodeTable(const uint32_t* checks, uint32_t count, uint32_t length)
+{
+    HammingCodeTable t = {};
+    for (uint32_t b = 0U; b < 3U; b++) {
+        for (uint32_t v = 0U; v < 256U; v++)
+            t.syndrome[b][v] = (uint8_t)calcHammingSyndrome(checks, count, v << (b * 8U));
+    }
+
+    for (uint32_t j = 0U; j < length; j++)
+        t.error[calcHammingSyndrome(checks, count, 1U << j)] = 1U << j;
+
+    return t;
+}
+
+constexpr HammingCodeTable HAMMING_15113_1_TABLE = makeHammingCodeTable(HAMMING_15113_1_CHECK, 4U, 15U);
+constexpr HammingCodeTable HAMMING_15113_2_TABLE = makeHammingCodeTable(HAMMING_15113_2_CHECK, 4U, 15U);
+constexpr HammingCodeTable HAMMING_1393_TABLE = makeHammingCodeTable(HAMMING_1393_CHECK, 4U, 13U);
+constexpr HammingCodeTable HAMMING_1063_TABLE = makeHammingCodeTable(HAMMING_1063_CHECK, 4U, 10U);
+constexpr HammingCodeTable HAMMING_16114_TABLE = makeHammingCodeTable(HAMMING_16114_CHECK, 5U, 16U);
+constexpr HammingCodeTable HAMMING_17123_TABLE = makeHammingCodeTable(HAMMING_17123_CHECK, 5U, 17U);
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Returns the syndrome of a packed codeword.
+/// </summary>
+/// <param name="t"></param>
+/// <param name="code"></param>
+/// <returns></returns>
+static inline uint32_t getSyndrome(const HammingCodeTable& t, uint32_t code)
+{
+    return t.syndrome[0U][code & 0xFFU] ^ t.syndrome[1U][(code >> 8) & 0xFFU] ^ t.syndrome[2U][(code >> 16) & 0xFFU];
+}
+
+/// <summary>
+/// Packs a boolean bit array MSB first.
+/// </summary>
+/// <param name="d"></param>
+/// <param name="length"></param>
+/// <returns></returns>
+static inline uint32_t packBits(const bool* d, uint32_t length)
+{
+    uint32_t code = 0U;
+    for (uint32_t i = 0U; i < length; i++)
+        code = (code << 1) | (d[i] ? 0x01U : 0x00U);
+
+    return code;
+}
+
+/// <summary>
+/// Unpacks a MSB first packed codeword into a boolean bit array.
+/// </summary>
+/// <param name="code"></param>
+/// <param name="d"></param>
+/// <param name="length"></param>
+static inline void unpackBits(uint32_t code, bool* d, uint32_t length)
+{
+    for (uint32_t i = 0U; i < length; i++)
+        d[i] = ((code >> (length - 1U - i)) & 0x01U) == 0x01U;
+}
+
 // ---------------------------------------------------------------------------
 //  Static Class Members
 // ---------------------------------------------------------------------------
@@ -47,41 +182,23 @@ bool Hamming::decode15113_1(bool* d)
 {
     assert(d != nullptr);
 
-    // Calculate the parity it should have
-    bool c0 = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[6];
-    bool c1 = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[7] ^ d[8] ^ d[9];
-    bool c2 = d[0] ^ d[1] ^ d[4] ^ d[5] ^ d[7] ^ d[8] ^ d[10];
-    bool c3 = d[0] ^ d[2] ^ d[4] ^ d[6] ^ d[7] ^ d[9] ^ d[10];
-
-    unsigned char n = 0U;
-    n |= (c0 != d[11]) ? 0x01U : 0x00U;
-    n |= (c1 != d[12]) ? 0x02U : 0x00U;
-    n |= (c2 != d[13]) ? 0x04U : 0x00U;
-    n |= (c3 != d[14]) ? 0x08U : 0x00U;
-
-    switch (n) {
-        // Parity bit errors
-        case 0x01U: d[11] = !d[11]; return true;
-        case 0x02U: d[12] = !d[12]; return true;
-        case 0x04U: d[13] = !d[13]; return true;
-        case 0x08U: d[14] = !d[14]; return true;
-
-        // Data bit errors
-        case 0x0FU: d[0] = !d[0];  return true;
-        case 0x07U: d[1] = !d[1];  return true;
-        case 0x0BU: d[2] = !d[2];  return true;
-        case 0x03U: d[3] = !d[3];  return true;
-        case 0x0DU: d[4] = !d[4];  return true;
-        case 0x05U: d[5] = !d[5];  return true;
-        case 0x09U: d[6] = !d[6];  return true;
-        case 0x0EU: d[7] = !d[7];  return true;
-        case 0x06U: d[8] = !d[8];  return true;
-        case 0x0AU: d[9] = !d[9];  return true;
-        case 0x0CU: d[10] = !d[10]; return true;
-
-        // No bit errors
-        default: return false;
-    }
+    uint32_t code = packBits(d, 15U);
+    bool ret = decode15113_1(code);
+    unpackBits(code, d, 15U);
+
+    return ret;
+}
+
+/// <summary>
+/// Decode Hamming (15,11,3).
+/// </summary>
+/// <param name="code">Packed codeword (d[0] is bit 14).</param>
+/// <returns>True, if bit errors are detected, otherwise false.</returns>
+bool Hamming::decode15113_1(uint32_t& code)
+{
+    uint32_t error = HAMMING_15113_1_TABLE.error[getSyndrome(HAMMING_15113_1_TABLE, code)];
+    code ^= error;
+    return error != 0U;
 }
 
 /// <summary>
@@ -92,11 +209,19 @@ void Hamming::encode15113_1(bool* d)
 {
     assert(d != nullptr);
 
-    // Calculate the checksum this row should have
-    d[11] = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[6];
-    d[12] = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[7] ^ d[8] ^ d[9];
-    d[13] = d[0] ^ d[1] ^ d[4] ^ d[5] ^ d[7] ^ d[8] ^ d[10];
-    d[14] = d[0] ^ d[2] ^ d[4] ^ d[6] ^ d[7] ^ d[9] ^ d[10];
+    uint32_t code = packBits(d, 15U);
+    encode15113_1(code);
+    unpackBits(code, d, 15U);
+}
+
+/// <summary>
+/// Encode Hamming (15,11,3).
+/// </summary>
+/// <param name="code">Packed codeword (d[0] is bit 14).</param>
+void Hamming::encode15113_1(uint32_t& code)
+{
+    code &= 0x7FF0U;
+    code |= getSyndrome(HAMMING_15113_1_TABLE, code);
 }
 
 /// <summary>
@@ -108,41 +233,23 @@ bool Hamming::decode15113_2(bool* d)
 {
     assert(d != nullptr);
 
-    // Calculate the checksum this row should have
-    bool c0 = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[5] ^ d[7] ^ d[8];
-    bool c1 = d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[6] ^ d[8] ^ d[9];
-    bool c2 = d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[7] ^ d[9] ^ d[10];
-    bool c3 = d[0] ^ d[1] ^ d[2] ^ d[4] ^ d[6] ^ d[7] ^ d[10];
-
-    unsigned char n = 0x00U;
-    n |= (c0 != d[11]) ? 0x01U : 0x00U;
-    n |= (c1 != d[12]) ? 0x02U : 0x00U;
-    n |= (c2 != d[13]) ? 0x04U : 0x00U;
-    n |= (c3 != d[14]) ? 0x08U : 0x00U;
-
-    switch (n) {
-        // Parity bit errors
-        case 0x01U: d[11] = !d[11]; return true;
-        case 0x02U: d[12] = !d[12]; return true;
-        case 0x04U: d[13] = !d[13]; return true;
-        case 0x08U: d[14] = !d[14]; return true;
-
-        // Data bit errors
-        case 0x09U: d[0] = !d[0];  return true;
-        case 0x0BU: d[1] = !d[1];  return true;
-        case 0x0FU: d[2] = !d[2];  return true;
-        case 0x07U: d[3] = !d[3];  return true;
-        case 0x0EU: d[4] = !d[4];  return true;
-        case 0x05U: d[5] = !d[5];  return true;
-        case 0x0AU: d[6] = !d[6];  return true;
-        case 0x0DU: d[7] = !d[7];  return true;
-        case 0x03U: d[8] = !d[8];  return true;
-        case 0x06U: d[9] = !d[9];  return true;
-        case 0x0CU: d[10] = !d[10]; return true;
-
-        // No bit errors
-        default: return false;
-    }
+    uint32_t code = packBits(d, 15U);
+    bool ret = decode15113_2(code);
+    unpackBits(code, d, 15U);
+
+    return ret;
+}
+
+/// <summary>
+/// Decode Hamming (15,11,3).
+/// </summary>
+/// <param name="code">Packed codeword (d[0] is bit 14).</param>
+/// <returns>True, if bit errors are detected, otherwise false.</returns>
+bool Hamming::decode15113_2(uint32_t& code)
+{
+    uint32_t error = HAMMING_15113_2_TABLE.error[getSyndrome(HAMMING_15113_2_TABLE, code)];
+    code ^= error;
+    return error != 0U;
 }
 
 /// <summary>
@@ -153,11 +260,19 @@ void Hamming::encode15113_2(bool* d)
 {
     assert(d != nullptr);
 
-    // Calculate the checksum this row should have
-    d[11] = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[5] ^ d[7] ^ d[8];
-    d[12] = d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[6] ^ d[8] ^ d[9];
-    d[13] = d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[7] ^ d[9] ^ d[10];
-    d[14] = d[0] ^ d[1] ^ d[2] ^ d[4] ^ d[6] ^ d[7] ^ d[10];
+    uint32_t code = packBits(d, 15U);
+    encode15113_2(code);
+    unpackBits(code, d, 15U);
+}
+
+/// <summary>
+/// Encode Hamming (15,11,3).
+/// </summary>
+/// <param name="code">Packed codeword (d[0] is bit 14).</param>
+void Hamming::encode15113_2(uint32_t& code)
+{
+    code &= 0x7FF0U;
+    code |= getSyndrome(HAMMING_15113_2_TABLE, code);
 }
 
 /// <summary>
@@ -169,39 +284,24 @@ bool Hamming::decode1393(bool* d)
 {
     assert(d != nullptr);
 
-    // Calculate the checksum this column should have
-    bool c0 = d[0] ^ d[1] ^ d[3] ^ d[5] ^ d[6];
-    bool c1 = d[0] ^ d[1] ^ d[2] ^ d[4] ^ d[6] ^ d[7];
-    bool c2 = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[5] ^ d[7] ^ d[8];
-    bool c3 = d[0] ^ d[2] ^ d[4] ^ d[5] ^ d[8];
-
-    unsigned char n = 0x00U;
-    n |= (c0 != d[9]) ? 0x01U : 0x00U;
-    n |= (c1 != d[10]) ? 0x02U : 0x00U;
-    n |= (c2 != d[11]) ? 0x04U : 0x00U;
-    n |= (c3 != d[12]) ? 0x08U : 0x00U;
-
-    switch (n) {
-        // Parity bit errors
-        case 0x01U: d[9] = !d[9];  return true;
-        case 0x02U: d[10] = !d[10]; return true;
-        case 0x04U: d[11] = !d[11]; return true;
-        case 0x08U: d[12] = !d[12]; return true;
-
-        // Data bit erros
-        case 0x0FU: d[0] = !d[0]; return true;
-        case 0x07U: d[1] = !d[1]; return true;
-        case 0x0EU: d[2] = !d[2]; return true;
-        case 0x05U: d[3] = !d[3]; return true;
-        case 0x0AU: d[4] = !d[4]; return true;
-        case 0x0DU: d[5] = !d[5]; return true;
-        case 0x03U: d[6] = !d[6]; return true;
-        case 0x06U: d[7] = !d[7]; return true;
-        case 0x0CU: d[8] = !d[8]; return true;
-
-        // No bit errors
-        default: return false;
-    }
+    uint32_t code = packBits(d, 13U);
+    bool ret = decode1393(code);
+    unpackBits(code, d, 13U);
+
+    return ret;
+}
+
+/// <summary>
+/// Decode Hamming (13,9,3).
+/// </summary>
+/// <param name="code">Packed codeword (d[0] is bit 12).</param>
+/// <returns>True, if bit errors are detected, otherwise false.</returns>
+bool Hamming::decode1393(uint32_t& code)
+{
+    // syndromes which do not match a single bit error are left uncorrected
+    uint32_t error = HAMMING_1393_TABLE.error[getSyndrome(HAMMING_1393_TABLE, code)];
+    code ^= error;
+    return error != 0U;
 }
 
 /// <summary>
@@ -212,11 +312,19 @@ void Hamming::encode1393(bool* d)
 {
     assert(d != nullptr);
 
-    // Calculate the checksum this column should have
-    d[9] = d[0] ^ d[1] ^ d[3] ^ d[5] ^ d[6];
-    d[10] = d[0] ^ d[1] ^ d[2] ^ d[4] ^ d[6] ^ d[7];
-    d[11] = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[5] ^ d[7] ^ d[8];
-    d[12] = d[0] ^ d[2] ^ d[4] ^ d[5] ^ d[8];
+    uint32_t code = packBits(d, 13U);
+    encode1393(code);
+    unpackBits(code, d, 13U);
+}
+
+/// <summary>
+/// Encode Hamming (13,9,3).
+/// </summary>
+/// <param name="code">Packed codeword (d[0] is bit 12).</param>
+void Hamming::encode1393(uint32_t& code)
+{
+    code &= 0x1FF0U;
+    code |= getSyndrome(HAMMING_1393_TABLE, code);
 }
 
 /// <summary>
@@ -228,36 +336,24 @@ bool Hamming::decode1063(bool* d)
 {
     assert(d != nullptr);
 
-    // Calculate the checksum this column should have
-    bool c0 = d[0] ^ d[1] ^ d[2] ^ d[5];
-    bool c1 = d[0] ^ d[1] ^ d[3] ^ d[5];
-    bool c2 = d[0] ^ d[2] ^ d[3] ^ d[4];
-    bool c3 = d[1] ^ d[2] ^ d[3] ^ d[4];
-
-    unsigned char n = 0x00U;
-    n |= (c0 != d[6]) ? 0x01U : 0x00U;
-    n |= (c1 != d[7]) ? 0x02U : 0x00U;
-    n |= (c2 != d[8]) ? 0x04U : 0x00U;
-    n |= (c3 != d[9]) ? 0x08U : 0x00U;
-
-    switch (n) {
-        // Parity bit errors
-        case 0x01U: d[6] = !d[6]; return true;
-        case 0x02U: d[7] = !d[7]; return true;
-        case 0x04U: d[8] = !d[8]; return true;
-        case 0x08U: d[9] = !d[9]; return true;
-
-        // Data bit erros
-        case 0x07U: d[0] = !d[0]; return true;
-        case 0x0BU: d[1] = !d[1]; return true;
-        case 0x0DU: d[2] = !d[2]; return true;
-        case 0x0EU: d[3] = !d[3]; return true;
-        case 0x0CU: d[4] = !d[4]; return true;
-        case 0x03U: d[5] = !d[5]; return true;
-
-        // No bit errors
-        default: return false;
-    }
+    uint32_t code = packBits(d, 10U);
+    bool ret = decode1063(code);
+    unpackBits(code, d, 10U);
+
+    return ret;
+}
+
+/// <summary>
+/// Decode Hamming (10,6,3).
+/// </summary>
+/// <param name="code">Packed codeword (d[0] is bit 9).</param>
+/// <returns>True, if bit errors are detected, otherwise false.</returns>
+bool Hamming::decode1063(uint32_t& code)
+{
+    // syndromes which do not match a single bit error are left uncorrected
+    uint32_t error = HAMMING_1063_TABLE.error[getSyndrome(HAMMING_1063_TABLE, code)];
+    code ^= error;
+    return error != 0U;
 }
 
 /// <summary>
@@ -268,11 +364,19 @@ void Hamming::encode1063(bool* d)
 {
     assert(d != nullptr);
 
-    // Calculate the checksum this column should have
-    d[6] = d[0] ^ d[1] ^ d[2] ^ d[5];
-    d[7] = d[0] ^ d[1] ^ d[3] ^ d[5];
-    d[8] = d[0] ^ d[2] ^ d[3] ^ d[4];
-    d[9] = d[1] ^ d[2] ^ d[3] ^ d[4];
+    uint32_t code = packBits(d, 10U);
+    encode1063(code);
+    unpackBits(code, d, 10U);
+}
+
+/// <summary>
+/// Encode Hamming (10,6,3).
+/// </summary>
+/// <param name="code">Packed codeword (d[0] is bit 9).</param>
+void Hamming::encode1063(uint32_t& code)
+{
+    code &= 0x3F0U;
+    code |= getSyndrome(HAMMING_1063_TABLE, code);
 }
 
 /// <summary>
@@ -284,63 +388,47 @@ bool Hamming::decode16114(bool* d)
 {
     assert(d != nullptr);
 
-    // Calculate the checksum this column should have
-    bool c0 = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[5] ^ d[7] ^ d[8];
-    bool c1 = d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[6] ^ d[8] ^ d[9];
-    bool c2 = d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[7] ^ d[9] ^ d[10];
-    bool c3 = d[0] ^ d[1] ^ d[2] ^ d[4] ^ d[6] ^ d[7] ^ d[10];
-    bool c4 = d[0] ^ d[2] ^ d[5] ^ d[6] ^ d[8] ^ d[9] ^ d[10];
-
-    // Compare these with the actual bits
-    unsigned char n = 0x00U;
-    n |= (c0 != d[11]) ? 0x01U : 0x00U;
-    n |= (c1 != d[12]) ? 0x02U : 0x00U;
-    n |= (c2 != d[13]) ? 0x04U : 0x00U;
-    n |= (c3 != d[14]) ? 0x08U : 0x00U;
-    n |= (c4 != d[15]) ? 0x10U : 0x00U;
-
-    switch (n) {
-        // Parity bit errors
-        case 0x01U: d[11] = !d[11]; return true;
-        case 0x02U: d[12] = !d[12]; return true;
-        case 0x04U: d[13] = !d[13]; return true;
-        case 0x08U: d[14] = !d[14]; return true;
-        case 0x10U: d[15] = !d[15]; return true;
-
-        // Data bit errors
-        case 0x19U: d[0] = !d[0];  return true;
-        case 0x0BU: d[1] = !d[1];  return true;
-        case 0x1FU: d[2] = !d[2];  return true;
-        case 0x07U: d[3] = !d[3];  return true;
-        case 0x0EU: d[4] = !d[4];  return true;
-        case 0x15U: d[5] = !d[5];  return true;
-        case 0x1AU: d[6] = !d[6];  return true;
-        case 0x0DU: d[7] = !d[7];  return true;
-        case 0x13U: d[8] = !d[8];  return true;
-        case 0x16U: d[9] = !d[9];  return true;
-        case 0x1CU: d[10] = !d[10]; return true;
-
-        // No bit errors
-        case 0x00U: return true;
-
-        // Unrecoverable errors
-        default: return false;
-    }
+    uint32_t code = packBits(d, 16U);
+    bool ret = decode16114(code);
+    unpackBits(code, d, 16U);
+
+    return ret;
 }
 
 /// <summary>
-/// Encode Hamming (10,6,3).
+/// Decode Hamming (16,11,4).
+/// </summary>
+/// <param name="code">Packed codeword (d[0] is bit 15).</param>
+/// <returns>True, if bit errors are detected or no bit errors, otherwise false if unrecoverable errors are detected.</returns>
+bool Hamming::decode16114(uint32_t& code)
+{
+    uint32_t n = getSyndrome(HAMMING_16114_TABLE, code);
+    uint32_t error = HAMMING_16114_TABLE.error[n];
+    code ^= error;
+    return n == 0U || error != 0U;
+}
+
+/// <summary>
+/// Encode Hamming (16,11,4).
 /// </summary>
 /// <param name="d">Boolean bit array.</param>
 void Hamming::encode16114(bool* d)
 {
     assert(d != nullptr);
 
-    d[11] = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[5] ^ d[7] ^ d[8];
-    d[12] = d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[6] ^ d[8] ^ d[9];
-    d[13] = d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[7] ^ d[9] ^ d[10];
-    d[14] = d[0] ^ d[1] ^ d[2] ^ d[4] ^ d[6] ^ d[7] ^ d[10];
-    d[15] = d[0] ^ d[2] ^ d[5] ^ d[6] ^ d[8] ^ d[9] ^ d[10];
+    uint32_t code = packBits(d, 16U);
+    encode16114(code);
+    unpackBits(code, d, 16U);
+}
+
+/// <summary>
+/// Encode Hamming (16,11,4).
+/// </summary>
+/// <param name="code">Packed codeword (d[0] is bit 15).</param>
+void Hamming::encode16114(uint32_t& code)
+{
+    code &= 0xFFE0U;
+    code |= getSyndrome(HAMMING_16114_TABLE, code);
 }
 
 /// <summary>
@@ -352,49 +440,24 @@ bool Hamming::decode17123(bool* d)
 {
     assert(d != nullptr);
 
-    // Calculate the checksum this column should have
-    bool c0 = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[6] ^ d[7] ^ d[9];
-    bool c1 = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[7] ^ d[8] ^ d[10];
-    bool c2 = d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[8] ^ d[9] ^ d[11];
-    bool c3 = d[0] ^ d[1] ^ d[4] ^ d[5] ^ d[7] ^ d[10];
-    bool c4 = d[0] ^ d[1] ^ d[2] ^ d[5] ^ d[6] ^ d[8] ^ d[11];
-
-    // Compare these with the actual bits
-    unsigned char n = 0x00U;
-    n |= (c0 != d[12]) ? 0x01U : 0x00U;
-    n |= (c1 != d[13]) ? 0x02U : 0x00U;
-    n |= (c2 != d[14]) ? 0x04U : 0x00U;
-    n |= (c3 != d[15]) ? 0x08U : 0x00U;
-    n |= (c4 != d[16]) ? 0x10U : 0x00U;
-
-    switch (n) {
-        // Parity bit errors
-        case 0x01U: d[12] = !d[12]; return true;
-        case 0x02U: d[13] = !d[13]; return true;
-        case 0x04U: d[14] = !d[14]; return true;
-        case 0x08U: d[15] = !d[15]; return true;
-        case 0x10U: d[16] = !d[16]; return true;
-
-        // Data bit errors
-        case 0x1BU: d[0] = !d[0];  return true;
-        case 0x1FU: d[1] = !d[1];  return true;
-        case 0x17U: d[2] = !d[2];  return true;
-        case 0x07U: d[3] = !d[3];  return true;
-        case 0x0EU: d[4] = !d[4];  return true;
-        case 0x1CU: d[5] = !d[5];  return true;
-        case 0x11U: d[6] = !d[6];  return true;
-        case 0x0BU: d[7] = !d[7];  return true;
-        case 0x16U: d[8] = !d[8];  return true;
-        case 0x05U: d[9] = !d[9];  return true;
-        case 0x0AU: d[10] = !d[10]; return true;
-        case 0x14U: d[11] = !d[11]; return true;
-
-        // No bit errors
-        case 0x00U: return true;
-
-        // Unrecoverable errors
-        default: return false;
-    }
+    uint32_t code = packBits(d, 17U);
+    bool ret = decode17123(code);
+    unpackBits(code, d, 17U);
+
+    return ret;
+}
+
+/// <summary>
+/// Decode Hamming (17,12,3).
+/// </summary>
+/// <param name="code">Packed codeword (d[0] is bit 16).</param>
+/// <returns>True, if bit errors are detected or no bit errors, otherwise false if unrecoverable errors are detected.</returns>
+bool Hamming::decode17123(uint32_t& code)
+{
+    uint32_t n = getSyndrome(HAMMING_17123_TABLE, code);
+    uint32_t error = HAMMING_17123_TABLE.error[n];
+    code ^= error;
+    return n == 0U || error != 0U;
 }
 
 /// <summary>
@@ -405,9 +468,17 @@ void Hamming::encode17123(bool* d)
 {
     assert(d != nullptr);
 
-    d[12] = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[6] ^ d[7] ^ d[9];
-    d[13] = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[7] ^ d[8] ^ d[10];
-    d[14] = d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[8] ^ d[9] ^ d[11];
-    d[15] = d[0] ^ d[1] ^ d[4] ^ d[5] ^ d[7] ^ d[10];
-    d[16] = d[0] ^ d[1] ^ d[2] ^ d[5] ^ d[6] ^ d[8] ^ d[11];
+    uint32_t code = packBits(d, 17U);
+    encode17123(code);
+    unpackBits(code, d, 17U);
+}
+
+/// <summary>
+/// Encode Hamming (17,12,3).
+/// </summary>
+/// <param name="code">Packed codeword (d[0] is bit 16).</param>
+void Hamming::encode17123(uint32_t& code)
+{
+    code &= 0x1FFE0U;
+    code |= getSyndrome(HAMMING_17123_TABLE, code);
 }
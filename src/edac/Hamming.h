@@ -46,31 +46,55 @@ namespace edac
         static bool decode15113_1(bool* d);
         /// <summary>Encode Hamming (15,11,3).</summary>
         static void encode15113_1(bool* d);
+        /// <summary>Decode Hamming (15,11,3) from a packed codeword (d[0] is bit 14).</summary>
+        static bool decode15113_1(uint32_t& code);
+        /// <summary>Encode Hamming (15,11,3) into a packed codeword (d[0] is bit 14).</summary>
+        static void encode15113_1(uint32_t& code);
 
         /// <summary>Decode Hamming (15,11,3).</summary>
         static bool decode15113_2(bool* d);
         /// <summary>Encode Hamming (15,11,3).</summary>
         static void encode15113_2(bool* d);
+        /// <summary>Decode Hamming (15,11,3) from a packed codeword (d[0] is bit 14).</summary>
+        static bool decode15113_2(uint32_t& code);
+        /// <summary>Encode Hamming (15,11,3) into a packed codeword (d[0] is bit 14).</summary>
+        static void encode15113_2(uint32_t& code);
 
         /// <summary>Decode Hamming (13,9,3).</summary>
         static bool decode1393(bool* d);
         /// <summary>Encode Hamming (13,9,3).</summary>
         static void encode1393(bool* d);
+        /// <summary>Decode Hamming (13,9,3) from a packed codeword (d[0] is bit 12).</summary>
+        static bool decode1393(uint32_t& code);
+        /// <summary>Encode Hamming (13,9,3) into a packed codeword (d[0] is bit 12).</summary>
+        static void encode1393(uint32_t& code);
 
         /// <summary>Decode Hamming (10,6,3).</summary>
         static bool decode1063(bool* d);
         /// <summary>Encode Hamming (10,6,3).</summary>
         static void encode1063(bool* d);
+        /// <summary>Decode Hamming (10,6,3) from a packed codeword (d[0] is bit 9).</summary>
+        static bool decode1063(uint32_t& code);
+        /// <summary>Encode Hamming (10,6,3) into a packed codeword (d[0] is bit 9).</summary>
+        static void encode1063(uint32_t& code);
 
         /// <summary>Decode Hamming (16,11,4).</summary>
         static bool decode16114(bool* d);
         /// <summary>Encode Hamming (16,11,4).</summary>
         static void encode16114(bool* d);
+        /// <summary>Decode Hamming (16,11,4) from a packed codeword (d[0] is bit 15).</summary>
+        static bool decode16114(uint32_t& code);
+        /// <summary>Encode Hamming (16,11,4) into a packed codeword (d[0] is bit 15).</summary>
+        static void encode16114(uint32_t& code);
 
         /// <summary>Decode Hamming (17,12,3).</summary>
         static bool decode17123(bool* d);
         /// <summary>Encode Hamming (17,12,3).</summary>
         static void encode17123(bool* d);
+        /// <summary>Decode Hamming (17,12,3) from a packed codeword (d[0] is bit 16).</summary>
+        static bool decode17123(uint32_t& code);
+        /// <summary>Encode Hamming (17,12,3) into a packed codeword (d[0] is bit 16).</summary>
+        static void encode17123(uint32_t& code);
     };
 } // namespace edac
 
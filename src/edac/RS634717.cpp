@@ -32,6 +32,7 @@
 #include "edac/RS634717.h"
 #include "edac/rs/RS.h"
 #include "Log.h"
+#include "Metrics.h"
 
 using namespace edac;
 
@@ -181,9 +182,13 @@ bool RS634717::decode241213(uint8_t* data)
         hex2Bin(codeword[39 + i], data, offset);
 
     if ((ec == -1) || (ec >= 6)) {
+        Metrics::add(METRIC_FEC_RS241213_FAILED);
         return false;
     }
 
+    if (ec > 0)
+        Metrics::add(METRIC_FEC_RS241213_CORRECTED);
+
     return true;
 }
 
@@ -236,9 +241,13 @@ bool RS634717::decode24169(uint8_t* data)
         hex2Bin(codeword[39 + i], data, offset);
 
     if ((ec == -1) || (ec >= 4)) {
+        Metrics::add(METRIC_FEC_RS24169_FAILED);
         return false;
     }
 
+    if (ec > 0)
+        Metrics::add(METRIC_FEC_RS24169_CORRECTED);
+
     return true;
 }
 
@@ -291,9 +300,13 @@ bool RS634717::decode362017(uint8_t* data)
         hex2Bin(codeword[27 + i], data, offset);
 
     if ((ec == -1) || (ec >= 8)) {
+        Metrics::add(METRIC_FEC_RS362017_FAILED);
         return false;
     }
 
+    if (ec > 0)
+        Metrics::add(METRIC_FEC_RS362017_CORRECTED);
+
     return true;
 }
 
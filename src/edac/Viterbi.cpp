@@ -0,0 +1,246 @@
+/**
+* Digital Voice Modem - Host Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software
+*
+*/
+/*
+*   Copyright (C) 2023 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#include "Defines.h"
+#include "edac/Viterbi.h"
+
+using namespace edac;
+
+#include <cassert>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+// The trellis state is the previous input; there are at most 8 states, one per
+// SIMD lane.
+const uint32_t MAX_STATES = 8U;
+
+const uint8_t ENCODE_TABLE_34[] = {
+    0U,  8U, 4U, 12U, 2U, 10U, 6U, 14U,
+    4U, 12U, 2U, 10U, 6U, 14U, 0U,  8U,
+    1U,  9U, 5U, 13U, 3U, 11U, 7U, 15U,
+    5U, 13U, 3U, 11U, 7U, 15U, 1U,  9U,
+    3U, 11U, 7U, 15U, 1U,  9U, 5U, 13U,
+    7U, 15U, 1U,  9U, 5U, 13U, 3U, 11U,
+    2U, 10U, 6U, 14U, 0U,  8U, 4U, 12U,
+    6U, 14U, 0U,  8U, 4U, 12U, 2U, 10U };
+
+const uint8_t ENCODE_TABLE_12[] = {
+    0U,  15U, 12U,  3U,
+    4U,  11U,  8U,  7U,
+    13U,  2U,  1U, 14U,
+    9U,   6U,  5U, 10U };
+
+// 4FSK dibit levels of each constellation point
+const int8_t POINT_LEVELS[16U][2U] = {
+    { +1, -1 }, { -1, -1 }, { +3, -3 }, { -3, -3 }, { -3, -1 }, { +3, -1 }, { -1, -3 }, { +1, -3 },
+    { -3, +3 }, { +3, +3 }, { -1, +1 }, { +1, +1 }, { +1, +3 }, { -1, +3 }, { +3, +1 }, { -3, +1 } };
+
+/// <summary>
+/// Scaled dibit levels of the point emitted on each branch of a trellis, laid out
+/// with the next state (the input) in the SIMD lanes for each previous state.
+/// </summary>
+struct TrellisBranchTable {
+    int16_t level0[MAX_STATES][MAX_STATES];
+    int16_t level1[MAX_STATES][MAX_STATES];
+};
+
+/// <summary>
+/// Builds the branch table for a trellis.
+/// </summary>
+/// <param name="encodeTable">Trellis encode table.</param>
+/// <param name="numStates">Number of trellis states.</param>
+/// <returns></returns>
+constexpr TrellisBranchTable makeTrellisBranchTable(const uint8_t* encodeTable, uint32_t numStates)
+{
+    TrellisBranchTable t = {};
+    for (uint32_t s = 0U; s < numStates; s++) {
+        for (uint32_t n = 0U; n < numStates; n++) {
+            uint8_t point = encodeTable[s * numStates + n];
+            t.level0[s][n] = (int16_t)(POINT_LEVELS[point][0U] * VITERBI_SYMBOL_SCALE);
+            t.level1[s][n] = (int16_t)(POINT_LEVELS[point][1U] * VITERBI_SYMBOL_SCALE);
+        }
+    }
+
+    return t;
+}
+
+constexpr TrellisBranchTable BRANCH_TABLE_34 = makeTrellisBranchTable(ENCODE_TABLE_34, 8U);
+constexpr TrellisBranchTable BRANCH_TABLE_12 = makeTrellisBranchTable(ENCODE_TABLE_12, 4U);
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Performs the add-compare-select step for one trellis point.
+/// </summary>
+/// <remarks>
+/// The branch metric is the distance between the received symbols and the levels of
+/// the point on the branch. For every next state the surviving previous state is the
+/// first one with the lowest path metric, in every implementation.
+/// </remarks>
+/// <param name="branch">Branch table.</param>
+/// <param name="r0">First received symbol.</param>
+/// <param name="r1">Second received symbol.</param>
+/// <param name="numPrev">Number of previous states to consider.</param>
+/// <param name="metrics">Path metrics (updated in place).</param>
+/// <param name="decisions">Surviving previous state for each next state.</param>
+static inline void addCompareSelect(const TrellisBranchTable& branch, int16_t r0, int16_t r1, uint32_t numPrev,
+    int16_t* metrics, uint8_t* decisions)
+{
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    __m128i sym0 = _mm_set1_epi16(r0);
+    __m128i sym1 = _mm_set1_epi16(r1);
+
+    __m128i best = _mm_set1_epi16(0x7FFF);
+    __m128i prev = zero;
+    for (uint32_t s = 0U; s < numPrev; s++) {
+        __m128i d0 = _mm_sub_epi16(sym0, _mm_loadu_si128((const __m128i*)branch.level0[s]));
+        __m128i d1 = _mm_sub_epi16(sym1, _mm_loadu_si128((const __m128i*)branch.level1[s]));
+        __m128i bm = _mm_add_epi16(_mm_max_epi16(d0, _mm_sub_epi16(zero, d0)), _mm_max_epi16(d1, _mm_sub_epi16(zero, d1)));
+
+        __m128i cand = _mm_add_epi16(_mm_set1_epi16(metrics[s]), bm);
+        __m128i lt = _mm_cmplt_epi16(cand, best);
+        best = _mm_min_epi16(best, cand);
+        prev = _mm_or_si128(_mm_and_si128(lt, _mm_set1_epi16((int16_t)s)), _mm_andnot_si128(lt, prev));
+    }
+
+    _mm_storeu_si128((__m128i*)metrics, best);
+    _mm_storel_epi64((__m128i*)decisions, _mm_packus_epi16(prev, prev));
+#else
+    int16_t best[MAX_STATES];
+    for (uint32_t n = 0U; n < MAX_STATES; n++) {
+        best[n] = 0x7FFF;
+        decisions[n] = 0U;
+    }
+
+    for (uint32_t s = 0U; s < numPrev; s++) {
+        for (uint32_t n = 0U; n < MAX_STATES; n++) {
+            int16_t d0 = r0 - branch.level0[s][n];
+            int16_t d1 = r1 - branch.level1[s][n];
+            int16_t cand = metrics[s] + (d0 < 0 ? -d0 : d0) + (d1 < 0 ? -d1 : d1);
+            if (cand < best[n]) {
+                best[n] = cand;
+                decisions[n] = (uint8_t)s;
+            }
+        }
+    }
+
+    for (uint32_t n = 0U; n < MAX_STATES; n++)
+        metrics[n] = best[n];
+#endif
+}
+
+/// <summary>
+/// Slices a soft symbol to the nearest nominal scaled level.
+/// </summary>
+/// <param name="symbol"></param>
+/// <returns></returns>
+static inline int16_t sliceSymbol(int8_t symbol)
+{
+    if (symbol >= 2 * VITERBI_SYMBOL_SCALE)
+        return 3 * VITERBI_SYMBOL_SCALE;
+    if (symbol >= 0)
+        return VITERBI_SYMBOL_SCALE;
+    if (symbol >= -2 * VITERBI_SYMBOL_SCALE)
+        return -VITERBI_SYMBOL_SCALE;
+    return -3 * VITERBI_SYMBOL_SCALE;
+}
+
+/// <summary>
+/// Decodes a Trellis coded block.
+/// </summary>
+/// <remarks>
+/// The encoder starts in state 0 and the final input is always 0, so the decoded path
+/// starts and ends in state 0.
+/// </remarks>
+/// <param name="branch">Branch table.</param>
+/// <param name="numStates">Number of trellis states.</param>
+/// <param name="symbols">Deinterleaved soft symbols.</param>
+/// <param name="inputs">Decoded encoder inputs.</param>
+/// <returns>Number of points on the decoded path that differ from the hard decisions.</returns>
+static uint32_t decodeTrellis(const TrellisBranchTable& branch, uint32_t numStates, const int8_t* symbols, uint8_t* inputs)
+{
+    int16_t metrics[MAX_STATES] = { 0 };
+    uint8_t decisions[VITERBI_TRELLIS_POINTS][MAX_STATES];
+    for (uint32_t i = 0U; i < VITERBI_TRELLIS_POINTS; i++) {
+        addCompareSelect(branch, symbols[i * 2U + 0U], symbols[i * 2U + 1U], (i == 0U) ? 1U : numStates,
+            metrics, decisions[i]);
+    }
+
+    uint32_t errors = 0U;
+    uint32_t state = 0U;
+    for (uint32_t i = VITERBI_TRELLIS_POINTS; i-- > 0U; ) {
+        uint32_t prev = decisions[i][state];
+        inputs[i] = (uint8_t)state;
+
+        if (sliceSymbol(symbols[i * 2U + 0U]) != branch.level0[prev][state] ||
+            sliceSymbol(symbols[i * 2U + 1U]) != branch.level1[prev][state])
+            errors++;
+
+        state = prev;
+    }
+
+    return errors;
+}
+
+// ---------------------------------------------------------------------------
+//  Static Class Members
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Decodes 3/4 rate Trellis coded symbols into tribits.
+/// </summary>
+/// <param name="symbols">98 deinterleaved soft symbols.</param>
+/// <param name="tribits">49 decoded tribits.</param>
+/// <returns>Number of points on the decoded path that differ from the hard decisions.</returns>
+uint32_t Viterbi::decodeTrellis34(const int8_t* symbols, uint8_t* tribits)
+{
+    assert(symbols != nullptr);
+    assert(tribits != nullptr);
+
+    return decodeTrellis(BRANCH_TABLE_34, 8U, symbols, tribits);
+}
+
+/// <summary>
+/// Decodes 1/2 rate Trellis coded symbols into dibits.
+/// </summary>
+/// <param name="symbols">98 deinterleaved soft symbols.</param>
+/// <param name="dibits">49 decoded dibits.</param>
+/// <returns>Number of points on the decoded path that differ from the hard decisions.</returns>
+uint32_t Viterbi::decodeTrellis12(const int8_t* symbols, uint8_t* dibits)
+{
+    assert(symbols != nullptr);
+    assert(dibits != nullptr);
+
+    return decodeTrellis(BRANCH_TABLE_12, 4U, symbols, dibits);
+}
@@ -0,0 +1,60 @@
+/**
+* Digital Voice Modem - Host Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software
+*
+*/
+/*
+*   Copyright (C) 2023 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#if !defined(__VITERBI_H__)
+#define __VITERBI_H__
+
+#include "Defines.h"
+
+namespace edac
+{
+    // ---------------------------------------------------------------------------
+    //  Constants
+    // ---------------------------------------------------------------------------
+
+    // Soft symbols are the received 4FSK symbol levels scaled so that the nominal
+    // +1 and +3 levels are +32 and +96 (-1 and -3 are -32 and -96); hard decisions
+    // map exactly onto the nominal levels.
+    const int8_t VITERBI_SYMBOL_SCALE = 32;
+
+    const uint32_t VITERBI_TRELLIS_POINTS = 49U;
+    const uint32_t VITERBI_TRELLIS_SYMBOLS = 98U;
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    //      Implements a soft decision Viterbi decoder for the 1/2 rate and 3/4 rate
+    //      4FSK Trellis codes used by DMR and P25.
+    // ---------------------------------------------------------------------------
+
+    class HOST_SW_API Viterbi {
+    public:
+        /// <summary>Decodes 3/4 rate Trellis coded symbols into tribits.</summary>
+        static uint32_t decodeTrellis34(const int8_t* symbols, uint8_t* tribits);
+        /// <summary>Decodes 1/2 rate Trellis coded symbols into dibits.</summary>
+        static uint32_t decodeTrellis12(const int8_t* symbols, uint8_t* dibits);
+    };
+} // namespace edac
+
+#endif // __VITERBI_H__
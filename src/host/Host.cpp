@@ -40,6 +40,7 @@
 #include "modem/port/PseudoPTYPort.h"
 #include "modem/port/UDPPort.h"
 #include "network/UDPSocket.h"
+#include "network/Reactor.h"
 #include "lookups/RSSIInterpolator.h"
 #include "host/Host.h"
 #include "HostMain.h"
@@ -70,6 +71,8 @@ using namespace lookups;
 
 #define CW_IDLE_SLEEP_MS 50U
 #define IDLE_WARMUP_MS 5U
+#define EVENT_IDLE_MAX_WAIT_MS 50U
+#define EVENT_HOUSEKEEPING_INTERVAL_MS 1000U
 
 // ---------------------------------------------------------------------------
 //  Public Class Members
@@ -143,7 +146,9 @@ Host::Host(const std::string& confFile) :
     m_supervisor(false),
     m_activeTickDelay(5U),
     m_idleTickDelay(5U),
-    m_RESTAPI(nullptr)
+    m_eventDriven(true),
+    m_RESTAPI(nullptr),
+    m_restClientPool(nullptr)
 {
     /* stub */
 }
@@ -227,6 +232,13 @@ int Host::run()
         ::close(STDERR_FILENO);
     }
 
+    // start the asynchronous log writer (threads do not survive the fork above)
+    if (logConf["async"].as<bool>(false)) {
+        if (!::LogStartAsync()) {
+            ::LogWarning(LOG_HOST, "Failed to start the asynchronous log writer, logging synchronously");
+        }
+    }
+
     getHostVersion();
     ::LogInfo(">> Modem Controller");
 
@@ -756,6 +768,20 @@ int Host::run()
         stopWatch.start();
     }
 
+    // in event driven mode the main loop sleeps until the modem or network has data, or the nearest
+    // host timer is due, instead of for a fixed tick
+    std::unique_ptr<Reactor> reactor = nullptr;
+    if (m_eventDriven && !killed) {
+        reactor = std::unique_ptr<Reactor>(new Reactor());
+        if (reactor->open(EVENT_HOUSEKEEPING_INTERVAL_MS)) {
+            watchEvents(*reactor);
+        }
+        else {
+            ::LogError(LOG_HOST, "Failed to initialize the host event reactor, falling back to fixed tick delays");
+            reactor = nullptr;
+        }
+    }
+
     bool hasTxShutdown = false;
 
     // Macro to interrupt a running P25 control channel transmission
@@ -1072,8 +1098,7 @@ int Host::run()
         //  -- Modem Clocking                                 --
         // ------------------------------------------------------
 
-        ms = stopWatch.elapsed();
-        stopWatch.start();
+        ms = stopWatch.lap();
 
         m_modem->clock(ms);
 
@@ -1321,6 +1346,9 @@ int Host::run()
         if (m_network != nullptr)
             m_network->clock(ms);
 
+        if (m_restClientPool != nullptr)
+            m_restClientPool->clock();
+
 #if defined(ENABLE_DMR)
         if (dmr != nullptr)
             dmr->clock(ms);
@@ -1646,10 +1674,40 @@ int Host::run()
 
         m_modeTimer.clock(ms);
 
-        if ((m_state != STATE_IDLE) && ms <= m_activeTickDelay)
-            Thread::sleep(m_activeTickDelay);
-        if (m_state == STATE_IDLE)
-            Thread::sleep(m_idleTickDelay);
+        if (reactor != nullptr) {
+            // while active the protocol controllers are still paced by the tick delay; when idle the
+            // wait is only bounded by the nearest running host timer
+            uint32_t timeout = (m_state != STATE_IDLE) ? m_activeTickDelay : EVENT_IDLE_MAX_WAIT_MS;
+
+            Timer* timers[] = { &m_modeTimer, &m_dmrTXTimer, &m_cwIdTimer, &dmrBeaconIntervalTimer, &dmrBeaconDurationTimer,
+                &p25BcastIntervalTimer, &p25BcastDurationTimer, &nxdnBcastIntervalTimer, &nxdnBcastDurationTimer };
+            for (Timer* timer : timers) {
+                if (!timer->isRunning() || timer->isPaused())
+                    continue;
+
+                // expired timers are left for the tick bound to re-check, otherwise they would spin the loop
+                uint32_t remaining = timer->getRemainingMs();
+                if (remaining > 0U && remaining < timeout)
+                    timeout = remaining;
+            }
+
+            bool ticked = false;
+            reactor->wait((int)timeout, ticked);
+
+            // the network socket may have been reopened while clocking
+            if (ticked)
+                watchEvents(*reactor);
+        }
+        else {
+            if ((m_state != STATE_IDLE) && ms <= m_activeTickDelay)
+                Thread::sleep(m_activeTickDelay);
+            if (m_state == STATE_IDLE)
+                Thread::sleep(m_idleTickDelay);
+        }
+    }
+
+    if (reactor != nullptr) {
+        reactor->close();
     }
 
     if (rssi != nullptr) {
@@ -1718,6 +1776,7 @@ bool Host::readParams()
     m_idleTickDelay = (uint8_t)systemConf["idleTickDelay"].as<uint32_t>(5U);
     if (m_idleTickDelay < 1U)
         m_idleTickDelay = 1U;
+    m_eventDriven = systemConf["eventDriven"].as<bool>(true);
 
     m_identity = systemConf["identity"].as<std::string>();
     m_fixedMode = systemConf["fixedMode"].as<bool>(false);
@@ -1744,6 +1803,7 @@ bool Host::readParams()
         }
         LogInfo("    Active Tick Delay: %ums", m_activeTickDelay);
         LogInfo("    Idle Tick Delay: %ums", m_idleTickDelay);
+        LogInfo("    Event Driven: %s", m_eventDriven ? "yes" : "no");
         LogInfo("    Timeout: %us", m_timeout);
         LogInfo("    RF Mode Hang: %us", m_rfModeHang);
         LogInfo("    RF Talkgroup Hang: %us", m_rfTalkgroupHang);
@@ -2095,6 +2155,7 @@ bool Host::createModem()
     bool disableOFlowReset = modemConf["disableOFlowReset"].as<bool>(false);
     bool ignoreModemConfigArea = modemConf["ignoreModemConfigArea"].as<bool>(false);
     bool dumpModemStatus = modemConf["dumpModemStatus"].as<bool>(false);
+    bool ioThread = modemConf["ioThread"].as<bool>(true);
     bool trace = modemConf["trace"].as<bool>(false);
     bool debug = modemConf["debug"].as<bool>(false);
 
@@ -2209,6 +2270,7 @@ bool Host::createModem()
         LogInfo("    P25 TX Level: %.1f%%", p25TXLevel);
         LogInfo("    NXDN TX Level: %.1f%%", nxdnTXLevel);
         LogInfo("    Disable Overflow Reset: %s", disableOFlowReset ? "yes" : "no");
+        LogInfo("    Threaded Port I/O: %s", ioThread ? "yes" : "no");
         LogInfo("    DMR Queue Size: %u (%u bytes)", dmrQueueSize, m_dmrQueueSizeBytes);
         LogInfo("    P25 Queue Size: %u (%u bytes)", p25QueueSize, m_p25QueueSizeBytes);
         LogInfo("    NXDN Queue Size: %u (%u bytes)", nxdnQueueSize, m_nxdnQueueSizeBytes);
@@ -2258,6 +2320,11 @@ bool Host::createModem()
 
     m_modem->setFifoLength(dmrFifoLength, p25FifoLength, nxdnFifoLength);
 
+    // hand port I/O off to its own thread only once the synchronous configuration exchange is done
+    if (ioThread) {
+        m_modem->setIOThread(true);
+    }
+
     // are we on a protocol version older then 3?
     if (m_modem->getVersion() < 3U) {
         if (m_nxdnEnabled) {
@@ -2389,6 +2456,15 @@ bool Host::createNetwork()
         m_RESTAPI = nullptr;
     }
 
+    // initialize the REST client used for channel grant dispatch; requests are queued to
+    // a worker and their completions delivered back to the host loop
+    m_restClientPool = new RESTClientPool(REST_CLIENT_POOL_TIMEOUT_MS, restApiDebug);
+    if (!m_restClientPool->open()) {
+        delete m_restClientPool;
+        m_restClientPool = nullptr;
+        LogWarning(LOG_HOST, "failed to start the REST client pool, channel grant dispatch will block the host loop");
+    }
+
     return true;
 }
 
@@ -2473,6 +2549,23 @@ bool Host::rmtPortModemHandler(Modem* modem, uint32_t ms, modem::RESP_TYPE_DVM r
     return true;
 }
 
+/// <summary>
+/// Registers the modem and network event descriptors with the event reactor.
+/// </summary>
+/// <param name="reactor">Event reactor.</param>
+void Host::watchEvents(Reactor& reactor)
+{
+    if (m_modem != nullptr) {
+        reactor.watch(m_modem->getEventFd());
+    }
+
+    if (m_network != nullptr) {
+        for (uint32_t i = 0U; i < UDP_SOCKET_MAX; i++) {
+            reactor.watch(m_network->getSocket()->fd(i));
+        }
+    }
+}
+
 /// <summary>
 /// Helper to set the host/modem running state.
 /// </summary>
@@ -2581,6 +2674,11 @@ void Host::setState(uint8_t state)
                     delete m_network;
                 }
 
+                if (m_restClientPool != nullptr) {
+                    m_restClientPool->close();
+                    delete m_restClientPool;
+                }
+
                 if (m_RESTAPI != nullptr) {
                     m_RESTAPI->close();
                     delete m_RESTAPI;
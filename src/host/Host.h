@@ -34,6 +34,7 @@
 #include "Defines.h"
 #include "network/Network.h"
 #include "network/RESTAPI.h"
+#include "remote/RESTClientPool.h"
 #include "modem/Modem.h"
 #include "Timer.h"
 #include "lookups/AffiliationLookup.h"
@@ -50,6 +51,7 @@
 // ---------------------------------------------------------------------------
 
 class HOST_SW_API RESTAPI;
+namespace network { class HOST_SW_API Reactor; }
 
 // ---------------------------------------------------------------------------
 //  Class Declaration
@@ -153,10 +155,13 @@ private:
 
     uint8_t m_activeTickDelay;
     uint8_t m_idleTickDelay;
+    bool m_eventDriven;
 
     friend class RESTAPI;
     RESTAPI* m_RESTAPI;
 
+    RESTClientPool* m_restClientPool;
+
     /// <summary>Reads basic configuration parameters from the INI.</summary>
     bool readParams();
     /// <summary>Initializes the modem DSP.</summary>
@@ -164,6 +169,9 @@ private:
     /// <summary>Initializes network connectivity.</summary>
     bool createNetwork();
 
+    /// <summary>Registers the modem and network event descriptors with the event reactor.</summary>
+    void watchEvents(network::Reactor& reactor);
+
     /// <summary>Modem port open callback.</summary>
     bool rmtPortModemOpen(modem::Modem* modem);
     /// <summary>Modem port close callback.</summary>
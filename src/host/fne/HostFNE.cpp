@@ -28,6 +28,8 @@
 #include "network/fne/TagP25Data.h"
 #include "network/fne/TagNXDNData.h"
 #include "network/UDPSocket.h"
+#include "network/MetricsServer.h"
+#include "network/Reactor.h"
 #include "host/fne/HostFNE.h"
 #include "HostMain.h"
 #include "Log.h"
@@ -55,6 +57,7 @@ using namespace lookups;
 // ---------------------------------------------------------------------------
 
 #define IDLE_WARMUP_MS 5U
+#define HOUSEKEEPING_INTERVAL_MS 100U
 
 // ---------------------------------------------------------------------------
 //  Public Class Members
@@ -68,6 +71,7 @@ HostFNE::HostFNE(const std::string& confFile) :
     m_confFile(confFile),
     m_conf(),
     m_network(nullptr),
+    m_metricsServer(nullptr),
     m_dmrEnabled(false),
     m_p25Enabled(false),
     m_nxdnEnabled(false),
@@ -162,6 +166,13 @@ int HostFNE::run()
         ::close(STDERR_FILENO);
     }
 
+    // start the asynchronous log writer (threads do not survive the fork above)
+    if (logConf["async"].as<bool>(false)) {
+        if (!::LogStartAsync()) {
+            ::LogWarning(LOG_HOST, "Failed to start the asynchronous log writer, logging synchronously");
+        }
+    }
+
     getHostVersion();
     ::LogInfo(">> Fixed Network Equipment");
 
@@ -194,6 +205,16 @@ int HostFNE::run()
     if (!ret)
         return EXIT_FAILURE;
 
+    // the main loop sleeps until network traffic arrives, or the housekeeping tick expires to clock
+    // the network timers
+    Reactor reactor;
+    if (!reactor.open(HOUSEKEEPING_INTERVAL_MS)) {
+        ::LogError(LOG_HOST, "Failed to initialize the FNE event reactor");
+        return EXIT_FAILURE;
+    }
+
+    watchNetworks(reactor);
+
     ::LogInfoEx(LOG_HOST, "FNE is up and running");
 
     StopWatch stopWatch;
@@ -225,8 +246,34 @@ int HostFNE::run()
             }
         }
 
-        if (ms < 2U)
-            Thread::sleep(1U);
+        // parrot playback is paced by this loop, so don't sleep while frames are waiting
+        int timeout = -1;
+        if (m_network != nullptr && m_network->hasParrotFrames())
+            timeout = 0;
+
+        // wake up again when the next frame buffered on a peer link is due for playout
+        for (auto network : m_peerNetworks) {
+            network::Network* peerNetwork = network.second;
+            if (peerNetwork != nullptr && timeout != 0) {
+                int32_t delay = peerNetwork->playoutDelay();
+                if (delay >= 0 && (timeout < 0 || delay < timeout))
+                    timeout = delay;
+            }
+        }
+
+        bool ticked = false;
+        reactor.wait(timeout, ticked);
+
+        // sockets may have been (re)opened while clocking
+        if (ticked)
+            watchNetworks(reactor);
+    }
+
+    reactor.close();
+
+    if (m_metricsServer != nullptr) {
+        m_metricsServer->close();
+        delete m_metricsServer;
     }
 
     if (m_network != nullptr) {
@@ -328,6 +375,12 @@ bool HostFNE::createMasterNetwork()
     m_p25Enabled = masterConf["allowP25Traffic"].as<bool>(true);
     m_nxdnEnabled = masterConf["allowNXDNTraffic"].as<bool>(true);
 
+    uint32_t workers = masterConf["workers"].as<uint32_t>(0U);
+
+    bool metricsEnable = masterConf["metricsEnable"].as<bool>(false);
+    std::string metricsAddress = masterConf["metricsAddress"].as<std::string>("127.0.0.1");
+    uint16_t metricsPort = (uint16_t)masterConf["metricsPort"].as<uint32_t>(METRICS_DEFAULT_PORT);
+
     uint32_t parrotDelay = masterConf["parrotDelay"].as<uint32_t>(2500U);
     if (m_pingTime * 1000U < parrotDelay) {
         LogWarning(LOG_HOST, "Parrot delay cannot be longer then the ping time of a peer. Reducing parrot delay to half the ping time.");
@@ -342,6 +395,12 @@ bool HostFNE::createMasterNetwork()
     LogInfo("    Allow P25 Traffic: %s", m_p25Enabled ? "yes" : "no");
     LogInfo("    Allow NXDN Traffic: %s", m_nxdnEnabled ? "yes" : "no");
     LogInfo("    Parrot Repeat Delay: %u ms", parrotDelay);
+    LogInfo("    Packet Workers: %u", workers);
+    LogInfo("    Metrics Enabled: %s", metricsEnable ? "yes" : "no");
+    if (metricsEnable) {
+        LogInfo("    Metrics Address: %s", metricsAddress.c_str());
+        LogInfo("    Metrics Port: %u", metricsPort);
+    }
 
     if (verbose) {
         LogInfo("    Verbose: yes");
@@ -353,7 +412,7 @@ bool HostFNE::createMasterNetwork()
 
     // initialize networking
     m_network = new FNENetwork(this, address, port, id, password, debug, verbose, m_dmrEnabled, m_p25Enabled, m_nxdnEnabled, parrotDelay,
-        m_allowActivityTransfer, m_allowDiagnosticTransfer, m_pingTime, m_updateLookupTime);
+        m_allowActivityTransfer, m_allowDiagnosticTransfer, m_pingTime, m_updateLookupTime, workers);
 
     m_network->setLookups(m_ridLookup, m_tidLookup);
 
@@ -365,6 +424,18 @@ bool HostFNE::createMasterNetwork()
         return false;
     }
 
+    // initialize the metrics endpoint
+    if (metricsEnable) {
+        m_metricsServer = new MetricsServer(metricsAddress, metricsPort, debug);
+        ret = m_metricsServer->open();
+        if (!ret) {
+            delete m_metricsServer;
+            m_metricsServer = nullptr;
+            LogError(LOG_HOST, "failed to initialize metrics networking! Metrics will be unavailable!");
+            // metrics failing isn't fatal -- we'll allow this to return normally
+        }
+    }
+
     return true;
 }
 
@@ -415,6 +486,28 @@ bool HostFNE::createPeerNetworks()
     return true;
 }
 
+/// <summary>
+/// Registers the master and peer network sockets with the event reactor.
+/// </summary>
+/// <param name="reactor">Event reactor.</param>
+void HostFNE::watchNetworks(Reactor& reactor)
+{
+    if (m_network != nullptr) {
+        for (uint32_t i = 0U; i < UDP_SOCKET_MAX; i++) {
+            reactor.watch(m_network->getSocket()->fd(i));
+        }
+    }
+
+    for (auto network : m_peerNetworks) {
+        network::Network* peerNetwork = network.second;
+        if (peerNetwork != nullptr) {
+            for (uint32_t i = 0U; i < UDP_SOCKET_MAX; i++) {
+                reactor.watch(peerNetwork->getSocket()->fd(i));
+            }
+        }
+    }
+}
+
 /// <summary>
 /// Processes any peer network traffic.
 /// </summary>
@@ -426,43 +519,46 @@ void HostFNE::processPeer(network::Network* peerNetwork)
     if (peerNetwork->getStatus() != NET_STAT_RUNNING)
         return;
 
-    // process DMR data
-    if (peerNetwork->hasDMRData()) {
-        uint32_t length = 100U;
-        bool ret = false;
-        UInt8Array data = peerNetwork->readDMR(ret, length);
-        if (ret) {
-            uint32_t peerId = peerNetwork->getPeerId();
-            uint32_t slotNo = (data[15U] & 0x80U) == 0x80U ? 2U : 1U;
-            uint32_t streamId = peerNetwork->getDMRStreamId(slotNo);
-
-            m_network->dmrTrafficHandler()->processFrame(data.get(), length, peerId, peerNetwork->pktLastSeq(), streamId);
+    // a single batched read may have queued several frames, process all of them in this pass
+    while (peerNetwork->hasDMRData() || peerNetwork->hasP25Data() || peerNetwork->hasNXDNData()) {
+        // process DMR data
+        if (peerNetwork->hasDMRData()) {
+            uint32_t length = 100U;
+            bool ret = false;
+            UInt8Array data = peerNetwork->readDMR(ret, length);
+            if (ret) {
+                uint32_t peerId = peerNetwork->getPeerId();
+                uint32_t slotNo = (data[15U] & 0x80U) == 0x80U ? 2U : 1U;
+                uint32_t streamId = peerNetwork->getDMRStreamId(slotNo);
+
+                m_network->dmrTrafficHandler()->processFrame(data.get(), length, peerId, peerNetwork->pktLastSeq(), streamId);
+            }
         }
-    }
 
-    // process P25 data
-    if (peerNetwork->hasP25Data()) {
-        uint32_t length = 100U;
-        bool ret = false;
-        UInt8Array data = peerNetwork->readP25(ret, length);
-        if (ret) {
-            uint32_t peerId = peerNetwork->getPeerId();
-            uint32_t streamId = peerNetwork->getP25StreamId();
+        // process P25 data
+        if (peerNetwork->hasP25Data()) {
+            uint32_t length = 100U;
+            bool ret = false;
+            UInt8Array data = peerNetwork->readP25(ret, length);
+            if (ret) {
+                uint32_t peerId = peerNetwork->getPeerId();
+                uint32_t streamId = peerNetwork->getP25StreamId();
 
-            m_network->p25TrafficHandler()->processFrame(data.get(), length, peerId, peerNetwork->pktLastSeq(), streamId);
+                m_network->p25TrafficHandler()->processFrame(data.get(), length, peerId, peerNetwork->pktLastSeq(), streamId);
+            }
         }
-    }
 
-    // process NXDN data
-    if (peerNetwork->hasNXDNData()) {
-        uint32_t length = 100U;
-        bool ret = false;
-        UInt8Array data = peerNetwork->readNXDN(ret, length);
-        if (ret) {
-            uint32_t peerId = peerNetwork->getPeerId();
-            uint32_t streamId = peerNetwork->getNXDNStreamId();
+        // process NXDN data
+        if (peerNetwork->hasNXDNData()) {
+            uint32_t length = 100U;
+            bool ret = false;
+            UInt8Array data = peerNetwork->readNXDN(ret, length);
+            if (ret) {
+                uint32_t peerId = peerNetwork->getPeerId();
+                uint32_t streamId = peerNetwork->getNXDNStreamId();
 
-            m_network->nxdnTrafficHandler()->processFrame(data.get(), length, peerId, peerNetwork->pktLastSeq(), streamId);
+                m_network->nxdnTrafficHandler()->processFrame(data.get(), length, peerId, peerNetwork->pktLastSeq(), streamId);
+            }
         }
     }
 }
\ No newline at end of file
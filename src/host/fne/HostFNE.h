@@ -45,6 +45,8 @@
 namespace network { namespace fne { class HOST_SW_API TagDMRData; } }
 namespace network { namespace fne { class HOST_SW_API TagP25Data; } }
 namespace network { namespace fne { class HOST_SW_API TagNXDNData; } }
+namespace network { class HOST_SW_API Reactor; }
+class HOST_SW_API MetricsServer;
 
 // ---------------------------------------------------------------------------
 //  Class Declaration
@@ -70,6 +72,7 @@ private:
     friend class network::fne::TagP25Data;
     friend class network::fne::TagNXDNData;
     network::FNENetwork* m_network;
+    MetricsServer* m_metricsServer;
 
     bool m_dmrEnabled;
     bool m_p25Enabled;
@@ -94,6 +97,9 @@ private:
     /// <summary>Initializes peer FNE network connectivity.</summary>
     bool createPeerNetworks();
 
+    /// <summary>Registers the master and peer network sockets with the event reactor.</summary>
+    void watchNetworks(network::Reactor& reactor);
+
     /// <summary>Processes any peer network traffic.</summary>
     void processPeer(network::Network* peerNetwork);
 };
@@ -531,7 +531,7 @@ bool HostSetup::portModemHandler(Modem* modem, uint32_t ms, RESP_TYPE_DVM rspTyp
         case CMD_DEBUG4:
         case CMD_DEBUG5:
         case CMD_DEBUG_DUMP:
-            m_modem->printDebug(buffer, len);
+            m_modem->printDebug(buffer, len, rspDblLen);
             break;
 
         default:
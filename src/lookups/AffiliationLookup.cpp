@@ -33,6 +33,13 @@ using namespace lookups;
 #include <cstring>
 #include <ctime>
 
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t GRANT_TIMER_TICK_MS = 100U;
+const uint32_t GRANT_TIMER_SLOTS = 128U;
+
 // ---------------------------------------------------------------------------
 //  Public Class Members
 // ---------------------------------------------------------------------------
@@ -48,9 +55,11 @@ AffiliationLookup::AffiliationLookup(const char* name, bool verbose) :
     m_rfGrantChCnt(0U),
     m_unitRegTable(),
     m_grpAffTable(),
+    m_grpAffDstTable(),
     m_grantChTable(),
     m_grantSrcIdTable(),
-    m_grantTimers(),
+    m_grantTimers(GRANT_TIMER_TICK_MS, GRANT_TIMER_SLOTS),
+    m_expiredGrants(),
     m_releaseGrant(nullptr),
     m_name(name),
     m_verbose(verbose)
@@ -59,6 +68,7 @@ AffiliationLookup::AffiliationLookup(const char* name, bool verbose) :
 
     m_unitRegTable.clear();
     m_grpAffTable.clear();
+    m_grpAffDstTable.clear();
 
     m_grantChTable.clear();
     m_grantSrcIdTable.clear();
@@ -83,7 +93,7 @@ void AffiliationLookup::unitReg(uint32_t srcId)
         return;
     }
 
-    m_unitRegTable.push_back(srcId);
+    m_unitRegTable.insert(srcId);
 
     if (m_verbose) {
         LogMessage(LOG_HOST, "%s, unit registration, srcId = %u",
@@ -111,9 +121,7 @@ bool AffiliationLookup::unitDereg(uint32_t srcId)
     groupUnaff(srcId);
 
     // remove dynamic unit registration table entry
-    if (std::find(m_unitRegTable.begin(), m_unitRegTable.end(), srcId) != m_unitRegTable.end()) {
-        auto it = std::find(m_unitRegTable.begin(), m_unitRegTable.end(), srcId);
-        m_unitRegTable.erase(it);
+    if (m_unitRegTable.erase(srcId) > 0U) {
         ret = true;
     }
 
@@ -128,12 +136,7 @@ bool AffiliationLookup::unitDereg(uint32_t srcId)
 bool AffiliationLookup::isUnitReg(uint32_t srcId) const
 {
     // lookup dynamic unit registration table entry
-    if (std::find(m_unitRegTable.begin(), m_unitRegTable.end(), srcId) != m_unitRegTable.end()) {
-        return true;
-    }
-    else {
-        return false;
-    }
+    return m_unitRegTable.find(srcId) != m_unitRegTable.end();
 }
 
 /// <summary>
@@ -144,8 +147,15 @@ bool AffiliationLookup::isUnitReg(uint32_t srcId) const
 void AffiliationLookup::groupAff(uint32_t srcId, uint32_t dstId)
 {
     if (!isGroupAff(srcId, dstId)) {
-        // update dynamic affiliation table
+        // a source ID is only ever affiliated to one group; move it out of the old group
+        auto it = m_grpAffTable.find(srcId);
+        if (it != m_grpAffTable.end()) {
+            removeGroupAffMember(it->second, srcId);
+        }
+
+        // update dynamic affiliation tables
         m_grpAffTable[srcId] = dstId;
+        m_grpAffDstTable[dstId].insert(srcId);
 
         if (m_verbose) {
             LogMessage(LOG_HOST, "%s, group affiliation, srcId = %u, dstId = %u",
@@ -161,25 +171,21 @@ void AffiliationLookup::groupAff(uint32_t srcId, uint32_t dstId)
 bool AffiliationLookup::groupUnaff(uint32_t srcId)
 {
     // lookup dynamic affiliation table entry
-    try {
-        uint32_t tblDstId = m_grpAffTable.at(srcId);
-        if (m_verbose) {
-            LogMessage(LOG_HOST, "%s, group unaffiliation, srcId = %u, dstId = %u",
-                m_name, srcId, tblDstId);
-        }
-    } catch (...) {
+    auto it = m_grpAffTable.find(srcId);
+    if (it == m_grpAffTable.end()) {
         return false;
     }
 
-    // remove dynamic affiliation table entry
-    try {
-        m_grpAffTable.at(srcId);
-        m_grpAffTable.erase(srcId);
-        return true;
-    }
-    catch (...) {
-        return false;
+    uint32_t tblDstId = it->second;
+    if (m_verbose) {
+        LogMessage(LOG_HOST, "%s, group unaffiliation, srcId = %u, dstId = %u",
+            m_name, srcId, tblDstId);
     }
+
+    // remove dynamic affiliation table entries
+    m_grpAffTable.erase(it);
+    removeGroupAffMember(tblDstId, srcId);
+    return true;
 }
 
 /// <summary>
@@ -191,17 +197,8 @@ bool AffiliationLookup::groupUnaff(uint32_t srcId)
 bool AffiliationLookup::isGroupAff(uint32_t srcId, uint32_t dstId) const
 {
     // lookup dynamic affiliation table entry
-    try {
-        uint32_t tblDstId = m_grpAffTable.at(srcId);
-        if (tblDstId == dstId) {
-            return true;
-        }
-        else {
-            return false;
-        }
-    } catch (...) {
-        return false;
-    }
+    auto it = m_grpAffTable.find(srcId);
+    return it != m_grpAffTable.end() && it->second == dstId;
 }
 
 /// <summary>
@@ -225,12 +222,9 @@ std::vector<uint32_t> AffiliationLookup::clearGroupAff(uint32_t dstId, bool rele
     }
     else {
         LogWarning(LOG_HOST, "%s, releasing group affiliations, dstId = %u", m_name, dstId);
-        for (auto entry : m_grpAffTable) {
-            uint32_t srcId = entry.first;
-            uint32_t grpId = entry.second;
-            if (grpId == dstId) {
-                srcToRel.push_back(srcId);
-            }
+        auto it = m_grpAffDstTable.find(dstId);
+        if (it != m_grpAffDstTable.end()) {
+            srcToRel.assign(it->second.begin(), it->second.end());
         }
     }
 
@@ -262,8 +256,7 @@ bool AffiliationLookup::grantCh(uint32_t dstId, uint32_t srcId, uint32_t grantTi
     m_grantSrcIdTable[dstId] = srcId;
     m_rfGrantChCnt++;
 
-    m_grantTimers[dstId] = Timer(1000U, grantTimeout);
-    m_grantTimers[dstId].start();
+    m_grantTimers.start(dstId, grantTimeout * 1000U);
 
     if (m_verbose) {
         LogMessage(LOG_HOST, "%s, granting channel, chNo = %u, dstId = %u, srcId = %u",
@@ -285,7 +278,7 @@ void AffiliationLookup::touchGrant(uint32_t dstId)
     }
 
     if (isGranted(dstId)) {
-        m_grantTimers[dstId].start();
+        m_grantTimers.restart(dstId);
     }
 }
 
@@ -341,7 +334,7 @@ bool AffiliationLookup::releaseGrant(uint32_t dstId, bool releaseAll)
             m_rfGrantChCnt = 0U;
         }
 
-        m_grantTimers[dstId].stop();
+        m_grantTimers.stop(dstId);
         return true;
     }
 
@@ -381,17 +374,8 @@ bool AffiliationLookup::isGranted(uint32_t dstId) const
     }
 
     // lookup dynamic channel grant table entry
-    try {
-        uint32_t chNo = m_grantChTable.at(dstId);
-        if (chNo != 0U) {
-            return true;
-        }
-        else {
-            return false;
-        }
-    } catch (...) {
-        return false;
-    }
+    auto it = m_grantChTable.find(dstId);
+    return it != m_grantChTable.end() && it->second != 0U;
 }
 
 /// <summary>
@@ -457,19 +441,34 @@ VoiceChData AffiliationLookup::getRFChData(uint32_t chNo) const
 /// <param name="ms"></param>
 void AffiliationLookup::clock(uint32_t ms)
 {
-    // clock all the grant timers
-    std::vector<uint32_t> gntsToRel = std::vector<uint32_t>();
-    for (auto entry : m_grantChTable) {
-        uint32_t dstId = entry.first;
-
-        m_grantTimers[dstId].clock(ms);
-        if (m_grantTimers[dstId].isRunning() && m_grantTimers[dstId].hasExpired()) {
-            gntsToRel.push_back(dstId);
-        }
-    }
+    // clock the grant timers; only the timers that have come due are visited
+    m_expiredGrants.clear();
+    m_grantTimers.clock(ms, m_expiredGrants);
 
     // release grants that have timed out
-    for (uint32_t dstId : gntsToRel) {
+    for (uint32_t dstId : m_expiredGrants) {
         releaseGrant(dstId, false);
     }
 }
+
+// ---------------------------------------------------------------------------
+//  Protected Class Members
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Helper to remove a source ID from the affiliated members of a group.
+/// </summary>
+/// <param name="dstId"></param>
+/// <param name="srcId"></param>
+void AffiliationLookup::removeGroupAffMember(uint32_t dstId, uint32_t srcId)
+{
+    auto it = m_grpAffDstTable.find(dstId);
+    if (it == m_grpAffDstTable.end()) {
+        return;
+    }
+
+    it->second.erase(srcId);
+    if (it->second.empty()) {
+        m_grpAffDstTable.erase(it);
+    }
+}
@@ -27,10 +27,11 @@
 #define __AFFILIATION_LOOKUP_H__
 
 #include "Defines.h"
-#include "Timer.h"
+#include "TimerWheel.h"
 
 #include <cstdio>
 #include <unordered_map>
+#include <unordered_set>
 #include <algorithm>
 #include <vector>
 #include <functional>
@@ -110,9 +111,9 @@ namespace lookups
         virtual ~AffiliationLookup();
 
         /// <summary>Gets the count of unit registrations.</summary>
-        uint8_t unitRegSize() const { return m_unitRegTable.size(); }
+        uint32_t unitRegSize() const { return (uint32_t)m_unitRegTable.size(); }
         /// <summary>Gets the unit registration table.</summary>
-        std::vector<uint32_t> unitRegTable() const { return m_unitRegTable; }
+        const std::unordered_set<uint32_t>& unitRegTable() const { return m_unitRegTable; }
         /// <summary>Helper to register a source ID.</summary>
         virtual void unitReg(uint32_t srcId);
         /// <summary>Helper to deregister a source ID.</summary>
@@ -121,9 +122,9 @@ namespace lookups
         virtual bool isUnitReg(uint32_t srcId) const;
 
         /// <summary>Gets the count of affiliations.</summary>
-        uint8_t grpAffSize() const { return m_grpAffTable.size(); }
+        uint32_t grpAffSize() const { return (uint32_t)m_grpAffTable.size(); }
         /// <summary>Gets the group affiliation table.</summary>
-        std::unordered_map<uint32_t, uint32_t> grpAffTable() const { return m_grpAffTable; }
+        const std::unordered_map<uint32_t, uint32_t>& grpAffTable() const { return m_grpAffTable; }
         /// <summary>Helper to group affiliate a source ID.</summary>
         virtual void groupAff(uint32_t srcId, uint32_t dstId);
         /// <summary>Helper to group unaffiliate a source ID.</summary>
@@ -134,9 +135,9 @@ namespace lookups
         virtual std::vector<uint32_t> clearGroupAff(uint32_t dstId, bool releaseAll);
 
         /// <summary>Gets the count of grants.</summary>
-        uint8_t grantSize() const { return m_grantChTable.size(); }
+        uint32_t grantSize() const { return (uint32_t)m_grantChTable.size(); }
         /// <summary>Gets the grant table.</summary>
-        std::unordered_map<uint32_t, uint32_t> grantTable() const { return m_grantChTable; }
+        const std::unordered_map<uint32_t, uint32_t>& grantTable() const { return m_grantChTable; }
         /// <summary>Helper to grant a channel.</summary>
         virtual bool grantCh(uint32_t dstId, uint32_t srcId, uint32_t grantTimeout);
         /// <summary>Helper to start the destination ID grant timer.</summary>
@@ -175,16 +176,23 @@ namespace lookups
         void setReleaseGrantCallback(std::function<void(uint32_t, uint32_t, uint8_t)>&& callback) { m_releaseGrant = callback; }
 
     protected:
+        /// <summary>Helper to remove a source ID from the affiliated members of a group.</summary>
+        void removeGroupAffMember(uint32_t dstId, uint32_t srcId);
+
         std::vector<uint32_t> m_rfChTable;
         std::unordered_map<uint32_t, VoiceChData> m_rfChDataTable;
         uint8_t m_rfGrantChCnt;
 
-        std::vector<uint32_t> m_unitRegTable;
+        std::unordered_set<uint32_t> m_unitRegTable;
+        //                 srcId     dstId
         std::unordered_map<uint32_t, uint32_t> m_grpAffTable;
+        //                 dstId     srcIds
+        std::unordered_map<uint32_t, std::unordered_set<uint32_t>> m_grpAffDstTable;
 
         std::unordered_map<uint32_t, uint32_t> m_grantChTable;
         std::unordered_map<uint32_t, uint32_t> m_grantSrcIdTable;
-        std::unordered_map<uint32_t, Timer> m_grantTimers;
+        TimerWheel m_grantTimers;
+        std::vector<uint32_t> m_expiredGrants;
 
         //                 chNo      dstId     slot
         std::function<void(uint32_t, uint32_t, uint8_t)> m_releaseGrant;
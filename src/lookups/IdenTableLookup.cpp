@@ -68,15 +68,11 @@ IdenTable IdenTableLookup::find(uint32_t id)
 {
     IdenTable entry;
 
-    m_mutex.lock();
-    {
-        try {
-            entry = m_table.at(id);
-        } catch (...) {
-            /* stub */
-        }
+    std::shared_ptr<const TableMap> table = snapshot();
+    auto it = table->find(id);
+    if (it != table->end()) {
+        entry = it->second;
     }
-    m_mutex.unlock();
 
     float chBandwidthKhz = entry.chBandwidthKhz();
     if (chBandwidthKhz == 0.0F)
@@ -97,10 +93,10 @@ IdenTable IdenTableLookup::find(uint32_t id)
 std::vector<IdenTable> IdenTableLookup::list()
 {
     std::vector<IdenTable> list = std::vector<IdenTable>();
-    if (m_table.size() > 0) {
-        for (auto entry : m_table) {
-            list.push_back(entry.second);
-        }
+
+    std::shared_ptr<const TableMap> table = snapshot();
+    for (auto entry : *table) {
+        list.push_back(entry.second);
     }
 
     return list;
@@ -126,64 +122,67 @@ bool IdenTableLookup::load()
         return false;
     }
 
-    // clear table
-    clear();
-
-    m_mutex.lock();
-    {
-        // read lines from file
-        std::string line;
-        while (std::getline(file, line)) {
-            if (line.length() > 0) {
-                if (line.at(0) == '#')
-                    continue;
-
-                // tokenize line
-                std::string next;
-                std::vector<std::string> parsed;
-                char delim = ',';
-
-                for (auto it = line.begin(); it != line.end(); it++) {
-                    if (*it == delim) {
-                        if (!next.empty()) {
-                            parsed.push_back(next);
-                            next.clear();
-                        }
+    // build the new table off to the side; readers keep using the current table until it is published
+    std::shared_ptr<TableMap> table = std::make_shared<TableMap>();
+
+    // read lines from file
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.length() > 0) {
+            if (line.at(0) == '#')
+                continue;
+
+            // tokenize line
+            std::string next;
+            std::vector<std::string> parsed;
+            char delim = ',';
+
+            for (auto it = line.begin(); it != line.end(); it++) {
+                if (*it == delim) {
+                    if (!next.empty()) {
+                        parsed.push_back(next);
+                        next.clear();
                     }
-                    else
-                        next += *it;
                 }
-                if (!next.empty())
-                    parsed.push_back(next);
+                else
+                    next += *it;
+            }
+            if (!next.empty())
+                parsed.push_back(next);
 
-                // parse tokenized line
-                uint8_t channelId = (uint8_t)::atoi(parsed[0].c_str());
-                uint32_t baseFrequency = (uint32_t)::atoi(parsed[1].c_str());
-                float chSpaceKhz = float(::atof(parsed[2].c_str()));
-                float txOffsetMhz = float(::atof(parsed[3].c_str()));
-                float chBandwidthKhz = float(::atof(parsed[4].c_str()));
+            // parse tokenized line
+            uint8_t channelId = (uint8_t)::atoi(parsed[0].c_str());
+            uint32_t baseFrequency = (uint32_t)::atoi(parsed[1].c_str());
+            float chSpaceKhz = float(::atof(parsed[2].c_str()));
+            float txOffsetMhz = float(::atof(parsed[3].c_str()));
+            float chBandwidthKhz = float(::atof(parsed[4].c_str()));
 
-                if (chSpaceKhz == 0.0F)
-                    chSpaceKhz = chBandwidthKhz / 2;
-                if (chSpaceKhz < 0.125F)    // clamp to 125 Hz
-                    chSpaceKhz = 0.125F;
-                if (chSpaceKhz > 125000.0F)   // clamp to 125 kHz
-                    chSpaceKhz = 125000.0F;                    
+            if (chSpaceKhz == 0.0F)
+                chSpaceKhz = chBandwidthKhz / 2;
+            if (chSpaceKhz < 0.125F)    // clamp to 125 Hz
+                chSpaceKhz = 0.125F;
+            if (chSpaceKhz > 125000.0F)   // clamp to 125 kHz
+                chSpaceKhz = 125000.0F;                    
 
-                IdenTable entry = IdenTable(channelId, baseFrequency, chSpaceKhz, txOffsetMhz, chBandwidthKhz);
+            IdenTable entry = IdenTable(channelId, baseFrequency, chSpaceKhz, txOffsetMhz, chBandwidthKhz);
 
-                LogMessage(LOG_HOST, "Channel Id %u: BaseFrequency = %uHz, TXOffsetMhz = %fMHz, BandwidthKhz = %fKHz, SpaceKhz = %fKHz",
-                    entry.channelId(), entry.baseFrequency(), entry.txOffsetMhz(), entry.chBandwidthKhz(), entry.chSpaceKhz());
+            LogMessage(LOG_HOST, "Channel Id %u: BaseFrequency = %uHz, TXOffsetMhz = %fMHz, BandwidthKhz = %fKHz, SpaceKhz = %fKHz",
+                entry.channelId(), entry.baseFrequency(), entry.txOffsetMhz(), entry.chBandwidthKhz(), entry.chSpaceKhz());
 
-                m_table[channelId] = entry;
-            }
+            (*table)[channelId] = entry;
         }
     }
-    m_mutex.unlock();
 
     file.close();
 
-    size_t size = m_table.size();
+    size_t size = table->size();
+
+    m_mutex.lock();
+    {
+        publish(table);
+    }
+    m_mutex.unlock();
+
     if (size == 0U)
         return false;
 
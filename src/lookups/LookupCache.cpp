@@ -0,0 +1,287 @@
+/**
+* Digital Voice Modem - Host Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software
+*
+*/
+/*
+*   Copyright (C) 2023 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#include "lookups/LookupCache.h"
+#include "Log.h"
+
+using namespace lookups;
+
+#include <cstdio>
+#include <cerrno>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint64_t FNV_OFFSET_BASIS = 0xCBF29CE484222325ULL;
+const uint64_t FNV_PRIME = 0x100000001B3ULL;
+
+const size_t HASH_BUFFER_LEN = 65536U;
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Initializes a new instance of the LookupCache class.
+/// </summary>
+/// <param name="sourceFile">Full-path to the source lookup file.</param>
+/// <param name="magic">Magic number identifying the record format of the cache.</param>
+LookupCache::LookupCache(const std::string& sourceFile, uint32_t magic) :
+    m_sourceFile(sourceFile),
+    m_cacheFile(sourceFile + ".cache"),
+    m_magic(magic),
+    m_current(),
+    m_loaded(),
+    m_hasLoaded(false),
+    m_map(nullptr),
+    m_mapLength(0U),
+    m_payload(nullptr),
+    m_length(0U),
+    m_count(0U)
+{
+    m_current.mtime = 0;
+    m_current.size = 0U;
+    m_current.hash = 0U;
+    m_loaded = m_current;
+}
+
+/// <summary>
+/// Finalizes a instance of the LookupCache class.
+/// </summary>
+LookupCache::~LookupCache()
+{
+    close();
+}
+
+/// <summary>
+/// Checks whether the source file has changed since it was last loaded.
+/// </summary>
+/// <remarks>
+/// The modification time and size are checked first; the contents are only hashed when
+/// either differs, so a file that was merely touched (or copied over with the same contents)
+/// is still reported as unchanged.
+/// </remarks>
+/// <returns>True, if the source file has changed (or could not be checked), otherwise false.</returns>
+bool LookupCache::sourceChanged()
+{
+    // an unreadable source file never matches a cache (an empty file does not hash to zero)
+    m_current.mtime = 0;
+    m_current.size = 0U;
+    m_current.hash = 0U;
+
+    struct stat st;
+    if (::stat(m_sourceFile.c_str(), &st) != 0) {
+        return true;
+    }
+
+#if defined(__APPLE__)
+    m_current.mtime = (int64_t)st.st_mtimespec.tv_sec * 1000000000LL + st.st_mtimespec.tv_nsec;
+#else
+    m_current.mtime = (int64_t)st.st_mtim.tv_sec * 1000000000LL + st.st_mtim.tv_nsec;
+#endif
+    m_current.size = (uint64_t)st.st_size;
+
+    if (m_hasLoaded && m_current.mtime == m_loaded.mtime && m_current.size == m_loaded.size) {
+        m_current.hash = m_loaded.hash;
+        return false;
+    }
+
+    if (!hashSource(m_current.hash)) {
+        m_current.hash = 0U;
+        return true;
+    }
+
+    if (m_hasLoaded && m_current.size == m_loaded.size && m_current.hash == m_loaded.hash) {
+        m_loaded.mtime = m_current.mtime;
+        return false;
+    }
+
+    return true;
+}
+
+/// <summary>
+/// Marks the source file as loaded.
+/// </summary>
+/// <remarks>Records the state of the source file seen by the last call to sourceChanged().</remarks>
+void LookupCache::loaded()
+{
+    m_loaded = m_current;
+    m_hasLoaded = true;
+}
+
+/// <summary>
+/// Forgets the loaded source file, forcing the next check to report a change.
+/// </summary>
+void LookupCache::reset()
+{
+    m_hasLoaded = false;
+}
+
+/// <summary>
+/// Maps the cache file, if it is valid for the source file.
+/// </summary>
+/// <remarks>Must be called after sourceChanged().</remarks>
+/// <returns>True, if the cache file was mapped, otherwise false.</returns>
+bool LookupCache::open()
+{
+    close();
+
+    int fd = ::open(m_cacheFile.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(LookupCacheHeader)) {
+        ::close(fd);
+        return false;
+    }
+
+    size_t length = (size_t)st.st_size;
+    void* map = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        LogWarning(LOG_HOST, "Cannot map the lookup cache file - %s (%s)", m_cacheFile.c_str(), strerror(errno));
+        return false;
+    }
+
+    LookupCacheHeader header;
+    ::memcpy(&header, map, sizeof(LookupCacheHeader));
+
+    if (header.magic != m_magic || header.version != LOOKUP_CACHE_VERSION ||
+        header.srcSize != m_current.size || header.srcHash != m_current.hash ||
+        header.length != length - sizeof(LookupCacheHeader)) {
+        ::munmap(map, length);
+        return false;
+    }
+
+    m_map = map;
+    m_mapLength = length;
+    m_payload = (const uint8_t*)map + sizeof(LookupCacheHeader);
+    m_length = (size_t)header.length;
+    m_count = header.count;
+    return true;
+}
+
+/// <summary>
+/// Unmaps the cache file.
+/// </summary>
+void LookupCache::close()
+{
+    if (m_map != nullptr) {
+        ::munmap(m_map, m_mapLength);
+    }
+
+    m_map = nullptr;
+    m_mapLength = 0U;
+    m_payload = nullptr;
+    m_length = 0U;
+    m_count = 0U;
+}
+
+/// <summary>
+/// Writes the cache file for the source file.
+/// </summary>
+/// <remarks>
+/// The cache is written to a temporary file and renamed into place, so another process
+/// never maps a partially written cache. Failing to write the cache is not fatal; the
+/// source file is simply parsed again the next time.
+/// </remarks>
+/// <param name="payload">Record data.</param>
+/// <param name="count">Number of records.</param>
+/// <returns>True, if the cache file was written, otherwise false.</returns>
+bool LookupCache::write(const std::vector<uint8_t>& payload, uint32_t count)
+{
+    LookupCacheHeader header;
+    ::memset(&header, 0x00U, sizeof(LookupCacheHeader));
+    header.magic = m_magic;
+    header.version = LOOKUP_CACHE_VERSION;
+    header.count = count;
+    header.srcSize = m_current.size;
+    header.srcHash = m_current.hash;
+    header.length = payload.size();
+
+    std::string tempFile = m_cacheFile + ".tmp";
+    FILE* fp = ::fopen(tempFile.c_str(), "wb");
+    if (fp == nullptr) {
+        LogWarning(LOG_HOST, "Cannot write the lookup cache file - %s (%s)", m_cacheFile.c_str(), strerror(errno));
+        return false;
+    }
+
+    bool ret = ::fwrite(&header, sizeof(LookupCacheHeader), 1U, fp) == 1U;
+    if (ret && payload.size() > 0U) {
+        ret = ::fwrite(payload.data(), payload.size(), 1U, fp) == 1U;
+    }
+
+    if (::fclose(fp) != 0) {
+        ret = false;
+    }
+
+    if (!ret || ::rename(tempFile.c_str(), m_cacheFile.c_str()) != 0) {
+        LogWarning(LOG_HOST, "Cannot write the lookup cache file - %s (%s)", m_cacheFile.c_str(), strerror(errno));
+        ::unlink(tempFile.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Helper to compute the FNV-1a hash of the source file.
+/// </summary>
+/// <param name="hash">Computed hash.</param>
+/// <returns>True, if the source file was hashed, otherwise false.</returns>
+bool LookupCache::hashSource(uint64_t& hash)
+{
+    FILE* fp = ::fopen(m_sourceFile.c_str(), "rb");
+    if (fp == nullptr) {
+        return false;
+    }
+
+    std::vector<uint8_t> buffer(HASH_BUFFER_LEN);
+
+    hash = FNV_OFFSET_BASIS;
+    size_t len = 0U;
+    while ((len = ::fread(buffer.data(), 1U, HASH_BUFFER_LEN, fp)) > 0U) {
+        for (size_t i = 0U; i < len; i++) {
+            hash ^= buffer[i];
+            hash *= FNV_PRIME;
+        }
+    }
+
+    bool ret = ::ferror(fp) == 0;
+    ::fclose(fp);
+    return ret;
+}
@@ -0,0 +1,142 @@
+/**
+* Digital Voice Modem - Host Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software
+*
+*/
+/*
+*   Copyright (C) 2023 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#if !defined(__LOOKUP_CACHE_H__)
+#define __LOOKUP_CACHE_H__
+
+#include "Defines.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace lookups
+{
+    // ---------------------------------------------------------------------------
+    //  Constants
+    // ---------------------------------------------------------------------------
+
+    const uint32_t  LOOKUP_CACHE_VERSION = 1U;
+
+    const uint32_t  LOOKUP_CACHE_MAGIC_RID = 0x44495244U;   // "DRID"
+    const uint32_t  LOOKUP_CACHE_MAGIC_TGR = 0x52474454U;   // "TDGR"
+
+    // ---------------------------------------------------------------------------
+    //  Structure Declaration
+    //      Header written at the start of a binary lookup cache file. All
+    //      fields are in host byte order; a cache written on a host of the
+    //      other byte order fails the magic check and is simply rebuilt.
+    // ---------------------------------------------------------------------------
+
+    struct LookupCacheHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t count;
+        uint32_t reserved;
+        uint64_t srcSize;
+        uint64_t srcHash;
+        uint64_t length;
+    };
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    //      Implements a binary cache for a text lookup file. The cache is
+    //      stored next to the source file (as "<source>.cache"), is tied to
+    //      the size and content hash of the source file it was built from,
+    //      and is read back by memory mapping it.
+    // ---------------------------------------------------------------------------
+
+    class HOST_SW_API LookupCache {
+    public:
+        /// <summary>Initializes a new instance of the LookupCache class.</summary>
+        LookupCache(const std::string& sourceFile, uint32_t magic);
+        /// <summary>Finalizes a instance of the LookupCache class.</summary>
+        ~LookupCache();
+
+        /// <summary>Checks whether the source file has changed since it was last loaded.</summary>
+        bool sourceChanged();
+        /// <summary>Marks the source file as loaded.</summary>
+        void loaded();
+        /// <summary>Forgets the loaded source file, forcing the next check to report a change.</summary>
+        void reset();
+
+        /// <summary>Maps the cache file, if it is valid for the source file.</summary>
+        bool open();
+        /// <summary>Unmaps the cache file.</summary>
+        void close();
+        /// <summary>Writes the cache file for the source file.</summary>
+        bool write(const std::vector<uint8_t>& payload, uint32_t count);
+
+        /// <summary>Gets the full-path to the cache file.</summary>
+        const std::string& cacheFile() const { return m_cacheFile; }
+        /// <summary>Gets the number of records in the mapped cache.</summary>
+        uint32_t count() const { return m_count; }
+        /// <summary>Gets the record data of the mapped cache.</summary>
+        const uint8_t* payload() const { return m_payload; }
+        /// <summary>Gets the length of the record data of the mapped cache.</summary>
+        size_t length() const { return m_length; }
+
+        /// <summary>Helper to append a 32-bit value to a cache payload.</summary>
+        static void put32(std::vector<uint8_t>& payload, uint32_t value)
+        {
+            uint8_t buffer[4U];
+            ::memcpy(buffer, &value, 4U);
+            payload.insert(payload.end(), buffer, buffer + 4U);
+        }
+        /// <summary>Helper to read a 32-bit value from a cache payload.</summary>
+        static uint32_t get32(const uint8_t* data)
+        {
+            uint32_t value;
+            ::memcpy(&value, data, 4U);
+            return value;
+        }
+
+    private:
+        std::string m_sourceFile;
+        std::string m_cacheFile;
+        uint32_t m_magic;
+
+        class FileStamp {
+        public:
+            int64_t mtime;
+            uint64_t size;
+            uint64_t hash;
+        };
+        FileStamp m_current;
+        FileStamp m_loaded;
+        bool m_hasLoaded;
+
+        void* m_map;
+        size_t m_mapLength;
+        const uint8_t* m_payload;
+        size_t m_length;
+        uint32_t m_count;
+
+        /// <summary>Helper to compute the FNV-1a hash of the source file.</summary>
+        bool hashSource(uint64_t& hash);
+    };
+} // namespace lookups
+
+#endif // __LOOKUP_CACHE_H__
@@ -39,6 +39,8 @@
 #include <cstdlib>
 #include <cstring>
 #include <cctype>
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
 
@@ -47,12 +49,16 @@ namespace lookups
     // ---------------------------------------------------------------------------
     //  Class Declaration
     //      Implements a abstract threading class that contains base logic for
-    //      building tables of data.
+    //      building tables of data. The table is published as an immutable
+    //      snapshot; readers take the current snapshot without locking, while
+    //      writers build a replacement table off to the side and swap it in.
     // ---------------------------------------------------------------------------
 
     template <class T>
     class HOST_SW_API LookupTable : public Thread {
     public:
+        typedef std::unordered_map<uint32_t, T> TableMap;
+
         /// <summary>Initializes a new instance of the LookupTable class.</summary>
         /// <param name="filename">Full-path to the lookup table file.</param>
         /// <param name="reloadTime">Interval of time to reload the channel identity table.</param>
@@ -60,7 +66,10 @@ namespace lookups
             Thread(),
             m_filename(filename),
             m_reloadTime(reloadTime),
-            m_table()
+            m_table(std::make_shared<const TableMap>()),
+            m_mutex(),
+            m_stop(false),
+            m_generation(0U)
         {
             /* stub */
         }
@@ -119,11 +128,8 @@ namespace lookups
         /// <summary>Clears all entries from the lookup table.</summary>
         virtual void clear()
         {
-            m_mutex.lock();
-            {
-                m_table.clear();
-            }
-            m_mutex.unlock();
+            std::lock_guard<std::mutex> lock(m_mutex);
+            publish(std::make_shared<const TableMap>());
         }
 
         /// <summary>Helper to check if this lookup table has the specified unique ID.</summary>
@@ -131,19 +137,8 @@ namespace lookups
         /// <returns>True, if the lookup table has an entry by the specified unique ID, otherwise false.</returns>
         virtual bool hasEntry(uint32_t id)
         {
-            m_mutex.lock();
-            {
-                try {
-                    m_table.at(id);
-                    return true;
-                }
-                catch (...) {
-                    return false;
-                }
-            }
-            m_mutex.unlock();
-
-            return false;
+            std::shared_ptr<const TableMap> table = snapshot();
+            return table->find(id) != table->end();
         }
 
         /// <summary>Finds a table entry in this lookup table.</summary>
@@ -153,20 +148,39 @@ namespace lookups
 
         /// <summary>Helper to return the lookup table.</summary>
         /// <returns>Table.</returns>
-        virtual std::unordered_map<uint32_t, T> table() { return m_table; }
+        virtual TableMap table() { return *snapshot(); }
+        /// <summary>Helper to return the current immutable snapshot of the lookup table.</summary>
+        /// <returns>Table snapshot.</returns>
+        std::shared_ptr<const TableMap> snapshot() const { return std::atomic_load(&m_table); }
+        /// <summary>Gets the generation of the table; this changes whenever the table is reloaded or modified.</summary>
+        uint32_t generation() const { return m_generation.load(); }
 
     protected:
         std::string m_filename;
         uint32_t m_reloadTime;
-        std::unordered_map<uint32_t, T> m_table;
-        std::mutex m_mutex;
+        std::shared_ptr<const TableMap> m_table;
+        std::mutex m_mutex;     // serializes writers only; readers never take this
         bool m_stop;
 
+        std::atomic<uint32_t> m_generation;
+
         bool m_acl;
 
         /// <summary>Loads the table from the passed lookup table file.</summary>
         /// <returns>True, if lookup table was loaded, otherwise false.</returns>
         virtual bool load() = 0;
+
+        /// <summary>Helper to atomically replace the published table.</summary>
+        /// <param name="table">New table.</param>
+        void publish(std::shared_ptr<const TableMap> table)
+        {
+            std::shared_ptr<const TableMap> previous = std::atomic_exchange(&m_table, std::shared_ptr<const TableMap>(table));
+            m_generation++;
+
+            // the previous table is normally released here, on the writer, rather than by whichever
+            // reader happens to drop the last reference to it
+            previous.reset();
+        }
     };
 } // namespace lookups
 
@@ -35,6 +35,7 @@
 
 using namespace lookups;
 
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -43,6 +44,15 @@ using namespace lookups;
 #include <vector>
 #include <fstream>
 
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t RID_CACHE_RECORD_LEN = 8U;
+
+const uint32_t RID_CACHE_FLAG_ENABLED = 0x01U;
+const uint32_t RID_CACHE_FLAG_DEFAULT = 0x02U;
+
 // ---------------------------------------------------------------------------
 //  Public Class Members
 // ---------------------------------------------------------------------------
@@ -54,7 +64,8 @@ using namespace lookups;
 /// <param name="reloadTime">Interval of time to reload the radio ID table.</param>
 /// <param name="ridAcl">Flag indicating whether radio ID access control is enabled.</param>
 RadioIdLookup::RadioIdLookup(const std::string& filename, uint32_t reloadTime, bool ridAcl) : LookupTable(filename, reloadTime),
-    m_acl(ridAcl)
+    m_acl(ridAcl),
+    m_cache(filename, LOOKUP_CACHE_MAGIC_RID)
 {
     /* stub */
 }
@@ -67,6 +78,18 @@ RadioIdLookup::~RadioIdLookup()
     /* stub */
 }
 
+/// <summary>
+/// Clears all entries from the lookup table.
+/// </summary>
+void RadioIdLookup::clear()
+{
+    LookupTable::clear();
+
+    // the next load must repopulate the table even if the file is unchanged
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cache.reset();
+}
+
 /// <summary>
 /// Toggles the specified radio ID enabled or disabled.
 /// </summary>
@@ -74,26 +97,38 @@ RadioIdLookup::~RadioIdLookup()
 /// <param name="enabled">Flag indicating if radio ID is enabled or not.</param>
 void RadioIdLookup::toggleEntry(uint32_t id, bool enabled)
 {
-    RadioId rid = find(id);
-    if (rid.radioEnabled() == false && rid.radioDefault() == true) {
-        if (enabled) {
-            LogMessage(LOG_HOST, "Added enabled RID %u to RID ACL table", id);
-        }
-        else {
-            LogMessage(LOG_HOST, "Added disabled RID %u to RID ACL table", id);
-        }
-    }
+    toggleEntries(std::vector<uint32_t>(1U, id), enabled);
+}
 
-    if (rid.radioEnabled() == false && rid.radioDefault() == false) {
-        if (enabled) {
-            LogMessage(LOG_HOST, "Enabled RID %u in RID ACL table", id);
+/// <summary>
+/// Toggles the specified radio IDs enabled or disabled.
+/// </summary>
+/// <param name="ids">Unique IDs to toggle.</param>
+/// <param name="enabled">Flag indicating if radio IDs are enabled or not.</param>
+void RadioIdLookup::toggleEntries(const std::vector<uint32_t>& ids, bool enabled)
+{
+    for (uint32_t id : ids) {
+        RadioId rid = find(id);
+        if (rid.radioEnabled() == false && rid.radioDefault() == true) {
+            if (enabled) {
+                LogMessage(LOG_HOST, "Added enabled RID %u to RID ACL table", id);
+            }
+            else {
+                LogMessage(LOG_HOST, "Added disabled RID %u to RID ACL table", id);
+            }
         }
-        else {
-            LogMessage(LOG_HOST, "Disabled RID %u in RID ACL table", id);
+
+        if (rid.radioEnabled() == false && rid.radioDefault() == false) {
+            if (enabled) {
+                LogMessage(LOG_HOST, "Enabled RID %u in RID ACL table", id);
+            }
+            else {
+                LogMessage(LOG_HOST, "Disabled RID %u in RID ACL table", id);
+            }
         }
     }
 
-    addEntry(id, enabled);
+    addEntries(ids, enabled);
 }
 
 /// <summary>
@@ -103,27 +138,70 @@ void RadioIdLookup::toggleEntry(uint32_t id, bool enabled)
 /// <param name="enabled">Flag indicating if radio ID is enabled or not.</param>
 void RadioIdLookup::addEntry(uint32_t id, bool enabled)
 {
-    if ((id == p25::P25_WUID_ALL) || (id == p25::P25_WUID_FNE)) {
-        return;
+    addEntries(std::vector<uint32_t>(1U, id), enabled);
+}
+
+/// <summary>
+/// Adds new entries to the lookup table by the specified unique IDs.
+/// </summary>
+/// <remarks>The published table is never modified; the entries are applied to a copy which replaces it.</remarks>
+/// <param name="ids">Unique IDs to add.</param>
+/// <param name="enabled">Flag indicating if radio IDs are enabled or not.</param>
+void RadioIdLookup::addEntries(const std::vector<uint32_t>& ids, bool enabled)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::shared_ptr<TableMap> table;
+    for (uint32_t id : ids) {
+        if ((id == p25::P25_WUID_ALL) || (id == p25::P25_WUID_FNE)) {
+            continue;
+        }
+
+        // if the entry already has the intended enabled value -- leave the table alone
+        const TableMap& current = (table != nullptr) ? *table : *m_table;
+        auto it = current.find(id);
+        if (it != current.end() && it->second.radioEnabled() == enabled) {
+            continue;
+        }
+
+        if (table == nullptr) {
+            table = std::make_shared<TableMap>(*m_table);
+        }
+
+        (*table)[id] = RadioId(enabled, false);
     }
 
-    RadioId entry = RadioId(enabled, false);
+    if (table != nullptr) {
+        publish(table);
+    }
+}
 
-    m_mutex.lock();
-    {
-        try {
-            RadioId _entry = m_table.at(id);
+/// <summary>
+/// Erases entries from the lookup table by the specified unique IDs.
+/// </summary>
+/// <remarks>The published table is never modified; the entries are erased from a copy which replaces it.</remarks>
+/// <param name="ids">Unique IDs to erase.</param>
+void RadioIdLookup::eraseEntries(const std::vector<uint32_t>& ids)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
 
-            // if the enabled value doesn't match -- override with the intended
-            if (_entry.radioEnabled() != enabled) {
-                _entry = RadioId(enabled, false);
-                m_table[id] = _entry;
-            }
-        } catch (...) {
-            m_table[id] = entry;
+    std::shared_ptr<TableMap> table;
+    for (uint32_t id : ids) {
+        const TableMap& current = (table != nullptr) ? *table : *m_table;
+        if (current.find(id) == current.end()) {
+            continue;
         }
+
+        if (table == nullptr) {
+            table = std::make_shared<TableMap>(*m_table);
+        }
+
+        table->erase(id);
+    }
+
+    if (table != nullptr) {
+        publish(table);
     }
-    m_mutex.unlock();
 }
 
 /// <summary>
@@ -133,23 +211,17 @@ void RadioIdLookup::addEntry(uint32_t id, bool enabled)
 /// <returns>Table entry.</returns>
 RadioId RadioIdLookup::find(uint32_t id)
 {
-    RadioId entry;
-
     if ((id == p25::P25_WUID_ALL) || (id == p25::P25_WUID_FNE)) {
         return RadioId(true, false);
     }
 
-    m_mutex.lock();
-    {
-        try {
-            entry = m_table.at(id);
-        } catch (...) {
-            entry = RadioId(false, true);
-        }
+    std::shared_ptr<const TableMap> table = snapshot();
+    auto it = table->find(id);
+    if (it != table->end()) {
+        return it->second;
     }
-    m_mutex.unlock();
 
-    return entry;
+    return RadioId(false, true);
 }
 
 /// <summary>
@@ -168,6 +240,11 @@ bool RadioIdLookup::getACL()
 /// <summary>
 /// Loads the table from the passed lookup table file.
 /// </summary>
+/// <remarks>
+/// Nothing is reloaded if the file has not changed since it was last loaded. Otherwise the
+/// binary cache of the file is used if it is still valid, and the file is only parsed (and
+/// the cache rebuilt) when it is not.
+/// </remarks>
 /// <returns>True, if lookup table was loaded, otherwise false.</returns>
 bool RadioIdLookup::load()
 {
@@ -175,60 +252,138 @@ bool RadioIdLookup::load()
         return false;
     }
 
+    if (!m_cache.sourceChanged()) {
+        return snapshot()->size() > 0U;
+    }
+
+    // build the new table off to the side; readers keep using the current table until it is published
+    std::shared_ptr<TableMap> table = std::make_shared<TableMap>();
+
+    bool cached = loadCache(table);
+    if (!cached) {
+        table->clear();
+        if (!loadFile(table)) {
+            return false;
+        }
+    }
+
+    size_t size = table->size();
+
+    m_mutex.lock();
+    {
+        publish(table);
+        m_cache.loaded();
+    }
+    m_mutex.unlock();
+
+    if (size == 0U)
+        return false;
+
+    LogInfoEx(LOG_HOST, "Loaded %u entries into lookup table%s", size, (cached) ? " (cached)" : "");
+
+    return true;
+}
+
+/// <summary>
+/// Loads the table from the binary cache of the lookup table file.
+/// </summary>
+/// <remarks>The cache holds fixed-length (ID, flags) records sorted by ID.</remarks>
+/// <param name="table">Table to load.</param>
+/// <returns>True, if lookup table was loaded, otherwise false.</returns>
+bool RadioIdLookup::loadCache(std::shared_ptr<TableMap> table)
+{
+    if (!m_cache.open()) {
+        return false;
+    }
+
+    uint32_t count = m_cache.count();
+    if (m_cache.length() != (size_t)count * RID_CACHE_RECORD_LEN) {
+        m_cache.close();
+        return false;
+    }
+
+    table->reserve(count);
+
+    const uint8_t* record = m_cache.payload();
+    for (uint32_t i = 0U; i < count; i++, record += RID_CACHE_RECORD_LEN) {
+        uint32_t id = LookupCache::get32(record);
+        uint32_t flags = LookupCache::get32(record + 4U);
+
+        (*table)[id] = RadioId((flags & RID_CACHE_FLAG_ENABLED) == RID_CACHE_FLAG_ENABLED,
+            (flags & RID_CACHE_FLAG_DEFAULT) == RID_CACHE_FLAG_DEFAULT);
+    }
+
+    m_cache.close();
+    return true;
+}
+
+/// <summary>
+/// Loads the table from the lookup table file.
+/// </summary>
+/// <param name="table">Table to load.</param>
+/// <returns>True, if lookup table was loaded, otherwise false.</returns>
+bool RadioIdLookup::loadFile(std::shared_ptr<TableMap> table)
+{
     std::ifstream file (m_filename, std::ifstream::in);
     if (file.fail()) {
         LogError(LOG_HOST, "Cannot open the radio ID lookup file - %s", m_filename.c_str());
         return false;
     }
 
-    // clear table
-    clear();
+    // read lines from file
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.length() > 0) {
+            if (line.at(0) == '#')
+                continue;
 
-    m_mutex.lock();
-    {
-        // read lines from file
-        std::string line;
-        while (std::getline(file, line)) {
-            if (line.length() > 0) {
-                if (line.at(0) == '#')
-                    continue;
-
-                // tokenize line
-                std::string next;
-                std::vector<std::string> parsed;
-                char delim = ',';
-
-                for (char c : line) {
-                    if (c == delim) {
-                        if (!next.empty()) {
-                            parsed.push_back(next);
-                            next.clear();
-                        }
+            // tokenize line
+            std::string next;
+            std::vector<std::string> parsed;
+            char delim = ',';
+
+            for (char c : line) {
+                if (c == delim) {
+                    if (!next.empty()) {
+                        parsed.push_back(next);
+                        next.clear();
                     }
-                    else
-                        next += c;
                 }
-                if (!next.empty())
-                    parsed.push_back(next);
+                else
+                    next += c;
+            }
+            if (!next.empty())
+                parsed.push_back(next);
 
-                // parse tokenized line
-                uint32_t id = ::atoi(parsed[0].c_str());
-                bool radioEnabled = ::atoi(parsed[1].c_str()) == 1;
-                bool radioDefault = false;
+            // parse tokenized line
+            uint32_t id = ::atoi(parsed[0].c_str());
+            bool radioEnabled = ::atoi(parsed[1].c_str()) == 1;
+            bool radioDefault = false;
 
-                m_table[id] = RadioId(radioEnabled, radioDefault);
-            }
+            (*table)[id] = RadioId(radioEnabled, radioDefault);
         }
     }
-    m_mutex.unlock();
 
     file.close();
 
-    size_t size = m_table.size();
-    if (size == 0U)
-        return false;
+    // rebuild the cache for the next load
+    std::vector<uint32_t> ids;
+    ids.reserve(table->size());
+    for (const auto& entry : *table) {
+        ids.push_back(entry.first);
+    }
+    std::sort(ids.begin(), ids.end());
+
+    std::vector<uint8_t> payload;
+    payload.reserve(ids.size() * RID_CACHE_RECORD_LEN);
+    for (uint32_t id : ids) {
+        const RadioId& rid = table->at(id);
+        uint32_t flags = (rid.radioEnabled() ? RID_CACHE_FLAG_ENABLED : 0U) | (rid.radioDefault() ? RID_CACHE_FLAG_DEFAULT : 0U);
 
-    LogInfoEx(LOG_HOST, "Loaded %u entries into lookup table", size);
+        LookupCache::put32(payload, id);
+        LookupCache::put32(payload, flags);
+    }
 
+    m_cache.write(payload, (uint32_t)ids.size());
     return true;
 }
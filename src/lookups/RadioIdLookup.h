@@ -32,11 +32,13 @@
 #define __RADIO_ID_LOOKUP_H__
 
 #include "Defines.h"
+#include "lookups/LookupCache.h"
 #include "lookups/LookupTable.h"
 #include "Thread.h"
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace lookups
 {
@@ -104,11 +106,20 @@ namespace lookups
         /// <summary>Finalizes a instance of the RadioIdLookup class.</summary>
         virtual ~RadioIdLookup();
 
+        /// <summary>Clears all entries from the lookup table.</summary>
+        virtual void clear();
+
         /// <summary>Toggles the specified radio ID enabled or disabled.</summary>
         void toggleEntry(uint32_t id, bool enabled);
+        /// <summary>Toggles the specified radio IDs enabled or disabled.</summary>
+        void toggleEntries(const std::vector<uint32_t>& ids, bool enabled);
 
         /// <summary>Adds a new entry to the lookup table by the specified unique ID.</summary>
         void addEntry(uint32_t id, bool enabled);
+        /// <summary>Adds new entries to the lookup table by the specified unique IDs.</summary>
+        void addEntries(const std::vector<uint32_t>& ids, bool enabled);
+        /// <summary>Erases entries from the lookup table by the specified unique IDs.</summary>
+        void eraseEntries(const std::vector<uint32_t>& ids);
         /// <summary>Finds a table entry in this lookup table.</summary>
         virtual RadioId find(uint32_t id);
 
@@ -118,9 +129,17 @@ namespace lookups
     protected:
         bool m_acl;
 
+        LookupCache m_cache;
+
         /// <summary>Loads the table from the passed lookup table file.</summary>
         /// <returns>True, if lookup table was loaded, otherwise false.</returns>
         virtual bool load();
+
+    private:
+        /// <summary>Loads the table from the binary cache of the lookup table file.</summary>
+        bool loadCache(std::shared_ptr<TableMap> table);
+        /// <summary>Loads the table from the lookup table file.</summary>
+        bool loadFile(std::shared_ptr<TableMap> table);
     };
 } // namespace lookups
 
@@ -34,9 +34,89 @@ using namespace lookups;
 #include <cstring>
 #include <cctype>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 #include <fstream>
 
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t TGR_CACHE_RECORD_HDR_LEN = 20U;
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+//      Index over a copy of the group voice rules, used to apply a batch of
+//      changes to the copy without scanning it once per change.
+// ---------------------------------------------------------------------------
+
+class GroupVoiceIndex {
+public:
+    static const size_t NOT_FOUND = (size_t)-1;
+
+    /// <summary>Initializes a new instance of the GroupVoiceIndex class.</summary>
+    GroupVoiceIndex(std::vector<TalkgroupRuleGroupVoice>& list) :
+        m_list(list),
+        m_bySlot(),
+        m_byId()
+    {
+        for (size_t i = 0U; i < m_list.size(); i++) {
+            add(i);
+        }
+    }
+
+    /// <summary>Gets the key of a talkgroup ID and DMR slot.</summary>
+    static uint64_t key(uint32_t id, uint8_t slot) { return ((uint64_t)id << 8) | slot; }
+
+    /// <summary>Finds the first rule for the given talkgroup ID and DMR slot (a slot of 0 matches any slot).</summary>
+    size_t find(uint32_t id, uint8_t slot) const
+    {
+        if (slot != 0U) {
+            auto it = m_bySlot.find(key(id, slot));
+            return (it != m_bySlot.end()) ? it->second : NOT_FOUND;
+        }
+
+        auto it = m_byId.find(id);
+        return (it != m_byId.end()) ? it->second : NOT_FOUND;
+    }
+
+    /// <summary>Replaces the rule at the given position, or appends it if the position is NOT_FOUND.</summary>
+    void set(size_t i, const TalkgroupRuleGroupVoice& entry)
+    {
+        if (i == NOT_FOUND) {
+            m_list.push_back(entry);
+            add(m_list.size() - 1U);
+            return;
+        }
+
+        // the replaced rule may have moved to another slot
+        uint64_t oldKey = key(m_list[i].source().tgId(), m_list[i].source().tgSlot());
+        m_list[i] = entry;
+        if (oldKey != key(entry.source().tgId(), entry.source().tgSlot())) {
+            auto it = m_bySlot.find(oldKey);
+            if (it != m_bySlot.end() && it->second == i) {
+                m_bySlot.erase(it);
+            }
+
+            add(i);
+        }
+    }
+
+private:
+    std::vector<TalkgroupRuleGroupVoice>& m_list;
+    std::unordered_map<uint64_t, size_t> m_bySlot;
+    std::unordered_map<uint32_t, size_t> m_byId;
+
+    /// <summary>Indexes the rule at the given position; the first rule for a key wins.</summary>
+    void add(size_t i)
+    {
+        uint32_t id = m_list[i].source().tgId();
+        m_bySlot.emplace(key(id, m_list[i].source().tgSlot()), i);
+        m_byId.emplace(id, i);
+    }
+};
+
 // ---------------------------------------------------------------------------
 //  Public Class Members
 // ---------------------------------------------------------------------------
@@ -52,9 +132,13 @@ TalkgroupRulesLookup::TalkgroupRulesLookup(const std::string& filename, uint32_t
     m_reloadTime(reloadTime),
     m_rules(),
     m_acl(acl),
+    m_groupVoice(std::make_shared<const std::vector<TalkgroupRuleGroupVoice>>()),
+    m_mutex(),
+    m_stop(false),
+    m_generation(0U),
+    m_cache(filename, LOOKUP_CACHE_MAGIC_TGR),
     m_groupHangTime(5U),
-    m_sendTalkgroups(false),
-    m_groupVoice()
+    m_sendTalkgroups(false)
 {
     /* stub */
 }
@@ -124,11 +208,11 @@ bool TalkgroupRulesLookup::read()
 /// </summary>
 void TalkgroupRulesLookup::clear()
 {
-    m_mutex.lock();
-    {
-        m_groupVoice.clear();
-    }
-    m_mutex.unlock();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    publish(std::make_shared<const std::vector<TalkgroupRuleGroupVoice>>());
+
+    // the next load must repopulate the rules even if the file is unchanged
+    m_cache.reset();
 }
 
 /// <summary>
@@ -139,46 +223,44 @@ void TalkgroupRulesLookup::clear()
 /// <param name="enabled">Flag indicating if talkgroup ID is enabled or not.</param>
 void TalkgroupRulesLookup::addEntry(uint32_t id, uint8_t slot, bool enabled)
 {
-    TalkgroupRuleGroupVoiceSource source;
-    TalkgroupRuleConfig config;
-    source.tgId(id);
-    source.tgSlot(slot);
-    config.active(enabled);
+    addEntries(std::vector<std::pair<uint32_t, uint8_t>>(1U, std::make_pair(id, slot)), enabled);
+}
 
-    m_mutex.lock();
-    {
-        auto it = std::find_if(m_groupVoice.begin(), m_groupVoice.end(), 
-            [&](TalkgroupRuleGroupVoice x) 
-            { 
-                if (slot != 0U) {
-                    return x.source().tgId() == id && x.source().tgSlot() == slot;
-                }
-
-                return x.source().tgId() == id; 
-            });
-        if (it != m_groupVoice.end()) {
-            source = it->source();
-            source.tgId(id);
-            source.tgSlot(slot);
-            
-            config = it->config();
-            config.active(enabled);
-
-            TalkgroupRuleGroupVoice entry = *it;
-            entry.config(config);
-            entry.source(source);
-
-            m_groupVoice[it - m_groupVoice.begin()] = entry;
-        }
-        else {
-            TalkgroupRuleGroupVoice entry;
-            entry.config(config);
-            entry.source(source);
+/// <summary>
+/// Adds new entries to the lookup table by the specified unique IDs.
+/// </summary>
+/// <remarks>The published rules are never modified; the entries are applied to a copy which replaces them.</remarks>
+/// <param name="ids">Unique IDs and DMR slots to add.</param>
+/// <param name="enabled">Flag indicating if talkgroup IDs are enabled or not.</param>
+void TalkgroupRulesLookup::addEntries(const std::vector<std::pair<uint32_t, uint8_t>>& ids, bool enabled)
+{
+    if (ids.empty())
+        return;
 
-            m_groupVoice.push_back(entry);
-        }
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::shared_ptr<std::vector<TalkgroupRuleGroupVoice>> groupVoice = std::make_shared<std::vector<TalkgroupRuleGroupVoice>>(*m_groupVoice);
+    GroupVoiceIndex index(*groupVoice);
+    for (auto& entry : ids) {
+        uint32_t id = entry.first;
+        uint8_t slot = entry.second;
+
+        size_t i = index.find(id, slot);
+        TalkgroupRuleGroupVoice rule = (i != GroupVoiceIndex::NOT_FOUND) ? (*groupVoice)[i] : TalkgroupRuleGroupVoice();
+
+        TalkgroupRuleGroupVoiceSource source = rule.source();
+        source.tgId(id);
+        source.tgSlot(slot);
+
+        TalkgroupRuleConfig config = rule.config();
+        config.active(enabled);
+
+        rule.config(config);
+        rule.source(source);
+        index.set(i, rule);
     }
-    m_mutex.unlock();
+
+    publish(groupVoice);
 }
 
 /// <summary>
@@ -187,32 +269,35 @@ void TalkgroupRulesLookup::addEntry(uint32_t id, uint8_t slot, bool enabled)
 /// <param name="groupVoice"></param>
 void TalkgroupRulesLookup::addEntry(TalkgroupRuleGroupVoice groupVoice)
 {
-    if (groupVoice.isInvalid())
-        return;
+    addEntries(std::vector<TalkgroupRuleGroupVoice>(1U, groupVoice));
+}
 
-    TalkgroupRuleGroupVoice entry = groupVoice;
-    uint32_t id = entry.source().tgId();
-    uint8_t slot = entry.source().tgSlot();
+/// <summary>
+/// Adds new entries to the lookup table.
+/// </summary>
+/// <remarks>The published rules are never modified; the entries are applied to a copy which replaces them.</remarks>
+/// <param name="groupVoice">Group voice rules to add, or replace existing rules with.</param>
+void TalkgroupRulesLookup::addEntries(const std::vector<TalkgroupRuleGroupVoice>& groupVoice)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
 
-    m_mutex.lock();
-    {
-        auto it = std::find_if(m_groupVoice.begin(), m_groupVoice.end(), 
-            [&](TalkgroupRuleGroupVoice x) 
-            { 
-                if (slot != 0U) {
-                    return x.source().tgId() == id && x.source().tgSlot() == slot;
-                }
-
-                return x.source().tgId() == id; 
-            });
-        if (it != m_groupVoice.end()) {
-            m_groupVoice[it - m_groupVoice.begin()] = entry;
-        }
-        else {
-            m_groupVoice.push_back(entry);
+    std::shared_ptr<std::vector<TalkgroupRuleGroupVoice>> list;
+    std::unique_ptr<GroupVoiceIndex> index;
+    for (const TalkgroupRuleGroupVoice& entry : groupVoice) {
+        if (entry.isInvalid())
+            continue;
+
+        if (list == nullptr) {
+            list = std::make_shared<std::vector<TalkgroupRuleGroupVoice>>(*m_groupVoice);
+            index.reset(new GroupVoiceIndex(*list));
         }
+
+        index->set(index->find(entry.source().tgId(), entry.source().tgSlot()), entry);
+    }
+
+    if (list != nullptr) {
+        publish(list);
     }
-    m_mutex.unlock();
 }
 
 /// <summary>
@@ -222,14 +307,42 @@ void TalkgroupRulesLookup::addEntry(TalkgroupRuleGroupVoice groupVoice)
 /// <param name="slot">DMR slot this talkgroup is valid on.</param>
 void TalkgroupRulesLookup::eraseEntry(uint32_t id, uint8_t slot)
 {
-    m_mutex.lock();
-    {
-        auto it = std::find_if(m_groupVoice.begin(), m_groupVoice.end(), [&](TalkgroupRuleGroupVoice x) { return x.source().tgId() == id && x.source().tgSlot() == slot; });
-        if (it != m_groupVoice.end()) {
-            m_groupVoice.erase(it);
+    eraseEntries(std::vector<std::pair<uint32_t, uint8_t>>(1U, std::make_pair(id, slot)));
+}
+
+/// <summary>
+/// Erases existing entries from the lookup table by the specified unique IDs.
+/// </summary>
+/// <remarks>The published rules are never modified; the entries are erased from a copy which replaces them.</remarks>
+/// <param name="ids">Unique IDs and DMR slots to erase.</param>
+void TalkgroupRulesLookup::eraseEntries(const std::vector<std::pair<uint32_t, uint8_t>>& ids)
+{
+    if (ids.empty())
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // each ID and slot erases the first rule it matches
+    std::unordered_map<uint64_t, uint32_t> erase;
+    for (auto& entry : ids) {
+        erase[GroupVoiceIndex::key(entry.first, entry.second)]++;
+    }
+
+    std::shared_ptr<std::vector<TalkgroupRuleGroupVoice>> groupVoice = std::make_shared<std::vector<TalkgroupRuleGroupVoice>>();
+    groupVoice->reserve(m_groupVoice->size());
+    for (const TalkgroupRuleGroupVoice& entry : *m_groupVoice) {
+        auto it = erase.find(GroupVoiceIndex::key(entry.source().tgId(), entry.source().tgSlot()));
+        if (it != erase.end() && it->second > 0U) {
+            it->second--;
+            continue;
         }
+
+        groupVoice->push_back(entry);
+    }
+
+    if (groupVoice->size() != m_groupVoice->size()) {
+        publish(groupVoice);
     }
-    m_mutex.unlock();
 }
 
 /// <summary>
@@ -240,28 +353,20 @@ void TalkgroupRulesLookup::eraseEntry(uint32_t id, uint8_t slot)
 /// <returns>Table entry.</returns>
 TalkgroupRuleGroupVoice TalkgroupRulesLookup::find(uint32_t id, uint8_t slot)
 {
-    TalkgroupRuleGroupVoice entry;
+    std::shared_ptr<const std::vector<TalkgroupRuleGroupVoice>> groupVoice = snapshot();
+    for (const TalkgroupRuleGroupVoice& entry : *groupVoice) {
+        if (entry.source().tgId() != id) {
+            continue;
+        }
 
-    m_mutex.lock();
-    {
-        auto it = std::find_if(m_groupVoice.begin(), m_groupVoice.end(), 
-            [&](TalkgroupRuleGroupVoice x) 
-            { 
-                if (slot != 0U) {
-                    return x.source().tgId() == id && x.source().tgSlot() == slot;
-                }
-
-                return x.source().tgId() == id; 
-            });
-        if (it != m_groupVoice.end()) {
-            entry = *it;
-        } else {
-            entry = TalkgroupRuleGroupVoice();
+        if (slot != 0U && entry.source().tgSlot() != slot) {
+            continue;
         }
+
+        return entry;
     }
-    m_mutex.unlock();
 
-    return entry;
+    return TalkgroupRuleGroupVoice();
 }
 
 /// <summary>
@@ -280,6 +385,11 @@ bool TalkgroupRulesLookup::getACL()
 /// <summary>
 /// Loads the table from the passed lookup table file.
 /// </summary>
+/// <remarks>
+/// Nothing is reloaded if the file has not changed since it was last loaded. Otherwise the
+/// binary cache of the file is used if it is still valid, and the file is only parsed (and
+/// the cache rebuilt) when it is not.
+/// </remarks>
 /// <returns>True, if lookup table was loaded, otherwise false.</returns>
 bool TalkgroupRulesLookup::load()
 {
@@ -287,6 +397,122 @@ bool TalkgroupRulesLookup::load()
         return false;
     }
 
+    if (!m_cache.sourceChanged()) {
+        return snapshot()->size() > 0U;
+    }
+
+    // build the new rules off to the side; readers keep using the current rules until they are published
+    std::shared_ptr<std::vector<TalkgroupRuleGroupVoice>> groupVoice = std::make_shared<std::vector<TalkgroupRuleGroupVoice>>();
+
+    bool cached = loadCache(*groupVoice);
+    if (!cached) {
+        groupVoice->clear();
+        if (!loadFile(*groupVoice)) {
+            return false;
+        }
+    }
+
+    size_t size = groupVoice->size();
+
+    m_mutex.lock();
+    {
+        publish(groupVoice);
+        m_cache.loaded();
+    }
+    m_mutex.unlock();
+
+    if (size == 0U)
+        return false;
+
+    LogInfoEx(LOG_HOST, "Loaded %u entries into lookup table%s", size, (cached) ? " (cached)" : "");
+
+    return true;
+}
+
+/// <summary>
+/// Loads the table from the binary cache of the lookup table file.
+/// </summary>
+/// <remarks>
+/// The cache holds one variable-length record per rule, in file order (the first matching
+/// rule wins, so the order is significant): the talkgroup ID, slot, active and parrot flags,
+/// name length, inclusion count and exclusion count, followed by the name padded to a 4-byte
+/// boundary and the inclusion and exclusion peer IDs.
+/// </remarks>
+/// <param name="groupVoice">Rules to load.</param>
+/// <returns>True, if lookup table was loaded, otherwise false.</returns>
+bool TalkgroupRulesLookup::loadCache(std::vector<TalkgroupRuleGroupVoice>& groupVoice)
+{
+    if (!m_cache.open()) {
+        return false;
+    }
+
+    uint32_t count = m_cache.count();
+    const uint8_t* record = m_cache.payload();
+    const uint8_t* end = record + m_cache.length();
+
+    groupVoice.reserve(count);
+    for (uint32_t i = 0U; i < count; i++) {
+        if ((size_t)(end - record) < TGR_CACHE_RECORD_HDR_LEN) {
+            m_cache.close();
+            return false;
+        }
+
+        uint32_t tgId = LookupCache::get32(record);
+        uint8_t tgSlot = record[4U];
+        bool active = record[5U] == 1U;
+        bool parrot = record[6U] == 1U;
+        uint32_t nameLen = LookupCache::get32(record + 8U);
+        uint32_t incCount = LookupCache::get32(record + 12U);
+        uint32_t excCount = LookupCache::get32(record + 16U);
+        record += TGR_CACHE_RECORD_HDR_LEN;
+
+        uint64_t paddedLen = ((uint64_t)nameLen + 3U) & ~3ULL;
+        if ((uint64_t)(end - record) < paddedLen + ((uint64_t)incCount + excCount) * 4U) {
+            m_cache.close();
+            return false;
+        }
+
+        std::string name((const char*)record, nameLen);
+        record += paddedLen;
+
+        std::vector<uint32_t> inclusion(incCount);
+        for (uint32_t n = 0U; n < incCount; n++, record += 4U) {
+            inclusion[n] = LookupCache::get32(record);
+        }
+
+        std::vector<uint32_t> exclusion(excCount);
+        for (uint32_t n = 0U; n < excCount; n++, record += 4U) {
+            exclusion[n] = LookupCache::get32(record);
+        }
+
+        TalkgroupRuleGroupVoiceSource source;
+        source.tgId(tgId);
+        source.tgSlot(tgSlot);
+
+        TalkgroupRuleConfig config;
+        config.active(active);
+        config.parrot(parrot);
+        config.inclusion(inclusion);
+        config.exclusion(exclusion);
+
+        TalkgroupRuleGroupVoice entry;
+        entry.name(name);
+        entry.config(config);
+        entry.source(source);
+        groupVoice.push_back(entry);
+    }
+
+    m_cache.close();
+    return true;
+}
+
+/// <summary>
+/// Loads the table from the lookup table file.
+/// </summary>
+/// <param name="groupVoice">Rules to load.</param>
+/// <returns>True, if lookup table was loaded, otherwise false.</returns>
+bool TalkgroupRulesLookup::loadFile(std::vector<TalkgroupRuleGroupVoice>& groupVoice)
+{
     try {
         bool ret = yaml::Parse(m_rules, m_rulesFile.c_str());
         if (!ret) {
@@ -299,45 +525,67 @@ bool TalkgroupRulesLookup::load()
         return false;
     }
 
-    // clear table
-    clear();
+    yaml::Node& groupVoiceList = m_rules["groupVoice"];
 
-    m_mutex.lock();
-    {
-        yaml::Node& groupVoiceList = m_rules["groupVoice"];
+    if (groupVoiceList.size() == 0U) {
+        ::LogError(LOG_HOST, "No group voice rules list defined!");
+        return false;
+    }
 
-        if (groupVoiceList.size() == 0U) {
-            ::LogError(LOG_HOST, "No group voice rules list defined!");
-            return false;
-        }
+    std::vector<uint8_t> payload;
+    for (size_t i = 0; i < groupVoiceList.size(); i++) {
+        TalkgroupRuleGroupVoice entry = TalkgroupRuleGroupVoice(groupVoiceList[i]);
+        groupVoice.push_back(entry);
 
-        for (size_t i = 0; i < groupVoiceList.size(); i++) {
-            TalkgroupRuleGroupVoice groupVoice = TalkgroupRuleGroupVoice(groupVoiceList[i]);
-            m_groupVoice.push_back(groupVoice);
+        std::string groupName = entry.name();
+        uint32_t tgId = entry.source().tgId();
+        uint8_t tgSlot = entry.source().tgSlot();
+        bool active = entry.config().active();
+        bool parrot = entry.config().parrot();
 
-            std::string groupName = groupVoice.name();
-            uint32_t tgId = groupVoice.source().tgId();
-            uint8_t tgSlot = groupVoice.source().tgSlot();
-            bool active = groupVoice.config().active();
-            bool parrot = groupVoice.config().parrot();
+        std::vector<uint32_t> inclusion = entry.config().inclusion();
+        std::vector<uint32_t> exclusion = entry.config().exclusion();
+        uint32_t incCount = inclusion.size();
+        uint32_t excCount = exclusion.size();
 
-            uint32_t incCount = groupVoice.config().inclusion().size();
-            uint32_t excCount = groupVoice.config().exclusion().size();
+        if (incCount > 0 && excCount > 0) {
+            ::LogWarning(LOG_HOST, "Talkgroup (%s) defines both inclusions and exclusions! Inclusions take precedence and exclusions will be ignored.", groupName.c_str());
+        }
 
-            if (incCount > 0 && excCount > 0) {
-                ::LogWarning(LOG_HOST, "Talkgroup (%s) defines both inclusions and exclusions! Inclusions take precedence and exclusions will be ignored.", groupName.c_str());
-            }
+        ::LogInfoEx(LOG_HOST, "Talkgroup NAME: %s SRC_TGID: %u SRC_TS: %u ACTIVE: %u PARROT: %u INCLUSIONS: %u EXCLUSIONS: %u", groupName.c_str(), tgId, tgSlot, active, parrot, incCount, excCount);
 
-            ::LogInfoEx(LOG_HOST, "Talkgroup NAME: %s SRC_TGID: %u SRC_TS: %u ACTIVE: %u PARROT: %u INCLUSIONS: %u EXCLUSIONS: %u", groupName.c_str(), tgId, tgSlot, active, parrot, incCount, excCount);
-        }
-    }
-    m_mutex.unlock();
+        // append the cache record for this rule
+        LookupCache::put32(payload, tgId);
+        payload.push_back(tgSlot);
+        payload.push_back(active ? 1U : 0U);
+        payload.push_back(parrot ? 1U : 0U);
+        payload.push_back(0U);
+        LookupCache::put32(payload, (uint32_t)groupName.length());
+        LookupCache::put32(payload, incCount);
+        LookupCache::put32(payload, excCount);
 
-    size_t size = m_groupVoice.size();
-    if (size == 0U)
-        return false;
+        payload.insert(payload.end(), groupName.begin(), groupName.end());
+        payload.resize((payload.size() + 3U) & ~(size_t)3U, 0U);
 
-    LogInfoEx(LOG_HOST, "Loaded %u entries into lookup table", size);
+        for (uint32_t peerId : inclusion) {
+            LookupCache::put32(payload, peerId);
+        }
+        for (uint32_t peerId : exclusion) {
+            LookupCache::put32(payload, peerId);
+        }
+    }
 
+    m_cache.write(payload, (uint32_t)groupVoice.size());
     return true;
 }
+
+/// <summary>
+/// Helper to atomically replace the published group voice rules.
+/// </summary>
+/// <remarks>Must be called with the writer lock held.</remarks>
+/// <param name="groupVoice">New group voice rules.</param>
+void TalkgroupRulesLookup::publish(std::shared_ptr<const std::vector<TalkgroupRuleGroupVoice>> groupVoice)
+{
+    std::atomic_store(&m_groupVoice, groupVoice);
+    m_generation++;
+}
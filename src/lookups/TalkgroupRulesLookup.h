@@ -27,13 +27,17 @@
 #define __TALKGROUP_RULES_LOOKUP_H__
 
 #include "Defines.h"
+#include "lookups/LookupCache.h"
 #include "lookups/LookupTable.h"
 #include "Thread.h"
 #include "yaml/Yaml.h"
 
+#include <atomic>
+#include <memory>
 #include <string>
 #include <mutex>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace lookups
@@ -132,6 +136,12 @@ namespace lookups
 
             return *this;
         }
+        /// <summary>Equality operator. Compares this TalkgroupRuleConfig to another TalkgroupRuleConfig.</summary>
+        bool operator==(const TalkgroupRuleConfig& data) const
+        {
+            return m_active == data.m_active && m_parrot == data.m_parrot &&
+                m_inclusion == data.m_inclusion && m_exclusion == data.m_exclusion;
+        }
 
     public:
         /// <summary>Flag indicating whether the rule is active.</summary>
@@ -224,16 +234,29 @@ namespace lookups
 
         /// <summary>Adds a new entry to the lookup table.</summary>
         void addEntry(uint32_t id, uint8_t slot, bool enabled);
+        /// <summary>Adds new entries to the lookup table, as a single update.</summary>
+        void addEntries(const std::vector<std::pair<uint32_t, uint8_t>>& ids, bool enabled);
         /// <summary>Adds a new entry to the lookup table.</summary>
         void addEntry(TalkgroupRuleGroupVoice groupVoice);
+        /// <summary>Adds new entries to the lookup table, as a single update.</summary>
+        void addEntries(const std::vector<TalkgroupRuleGroupVoice>& groupVoice);
         /// <summary>Adds a new entry to the lookup table.</summary>
         void eraseEntry(uint32_t id, uint8_t slot);
+        /// <summary>Erases entries from the lookup table, as a single update.</summary>
+        void eraseEntries(const std::vector<std::pair<uint32_t, uint8_t>>& ids);
         /// <summary>Finds a table entry in this lookup table.</summary>
         virtual TalkgroupRuleGroupVoice find(uint32_t id, uint8_t slot = 0U);
 
         /// <summary>Flag indicating whether talkgroup ID access control is enabled or not.</summary>
         bool getACL();
 
+        /// <summary>Gets the list of group voice rules.</summary>
+        std::vector<TalkgroupRuleGroupVoice> groupVoice() const { return *snapshot(); }
+        /// <summary>Gets the current immutable snapshot of the group voice rules.</summary>
+        std::shared_ptr<const std::vector<TalkgroupRuleGroupVoice>> snapshot() const { return std::atomic_load(&m_groupVoice); }
+        /// <summary>Gets the generation of the rules; this changes whenever the rules are reloaded or modified.</summary>
+        uint32_t generation() const { return m_generation.load(); }
+
     private:
         const std::string m_rulesFile;
         uint32_t m_reloadTime;
@@ -241,20 +264,30 @@ namespace lookups
 
         bool m_acl;
 
-        std::mutex m_mutex;
+        std::shared_ptr<const std::vector<TalkgroupRuleGroupVoice>> m_groupVoice;
+        std::mutex m_mutex;     // serializes writers only; readers never take this
         bool m_stop;
 
+        std::atomic<uint32_t> m_generation;
+
+        LookupCache m_cache;
+
         /// <summary>Loads the table from the passed lookup table file.</summary>
         /// <returns>True, if lookup table was loaded, otherwise false.</returns>
         bool load();
+        /// <summary>Loads the table from the binary cache of the lookup table file.</summary>
+        bool loadCache(std::vector<TalkgroupRuleGroupVoice>& groupVoice);
+        /// <summary>Loads the table from the lookup table file.</summary>
+        bool loadFile(std::vector<TalkgroupRuleGroupVoice>& groupVoice);
+
+        /// <summary>Helper to atomically replace the published group voice rules.</summary>
+        void publish(std::shared_ptr<const std::vector<TalkgroupRuleGroupVoice>> groupVoice);
 
     public:
         /// <summary>Number indicating the number of seconds to hang on a talkgroup.</summary>
         __PROPERTY_PLAIN(uint32_t, groupHangTime, groupHangTime);
         /// <summary>Flag indicating whether or not the network layer should send the talkgroups to peers.</summary>
         __PROPERTY_PLAIN(bool, sendTalkgroups, sendTalkgroups);
-        /// <summary>List of group voice rules.</summary>
-        __PROPERTY_PLAIN(std::vector<TalkgroupRuleGroupVoice>, groupVoice, groupVoice);
     };
 } // namespace lookups
 
@@ -36,6 +36,7 @@
 #include "modem/Modem.h"
 #include "edac/CRC.h"
 #include "Log.h"
+#include "Metrics.h"
 #include "Thread.h"
 #include "Utils.h"
 
@@ -179,6 +180,8 @@ Modem::Modem(port::IModemPort* port, bool duplex, bool rxInvert, bool txInvert,
     m_openPortHandler(nullptr),
     m_closePortHandler(nullptr),
     m_rspHandler(nullptr),
+    m_ioThread(nullptr),
+    m_txLock(),
     m_rxDMRQueue1(dmrQueueSize, "Modem RX DMR1"),
     m_rxDMRQueue2(dmrQueueSize, "Modem RX DMR2"),
     m_rxP25Queue(p25QueueSize, "Modem RX P25"),
@@ -209,6 +212,11 @@ Modem::Modem(port::IModemPort* port, bool duplex, bool rxInvert, bool txInvert,
 /// </summary>
 Modem::~Modem()
 {
+    if (m_ioThread != nullptr) {
+        m_ioThread->stop();
+        delete m_ioThread;
+    }
+
     delete m_port;
     delete[] m_buffer;
 }
@@ -538,6 +546,56 @@ void Modem::setCloseHandler(std::function<MODEM_OC_PORT_HANDLER> handler)
     m_closePortHandler = handler;
 }
 
+/// <summary>
+/// Sets whether or not modem port I/O is performed on a dedicated thread.
+/// </summary>
+/// <remarks>
+/// This should be called after the modem is opened and configured; once enabled, frames read from the
+/// modem are handed to the host through a lock-free queue drained by clock(), and write() queues
+/// frames for the I/O thread instead of blocking on the port.
+/// </remarks>
+/// <param name="enable"></param>
+/// <returns>True, if the requested mode is active, otherwise false.</returns>
+bool Modem::setIOThread(bool enable)
+{
+    std::lock_guard<std::mutex> lock(m_txLock);
+    if (!enable) {
+        if (m_ioThread != nullptr) {
+            m_ioThread->stop();
+            delete m_ioThread;
+            m_ioThread = nullptr;
+        }
+
+        return true;
+    }
+
+    if (m_ioThread == nullptr) {
+        m_ioThread = new ModemIOThread(this);
+    }
+
+    if (!m_ioThread->isRunning() && !m_ioThread->run()) {
+        LogError(LOG_MODEM, "Failed to start the modem I/O thread, falling back to polled port I/O");
+        delete m_ioThread;
+        m_ioThread = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
+/// <summary>
+/// Gets a descriptor that becomes readable when frames have been received from the modem.
+/// </summary>
+/// <remarks>This is only available when port I/O is performed on a dedicated thread.</remarks>
+/// <returns>Event descriptor, or -1 if none is available.</returns>
+int Modem::getEventFd() const
+{
+    if (m_ioThread == nullptr)
+        return -1;
+
+    return m_ioThread->eventFd();
+}
+
 /// <summary>
 /// Opens connection to the air interface modem.
 /// </summary>
@@ -621,6 +679,11 @@ void Modem::clock(uint32_t ms)
     if (m_statusTimer.hasExpired()) {
         getStatus();
         m_statusTimer.start();
+
+        Metrics::set(METRIC_MODEM_RX_DMR1_QUEUE, m_rxDMRQueue1.dataSize());
+        Metrics::set(METRIC_MODEM_RX_DMR2_QUEUE, m_rxDMRQueue2.dataSize());
+        Metrics::set(METRIC_MODEM_RX_P25_QUEUE, m_rxP25Queue.dataSize());
+        Metrics::set(METRIC_MODEM_RX_NXDN_QUEUE, m_rxNXDNQueue.dataSize());
     }
 
     m_inactivityTimer.clock(ms);
@@ -629,1154 +692,1195 @@ void Modem::clock(uint32_t ms)
         reset();
     }
 
-    bool forceModemReset = false;
-    RESP_TYPE_DVM type = getResponse();
+    // when port I/O runs on its own thread, drain every frame it has read since the last clock
+    if (m_ioThread != nullptr && m_ioThread->isRunning()) {
+        m_ioThread->clearEvent();
 
-    // do we have a custom response handler?
-    if (m_rspHandler != nullptr) {
-        // execute custom response handler
-        if (m_rspHandler(this, ms, type, m_rspDoubleLength, m_buffer, m_length)) {
-            // all logic handled by handler -- return
-            return;
+        ModemFrame frame;
+        bool processed = false;
+        while (m_ioThread->isRunning() && m_ioThread->read(frame)) {
+            processResponse(ms, RTM_OK, frame.data, frame.length, frame.doubleLength);
+            processed = true;
         }
-    }
 
-    if (type == RTM_TIMEOUT) {
-        // Nothing to do
-    }
-    else if (type == RTM_ERROR) {
-        // Nothing to do
+        // ensure a custom response handler still gets clocked when nothing was received
+        if (!processed) {
+            processResponse(ms, RTM_TIMEOUT, frame.data, 0U, false);
+        }
+
+        return;
     }
-    else {
-        // type == RTM_OK
-        switch (m_buffer[2U]) {
-        /** Digital Mobile Radio */
-        case CMD_DMR_DATA1:
-        {
-#if defined(ENABLE_DMR)
-            //if (m_trace)
-            //    Utils::dump(1U, "RX DMR Data 1", m_buffer, m_length);
 
-            if (m_rspDoubleLength) {
-                LogError(LOG_MODEM, "CMD_DMR_DATA1 double length?; len = %u", m_length);
-                break;
-            }
+    RESP_TYPE_DVM type = getResponse();
+    processResponse(ms, type, m_buffer, m_length, m_rspDoubleLength);
+}
 
-            uint8_t data = m_length - 2U;
-            m_rxDMRQueue1.addData(&data, 1U);
+/// <summary>
+/// Closes connection to the air interface modem.
+/// </summary>
+void Modem::close()
+{
+    LogDebug(LOG_MODEM, "Closing the modem");
 
-            if (m_buffer[3U] == (dmr::DMR_SYNC_DATA | dmr::DT_TERMINATOR_WITH_LC))
-                data = TAG_EOT;
-            else
-                data = TAG_DATA;
-            m_rxDMRQueue1.addData(&data, 1U);
+    // the I/O thread must be stopped before its port goes away
+    if (m_ioThread != nullptr) {
+        std::lock_guard<std::mutex> lock(m_txLock);
+        m_ioThread->stop();
+    }
 
-            m_rxDMRQueue1.addData(m_buffer + 3U, m_length - 3U);
-#endif // defined(ENABLE_DMR)
-        }
-        break;
+    m_port->close();
 
-        case CMD_DMR_DATA2:
-        {
-#if defined(ENABLE_DMR)
-            //if (m_trace)
-            //    Utils::dump(1U, "RX DMR Data 2", m_buffer, m_length);
+    // do we have a close port handler?
+    if (m_closePortHandler != nullptr) {
+        m_closePortHandler(this);
+    }
+}
 
-            if (m_rspDoubleLength) {
-                LogError(LOG_MODEM, "CMD_DMR_DATA2 double length?; len = %u", m_length);
-                break;
-            }
+/// <summary>
+/// Reads DMR Slot 1 frame data from the DMR Slot 1 ring buffer.
+/// </summary>
+/// <param name="data">Buffer to write frame data to.</param>
+/// <returns>Length of data read from ring buffer.</returns>
+uint32_t Modem::readDMRFrame1(uint8_t* data)
+{
+    assert(data != nullptr);
 
-            uint8_t data = m_length - 2U;
-            m_rxDMRQueue2.addData(&data, 1U);
+    if (m_rxDMRQueue1.isEmpty())
+        return 0U;
 
-            if (m_buffer[3U] == (dmr::DMR_SYNC_DATA | dmr::DT_TERMINATOR_WITH_LC))
-                data = TAG_EOT;
-            else
-                data = TAG_DATA;
-            m_rxDMRQueue2.addData(&data, 1U);
+    uint8_t len = 0U;
+    m_rxDMRQueue1.getData(&len, 1U);
+    m_rxDMRQueue1.getData(data, len);
 
-            m_rxDMRQueue2.addData(m_buffer + 3U, m_length - 3U);
-#endif // defined(ENABLE_DMR)
-        }
-        break;
+    Metrics::add(METRIC_DMR_FRAMES_IN);
+    return len;
+}
 
-        case CMD_DMR_LOST1:
-        {
-#if defined(ENABLE_DMR)
-            //if (m_trace)
-            //    Utils::dump(1U, "RX DMR Lost 1", m_buffer, m_length);
+/// <summary>
+/// Reads DMR Slot 2 frame data from the DMR Slot 2 ring buffer.
+/// </summary>
+/// <param name="data">Buffer to write frame data to.</param>
+/// <returns>Length of data read from ring buffer.</returns>
+uint32_t Modem::readDMRFrame2(uint8_t* data)
+{
+    assert(data != nullptr);
 
-            if (m_rspDoubleLength) {
-                LogError(LOG_MODEM, "CMD_DMR_LOST1 double length?; len = %u", m_length);
-                break;
-            }
+    if (m_rxDMRQueue2.isEmpty())
+        return 0U;
 
-            uint8_t data = 1U;
-            m_rxDMRQueue1.addData(&data, 1U);
+    uint8_t len = 0U;
+    m_rxDMRQueue2.getData(&len, 1U);
+    m_rxDMRQueue2.getData(data, len);
 
-            data = TAG_LOST;
-            m_rxDMRQueue1.addData(&data, 1U);
-#endif // defined(ENABLE_DMR)
-        }
-        break;
+    Metrics::add(METRIC_DMR_FRAMES_IN);
+    return len;
+}
 
-        case CMD_DMR_LOST2:
-        {
-#if defined(ENABLE_DMR)
-            //if (m_trace)
-            //    Utils::dump(1U, "RX DMR Lost 2", m_buffer, m_length);
+/// <summary>
+/// Reads P25 frame data from the P25 ring buffer.
+/// </summary>
+/// <param name="data">Buffer to write frame data to.</param>
+/// <returns>Length of data read from ring buffer.</returns>
+uint32_t Modem::readP25Frame(uint8_t* data)
+{
+    assert(data != nullptr);
 
-            if (m_rspDoubleLength) {
-                LogError(LOG_MODEM, "CMD_DMR_LOST2 double length?; len = %u", m_length);
-                break;
-            }
+    if (m_rxP25Queue.isEmpty())
+        return 0U;
 
-            uint8_t data = 1U;
-            m_rxDMRQueue2.addData(&data, 1U);
+    uint8_t len = 0U;
+    m_rxP25Queue.getData(&len, 1U);
+    m_rxP25Queue.getData(data, len);
 
-            data = TAG_LOST;
-            m_rxDMRQueue2.addData(&data, 1U);
-#endif // defined(ENABLE_DMR)
-        }
-        break;
+    Metrics::add(METRIC_P25_FRAMES_IN);
+    return len;
+}
 
-        /** Project 25 */
-        case CMD_P25_DATA:
-        {
-#if defined(ENABLE_P25)
-            //if (m_trace)
-            //    Utils::dump(1U, "RX P25 Data", m_buffer, m_length);
+/// <summary>
+/// Reads NXDN frame data from the NXDN ring buffer.
+/// </summary>
+/// <param name="data">Buffer to write frame data to.</param>
+/// <returns>Length of data read from ring buffer.</returns>
+uint32_t Modem::readNXDNFrame(uint8_t* data)
+{
+    assert(data != nullptr);
 
-            if (m_rspDoubleLength) {
-                LogError(LOG_MODEM, "CMD_P25_DATA double length?; len = %u", m_length);
-                break;
-            }
+    if (m_rxNXDNQueue.isEmpty())
+        return 0U;
 
-            uint8_t data = m_length - 2U;
-            m_rxP25Queue.addData(&data, 1U);
+    uint8_t len = 0U;
+    m_rxNXDNQueue.getData(&len, 1U);
+    m_rxNXDNQueue.getData(data, len);
 
-            data = TAG_DATA;
-            m_rxP25Queue.addData(&data, 1U);
+    Metrics::add(METRIC_NXDN_FRAMES_IN);
+    return len;
+}
 
-            m_rxP25Queue.addData(m_buffer + 3U, m_length - 3U);
-#endif // defined(ENABLE_P25)
-        }
-        break;
+/// <summary>
+/// Helper to test if the DMR Slot 1 ring buffer has free space.
+/// </summary>
+/// <returns>True, if the DMR Slot 1 ring buffer has free space, otherwise false.</returns>
+bool Modem::hasDMRSpace1() const
+{
+    return m_dmrSpace1 >= (dmr::DMR_FRAME_LENGTH_BYTES + 2U);
+}
 
-        case CMD_P25_LOST:
-        {
-#if defined(ENABLE_P25)
-            //if (m_trace)
-            //    Utils::dump(1U, "RX P25 Lost", m_buffer, m_length);
+/// <summary>
+/// Helper to test if the DMR Slot 2 ring buffer has free space.
+/// </summary>
+/// <returns>True, if the DMR Slot 2 ring buffer has free space, otherwise false.</returns>
+bool Modem::hasDMRSpace2() const
+{
+    return m_dmrSpace2 >= (dmr::DMR_FRAME_LENGTH_BYTES + 2U);
+}
 
-            if (m_rspDoubleLength) {
-                LogError(LOG_MODEM, "CMD_P25_LOST double length?; len = %u", m_length);
-                break;
-            }
+/// <summary>
+/// Helper to test if the P25 ring buffer has free space.
+/// </summary>
+/// <param name="length"></param>
+/// <returns>True, if the P25 ring buffer has free space, otherwise false.</returns>
+bool Modem::hasP25Space(uint32_t length) const
+{
+    return m_p25Space >= length;
+}
 
-            uint8_t data = 1U;
-            m_rxP25Queue.addData(&data, 1U);
+/// <summary>
+/// Helper to test if the NXDN ring buffer has free space.
+/// </summary>
+/// <returns>True, if the NXDN ring buffer has free space, otherwise false.</returns>
+bool Modem::hasNXDNSpace() const
+{
+    return m_nxdnSpace >= nxdn::NXDN_FRAME_LENGTH_BYTES;
+}
 
-            data = TAG_LOST;
-            m_rxP25Queue.addData(&data, 1U);
-#endif // defined(ENABLE_P25)
-        }
-        break;
+/// <summary>
+/// Helper to test if the modem is a hotspot.
+/// </summary>
+/// <returns>True, if the modem is a hotspot, otherwise false.</returns>
+bool Modem::isHotspot() const
+{
+    return m_isHotspot;
+}
 
-        /** Next Generation Digital Narrowband */
-        case CMD_NXDN_DATA:
-        {
-#if defined(ENABLE_NXDN)
-            //if (m_trace)
-            //    Utils::dump(1U, "RX NXDN Data", m_buffer, m_length);
+/// <summary>
+/// Flag indicating whether or not the air interface modem is transmitting.
+/// </summary>
+/// <returns>True, if air interface modem is transmitting, otherwise false.</returns>
+bool Modem::hasTX() const
+{
+    return m_tx;
+}
 
-            if (m_rspDoubleLength) {
-                LogError(LOG_MODEM, "CMD_NXDN_DATA double length?; len = %u", m_length);
-                break;
-            }
-
-            uint8_t data = m_length - 2U;
-            m_rxNXDNQueue.addData(&data, 1U);
-
-            data = TAG_DATA;
-            m_rxNXDNQueue.addData(&data, 1U);
-
-            m_rxNXDNQueue.addData(m_buffer + 3U, m_length - 3U);
-#endif // defined(ENABLE_NXDN)
-        }
-        break;
-
-        case CMD_NXDN_LOST:
-        {
-#if defined(ENABLE_NXDN)
-            //if (m_trace)
-            //    Utils::dump(1U, "RX NXDN Lost", m_buffer, m_length);
-
-            if (m_rspDoubleLength) {
-                LogError(LOG_MODEM, "CMD_NXDN_LOST double length?; len = %u", m_length);
-                break;
-            }
-
-            uint8_t data = 1U;
-            m_rxNXDNQueue.addData(&data, 1U);
-
-            data = TAG_LOST;
-            m_rxNXDNQueue.addData(&data, 1U);
-#endif // defined(ENABLE_NXDN)
-        }
-        break;
-
-        /** General */
-        case CMD_GET_STATUS:
-        {
-            //if (m_trace)
-            //   Utils::dump(1U, "Get Status", m_buffer, m_length);
-
-            m_isHotspot = (m_buffer[3U] & 0x01U) == 0x01U;
-
-            // override hotspot flag if we're forcing hotspot
-            if (m_forceHotspot) {
-                m_isHotspot = m_forceHotspot;
-            }
-
-            bool dmrEnable = (m_buffer[3U] & 0x02U) == 0x02U;
-            bool p25Enable = (m_buffer[3U] & 0x08U) == 0x08U;
-            bool nxdnEnable = (m_buffer[3U] & 0x10U) == 0x10U;
-
-            m_modemState = (DVM_STATE)m_buffer[4U];
-
-            m_tx = (m_buffer[5U] & 0x01U) == 0x01U;
-
-            bool adcOverflow = (m_buffer[5U] & 0x02U) == 0x02U;
-            if (adcOverflow) {
-                //LogError(LOG_MODEM, "ADC levels have overflowed");
-                m_adcOverFlowCount++;
-
-                if (m_adcOverFlowCount >= MAX_ADC_OVERFLOW / 2U) {
-                    LogWarning(LOG_MODEM, "ADC overflow count > %u!", MAX_ADC_OVERFLOW / 2U);
-                }
-
-                if (!m_disableOFlowReset) {
-                    if (m_adcOverFlowCount > MAX_ADC_OVERFLOW) {
-                        LogError(LOG_MODEM, "ADC overflow count > %u, resetting modem", MAX_ADC_OVERFLOW);
-                        forceModemReset = true;
-                    }
-                }
-                else {
-                    m_adcOverFlowCount = 0U;
-                }
-            }
-            else {
-                if (m_adcOverFlowCount != 0U) {
-                    m_adcOverFlowCount--;
-                }
-            }
-
-            bool rxOverflow = (m_buffer[5U] & 0x04U) == 0x04U;
-            if (rxOverflow)
-                LogError(LOG_MODEM, "RX buffer has overflowed");
-
-            bool txOverflow = (m_buffer[5U] & 0x08U) == 0x08U;
-            if (txOverflow)
-                LogError(LOG_MODEM, "TX buffer has overflowed");
+/// <summary>
+/// Flag indicating whether or not the air interface modem has carrier detect.
+/// </summary>
+/// <returns>True, if air interface modem has carrier detect, otherwise false.</returns>
+bool Modem::hasCD() const
+{
+    return m_cd;
+}
 
-            m_lockout = (m_buffer[5U] & 0x10U) == 0x10U;
+/// <summary>
+/// Flag indicating whether or not the air interface modem is currently locked out.
+/// </summary>
+/// <returns>True, if air interface modem is currently locked out, otherwise false.</returns>
+bool Modem::hasLockout() const
+{
+    return m_lockout;
+}
 
-            bool dacOverflow = (m_buffer[5U] & 0x20U) == 0x20U;
-            if (dacOverflow) {
-                //LogError(LOG_MODEM, "DAC levels have overflowed");
-                m_dacOverFlowCount++;
+/// <summary>
+/// Flag indicating whether or not the air interface modem is currently in an error condition.
+/// </summary>
+/// <returns>True, if the air interface modem is current in an error condition, otherwise false.</returns>
+bool Modem::hasError() const
+{
+    return m_error;
+}
 
-                if (m_dacOverFlowCount > MAX_DAC_OVERFLOW / 2U) {
-                    LogWarning(LOG_MODEM, "DAC overflow count > %u!", MAX_DAC_OVERFLOW / 2U);
-                }
+/// <summary>
+/// Clears any buffered DMR Slot 1 frame data to be sent to the air interface modem.
+/// </summary>
+void Modem::clearDMRFrame1()
+{
+    uint8_t buffer[3U];
 
-                if (!m_disableOFlowReset) {
-                    if (m_dacOverFlowCount > MAX_DAC_OVERFLOW) {
-                        LogError(LOG_MODEM, "DAC overflow count > %u, resetting modem", MAX_DAC_OVERFLOW);
-                        forceModemReset = true;
-                    }
-                }
-                else {
-                    m_dacOverFlowCount = 0U;
-                }
-            }
-            else {
-                if (m_dacOverFlowCount != 0U) {
-                    m_dacOverFlowCount--;
-                }
-            }
+    buffer[0U] = DVM_FRAME_START;
+    buffer[1U] = 3U;
+    buffer[2U] = CMD_DMR_CLEAR1;
+#if DEBUG_MODEM
+    Utils::dump(1U, "Modem::clearDMRFrame1(), Written", buffer, 3U);
+#endif
+    write(buffer, 3U);
+    Thread::sleep(5); // 5ms delay
+}
 
-            m_cd = (m_buffer[5U] & 0x40U) == 0x40U;
+/// <summary>
+/// Clears any buffered DMR Slot 2 frame data to be sent to the air interface modem.
+/// </summary>
+void Modem::clearDMRFrame2()
+{
+    uint8_t buffer[3U];
 
-            // spaces from the modem are returned in "logical" frame count, not raw byte size
-            m_dmrSpace1 = m_buffer[7U] * (dmr::DMR_FRAME_LENGTH_BYTES + 2U);
-            m_dmrSpace2 = m_buffer[8U] * (dmr::DMR_FRAME_LENGTH_BYTES + 2U);
-            m_p25Space = m_buffer[10U] * (p25::P25_LDU_FRAME_LENGTH_BYTES);
-            m_nxdnSpace = m_buffer[11U] * (nxdn::NXDN_FRAME_LENGTH_BYTES);
+    buffer[0U] = DVM_FRAME_START;
+    buffer[1U] = 3U;
+    buffer[2U] = CMD_DMR_CLEAR2;
+#if DEBUG_MODEM
+    Utils::dump(1U, "Modem::clearDMRFrame2(), Written", buffer, 3U);
+#endif
+    write(buffer, 3U);
+    Thread::sleep(5); // 5ms delay
+}
 
-            if (m_dumpModemStatus) {
-                LogDebug(LOG_MODEM, "Modem::clock(), CMD_GET_STATUS, isHotspot = %u, dmr = %u / %u, p25 = %u / %u, nxdn = %u / %u, modemState = %u, tx = %u, adcOverflow = %u, rxOverflow = %u, txOverflow = %u, dacOverflow = %u, dmrSpace1 = %u, dmrSpace2 = %u, p25Space = %u, nxdnSpace = %u",
-                    m_isHotspot, dmrEnable, m_dmrEnabled, p25Enable, m_p25Enabled, nxdnEnable, m_nxdnEnabled, m_modemState, m_tx, adcOverflow, rxOverflow, txOverflow, dacOverflow, m_dmrSpace1, m_dmrSpace2, m_p25Space, m_nxdnSpace);
-                LogDebug(LOG_MODEM, "Modem::clock(), CMD_GET_STATUS, rxDMRData1 size = %u, len = %u, free = %u; rxDMRData2 size = %u, len = %u, free = %u, rxP25Data size = %u, len = %u, free = %u, rxNXDNData size = %u, len = %u, free = %u",
-                    m_rxDMRQueue1.length(), m_rxDMRQueue1.dataSize(), m_rxDMRQueue1.freeSpace(), m_rxDMRQueue2.length(), m_rxDMRQueue2.dataSize(), m_rxDMRQueue2.freeSpace(),
-                    m_rxP25Queue.length(), m_rxP25Queue.dataSize(), m_rxP25Queue.freeSpace(), m_rxNXDNQueue.length(), m_rxNXDNQueue.dataSize(), m_rxNXDNQueue.freeSpace());
-            }
+/// <summary>
+/// Clears any buffered P25 frame data to be sent to the air interface modem.
+/// </summary>
+void Modem::clearP25Frame()
+{
+    uint8_t buffer[3U];
 
-            m_inactivityTimer.start();
-        }
-        break;
+    buffer[0U] = DVM_FRAME_START;
+    buffer[1U] = 3U;
+    buffer[2U] = CMD_P25_CLEAR;
+#if DEBUG_MODEM
+    Utils::dump(1U, "Modem::clearP25Data(), Written", buffer, 3U);
+#endif
+    write(buffer, 3U);
+    Thread::sleep(5); // 5ms delay
+}
 
-        case CMD_GET_VERSION:
-        case CMD_ACK:
-            break;
+/// <summary>
+/// Clears any buffered NXDN frame data to be sent to the air interface modem.
+/// </summary>
+void Modem::clearNXDNFrame()
+{
+    uint8_t buffer[3U];
 
-        case CMD_NAK:
-        {
-            LogWarning(LOG_MODEM, "NAK, command = 0x%02X (%s), reason = %u (%s)", m_buffer[3U], cmdToString(m_buffer[3U]).c_str(), m_buffer[4U], rsnToString(m_buffer[4U]).c_str());
-            switch (m_buffer[4U]) {
-                case RSN_RINGBUFF_FULL:
-                {
-                    switch (m_buffer[3U]) {
-                        case CMD_DMR_DATA1:
-                            LogWarning(LOG_MODEM, "NAK, %s, dmrSpace1 = %u", rsnToString(m_buffer[4U]).c_str(), m_dmrSpace1);
-                            break;
-                        case CMD_DMR_DATA2:
-                            LogWarning(LOG_MODEM, "NAK, %s, dmrSpace2 = %u", rsnToString(m_buffer[4U]).c_str(), m_dmrSpace2);
-                            break;
+    buffer[0U] = DVM_FRAME_START;
+    buffer[1U] = 3U;
+    buffer[2U] = CMD_NXDN_CLEAR;
+#if DEBUG_MODEM
+    Utils::dump(1U, "Modem::clearNXDNFrame(), Written", buffer, 3U);
+#endif
+    write(buffer, 3U);
+    Thread::sleep(5); // 5ms delay
+}
 
-                        case CMD_P25_DATA:
-                            LogWarning(LOG_MODEM, "NAK, %s, p25Space = %u", rsnToString(m_buffer[4U]).c_str(), m_p25Space);
-                            break;
+/// <summary>
+/// Internal helper to inject DMR Slot 1 frame data as if it came from the air interface modem.
+/// </summary>
+/// <param name="data">Data to write to ring buffer.</param>
+/// <param name="length">Length of data to write.</param>
+void Modem::injectDMRFrame1(const uint8_t* data, uint32_t length)
+{
+#if defined(ENABLE_DMR)
+    assert(data != nullptr);
+    assert(length > 0U);
 
-                        case CMD_NXDN_DATA:
-                            LogWarning(LOG_MODEM, "NAK, %s, nxdnSpace = %u", rsnToString(m_buffer[4U]).c_str(), m_nxdnSpace);
-                            break;
-                        }
-                }
-                break;
-            }
-        }
-        break;
+    if (m_trace)
+        Utils::dump(1U, "Injected DMR Slot 1 Data", data, length);
 
-        case CMD_DEBUG1:
-        case CMD_DEBUG2:
-        case CMD_DEBUG3:
-        case CMD_DEBUG4:
-        case CMD_DEBUG5:
-        case CMD_DEBUG_DUMP:
-            printDebug(m_buffer, m_length);
-            break;
+    uint8_t val = length;
+    m_rxDMRQueue1.addData(&val, 1U);
 
-        default:
-            LogWarning(LOG_MODEM, "Unknown message, type = %02X", m_buffer[2U]);
-            Utils::dump("Buffer dump", m_buffer, m_length);
-            break;
-        }
-    }
+    val = TAG_DATA;
+    m_rxDMRQueue1.addData(&val, 1U);
+    val = dmr::DMR_SYNC_VOICE & dmr::DMR_SYNC_DATA;    // valid sync
+    m_rxDMRQueue1.addData(&val, 1U);
 
-    // force a modem reset because of a error condition
-    if (forceModemReset) {
-        forceModemReset = false;
-        reset();
-    }
+    m_rxDMRQueue1.addData(data, length);
+#endif // defined(ENABLE_DMR)
 }
 
 /// <summary>
-/// Closes connection to the air interface modem.
+/// Internal helper to inject DMR Slot 2 frame data as if it came from the air interface modem.
 /// </summary>
-void Modem::close()
+/// <param name="data">Data to write to ring buffer.</param>
+/// <param name="length">Length of data to write.</param>
+void Modem::injectDMRFrame2(const uint8_t* data, uint32_t length)
 {
-    LogDebug(LOG_MODEM, "Closing the modem");
-    m_port->close();
+#if defined(ENABLE_DMR)
+    assert(data != nullptr);
+    assert(length > 0U);
 
-    // do we have a close port handler?
-    if (m_closePortHandler != nullptr) {
-        m_closePortHandler(this);
-    }
+    if (m_trace)
+        Utils::dump(1U, "Injected DMR Slot 2 Data", data, length);
+
+    uint8_t val = length;
+    m_rxDMRQueue2.addData(&val, 1U);
+
+    val = TAG_DATA;
+    m_rxDMRQueue2.addData(&val, 1U);
+    val = dmr::DMR_SYNC_VOICE & dmr::DMR_SYNC_DATA;    // valid sync
+    m_rxDMRQueue2.addData(&val, 1U);
+
+    m_rxDMRQueue2.addData(data, length);
+#endif // defined(ENABLE_DMR)
 }
 
 /// <summary>
-/// Reads DMR Slot 1 frame data from the DMR Slot 1 ring buffer.
+/// Internal helper to inject P25 frame data as if it came from the air interface modem.
 /// </summary>
-/// <param name="data">Buffer to write frame data to.</param>
-/// <returns>Length of data read from ring buffer.</returns>
-uint32_t Modem::readDMRFrame1(uint8_t* data)
+/// <param name="data">Data to write to ring buffer.</param>
+/// <param name="length">Length of data to write.</param>
+void Modem::injectP25Frame(const uint8_t* data, uint32_t length)
 {
+#if defined(ENABLE_P25)
     assert(data != nullptr);
+    assert(length > 0U);
 
-    if (m_rxDMRQueue1.isEmpty())
-        return 0U;
+    if (m_trace)
+        Utils::dump(1U, "Injected P25 Data", data, length);
 
-    uint8_t len = 0U;
-    m_rxDMRQueue1.getData(&len, 1U);
-    m_rxDMRQueue1.getData(data, len);
+    uint8_t val = length;
+    m_rxP25Queue.addData(&val, 1U);
 
-    return len;
+    val = TAG_DATA;
+    m_rxP25Queue.addData(&val, 1U);
+    val = 0x01U;    // valid sync
+    m_rxP25Queue.addData(&val, 1U);
+
+    m_rxP25Queue.addData(data, length);
+#endif // defined(ENABLE_P25)
 }
 
 /// <summary>
-/// Reads DMR Slot 2 frame data from the DMR Slot 2 ring buffer.
+/// Internal helper to inject NXDN frame data as if it came from the air interface modem.
 /// </summary>
-/// <param name="data">Buffer to write frame data to.</param>
-/// <returns>Length of data read from ring buffer.</returns>
-uint32_t Modem::readDMRFrame2(uint8_t* data)
+/// <param name="data">Data to write to ring buffer.</param>
+/// <param name="length">Length of data to write.</param>
+void Modem::injectNXDNFrame(const uint8_t* data, uint32_t length)
 {
+#if defined(ENABLE_NXDN)
     assert(data != nullptr);
+    assert(length > 0U);
 
-    if (m_rxDMRQueue2.isEmpty())
-        return 0U;
+    if (m_trace)
+        Utils::dump(1U, "Injected NXDN Data", data, length);
 
-    uint8_t len = 0U;
-    m_rxDMRQueue2.getData(&len, 1U);
-    m_rxDMRQueue2.getData(data, len);
+    uint8_t val = length;
+    m_rxNXDNQueue.addData(&val, 1U);
 
-    return len;
+    val = TAG_DATA;
+    m_rxNXDNQueue.addData(&val, 1U);
+    val = 0x01U;    // valid sync
+    m_rxNXDNQueue.addData(&val, 1U);
+
+    m_rxNXDNQueue.addData(data, length);
+#endif // defined(ENABLE_NXDN)
 }
 
 /// <summary>
-/// Reads P25 frame data from the P25 ring buffer.
+/// Writes DMR Slot 1 frame data to the DMR Slot 1 ring buffer.
 /// </summary>
-/// <param name="data">Buffer to write frame data to.</param>
-/// <returns>Length of data read from ring buffer.</returns>
-uint32_t Modem::readP25Frame(uint8_t* data)
+/// <param name="data">Data to write to ring buffer.</param>
+/// <param name="length">Length of data to write.</param>
+/// <returns>True, if data is written, otherwise false.</returns>
+bool Modem::writeDMRFrame1(const uint8_t* data, uint32_t length)
 {
+#if defined(ENABLE_DMR)
     assert(data != nullptr);
+    assert(length > 0U);
 
-    if (m_rxP25Queue.isEmpty())
-        return 0U;
+    const uint8_t MAX_LENGTH = 40U;
 
-    uint8_t len = 0U;
-    m_rxP25Queue.getData(&len, 1U);
-    m_rxP25Queue.getData(data, len);
+    if (data[0U] != TAG_DATA && data[0U] != TAG_EOT)
+        return false;
+    if (length > MAX_LENGTH) {
+        LogError(LOG_MODEM, "Modem::writeDMRData1(); request data to write >%u?, len = %u", MAX_LENGTH, length);
+        Utils::dump(1U, "Modem::writeDMRData1(); Attmpted Data", data, length);
+        return false;
+    }
 
-    return len;
+    uint8_t buffer[MAX_LENGTH];
+
+    buffer[0U] = DVM_FRAME_START;
+    buffer[1U] = length + 2U;
+    buffer[2U] = CMD_DMR_DATA1;
+
+    ::memcpy(buffer + 3U, data + 1U, length - 1U);
+
+    uint8_t len = length + 2U;
+
+    // write or buffer DMR slot 1 data to air interface
+    if (m_dmrSpace1 >= length) {
+        if (m_debug)
+            LogDebug(LOG_MODEM, "Modem::writeDMRData1(); immediate write (len %u)", length);
+        //if (m_trace)
+        //    Utils::dump(1U, "Immediate TX DMR Data 1", buffer, len);
+
+        int ret = write(buffer, len);
+        if (ret != int(len)) {
+            LogError(LOG_MODEM, "Error writing DMR slot 1 data");
+            return false;
+        }
+
+        m_dmrSpace1 -= length;
+    }
+    else {
+        return false;
+    }
+
+    Metrics::add(METRIC_DMR_FRAMES_OUT);
+    return true;
+#else
+    return false;
+#endif // defined(ENABLE_DMR)
 }
 
 /// <summary>
-/// Reads NXDN frame data from the NXDN ring buffer.
+/// Writes DMR Slot 2 frame data to the DMR Slot 2 ring buffer.
 /// </summary>
-/// <param name="data">Buffer to write frame data to.</param>
-/// <returns>Length of data read from ring buffer.</returns>
-uint32_t Modem::readNXDNFrame(uint8_t* data)
+/// <param name="data">Data to write to ring buffer.</param>
+/// <param name="length">Length of data to write.</param>
+/// <returns>True, if data is written, otherwise false.</returns>
+bool Modem::writeDMRFrame2(const uint8_t* data, uint32_t length)
 {
+#if defined(ENABLE_DMR)
     assert(data != nullptr);
+    assert(length > 0U);
 
-    if (m_rxNXDNQueue.isEmpty())
-        return 0U;
+    const uint8_t MAX_LENGTH = 40U;
 
-    uint8_t len = 0U;
-    m_rxNXDNQueue.getData(&len, 1U);
-    m_rxNXDNQueue.getData(data, len);
+    if (data[0U] != TAG_DATA && data[0U] != TAG_EOT)
+        return false;
+    if (length > MAX_LENGTH) {
+        LogError(LOG_MODEM, "Modem::writeDMRData2(); request data to write >%u?, len = %u", MAX_LENGTH, length);
+        Utils::dump(1U, "Modem::writeDMRData2(); Attmpted Data", data, length);
+        return false;
+    }
 
-    return len;
-}
+    uint8_t buffer[MAX_LENGTH];
 
-/// <summary>
-/// Helper to test if the DMR Slot 1 ring buffer has free space.
-/// </summary>
-/// <returns>True, if the DMR Slot 1 ring buffer has free space, otherwise false.</returns>
-bool Modem::hasDMRSpace1() const
-{
-    return m_dmrSpace1 >= (dmr::DMR_FRAME_LENGTH_BYTES + 2U);
-}
+    buffer[0U] = DVM_FRAME_START;
+    buffer[1U] = length + 2U;
+    buffer[2U] = CMD_DMR_DATA2;
 
-/// <summary>
-/// Helper to test if the DMR Slot 2 ring buffer has free space.
-/// </summary>
-/// <returns>True, if the DMR Slot 2 ring buffer has free space, otherwise false.</returns>
-bool Modem::hasDMRSpace2() const
-{
-    return m_dmrSpace2 >= (dmr::DMR_FRAME_LENGTH_BYTES + 2U);
-}
+    ::memcpy(buffer + 3U, data + 1U, length - 1U);
 
-/// <summary>
-/// Helper to test if the P25 ring buffer has free space.
-/// </summary>
-/// <param name="length"></param>
-/// <returns>True, if the P25 ring buffer has free space, otherwise false.</returns>
-bool Modem::hasP25Space(uint32_t length) const
-{
-    return m_p25Space >= length;
-}
+    uint8_t len = length + 2U;
 
-/// <summary>
-/// Helper to test if the NXDN ring buffer has free space.
-/// </summary>
-/// <returns>True, if the NXDN ring buffer has free space, otherwise false.</returns>
-bool Modem::hasNXDNSpace() const
-{
-    return m_nxdnSpace >= nxdn::NXDN_FRAME_LENGTH_BYTES;
-}
+    // write or buffer DMR slot 2 data to air interface
+    if (m_dmrSpace2 >= length) {
+        if (m_debug)
+            LogDebug(LOG_MODEM, "Modem::writeDMRData2(); immediate write (len %u)", length);
+        //if (m_trace)
+        //    Utils::dump(1U, "Immediate TX DMR Data 2", buffer, len);
 
-/// <summary>
-/// Helper to test if the modem is a hotspot.
-/// </summary>
-/// <returns>True, if the modem is a hotspot, otherwise false.</returns>
-bool Modem::isHotspot() const
-{
-    return m_isHotspot;
+        int ret = write(buffer, len);
+        if (ret != int(len)) {
+            LogError(LOG_MODEM, "Error writing DMR slot 2 data");
+            return false;
+        }
+
+        m_dmrSpace2 -= length;
+    }
+    else {
+        return false;
+    }
+
+    Metrics::add(METRIC_DMR_FRAMES_OUT);
+    return true;
+#else
+    return false;
+#endif // defined(ENABLE_DMR)
 }
 
 /// <summary>
-/// Flag indicating whether or not the air interface modem is transmitting.
+/// Writes P25 frame data to the P25 ring buffer.
 /// </summary>
-/// <returns>True, if air interface modem is transmitting, otherwise false.</returns>
-bool Modem::hasTX() const
+/// <param name="data">Data to write to ring buffer.</param>
+/// <param name="length">Length of data to write.</param>
+/// <returns>True, if data is written, otherwise false.</returns>
+bool Modem::writeP25Frame(const uint8_t* data, uint32_t length)
 {
-    return m_tx;
-}
+#if defined(ENABLE_P25)
+    assert(data != nullptr);
+    assert(length > 0U);
+
+    const uint8_t MAX_LENGTH = 250U;
+
+    if (data[0U] != TAG_DATA && data[0U] != TAG_EOT)
+        return false;
+    if (length > MAX_LENGTH) {
+        LogError(LOG_MODEM, "Modem::writeP25Data(); request data to write >%u?, len = %u", MAX_LENGTH, length);
+        Utils::dump(1U, "Modem::writeP25Data(); Attmpted Data", data, length);
+        return false;
+    }
+
+    uint8_t buffer[MAX_LENGTH];
+
+    buffer[0U] = DVM_FRAME_START;
+    buffer[1U] = length + 2U;
+    buffer[2U] = CMD_P25_DATA;
+
+    ::memcpy(buffer + 3U, data + 1U, length - 1U);
+
+    uint8_t len = length + 2U;
+
+    // write or buffer P25 data to air interface
+    if (m_p25Space >= length) {
+        if (m_debug)
+            LogDebug(LOG_MODEM, "Modem::writeP25Data(); immediate write (len %u)", length);
+        //if (m_trace)
+        //    Utils::dump(1U, "Immediate TX P25 Data", buffer, len);
+
+        int ret = write(buffer, len);
+        if (ret != int(len)) {
+            LogError(LOG_MODEM, "Error writing P25 data");
+            return false;
+        }
+
+        m_p25Space -= length;
+    }
+    else {
+        return false;
+    }
 
-/// <summary>
-/// Flag indicating whether or not the air interface modem has carrier detect.
-/// </summary>
-/// <returns>True, if air interface modem has carrier detect, otherwise false.</returns>
-bool Modem::hasCD() const
-{
-    return m_cd;
+    Metrics::add(METRIC_P25_FRAMES_OUT);
+    return true;
+#else
+    return false;
+#endif // defined(ENABLE_P25)
 }
 
 /// <summary>
-/// Flag indicating whether or not the air interface modem is currently locked out.
+/// Writes NXDN frame data to the NXDN ring buffer.
 /// </summary>
-/// <returns>True, if air interface modem is currently locked out, otherwise false.</returns>
-bool Modem::hasLockout() const
+/// <param name="data">Data to write to ring buffer.</param>
+/// <param name="length">Length of data to write.</param>
+/// <returns>True, if data is written, otherwise false.</returns>
+bool Modem::writeNXDNFrame(const uint8_t* data, uint32_t length)
 {
-    return m_lockout;
-}
+#if defined(ENABLE_NXDN)
+    assert(data != nullptr);
+    assert(length > 0U);
 
-/// <summary>
-/// Flag indicating whether or not the air interface modem is currently in an error condition.
-/// </summary>
-/// <returns>True, if the air interface modem is current in an error condition, otherwise false.</returns>
-bool Modem::hasError() const
-{
-    return m_error;
-}
+    const uint8_t MAX_LENGTH = 250U;
 
-/// <summary>
-/// Clears any buffered DMR Slot 1 frame data to be sent to the air interface modem.
-/// </summary>
-void Modem::clearDMRFrame1()
-{
-    uint8_t buffer[3U];
+    if (data[0U] != TAG_DATA && data[0U] != TAG_EOT)
+        return false;
+    if (length > MAX_LENGTH) {
+        LogError(LOG_MODEM, "Modem::writeNXDNData(); request data to write >%u?, len = %u", MAX_LENGTH, length);
+        Utils::dump(1U, "Modem::writeNXDNData(); Attmpted Data", data, length);
+        return false;
+    }
+
+    uint8_t buffer[MAX_LENGTH];
 
     buffer[0U] = DVM_FRAME_START;
-    buffer[1U] = 3U;
-    buffer[2U] = CMD_DMR_CLEAR1;
-#if DEBUG_MODEM
-    Utils::dump(1U, "Modem::clearDMRFrame1(), Written", buffer, 3U);
-#endif
-    write(buffer, 3U);
-    Thread::sleep(5); // 5ms delay
+    buffer[1U] = length + 2U;
+    buffer[2U] = CMD_NXDN_DATA;
+
+    ::memcpy(buffer + 3U, data + 1U, length - 1U);
+
+    uint8_t len = length + 2U;
+
+    // write or buffer NXDN data to air interface
+    if (m_nxdnSpace >= length) {
+        if (m_debug)
+            LogDebug(LOG_MODEM, "Modem::writeNXDNData(); immediate write (len %u)", length);
+        //if (m_trace)
+        //    Utils::dump(1U, "Immediate TX NXDN Data", buffer, len);
+
+        int ret = write(buffer, len);
+        if (ret != int(len)) {
+            LogError(LOG_MODEM, "Error writing NXDN data");
+            return false;
+        }
+
+        m_nxdnSpace -= length;
+    }
+    else {
+        return false;
+    }
+
+    Metrics::add(METRIC_NXDN_FRAMES_OUT);
+    return true;
+#else
+    return false;
+#endif // defined(ENABLE_NXDN)
 }
 
 /// <summary>
-/// Clears any buffered DMR Slot 2 frame data to be sent to the air interface modem.
+/// Triggers the start of DMR transmit.
 /// </summary>
-void Modem::clearDMRFrame2()
+/// <param name="tx"></param>
+/// <returns>True, if DMR transmit started, otherwise false.</returns>
+bool Modem::writeDMRStart(bool tx)
 {
-    uint8_t buffer[3U];
+#if defined(ENABLE_DMR)
+    if (tx && m_tx)
+        return true;
+    if (!tx && !m_tx)
+        return true;
+
+    uint8_t buffer[4U];
 
     buffer[0U] = DVM_FRAME_START;
-    buffer[1U] = 3U;
-    buffer[2U] = CMD_DMR_CLEAR2;
+    buffer[1U] = 4U;
+    buffer[2U] = CMD_DMR_START;
+    buffer[3U] = tx ? 0x01U : 0x00U;
 #if DEBUG_MODEM
-    Utils::dump(1U, "Modem::clearDMRFrame2(), Written", buffer, 3U);
+    Utils::dump(1U, "Modem::writeDMRStart(), Written", buffer, 4U);
 #endif
-    write(buffer, 3U);
-    Thread::sleep(5); // 5ms delay
+    return write(buffer, 4U) == 4;
+#else
+    return false;
+#endif // defined(ENABLE_DMR)
 }
 
 /// <summary>
-/// Clears any buffered P25 frame data to be sent to the air interface modem.
+/// Writes a DMR short LC to the air interface modem.
 /// </summary>
-void Modem::clearP25Frame()
+/// <param name="lc"></param>
+/// <returns>True, if DMR LC is written, otherwise false.</returns>
+bool Modem::writeDMRShortLC(const uint8_t* lc)
 {
-    uint8_t buffer[3U];
+#if defined(ENABLE_DMR)
+    assert(lc != nullptr);
+
+    uint8_t buffer[12U];
 
     buffer[0U] = DVM_FRAME_START;
-    buffer[1U] = 3U;
-    buffer[2U] = CMD_P25_CLEAR;
+    buffer[1U] = 12U;
+    buffer[2U] = CMD_DMR_SHORTLC;
+    buffer[3U] = lc[0U];
+    buffer[4U] = lc[1U];
+    buffer[5U] = lc[2U];
+    buffer[6U] = lc[3U];
+    buffer[7U] = lc[4U];
+    buffer[8U] = lc[5U];
+    buffer[9U] = lc[6U];
+    buffer[10U] = lc[7U];
+    buffer[11U] = lc[8U];
 #if DEBUG_MODEM
-    Utils::dump(1U, "Modem::clearP25Data(), Written", buffer, 3U);
+    Utils::dump(1U, "Modem::writeDMRShortLC(), Written", buffer, 12U);
 #endif
-    write(buffer, 3U);
-    Thread::sleep(5); // 5ms delay
+    return write(buffer, 12U) == 12;
+#else
+    return false;
+#endif // defined(ENABLE_DMR)
 }
 
 /// <summary>
-/// Clears any buffered NXDN frame data to be sent to the air interface modem.
+/// Writes a DMR abort message for the given slot to the air interface modem.
 /// </summary>
-void Modem::clearNXDNFrame()
+/// <param name="slotNo">DMR slot to write abort for.</param>
+/// <returns>True, if DMR abort is written, otherwise false.</returns>
+bool Modem::writeDMRAbort(uint32_t slotNo)
 {
-    uint8_t buffer[3U];
+#if defined(ENABLE_DMR)
+    uint8_t buffer[4U];
 
     buffer[0U] = DVM_FRAME_START;
-    buffer[1U] = 3U;
-    buffer[2U] = CMD_NXDN_CLEAR;
+    buffer[1U] = 4U;
+    buffer[2U] = CMD_DMR_ABORT;
+    buffer[3U] = slotNo;
 #if DEBUG_MODEM
-    Utils::dump(1U, "Modem::clearNXDNFrame(), Written", buffer, 3U);
+    Utils::dump(1U, "Modem::writeDMRAbort(), Written", buffer, 4U);
 #endif
-    write(buffer, 3U);
-    Thread::sleep(5); // 5ms delay
+    return write(buffer, 4U) == 4;
+#else
+    return false;
+#endif // defined(ENABLE_DMR)
 }
 
 /// <summary>
-/// Internal helper to inject DMR Slot 1 frame data as if it came from the air interface modem.
+/// Sets the ignore flags for setting the CACH Access Type bit on the air interface modem.
 /// </summary>
-/// <param name="data">Data to write to ring buffer.</param>
-/// <param name="length">Length of data to write.</param>
-void Modem::injectDMRFrame1(const uint8_t* data, uint32_t length)
+/// <param name="slotNo">DMR slot to set ignore CACH AT flag for.</param>
+/// <returns>True, if set flag is written, otherwise false.</returns>
+bool Modem::setDMRIgnoreCACH_AT(uint8_t slotNo)
 {
 #if defined(ENABLE_DMR)
-    assert(data != nullptr);
-    assert(length > 0U);
-
-    if (m_trace)
-        Utils::dump(1U, "Injected DMR Slot 1 Data", data, length);
-
-    uint8_t val = length;
-    m_rxDMRQueue1.addData(&val, 1U);
+    uint8_t buffer[4U];
 
-    val = TAG_DATA;
-    m_rxDMRQueue1.addData(&val, 1U);
-    val = dmr::DMR_SYNC_VOICE & dmr::DMR_SYNC_DATA;    // valid sync
-    m_rxDMRQueue1.addData(&val, 1U);
+    buffer[0U] = DVM_FRAME_START;
+    buffer[1U] = 4U;
+    buffer[2U] = CMD_DMR_CACH_AT_CTRL;
+    buffer[3U] = slotNo;
 
-    m_rxDMRQueue1.addData(data, length);
+    // are we on a protocol version 3 firmware?
+    if (m_protoVer >= 3U) {
+#if DEBUG_MODEM
+        Utils::dump(1U, "Modem::setDMRIgnoreCACH_AT(), Written", buffer, 4U);
+#endif
+        return write(buffer, 4U) == 4;
+    } else {
+        LogWarning(LOG_MODEM, "Modem::setDMRIgnoreCACH_AT(), ignoring CACH AT for slot %u is not supported on this modem!", slotNo);
+        return false;
+    }
+#else
+    return false;
 #endif // defined(ENABLE_DMR)
 }
 
 /// <summary>
-/// Internal helper to inject DMR Slot 2 frame data as if it came from the air interface modem.
+/// Writes raw data to the air interface modem.
 /// </summary>
-/// <param name="data">Data to write to ring buffer.</param>
-/// <param name="length">Length of data to write.</param>
-void Modem::injectDMRFrame2(const uint8_t* data, uint32_t length)
+/// <param name="data"></param>
+/// <param name="length"></param>
+/// <returns></returns>
+int Modem::write(const uint8_t* data, uint32_t length)
 {
-#if defined(ENABLE_DMR)
-    assert(data != nullptr);
-    assert(length > 0U);
-
-    if (m_trace)
-        Utils::dump(1U, "Injected DMR Slot 2 Data", data, length);
-
-    uint8_t val = length;
-    m_rxDMRQueue2.addData(&val, 1U);
-
-    val = TAG_DATA;
-    m_rxDMRQueue2.addData(&val, 1U);
-    val = dmr::DMR_SYNC_VOICE & dmr::DMR_SYNC_DATA;    // valid sync
-    m_rxDMRQueue2.addData(&val, 1U);
+    std::lock_guard<std::mutex> lock(m_txLock);
+    if (m_ioThread != nullptr && m_ioThread->isRunning()) {
+        return m_ioThread->write(data, length) ? int(length) : -1;
+    }
 
-    m_rxDMRQueue2.addData(data, length);
-#endif // defined(ENABLE_DMR)
+    return m_port->write(data, length);
 }
 
 /// <summary>
-/// Internal helper to inject P25 frame data as if it came from the air interface modem.
+/// Gets the current operating state for the air interface modem.
 /// </summary>
-/// <param name="data">Data to write to ring buffer.</param>
-/// <param name="length">Length of data to write.</param>
-void Modem::injectP25Frame(const uint8_t* data, uint32_t length)
-{
-#if defined(ENABLE_P25)
-    assert(data != nullptr);
-    assert(length > 0U);
-
-    if (m_trace)
-        Utils::dump(1U, "Injected P25 Data", data, length);
-
-    uint8_t val = length;
-    m_rxP25Queue.addData(&val, 1U);
-
-    val = TAG_DATA;
-    m_rxP25Queue.addData(&val, 1U);
-    val = 0x01U;    // valid sync
-    m_rxP25Queue.addData(&val, 1U);
-
-    m_rxP25Queue.addData(data, length);
-#endif // defined(ENABLE_P25)
+/// <returns></returns>
+DVM_STATE Modem::getState() const
+{
+    return m_modemState;
 }
 
 /// <summary>
-/// Internal helper to inject NXDN frame data as if it came from the air interface modem.
+/// Sets the current operating state for the air interface modem.
 /// </summary>
-/// <param name="data">Data to write to ring buffer.</param>
-/// <param name="length">Length of data to write.</param>
-void Modem::injectNXDNFrame(const uint8_t* data, uint32_t length)
+/// <param name="state"></param>
+/// <returns></returns>
+bool Modem::setState(DVM_STATE state)
 {
-#if defined(ENABLE_NXDN)
-    assert(data != nullptr);
-    assert(length > 0U);
-
-    if (m_trace)
-        Utils::dump(1U, "Injected NXDN Data", data, length);
-
-    uint8_t val = length;
-    m_rxNXDNQueue.addData(&val, 1U);
-
-    val = TAG_DATA;
-    m_rxNXDNQueue.addData(&val, 1U);
-    val = 0x01U;    // valid sync
-    m_rxNXDNQueue.addData(&val, 1U);
+    uint8_t buffer[4U];
 
-    m_rxNXDNQueue.addData(data, length);
-#endif // defined(ENABLE_NXDN)
+    buffer[0U] = DVM_FRAME_START;
+    buffer[1U] = 4U;
+    buffer[2U] = CMD_SET_MODE;
+    buffer[3U] = state;
+#if DEBUG_MODEM
+    Utils::dump(1U, "Modem::setState(), Written", buffer, 4U);
+#endif
+    return write(buffer, 4U) == 4;
 }
 
 /// <summary>
-/// Writes DMR Slot 1 frame data to the DMR Slot 1 ring buffer.
+/// Transmits the given string as CW morse.
 /// </summary>
-/// <param name="data">Data to write to ring buffer.</param>
-/// <param name="length">Length of data to write.</param>
-/// <returns>True, if data is written, otherwise false.</returns>
-bool Modem::writeDMRFrame1(const uint8_t* data, uint32_t length)
+/// <param name="callsign"></param>
+/// <returns></returns>
+bool Modem::sendCWId(const std::string& callsign)
 {
-#if defined(ENABLE_DMR)
-    assert(data != nullptr);
-    assert(length > 0U);
-
-    const uint8_t MAX_LENGTH = 40U;
+    LogDebug(LOG_MODEM, "sending CW ID");
 
-    if (data[0U] != TAG_DATA && data[0U] != TAG_EOT)
-        return false;
-    if (length > MAX_LENGTH) {
-        LogError(LOG_MODEM, "Modem::writeDMRData1(); request data to write >%u?, len = %u", MAX_LENGTH, length);
-        Utils::dump(1U, "Modem::writeDMRData1(); Attmpted Data", data, length);
-        return false;
-    }
+    uint32_t length = (uint32_t)callsign.length();
+    if (length > 200U)
+        length = 200U;
 
-    uint8_t buffer[MAX_LENGTH];
+    uint8_t buffer[205U];
 
     buffer[0U] = DVM_FRAME_START;
-    buffer[1U] = length + 2U;
-    buffer[2U] = CMD_DMR_DATA1;
+    buffer[1U] = length + 3U;
+    buffer[2U] = CMD_SEND_CWID;
 
-    ::memcpy(buffer + 3U, data + 1U, length - 1U);
+    for (uint32_t i = 0U; i < length; i++)
+        buffer[i + 3U] = callsign.at(i);
 
-    uint8_t len = length + 2U;
+    //if (m_trace)
+    //    Utils::dump(1U, "CW ID Data", buffer, length + 3U);
 
-    // write or buffer DMR slot 1 data to air interface
-    if (m_dmrSpace1 >= length) {
-        if (m_debug)
-            LogDebug(LOG_MODEM, "Modem::writeDMRData1(); immediate write (len %u)", length);
-        //if (m_trace)
-        //    Utils::dump(1U, "Immediate TX DMR Data 1", buffer, len);
+    return write(buffer, length + 3U) == int(length + 3U);
+}
 
-        int ret = write(buffer, len);
-        if (ret != int(len)) {
-            LogError(LOG_MODEM, "Error writing DMR slot 1 data");
-            return false;
-        }
+/// <summary>
+/// Returns the protocol version of the connected modem.
+/// </param>
+/// <returns></returns>
+uint8_t Modem::getVersion() const
+{
+    return m_protoVer;
+}
 
-        m_dmrSpace1 -= length;
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Internal helper to warm reset the connection to the modem.
+/// </summary>
+void Modem::reset()
+{
+    m_error = true;
+    m_adcOverFlowCount = 0U;
+    m_dacOverFlowCount = 0U;
+
+    close();
+
+    ::memset(m_buffer, 0x00U, BUFFER_LENGTH);
+
+    Thread::sleep(2000U);        // 2s
+    while (!open()) {
+        Thread::sleep(5000U);    // 5s
+        close();
     }
-    else {
-        return false;
+
+    // open() talks to the modem synchronously; only hand the port back to the I/O thread afterwards
+    if (m_ioThread != nullptr) {
+        std::lock_guard<std::mutex> lock(m_txLock);
+        m_ioThread->run();
     }
 
-    return true;
-#else
-    return false;
-#endif // defined(ENABLE_DMR)
+    // reset modem to last state
+    setState(m_modemState);
 }
 
 /// <summary>
-/// Writes DMR Slot 2 frame data to the DMR Slot 2 ring buffer.
+/// Retrieve the air interface modem version.
 /// </summary>
-/// <param name="data">Data to write to ring buffer.</param>
-/// <param name="length">Length of data to write.</param>
-/// <returns>True, if data is written, otherwise false.</returns>
-bool Modem::writeDMRFrame2(const uint8_t* data, uint32_t length)
+/// <returns></returns>
+bool Modem::getFirmwareVersion()
 {
-#if defined(ENABLE_DMR)
-    assert(data != nullptr);
-    assert(length > 0U);
+    Thread::sleep(2000U);    // 2s
 
-    const uint8_t MAX_LENGTH = 40U;
+    for (uint32_t i = 0U; i < 6U; i++) {
+        uint8_t buffer[3U];
 
-    if (data[0U] != TAG_DATA && data[0U] != TAG_EOT)
-        return false;
-    if (length > MAX_LENGTH) {
-        LogError(LOG_MODEM, "Modem::writeDMRData2(); request data to write >%u?, len = %u", MAX_LENGTH, length);
-        Utils::dump(1U, "Modem::writeDMRData2(); Attmpted Data", data, length);
-        return false;
-    }
+        buffer[0U] = DVM_FRAME_START;
+        buffer[1U] = 3U;
+        buffer[2U] = CMD_GET_VERSION;
 
-    uint8_t buffer[MAX_LENGTH];
+        int ret = write(buffer, 3U);
+        if (ret != 3)
+            return false;
 
-    buffer[0U] = DVM_FRAME_START;
-    buffer[1U] = length + 2U;
-    buffer[2U] = CMD_DMR_DATA2;
+        for (uint32_t count = 0U; count < MAX_RESPONSES; count++) {
+            Thread::sleep(10U);
+            RESP_TYPE_DVM resp = getResponse(true);
 
-    ::memcpy(buffer + 3U, data + 1U, length - 1U);
+            if (resp == RTM_ERROR)
+                continue;
 
-    uint8_t len = length + 2U;
+            if (resp == RTM_OK && m_buffer[2U] == CMD_GET_VERSION) {
+                LogMessage(LOG_MODEM, "Protocol: %02x, CPU: %02X", m_buffer[3U], m_buffer[4U]);
+                m_protoVer = m_buffer[3U];
 
-    // write or buffer DMR slot 2 data to air interface
-    if (m_dmrSpace2 >= length) {
-        if (m_debug)
-            LogDebug(LOG_MODEM, "Modem::writeDMRData2(); immediate write (len %u)", length);
-        //if (m_trace)
-        //    Utils::dump(1U, "Immediate TX DMR Data 2", buffer, len);
+                if (m_protoVer >= 2U) {
+                    LogInfoEx(LOG_MODEM, MODEM_VERSION_STR, m_length - 21U, m_buffer + 21U, m_protoVer);
+                    if (m_protoVer < 3U) {
+                        LogWarning(LOG_MODEM, "Legacy firmware detected; this version of the firmware will not support NXDN or any future enhancments.");
+                    }
 
-        int ret = write(buffer, len);
-        if (ret != int(len)) {
-            LogError(LOG_MODEM, "Error writing DMR slot 2 data");
-            return false;
+                    switch (m_buffer[4U]) {
+                    case 0U:
+                        LogMessage(LOG_MODEM, "Atmel ARM, UDID: %02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X", m_buffer[5U], m_buffer[6U], m_buffer[7U], m_buffer[8U], m_buffer[9U], m_buffer[10U], m_buffer[11U], m_buffer[12U], m_buffer[13U], m_buffer[14U], m_buffer[15U], m_buffer[16U], m_buffer[17U], m_buffer[18U], m_buffer[19U], m_buffer[20U]);
+                        break;
+                    case 1U:
+                        LogMessage(LOG_MODEM, "NXP ARM, UDID: %02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X", m_buffer[5U], m_buffer[6U], m_buffer[7U], m_buffer[8U], m_buffer[9U], m_buffer[10U], m_buffer[11U], m_buffer[12U], m_buffer[13U], m_buffer[14U], m_buffer[15U], m_buffer[16U], m_buffer[17U], m_buffer[18U], m_buffer[19U], m_buffer[20U]);
+                        break;
+                    case 2U:
+                        LogMessage(LOG_MODEM, "ST-Micro ARM, UDID: %02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X", m_buffer[5U], m_buffer[6U], m_buffer[7U], m_buffer[8U], m_buffer[9U], m_buffer[10U], m_buffer[11U], m_buffer[12U], m_buffer[13U], m_buffer[14U], m_buffer[15U], m_buffer[16U]);
+                        break;
+                    case 15U:
+                        LogMessage(LOG_MODEM, "Null Modem, UDID: N/A");
+                        break;
+                    default:
+                        LogMessage(LOG_MODEM, "Unknown CPU type: %u", m_buffer[4U]);
+                        break;
+                    }
+
+                    return true;
+                }
+                else {
+                    LogError(LOG_MODEM, MODEM_UNSUPPORTED_STR, m_protoVer);
+                    return false;
+                }
+            }
         }
 
-        m_dmrSpace2 -= length;
-    }
-    else {
-        return false;
+        Thread::sleep(1500U);
     }
 
-    return true;
-#else
+    LogError(LOG_MODEM, "Unable to read the firmware version after 6 attempts");
+
     return false;
-#endif // defined(ENABLE_DMR)
 }
 
 /// <summary>
-/// Writes P25 frame data to the P25 ring buffer.
+/// Retrieve the current status from the air interface modem.
 /// </summary>
-/// <param name="data">Data to write to ring buffer.</param>
-/// <param name="length">Length of data to write.</param>
-/// <returns>True, if data is written, otherwise false.</returns>
-bool Modem::writeP25Frame(const uint8_t* data, uint32_t length)
+/// <returns></returns>
+bool Modem::getStatus()
 {
-#if defined(ENABLE_P25)
-    assert(data != nullptr);
-    assert(length > 0U);
-
-    const uint8_t MAX_LENGTH = 250U;
-
-    if (data[0U] != TAG_DATA && data[0U] != TAG_EOT)
-        return false;
-    if (length > MAX_LENGTH) {
-        LogError(LOG_MODEM, "Modem::writeP25Data(); request data to write >%u?, len = %u", MAX_LENGTH, length);
-        Utils::dump(1U, "Modem::writeP25Data(); Attmpted Data", data, length);
-        return false;
-    }
-
-    uint8_t buffer[MAX_LENGTH];
-
-    buffer[0U] = DVM_FRAME_START;
-    buffer[1U] = length + 2U;
-    buffer[2U] = CMD_P25_DATA;
-
-    ::memcpy(buffer + 3U, data + 1U, length - 1U);
-
-    uint8_t len = length + 2U;
-
-    // write or buffer P25 data to air interface
-    if (m_p25Space >= length) {
-        if (m_debug)
-            LogDebug(LOG_MODEM, "Modem::writeP25Data(); immediate write (len %u)", length);
-        //if (m_trace)
-        //    Utils::dump(1U, "Immediate TX P25 Data", buffer, len);
+    uint8_t buffer[3U];
 
-        int ret = write(buffer, len);
-        if (ret != int(len)) {
-            LogError(LOG_MODEM, "Error writing P25 data");
-            return false;
-        }
+    buffer[0U] = DVM_FRAME_START;
+    buffer[1U] = 3U;
+    buffer[2U] = CMD_GET_STATUS;
 
-        m_p25Space -= length;
-    }
-    else {
-        return false;
-    }
+    //LogDebug(LOG_MODEM, "getStatus(), polling modem status");
 
-    return true;
-#else
-    return false;
-#endif // defined(ENABLE_P25)
+    return write(buffer, 3U) == 3;
 }
 
 /// <summary>
-/// Writes NXDN frame data to the NXDN ring buffer.
+/// Write configuration to the air interface modem.
 /// </summary>
-/// <param name="data">Data to write to ring buffer.</param>
-/// <param name="length">Length of data to write.</param>
-/// <returns>True, if data is written, otherwise false.</returns>
-bool Modem::writeNXDNFrame(const uint8_t* data, uint32_t length)
+/// <returns></returns>
+bool Modem::writeConfig()
 {
-#if defined(ENABLE_NXDN)
-    assert(data != nullptr);
-    assert(length > 0U);
+    uint8_t buffer[25U];
+    ::memset(buffer, 0x00U, 25U);
+    uint8_t lengthToWrite = 17U;
 
-    const uint8_t MAX_LENGTH = 250U;
+    buffer[0U] = DVM_FRAME_START;
+    buffer[2U] = CMD_SET_CONFIG;
 
-    if (data[0U] != TAG_DATA && data[0U] != TAG_EOT)
-        return false;
-    if (length > MAX_LENGTH) {
-        LogError(LOG_MODEM, "Modem::writeNXDNData(); request data to write >%u?, len = %u", MAX_LENGTH, length);
-        Utils::dump(1U, "Modem::writeNXDNData(); Attmpted Data", data, length);
-        return false;
+    buffer[3U] = 0x00U;
+    if (m_rxInvert)
+        buffer[3U] |= 0x01U;
+    if (m_txInvert)
+        buffer[3U] |= 0x02U;
+    if (m_pttInvert)
+        buffer[3U] |= 0x04U;
+    if (m_debug)
+        buffer[3U] |= 0x10U;
+    if (!m_duplex)
+        buffer[3U] |= 0x80U;
+
+    buffer[4U] = 0x00U;
+    if (m_dcBlocker)
+        buffer[4U] |= 0x01U;
+    if (m_cosLockout)
+        buffer[4U] |= 0x04U;
+
+#if defined(ENABLE_DMR)
+    if (m_dmrEnabled)
+        buffer[4U] |= 0x02U;
+#endif // defined(ENABLE_DMR)
+#if defined(ENABLE_P25)
+    if (m_p25Enabled)
+        buffer[4U] |= 0x08U;
+#endif // defined(ENABLE_P25)
+
+    if (m_fdmaPreamble > MAX_FDMA_PREAMBLE) {
+        LogWarning(LOG_P25, "oversized FDMA preamble count, reducing to maximum %u", MAX_FDMA_PREAMBLE);
+        m_fdmaPreamble = MAX_FDMA_PREAMBLE;
     }
 
-    uint8_t buffer[MAX_LENGTH];
+    buffer[5U] = m_fdmaPreamble;
 
-    buffer[0U] = DVM_FRAME_START;
-    buffer[1U] = length + 2U;
-    buffer[2U] = CMD_NXDN_DATA;
+    buffer[6U] = STATE_IDLE;
 
-    ::memcpy(buffer + 3U, data + 1U, length - 1U);
+    buffer[7U] = (uint8_t)(m_rxLevel * 2.55F + 0.5F);
 
-    uint8_t len = length + 2U;
+    buffer[8U] = (uint8_t)(m_cwIdTXLevel * 2.55F + 0.5F);
 
-    // write or buffer NXDN data to air interface
-    if (m_nxdnSpace >= length) {
-        if (m_debug)
-            LogDebug(LOG_MODEM, "Modem::writeNXDNData(); immediate write (len %u)", length);
-        //if (m_trace)
-        //    Utils::dump(1U, "Immediate TX NXDN Data", buffer, len);
+    buffer[9U] = m_dmrColorCode;
 
-        int ret = write(buffer, len);
-        if (ret != int(len)) {
-            LogError(LOG_MODEM, "Error writing NXDN data");
-            return false;
-        }
+    buffer[10U] = m_dmrRxDelay;
 
-        m_nxdnSpace -= length;
-    }
-    else {
-        return false;
-    }
+    buffer[11U] = (m_p25NAC >> 4) & 0xFFU;
+    buffer[12U] = (m_p25NAC << 4) & 0xF0U;
 
-    return true;
-#else
-    return false;
-#endif // defined(ENABLE_NXDN)
-}
+    buffer[13U] = (uint8_t)(m_dmrTXLevel * 2.55F + 0.5F);
+    buffer[15U] = (uint8_t)(m_p25TXLevel * 2.55F + 0.5F);
 
-/// <summary>
-/// Triggers the start of DMR transmit.
-/// </summary>
-/// <param name="tx"></param>
-/// <returns>True, if DMR transmit started, otherwise false.</returns>
-bool Modem::writeDMRStart(bool tx)
-{
-#if defined(ENABLE_DMR)
-    if (tx && m_tx)
-        return true;
-    if (!tx && !m_tx)
-        return true;
+    buffer[16U] = (uint8_t)(m_txDCOffset + 128);
+    buffer[17U] = (uint8_t)(m_rxDCOffset + 128);
 
-    uint8_t buffer[4U];
+    buffer[14U] = m_p25CorrCount;
 
-    buffer[0U] = DVM_FRAME_START;
-    buffer[1U] = 4U;
-    buffer[2U] = CMD_DMR_START;
-    buffer[3U] = tx ? 0x01U : 0x00U;
-#if DEBUG_MODEM
-    Utils::dump(1U, "Modem::writeDMRStart(), Written", buffer, 4U);
-#endif
-    return write(buffer, 4U) == 4;
-#else
-    return false;
-#endif // defined(ENABLE_DMR)
-}
+    // are we on a protocol version 3 firmware?
+    if (m_protoVer >= 3U) {
+        lengthToWrite = 24U;
 
-/// <summary>
-/// Writes a DMR short LC to the air interface modem.
-/// </summary>
-/// <param name="lc"></param>
-/// <returns>True, if DMR LC is written, otherwise false.</returns>
-bool Modem::writeDMRShortLC(const uint8_t* lc)
-{
-#if defined(ENABLE_DMR)
-    assert(lc != nullptr);
+#if defined(ENABLE_NXDN)
+        if (m_nxdnEnabled)
+            buffer[4U] |= 0x10U;
+#endif // defined(ENABLE_NXDN)
 
-    uint8_t buffer[12U];
+        buffer[18U] = (uint8_t)(m_nxdnTXLevel * 2.55F + 0.5F);
 
-    buffer[0U] = DVM_FRAME_START;
-    buffer[1U] = 12U;
-    buffer[2U] = CMD_DMR_SHORTLC;
-    buffer[3U] = lc[0U];
-    buffer[4U] = lc[1U];
-    buffer[5U] = lc[2U];
-    buffer[6U] = lc[3U];
-    buffer[7U] = lc[4U];
-    buffer[8U] = lc[5U];
-    buffer[9U] = lc[6U];
-    buffer[10U] = lc[7U];
-    buffer[11U] = lc[8U];
-#if DEBUG_MODEM
-    Utils::dump(1U, "Modem::writeDMRShortLC(), Written", buffer, 12U);
-#endif
-    return write(buffer, 12U) == 12;
-#else
-    return false;
-#endif // defined(ENABLE_DMR)
-}
+        buffer[19U] = m_rxCoarsePot;
+        buffer[20U] = m_rxFinePot;
+        buffer[21U] = m_txCoarsePot;
+        buffer[22U] = m_txFinePot;
+        buffer[23U] = m_rssiCoarsePot;
+        buffer[24U] = m_rssiFinePot;
+    }
 
-/// <summary>
-/// Writes a DMR abort message for the given slot to the air interface modem.
-/// </summary>
-/// <param name="slotNo">DMR slot to write abort for.</param>
-/// <returns>True, if DMR abort is written, otherwise false.</returns>
-bool Modem::writeDMRAbort(uint32_t slotNo)
-{
-#if defined(ENABLE_DMR)
-    uint8_t buffer[4U];
+    buffer[1U] = lengthToWrite;
 
-    buffer[0U] = DVM_FRAME_START;
-    buffer[1U] = 4U;
-    buffer[2U] = CMD_DMR_ABORT;
-    buffer[3U] = slotNo;
 #if DEBUG_MODEM
-    Utils::dump(1U, "Modem::writeDMRAbort(), Written", buffer, 4U);
+    Utils::dump(1U, "Modem::writeConfig(), Written", buffer, lengthToWrite);
 #endif
-    return write(buffer, 4U) == 4;
-#else
-    return false;
-#endif // defined(ENABLE_DMR)
-}
 
-/// <summary>
-/// Sets the ignore flags for setting the CACH Access Type bit on the air interface modem.
-/// </summary>
-/// <param name="slotNo">DMR slot to set ignore CACH AT flag for.</param>
-/// <returns>True, if set flag is written, otherwise false.</returns>
-bool Modem::setDMRIgnoreCACH_AT(uint8_t slotNo)
-{
-#if defined(ENABLE_DMR)
-    uint8_t buffer[4U];
+    int ret = write(buffer, lengthToWrite);
+    if (ret != lengthToWrite)
+        return false;
 
-    buffer[0U] = DVM_FRAME_START;
-    buffer[1U] = 4U;
-    buffer[2U] = CMD_DMR_CACH_AT_CTRL;
-    buffer[3U] = slotNo;
+    uint32_t count = 0U;
+    RESP_TYPE_DVM resp;
+    do {
+        Thread::sleep(10U);
 
-    // are we on a protocol version 3 firmware?
-    if (m_protoVer >= 3U) {
+        resp = getResponse();
+        if (resp == RTM_OK && m_buffer[2U] != CMD_ACK && m_buffer[2U] != CMD_NAK) {
+            count++;
+            if (count >= MAX_RESPONSES) {
+                LogError(LOG_MODEM, "No response, %s command", cmdToString(CMD_SET_CONFIG).c_str());
+                return false;
+            }
+        }
+    } while (resp == RTM_OK && m_buffer[2U] != CMD_ACK && m_buffer[2U] != CMD_NAK);
 #if DEBUG_MODEM
-        Utils::dump(1U, "Modem::setDMRIgnoreCACH_AT(), Written", buffer, 4U);
+    Utils::dump(1U, "Modem::writeConfig(), Response", m_buffer, m_length);
 #endif
-        return write(buffer, 4U) == 4;
-    } else {
-        LogWarning(LOG_MODEM, "Modem::setDMRIgnoreCACH_AT(), ignoring CACH AT for slot %u is not supported on this modem!", slotNo);
+    if (resp == RTM_OK && m_buffer[2U] == CMD_NAK) {
+        LogError(LOG_MODEM, "NAK, %s, command = 0x%02X, reason = %u (%s)", cmdToString(CMD_SET_CONFIG).c_str(), m_buffer[3U], m_buffer[4U], rsnToString(m_buffer[4U]).c_str());
         return false;
     }
-#else
-    return false;
-#endif // defined(ENABLE_DMR)
-}
 
-/// <summary>
-/// Writes raw data to the air interface modem.
-/// </summary>
-/// <param name="data"></param>
-/// <param name="length"></param>
-/// <returns></returns>
-int Modem::write(const uint8_t* data, uint32_t length)
-{
-    return m_port->write(data, length);
+    return true;
 }
 
 /// <summary>
-/// Gets the current operating state for the air interface modem.
+/// Write symbol level adjustments to the air interface modem.
 /// </summary>
-/// <returns></returns>
-DVM_STATE Modem::getState() const
+/// <returns>True, if level adjustments are written, otherwise false.</returns>
+bool Modem::writeSymbolAdjust()
 {
-    return m_modemState;
+    uint8_t buffer[20U];
+    ::memset(buffer, 0x00U, 20U);
+    uint8_t lengthToWrite = 7U;
+
+    buffer[0U] = DVM_FRAME_START;
+    buffer[2U] = CMD_SET_SYMLVLADJ;
+
+    buffer[3U] = (uint8_t)(m_dmrSymLevel3Adj + 128);
+    buffer[4U] = (uint8_t)(m_dmrSymLevel1Adj + 128);
+
+    buffer[5U] = (uint8_t)(m_p25SymLevel3Adj + 128);
+    buffer[6U] = (uint8_t)(m_p25SymLevel1Adj + 128);
+
+    // are we on a protocol version 3 firmware?
+    if (m_protoVer >= 3U) {
+        lengthToWrite = 9U;
+
+        buffer[7U] = (uint8_t)(m_nxdnSymLevel3Adj + 128);
+        buffer[8U] = (uint8_t)(m_nxdnSymLevel1Adj + 128);
+    }
+
+    buffer[1U] = lengthToWrite;
+
+    int ret = write(buffer, lengthToWrite);
+    if (ret <= 0)
+        return false;
+
+    uint32_t count = 0U;
+    RESP_TYPE_DVM resp;
+    do {
+        Thread::sleep(10U);
+
+        resp = getResponse();
+        if (resp == RTM_OK && m_buffer[2U] != CMD_ACK && m_buffer[2U] != CMD_NAK) {
+            count++;
+            if (count >= MAX_RESPONSES) {
+                LogError(LOG_MODEM, "No response, %s command", cmdToString(CMD_SET_SYMLVLADJ).c_str());
+                return false;
+            }
+        }
+    } while (resp == RTM_OK && m_buffer[2U] != CMD_ACK && m_buffer[2U] != CMD_NAK);
+
+    if (resp == RTM_OK && m_buffer[2U] == CMD_NAK) {
+        LogError(LOG_MODEM, "NAK, %s, command = 0x%02X, reason = %u (%s)", cmdToString(CMD_SET_SYMLVLADJ).c_str(), m_buffer[3U], m_buffer[4U], rsnToString(m_buffer[4U]).c_str());
+        return false;
+    }
+
+    return true;
 }
 
 /// <summary>
-/// Sets the current operating state for the air interface modem.
+/// Write RF parameters to the air interface modem.
 /// </summary>
-/// <param name="state"></param>
 /// <returns></returns>
-bool Modem::setState(DVM_STATE state)
+bool Modem::writeRFParams()
 {
-    uint8_t buffer[4U];
+    uint8_t buffer[22U];
+    ::memset(buffer, 0x00U, 22U);
+    uint8_t lengthToWrite = 18U;
 
     buffer[0U] = DVM_FRAME_START;
-    buffer[1U] = 4U;
-    buffer[2U] = CMD_SET_MODE;
-    buffer[3U] = state;
-#if DEBUG_MODEM
-    Utils::dump(1U, "Modem::setState(), Written", buffer, 4U);
-#endif
-    return write(buffer, 4U) == 4;
-}
+    buffer[2U] = CMD_SET_RFPARAMS;
 
-/// <summary>
-/// Transmits the given string as CW morse.
-/// </summary>
-/// <param name="callsign"></param>
-/// <returns></returns>
-bool Modem::sendCWId(const std::string& callsign)
-{
-    LogDebug(LOG_MODEM, "sending CW ID");
+    buffer[3U] = 0x00U;
 
-    uint32_t length = (uint32_t)callsign.length();
-    if (length > 200U)
-        length = 200U;
+    uint32_t rxActualFreq = m_rxFrequency + m_rxTuning;
+    buffer[4U] = (rxActualFreq >> 0) & 0xFFU;
+    buffer[5U] = (rxActualFreq >> 8) & 0xFFU;
+    buffer[6U] = (rxActualFreq >> 16) & 0xFFU;
+    buffer[7U] = (rxActualFreq >> 24) & 0xFFU;
 
-    uint8_t buffer[205U];
+    uint32_t txActualFreq = m_txFrequency + m_txTuning;
+    buffer[8U] = (txActualFreq >> 0) & 0xFFU;
+    buffer[9U] = (txActualFreq >> 8) & 0xFFU;
+    buffer[10U] = (txActualFreq >> 16) & 0xFFU;
+    buffer[11U] = (txActualFreq >> 24) & 0xFFU;
 
-    buffer[0U] = DVM_FRAME_START;
-    buffer[1U] = length + 3U;
-    buffer[2U] = CMD_SEND_CWID;
+    buffer[12U] = (unsigned char)(m_rfPower * 2.55F + 0.5F);
 
-    for (uint32_t i = 0U; i < length; i++)
-        buffer[i + 3U] = callsign.at(i);
+    buffer[13U] = (uint8_t)(m_dmrDiscBWAdj + 128);
+    buffer[14U] = (uint8_t)(m_p25DiscBWAdj + 128);
+    buffer[15U] = (uint8_t)(m_dmrPostBWAdj + 128);
+    buffer[16U] = (uint8_t)(m_p25PostBWAdj + 128);
 
-    //if (m_trace)
-    //    Utils::dump(1U, "CW ID Data", buffer, length + 3U);
+    buffer[17U] = (uint8_t)m_adfGainMode;
 
-    return write(buffer, length + 3U) == int(length + 3U);
-}
+    // are we on a protocol version 3 firmware?
+    if (m_protoVer >= 3U) {
+        lengthToWrite = 22U;
 
-/// <summary>
-/// Returns the protocol version of the connected modem.
-/// </param>
-/// <returns></returns>
-uint8_t Modem::getVersion() const
-{
-    return m_protoVer;
-}
+        buffer[18U] = (uint8_t)(m_nxdnDiscBWAdj + 128);
+        buffer[19U] = (uint8_t)(m_nxdnPostBWAdj + 128);
 
-// ---------------------------------------------------------------------------
-//  Private Class Members
-// ---------------------------------------------------------------------------
+        // support optional AFC parameters
+        buffer[20U] = (m_afcEnable ? 0x80 : 0x00) +
+            (m_afcKP << 4) + (m_afcKI);
+        buffer[21U] = m_afcRange;
+    }
 
-/// <summary>
-/// Internal helper to warm reset the connection to the modem.
-/// </summary>
-void Modem::reset()
-{
-    m_error = true;
-    m_adcOverFlowCount = 0U;
-    m_dacOverFlowCount = 0U;
+    buffer[1U] = lengthToWrite;
 
-    close();
+    int ret = m_port->write(buffer, lengthToWrite);
+    if (ret <= 0)
+        return false;
 
-    ::memset(m_buffer, 0x00U, BUFFER_LENGTH);
+    unsigned int count = 0U;
+    RESP_TYPE_DVM resp;
+    do {
+        Thread::sleep(10U);
 
-    Thread::sleep(2000U);        // 2s
-    while (!open()) {
-        Thread::sleep(5000U);    // 5s
-        close();
+        resp = getResponse();
+        if (resp == RTM_OK && m_buffer[2U] != RSN_OK && m_buffer[2U] != RSN_NAK) {
+            count++;
+            if (count >= MAX_RESPONSES) {
+                LogError(LOG_MODEM, "No response, %s command", cmdToString(CMD_SET_RFPARAMS).c_str());
+                return false;
+            }
+        }
+    } while (resp == RTM_OK && m_buffer[2U] != RSN_OK && m_buffer[2U] != RSN_NAK);
+
+    // CUtils::dump(1U, "Response", m_buffer, m_length);
+
+    if (resp == RTM_OK && m_buffer[2U] == RSN_NAK) {
+        LogError(LOG_MODEM, "NAK, %s, command = 0x%02X, reason = %u (%s)", cmdToString(CMD_SET_RFPARAMS).c_str(), m_buffer[3U], m_buffer[4U], rsnToString(m_buffer[4U]).c_str());
+        return false;
     }
 
-    // reset modem to last state
-    setState(m_modemState);
+    return true;
 }
 
 /// <summary>
-/// Retrieve the air interface modem version.
+/// Retrieve the data from the configuration area on the air interface modem.
 /// </summary>
 /// <returns></returns>
-bool Modem::getFirmwareVersion()
+bool Modem::readFlash()
 {
     Thread::sleep(2000U);    // 2s
 
@@ -1785,7 +1889,7 @@ bool Modem::getFirmwareVersion()
 
         buffer[0U] = DVM_FRAME_START;
         buffer[1U] = 3U;
-        buffer[2U] = CMD_GET_VERSION;
+        buffer[2U] = CMD_FLSH_READ;
 
         int ret = write(buffer, 3U);
         if (ret != 3)
@@ -1798,569 +1902,587 @@ bool Modem::getFirmwareVersion()
             if (resp == RTM_ERROR)
                 continue;
 
-            if (resp == RTM_OK && m_buffer[2U] == CMD_GET_VERSION) {
-                LogMessage(LOG_MODEM, "Protocol: %02x, CPU: %02X", m_buffer[3U], m_buffer[4U]);
-                m_protoVer = m_buffer[3U];
-
-                if (m_protoVer >= 2U) {
-                    LogInfoEx(LOG_MODEM, MODEM_VERSION_STR, m_length - 21U, m_buffer + 21U, m_protoVer);
-                    if (m_protoVer < 3U) {
-                        LogWarning(LOG_MODEM, "Legacy firmware detected; this version of the firmware will not support NXDN or any future enhancments.");
-                    }
-
-                    switch (m_buffer[4U]) {
-                    case 0U:
-                        LogMessage(LOG_MODEM, "Atmel ARM, UDID: %02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X", m_buffer[5U], m_buffer[6U], m_buffer[7U], m_buffer[8U], m_buffer[9U], m_buffer[10U], m_buffer[11U], m_buffer[12U], m_buffer[13U], m_buffer[14U], m_buffer[15U], m_buffer[16U], m_buffer[17U], m_buffer[18U], m_buffer[19U], m_buffer[20U]);
-                        break;
-                    case 1U:
-                        LogMessage(LOG_MODEM, "NXP ARM, UDID: %02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X", m_buffer[5U], m_buffer[6U], m_buffer[7U], m_buffer[8U], m_buffer[9U], m_buffer[10U], m_buffer[11U], m_buffer[12U], m_buffer[13U], m_buffer[14U], m_buffer[15U], m_buffer[16U], m_buffer[17U], m_buffer[18U], m_buffer[19U], m_buffer[20U]);
-                        break;
-                    case 2U:
-                        LogMessage(LOG_MODEM, "ST-Micro ARM, UDID: %02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X", m_buffer[5U], m_buffer[6U], m_buffer[7U], m_buffer[8U], m_buffer[9U], m_buffer[10U], m_buffer[11U], m_buffer[12U], m_buffer[13U], m_buffer[14U], m_buffer[15U], m_buffer[16U]);
-                        break;
-                    case 15U:
-                        LogMessage(LOG_MODEM, "Null Modem, UDID: N/A");
-                        break;
-                    default:
-                        LogMessage(LOG_MODEM, "Unknown CPU type: %u", m_buffer[4U]);
-                        break;
-                    }
-
-                    return true;
-                }
-                else {
-                    LogError(LOG_MODEM, MODEM_UNSUPPORTED_STR, m_protoVer);
-                    return false;
-                }
+            if (resp == RTM_OK && m_buffer[2U] == CMD_NAK) {
+                LogWarning(LOG_MODEM, "%s, old modem that doesn't support flash commands?", cmdToString(CMD_FLSH_READ).c_str());
+                m_flashDisabled = true;
+                return false;
             }
-        }
-
-        Thread::sleep(1500U);
-    }
 
-    LogError(LOG_MODEM, "Unable to read the firmware version after 6 attempts");
+            m_flashDisabled = false;
+            if (resp == RTM_OK && m_buffer[2U] == CMD_FLSH_READ) {
+                uint8_t len = m_buffer[1U];
+                if (m_debug) {
+                    Utils::dump(1U, "Modem Flash Contents", m_buffer + 3U, len - 3U);
+                }
 
-    return false;
-}
+                if (len == 249U) {
+                    bool ret = edac::CRC::checkCCITT162(m_buffer + 3U, DVM_CONF_AREA_LEN);
+                    if (!ret) {
+                        LogWarning(LOG_MODEM, "Modem configuration area does not contain a valid configuration!");
+                    }
+                    else {
+                        bool isErased = (m_buffer[DVM_CONF_AREA_LEN] & 0x80U) == 0x80U;
+                        uint8_t confAreaVersion = m_buffer[DVM_CONF_AREA_LEN] & 0x7FU;
 
-/// <summary>
-/// Retrieve the current status from the air interface modem.
-/// </summary>
-/// <returns></returns>
-bool Modem::getStatus()
-{
-    uint8_t buffer[3U];
+                        if (!isErased) {
+                            if (confAreaVersion != DVM_CONF_AREA_VER) {
+                                LogError(LOG_MODEM, "Invalid version for configuration area, %02X != %02X", DVM_CONF_AREA_VER, confAreaVersion);
+                            }
+                            else {
+                                processFlashConfig(m_buffer);
+                            }
+                        }
+                        else {
+                            LogWarning(LOG_MODEM, "Modem configuration area was erased and does not contain active configuration!");
+                        }
+                    }
+                }
+                else {
+                    LogWarning(LOG_MODEM, "Incorrect length for configuration area! Ignoring.");
+                }
 
-    buffer[0U] = DVM_FRAME_START;
-    buffer[1U] = 3U;
-    buffer[2U] = CMD_GET_STATUS;
+                return true;
+            }
+        }
 
-    //LogDebug(LOG_MODEM, "getStatus(), polling modem status");
+        Thread::sleep(1500U);
+    }
 
-    return write(buffer, 3U) == 3;
+    LogError(LOG_MODEM, "Unable to read the configuration flash after 6 attempts");
+
+    return false;
 }
 
 /// <summary>
-/// Write configuration to the air interface modem.
+/// Process the configuration data from the air interface modem.
 /// </summary>
-/// <returns></returns>
-bool Modem::writeConfig()
+/// <param name="buffer"></param>
+void Modem::processFlashConfig(const uint8_t *buffer)
 {
-    uint8_t buffer[25U];
-    ::memset(buffer, 0x00U, 25U);
-    uint8_t lengthToWrite = 17U;
-
-    buffer[0U] = DVM_FRAME_START;
-    buffer[2U] = CMD_SET_CONFIG;
-
-    buffer[3U] = 0x00U;
-    if (m_rxInvert)
-        buffer[3U] |= 0x01U;
-    if (m_txInvert)
-        buffer[3U] |= 0x02U;
-    if (m_pttInvert)
-        buffer[3U] |= 0x04U;
-    if (m_debug)
-        buffer[3U] |= 0x10U;
-    if (!m_duplex)
-        buffer[3U] |= 0x80U;
-
-    buffer[4U] = 0x00U;
-    if (m_dcBlocker)
-        buffer[4U] |= 0x01U;
-    if (m_cosLockout)
-        buffer[4U] |= 0x04U;
-
-#if defined(ENABLE_DMR)
-    if (m_dmrEnabled)
-        buffer[4U] |= 0x02U;
-#endif // defined(ENABLE_DMR)
-#if defined(ENABLE_P25)
-    if (m_p25Enabled)
-        buffer[4U] |= 0x08U;
-#endif // defined(ENABLE_P25)
-
-    if (m_fdmaPreamble > MAX_FDMA_PREAMBLE) {
-        LogWarning(LOG_P25, "oversized FDMA preamble count, reducing to maximum %u", MAX_FDMA_PREAMBLE);
-        m_fdmaPreamble = MAX_FDMA_PREAMBLE;
+    if (m_ignoreModemConfigArea) {
+        LogMessage(LOG_MODEM, "Modem configuration area checking is disabled!");
+        return;
     }
 
-    buffer[5U] = m_fdmaPreamble;
+    // general config
+    bool rxInvert = (buffer[3U] & 0x01U) == 0x01U;
+    FLASH_VALUE_CHECK(m_rxInvert, rxInvert, false, "rxInvert");
+    bool txInvert = (buffer[3U] & 0x02U) == 0x02U;
+    FLASH_VALUE_CHECK(m_txInvert, txInvert, false, "txInvert");
+    bool pttInvert = (buffer[3U] & 0x04U) == 0x04U;
+    FLASH_VALUE_CHECK(m_pttInvert, pttInvert, false, "pttInvert");
 
-    buffer[6U] = STATE_IDLE;
+    bool dcBlocker = (buffer[4U] & 0x01U) == 0x01U;
+    FLASH_VALUE_CHECK(m_dcBlocker, dcBlocker, true, "dcBlocker");
 
-    buffer[7U] = (uint8_t)(m_rxLevel * 2.55F + 0.5F);
+    uint8_t fdmaPreamble = buffer[5U];
+    FLASH_VALUE_CHECK(m_fdmaPreamble, fdmaPreamble, 80U, "fdmaPreamble");
 
-    buffer[8U] = (uint8_t)(m_cwIdTXLevel * 2.55F + 0.5F);
+    // levels
+    float rxLevel = (float(buffer[7U]) - 0.5F) / 2.55F;
+    FLASH_VALUE_CHECK_FLOAT(m_rxLevel, rxLevel, 50.0F, "rxLevel");
 
-    buffer[9U] = m_dmrColorCode;
+    float txLevel = (float(buffer[8U]) - 0.5F) / 2.55F;
+    FLASH_VALUE_CHECK_FLOAT(m_cwIdTXLevel, txLevel, 50.0F, "cwIdTxLevel");
+    FLASH_VALUE_CHECK_FLOAT(m_dmrTXLevel, txLevel, 50.0F, "dmrTxLevel");
+    FLASH_VALUE_CHECK_FLOAT(m_p25TXLevel, txLevel, 50.0F, "p25TxLevel");
+    FLASH_VALUE_CHECK_FLOAT(m_nxdnTXLevel, txLevel, 50.0F, "nxdnTxLevel");
 
-    buffer[10U] = m_dmrRxDelay;
+    uint8_t dmrRxDelay = buffer[10U];
+    FLASH_VALUE_CHECK(m_dmrRxDelay, dmrRxDelay, 7U, "dmrRxDelay");
 
-    buffer[11U] = (m_p25NAC >> 4) & 0xFFU;
-    buffer[12U] = (m_p25NAC << 4) & 0xF0U;
+    uint8_t p25CorrCount = buffer[11U];
+    FLASH_VALUE_CHECK(m_p25CorrCount, p25CorrCount, 8U, "p25CorrCount");
 
-    buffer[13U] = (uint8_t)(m_dmrTXLevel * 2.55F + 0.5F);
-    buffer[15U] = (uint8_t)(m_p25TXLevel * 2.55F + 0.5F);
+    int txDCOffset = int(buffer[16U]) - 128;
+    FLASH_VALUE_CHECK(m_txDCOffset, txDCOffset, 0, "txDCOffset");
 
-    buffer[16U] = (uint8_t)(m_txDCOffset + 128);
-    buffer[17U] = (uint8_t)(m_rxDCOffset + 128);
+    int rxDCOffset = int(buffer[17U]) - 128;
+    FLASH_VALUE_CHECK(m_rxDCOffset, rxDCOffset, 0, "rxDCOffset");
 
-    buffer[14U] = m_p25CorrCount;
+    // RF parameters
+    int8_t dmrDiscBWAdj = int8_t(buffer[20U]) - 128;
+    FLASH_VALUE_CHECK(m_dmrDiscBWAdj, dmrDiscBWAdj, 0, "dmrDiscBWAdj");
+    int8_t p25DiscBWAdj = int8_t(buffer[21U]) - 128;
+    FLASH_VALUE_CHECK(m_p25DiscBWAdj, p25DiscBWAdj, 0, "p25DiscBWAdj");
+    int8_t dmrPostBWAdj = int8_t(buffer[22U]) - 128;
+    FLASH_VALUE_CHECK(m_dmrPostBWAdj, dmrPostBWAdj, 0, "dmrPostBWAdj");
+    int8_t p25PostBWAdj = int8_t(buffer[23U]) - 128;
+    FLASH_VALUE_CHECK(m_p25PostBWAdj, p25PostBWAdj, 0, "p25PostBWAdj");
 
     // are we on a protocol version 3 firmware?
     if (m_protoVer >= 3U) {
-        lengthToWrite = 24U;
+        int8_t nxdnDiscBWAdj = int8_t(buffer[39U]) - 128;
+        FLASH_VALUE_CHECK(m_nxdnDiscBWAdj, nxdnDiscBWAdj, 0, "nxdnDiscBWAdj");
+        int8_t nxdnPostBWAdj = int8_t(buffer[40U]) - 128;
+        FLASH_VALUE_CHECK(m_nxdnPostBWAdj, nxdnPostBWAdj, 0, "nxdnPostBWAdj");
+    }
 
-#if defined(ENABLE_NXDN)
-        if (m_nxdnEnabled)
-            buffer[4U] |= 0x10U;
-#endif // defined(ENABLE_NXDN)
+    ADF_GAIN_MODE adfGainMode = (ADF_GAIN_MODE)buffer[24U];
+    FLASH_VALUE_CHECK(m_adfGainMode, adfGainMode, ADF_GAIN_AUTO, "adfGainMode");
 
-        buffer[18U] = (uint8_t)(m_nxdnTXLevel * 2.55F + 0.5F);
+    uint32_t txTuningRaw = __GET_UINT32(buffer, 25U);
+    int txTuning = int(txTuningRaw);
+    FLASH_VALUE_CHECK(m_txTuning, txTuning, 0, "txTuning");
+    uint32_t rxTuningRaw = __GET_UINT32(buffer, 29U);
+    int rxTuning = int(rxTuningRaw);
+    FLASH_VALUE_CHECK(m_rxTuning, rxTuning, 0, "rxTuning");
 
-        buffer[19U] = m_rxCoarsePot;
-        buffer[20U] = m_rxFinePot;
-        buffer[21U] = m_txCoarsePot;
-        buffer[22U] = m_txFinePot;
-        buffer[23U] = m_rssiCoarsePot;
-        buffer[24U] = m_rssiFinePot;
-    }
+    // symbol adjust
+    int dmrSymLevel3Adj = int(buffer[35U]) - 128;
+    FLASH_VALUE_CHECK(m_dmrSymLevel3Adj, dmrSymLevel3Adj, 0, "dmrSymLevel3Adj");
+    int dmrSymLevel1Adj = int(buffer[36U]) - 128;
+    FLASH_VALUE_CHECK(m_dmrSymLevel1Adj, dmrSymLevel1Adj, 0, "dmrSymLevel1Adj");
 
-    buffer[1U] = lengthToWrite;
+    int p25SymLevel3Adj = int(buffer[37U]) - 128;
+    FLASH_VALUE_CHECK(m_p25SymLevel3Adj, p25SymLevel3Adj, 0, "p25SymLevel3Adj");
+    int p25SymLevel1Adj = int(buffer[38U]) - 128;
+    FLASH_VALUE_CHECK(m_p25SymLevel1Adj, p25SymLevel1Adj, 0, "p25SymLevel1Adj");
 
-#if DEBUG_MODEM
-    Utils::dump(1U, "Modem::writeConfig(), Written", buffer, lengthToWrite);
-#endif
+    // are we on a protocol version 3 firmware?
+    if (m_protoVer >= 3U) {
+        int nxdnSymLevel3Adj = int(buffer[41U]) - 128;
+        FLASH_VALUE_CHECK(m_nxdnSymLevel3Adj, nxdnSymLevel3Adj, 0, "nxdnSymLevel3Adj");
+        int nxdnSymLevel1Adj = int(buffer[42U]) - 128;
+        FLASH_VALUE_CHECK(m_nxdnSymLevel1Adj, nxdnSymLevel1Adj, 0, "nxdnSymLevel1Adj");
+    }
 
-    int ret = write(buffer, lengthToWrite);
-    if (ret != lengthToWrite)
-        return false;
+    // are we on a protocol version 3 firmware?
+    if (m_protoVer >= 3U) {
+        uint8_t rxCoarse = buffer[43U];
+        FLASH_VALUE_CHECK(m_rxCoarsePot, rxCoarse, 7U, "rxCoarse");
+        uint8_t rxFine = buffer[44U];
+        FLASH_VALUE_CHECK(m_rxFinePot, rxFine, 7U, "rxFine");
 
-    uint32_t count = 0U;
-    RESP_TYPE_DVM resp;
-    do {
-        Thread::sleep(10U);
+        uint8_t txCoarse = buffer[45U];
+        FLASH_VALUE_CHECK(m_txCoarsePot, txCoarse, 7U, "txCoarse");
+        uint8_t txFine = buffer[46U];
+        FLASH_VALUE_CHECK(m_txFinePot, txFine, 7U, "txFine");
 
-        resp = getResponse();
-        if (resp == RTM_OK && m_buffer[2U] != CMD_ACK && m_buffer[2U] != CMD_NAK) {
-            count++;
-            if (count >= MAX_RESPONSES) {
-                LogError(LOG_MODEM, "No response, %s command", cmdToString(CMD_SET_CONFIG).c_str());
-                return false;
-            }
-        }
-    } while (resp == RTM_OK && m_buffer[2U] != CMD_ACK && m_buffer[2U] != CMD_NAK);
-#if DEBUG_MODEM
-    Utils::dump(1U, "Modem::writeConfig(), Response", m_buffer, m_length);
-#endif
-    if (resp == RTM_OK && m_buffer[2U] == CMD_NAK) {
-        LogError(LOG_MODEM, "NAK, %s, command = 0x%02X, reason = %u (%s)", cmdToString(CMD_SET_CONFIG).c_str(), m_buffer[3U], m_buffer[4U], rsnToString(m_buffer[4U]).c_str());
-        return false;
+        uint8_t rssiCoarse = buffer[47U];
+        FLASH_VALUE_CHECK(m_rssiCoarsePot, rssiCoarse, 7U, "rssiCoarse");
+        uint8_t rssiFine = buffer[48U];
+        FLASH_VALUE_CHECK(m_rssiFinePot, rssiFine, 7U, "rssiFine");
     }
-
-    return true;
 }
 
 /// <summary>
-/// Write symbol level adjustments to the air interface modem.
+/// Print debug air interface messages to the host log.
 /// </summary>
-/// <returns>True, if level adjustments are written, otherwise false.</returns>
-bool Modem::writeSymbolAdjust()
+/// <param name="buffer"></param>
+/// <param name="len"></param>
+/// <param name="doubleLength"></param>
+void Modem::printDebug(const uint8_t* buffer, uint16_t len, bool doubleLength)
 {
-    uint8_t buffer[20U];
-    ::memset(buffer, 0x00U, 20U);
-    uint8_t lengthToWrite = 7U;
-
-    buffer[0U] = DVM_FRAME_START;
-    buffer[2U] = CMD_SET_SYMLVLADJ;
-
-    buffer[3U] = (uint8_t)(m_dmrSymLevel3Adj + 128);
-    buffer[4U] = (uint8_t)(m_dmrSymLevel1Adj + 128);
+    if (doubleLength && buffer[3U] == CMD_DEBUG_DUMP) {
+        uint8_t data[512U];
+        ::memset(data, 0x00U, 512U);
+        ::memcpy(data, buffer, len);
 
-    buffer[5U] = (uint8_t)(m_p25SymLevel3Adj + 128);
-    buffer[6U] = (uint8_t)(m_p25SymLevel1Adj + 128);
+        Utils::dump(1U, "Modem Debug Dump", data, len);
+        return;
+    }
+    else {
+        if (doubleLength) {
+            LogError(LOG_MODEM, "Invalid debug data received from the modem, len = %u", len);
+            return;
+        }
+    }
 
-    // are we on a protocol version 3 firmware?
-    if (m_protoVer >= 3U) {
-        lengthToWrite = 9U;
+    if (buffer[2U] == CMD_DEBUG1) {
+        LogDebug(LOG_MODEM, "M: %.*s", len - 3U, buffer + 3U);
+    }
+    else if (buffer[2U] == CMD_DEBUG2) {
+        short val1 = (buffer[len - 2U] << 8) | buffer[len - 1U];
+        LogDebug(LOG_MODEM, "M: %.*s %X", len - 5U, buffer + 3U, val1);
+    }
+    else if (buffer[2U] == CMD_DEBUG3) {
+        short val1 = (buffer[len - 4U] << 8) | buffer[len - 3U];
+        short val2 = (buffer[len - 2U] << 8) | buffer[len - 1U];
+        LogDebug(LOG_MODEM, "M: %.*s %X %X", len - 7U, buffer + 3U, val1, val2);
+    }
+    else if (buffer[2U] == CMD_DEBUG4) {
+        short val1 = (buffer[len - 6U] << 8) | buffer[len - 5U];
+        short val2 = (buffer[len - 4U] << 8) | buffer[len - 3U];
+        short val3 = (buffer[len - 2U] << 8) | buffer[len - 1U];
+        LogDebug(LOG_MODEM, "M: %.*s %X %X %X", len - 9U, buffer + 3U, val1, val2, val3);
+    }
+    else if (buffer[2U] == CMD_DEBUG5) {
+        short val1 = (buffer[len - 8U] << 8) | buffer[len - 7U];
+        short val2 = (buffer[len - 6U] << 8) | buffer[len - 5U];
+        short val3 = (buffer[len - 4U] << 8) | buffer[len - 3U];
+        short val4 = (buffer[len - 2U] << 8) | buffer[len - 1U];
+        LogDebug(LOG_MODEM, "M: %.*s %X %X %X %X", len - 11U, buffer + 3U, val1, val2, val3, val4);
+    }
+    else if (buffer[2U] == CMD_DEBUG_DUMP) {
+        uint8_t data[255U];
+        ::memset(data, 0x00U, 255U);
+        ::memcpy(data, buffer, len);
 
-        buffer[7U] = (uint8_t)(m_nxdnSymLevel3Adj + 128);
-        buffer[8U] = (uint8_t)(m_nxdnSymLevel1Adj + 128);
+        Utils::dump(1U, "Modem Debug Dump", data, len);
     }
+}
 
-    buffer[1U] = lengthToWrite;
-
-    int ret = write(buffer, lengthToWrite);
-    if (ret <= 0)
-        return false;
-
-    uint32_t count = 0U;
-    RESP_TYPE_DVM resp;
-    do {
-        Thread::sleep(10U);
+/// <summary>
+/// Helper to process a response packet from the modem.
+/// </summary>
+/// <param name="ms"></param>
+/// <param name="type">Response type from modem.</param>
+/// <param name="buffer">Response packet.</param>
+/// <param name="length">Length of response packet.</param>
+/// <param name="doubleLength">Flag indicating the response packet uses a double length header.</param>
+void Modem::processResponse(uint32_t ms, RESP_TYPE_DVM type, const uint8_t* buffer, uint16_t length, bool doubleLength)
+{
+    bool forceModemReset = false;
 
-        resp = getResponse();
-        if (resp == RTM_OK && m_buffer[2U] != CMD_ACK && m_buffer[2U] != CMD_NAK) {
-            count++;
-            if (count >= MAX_RESPONSES) {
-                LogError(LOG_MODEM, "No response, %s command", cmdToString(CMD_SET_SYMLVLADJ).c_str());
-                return false;
-            }
+    // do we have a custom response handler?
+    if (m_rspHandler != nullptr) {
+        // execute custom response handler
+        if (m_rspHandler(this, ms, type, doubleLength, buffer, length)) {
+            // all logic handled by handler -- return
+            return;
         }
-    } while (resp == RTM_OK && m_buffer[2U] != CMD_ACK && m_buffer[2U] != CMD_NAK);
-
-    if (resp == RTM_OK && m_buffer[2U] == CMD_NAK) {
-        LogError(LOG_MODEM, "NAK, %s, command = 0x%02X, reason = %u (%s)", cmdToString(CMD_SET_SYMLVLADJ).c_str(), m_buffer[3U], m_buffer[4U], rsnToString(m_buffer[4U]).c_str());
-        return false;
     }
 
-    return true;
-}
+    if (type == RTM_TIMEOUT) {
+        // Nothing to do
+    }
+    else if (type == RTM_ERROR) {
+        // Nothing to do
+    }
+    else {
+        // type == RTM_OK
+        switch (buffer[2U]) {
+        /** Digital Mobile Radio */
+        case CMD_DMR_DATA1:
+        {
+#if defined(ENABLE_DMR)
+            //if (m_trace)
+            //    Utils::dump(1U, "RX DMR Data 1", buffer, length);
 
-/// <summary>
-/// Write RF parameters to the air interface modem.
-/// </summary>
-/// <returns></returns>
-bool Modem::writeRFParams()
-{
-    uint8_t buffer[22U];
-    ::memset(buffer, 0x00U, 22U);
-    uint8_t lengthToWrite = 18U;
+            if (doubleLength) {
+                LogError(LOG_MODEM, "CMD_DMR_DATA1 double length?; len = %u", length);
+                break;
+            }
 
-    buffer[0U] = DVM_FRAME_START;
-    buffer[2U] = CMD_SET_RFPARAMS;
+            uint8_t data = length - 2U;
+            m_rxDMRQueue1.addData(&data, 1U);
 
-    buffer[3U] = 0x00U;
+            if (buffer[3U] == (dmr::DMR_SYNC_DATA | dmr::DT_TERMINATOR_WITH_LC))
+                data = TAG_EOT;
+            else
+                data = TAG_DATA;
+            m_rxDMRQueue1.addData(&data, 1U);
 
-    uint32_t rxActualFreq = m_rxFrequency + m_rxTuning;
-    buffer[4U] = (rxActualFreq >> 0) & 0xFFU;
-    buffer[5U] = (rxActualFreq >> 8) & 0xFFU;
-    buffer[6U] = (rxActualFreq >> 16) & 0xFFU;
-    buffer[7U] = (rxActualFreq >> 24) & 0xFFU;
+            m_rxDMRQueue1.addData(buffer + 3U, length - 3U);
+#endif // defined(ENABLE_DMR)
+        }
+        break;
 
-    uint32_t txActualFreq = m_txFrequency + m_txTuning;
-    buffer[8U] = (txActualFreq >> 0) & 0xFFU;
-    buffer[9U] = (txActualFreq >> 8) & 0xFFU;
-    buffer[10U] = (txActualFreq >> 16) & 0xFFU;
-    buffer[11U] = (txActualFreq >> 24) & 0xFFU;
+        case CMD_DMR_DATA2:
+        {
+#if defined(ENABLE_DMR)
+            //if (m_trace)
+            //    Utils::dump(1U, "RX DMR Data 2", buffer, length);
 
-    buffer[12U] = (unsigned char)(m_rfPower * 2.55F + 0.5F);
+            if (doubleLength) {
+                LogError(LOG_MODEM, "CMD_DMR_DATA2 double length?; len = %u", length);
+                break;
+            }
 
-    buffer[13U] = (uint8_t)(m_dmrDiscBWAdj + 128);
-    buffer[14U] = (uint8_t)(m_p25DiscBWAdj + 128);
-    buffer[15U] = (uint8_t)(m_dmrPostBWAdj + 128);
-    buffer[16U] = (uint8_t)(m_p25PostBWAdj + 128);
+            uint8_t data = length - 2U;
+            m_rxDMRQueue2.addData(&data, 1U);
 
-    buffer[17U] = (uint8_t)m_adfGainMode;
+            if (buffer[3U] == (dmr::DMR_SYNC_DATA | dmr::DT_TERMINATOR_WITH_LC))
+                data = TAG_EOT;
+            else
+                data = TAG_DATA;
+            m_rxDMRQueue2.addData(&data, 1U);
 
-    // are we on a protocol version 3 firmware?
-    if (m_protoVer >= 3U) {
-        lengthToWrite = 22U;
+            m_rxDMRQueue2.addData(buffer + 3U, length - 3U);
+#endif // defined(ENABLE_DMR)
+        }
+        break;
 
-        buffer[18U] = (uint8_t)(m_nxdnDiscBWAdj + 128);
-        buffer[19U] = (uint8_t)(m_nxdnPostBWAdj + 128);
+        case CMD_DMR_LOST1:
+        {
+#if defined(ENABLE_DMR)
+            //if (m_trace)
+            //    Utils::dump(1U, "RX DMR Lost 1", buffer, length);
 
-        // support optional AFC parameters
-        buffer[20U] = (m_afcEnable ? 0x80 : 0x00) +
-            (m_afcKP << 4) + (m_afcKI);
-        buffer[21U] = m_afcRange;
-    }
+            if (doubleLength) {
+                LogError(LOG_MODEM, "CMD_DMR_LOST1 double length?; len = %u", length);
+                break;
+            }
 
-    buffer[1U] = lengthToWrite;
+            uint8_t data = 1U;
+            m_rxDMRQueue1.addData(&data, 1U);
 
-    int ret = m_port->write(buffer, lengthToWrite);
-    if (ret <= 0)
-        return false;
+            data = TAG_LOST;
+            m_rxDMRQueue1.addData(&data, 1U);
+#endif // defined(ENABLE_DMR)
+        }
+        break;
 
-    unsigned int count = 0U;
-    RESP_TYPE_DVM resp;
-    do {
-        Thread::sleep(10U);
+        case CMD_DMR_LOST2:
+        {
+#if defined(ENABLE_DMR)
+            //if (m_trace)
+            //    Utils::dump(1U, "RX DMR Lost 2", buffer, length);
 
-        resp = getResponse();
-        if (resp == RTM_OK && m_buffer[2U] != RSN_OK && m_buffer[2U] != RSN_NAK) {
-            count++;
-            if (count >= MAX_RESPONSES) {
-                LogError(LOG_MODEM, "No response, %s command", cmdToString(CMD_SET_RFPARAMS).c_str());
-                return false;
+            if (doubleLength) {
+                LogError(LOG_MODEM, "CMD_DMR_LOST2 double length?; len = %u", length);
+                break;
             }
+
+            uint8_t data = 1U;
+            m_rxDMRQueue2.addData(&data, 1U);
+
+            data = TAG_LOST;
+            m_rxDMRQueue2.addData(&data, 1U);
+#endif // defined(ENABLE_DMR)
         }
-    } while (resp == RTM_OK && m_buffer[2U] != RSN_OK && m_buffer[2U] != RSN_NAK);
+        break;
 
-    // CUtils::dump(1U, "Response", m_buffer, m_length);
+        /** Project 25 */
+        case CMD_P25_DATA:
+        {
+#if defined(ENABLE_P25)
+            //if (m_trace)
+            //    Utils::dump(1U, "RX P25 Data", buffer, length);
 
-    if (resp == RTM_OK && m_buffer[2U] == RSN_NAK) {
-        LogError(LOG_MODEM, "NAK, %s, command = 0x%02X, reason = %u (%s)", cmdToString(CMD_SET_RFPARAMS).c_str(), m_buffer[3U], m_buffer[4U], rsnToString(m_buffer[4U]).c_str());
-        return false;
-    }
+            if (doubleLength) {
+                LogError(LOG_MODEM, "CMD_P25_DATA double length?; len = %u", length);
+                break;
+            }
 
-    return true;
-}
+            uint8_t data = length - 2U;
+            m_rxP25Queue.addData(&data, 1U);
 
-/// <summary>
-/// Retrieve the data from the configuration area on the air interface modem.
-/// </summary>
-/// <returns></returns>
-bool Modem::readFlash()
-{
-    Thread::sleep(2000U);    // 2s
+            data = TAG_DATA;
+            m_rxP25Queue.addData(&data, 1U);
 
-    for (uint32_t i = 0U; i < 6U; i++) {
-        uint8_t buffer[3U];
+            m_rxP25Queue.addData(buffer + 3U, length - 3U);
+#endif // defined(ENABLE_P25)
+        }
+        break;
 
-        buffer[0U] = DVM_FRAME_START;
-        buffer[1U] = 3U;
-        buffer[2U] = CMD_FLSH_READ;
+        case CMD_P25_LOST:
+        {
+#if defined(ENABLE_P25)
+            //if (m_trace)
+            //    Utils::dump(1U, "RX P25 Lost", buffer, length);
 
-        int ret = write(buffer, 3U);
-        if (ret != 3)
-            return false;
+            if (doubleLength) {
+                LogError(LOG_MODEM, "CMD_P25_LOST double length?; len = %u", length);
+                break;
+            }
 
-        for (uint32_t count = 0U; count < MAX_RESPONSES; count++) {
-            Thread::sleep(10U);
-            RESP_TYPE_DVM resp = getResponse(true);
+            uint8_t data = 1U;
+            m_rxP25Queue.addData(&data, 1U);
 
-            if (resp == RTM_ERROR)
-                continue;
+            data = TAG_LOST;
+            m_rxP25Queue.addData(&data, 1U);
+#endif // defined(ENABLE_P25)
+        }
+        break;
 
-            if (resp == RTM_OK && m_buffer[2U] == CMD_NAK) {
-                LogWarning(LOG_MODEM, "%s, old modem that doesn't support flash commands?", cmdToString(CMD_FLSH_READ).c_str());
-                m_flashDisabled = true;
-                return false;
+        /** Next Generation Digital Narrowband */
+        case CMD_NXDN_DATA:
+        {
+#if defined(ENABLE_NXDN)
+            //if (m_trace)
+            //    Utils::dump(1U, "RX NXDN Data", buffer, length);
+
+            if (doubleLength) {
+                LogError(LOG_MODEM, "CMD_NXDN_DATA double length?; len = %u", length);
+                break;
             }
 
-            m_flashDisabled = false;
-            if (resp == RTM_OK && m_buffer[2U] == CMD_FLSH_READ) {
-                uint8_t len = m_buffer[1U];
-                if (m_debug) {
-                    Utils::dump(1U, "Modem Flash Contents", m_buffer + 3U, len - 3U);
-                }
+            uint8_t data = length - 2U;
+            m_rxNXDNQueue.addData(&data, 1U);
 
-                if (len == 249U) {
-                    bool ret = edac::CRC::checkCCITT162(m_buffer + 3U, DVM_CONF_AREA_LEN);
-                    if (!ret) {
-                        LogWarning(LOG_MODEM, "Modem configuration area does not contain a valid configuration!");
-                    }
-                    else {
-                        bool isErased = (m_buffer[DVM_CONF_AREA_LEN] & 0x80U) == 0x80U;
-                        uint8_t confAreaVersion = m_buffer[DVM_CONF_AREA_LEN] & 0x7FU;
+            data = TAG_DATA;
+            m_rxNXDNQueue.addData(&data, 1U);
 
-                        if (!isErased) {
-                            if (confAreaVersion != DVM_CONF_AREA_VER) {
-                                LogError(LOG_MODEM, "Invalid version for configuration area, %02X != %02X", DVM_CONF_AREA_VER, confAreaVersion);
-                            }
-                            else {
-                                processFlashConfig(m_buffer);
-                            }
-                        }
-                        else {
-                            LogWarning(LOG_MODEM, "Modem configuration area was erased and does not contain active configuration!");
-                        }
-                    }
-                }
-                else {
-                    LogWarning(LOG_MODEM, "Incorrect length for configuration area! Ignoring.");
-                }
+            m_rxNXDNQueue.addData(buffer + 3U, length - 3U);
+#endif // defined(ENABLE_NXDN)
+        }
+        break;
+
+        case CMD_NXDN_LOST:
+        {
+#if defined(ENABLE_NXDN)
+            //if (m_trace)
+            //    Utils::dump(1U, "RX NXDN Lost", buffer, length);
 
-                return true;
+            if (doubleLength) {
+                LogError(LOG_MODEM, "CMD_NXDN_LOST double length?; len = %u", length);
+                break;
             }
-        }
 
-        Thread::sleep(1500U);
-    }
+            uint8_t data = 1U;
+            m_rxNXDNQueue.addData(&data, 1U);
 
-    LogError(LOG_MODEM, "Unable to read the configuration flash after 6 attempts");
+            data = TAG_LOST;
+            m_rxNXDNQueue.addData(&data, 1U);
+#endif // defined(ENABLE_NXDN)
+        }
+        break;
 
-    return false;
-}
+        /** General */
+        case CMD_GET_STATUS:
+        {
+            //if (m_trace)
+            //   Utils::dump(1U, "Get Status", buffer, length);
 
-/// <summary>
-/// Process the configuration data from the air interface modem.
-/// </summary>
-/// <param name="buffer"></param>
-void Modem::processFlashConfig(const uint8_t *buffer)
-{
-    if (m_ignoreModemConfigArea) {
-        LogMessage(LOG_MODEM, "Modem configuration area checking is disabled!");
-        return;
-    }
+            m_isHotspot = (buffer[3U] & 0x01U) == 0x01U;
 
-    // general config
-    bool rxInvert = (buffer[3U] & 0x01U) == 0x01U;
-    FLASH_VALUE_CHECK(m_rxInvert, rxInvert, false, "rxInvert");
-    bool txInvert = (buffer[3U] & 0x02U) == 0x02U;
-    FLASH_VALUE_CHECK(m_txInvert, txInvert, false, "txInvert");
-    bool pttInvert = (buffer[3U] & 0x04U) == 0x04U;
-    FLASH_VALUE_CHECK(m_pttInvert, pttInvert, false, "pttInvert");
+            // override hotspot flag if we're forcing hotspot
+            if (m_forceHotspot) {
+                m_isHotspot = m_forceHotspot;
+            }
 
-    bool dcBlocker = (buffer[4U] & 0x01U) == 0x01U;
-    FLASH_VALUE_CHECK(m_dcBlocker, dcBlocker, true, "dcBlocker");
+            bool dmrEnable = (buffer[3U] & 0x02U) == 0x02U;
+            bool p25Enable = (buffer[3U] & 0x08U) == 0x08U;
+            bool nxdnEnable = (buffer[3U] & 0x10U) == 0x10U;
 
-    uint8_t fdmaPreamble = buffer[5U];
-    FLASH_VALUE_CHECK(m_fdmaPreamble, fdmaPreamble, 80U, "fdmaPreamble");
+            m_modemState = (DVM_STATE)buffer[4U];
 
-    // levels
-    float rxLevel = (float(buffer[7U]) - 0.5F) / 2.55F;
-    FLASH_VALUE_CHECK_FLOAT(m_rxLevel, rxLevel, 50.0F, "rxLevel");
+            m_tx = (buffer[5U] & 0x01U) == 0x01U;
 
-    float txLevel = (float(buffer[8U]) - 0.5F) / 2.55F;
-    FLASH_VALUE_CHECK_FLOAT(m_cwIdTXLevel, txLevel, 50.0F, "cwIdTxLevel");
-    FLASH_VALUE_CHECK_FLOAT(m_dmrTXLevel, txLevel, 50.0F, "dmrTxLevel");
-    FLASH_VALUE_CHECK_FLOAT(m_p25TXLevel, txLevel, 50.0F, "p25TxLevel");
-    FLASH_VALUE_CHECK_FLOAT(m_nxdnTXLevel, txLevel, 50.0F, "nxdnTxLevel");
+            bool adcOverflow = (buffer[5U] & 0x02U) == 0x02U;
+            if (adcOverflow) {
+                //LogError(LOG_MODEM, "ADC levels have overflowed");
+                m_adcOverFlowCount++;
 
-    uint8_t dmrRxDelay = buffer[10U];
-    FLASH_VALUE_CHECK(m_dmrRxDelay, dmrRxDelay, 7U, "dmrRxDelay");
+                if (m_adcOverFlowCount >= MAX_ADC_OVERFLOW / 2U) {
+                    LogWarning(LOG_MODEM, "ADC overflow count > %u!", MAX_ADC_OVERFLOW / 2U);
+                }
 
-    uint8_t p25CorrCount = buffer[11U];
-    FLASH_VALUE_CHECK(m_p25CorrCount, p25CorrCount, 8U, "p25CorrCount");
+                if (!m_disableOFlowReset) {
+                    if (m_adcOverFlowCount > MAX_ADC_OVERFLOW) {
+                        LogError(LOG_MODEM, "ADC overflow count > %u, resetting modem", MAX_ADC_OVERFLOW);
+                        forceModemReset = true;
+                    }
+                }
+                else {
+                    m_adcOverFlowCount = 0U;
+                }
+            }
+            else {
+                if (m_adcOverFlowCount != 0U) {
+                    m_adcOverFlowCount--;
+                }
+            }
 
-    int txDCOffset = int(buffer[16U]) - 128;
-    FLASH_VALUE_CHECK(m_txDCOffset, txDCOffset, 0, "txDCOffset");
+            bool rxOverflow = (buffer[5U] & 0x04U) == 0x04U;
+            if (rxOverflow)
+                LogError(LOG_MODEM, "RX buffer has overflowed");
 
-    int rxDCOffset = int(buffer[17U]) - 128;
-    FLASH_VALUE_CHECK(m_rxDCOffset, rxDCOffset, 0, "rxDCOffset");
+            bool txOverflow = (buffer[5U] & 0x08U) == 0x08U;
+            if (txOverflow)
+                LogError(LOG_MODEM, "TX buffer has overflowed");
 
-    // RF parameters
-    int8_t dmrDiscBWAdj = int8_t(buffer[20U]) - 128;
-    FLASH_VALUE_CHECK(m_dmrDiscBWAdj, dmrDiscBWAdj, 0, "dmrDiscBWAdj");
-    int8_t p25DiscBWAdj = int8_t(buffer[21U]) - 128;
-    FLASH_VALUE_CHECK(m_p25DiscBWAdj, p25DiscBWAdj, 0, "p25DiscBWAdj");
-    int8_t dmrPostBWAdj = int8_t(buffer[22U]) - 128;
-    FLASH_VALUE_CHECK(m_dmrPostBWAdj, dmrPostBWAdj, 0, "dmrPostBWAdj");
-    int8_t p25PostBWAdj = int8_t(buffer[23U]) - 128;
-    FLASH_VALUE_CHECK(m_p25PostBWAdj, p25PostBWAdj, 0, "p25PostBWAdj");
+            m_lockout = (buffer[5U] & 0x10U) == 0x10U;
 
-    // are we on a protocol version 3 firmware?
-    if (m_protoVer >= 3U) {
-        int8_t nxdnDiscBWAdj = int8_t(buffer[39U]) - 128;
-        FLASH_VALUE_CHECK(m_nxdnDiscBWAdj, nxdnDiscBWAdj, 0, "nxdnDiscBWAdj");
-        int8_t nxdnPostBWAdj = int8_t(buffer[40U]) - 128;
-        FLASH_VALUE_CHECK(m_nxdnPostBWAdj, nxdnPostBWAdj, 0, "nxdnPostBWAdj");
-    }
+            bool dacOverflow = (buffer[5U] & 0x20U) == 0x20U;
+            if (dacOverflow) {
+                //LogError(LOG_MODEM, "DAC levels have overflowed");
+                m_dacOverFlowCount++;
 
-    ADF_GAIN_MODE adfGainMode = (ADF_GAIN_MODE)buffer[24U];
-    FLASH_VALUE_CHECK(m_adfGainMode, adfGainMode, ADF_GAIN_AUTO, "adfGainMode");
+                if (m_dacOverFlowCount > MAX_DAC_OVERFLOW / 2U) {
+                    LogWarning(LOG_MODEM, "DAC overflow count > %u!", MAX_DAC_OVERFLOW / 2U);
+                }
 
-    uint32_t txTuningRaw = __GET_UINT32(buffer, 25U);
-    int txTuning = int(txTuningRaw);
-    FLASH_VALUE_CHECK(m_txTuning, txTuning, 0, "txTuning");
-    uint32_t rxTuningRaw = __GET_UINT32(buffer, 29U);
-    int rxTuning = int(rxTuningRaw);
-    FLASH_VALUE_CHECK(m_rxTuning, rxTuning, 0, "rxTuning");
+                if (!m_disableOFlowReset) {
+                    if (m_dacOverFlowCount > MAX_DAC_OVERFLOW) {
+                        LogError(LOG_MODEM, "DAC overflow count > %u, resetting modem", MAX_DAC_OVERFLOW);
+                        forceModemReset = true;
+                    }
+                }
+                else {
+                    m_dacOverFlowCount = 0U;
+                }
+            }
+            else {
+                if (m_dacOverFlowCount != 0U) {
+                    m_dacOverFlowCount--;
+                }
+            }
 
-    // symbol adjust
-    int dmrSymLevel3Adj = int(buffer[35U]) - 128;
-    FLASH_VALUE_CHECK(m_dmrSymLevel3Adj, dmrSymLevel3Adj, 0, "dmrSymLevel3Adj");
-    int dmrSymLevel1Adj = int(buffer[36U]) - 128;
-    FLASH_VALUE_CHECK(m_dmrSymLevel1Adj, dmrSymLevel1Adj, 0, "dmrSymLevel1Adj");
+            m_cd = (buffer[5U] & 0x40U) == 0x40U;
 
-    int p25SymLevel3Adj = int(buffer[37U]) - 128;
-    FLASH_VALUE_CHECK(m_p25SymLevel3Adj, p25SymLevel3Adj, 0, "p25SymLevel3Adj");
-    int p25SymLevel1Adj = int(buffer[38U]) - 128;
-    FLASH_VALUE_CHECK(m_p25SymLevel1Adj, p25SymLevel1Adj, 0, "p25SymLevel1Adj");
+            // spaces from the modem are returned in "logical" frame count, not raw byte size
+            m_dmrSpace1 = buffer[7U] * (dmr::DMR_FRAME_LENGTH_BYTES + 2U);
+            m_dmrSpace2 = buffer[8U] * (dmr::DMR_FRAME_LENGTH_BYTES + 2U);
+            m_p25Space = buffer[10U] * (p25::P25_LDU_FRAME_LENGTH_BYTES);
+            m_nxdnSpace = buffer[11U] * (nxdn::NXDN_FRAME_LENGTH_BYTES);
 
-    // are we on a protocol version 3 firmware?
-    if (m_protoVer >= 3U) {
-        int nxdnSymLevel3Adj = int(buffer[41U]) - 128;
-        FLASH_VALUE_CHECK(m_nxdnSymLevel3Adj, nxdnSymLevel3Adj, 0, "nxdnSymLevel3Adj");
-        int nxdnSymLevel1Adj = int(buffer[42U]) - 128;
-        FLASH_VALUE_CHECK(m_nxdnSymLevel1Adj, nxdnSymLevel1Adj, 0, "nxdnSymLevel1Adj");
-    }
+            if (m_dumpModemStatus) {
+                LogDebug(LOG_MODEM, "Modem::clock(), CMD_GET_STATUS, isHotspot = %u, dmr = %u / %u, p25 = %u / %u, nxdn = %u / %u, modemState = %u, tx = %u, adcOverflow = %u, rxOverflow = %u, txOverflow = %u, dacOverflow = %u, dmrSpace1 = %u, dmrSpace2 = %u, p25Space = %u, nxdnSpace = %u",
+                    m_isHotspot, dmrEnable, m_dmrEnabled, p25Enable, m_p25Enabled, nxdnEnable, m_nxdnEnabled, m_modemState, m_tx, adcOverflow, rxOverflow, txOverflow, dacOverflow, m_dmrSpace1, m_dmrSpace2, m_p25Space, m_nxdnSpace);
+                LogDebug(LOG_MODEM, "Modem::clock(), CMD_GET_STATUS, rxDMRData1 size = %u, len = %u, free = %u; rxDMRData2 size = %u, len = %u, free = %u, rxP25Data size = %u, len = %u, free = %u, rxNXDNData size = %u, len = %u, free = %u",
+                    m_rxDMRQueue1.length(), m_rxDMRQueue1.dataSize(), m_rxDMRQueue1.freeSpace(), m_rxDMRQueue2.length(), m_rxDMRQueue2.dataSize(), m_rxDMRQueue2.freeSpace(),
+                    m_rxP25Queue.length(), m_rxP25Queue.dataSize(), m_rxP25Queue.freeSpace(), m_rxNXDNQueue.length(), m_rxNXDNQueue.dataSize(), m_rxNXDNQueue.freeSpace());
+            }
 
-    // are we on a protocol version 3 firmware?
-    if (m_protoVer >= 3U) {
-        uint8_t rxCoarse = buffer[43U];
-        FLASH_VALUE_CHECK(m_rxCoarsePot, rxCoarse, 7U, "rxCoarse");
-        uint8_t rxFine = buffer[44U];
-        FLASH_VALUE_CHECK(m_rxFinePot, rxFine, 7U, "rxFine");
+            m_inactivityTimer.start();
+        }
+        break;
 
-        uint8_t txCoarse = buffer[45U];
-        FLASH_VALUE_CHECK(m_txCoarsePot, txCoarse, 7U, "txCoarse");
-        uint8_t txFine = buffer[46U];
-        FLASH_VALUE_CHECK(m_txFinePot, txFine, 7U, "txFine");
+        case CMD_GET_VERSION:
+        case CMD_ACK:
+            break;
 
-        uint8_t rssiCoarse = buffer[47U];
-        FLASH_VALUE_CHECK(m_rssiCoarsePot, rssiCoarse, 7U, "rssiCoarse");
-        uint8_t rssiFine = buffer[48U];
-        FLASH_VALUE_CHECK(m_rssiFinePot, rssiFine, 7U, "rssiFine");
-    }
-}
+        case CMD_NAK:
+        {
+            LogWarning(LOG_MODEM, "NAK, command = 0x%02X (%s), reason = %u (%s)", buffer[3U], cmdToString(buffer[3U]).c_str(), buffer[4U], rsnToString(buffer[4U]).c_str());
+            switch (buffer[4U]) {
+                case RSN_RINGBUFF_FULL:
+                {
+                    switch (buffer[3U]) {
+                        case CMD_DMR_DATA1:
+                            LogWarning(LOG_MODEM, "NAK, %s, dmrSpace1 = %u", rsnToString(buffer[4U]).c_str(), m_dmrSpace1);
+                            break;
+                        case CMD_DMR_DATA2:
+                            LogWarning(LOG_MODEM, "NAK, %s, dmrSpace2 = %u", rsnToString(buffer[4U]).c_str(), m_dmrSpace2);
+                            break;
 
-/// <summary>
-/// Print debug air interface messages to the host log.
-/// </summary>
-/// <param name="buffer"></param>
-/// <param name="len"></param>
-void Modem::printDebug(const uint8_t* buffer, uint16_t len)
-{
-    if (m_rspDoubleLength && buffer[3U] == CMD_DEBUG_DUMP) {
-        uint8_t data[512U];
-        ::memset(data, 0x00U, 512U);
-        ::memcpy(data, buffer, len);
+                        case CMD_P25_DATA:
+                            LogWarning(LOG_MODEM, "NAK, %s, p25Space = %u", rsnToString(buffer[4U]).c_str(), m_p25Space);
+                            break;
 
-        Utils::dump(1U, "Modem Debug Dump", data, len);
-        return;
-    }
-    else {
-        if (m_rspDoubleLength) {
-            LogError(LOG_MODEM, "Invalid debug data received from the modem, len = %u", len);
-            return;
+                        case CMD_NXDN_DATA:
+                            LogWarning(LOG_MODEM, "NAK, %s, nxdnSpace = %u", rsnToString(buffer[4U]).c_str(), m_nxdnSpace);
+                            break;
+                        }
+                }
+                break;
+            }
         }
-    }
+        break;
 
-    if (buffer[2U] == CMD_DEBUG1) {
-        LogDebug(LOG_MODEM, "M: %.*s", len - 3U, buffer + 3U);
-    }
-    else if (buffer[2U] == CMD_DEBUG2) {
-        short val1 = (buffer[len - 2U] << 8) | buffer[len - 1U];
-        LogDebug(LOG_MODEM, "M: %.*s %X", len - 5U, buffer + 3U, val1);
-    }
-    else if (buffer[2U] == CMD_DEBUG3) {
-        short val1 = (buffer[len - 4U] << 8) | buffer[len - 3U];
-        short val2 = (buffer[len - 2U] << 8) | buffer[len - 1U];
-        LogDebug(LOG_MODEM, "M: %.*s %X %X", len - 7U, buffer + 3U, val1, val2);
-    }
-    else if (buffer[2U] == CMD_DEBUG4) {
-        short val1 = (buffer[len - 6U] << 8) | buffer[len - 5U];
-        short val2 = (buffer[len - 4U] << 8) | buffer[len - 3U];
-        short val3 = (buffer[len - 2U] << 8) | buffer[len - 1U];
-        LogDebug(LOG_MODEM, "M: %.*s %X %X %X", len - 9U, buffer + 3U, val1, val2, val3);
-    }
-    else if (buffer[2U] == CMD_DEBUG5) {
-        short val1 = (buffer[len - 8U] << 8) | buffer[len - 7U];
-        short val2 = (buffer[len - 6U] << 8) | buffer[len - 5U];
-        short val3 = (buffer[len - 4U] << 8) | buffer[len - 3U];
-        short val4 = (buffer[len - 2U] << 8) | buffer[len - 1U];
-        LogDebug(LOG_MODEM, "M: %.*s %X %X %X %X", len - 11U, buffer + 3U, val1, val2, val3, val4);
+        case CMD_DEBUG1:
+        case CMD_DEBUG2:
+        case CMD_DEBUG3:
+        case CMD_DEBUG4:
+        case CMD_DEBUG5:
+        case CMD_DEBUG_DUMP:
+            printDebug(buffer, length, doubleLength);
+            break;
+
+        default:
+            LogWarning(LOG_MODEM, "Unknown message, type = %02X", buffer[2U]);
+            Utils::dump("Buffer dump", buffer, length);
+            break;
+        }
     }
-    else if (buffer[2U] == CMD_DEBUG_DUMP) {
-        uint8_t data[255U];
-        ::memset(data, 0x00U, 255U);
-        ::memcpy(data, buffer, len);
 
-        Utils::dump(1U, "Modem Debug Dump", data, len);
+    // force a modem reset because of a error condition
+    if (forceModemReset) {
+        forceModemReset = false;
+        reset();
     }
 }
 
@@ -34,12 +34,14 @@
 
 #include "Defines.h"
 #include "modem/port/IModemPort.h"
+#include "modem/ModemIOThread.h"
 #include "network/RESTAPI.h"
 #include "RingBuffer.h"
 #include "Timer.h"
 
 #include <string>
 #include <functional>
+#include <mutex>
 
 // ---------------------------------------------------------------------------
 //  Constants
@@ -285,6 +287,10 @@ namespace modem
         void setOpenHandler(std::function<MODEM_OC_PORT_HANDLER> handler);
         /// <summary>Sets a custom modem close port handler.</summary>
         void setCloseHandler(std::function<MODEM_OC_PORT_HANDLER> handler);
+        /// <summary>Sets whether or not modem port I/O is performed on a dedicated thread.</summary>
+        bool setIOThread(bool enable);
+        /// <summary>Gets a descriptor that becomes readable when frames have been received from the modem.</summary>
+        int getEventFd() const;
 
         /// <summary>Opens connection to the air interface modem.</summary>
         bool open();
@@ -379,6 +385,7 @@ namespace modem
     private:
         friend class ::HostCal;
         friend class ::RESTAPI;
+        friend class ModemIOThread;
 
         friend class ::HostSetup;
 #if defined(ENABLE_SETUP_TUI)        
@@ -483,6 +490,9 @@ namespace modem
         std::function<MODEM_OC_PORT_HANDLER> m_closePortHandler;
         std::function<MODEM_RESP_HANDLER> m_rspHandler;
 
+        ModemIOThread* m_ioThread;
+        std::mutex m_txLock;
+
         RingBuffer<uint8_t> m_rxDMRQueue1;
         RingBuffer<uint8_t> m_rxDMRQueue2;
         RingBuffer<uint8_t> m_rxP25Queue;
@@ -526,10 +536,12 @@ namespace modem
         void processFlashConfig(const uint8_t *buffer);
 
         /// <summary>Print debug air interface messages to the host log.</summary>
-        void printDebug(const uint8_t* buffer, uint16_t len);
+        void printDebug(const uint8_t* buffer, uint16_t len, bool doubleLength);
 
         /// <summary>Helper to get the raw response packet from modem.</summary>
         RESP_TYPE_DVM getResponse(bool noReportInvalid = false);
+        /// <summary>Helper to process a response packet from the modem.</summary>
+        void processResponse(uint32_t ms, RESP_TYPE_DVM type, const uint8_t* buffer, uint16_t length, bool doubleLength);
 
         /// <summary>Helper to convert a serial opcode to a string.</summary>
         std::string cmdToString(uint8_t opcode);
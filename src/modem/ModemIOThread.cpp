@@ -0,0 +1,308 @@
+/**
+* Digital Voice Modem - Host Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software
+*
+*/
+/*
+*   Copyright (C) 2023 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#include "Defines.h"
+#include "modem/Modem.h"
+#include "modem/ModemIOThread.h"
+#include "Log.h"
+
+using namespace modem;
+
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+
+#include <poll.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#endif
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Helper to create an event descriptor.
+/// </summary>
+/// <returns>Event descriptor, or -1 if none is available.</returns>
+static int createEvent()
+{
+#if defined(__linux__)
+    int fd = ::eventfd(0U, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fd < 0) {
+        LogWarning(LOG_MODEM, "Cannot create the modem I/O event descriptor, err: %d", errno);
+    }
+
+    return fd;
+#else
+    return -1;
+#endif
+}
+
+/// <summary>
+/// Helper to make an event descriptor readable.
+/// </summary>
+/// <param name="fd">Event descriptor.</param>
+static void signalEvent(int fd)
+{
+    if (fd >= 0) {
+        uint64_t value = 1U;
+        ssize_t len = ::write(fd, &value, sizeof(value));
+        (void)len;
+    }
+}
+
+/// <summary>
+/// Helper to reset an event descriptor.
+/// </summary>
+/// <param name="fd">Event descriptor.</param>
+static void resetEvent(int fd)
+{
+    if (fd >= 0) {
+        uint64_t value = 0U;
+        ssize_t len = ::read(fd, &value, sizeof(value));
+        (void)len;
+    }
+}
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Initializes a new instance of the ModemIOThread class.
+/// </summary>
+/// <param name="modem">Instance of the Modem class.</param>
+/// <param name="queueDepth">Maximum number of frames that may be waiting in each direction.</param>
+ModemIOThread::ModemIOThread(Modem* modem, uint32_t queueDepth) :
+    Thread(),
+    m_modem(modem),
+    m_rxQueue(queueDepth, "Modem RX Frame"),
+    m_txQueue(queueDepth, "Modem TX Frame"),
+    m_running(false),
+    m_started(false),
+    m_rxEventFd(-1),
+    m_txEventFd(-1),
+    m_txDropped(0U)
+{
+    assert(modem != nullptr);
+
+    m_rxEventFd = createEvent();
+    m_txEventFd = createEvent();
+}
+
+/// <summary>
+/// Finalizes a instance of the ModemIOThread class.
+/// </summary>
+ModemIOThread::~ModemIOThread()
+{
+    stop();
+
+    if (m_rxEventFd >= 0) {
+        ::close(m_rxEventFd);
+        m_rxEventFd = -1;
+    }
+
+    if (m_txEventFd >= 0) {
+        ::close(m_txEventFd);
+        m_txEventFd = -1;
+    }
+}
+
+/// <summary>
+/// Starts the I/O thread.
+/// </summary>
+/// <returns>True, if thread started, otherwise false.</returns>
+bool ModemIOThread::run()
+{
+    m_running = true;
+    m_started = Thread::run();
+    if (!m_started) {
+        m_running = false;
+    }
+
+    return m_started;
+}
+
+/// <summary>
+/// I/O thread main.
+/// </summary>
+void ModemIOThread::entry()
+{
+    LogMessage(LOG_MODEM, "Modem I/O thread started");
+
+    ModemFrame frame;
+    while (m_running) {
+        bool idle = true;
+        bool backlogged = false;
+        bool received = false;
+
+        resetEvent(m_txEventFd);
+
+        // transmit everything the host has queued before looking for new frames
+        while (m_txQueue.pop(frame)) {
+            int ret = m_modem->m_port->write(frame.data, frame.length);
+            if (ret != int(frame.length)) {
+                LogError(LOG_MODEM, "Error writing to the modem, ret = %d", ret);
+            }
+
+            idle = false;
+        }
+
+        for (uint32_t i = 0U; i < MODEM_IO_MAX_READS_PER_PASS; i++) {
+            // leave data in the port buffers until the host has caught up
+            if (m_rxQueue.size() >= m_rxQueue.capacity()) {
+                backlogged = true;
+                break;
+            }
+
+            RESP_TYPE_DVM type = m_modem->getResponse();
+            if (type == RTM_TIMEOUT)
+                break;
+            if (type == RTM_ERROR)
+                continue;
+
+            idle = false;
+
+            frame.length = m_modem->m_length;
+            frame.doubleLength = m_modem->m_rspDoubleLength;
+            ::memcpy(frame.data, m_modem->m_buffer, m_modem->m_length);
+
+            m_rxQueue.push(frame);
+            received = true;
+        }
+
+        // wake the host if it is waiting on us
+        if (received) {
+            signalEvent(m_rxEventFd);
+        }
+
+        if (idle) {
+            if (backlogged || m_txEventFd < 0) {
+                Thread::sleep(1U);
+                continue;
+            }
+
+            // sleep until the modem sends data or the host queues a frame (ports without a descriptor
+            // only produce data in response to writes)
+            struct pollfd pfd[2U];
+            nfds_t n = 0U;
+            pfd[n].fd = m_txEventFd;
+            pfd[n].events = POLLIN;
+            pfd[n].revents = 0;
+            n++;
+
+            int portFd = m_modem->m_port->getFd();
+            if (portFd >= 0) {
+                pfd[n].fd = portFd;
+                pfd[n].events = POLLIN;
+                pfd[n].revents = 0;
+                n++;
+            }
+
+            if (::poll(pfd, n, MODEM_IO_IDLE_WAIT_MS) < 0 && errno != EINTR) {
+                LogError(LOG_MODEM, "Error returned from modem I/O poll, err: %d", errno);
+                Thread::sleep(1U);
+            }
+        }
+    }
+
+    LogMessage(LOG_MODEM, "Modem I/O thread stopped");
+}
+
+/// <summary>
+/// Stops the I/O thread.
+/// </summary>
+void ModemIOThread::stop()
+{
+    if (!m_started) {
+        return;
+    }
+
+    m_running = false;
+    signalEvent(m_txEventFd);
+    wait();
+
+    // anything left over belongs to the port that is about to be closed
+    ModemFrame frame;
+    while (m_rxQueue.pop(frame))
+        ;
+    while (m_txQueue.pop(frame))
+        ;
+
+    m_started = false;
+}
+
+/// <summary>
+/// Gets the next frame received from the modem.
+/// </summary>
+/// <remarks>This must only be called from the host thread.</remarks>
+/// <param name="frame">Frame received from the modem.</param>
+/// <returns>True, if a frame was available, otherwise false.</returns>
+bool ModemIOThread::read(ModemFrame& frame)
+{
+    return m_rxQueue.pop(frame);
+}
+
+/// <summary>
+/// Resets the received frame event.
+/// </summary>
+/// <remarks>This must only be called from the host thread, before reading the waiting frames.</remarks>
+void ModemIOThread::clearEvent()
+{
+    resetEvent(m_rxEventFd);
+}
+
+/// <summary>
+/// Queues a frame to be written to the modem.
+/// </summary>
+/// <remarks>Callers must serialize calls to this; the modem does so with its transmit lock.</remarks>
+/// <param name="data">Frame data.</param>
+/// <param name="length">Length of frame data.</param>
+/// <returns>True, if the frame was queued, otherwise false.</returns>
+bool ModemIOThread::write(const uint8_t* data, uint32_t length)
+{
+    assert(data != nullptr);
+
+    if (length > MODEM_IO_FRAME_LENGTH) {
+        LogError(LOG_MODEM, "Modem I/O frame too large, len = %u", length);
+        return false;
+    }
+
+    ModemFrame frame;
+    frame.length = (uint16_t)length;
+    frame.doubleLength = false;
+    ::memcpy(frame.data, data, length);
+
+    if (!m_txQueue.push(frame)) {
+        m_txDropped++;
+        LogError(LOG_MODEM, "Modem I/O transmit queue full, dropping frame");
+        return false;
+    }
+
+    signalEvent(m_txEventFd);
+    return true;
+}
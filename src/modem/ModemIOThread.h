@@ -0,0 +1,116 @@
+/**
+* Digital Voice Modem - Host Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software
+*
+*/
+/*
+*   Copyright (C) 2023 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#if !defined(__MODEM_IO_THREAD_H__)
+#define __MODEM_IO_THREAD_H__
+
+#include "Defines.h"
+#include "SPSCQueue.h"
+#include "Thread.h"
+
+#include <atomic>
+
+namespace modem
+{
+    // ---------------------------------------------------------------------------
+    //  Constants
+    // ---------------------------------------------------------------------------
+
+    const uint32_t  MODEM_IO_FRAME_LENGTH = 520U;       // largest double length frame (510) + pad
+    const uint32_t  MODEM_IO_QUEUE_DEPTH = 256U;
+    const uint32_t  MODEM_IO_MAX_READS_PER_PASS = 16U;
+    const int       MODEM_IO_IDLE_WAIT_MS = 100;
+
+    // ---------------------------------------------------------------------------
+    //  Class Prototypes
+    // ---------------------------------------------------------------------------
+
+    class HOST_SW_API Modem;
+
+    // ---------------------------------------------------------------------------
+    //  Structure Declaration
+    //      Represents a single raw frame to or from the air interface modem.
+    // ---------------------------------------------------------------------------
+
+    struct ModemFrame {
+        uint16_t length;
+        bool doubleLength;
+        uint8_t data[MODEM_IO_FRAME_LENGTH];
+    };
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    //      Implements a thread that owns the modem port, reading complete
+    //      frames into a receive queue and draining a transmit queue, so the
+    //      host main loop never blocks on port I/O.
+    // ---------------------------------------------------------------------------
+
+    class HOST_SW_API ModemIOThread : public Thread {
+    public:
+        /// <summary>Initializes a new instance of the ModemIOThread class.</summary>
+        ModemIOThread(Modem* modem, uint32_t queueDepth = MODEM_IO_QUEUE_DEPTH);
+        /// <summary>Finalizes a instance of the ModemIOThread class.</summary>
+        ~ModemIOThread();
+
+        /// <summary>Starts the I/O thread.</summary>
+        virtual bool run();
+        /// <summary>I/O thread main.</summary>
+        virtual void entry();
+        /// <summary>Stops the I/O thread.</summary>
+        void stop();
+
+        /// <summary>Gets the next frame received from the modem.</summary>
+        bool read(ModemFrame& frame);
+        /// <summary>Queues a frame to be written to the modem.</summary>
+        bool write(const uint8_t* data, uint32_t length);
+
+        /// <summary>Gets a descriptor that becomes readable when frames are waiting to be read.</summary>
+        int eventFd() const { return m_rxEventFd; }
+        /// <summary>Resets the received frame event.</summary>
+        void clearEvent();
+
+        /// <summary>Flag indicating whether or not the I/O thread is running.</summary>
+        bool isRunning() const { return m_started; }
+
+        /// <summary>Gets the total number of transmit frames dropped due to a full queue.</summary>
+        uint64_t txDropped() const { return m_txDropped.load(); }
+
+    private:
+        Modem* m_modem;
+
+        SPSCQueue<ModemFrame> m_rxQueue;
+        SPSCQueue<ModemFrame> m_txQueue;
+
+        std::atomic<bool> m_running;
+        bool m_started;
+
+        int m_rxEventFd;
+        int m_txEventFd;
+
+        std::atomic<uint64_t> m_txDropped;
+    };
+} // namespace modem
+
+#endif // __MODEM_IO_THREAD_H__
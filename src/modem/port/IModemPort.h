@@ -56,6 +56,9 @@ namespace modem
 
             /// <summary>Closes the connection to the port.</summary>
             virtual void close() = 0;
+
+            /// <summary>Gets the descriptor that becomes readable when data arrives on the port.</summary>
+            virtual int getFd() const = 0;
         };
     } // namespace port
 } // namespace modem
@@ -63,6 +63,10 @@ namespace modem
             /// <summary>Closes the connection to the port.</summary>
             void close();
 
+            /// <summary>Gets the descriptor that becomes readable when data arrives on the port.</summary>
+            /// <remarks>Responses are generated as commands are written, so there is nothing to wait on.</remarks>
+            int getFd() const { return -1; }
+
         private:
             RingBuffer<unsigned char> m_buffer;
 
@@ -63,7 +63,8 @@ UARTPort::UARTPort(const std::string& device, SERIAL_SPEED speed, bool assertRTS
     m_device(device),
     m_speed(speed),
     m_assertRTS(assertRTS),
-    m_fd(-1)
+    m_fd(-1),
+    m_rxBuffer(UART_RX_BUFFER_LENGTH, "UART Port Ring Buffer")
 {
     assert(!device.empty());
 }
@@ -119,7 +120,8 @@ int UARTPort::read(uint8_t* buffer, uint32_t length)
     if (length == 0U)
         return 0;
 
-    uint32_t offset = 0U;
+    // serve whatever an earlier read already pulled from the port
+    uint32_t offset = readBuffered(buffer, length);
 
     while (offset < length) {
         fd_set fds;
@@ -146,7 +148,10 @@ int UARTPort::read(uint8_t* buffer, uint32_t length)
         }
 
         if (n > 0) {
-            ssize_t len = ::read(m_fd, buffer + offset, length - offset);
+            // pull everything the port has (not just what was asked for) in a single read; the
+            // remainder is kept for the following calls
+            uint8_t data[UART_RX_BUFFER_LENGTH];
+            ssize_t len = ::read(m_fd, data, m_rxBuffer.freeSpace() - 1U);
             if (len < 0) {
                 if (errno != EAGAIN) {
                     ::LogError(LOG_HOST, "Error from read(), errno=%d", errno);
@@ -154,8 +159,10 @@ int UARTPort::read(uint8_t* buffer, uint32_t length)
                 }
             }
 
-            if (len > 0)
-                offset += len;
+            if (len > 0) {
+                m_rxBuffer.addData(data, len);
+                offset += readBuffered(buffer + offset, length - offset);
+            }
         }
     }
 
@@ -212,6 +219,8 @@ void UARTPort::close()
     ::close(m_fd);
     m_fd = -1;
     m_isOpen = false;
+
+    m_rxBuffer.clear();
 }
 
 #if defined(__APPLE__)
@@ -245,11 +254,30 @@ UARTPort::UARTPort(SERIAL_SPEED speed, bool assertRTS) :
     m_isOpen(false),
     m_speed(speed),
     m_assertRTS(assertRTS),
-    m_fd(-1)
+    m_fd(-1),
+    m_rxBuffer(UART_RX_BUFFER_LENGTH, "UART Port Ring Buffer")
 {
     /* stub */
 }
 
+/// <summary>
+/// Copies already received data out of the receive buffer.
+/// </summary>
+/// <param name="buffer">Buffer to copy data to.</param>
+/// <param name="length">Maximum length of data to copy.</param>
+/// <returns>Length of data copied.</returns>
+uint32_t UARTPort::readBuffered(uint8_t* buffer, uint32_t length)
+{
+    uint32_t avail = m_rxBuffer.dataSize();
+    if (avail < length)
+        length = avail;
+
+    if (length > 0U)
+        m_rxBuffer.getData(buffer, length);
+
+    return length;
+}
+
 /// <summary>
 ///
 /// </summary>
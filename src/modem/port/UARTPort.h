@@ -35,6 +35,7 @@
 #include "Defines.h"
 #include "modem/port/IModemPort.h"
 #include "modem/port/ISerialPort.h"
+#include "RingBuffer.h"
 
 #include <string>
 
@@ -59,6 +60,8 @@ namespace modem
             SERIAL_460800 = 460800
         };
 
+        const uint32_t  UART_RX_BUFFER_LENGTH = 2048U;
+
         // ---------------------------------------------------------------------------
         //  Class Declaration
         //      This class implements low-level routines to communicate over a RS232
@@ -83,6 +86,9 @@ namespace modem
             /// <summary>Closes the connection to the serial port.</summary>
             void close();
 
+            /// <summary>Gets the descriptor that becomes readable when data arrives on the serial port.</summary>
+            int getFd() const { return m_fd; }
+
 #if defined(__APPLE__)
             /// <summary></summary>
             int setNonblock(bool nonblock);
@@ -99,6 +105,11 @@ namespace modem
             bool m_assertRTS;
             int m_fd;
 
+            RingBuffer<uint8_t> m_rxBuffer;
+
+            /// <summary>Copies already received data out of the receive buffer.</summary>
+            uint32_t readBuffered(uint8_t* buffer, uint32_t length);
+
             /// <summary></summary>
             bool canWrite();
 
@@ -106,25 +106,27 @@ int UDPPort::read(uint8_t* buffer, uint32_t length)
     assert(buffer != nullptr);
     assert(length > 0U);
 
-    uint8_t data[BUFFER_LENGTH];
-    ::memset(data, 0x00U, BUFFER_LENGTH);
-
-    sockaddr_storage addr;
-    uint32_t addrLen;
-    int ret = m_socket.read(data, BUFFER_LENGTH, addr, addrLen);
-
-    // An error occurred on the socket
-    if (ret < 0)
-        return ret;
-
-    // Add new data to the ring buffer
-    if (ret > 0) {
-        if (UDPSocket::match(addr, m_addr)) {
-            m_buffer.addData(data, ret);
-        }
-        else {
-            std::string addrStr = UDPSocket::address(addr);
-            LogWarning(LOG_HOST, "SECURITY: Remote modem mode encountered invalid IP address; %s", addrStr.c_str());
+    // only go to the socket when the buffered datagrams cannot satisfy the request
+    if (m_buffer.dataSize() < length) {
+        uint8_t data[BUFFER_LENGTH];
+
+        sockaddr_storage addr;
+        uint32_t addrLen;
+        int ret = m_socket.read(data, BUFFER_LENGTH, addr, addrLen);
+
+        // An error occurred on the socket
+        if (ret < 0)
+            return ret;
+
+        // Add new data to the ring buffer
+        if (ret > 0) {
+            if (UDPSocket::match(addr, m_addr)) {
+                m_buffer.addData(data, ret);
+            }
+            else {
+                std::string addrStr = UDPSocket::address(addr);
+                LogWarning(LOG_HOST, "SECURITY: Remote modem mode encountered invalid IP address; %s", addrStr.c_str());
+            }
         }
     }
 
@@ -65,6 +65,9 @@ namespace modem
             /// <summary>Closes the connection to the serial port.</summary>
             void close();
 
+            /// <summary>Gets the descriptor that becomes readable when data arrives on the port.</summary>
+            int getFd() const { return m_socket.fd(); }
+
         protected:
             network::UDPSocket m_socket;
 
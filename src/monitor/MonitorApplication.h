@@ -28,6 +28,7 @@
 
 #include "monitor/MonitorMain.h"
 #include "monitor/MonitorMainWnd.h"
+#include "remote/RESTClientPool.h"
 #include "Log.h"
 
 #include <final/final.h>
@@ -48,6 +49,7 @@ public:
     explicit MonitorApplication(const int& argc, char** argv) : FApplication{argc, argv}
     {
         m_statusRefreshTimer = addTimer(1000);
+        m_restClockTimer = addTimer(50);
     }
 
 protected:
@@ -73,11 +75,20 @@ protected:
             if (timer->getTimerId() == m_statusRefreshTimer) {
                 /* stub */
             }
+
+            // dispatch node status updates received by the REST client pool
+            if (timer->getTimerId() == m_restClockTimer) {
+                RESTClientPool* restClient = RESTClientPool::instance();
+                if (restClient != nullptr) {
+                    restClient->clock();
+                }
+            }
         }
     }
 
 private:
     int m_statusRefreshTimer;
+    int m_restClockTimer;
 };
 
 #endif // __MONITOR_APPLICATION_H__
\ No newline at end of file
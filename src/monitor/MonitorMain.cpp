@@ -28,6 +28,7 @@
 #include "monitor/MonitorMain.h"
 #include "monitor/MonitorApplication.h"
 #include "monitor/MonitorMainWnd.h"
+#include "remote/RESTClientPool.h"
 #include "yaml/Yaml.h"
 #include "Utils.h"
 
@@ -224,6 +225,12 @@ int main(int argc, char** argv)
         ::fatal("cannot read the configuration file - %s (%s)", g_iniFile.c_str(), e.message());
     }
 
+    // node status is streamed from each host on the REST client pool thread
+    RESTClientPool restClient(REST_CLIENT_POOL_TIMEOUT_MS, g_debug);
+    if (!restClient.open()) {
+        ::fatal("unable to start the REST client pool");
+    }
+
     // setup the finalcut tui
     MonitorApplication app{argc, argv};
 
@@ -263,6 +270,8 @@ int main(int argc, char** argv)
     app.redraw();
     
     int _errno = app.exec();
+
+    restClient.close();
     ::LogFinalise();
     return _errno;
 }
@@ -30,6 +30,7 @@
 #include "modem/Modem.h"
 #include "network/RESTDefines.h"
 #include "remote/RESTClient.h"
+#include "remote/RESTClientPool.h"
 
 #include "monitor/MonitorMainWnd.h"
 
@@ -57,15 +58,19 @@ public:
     /// <param name="widget"></param>
     explicit NodeStatusWnd(FWidget* widget = nullptr) : FDialog{widget}
     {
-        m_timerId = addTimer(250); // starts the timer every 250 milliseconds
-        m_reconnectTimerId = addTimer(15000); // starts the timer every 10 seconds
+        m_timerId = addTimer(1000); // starts the timer every 1 second (used only when polling)
     }
     /// <summary>Copy constructor.</summary>
     NodeStatusWnd(const NodeStatusWnd&) = delete;
     /// <summary>Move constructor.</summary>
     NodeStatusWnd(NodeStatusWnd&&) noexcept = delete;
     /// <summary>Finalizes an instance of the NodeStatusWnd class.</summary>
-    ~NodeStatusWnd() noexcept override = default;
+    ~NodeStatusWnd() noexcept override
+    {
+        if (!m_polling && RESTClientPool::instance() != nullptr) {
+            RESTClientPool::instance()->unsubscribe(m_chData.address(), m_chData.port(), GET_STATUS_STREAM);
+        }
+    }
 
     /// <summary>Disable copy assignment operator (=).</summary>
     auto operator= (const NodeStatusWnd&) -> NodeStatusWnd& = delete;
@@ -86,16 +91,16 @@ public:
     /// <summary>Gets the channel data.</summary>
     lookups::VoiceChData getChData() { return m_chData; }
     /// <summary>Sets the channel data.</summary>
-    void setChData(lookups::VoiceChData chData) { m_chData = chData; }
+    void setChData(lookups::VoiceChData chData) { m_chData = chData; subscribe(); }
     /// <summary>Gets the peer ID.</summary>
     uint32_t getPeerId() const { return m_peerId; }
 
 private:
     int m_timerId;
-    int m_reconnectTimerId;
 
     uint8_t m_failCnt = 0U;
     bool m_failed;
+    bool m_polling = false;
     bool m_control;
     bool m_tx;
 
@@ -104,6 +109,8 @@ private:
     uint32_t m_channelNo;
     uint32_t m_peerId;
 
+    json::object m_status;
+
     FLabel m_modeStr{this};
     FLabel m_peerIdStr{this};
 
@@ -248,6 +255,180 @@ private:
         }
     }
 
+    /// <summary>
+    /// Subscribes to the status stream of the node we represent.
+    /// </summary>
+    void subscribe()
+    {
+        RESTClientPool* restClient = RESTClientPool::instance();
+        if (restClient == nullptr) {
+            m_polling = true;
+            return;
+        }
+
+        restClient->subscribe(m_chData.address(), m_chData.port(), m_chData.password(), GET_STATUS_STREAM,
+            [this](int status, const json::object& rsp) { update(status, rsp); }, g_debug);
+    }
+
+    /// <summary>
+    /// Updates the displayed status from a full status or a status stream update.
+    /// </summary>
+    /// <param name="status"></param>
+    /// <param name="rsp"></param>
+    void update(int status, const json::object& rsp)
+    {
+        if (status != network::rest::http::HTTPPayload::StatusType::OK) {
+            // hosts that do not offer the status stream are polled instead
+            if (!m_polling && (status == ERRNO_BAD_API_RESPONSE || status == network::rest::http::HTTPPayload::StatusType::BAD_REQUEST)) {
+                ::LogWarning(LOG_HOST, "%s:%u, does not stream status, polling", m_chData.address().c_str(), m_chData.port());
+                RESTClientPool::instance()->unsubscribe(m_chData.address(), m_chData.port(), GET_STATUS_STREAM);
+                m_polling = true;
+                return;
+            }
+
+            ::LogError(LOG_HOST, "failed to get status for %s:%u, chNo = %u", m_chData.address().c_str(), m_chData.port(), m_channelNo);
+
+            // a failed stream has already timed out; polled status gets a few tries
+            if (m_polling) {
+                ++m_failCnt;
+                if (m_failCnt <= NODE_UPDATE_FAIL_CNT) {
+                    return;
+                }
+            }
+
+            m_failed = true;
+            setText("FAILED");
+            redraw();
+            return;
+        }
+
+        m_failCnt = 0U;
+        if (m_failed) {
+            m_failed = false;
+            setText("UNKNOWN");
+        }
+
+        // stream updates only carry the values that changed
+        for (auto& entry : rsp) {
+            m_status[entry.first] = entry.second;
+        }
+
+        try {
+            uint8_t mode = m_status["state"].get<uint8_t>();
+            switch (mode) {
+            case modem::STATE_DMR:
+                m_modeStr.setText("DMR");
+                break;
+            case modem::STATE_P25:
+                m_modeStr.setText("P25");
+                break;
+            case modem::STATE_NXDN:
+                m_modeStr.setText("NXDN");
+                break;
+            default:
+                m_modeStr.setText("");
+                break;
+            }
+
+            if (m_status["peerId"].is<uint32_t>()) {
+                m_peerId = m_status["peerId"].get<uint32_t>();
+                m_peerIdStr.setText(__INT_STR(m_peerId));
+            }
+
+            // get remote node state
+            if (m_status["dmrTSCCEnable"].is<bool>() && m_status["p25CtrlEnable"].is<bool>() &&
+                m_status["nxdnCtrlEnable"].is<bool>()) {
+                bool dmrTSCCEnable = m_status["dmrTSCCEnable"].get<bool>();
+                bool dmrCC = m_status["dmrCC"].get<bool>();
+                bool p25CtrlEnable = m_status["p25CtrlEnable"].get<bool>();
+                bool p25CC = m_status["p25CC"].get<bool>();
+                bool p25VOC = m_status["p25VOC"].get<bool>();
+                bool nxdnCtrlEnable = m_status["nxdnCtrlEnable"].get<bool>();
+                bool nxdnCC = m_status["nxdnCC"].get<bool>();
+
+                // are we a dedicated control channel?
+                if (dmrCC || p25CC || nxdnCC) {
+                    m_control = true;
+                    if (p25CC && p25VOC) {
+                        setText("CONTROL (VOC)");
+                    }
+                    else {
+                        setText("CONTROL");
+                    }
+                }
+
+                // if we aren't a dedicated control channel; set our
+                // title bar appropriately and set Tx state
+                if (!m_control) {
+                    if (dmrTSCCEnable || p25CtrlEnable || nxdnCtrlEnable) {
+                        setText("ENH. VOICE/CONV");
+                    }
+                    else {
+                        setText("VOICE/CONV");
+                    }
+
+                    // are we transmitting?
+                    if (m_status["tx"].is<bool>()) {
+                        m_tx = m_status["tx"].get<bool>();
+                    }
+                    else {
+                        ::LogWarning(LOG_HOST, "%s:%u, does not report Tx status");
+                        m_tx = false;
+                    }
+                }
+            }
+
+            // get the remote node channel information
+            if (m_status["channelId"].is<uint8_t>() && m_status["channelNo"].is<uint32_t>()) {
+                uint8_t channelId = m_status["channelId"].get<uint8_t>();
+                uint32_t channelNo = m_status["channelNo"].get<uint32_t>();
+
+                if (m_channelId != channelId && m_channelNo != channelNo) {
+                    m_channelId = channelId;
+                    m_channelNo = channelNo;
+
+                    calculateRxTx();
+                }
+            }
+            else {
+                ::LogWarning(LOG_HOST, "%s:%u, does not report channel information");
+            }
+
+            // report last known transmitted destination ID
+            if (m_status["lastDstId"].is<uint32_t>()) {
+                uint32_t lastDstId = m_status["lastDstId"].get<uint32_t>();
+                if (lastDstId == 0) {
+                    m_lastDst.setText("None");
+                }
+                else {
+                    m_lastDst.setText(__INT_STR(lastDstId));
+                }
+            }
+            else {
+                ::LogWarning(LOG_HOST, "%s:%u, does not report last TG information");
+            }
+
+            // report last known transmitted source ID
+            if (m_status["lastSrcId"].is<uint32_t>()) {
+                uint32_t lastSrcId = m_status["lastSrcId"].get<uint32_t>();
+                if (lastSrcId == 0) {
+                    m_lastSrc.setText("None");
+                }
+                else {
+                    m_lastSrc.setText(__INT_STR(lastSrcId));
+                }
+            }
+            else {
+                ::LogWarning(LOG_HOST, "%s:%u, does not report last source information");
+            }
+        }
+        catch (std::exception&) {
+            ::LogWarning(LOG_HOST, "%s:%u, failed to properly handle status", m_chData.address().c_str(), m_chData.port());
+        }
+
+        redraw();
+    }
+
     /*
     ** Event Handlers
     */
@@ -269,160 +450,12 @@ private:
     void onTimer(FTimerEvent* timer) override
     {
         if (timer != nullptr) {
-            // update timer
-            if (timer->getTimerId() == m_timerId) {
-                if (!m_failed) {
-                    // callback REST API to get status of the channel we represent
-                    json::object req = json::object();
-                    json::object rsp = json::object();
-                
-                    int ret = RESTClient::send(m_chData.address(), m_chData.port(), m_chData.password(),
-                        HTTP_GET, GET_STATUS, req, rsp, g_debug);
-                    if (ret != network::rest::http::HTTPPayload::StatusType::OK) {
-                        ::LogError(LOG_HOST, "failed to get status for %s:%u, chNo = %u", m_chData.address().c_str(), m_chData.port(), m_channelNo);
-                        ++m_failCnt;
-                        if (m_failCnt > NODE_UPDATE_FAIL_CNT) {
-                            m_failed = true;
-                            setText("FAILED");
-                        }
-                    }
-                    else {
-                        try {
-                            m_failCnt = 0U;
-
-                            uint8_t mode = rsp["state"].get<uint8_t>();
-                            switch (mode) {
-                            case modem::STATE_DMR:
-                                m_modeStr.setText("DMR");
-                                break;
-                            case modem::STATE_P25:
-                                m_modeStr.setText("P25");
-                                break;
-                            case modem::STATE_NXDN:
-                                m_modeStr.setText("NXDN");
-                                break;
-                            default:
-                                m_modeStr.setText("");
-                                break;
-                            }
-
-                            if (rsp["peerId"].is<uint32_t>()) {
-                                m_peerId = rsp["peerId"].get<uint32_t>();
-                                m_peerIdStr.setText(__INT_STR(m_peerId));
-                            }
-
-                            // get remote node state
-                            if (rsp["dmrTSCCEnable"].is<bool>() && rsp["p25CtrlEnable"].is<bool>() &&
-                                rsp["nxdnCtrlEnable"].is<bool>()) {
-                                bool dmrTSCCEnable = rsp["dmrTSCCEnable"].get<bool>();
-                                bool dmrCC = rsp["dmrCC"].get<bool>();
-                                bool p25CtrlEnable = rsp["p25CtrlEnable"].get<bool>();
-                                bool p25CC = rsp["p25CC"].get<bool>();
-                                bool p25VOC = rsp["p25VOC"].get<bool>();
-                                bool nxdnCtrlEnable = rsp["nxdnCtrlEnable"].get<bool>();
-                                bool nxdnCC = rsp["nxdnCC"].get<bool>();
-
-                                // are we a dedicated control channel?
-                                if (dmrCC || p25CC || nxdnCC) {
-                                    m_control = true;
-                                    if (p25CC && p25VOC) {
-                                        setText("CONTROL (VOC)");
-                                    }
-                                    else {
-                                        setText("CONTROL");
-                                    }
-                                }
-
-                                // if we aren't a dedicated control channel; set our
-                                // title bar appropriately and set Tx state
-                                if (!m_control) {
-                                    if (dmrTSCCEnable || p25CtrlEnable || nxdnCtrlEnable) {
-                                        setText("ENH. VOICE/CONV");
-                                    }
-                                    else {
-                                        setText("VOICE/CONV");
-                                    }
-
-                                    // are we transmitting?
-                                    if (rsp["tx"].is<bool>()) {
-                                        m_tx = rsp["tx"].get<bool>();
-                                    }
-                                    else {
-                                        ::LogWarning(LOG_HOST, "%s:%u, does not report Tx status");
-                                        m_tx = false;
-                                    }
-                                }
-                            }
-
-                            // get the remote node channel information
-                            if (rsp["channelId"].is<uint8_t>() && rsp["channelNo"].is<uint32_t>()) {
-                                uint8_t channelId = rsp["channelId"].get<uint8_t>();
-                                uint32_t channelNo = rsp["channelNo"].get<uint32_t>();
-
-                                if (m_channelId != channelId && m_channelNo != channelNo) {
-                                    m_channelId = channelId;
-                                    m_channelNo = channelNo;
-
-                                    calculateRxTx();
-                                }
-                            }
-                            else {
-                                ::LogWarning(LOG_HOST, "%s:%u, does not report channel information");
-                            }
-
-                            // report last known transmitted destination ID
-                            if (rsp["lastDstId"].is<uint32_t>()) {
-                                uint32_t lastDstId = rsp["lastDstId"].get<uint32_t>();
-                                if (lastDstId == 0) {
-                                    m_lastDst.setText("None");
-                                }
-                                else {
-                                    m_lastDst.setText(__INT_STR(lastDstId));
-                                }
-                            }
-                            else {
-                                ::LogWarning(LOG_HOST, "%s:%u, does not report last TG information");
-                            }
-
-                            // report last known transmitted source ID
-                            if (rsp["lastSrcId"].is<uint32_t>()) {
-                                uint32_t lastSrcId = rsp["lastSrcId"].get<uint32_t>();
-                                if (lastSrcId == 0) {
-                                    m_lastSrc.setText("None");
-                                }
-                                else {
-                                    m_lastSrc.setText(__INT_STR(lastSrcId));
-                                }
-                            }
-                            else {
-                                ::LogWarning(LOG_HOST, "%s:%u, does not report last source information");
-                            }
-                        }
-                        catch (std::exception&) {
-                            ::LogWarning(LOG_HOST, "%s:%u, failed to properly handle status", m_chData.address().c_str(), m_chData.port());
-                        }
-                    }
+            // poll timer
+            if (timer->getTimerId() == m_timerId && m_polling) {
+                if (!RESTClientPool::send(m_chData.address(), m_chData.port(), m_chData.password(), HTTP_GET, GET_STATUS, json::object(),
+                    [this](int status, const json::object& rsp) { update(status, rsp); }, g_debug)) {
+                    update(ERRNO_INTERNAL_ERROR, json::object());
                 }
-
-                redraw();
-            }
-
-            // reconnect timer
-            if (timer->getTimerId() == m_reconnectTimerId) {
-                if (m_failed) {
-                    ::LogInfoEx(LOG_HOST, "attempting to reconnect to %s:%u, chNo = %u", m_chData.address().c_str(), m_chData.port(), m_channelNo);
-                    // callback REST API to get status of the channel we represent
-                    json::object req = json::object();
-                    int ret = RESTClient::send(m_chData.address(), m_chData.port(), m_chData.password(),
-                        HTTP_GET, GET_STATUS, req, g_debug);
-                    if (ret == network::rest::http::HTTPPayload::StatusType::OK) {
-                        m_failed = false;
-                        m_failCnt = 0U;
-                        setText("UNKNOWN");
-                    }
-                }
-
-                redraw();
             }
         }
     }
@@ -77,6 +77,9 @@ BaseNetwork::BaseNetwork(uint32_t peerId, bool duplex, bool debug, bool slot1, b
     m_p25StreamId(0U),
     m_nxdnStreamId(0U),
     m_pktSeq(0U),
+    m_dmrPktSeq(nullptr),
+    m_p25PktSeq(0U),
+    m_nxdnPktSeq(0U),
     m_audio()
 {
     assert(peerId < 999999999U);
@@ -93,6 +96,10 @@ BaseNetwork::BaseNetwork(uint32_t peerId, bool duplex, bool debug, bool slot1, b
     m_dmrStreamId[1U] = createStreamId();
     m_p25StreamId = createStreamId();
     m_nxdnStreamId = createStreamId();
+
+    m_dmrPktSeq = new uint16_t[2U];
+    m_dmrPktSeq[0U] = 0U;
+    m_dmrPktSeq[1U] = 0U;
 }
 
 /// <summary>
@@ -109,6 +116,7 @@ BaseNetwork::~BaseNetwork()
     }
 
     delete[] m_dmrStreamId;
+    delete[] m_dmrPktSeq;
 }
 
 /// <summary>
@@ -198,12 +206,13 @@ void BaseNetwork::resetDMR(uint32_t slotNo)
 
     if (slotNo == 1U) {
         m_dmrStreamId[0U] = createStreamId();
+        m_dmrPktSeq[0U] = 0U;
     }
     else {
         m_dmrStreamId[1U] = createStreamId();
+        m_dmrPktSeq[1U] = 0U;
     }
 
-    m_pktSeq = 0U;
     m_rxDMRData.clear();
 }
 
@@ -213,7 +222,7 @@ void BaseNetwork::resetDMR(uint32_t slotNo)
 void BaseNetwork::resetP25()
 {
     m_p25StreamId = createStreamId();
-    m_pktSeq = 0U;
+    m_p25PktSeq = 0U;
     m_rxP25Data.clear();
 }
 
@@ -223,7 +232,7 @@ void BaseNetwork::resetP25()
 void BaseNetwork::resetNXDN()
 {
     m_nxdnStreamId = createStreamId();
-    m_pktSeq = 0U;
+    m_nxdnPktSeq = 0U;
     m_rxNXDNData.clear();
 }
 
@@ -330,7 +339,7 @@ bool BaseNetwork::writeDMR(const dmr::data::Data& data)
         return false;
     }
 
-    return writeMaster({ NET_FUNC_PROTOCOL, NET_PROTOCOL_SUBFUNC_DMR }, message.get(), messageLength, pktSeq(resetSeq), m_dmrStreamId[slotIndex]);
+    return writeMaster({ NET_FUNC_PROTOCOL, NET_PROTOCOL_SUBFUNC_DMR }, message.get(), messageLength, pktSeq(m_dmrPktSeq[slotIndex], resetSeq), m_dmrStreamId[slotIndex]);
 }
 
 /// <summary>
@@ -403,7 +412,7 @@ bool BaseNetwork::writeP25LDU1(const p25::lc::LC& control, const p25::data::LowS
         return false;
     }
 
-    return writeMaster({ NET_FUNC_PROTOCOL, NET_PROTOCOL_SUBFUNC_P25 }, message.get(), messageLength, pktSeq(resetSeq), m_p25StreamId);
+    return writeMaster({ NET_FUNC_PROTOCOL, NET_PROTOCOL_SUBFUNC_P25 }, message.get(), messageLength, pktSeq(m_p25PktSeq, resetSeq), m_p25StreamId);
 }
 
 /// <summary>
@@ -430,7 +439,7 @@ bool BaseNetwork::writeP25LDU2(const p25::lc::LC& control, const p25::data::LowS
         return false;
     }
 
-    return writeMaster({ NET_FUNC_PROTOCOL, NET_PROTOCOL_SUBFUNC_P25 }, message.get(), messageLength, pktSeq(resetSeq), m_p25StreamId);
+    return writeMaster({ NET_FUNC_PROTOCOL, NET_PROTOCOL_SUBFUNC_P25 }, message.get(), messageLength, pktSeq(m_p25PktSeq, resetSeq), m_p25StreamId);
 }
 
 /// <summary>
@@ -456,7 +465,7 @@ bool BaseNetwork::writeP25TDU(const p25::lc::LC& control, const p25::data::LowSp
         return false;
     }
 
-    return writeMaster({ NET_FUNC_PROTOCOL, NET_PROTOCOL_SUBFUNC_P25 }, message.get(), messageLength, pktSeq(resetSeq), m_p25StreamId);
+    return writeMaster({ NET_FUNC_PROTOCOL, NET_PROTOCOL_SUBFUNC_P25 }, message.get(), messageLength, pktSeq(m_p25PktSeq, resetSeq), m_p25StreamId);
 }
 
 /// <summary>
@@ -482,7 +491,7 @@ bool BaseNetwork::writeP25TSDU(const p25::lc::LC& control, const uint8_t* data)
         return false;
     }
 
-    return writeMaster({ NET_FUNC_PROTOCOL, NET_PROTOCOL_SUBFUNC_P25 }, message.get(), messageLength, pktSeq(resetSeq), m_p25StreamId);
+    return writeMaster({ NET_FUNC_PROTOCOL, NET_PROTOCOL_SUBFUNC_P25 }, message.get(), messageLength, pktSeq(m_p25PktSeq, resetSeq), m_p25StreamId);
 }
 
 /// <summary>
@@ -511,7 +520,7 @@ bool BaseNetwork::writeP25PDU(const p25::data::DataHeader& header, const uint8_t
         return false;
     }
 
-    return writeMaster({ NET_FUNC_PROTOCOL, NET_PROTOCOL_SUBFUNC_P25 }, message.get(), messageLength, pktSeq(resetSeq), m_p25StreamId);
+    return writeMaster({ NET_FUNC_PROTOCOL, NET_PROTOCOL_SUBFUNC_P25 }, message.get(), messageLength, pktSeq(m_p25PktSeq, resetSeq), m_p25StreamId);
 }
 
 /// <summary>
@@ -583,7 +592,7 @@ bool BaseNetwork::writeNXDN(const nxdn::lc::RTCH& lc, const uint8_t* data, const
         return false;
     }
 
-    return writeMaster({ NET_FUNC_PROTOCOL, NET_PROTOCOL_SUBFUNC_NXDN }, message.get(), messageLength, pktSeq(resetSeq), m_nxdnStreamId);
+    return writeMaster({ NET_FUNC_PROTOCOL, NET_PROTOCOL_SUBFUNC_NXDN }, message.get(), messageLength, pktSeq(m_nxdnPktSeq, resetSeq), m_nxdnStreamId);
 }
 
 /// <summary>
@@ -608,16 +617,28 @@ bool BaseNetwork::hasNXDNData() const
 /// <param name="reset"></param>
 /// <returns>RTP packet sequence.</returns>
 uint16_t BaseNetwork::pktSeq(bool reset)
+{
+    return pktSeq(m_pktSeq, reset);
+}
+
+/// <summary>
+/// Helper to update the RTP packet sequence of a call stream.
+/// </summary>
+/// <remarks>
+/// Each DMR slot, P25 and NXDN keep their own sequence; the receiver reorders frames by it,
+/// so a call starting on one stream must not restart the sequence of another.
+/// </remarks>
+/// <param name="seq">Sequence counter of the stream.</param>
+/// <param name="reset"></param>
+/// <returns>RTP packet sequence.</returns>
+uint16_t BaseNetwork::pktSeq(uint16_t& seq, bool reset)
 {
     if (reset) {
-        m_pktSeq = 0U;
+        seq = 0U;
     }
 
-    uint16_t curr = m_pktSeq;
-    ++m_pktSeq;
-    if (m_pktSeq > UINT16_MAX) {
-        m_pktSeq = 0U;
-    }
+    uint16_t curr = seq;
+    ++seq;
 
     return curr;
 }
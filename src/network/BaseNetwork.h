@@ -101,6 +101,8 @@ namespace network
     const uint8_t   NET_MASTER_SUBFUNC_BL_RID = 0x01U;                          // Blacklist RIDs
     const uint8_t   NET_MASTER_SUBFUNC_ACTIVE_TGS = 0x02U;                      // Active TGIDs
     const uint8_t   NET_MASTER_SUBFUNC_DEACTIVE_TGS = 0x03U;                    // Deactive TGIDs
+    const uint8_t   NET_MASTER_SUBFUNC_RID_DELTA = 0x04U;                       // RID List Delta
+    const uint8_t   NET_MASTER_SUBFUNC_TG_DELTA = 0x05U;                        // TGID List Delta
 
     const uint8_t   NET_FUNC_RPTL = 0x60U;                                      // Repeater Login
     const uint8_t   NET_FUNC_RPTK = 0x61U;                                      // Repeater Authorisation
@@ -121,6 +123,19 @@ namespace network
     const uint8_t   NET_TRANSFER_SUBFUNC_ACTIVITY = 0x01U;                      // Activity Log Transfer
     const uint8_t   NET_TRANSFER_SUBFUNC_DIAG = 0x02U;                          // Diagnostic Log Transfer
 
+    const uint32_t  LIST_DELTA_HEADER_LEN = 16U;    // from version + to version + chunk index + chunk count + record count
+    const uint32_t  LIST_DELTA_MAX_RECORDS = 1024U; // maximum records in a single list delta chunk
+    const uint32_t  LIST_DELTA_RID_RECORD_LEN = 5U; // 4 byte RID + 1 byte operation
+    const uint32_t  LIST_DELTA_TG_RECORD_LEN = 6U;  // 4 byte TGID + 1 byte slot + 1 byte operation
+
+    const uint8_t   LIST_DELTA_RID_BLACKLIST = 0x00U;                           // RID Blacklisted
+    const uint8_t   LIST_DELTA_RID_WHITELIST = 0x01U;                           // RID Whitelisted
+    const uint8_t   LIST_DELTA_RID_REMOVE = 0x02U;                              // RID Removed
+    const uint8_t   LIST_DELTA_TG_DEACTIVATE = 0x00U;                           // TGID Deactivated
+    const uint8_t   LIST_DELTA_TG_ACTIVATE = 0x01U;                             // TGID Activated
+
+    const uint32_t  PING_LIST_VERSION_LEN = 9U;     // 1 byte reserved + 4 byte RID list version + 4 byte TGID list version
+
     // ---------------------------------------------------------------------------
     //  Network Peer Connection Status
     // ---------------------------------------------------------------------------
@@ -157,6 +172,8 @@ namespace network
 
         /// <summary>Gets the frame queue for the network.</summary>
         FrameQueue* getFrameQueue() const { return m_frameQueue; }
+        /// <summary>Gets the UDP socket for the network.</summary>
+        UDPSocket* getSocket() const { return m_socket; }
 
         /// <summary>Writes a grant request to the network.</summary>
         bool writeGrantReq(const uint8_t mode, const uint32_t srcId, const uint32_t dstId, const uint8_t slot, const bool unitToUnit);
@@ -267,6 +284,8 @@ namespace network
 
         /// <summary>Helper to update the RTP packet sequence.</summary>
         uint16_t pktSeq(bool reset = false);
+        /// <summary>Helper to update the RTP packet sequence of a call stream.</summary>
+        static uint16_t pktSeq(uint16_t& seq, bool reset);
 
         /// <summary>Generates a new stream ID.</summary>
         uint32_t createStreamId() { std::uniform_int_distribution<uint32_t> dist(DVM_RAND_MIN, DVM_RAND_MAX); return dist(m_random); }
@@ -304,6 +323,9 @@ namespace network
         uint32_t m_nxdnStreamId;
 
         uint16_t m_pktSeq;
+        uint16_t* m_dmrPktSeq;
+        uint16_t m_p25PktSeq;
+        uint16_t m_nxdnPktSeq;
 
         p25::Audio m_audio;
     };
@@ -30,14 +30,18 @@
 #include "network/fne/TagDMRData.h"
 #include "network/fne/TagP25Data.h"
 #include "network/fne/TagNXDNData.h"
+#include "network/fne/PacketWorker.h"
+#include "network/fne/TalkgroupRoutingTable.h"
 #include "network/json/json.h"
 #include "Log.h"
+#include "Metrics.h"
 #include "StopWatch.h"
 #include "Utils.h"
 
 using namespace network;
 using namespace network::fne;
 
+#include <algorithm>
 #include <cstdio>
 #include <cassert>
 #include <cstdlib>
@@ -66,13 +70,16 @@ using namespace network::fne;
 /// <param name="trafficRepeat">Flag indicating if traffic should be repeated from this master.</param>
 /// <param name="pingTime"></param>
 /// <param name="updateLookupTime"></param>
+/// <param name="workerCnt">Number of packet worker threads (0 processes traffic on the calling thread).</param>
 FNENetwork::FNENetwork(HostFNE* host, const std::string& address, uint16_t port, uint32_t peerId, const std::string& password,
     bool debug, bool verbose, bool dmr, bool p25, bool nxdn, uint32_t parrotDelay, bool allowActivityTransfer, bool allowDiagnosticTransfer,
-    uint32_t pingTime, uint32_t updateLookupTime) :
+    uint32_t pingTime, uint32_t updateLookupTime, uint32_t workerCnt) :
     BaseNetwork(peerId, true, debug, true, true, allowActivityTransfer, allowDiagnosticTransfer),
     m_tagDMR(nullptr),
     m_tagP25(nullptr),
     m_tagNXDN(nullptr),
+    m_workers(),
+    m_workerCnt(workerCnt),
     m_host(host),
     m_address(address),
     m_port(port),
@@ -83,11 +90,23 @@ FNENetwork::FNENetwork(HostFNE* host, const std::string& address, uint16_t port,
     m_parrotDelay(parrotDelay),
     m_ridLookup(nullptr),
     m_tidLookup(nullptr),
+    m_tgRouting(nullptr),
+    m_tgRoutingPeers(0U),
+    m_tgRoutingPeersChanged(false),
+    m_ridVersions(),
+    m_tgVersions(),
+    m_ridGeneration(0U),
+    m_tgGeneration(0U),
     m_status(NET_STAT_INVALID),
     m_peers(),
+    m_peerMutex(),
     m_maintainenceTimer(1000U, pingTime),
     m_updateLookupTimer(1000U, (updateLookupTime * 60U)),
-    m_verbose(verbose)
+    m_verbose(verbose),
+    m_sendStatsTime(system_clock::hrc::now()),
+    m_lastDatagramsSent(0U),
+    m_lastSendCalls(0U),
+    m_syscallsSavedPerSec(0U)
 {
     assert(host != nullptr);
     assert(!address.empty());
@@ -97,6 +116,12 @@ FNENetwork::FNENetwork(HostFNE* host, const std::string& address, uint16_t port,
     m_tagDMR = new TagDMRData(this, debug);
     m_tagP25 = new TagP25Data(this, debug);
     m_tagNXDN = new TagNXDNData(this, debug);
+
+    // list versions start at a random point, so a version a peer holds from an earlier FNE instance
+    // is never mistaken for a current one
+    std::uniform_int_distribution<uint32_t> dist(DVM_RAND_MIN, DVM_RAND_MAX);
+    m_ridVersions.reset(dist(m_random));
+    m_tgVersions.reset(dist(m_random));
 }
 
 /// <summary>
@@ -104,9 +129,40 @@ FNENetwork::FNENetwork(HostFNE* host, const std::string& address, uint16_t port,
 /// </summary>
 FNENetwork::~FNENetwork()
 {
+    for (PacketWorker* worker : m_workers) {
+        delete worker;
+    }
+    m_workers.clear();
+
     delete m_tagDMR;
     delete m_tagP25;
     delete m_tagNXDN;
+
+    if (m_tgRouting != nullptr) {
+        delete m_tgRouting;
+    }
+}
+
+/// <summary>
+/// Gets whether any traffic handler has parrot frames waiting for playback.
+/// </summary>
+/// <returns></returns>
+bool FNENetwork::hasParrotFrames() const
+{
+#if defined(ENABLE_DMR)
+    if (m_tagDMR->hasParrotFrames())
+        return true;
+#endif // defined(ENABLE_DMR)
+#if defined(ENABLE_P25)
+    if (m_tagP25->hasParrotFrames())
+        return true;
+#endif // defined(ENABLE_P25)
+#if defined(ENABLE_NXDN)
+    if (m_tagNXDN->hasParrotFrames())
+        return true;
+#endif // defined(ENABLE_NXDN)
+
+    return false;
 }
 
 /// <summary>
@@ -118,6 +174,20 @@ void FNENetwork::setLookups(lookups::RadioIdLookup* ridLookup, lookups::Talkgrou
 {
     m_ridLookup = ridLookup;
     m_tidLookup = tidLookup;
+
+    // the traffic handlers make their repeat decisions from the precompiled routing cache
+    if (m_tgRouting != nullptr) {
+        delete m_tgRouting;
+        m_tgRouting = nullptr;
+    }
+
+    if (tidLookup != nullptr) {
+        m_tgRouting = new TalkgroupRoutingTable(tidLookup);
+
+        // compile the routes for any peers already connected
+        m_tgRoutingPeersChanged = true;
+        updateRoutes();
+    }
 }
 
 /// <summary>
@@ -134,11 +204,13 @@ void FNENetwork::clock(uint32_t ms)
 
     m_maintainenceTimer.clock(ms);
     if (m_maintainenceTimer.isRunning() && m_maintainenceTimer.hasExpired()) {
+        std::unique_lock<std::shared_timed_mutex> lock(m_peerMutex);
+
         // check to see if any peers have been quiet (no ping) longer than allowed
         std::vector<uint32_t> peersToRemove = std::vector<uint32_t>();
-        for (auto peer : m_peers) {
+        for (const auto& peer : m_peers) {
             uint32_t id = peer.first;
-            FNEPeerConnection connection = peer.second;
+            const FNEPeerConnection& connection = peer.second;
 
             if (connection.connected()) {
                 uint64_t dt = connection.lastPing() + (m_host->m_pingTime * m_host->m_maxMissedPings);
@@ -152,6 +224,15 @@ void FNENetwork::clock(uint32_t ms)
         // remove any peers
         for (uint32_t peerId : peersToRemove) {
             m_peers.erase(peerId);
+            Metrics::removePeer(peerId);
+        }
+
+        Metrics::set(METRIC_FNE_PEERS, m_peers.size());
+        lock.unlock();
+
+        updateNetworkStats();
+        if (m_verbose) {
+            logWorkerStats();
         }
 
         m_maintainenceTimer.start();
@@ -159,6 +240,8 @@ void FNENetwork::clock(uint32_t ms)
 
     m_updateLookupTimer.clock(ms);
     if (m_updateLookupTimer.isRunning() && m_updateLookupTimer.hasExpired()) {
+        std::unique_lock<std::shared_timed_mutex> lock(m_peerMutex);
+
         writeWhitelistRIDs();
         writeBlacklistRIDs();
         m_frameQueue->flushQueue();
@@ -167,6 +250,15 @@ void FNENetwork::clock(uint32_t ms)
         writeDeactiveTGIDs();
         m_frameQueue->flushQueue();
 
+        // peers accepting list deltas are only sent what changed since the versions they hold
+        updateListVersions();
+        for (const auto& peer : m_peers) {
+            if (peer.second.listDelta()) {
+                writeListDeltas(peer.second);
+            }
+        }
+        m_frameQueue->flushQueue();
+
         m_updateLookupTimer.start();
     }
 
@@ -176,410 +268,402 @@ void FNENetwork::clock(uint32_t ms)
     frame::RTPFNEHeader fneHeader;
     int length = 0U;
 
-    // read message
-    UInt8Array buffer = m_frameQueue->read(length, address, addrLen, &rtpHeader, &fneHeader);
-    if (length > 0) {
-        if (m_debug)
-            Utils::dump(1U, "Network Message", buffer.get(), length);
-
-        uint32_t peerId = fneHeader.getPeerId();
-        uint32_t streamId = fneHeader.getStreamId();
-
-        // update current peer packet sequence and stream ID
-        if (peerId > 0 && (m_peers.find(peerId) != m_peers.end()) && streamId != 0U) {
-            FNEPeerConnection connection = m_peers[peerId];
-
-            uint16_t pktSeq = rtpHeader.getSequence();
+    // read messages; a single batched read may return several datagrams, process all of them in this pass
+    bool received = false;
+    do {
+        UInt8Array buffer = m_frameQueue->read(length, address, addrLen, &rtpHeader, &fneHeader);
+        if (length > 0) {
+            received = true;
+            if (m_debug)
+                Utils::dump(1U, "Network Message", buffer.get(), length);
+
+            uint32_t peerId = fneHeader.getPeerId();
+            uint32_t streamId = fneHeader.getStreamId();
+
+            std::unique_lock<std::shared_timed_mutex> lock(m_peerMutex);
+
+            // update current peer packet sequence and stream ID
+            FNEPeerConnection* connection = m_peers.find(peerId);
+            if (connection != nullptr && streamId != 0U) {
+                uint16_t pktSeq = rtpHeader.getSequence();
+
+                if ((connection->currStreamId() == streamId) && (pktSeq != connection->pktNextSeq())) {
+                    LogWarning(LOG_NET, "PEER %u Stream %u out-of-sequence; %u != %u", peerId, streamId, pktSeq, connection->pktNextSeq());
+
+                    // a sequence ahead of the expected one means packets were lost; behind it, this one is late
+                    uint16_t gap = (uint16_t)(pktSeq - connection->pktNextSeq());
+                    if (gap < 0x8000U)
+                        Metrics::peerPacketLoss(peerId, gap, 0U);
+                    else
+                        Metrics::peerPacketLoss(peerId, 0U, 1U);
+                }
 
-            if ((connection.currStreamId() == streamId) && (pktSeq != connection.pktNextSeq())) {
-                LogWarning(LOG_NET, "PEER %u Stream %u out-of-sequence; %u != %u", peerId, streamId, pktSeq, connection.pktNextSeq());
+                connection->currStreamId(streamId);
+                connection->pktLastSeq(pktSeq);
+                connection->pktNextSeq(pktSeq + 1);
+                if (connection->pktNextSeq() > UINT16_MAX) {
+                    connection->pktNextSeq(0U);
+                }
             }
 
-            connection.currStreamId(streamId);
-            connection.pktLastSeq(pktSeq);
-            connection.pktNextSeq(pktSeq + 1);
-            if (connection.pktNextSeq() > UINT16_MAX) {
-                connection.pktNextSeq(0U);
+            // if we don't have a stream ID and are receiving call data -- throw an error and discard
+            if (streamId == 0 && fneHeader.getFunction() == NET_FUNC_PROTOCOL)
+            {
+                LogError(LOG_NET, "PEER %u Malformed packet (no stream ID for a call?)", peerId);
+                continue;
             }
 
-            m_peers[peerId] = connection;
-        }
-
-        // if we don't have a stream ID and are receiving call data -- throw an error and discard
-        if (streamId == 0 && fneHeader.getFunction() == NET_FUNC_PROTOCOL)
-        {
-            LogError(LOG_NET, "PEER %u Malformed packet (no stream ID for a call?)", peerId);
-            return;
-        }
+            // process incoming message frame opcodes
+            switch (fneHeader.getFunction()) {
+            case NET_FUNC_PROTOCOL:
+                {
+                    if (fneHeader.getSubFunction() != NET_PROTOCOL_SUBFUNC_DMR && fneHeader.getSubFunction() != NET_PROTOCOL_SUBFUNC_P25 &&
+                        fneHeader.getSubFunction() != NET_PROTOCOL_SUBFUNC_NXDN) {
+                        Utils::dump("Unknown protocol opcode from peer", buffer.get(), length);
+                        break;
+                    }
 
-        // process incoming message frame opcodes
-        switch (fneHeader.getFunction()) {
-        case NET_FUNC_PROTOCOL:
-            {
-                if (fneHeader.getSubFunction() == NET_PROTOCOL_SUBFUNC_DMR) {           // Encapsulated DMR data frame
-                    if (peerId > 0 && (m_peers.find(peerId) != m_peers.end())) {
-                        FNEPeerConnection connection = m_peers[peerId];
+                    connection = m_peers.find(peerId);
+                    if (connection != nullptr) {
                         std::string ip = UDPSocket::address(address);
 
                         // validate peer (simple validation really)
-                        if (connection.connected() && connection.address() == ip) {
-#if defined(ENABLE_DMR)
-                            if (m_dmrEnabled) {
-                                if (m_tagDMR != nullptr) {
-                                    m_tagDMR->processFrame(buffer.get(), length, peerId, rtpHeader.getSequence(), streamId);
+                        if (connection->connected() && connection->address() == ip) {
+                            // the traffic handlers take the peer lock themselves
+                            lock.unlock();
+
+                            if (m_workers.size() > 0U) {
+                                // shard by stream ID; every frame of a stream lands on the same worker in order
+                                PacketWorker* worker = m_workers[streamId % m_workers.size()];
+                                if (!worker->enqueue(fneHeader.getSubFunction(), buffer, length, peerId, rtpHeader.getSequence(), streamId)) {
+                                    LogWarning(LOG_NET, "PEER %u Stream %u dropped, packet worker %u queue full", peerId, streamId, worker->index());
                                 }
                             }
-#endif // defined(ENABLE_DMR)
-                        }
-                    }
-                }
-                else if (fneHeader.getSubFunction() == NET_PROTOCOL_SUBFUNC_P25) {      // Encapsulated P25 data frame
-                    if (peerId > 0 && (m_peers.find(peerId) != m_peers.end())) {
-                        FNEPeerConnection connection = m_peers[peerId];
-                        std::string ip = UDPSocket::address(address);
-
-                        // validate peer (simple validation really)
-                        if (connection.connected() && connection.address() == ip) {
-#if defined(ENABLE_P25)
-                            if (m_p25Enabled) {
-                                if (m_tagP25 != nullptr) {
-                                    m_tagP25->processFrame(buffer.get(), length, peerId, rtpHeader.getSequence(), streamId);
-                                }
+                            else {
+                                processFrame(fneHeader.getSubFunction(), buffer.get(), length, peerId, rtpHeader.getSequence(), streamId);
                             }
-#endif // defined(ENABLE_P25)
                         }
                     }
                 }
-                else if (fneHeader.getSubFunction() == NET_PROTOCOL_SUBFUNC_NXDN) {     // Encapsulated NXDN data frame
-                    if (peerId > 0 && (m_peers.find(peerId) != m_peers.end())) {
-                        FNEPeerConnection connection = m_peers[peerId];
-                        std::string ip = UDPSocket::address(address);
+                break;
 
-                        // validate peer (simple validation really)
-                        if (connection.connected() && connection.address() == ip) {
-#if defined(ENABLE_NXDN)        
-                            if (m_nxdnEnabled) {
-                                if (m_tagNXDN != nullptr) {
-                                    m_tagNXDN->processFrame(buffer.get(), length, peerId, rtpHeader.getSequence(), streamId);
-                                }
-                            }
-#endif // defined(ENABLE_NXDN)
-                        }
-                    }
-                }
-                else {
-                    Utils::dump("Unknown protocol opcode from peer", buffer.get(), length);
-                }
-            }
-            break;
+            case NET_FUNC_RPTL:                                                             // Repeater Login
+                {
+                    if (peerId > 0 && (m_peers.find(peerId) == nullptr)) {
+                        connection = &m_peers.add(peerId, FNEPeerConnection(peerId, address, addrLen));
+                        connection->lastPing(now);
+                        connection->currStreamId(streamId);
 
-        case NET_FUNC_RPTL:                                                             // Repeater Login
-            {
-                if (peerId > 0 && (m_peers.find(peerId) == m_peers.end())) {
-                    FNEPeerConnection connection = FNEPeerConnection(peerId, address, addrLen);
-                    connection.lastPing(now);
-                    connection.currStreamId(streamId);
+                        std::uniform_int_distribution<uint32_t> dist(DVM_RAND_MIN, DVM_RAND_MAX);
+                        connection->salt(dist(m_random));
 
-                    std::uniform_int_distribution<uint32_t> dist(DVM_RAND_MIN, DVM_RAND_MAX);
-                    connection.salt(dist(m_random));
+                        LogInfoEx(LOG_NET, "Repeater logging in with PEER %u, %s:%u", peerId, connection->address().c_str(), connection->port());
 
-                    LogInfoEx(LOG_NET, "Repeater logging in with PEER %u, %s:%u", peerId, connection.address().c_str(), connection.port());
+                        connection->connectionState(NET_STAT_WAITING_AUTHORISATION);
 
-                    connection.connectionState(NET_STAT_WAITING_AUTHORISATION);
-                    m_peers[peerId] = connection;
+                        // transmit salt to peer
+                        uint8_t salt[4U];
+                        ::memset(salt, 0x00U, 4U);
+                        __SET_UINT32(connection->salt(), salt, 0U);
 
-                    // transmit salt to peer
-                    uint8_t salt[4U];
-                    ::memset(salt, 0x00U, 4U);
-                    __SET_UINT32(connection.salt(), salt, 0U);
+                        writePeerACK(peerId, salt, 4U);
+                        LogInfoEx(LOG_NET, "Challenge response send to PEER %u for login", peerId);
+                    }
+                    else {
+                        writePeerNAK(peerId, TAG_REPEATER_LOGIN, address, addrLen);
 
-                    writePeerACK(peerId, salt, 4U);
-                    LogInfoEx(LOG_NET, "Challenge response send to PEER %u for login", peerId);
-                }
-                else {
-                    writePeerNAK(peerId, TAG_REPEATER_LOGIN, address, addrLen);
-
-                    // check if the peer is in our peer list -- if he is, and he isn't in a running state, reset
-                    // the login sequence
-                    if (peerId > 0 && (m_peers.find(peerId) != m_peers.end())) {
-                        FNEPeerConnection connection = m_peers[peerId];
-                        connection.lastPing(now);
-
-                        if (connection.connectionState() != NET_STAT_RUNNING) {
-                            auto it = std::find_if(m_peers.begin(), m_peers.end(), [&](PeerMapPair x) { return x.first == peerId; });
-                            if (it != m_peers.end()) {
+                        // check if the peer is in our peer list -- if he is, and he isn't in a running state, reset
+                        // the login sequence
+                        connection = m_peers.find(peerId);
+                        if (connection != nullptr) {
+                            connection->lastPing(now);
+
+                            if (connection->connectionState() != NET_STAT_RUNNING) {
                                 m_peers.erase(peerId);
+                                Metrics::removePeer(peerId);
                             }
                         }
                     }
                 }
-            }
-            break;
-        case NET_FUNC_RPTK:                                                             // Repeater Authentication
-            {
-                if (peerId > 0 && (m_peers.find(peerId) != m_peers.end())) {
-                    FNEPeerConnection connection = m_peers[peerId];
-                    connection.lastPing(now);
-
-                    if (connection.connectionState() == NET_STAT_WAITING_AUTHORISATION) {
-                        // get the hash from the frame message
-                        uint8_t hash[length - 8U];
-                        ::memset(hash, 0x00U, length - 8U);
-                        ::memcpy(hash, buffer.get() + 8U, length - 8U);
-
-                        // generate our own hash
-                        uint8_t salt[4U];
-                        ::memset(salt, 0x00U, 4U);
-                        __SET_UINT32(connection.salt(), salt, 0U);
-
-                        size_t size = m_password.size();
-                        uint8_t* in = new uint8_t[size + sizeof(uint32_t)];
-                        ::memcpy(in, salt, sizeof(uint32_t));
-                        for (size_t i = 0U; i < size; i++)
-                            in[i + sizeof(uint32_t)] = m_password.at(i);
-
-                        uint8_t out[32U];
-                        edac::SHA256 sha256;
-                        sha256.buffer(in, (uint32_t)(size + sizeof(uint32_t)), out);
-
-                        delete[] in;
-
-                        // validate hash
-                        bool valid = false;
-                        if (length - 8U == 32U) {
-                            valid = true;
-                            for (uint8_t i = 0; i < 32U; i++) {
-                                if (hash[i] != out[i]) {
-                                    valid = false;
-                                    break;
+                break;
+            case NET_FUNC_RPTK:                                                             // Repeater Authentication
+                {
+                    connection = m_peers.find(peerId);
+                    if (connection != nullptr) {
+                        connection->lastPing(now);
+
+                        if (connection->connectionState() == NET_STAT_WAITING_AUTHORISATION) {
+                            // get the hash from the frame message
+                            uint8_t hash[length - 8U];
+                            ::memset(hash, 0x00U, length - 8U);
+                            ::memcpy(hash, buffer.get() + 8U, length - 8U);
+
+                            // generate our own hash
+                            uint8_t salt[4U];
+                            ::memset(salt, 0x00U, 4U);
+                            __SET_UINT32(connection->salt(), salt, 0U);
+
+                            size_t size = m_password.size();
+                            uint8_t* in = new uint8_t[size + sizeof(uint32_t)];
+                            ::memcpy(in, salt, sizeof(uint32_t));
+                            for (size_t i = 0U; i < size; i++)
+                                in[i + sizeof(uint32_t)] = m_password.at(i);
+
+                            uint8_t out[32U];
+                            edac::SHA256 sha256;
+                            sha256.buffer(in, (uint32_t)(size + sizeof(uint32_t)), out);
+
+                            delete[] in;
+
+                            // validate hash
+                            bool valid = false;
+                            if (length - 8U == 32U) {
+                                valid = true;
+                                for (uint8_t i = 0; i < 32U; i++) {
+                                    if (hash[i] != out[i]) {
+                                        valid = false;
+                                        break;
+                                    }
                                 }
                             }
-                        }
 
-                        if (valid) {
-                            connection.connectionState(NET_STAT_WAITING_CONFIG);
-                            writePeerACK(peerId);
-                            LogInfoEx(LOG_NET, "PEER %u has completed the login exchange", peerId);
+                            if (valid) {
+                                connection->connectionState(NET_STAT_WAITING_CONFIG);
+                                writePeerACK(peerId);
+                                LogInfoEx(LOG_NET, "PEER %u has completed the login exchange", peerId);
+                            }
+                            else {
+                                LogWarning(LOG_NET, "PEER %u has failed the login exchange", peerId);
+                                writePeerNAK(peerId, TAG_REPEATER_AUTH);
+                                m_peers.erase(peerId);
+                                Metrics::removePeer(peerId);
+                            }
                         }
                         else {
-                            LogWarning(LOG_NET, "PEER %u has failed the login exchange", peerId);
+                            LogWarning(LOG_NET, "PEER %u tried login exchange while in an incorrect state?", peerId);
                             writePeerNAK(peerId, TAG_REPEATER_AUTH);
-                            auto it = std::find_if(m_peers.begin(), m_peers.end(), [&](PeerMapPair x) { return x.first == peerId; });
-                            if (it != m_peers.end()) {
-                                m_peers.erase(peerId);
-                            }
+                            m_peers.erase(peerId);
+                            Metrics::removePeer(peerId);
                         }
-
-                        m_peers[peerId] = connection;
                     }
                     else {
-                        LogWarning(LOG_NET, "PEER %u tried login exchange while in an incorrect state?", peerId);
-                        writePeerNAK(peerId, TAG_REPEATER_AUTH);
-                        auto it = std::find_if(m_peers.begin(), m_peers.end(), [&](PeerMapPair x) { return x.first == peerId; });
-                        if (it != m_peers.end()) {
-                            m_peers.erase(peerId);
-                        }
+                        writePeerNAK(peerId, TAG_REPEATER_AUTH, address, addrLen);
                     }
                 }
-                else {
-                    writePeerNAK(peerId, TAG_REPEATER_AUTH, address, addrLen);
-                }
-            }
-            break;
-        case NET_FUNC_RPTC:                                                             // Repeater Configuration
-            {
-                if (peerId > 0 && (m_peers.find(peerId) != m_peers.end())) {
-                    FNEPeerConnection connection = m_peers[peerId];
-                    connection.lastPing(now);
-
-                    if (connection.connectionState() == NET_STAT_WAITING_CONFIG) {
-                        uint8_t rawPayload[length - 8U];
-                        ::memset(rawPayload, 0x00U, length - 8U);
-                        ::memcpy(rawPayload, buffer.get() + 8U, length - 8U);
-                        std::string payload(rawPayload, rawPayload + (length - 8U));
-
-                        // parse JSON body
-                        json::value v;
-                        std::string err = json::parse(v, payload);
-                        if (!err.empty()) {
-                            LogWarning(LOG_NET, "PEER %u has supplied invalid configuration data", peerId);
-                            writePeerNAK(peerId, TAG_REPEATER_AUTH);
-                            auto it = std::find_if(m_peers.begin(), m_peers.end(), [&](PeerMapPair x) { return x.first == peerId; });
-                            if (it != m_peers.end()) {
-                                m_peers.erase(peerId);
-                            }
-                        }
-                        else  {
-                            // ensure parsed JSON is an object
-                            if (!v.is<json::object>()) {
+                break;
+            case NET_FUNC_RPTC:                                                             // Repeater Configuration
+                {
+                    connection = m_peers.find(peerId);
+                    if (connection != nullptr) {
+                        connection->lastPing(now);
+
+                        if (connection->connectionState() == NET_STAT_WAITING_CONFIG) {
+                            uint8_t rawPayload[length - 8U];
+                            ::memset(rawPayload, 0x00U, length - 8U);
+                            ::memcpy(rawPayload, buffer.get() + 8U, length - 8U);
+                            std::string payload(rawPayload, rawPayload + (length - 8U));
+
+                            // parse JSON body
+                            json::value v;
+                            std::string err = json::parse(v, payload);
+                            if (!err.empty()) {
                                 LogWarning(LOG_NET, "PEER %u has supplied invalid configuration data", peerId);
                                 writePeerNAK(peerId, TAG_REPEATER_AUTH);
-                                auto it = std::find_if(m_peers.begin(), m_peers.end(), [&](PeerMapPair x) { return x.first == peerId; });
-                                if (it != m_peers.end()) {
+                                m_peers.erase(peerId);
+                                Metrics::removePeer(peerId);
+                            }
+                            else  {
+                                // ensure parsed JSON is an object
+                                if (!v.is<json::object>()) {
+                                    LogWarning(LOG_NET, "PEER %u has supplied invalid configuration data", peerId);
+                                    writePeerNAK(peerId, TAG_REPEATER_AUTH);
                                     m_peers.erase(peerId);
+                                    Metrics::removePeer(peerId);
+                                }
+                                else {
+                                    json::object peerConfig = v.get<json::object>();
+                                    connection->config(peerConfig);
+                                    connection->connectionState(NET_STAT_RUNNING);
+                                    m_tgRoutingPeersChanged = true;
+                                    connection->connected(true);
+                                    connection->pingsReceived(0U);
+                                    connection->lastPing(now);
+
+                                    // peers that accept list deltas report the list versions they already hold
+                                    connection->listDelta(peerConfig["listDelta"].is<bool>() && peerConfig["listDelta"].get<bool>());
+                                    if (connection->listDelta()) {
+                                        connection->ridListVersion(peerConfig["ridListVersion"].is<uint32_t>() ? peerConfig["ridListVersion"].get<uint32_t>() : 0U);
+                                        connection->tgListVersion(peerConfig["tgListVersion"].is<uint32_t>() ? peerConfig["tgListVersion"].get<uint32_t>() : 0U);
+                                    }
+
+                                    writePeerACK(peerId);
+                                    LogInfoEx(LOG_NET, "PEER %u has completed the configuration exchange", peerId);
+
+                                    // queue final update messages and flush
+                                    if (connection->listDelta()) {
+                                        updateListVersions();
+                                        writeListDeltas(*connection);
+                                        m_frameQueue->flushQueue();
+                                    }
+                                    else {
+                                        writeWhitelistRIDs(peerId, true);
+                                        writeBlacklistRIDs(peerId, true);
+                                        m_frameQueue->flushQueue();
+
+                                        writeTGIDs(peerId, true);
+                                        writeDeactiveTGIDs(peerId, true);
+                                        m_frameQueue->flushQueue();
+                                    }
                                 }
-                            }
-                            else {
-                                connection.config(v.get<json::object>());
-                                connection.connectionState(NET_STAT_RUNNING);
-                                connection.connected(true);
-                                connection.pingsReceived(0U);
-                                connection.lastPing(now);
-                                m_peers[peerId] = connection;
-
-                                writePeerACK(peerId);
-                                LogInfoEx(LOG_NET, "PEER %u has completed the configuration exchange", peerId);
-
-                                // queue final update messages and flush
-                                writeWhitelistRIDs(peerId, true);
-                                writeBlacklistRIDs(peerId, true);
-                                m_frameQueue->flushQueue();
-
-                                writeTGIDs(peerId, true);
-                                writeDeactiveTGIDs(peerId, true);
-                                m_frameQueue->flushQueue();
                             }
                         }
-                    }
-                    else {
-                        LogWarning(LOG_NET, "PEER %u tried login exchange while in an incorrect state?", peerId);
-                        writePeerNAK(peerId, TAG_REPEATER_CONFIG);
-                        auto it = std::find_if(m_peers.begin(), m_peers.end(), [&](PeerMapPair x) { return x.first == peerId; });
-                        if (it != m_peers.end()) {
+                        else {
+                            LogWarning(LOG_NET, "PEER %u tried login exchange while in an incorrect state?", peerId);
+                            writePeerNAK(peerId, TAG_REPEATER_CONFIG);
                             m_peers.erase(peerId);
+                            Metrics::removePeer(peerId);
                         }
                     }
+                    else {
+                        writePeerNAK(peerId, TAG_REPEATER_CONFIG, address, addrLen);
+                    }
                 }
-                else {
-                    writePeerNAK(peerId, TAG_REPEATER_CONFIG, address, addrLen);
-                }
-            }
-            break;
+                break;
 
-        case NET_FUNC_RPT_CLOSING:                                                      // Repeater Closing (Disconnect)
-            {
-                if (peerId > 0 && (m_peers.find(peerId) != m_peers.end())) {
-                    FNEPeerConnection connection = m_peers[peerId];
-                    std::string ip = UDPSocket::address(address);
+            case NET_FUNC_RPT_CLOSING:                                                      // Repeater Closing (Disconnect)
+                {
+                    connection = m_peers.find(peerId);
+                    if (connection != nullptr) {
+                        std::string ip = UDPSocket::address(address);
 
-                    // validate peer (simple validation really)
-                    if (connection.connected() && connection.address() == ip) {
-                        LogInfoEx(LOG_NET, "PEER %u is closing down", peerId);
+                        // validate peer (simple validation really)
+                        if (connection->connected() && connection->address() == ip) {
+                            LogInfoEx(LOG_NET, "PEER %u is closing down", peerId);
 
-                        auto it = std::find_if(m_peers.begin(), m_peers.end(), [&](PeerMapPair x) { return x.first == peerId; });
-                        if (it != m_peers.end()) {
                             m_peers.erase(peerId);
+                            Metrics::removePeer(peerId);
                         }
                     }
                 }
-            }
-            break;
-        case NET_FUNC_PING:                                                             // Repeater Ping
-            {
-                if (peerId > 0 && (m_peers.find(peerId) != m_peers.end())) {
-                    FNEPeerConnection connection = m_peers[peerId];
-                    std::string ip = UDPSocket::address(address);
-
-                    // validate peer (simple validation really)
-                    if (connection.connected() && connection.address() == ip) {
-                        uint32_t pingsRx = connection.pingsReceived();
-                        connection.pingsReceived(pingsRx++);
-                        connection.lastPing(now);
-                        connection.pktLastSeq(connection.pktLastSeq() + 1);
-
-                        m_peers[peerId] = connection;
-                        writePeerCommand(peerId, { NET_FUNC_PONG, NET_SUBFUNC_NOP });
-
-                        if (m_debug) {
-                            LogDebug(LOG_NET, "PEER %u ping received and answered", peerId);
+                break;
+            case NET_FUNC_PING:                                                             // Repeater Ping
+                {
+                    connection = m_peers.find(peerId);
+                    if (connection != nullptr) {
+                        std::string ip = UDPSocket::address(address);
+
+                        // validate peer (simple validation really)
+                        if (connection->connected() && connection->address() == ip) {
+                            uint32_t pingsRx = connection->pingsReceived();
+                            connection->pingsReceived(pingsRx++);
+                            connection->lastPing(now);
+                            connection->pktLastSeq(connection->pktLastSeq() + 1);
+
+                            // peers that accept list deltas report the list versions they hold with each ping
+                            if (connection->listDelta() && length >= (int)PING_LIST_VERSION_LEN) {
+                                uint32_t ridListVersion = __GET_UINT32(buffer, 1U);
+                                uint32_t tgListVersion = __GET_UINT32(buffer, 5U);
+                                connection->ridListVersion(ridListVersion);
+                                connection->tgListVersion(tgListVersion);
+                            }
+
+                            writePeerCommand(peerId, { NET_FUNC_PONG, NET_SUBFUNC_NOP });
+
+                            if (m_debug) {
+                                LogDebug(LOG_NET, "PEER %u ping received and answered", peerId);
+                            }
+                        }
+                        else {
+                            writePeerNAK(peerId, TAG_REPEATER_PING);
                         }
-                    }
-                    else {
-                        writePeerNAK(peerId, TAG_REPEATER_PING);
                     }
                 }
-            }
-            break;
+                break;
 
-        case NET_FUNC_GRANT_REQ:                                                        // Repeater Grant Request
-            {
-                if (peerId > 0 && (m_peers.find(peerId) != m_peers.end())) {
-                    FNEPeerConnection connection = m_peers[peerId];
-                    std::string ip = UDPSocket::address(address);
+            case NET_FUNC_GRANT_REQ:                                                        // Repeater Grant Request
+                {
+                    connection = m_peers.find(peerId);
+                    if (connection != nullptr) {
+                        std::string ip = UDPSocket::address(address);
 
-                    // validate peer (simple validation really)
-                    if (connection.connected() && connection.address() == ip) {
-                        /* ignored */
-                    }
-                    else {
-                        writePeerNAK(peerId, TAG_REPEATER_GRANT);
+                        // validate peer (simple validation really)
+                        if (connection->connected() && connection->address() == ip) {
+                            /* ignored */
+                        }
+                        else {
+                            writePeerNAK(peerId, TAG_REPEATER_GRANT);
+                        }
                     }
                 }
-            }
-            break;
-
-        case NET_FUNC_TRANSFER:
-            {
-                if (fneHeader.getSubFunction() == NET_TRANSFER_SUBFUNC_ACTIVITY) {      // Peer Activity Log Transfer
-                    if (m_allowActivityTransfer) {
-                        if (peerId > 0 && (m_peers.find(peerId) != m_peers.end())) {
-                            FNEPeerConnection connection = m_peers[peerId];
-                            std::string ip = UDPSocket::address(address);
-
-                            // validate peer (simple validation really)
-                            if (connection.connected() && connection.address() == ip) {
-                                uint8_t rawPayload[length - 11U];
-                                ::memset(rawPayload, 0x00U, length - 11U);
-                                ::memcpy(rawPayload, buffer.get() + 11U, length - 11U);
-                                std::string payload(rawPayload, rawPayload + (length - 11U));
-
-                                std::stringstream ss;
-                                ss << peerId << " " << payload;
-
-                                ::ActivityLog("", false, ss.str().c_str());
-                            }
-                            else {
-                                writePeerNAK(peerId, TAG_TRANSFER_ACT_LOG);
+                break;
+
+            case NET_FUNC_TRANSFER:
+                {
+                    if (fneHeader.getSubFunction() == NET_TRANSFER_SUBFUNC_ACTIVITY) {      // Peer Activity Log Transfer
+                        if (m_allowActivityTransfer) {
+                            connection = m_peers.find(peerId);
+                            if (connection != nullptr) {
+                                std::string ip = UDPSocket::address(address);
+
+                                // validate peer (simple validation really)
+                                if (connection->connected() && connection->address() == ip) {
+                                    uint8_t rawPayload[length - 11U];
+                                    ::memset(rawPayload, 0x00U, length - 11U);
+                                    ::memcpy(rawPayload, buffer.get() + 11U, length - 11U);
+                                    std::string payload(rawPayload, rawPayload + (length - 11U));
+
+                                    std::stringstream ss;
+                                    ss << peerId << " " << payload;
+
+                                    ::ActivityLog("", false, ss.str().c_str());
+                                }
+                                else {
+                                    writePeerNAK(peerId, TAG_TRANSFER_ACT_LOG);
+                                }
                             }
                         }
                     }
-                }
-                else if (fneHeader.getSubFunction() == NET_TRANSFER_SUBFUNC_DIAG) {     // Peer Diagnostic Log Transfer
-                    if (m_allowDiagnosticTransfer) {
-                        if (peerId > 0 && (m_peers.find(peerId) != m_peers.end())) {
-                            FNEPeerConnection connection = m_peers[peerId];
-                            std::string ip = UDPSocket::address(address);
-
-                            // validate peer (simple validation really)
-                            if (connection.connected() && connection.address() == ip) {
-                                uint8_t rawPayload[length - 11U];
-                                ::memset(rawPayload, 0x00U, length - 11U);
-                                ::memcpy(rawPayload, buffer.get() + 11U, length - 11U);
-                                std::string payload(rawPayload, rawPayload + (length - 11U));
-
-                                bool currState = g_disableTimeDisplay;
-                                g_disableTimeDisplay = true;
-                                ::Log(9999U, nullptr, "%u %s", peerId, payload.c_str());
-                                g_disableTimeDisplay = currState;
-                            }
-                            else {
-                                writePeerNAK(peerId, TAG_TRANSFER_DIAG_LOG);
+                    else if (fneHeader.getSubFunction() == NET_TRANSFER_SUBFUNC_DIAG) {     // Peer Diagnostic Log Transfer
+                        if (m_allowDiagnosticTransfer) {
+                            connection = m_peers.find(peerId);
+                            if (connection != nullptr) {
+                                std::string ip = UDPSocket::address(address);
+
+                                // validate peer (simple validation really)
+                                if (connection->connected() && connection->address() == ip) {
+                                    uint8_t rawPayload[length - 11U];
+                                    ::memset(rawPayload, 0x00U, length - 11U);
+                                    ::memcpy(rawPayload, buffer.get() + 11U, length - 11U);
+                                    std::string payload(rawPayload, rawPayload + (length - 11U));
+
+                                    bool currState = g_disableTimeDisplay;
+                                    g_disableTimeDisplay = true;
+                                    ::Log(9999U, nullptr, "%u %s", peerId, payload.c_str());
+                                    g_disableTimeDisplay = currState;
+                                }
+                                else {
+                                    writePeerNAK(peerId, TAG_TRANSFER_DIAG_LOG);
+                                }
                             }
                         }
                     }
+                    else {
+                        Utils::dump("Unknown transfer opcode from the peer", buffer.get(), length);
+                    }
                 }
-                else {
-                    Utils::dump("Unknown transfer opcode from the peer", buffer.get(), length);
-                }
-            }
-            break;
+                break;
 
-        default:
-            Utils::dump("Unknown opcode from the peer", buffer.get(), length);
-            break;
+            default:
+                Utils::dump("Unknown opcode from the peer", buffer.get(), length);
+                break;
+            }
         }
-    }
-    else {
+    } while (m_frameQueue->hasPending());
+
+    // routes are recompiled here, never on the frame path
+    updateRoutes();
+
+    if (!received) {
 #if defined(ENABLE_DMR)
         // if the DMR handler has parrot frames to playback, playback a frame
         if (m_tagDMR->hasParrotFrames()) {
@@ -628,6 +712,20 @@ bool FNENetwork::open()
     bool ret = m_socket->open();
     if (!ret) {
         m_status = NET_STAT_INVALID;
+        return false;
+    }
+
+    // start packet workers
+    for (uint32_t i = 0U; i < m_workerCnt; i++) {
+        if (m_workers.size() <= i) {
+            m_workers.push_back(new PacketWorker(this, i));
+        }
+
+        if (!m_workers[i]->run()) {
+            LogError(LOG_NET, "Failed to start FNE packet worker %u", i);
+            m_status = NET_STAT_INVALID;
+            return false;
+        }
     }
 
     return ret;
@@ -641,11 +739,16 @@ void FNENetwork::close()
     if (m_debug)
         LogMessage(LOG_NET, "Closing Network");
 
+    for (PacketWorker* worker : m_workers) {
+        worker->stop();
+    }
+
     if (m_status == NET_STAT_MST_RUNNING) {
         uint8_t buffer[1U];
         ::memset(buffer, 0x00U, 1U);
 
-        for (auto peer : m_peers) {
+        std::unique_lock<std::shared_timed_mutex> lock(m_peerMutex);
+        for (const auto& peer : m_peers) {
             writePeer(peer.first, { NET_FUNC_MST_CLOSING, NET_SUBFUNC_NOP }, buffer, 1U, (ushort)0U, 0U);
         }
     }
@@ -662,6 +765,363 @@ void FNENetwork::close()
 //  Private Class Members
 // ---------------------------------------------------------------------------
 
+/// <summary>
+/// Helper to recompile the talkgroup routes when the rules or the connected peers change.
+/// </summary>
+/// <remarks>Only peers that have completed login are routed to; peers still logging in, or rejected
+/// during login, do not cause the routes to be recompiled.</remarks>
+void FNENetwork::updateRoutes()
+{
+    if (m_tgRouting == nullptr) {
+        return;
+    }
+
+    bool rebuilt = false;
+
+    std::shared_lock<std::shared_timed_mutex> lock(m_peerMutex);
+    if (m_tgRoutingPeersChanged || m_peers.generation() != m_tgRoutingPeers) {
+        std::vector<uint32_t> peers;
+        peers.reserve(m_peers.size());
+        for (const auto& peer : m_peers) {
+            if (peer.second.connectionState() == NET_STAT_RUNNING) {
+                peers.push_back(peer.first);
+            }
+        }
+
+        m_tgRoutingPeers = m_peers.generation();
+        m_tgRoutingPeersChanged = false;
+        lock.unlock();
+
+        rebuilt = m_tgRouting->setPeers(peers);
+    }
+    else {
+        lock.unlock();
+    }
+
+    rebuilt = m_tgRouting->update() || rebuilt;
+    if (rebuilt && m_debug) {
+        LogDebug(LOG_NET, "Talkgroup routing cache rebuilt, %u routes", m_tgRouting->size());
+    }
+}
+
+/// <summary>
+/// Helper to process a protocol frame with the appropriate traffic handler.
+/// </summary>
+/// <param name="subFunc">Protocol sub-function.</param>
+/// <param name="data">Network data buffer.</param>
+/// <param name="length">Length of data.</param>
+/// <param name="peerId">Peer ID</param>
+/// <param name="pktSeq"></param>
+/// <param name="streamId">Stream ID</param>
+void FNENetwork::processFrame(uint8_t subFunc, const uint8_t* data, uint32_t length, uint32_t peerId, uint16_t pktSeq, uint32_t streamId)
+{
+    switch (subFunc) {
+    case NET_PROTOCOL_SUBFUNC_DMR:                                                      // Encapsulated DMR data frame
+#if defined(ENABLE_DMR)
+        if (m_dmrEnabled) {
+            if (m_tagDMR != nullptr) {
+                m_tagDMR->processFrame(data, length, peerId, pktSeq, streamId);
+            }
+        }
+#endif // defined(ENABLE_DMR)
+        break;
+    case NET_PROTOCOL_SUBFUNC_P25:                                                      // Encapsulated P25 data frame
+#if defined(ENABLE_P25)
+        if (m_p25Enabled) {
+            if (m_tagP25 != nullptr) {
+                m_tagP25->processFrame(data, length, peerId, pktSeq, streamId);
+            }
+        }
+#endif // defined(ENABLE_P25)
+        break;
+    case NET_PROTOCOL_SUBFUNC_NXDN:                                                     // Encapsulated NXDN data frame
+#if defined(ENABLE_NXDN)
+        if (m_nxdnEnabled) {
+            if (m_tagNXDN != nullptr) {
+                m_tagNXDN->processFrame(data, length, peerId, pktSeq, streamId);
+            }
+        }
+#endif // defined(ENABLE_NXDN)
+        break;
+    default:
+        break;
+    }
+}
+
+/// <summary>
+/// Helper to log the packet worker statistics.
+/// </summary>
+void FNENetwork::logWorkerStats()
+{
+    for (PacketWorker* worker : m_workers) {
+        LogInfoEx(LOG_NET, "FNE packet worker %u, processed = %llu, dropped = %llu, queued = %u, queueHighWater = %u",
+            worker->index(), worker->framesProcessed(), worker->framesDropped(), worker->queueDepth(), worker->queueHighWater());
+    }
+}
+
+/// <summary>
+/// Helper to update (and log) the batched network read and write statistics.
+/// </summary>
+void FNENetwork::updateNetworkStats()
+{
+    uint64_t datagramsSent = m_socket->datagramsSent();
+    uint64_t sendCalls = m_socket->sendCalls();
+
+    uint64_t elapsed = system_clock::hrc::diffNow(m_sendStatsTime);
+    m_sendStatsTime = system_clock::hrc::now();
+    if (elapsed == 0U) {
+        return;
+    }
+
+    // every datagram written beyond the first in a batched write is a system call saved
+    uint64_t datagrams = datagramsSent - m_lastDatagramsSent;
+    uint64_t calls = sendCalls - m_lastSendCalls;
+    uint64_t saved = (datagrams > calls) ? datagrams - calls : 0U;
+    m_syscallsSavedPerSec = (uint32_t)((saved * 1000U) / elapsed);
+
+    m_lastDatagramsSent = datagramsSent;
+    m_lastSendCalls = sendCalls;
+
+    if (m_verbose) {
+        LogInfoEx(LOG_NET, "FNE network writes, datagrams = %llu, sendCalls = %llu, syscallsSaved = %u/s, bufferAllocs = %llu",
+            datagramsSent, sendCalls, m_syscallsSavedPerSec, m_frameQueue->bufferAllocations());
+        LogInfoEx(LOG_NET, "FNE network reads, batch sizes 1 = %llu, 2-3 = %llu, 4-7 = %llu, 8-15 = %llu, 16-31 = %llu, 32+ = %llu",
+            m_socket->readBatchHistogram(0U), m_socket->readBatchHistogram(1U), m_socket->readBatchHistogram(2U),
+            m_socket->readBatchHistogram(3U), m_socket->readBatchHistogram(4U), m_socket->readBatchHistogram(5U));
+    }
+}
+
+/// <summary>
+/// Helper to bring the versioned RID and TGID lists up to date with the lookup tables.
+/// </summary>
+/// <remarks>A lookup table is only compared against its versioned list when it has been reloaded or modified.</remarks>
+void FNENetwork::updateListVersions()
+{
+    if (m_ridLookup != nullptr) {
+        uint32_t generation = m_ridLookup->generation();
+        if (generation != m_ridGeneration) {
+            m_ridGeneration = generation;
+
+            auto ridLookups = m_ridLookup->snapshot();
+            fne::ListVersionLog<uint32_t, bool>::List list;
+            list.reserve(ridLookups->size());
+            for (const auto& entry : *ridLookups) {
+                list.push_back(std::make_pair(entry.first, entry.second.radioEnabled()));
+            }
+            std::sort(list.begin(), list.end());
+
+            if (m_ridVersions.update(std::move(list)) && m_verbose) {
+                LogInfoEx(LOG_NET, "RID list changed, version = %u", m_ridVersions.version());
+            }
+        }
+    }
+
+    if (m_tidLookup != nullptr) {
+        uint32_t generation = m_tidLookup->generation();
+        if (generation != m_tgGeneration) {
+            m_tgGeneration = generation;
+
+            auto groupVoice = m_tidLookup->snapshot();
+            fne::ListVersionLog<uint64_t, lookups::TalkgroupRuleConfig>::List list;
+            list.reserve(groupVoice->size());
+            for (const auto& entry : *groupVoice) {
+                uint64_t key = ((uint64_t)entry.source().tgId() << 8) | entry.source().tgSlot();
+                list.push_back(std::make_pair(key, entry.config()));
+            }
+
+            // the first rule for a talkgroup and slot is the one that applies
+            std::stable_sort(list.begin(), list.end(), 
+                [](const std::pair<uint64_t, lookups::TalkgroupRuleConfig>& a, const std::pair<uint64_t, lookups::TalkgroupRuleConfig>& b) { return a.first < b.first; });
+            list.erase(std::unique(list.begin(), list.end(), 
+                [](const std::pair<uint64_t, lookups::TalkgroupRuleConfig>& a, const std::pair<uint64_t, lookups::TalkgroupRuleConfig>& b) { return a.first == b.first; }), list.end());
+
+            if (m_tgVersions.update(std::move(list)) && m_verbose) {
+                LogInfoEx(LOG_NET, "TGID list changed, version = %u", m_tgVersions.version());
+            }
+        }
+    }
+}
+
+/// <summary>
+/// Helper to send the RID and TGID list changes the specified peer is missing.
+/// </summary>
+/// <param name="connection"></param>
+void FNENetwork::writeListDeltas(FNEPeerConnection& connection)
+{
+    if (m_ridLookup != nullptr) {
+        writeRIDDelta(connection.id(), connection.ridListVersion());
+    }
+
+    if (m_tidLookup != nullptr && m_tidLookup->sendTalkgroups()) {
+        writeTGDelta(connection.id(), connection.tgListVersion());
+    }
+}
+
+/// <summary>
+/// Helper to send the RID list changes the specified peer is missing.
+/// </summary>
+/// <remarks>Nothing is sent if the peer is up to date; the full list is sent if the changes are unknown.</remarks>
+/// <param name="peerId"></param>
+/// <param name="version">Version of the RID list the peer holds.</param>
+void FNENetwork::writeRIDDelta(uint32_t peerId, uint32_t version)
+{
+    std::vector<uint8_t> records;
+    auto appendRecord = [&](uint32_t id, uint8_t op) {
+        size_t offs = records.size();
+        records.resize(offs + LIST_DELTA_RID_RECORD_LEN);
+        __SET_UINT32(id, records, offs);
+        records[offs + 4U] = op;
+    };
+
+    std::vector<fne::ListVersionLog<uint32_t, bool>::Change> changes;
+    uint32_t fromVersion = version;
+    if (m_ridVersions.changesSince(version, changes)) {
+        if (changes.empty() && version == m_ridVersions.version()) {
+            return;
+        }
+
+        for (const auto& change : changes) {
+            uint8_t op = (!change.hasValue) ? LIST_DELTA_RID_REMOVE : (change.newValue ? LIST_DELTA_RID_WHITELIST : LIST_DELTA_RID_BLACKLIST);
+            if (m_debug)
+                LogDebug(LOG_NET, "PEER %u RID %u delta op %u", peerId, change.key, op);
+            appendRecord(change.key, op);
+        }
+    }
+    else {
+        fromVersion = 0U;
+        for (const auto& entry : m_ridVersions.list()) {
+            appendRecord(entry.first, entry.second ? LIST_DELTA_RID_WHITELIST : LIST_DELTA_RID_BLACKLIST);
+        }
+    }
+
+    writeListDelta(peerId, NET_MASTER_SUBFUNC_RID_DELTA, fromVersion, m_ridVersions.version(), records, LIST_DELTA_RID_RECORD_LEN);
+}
+
+/// <summary>
+/// Helper to send the TGID list changes the specified peer is missing.
+/// </summary>
+/// <remarks>Nothing is sent if the peer is up to date; the full list is sent if the changes are unknown.</remarks>
+/// <param name="peerId"></param>
+/// <param name="version">Version of the TGID list the peer holds.</param>
+void FNENetwork::writeTGDelta(uint32_t peerId, uint32_t version)
+{
+    std::vector<uint8_t> records;
+    auto appendRecord = [&](uint64_t key, uint8_t op) {
+        size_t offs = records.size();
+        records.resize(offs + LIST_DELTA_TG_RECORD_LEN);
+        uint32_t tgId = (uint32_t)(key >> 8);
+        __SET_UINT32(tgId, records, offs);
+        records[offs + 4U] = (uint8_t)(key & 0xFFU);
+        records[offs + 5U] = op;
+    };
+
+    // state of a rule as seen by this peer; 0 = not listed, 1 = deactivated, 2 = activated
+    auto ruleState = [&](bool hasRule, const lookups::TalkgroupRuleConfig& config) -> uint8_t {
+        if (!hasRule || !isRuleVisible(config, peerId)) {
+            return 0U;
+        }
+
+        return config.active() ? 2U : 1U;
+    };
+
+    std::vector<fne::ListVersionLog<uint64_t, lookups::TalkgroupRuleConfig>::Change> changes;
+    uint32_t fromVersion = version;
+    if (m_tgVersions.changesSince(version, changes)) {
+        for (const auto& change : changes) {
+            uint8_t oldState = ruleState(change.hadValue, change.oldValue);
+            uint8_t newState = ruleState(change.hasValue, change.newValue);
+            if (oldState == newState || (newState == 0U && oldState == 1U)) {
+                continue;
+            }
+
+            // a rule that no longer applies to the peer is removed by deactivating it
+            appendRecord(change.key, (newState == 2U) ? LIST_DELTA_TG_ACTIVATE : LIST_DELTA_TG_DEACTIVATE);
+        }
+
+        if (records.empty() && version == m_tgVersions.version()) {
+            return;
+        }
+    }
+    else {
+        fromVersion = 0U;
+        for (const auto& entry : m_tgVersions.list()) {
+            uint8_t state = ruleState(true, entry.second);
+            if (state != 0U) {
+                appendRecord(entry.first, (state == 2U) ? LIST_DELTA_TG_ACTIVATE : LIST_DELTA_TG_DEACTIVATE);
+            }
+        }
+    }
+
+    writeListDelta(peerId, NET_MASTER_SUBFUNC_TG_DELTA, fromVersion, m_tgVersions.version(), records, LIST_DELTA_TG_RECORD_LEN);
+}
+
+/// <summary>
+/// Helper to send a list delta to the specified peer, split into chunks.
+/// </summary>
+/// <remarks>
+/// A delta from version 0 carries the full list. The peer only takes the new version once it has
+/// received every chunk; a delta with no records is still sent so the peer learns the version.
+/// </remarks>
+/// <param name="peerId"></param>
+/// <param name="subFunc">Master sub-function.</param>
+/// <param name="fromVersion">Version the delta applies to (0 for the full list).</param>
+/// <param name="toVersion">Version the delta brings the peer to.</param>
+/// <param name="records">Delta records.</param>
+/// <param name="recordLen">Length of a single delta record.</param>
+void FNENetwork::writeListDelta(uint32_t peerId, uint8_t subFunc, uint32_t fromVersion, uint32_t toVersion,
+    const std::vector<uint8_t>& records, uint32_t recordLen)
+{
+    uint32_t count = (uint32_t)(records.size() / recordLen);
+    uint32_t chunks = (count + LIST_DELTA_MAX_RECORDS - 1U) / LIST_DELTA_MAX_RECORDS;
+    if (chunks == 0U) {
+        chunks = 1U;
+    }
+
+    for (uint32_t chunk = 0U; chunk < chunks; chunk++) {
+        uint32_t first = chunk * LIST_DELTA_MAX_RECORDS;
+        uint32_t chunkCount = std::min(LIST_DELTA_MAX_RECORDS, count - first);
+
+        std::vector<uint8_t> payload(LIST_DELTA_HEADER_LEN + (chunkCount * recordLen), 0x00U);
+        __SET_UINT32(fromVersion, payload, 0U);
+        __SET_UINT32(toVersion, payload, 4U);
+        payload[8U] = (uint8_t)((chunk >> 8) & 0xFFU);
+        payload[9U] = (uint8_t)(chunk & 0xFFU);
+        payload[10U] = (uint8_t)((chunks >> 8) & 0xFFU);
+        payload[11U] = (uint8_t)(chunks & 0xFFU);
+        __SET_UINT32(chunkCount, payload, 12U);
+
+        if (chunkCount > 0U) {
+            ::memcpy(payload.data() + LIST_DELTA_HEADER_LEN, records.data() + (first * recordLen), chunkCount * recordLen);
+        }
+
+        writePeerCommand(peerId, { NET_FUNC_MASTER, subFunc }, payload.data(), (uint32_t)payload.size(), true, true);
+    }
+
+    if (m_verbose) {
+        LogInfoEx(LOG_NET, "PEER %u sent %s list delta, version %u -> %u, %u changes", peerId,
+            (subFunc == NET_MASTER_SUBFUNC_RID_DELTA) ? "RID" : "TGID", fromVersion, toVersion, count);
+    }
+}
+
+/// <summary>
+/// Helper to determine whether a talkgroup rule applies to the specified peer.
+/// </summary>
+/// <param name="config">Talkgroup rule configuration.</param>
+/// <param name="peerId"></param>
+/// <returns>True, if the rule applies to the peer, otherwise false.</returns>
+bool FNENetwork::isRuleVisible(const lookups::TalkgroupRuleConfig& config, uint32_t peerId) const
+{
+    std::vector<uint32_t> inclusion = config.inclusion();
+    std::vector<uint32_t> exclusion = config.exclusion();
+
+    // peer inclusion lists take priority over exclusion lists
+    if (inclusion.size() > 0) {
+        return std::find(inclusion.begin(), inclusion.end(), peerId) != inclusion.end();
+    }
+
+    return std::find(exclusion.begin(), exclusion.end(), peerId) == exclusion.end();
+}
+
 /// <summary>
 /// Helper to send the list of whitelisted RIDs to the specified peer.
 /// </summary>
@@ -672,8 +1132,8 @@ void FNENetwork::writeWhitelistRIDs(uint32_t peerId, bool queueOnly)
     // send radio ID white/black lists
     std::vector<uint32_t> ridWhitelist;
 
-    auto ridLookups = m_ridLookup->table();
-    for (auto entry : ridLookups) {
+    auto ridLookups = m_ridLookup->snapshot();
+    for (const auto& entry : *ridLookups) {
         uint32_t id = entry.first;
         if (entry.second.radioEnabled()) {
             ridWhitelist.push_back(id);
@@ -709,11 +1169,15 @@ void FNENetwork::writeWhitelistRIDs(uint32_t peerId, bool queueOnly)
 /// </summary>
 void FNENetwork::writeWhitelistRIDs()
 {
-    if (m_ridLookup->table().size() == 0U) {
+    if (m_ridLookup->snapshot()->size() == 0U) {
         return;
     }
 
-    for (auto peer : m_peers) {
+    for (const auto& peer : m_peers) {
+        if (peer.second.listDelta()) {
+            continue;
+        }
+
         writeWhitelistRIDs(peer.first, true);
     }
 }
@@ -728,8 +1192,8 @@ void FNENetwork::writeBlacklistRIDs(uint32_t peerId, bool queueOnly)
     // send radio ID blacklist
     std::vector<uint32_t> ridBlacklist;
 
-    auto ridLookups = m_ridLookup->table();
-    for (auto entry : ridLookups) {
+    auto ridLookups = m_ridLookup->snapshot();
+    for (const auto& entry : *ridLookups) {
         uint32_t id = entry.first;
         if (!entry.second.radioEnabled()) {
             ridBlacklist.push_back(id);
@@ -765,11 +1229,15 @@ void FNENetwork::writeBlacklistRIDs(uint32_t peerId, bool queueOnly)
 /// </summary>
 void FNENetwork::writeBlacklistRIDs()
 {
-    if (m_ridLookup->table().size() == 0U) {
+    if (m_ridLookup->snapshot()->size() == 0U) {
         return;
     }
 
-    for (auto peer : m_peers) {
+    for (const auto& peer : m_peers) {
+        if (peer.second.listDelta()) {
+            continue;
+        }
+
         writeBlacklistRIDs(peer.first, true);
     }
 }
@@ -786,8 +1254,8 @@ void FNENetwork::writeTGIDs(uint32_t peerId, bool queueOnly)
     }
 
     std::vector<std::pair<uint32_t, uint8_t>> tgidList;
-    auto groupVoice = m_tidLookup->groupVoice();
-    for (auto entry : groupVoice) {
+    auto groupVoice = m_tidLookup->snapshot();
+    for (const auto& entry : *groupVoice) {
         std::vector<uint32_t> inclusion = entry.config().inclusion();
         std::vector<uint32_t> exclusion = entry.config().exclusion();
 
@@ -839,7 +1307,11 @@ void FNENetwork::writeTGIDs(uint32_t peerId, bool queueOnly)
 /// </summary>
 void FNENetwork::writeTGIDs()
 {
-    for (auto peer : m_peers) {
+    for (const auto& peer : m_peers) {
+        if (peer.second.listDelta()) {
+            continue;
+        }
+
         writeTGIDs(peer.first, true);
     }
 }
@@ -856,8 +1328,8 @@ void FNENetwork::writeDeactiveTGIDs(uint32_t peerId, bool queueOnly)
     }
 
     std::vector<std::pair<uint32_t, uint8_t>> tgidList;
-    auto groupVoice = m_tidLookup->groupVoice();
-    for (auto entry : groupVoice) {
+    auto groupVoice = m_tidLookup->snapshot();
+    for (const auto& entry : *groupVoice) {
         std::vector<uint32_t> inclusion = entry.config().inclusion();
         std::vector<uint32_t> exclusion = entry.config().exclusion();
 
@@ -909,7 +1381,11 @@ void FNENetwork::writeDeactiveTGIDs(uint32_t peerId, bool queueOnly)
 /// </summary>
 void FNENetwork::writeDeactiveTGIDs()
 {
-    for (auto peer : m_peers) {
+    for (const auto& peer : m_peers) {
+        if (peer.second.listDelta()) {
+            continue;
+        }
+
         writeDeactiveTGIDs(peer.first, true);
     }
 }
@@ -926,14 +1402,15 @@ void FNENetwork::writeDeactiveTGIDs()
 /// <param name="queueOnly"></param>
 bool FNENetwork::writePeer(uint32_t peerId, FrameQueue::OpcodePair opcode, const uint8_t* data, uint32_t length, uint16_t pktSeq, uint32_t streamId, bool queueOnly)
 {
-    auto it = std::find_if(m_peers.begin(), m_peers.end(), [&](PeerMapPair x) { return x.first == peerId; });
-    if (it != m_peers.end()) {
-        uint32_t peerStreamId = m_peers[peerId].currStreamId();
+    // this may be called by several packet workers holding a shared peer lock; only read the peer here
+    const FNEPeerConnection* connection = m_peers.find(peerId);
+    if (connection != nullptr) {
+        uint32_t peerStreamId = connection->currStreamId();
         if (streamId == 0U) {
             streamId = peerStreamId;
         }
-        sockaddr_storage addr = m_peers[peerId].socketStorage();
-        uint32_t addrLen = m_peers[peerId].sockStorageLen();
+        sockaddr_storage addr = connection->socketStorage();
+        uint32_t addrLen = connection->sockStorageLen();
         
         m_frameQueue->enqueueMessage(data, length, streamId, peerId, m_peerId, opcode, pktSeq, addr, addrLen);
         if (queueOnly)
@@ -956,12 +1433,12 @@ bool FNENetwork::writePeer(uint32_t peerId, FrameQueue::OpcodePair opcode, const
 /// <param name="incPktSeq"></param>
 bool FNENetwork::writePeer(uint32_t peerId, FrameQueue::OpcodePair opcode, const uint8_t* data, uint32_t length, uint32_t streamId, bool queueOnly, bool incPktSeq)
 {
-    auto it = std::find_if(m_peers.begin(), m_peers.end(), [&](PeerMapPair x) { return x.first == peerId; });
-    if (it != m_peers.end()) {
+    FNEPeerConnection* connection = m_peers.find(peerId);
+    if (connection != nullptr) {
         if (incPktSeq) {
-            m_peers[peerId].pktLastSeq(m_peers[peerId].pktLastSeq() + 1);
+            connection->pktLastSeq(connection->pktLastSeq() + 1);
         }
-        uint16_t pktSeq = m_peers[peerId].pktLastSeq();
+        uint16_t pktSeq = connection->pktLastSeq();
 
         return writePeer(peerId, opcode, data, length, pktSeq, streamId, queueOnly);
     }
@@ -969,6 +1446,57 @@ bool FNENetwork::writePeer(uint32_t peerId, FrameQueue::OpcodePair opcode, const
     return false;
 }
 
+/// <summary>
+/// Helper to send a data message to several peers with a single batched write.
+/// </summary>
+/// <param name="peerIds">List of peer IDs to send the message to.</param>
+/// <param name="opcode">Opcode.</param>
+/// <param name="data">Buffer to write to the network.</param>
+/// <param name="length">Length of buffer to write.</param>
+/// <param name="pktSeq"></param>
+/// <param name="streamId"></param>
+/// <param name="queueOnly"></param>
+bool FNENetwork::writePeers(const std::vector<uint32_t>& peerIds, FrameQueue::OpcodePair opcode, const uint8_t* data, uint32_t length,
+    uint16_t pktSeq, uint32_t streamId, bool queueOnly)
+{
+    // streams without an ID take the ID of each peers current stream, and cannot share a frame
+    if (streamId == 0U) {
+        bool ret = false;
+        for (uint32_t peerId : peerIds) {
+            ret |= writePeer(peerId, opcode, data, length, pktSeq, streamId, true);
+        }
+
+        if (queueOnly || !ret)
+            return ret;
+        return m_frameQueue->flushQueue();
+    }
+
+    // this may be called by several packet workers holding a shared peer lock; only read the peers here
+    FanOutVector peers;
+    peers.reserve(peerIds.size());
+    for (uint32_t peerId : peerIds) {
+        const FNEPeerConnection* connection = m_peers.find(peerId);
+        if (connection == nullptr) {
+            continue;
+        }
+
+        FanOutPeer peer;
+        peer.peerId = peerId;
+        peer.address = connection->socketStorage();
+        peer.addrLen = connection->sockStorageLen();
+        peers.push_back(peer);
+    }
+
+    if (peers.empty()) {
+        return false;
+    }
+
+    m_frameQueue->enqueueFanOut(data, length, streamId, peers, m_peerId, opcode, pktSeq);
+    if (queueOnly)
+        return true;
+    return m_frameQueue->flushQueue();
+}
+
 /// <summary>
 /// Helper to send a command message to the specified peer.
 /// </summary>
@@ -30,12 +30,17 @@
 #include "network/BaseNetwork.h"
 #include "network/Network.h"
 #include "network/json/json.h"
+#include "network/fne/ListVersionLog.h"
+#include "network/fne/PeerTable.h"
+#include "Clock.h"
 #include "lookups/RadioIdLookup.h"
 #include "lookups/TalkgroupRulesLookup.h"
 
 #include <string>
 #include <cstdint>
+#include <shared_mutex>
 #include <unordered_map>
+#include <vector>
 
 // ---------------------------------------------------------------------------
 //  Class Prototypes
@@ -45,6 +50,8 @@ class HOST_SW_API HostFNE;
 namespace network { namespace fne { class HOST_SW_API TagDMRData; } }
 namespace network { namespace fne { class HOST_SW_API TagP25Data; } }
 namespace network { namespace fne { class HOST_SW_API TagNXDNData; } }
+namespace network { namespace fne { class HOST_SW_API PacketWorker; } }
+namespace network { namespace fne { class HOST_SW_API TalkgroupRoutingTable; } }
 
 namespace network
 {
@@ -69,7 +76,10 @@ namespace network
             m_pingsReceived(0U),
             m_config(),
             m_pktLastSeq(0U),
-            m_pktNextSeq(1U)
+            m_pktNextSeq(1U),
+            m_listDelta(false),
+            m_ridListVersion(0U),
+            m_tgListVersion(0U)
         {
             /* stub */
         }
@@ -90,7 +100,10 @@ namespace network
             m_pingsReceived(0U),
             m_config(),
             m_pktLastSeq(0U),
-            m_pktNextSeq(1U)
+            m_pktNextSeq(1U),
+            m_listDelta(false),
+            m_ridListVersion(0U),
+            m_tgListVersion(0U)
         {
             assert(id > 0U);
             assert(sockStorageLen > 0U);
@@ -124,6 +137,10 @@ namespace network
 
                 m_pktLastSeq = data.m_pktLastSeq;
                 m_pktNextSeq = data.m_pktNextSeq;
+
+                m_listDelta = data.m_listDelta;
+                m_ridListVersion = data.m_ridListVersion;
+                m_tgListVersion = data.m_tgListVersion;
             }
 
             return *this;
@@ -166,6 +183,13 @@ namespace network
         __PROPERTY_PLAIN(uint16_t, pktLastSeq, pktLastSeq);
         /// <summary>Calculated next RTP sequence.</summary>
         __PROPERTY_PLAIN(uint16_t, pktNextSeq, pktNextSeq);
+
+        /// <summary>Flag indicating whether the peer accepts RID and TGID list deltas.</summary>
+        __PROPERTY_PLAIN(bool, listDelta, listDelta);
+        /// <summary>Version of the RID list the peer last reported holding.</summary>
+        __PROPERTY_PLAIN(uint32_t, ridListVersion, ridListVersion);
+        /// <summary>Version of the TGID list the peer last reported holding.</summary>
+        __PROPERTY_PLAIN(uint32_t, tgListVersion, tgListVersion);
     };
 
     // ---------------------------------------------------------------------------
@@ -178,7 +202,7 @@ namespace network
         /// <summary>Initializes a new instance of the FNENetwork class.</summary>
         FNENetwork(HostFNE* host, const std::string& address, uint16_t port, uint32_t peerId, const std::string& password,
             bool debug, bool verbose, bool dmr, bool p25, bool nxdn, uint32_t parrotDelay, bool allowActivityTransfer,
-            bool allowDiagnosticTransfer, uint32_t pingTime, uint32_t updateLookupTime);
+            bool allowDiagnosticTransfer, uint32_t pingTime, uint32_t updateLookupTime, uint32_t workerCnt = 0U);
         /// <summary>Finalizes a instance of the FNENetwork class.</summary>
         ~FNENetwork();
 
@@ -192,6 +216,14 @@ namespace network
         /// <summary>Gets the instance of the NXDN traffic handler.</summary>
         fne::TagNXDNData* nxdnTrafficHandler() const { return m_tagNXDN; }
 
+        /// <summary>Gets whether any traffic handler has parrot frames waiting for playback.</summary>
+        bool hasParrotFrames() const;
+
+        /// <summary>Gets the packet workers processing protocol traffic.</summary>
+        const std::vector<fne::PacketWorker*>& workers() const { return m_workers; }
+        /// <summary>Gets the number of send system calls saved per second by batched network writes.</summary>
+        uint32_t syscallsSavedPerSec() const { return m_syscallsSavedPerSec; }
+
         /// <summary>Sets the instances of the Radio ID and Talkgroup Rules lookup tables.</summary>
         void setLookups(lookups::RadioIdLookup* ridLookup, lookups::TalkgroupRulesLookup* tidLookup);
 
@@ -211,7 +243,10 @@ namespace network
         fne::TagP25Data* m_tagP25;
         friend class fne::TagNXDNData;
         fne::TagNXDNData* m_tagNXDN;
-        
+        friend class fne::PacketWorker;
+        std::vector<fne::PacketWorker*> m_workers;
+        uint32_t m_workerCnt;
+
         HostFNE* m_host;
 
         std::string m_address;
@@ -227,17 +262,53 @@ namespace network
 
         lookups::RadioIdLookup* m_ridLookup;
         lookups::TalkgroupRulesLookup* m_tidLookup;
+        fne::TalkgroupRoutingTable* m_tgRouting;
+        uint32_t m_tgRoutingPeers;
+        bool m_tgRoutingPeersChanged;
+
+        fne::ListVersionLog<uint32_t, bool> m_ridVersions;
+        fne::ListVersionLog<uint64_t, lookups::TalkgroupRuleConfig> m_tgVersions;
+        uint32_t m_ridGeneration;
+        uint32_t m_tgGeneration;
 
         NET_CONN_STATUS m_status;
 
-        typedef std::pair<const uint32_t, network::FNEPeerConnection> PeerMapPair;
-        std::unordered_map<uint32_t, FNEPeerConnection> m_peers;
+        fne::PeerTable<FNEPeerConnection> m_peers;
+        std::shared_timed_mutex m_peerMutex;
 
         Timer m_maintainenceTimer;
         Timer m_updateLookupTimer;
 
         bool m_verbose;
 
+        system_clock::hrc::hrc_t m_sendStatsTime;
+        uint64_t m_lastDatagramsSent;
+        uint64_t m_lastSendCalls;
+        uint32_t m_syscallsSavedPerSec;
+
+        /// <summary>Helper to process a protocol frame with the appropriate traffic handler.</summary>
+        void processFrame(uint8_t subFunc, const uint8_t* data, uint32_t length, uint32_t peerId, uint16_t pktSeq, uint32_t streamId);
+        /// <summary>Helper to recompile the talkgroup routes when the rules or the connected peers change.</summary>
+        void updateRoutes();
+        /// <summary>Helper to log the packet worker statistics.</summary>
+        void logWorkerStats();
+        /// <summary>Helper to update (and log) the batched network read and write statistics.</summary>
+        void updateNetworkStats();
+
+        /// <summary>Helper to bring the versioned RID and TGID lists up to date with the lookup tables.</summary>
+        void updateListVersions();
+        /// <summary>Helper to send the RID and TGID list changes the specified peer is missing.</summary>
+        void writeListDeltas(FNEPeerConnection& connection);
+        /// <summary>Helper to send the RID list changes the specified peer is missing.</summary>
+        void writeRIDDelta(uint32_t peerId, uint32_t version);
+        /// <summary>Helper to send the TGID list changes the specified peer is missing.</summary>
+        void writeTGDelta(uint32_t peerId, uint32_t version);
+        /// <summary>Helper to send a list delta to the specified peer, split into chunks.</summary>
+        void writeListDelta(uint32_t peerId, uint8_t subFunc, uint32_t fromVersion, uint32_t toVersion,
+            const std::vector<uint8_t>& records, uint32_t recordLen);
+        /// <summary>Helper to determine whether a talkgroup rule applies to the specified peer.</summary>
+        bool isRuleVisible(const lookups::TalkgroupRuleConfig& config, uint32_t peerId) const;
+
         /// <summary>Helper to send the list of whitelisted RIDs to the specified peer.</summary>
         void writeWhitelistRIDs(uint32_t peerId, bool queueOnly = false);
         /// <summary>Helper to send the list of whitelisted RIDs to connected peers.</summary>
@@ -263,6 +334,10 @@ namespace network
         bool writePeer(uint32_t peerId, FrameQueue::OpcodePair opcode, const uint8_t* data, uint32_t length, 
             uint32_t streamId, bool queueOnly = false, bool incPktSeq = false);
 
+        /// <summary>Helper to send a data message to several peers with a single batched write.</summary>
+        bool writePeers(const std::vector<uint32_t>& peerIds, FrameQueue::OpcodePair opcode, const uint8_t* data, uint32_t length,
+            uint16_t pktSeq, uint32_t streamId, bool queueOnly = false);
+
         /// <summary>Helper to send a command message to the specified peer.</summary>
         bool writePeerCommand(uint32_t peerId, FrameQueue::OpcodePair opcode, const uint8_t* data = nullptr, uint32_t length = 0U, 
             bool queueOnly = false, bool incPktSeq = false);
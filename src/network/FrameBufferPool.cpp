@@ -0,0 +1,193 @@
+/**
+* Digital Voice Modem - Host Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software
+*
+*/
+/*
+*   Copyright (C) 2023 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#include "Defines.h"
+#include "network/FrameBufferPool.h"
+
+using namespace network;
+
+#include <cassert>
+#include <cstring>
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Adds the given number of references to this buffer.
+/// </summary>
+/// <param name="count">Number of references to add.</param>
+void FrameBuffer::addRef(uint32_t count)
+{
+    m_refCnt.fetch_add(count);
+}
+
+/// <summary>
+/// Releases a reference to this buffer, returning it to its pool when no references remain.
+/// </summary>
+void FrameBuffer::release()
+{
+    uint32_t refCnt = m_refCnt.fetch_sub(1U);
+    assert(refCnt > 0U);
+    if (refCnt != 1U) {
+        return;
+    }
+
+    m_pool->release(this);
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Initializes a new instance of the FrameBuffer class.
+/// </summary>
+/// <param name="pool">Pool this buffer belongs to.</param>
+/// <param name="capacity">Maximum length of data this buffer can store.</param>
+FrameBuffer::FrameBuffer(FrameBufferPool* pool, uint32_t capacity) :
+    m_pool(pool),
+    m_data(nullptr),
+    m_capacity(capacity),
+    m_length(0U),
+    m_refCnt(0U)
+{
+    assert(pool != nullptr);
+    assert(capacity > 0U);
+
+    m_data = new uint8_t[capacity];
+}
+
+/// <summary>
+/// Finalizes a instance of the FrameBuffer class.
+/// </summary>
+FrameBuffer::~FrameBuffer()
+{
+    delete[] m_data;
+}
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Initializes a new instance of the FrameBufferPool class.
+/// </summary>
+/// <param name="maxFree">Maximum number of unused buffers of each size retained by the pool.</param>
+FrameBufferPool::FrameBufferPool(uint32_t maxFree) :
+    m_maxFree(maxFree),
+    m_freeSmall(),
+    m_freeLarge(),
+    m_mutex(),
+    m_allocations(0U)
+{
+    m_freeSmall.reserve(maxFree);
+    m_freeLarge.reserve(maxFree);
+}
+
+/// <summary>
+/// Finalizes a instance of the FrameBufferPool class.
+/// </summary>
+FrameBufferPool::~FrameBufferPool()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (FrameBuffer* buffer : m_freeSmall) {
+        delete buffer;
+    }
+    m_freeSmall.clear();
+
+    for (FrameBuffer* buffer : m_freeLarge) {
+        delete buffer;
+    }
+    m_freeLarge.clear();
+}
+
+/// <summary>
+/// Acquires a buffer from the pool and copies the given data into it.
+/// </summary>
+/// <remarks>The returned buffer holds a single reference.</remarks>
+/// <param name="data">Data to store in the buffer.</param>
+/// <param name="length">Length of data.</param>
+/// <returns>Buffer containing a copy of the data.</returns>
+FrameBuffer* FrameBufferPool::acquire(const uint8_t* data, uint32_t length)
+{
+    assert(data != nullptr);
+    assert(length > 0U);
+
+    FrameBuffer* buffer = nullptr;
+    if (length <= FRAME_BUFFER_LARGE_LENGTH) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::vector<FrameBuffer*>& freeList = (length <= FRAME_BUFFER_SMALL_LENGTH) ? m_freeSmall : m_freeLarge;
+        if (!freeList.empty()) {
+            buffer = freeList.back();
+            freeList.pop_back();
+        }
+    }
+
+    if (buffer == nullptr) {
+        uint32_t capacity = length;
+        if (length <= FRAME_BUFFER_SMALL_LENGTH) {
+            capacity = FRAME_BUFFER_SMALL_LENGTH;
+        }
+        else if (length <= FRAME_BUFFER_LARGE_LENGTH) {
+            capacity = FRAME_BUFFER_LARGE_LENGTH;
+        }
+
+        buffer = new FrameBuffer(this, capacity);
+        m_allocations++;
+    }
+
+    ::memcpy(buffer->m_data, data, length);
+    buffer->m_length = length;
+    buffer->m_refCnt = 1U;
+
+    return buffer;
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Returns a buffer, that no longer has any references, to the pool.
+/// </summary>
+/// <param name="buffer">Buffer to return.</param>
+void FrameBufferPool::release(FrameBuffer* buffer)
+{
+    assert(buffer != nullptr);
+
+    // oversized buffers are never pooled
+    if (buffer->m_capacity == FRAME_BUFFER_SMALL_LENGTH || buffer->m_capacity == FRAME_BUFFER_LARGE_LENGTH) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::vector<FrameBuffer*>& freeList = (buffer->m_capacity == FRAME_BUFFER_SMALL_LENGTH) ? m_freeSmall : m_freeLarge;
+        if (freeList.size() < m_maxFree) {
+            buffer->m_length = 0U;
+            freeList.push_back(buffer);
+            return;
+        }
+    }
+
+    delete buffer;
+}
@@ -0,0 +1,117 @@
+/**
+* Digital Voice Modem - Host Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software
+*
+*/
+/*
+*   Copyright (C) 2023 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#if !defined(__FRAME_BUFFER_POOL_H__)
+#define __FRAME_BUFFER_POOL_H__
+
+#include "Defines.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace network
+{
+    // ---------------------------------------------------------------------------
+    //  Constants
+    // ---------------------------------------------------------------------------
+
+    const uint32_t  FRAME_BUFFER_SMALL_LENGTH = 512U;
+    const uint32_t  FRAME_BUFFER_LARGE_LENGTH = 8192U;
+    const uint32_t  FRAME_BUFFER_POOL_MAX_FREE = 256U;
+
+    // ---------------------------------------------------------------------------
+    //  Class Prototypes
+    // ---------------------------------------------------------------------------
+
+    class HOST_SW_API FrameBufferPool;
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    //      Implements a reference counted frame buffer, backed by a buffer pool.
+    // ---------------------------------------------------------------------------
+
+    class HOST_SW_API FrameBuffer {
+    public:
+        /// <summary>Gets the buffer data.</summary>
+        uint8_t* data() const { return m_data; }
+        /// <summary>Gets the length of the data stored in the buffer.</summary>
+        uint32_t length() const { return m_length; }
+
+        /// <summary>Adds the given number of references to this buffer.</summary>
+        void addRef(uint32_t count = 1U);
+        /// <summary>Releases a reference to this buffer, returning it to its pool when no references remain.</summary>
+        void release();
+
+    private:
+        friend class FrameBufferPool;
+        /// <summary>Initializes a new instance of the FrameBuffer class.</summary>
+        FrameBuffer(FrameBufferPool* pool, uint32_t capacity);
+        /// <summary>Finalizes a instance of the FrameBuffer class.</summary>
+        ~FrameBuffer();
+
+        FrameBufferPool* m_pool;
+
+        uint8_t* m_data;
+        uint32_t m_capacity;
+        uint32_t m_length;
+
+        std::atomic<uint32_t> m_refCnt;
+    };
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    //      Implements a pool of reusable frame buffers.
+    // ---------------------------------------------------------------------------
+
+    class HOST_SW_API FrameBufferPool {
+    public:
+        /// <summary>Initializes a new instance of the FrameBufferPool class.</summary>
+        FrameBufferPool(uint32_t maxFree = FRAME_BUFFER_POOL_MAX_FREE);
+        /// <summary>Finalizes a instance of the FrameBufferPool class.</summary>
+        ~FrameBufferPool();
+
+        /// <summary>Acquires a buffer from the pool and copies the given data into it.</summary>
+        FrameBuffer* acquire(const uint8_t* data, uint32_t length);
+
+        /// <summary>Gets the total number of buffers allocated from the heap.</summary>
+        uint64_t allocations() const { return m_allocations.load(); }
+
+    private:
+        friend class FrameBuffer;
+        /// <summary>Returns a buffer, that no longer has any references, to the pool.</summary>
+        void release(FrameBuffer* buffer);
+
+        uint32_t m_maxFree;
+
+        std::vector<FrameBuffer*> m_freeSmall;
+        std::vector<FrameBuffer*> m_freeLarge;
+        std::mutex m_mutex;
+
+        std::atomic<uint64_t> m_allocations;
+    };
+} // namespace network
+
+#endif // __FRAME_BUFFER_POOL_H__
@@ -28,6 +28,7 @@
 #include "network/BaseNetwork.h"
 #include "network/FrameQueue.h"
 #include "Log.h"
+#include "Metrics.h"
 #include "Utils.h"
 
 using namespace network;
@@ -50,7 +51,13 @@ using namespace network::frame;
 FrameQueue::FrameQueue(UDPSocket* socket, uint32_t peerId, bool debug) :
     m_peerId(peerId),
     m_socket(socket),
+    m_rxBuffers(),
+    m_rxIndex(0U),
     m_buffers(),
+    m_queue(),
+    m_freeFrames(),
+    m_bufferPool(),
+    m_queueMutex(),
     m_debug(debug)
 {
     assert(peerId > 1000U);
@@ -61,7 +68,20 @@ FrameQueue::FrameQueue(UDPSocket* socket, uint32_t peerId, bool debug) :
 /// </summary>
 FrameQueue::~FrameQueue()
 {
-    /* stub */
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    for (QueuedFrame* frame : m_queue) {
+        if (frame->payload != nullptr) {
+            frame->payload->release();
+        }
+
+        delete frame;
+    }
+    m_queue.clear();
+
+    for (QueuedFrame* frame : m_freeFrames) {
+        delete frame;
+    }
+    m_freeFrames.clear();
 }
 
 /// <summary>
@@ -81,15 +101,25 @@ UInt8Array FrameQueue::read(int& messageLength, sockaddr_storage& address, uint3
 
     messageLength = -1;
 
-    // read message from socket
-    uint8_t buffer[DATA_PACKET_LENGTH];
-    ::memset(buffer, 0x00U, DATA_PACKET_LENGTH);
-    int length = m_socket->read(buffer, DATA_PACKET_LENGTH, address, addrLen);
-    if (length < 0) {
-        LogError(LOG_NET, "Failed reading data from the network");
-        return nullptr;
+    // read the next batch of datagrams from the socket once the current batch is consumed
+    if (!hasPending()) {
+        m_rxIndex = 0U;
+        if (m_socket->read(m_rxBuffers) < 0) {
+            LogError(LOG_NET, "Failed reading data from the network");
+            return nullptr;
+        }
+
+        if (m_rxBuffers.empty()) {
+            return nullptr;
+        }
     }
 
+    UDPDatagram* dgram = m_rxBuffers[m_rxIndex++];
+    const uint8_t* buffer = dgram->buffer;
+    int length = (int)dgram->length;
+    address = dgram->address;
+    addrLen = dgram->addrLen;
+
     if (length > 0) {
         if (m_debug)
             Utils::dump(1U, "Network Packet", buffer, length);
@@ -133,6 +163,14 @@ UInt8Array FrameQueue::read(int& messageLength, sockaddr_storage& address, uint3
             *fneHeader = _fneHeader;
         }
 
+        // ensure the message fits the datagram received
+        uint32_t headerLength = RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES + RTP_FNE_HEADER_LENGTH_BYTES;
+        if ((uint32_t)length < headerLength || _fneHeader.getMessageLength() > (uint32_t)length - headerLength) {
+            LogError(LOG_NET, "FrameQueue::read(), message received from network is malformed! %u bytes > %u bytes",
+                _fneHeader.getMessageLength() + headerLength, length);
+            return nullptr;
+        }
+
         // copy message
         messageLength = _fneHeader.getMessageLength();
         __UNIQUE_UINT8_ARRAY(message, messageLength);
@@ -146,12 +184,22 @@ UInt8Array FrameQueue::read(int& messageLength, sockaddr_storage& address, uint3
         }
 
         // LogDebug(LOG_NET, "message buffer, addr %p len %u", message.get(), messageLength);
+        Metrics::add(METRIC_NET_FRAMES_IN);
         return message;
     }
 
     return nullptr;
 }
 
+/// <summary>
+/// Gets whether datagrams received by the last batched read are still waiting to be read.
+/// </summary>
+/// <returns>True, if datagrams are waiting to be read, otherwise false.</returns>
+bool FrameQueue::hasPending() const
+{
+    return m_rxIndex < m_rxBuffers.size();
+}
+
 /// <summary>
 /// Cache "message" to frame queue.
 /// </summary>
@@ -189,48 +237,67 @@ void FrameQueue::enqueueMessage(const uint8_t* message, uint32_t length, uint32_
     assert(message != nullptr);
     assert(length > 0U);
 
-    uint32_t bufferLen = RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES + RTP_FNE_HEADER_LENGTH_BYTES + length;
-    uint8_t* buffer = new uint8_t[bufferLen];
-    ::memset(buffer, 0x00U, bufferLen);
-
-    RTPHeader header = RTPHeader();
-    header.setExtension(true);
+    uint8_t header[FRAME_HEADER_LENGTH];
+    generateHeader(header, message, length, streamId, peerId, ssrc, opcode, rtpSeq);
 
-    header.setPayloadType(DVM_RTP_PAYLOAD_TYPE);
-    header.setSequence(rtpSeq);
-    header.setSSRC(ssrc);
-
-    // properly flag control opcodes
-    if ((opcode.first == NET_FUNC_TRANSFER) || (opcode.first == NET_FUNC_GRANT_REQ)) {
-        header.setPayloadType(DVM_CTRL_RTP_PAYLOAD_TYPE);
-        header.setSequence(0U);
-    }
+    FrameBuffer* payload = m_bufferPool.acquire(message, length);
+    if (m_debug)
+        dumpMessage(header, payload);
 
-    header.encode(buffer);
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    QueuedFrame* frame = acquireFrame();
+    ::memcpy(frame->header, header, FRAME_HEADER_LENGTH);
+    frame->payload = payload;
+    frame->datagram.address = addr;
+    frame->datagram.addrLen = addrLen;
 
-    RTPFNEHeader fneHeader = RTPFNEHeader();
-    fneHeader.setCRC(edac::CRC::createCRC16(message, length * 8U));
-    fneHeader.setStreamId(streamId);
-    fneHeader.setPeerId(peerId);
-    fneHeader.setMessageLength(length);
+    m_queue.push_back(frame);
+}
 
-    fneHeader.setFunction(opcode.first);
-    fneHeader.setSubFunction(opcode.second);
+/// <summary>
+/// Cache "message" to frame queue for each of the given destinations.
+/// </summary>
+/// <remarks>The message is framed (and its CRC calculated) once, and its payload is stored once
+/// in a shared reference counted buffer; each destination only receives its own copy of the
+/// frame header with the peer ID patched, so the next flush writes the entire fan-out with a
+/// single sendmmsg().</remarks>
+/// <param name="message">Message buffer to frame and queue.</param>
+/// <param name="length">Length of message.</param>
+/// <param name="streamId">Message stream ID.</param>
+/// <param name="peers">Destinations to queue the message for.</param>
+/// <param name="ssrc">RTP SSRC ID.</param>
+/// <param name="opcode">Opcode.</param>
+/// <param name="rtpSeq">RTP Sequence.</param>
+void FrameQueue::enqueueFanOut(const uint8_t* message, uint32_t length, uint32_t streamId, const FanOutVector& peers,
+    uint32_t ssrc, OpcodePair opcode, uint16_t rtpSeq)
+{
+    assert(message != nullptr);
+    assert(length > 0U);
 
-    fneHeader.encode(buffer + RTP_HEADER_LENGTH_BYTES);
+    if (peers.empty()) {
+        return;
+    }
 
-    ::memcpy(buffer + RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES + RTP_FNE_HEADER_LENGTH_BYTES, message, length);
+    uint8_t header[FRAME_HEADER_LENGTH];
+    generateHeader(header, message, length, streamId, 0U, ssrc, opcode, rtpSeq);
 
+    FrameBuffer* payload = m_bufferPool.acquire(message, length);
+    payload->addRef((uint32_t)peers.size() - 1U);
     if (m_debug)
-        Utils::dump(1U, "FrameQueue::enqueueMessage() Buffered Message", buffer, bufferLen);
+        dumpMessage(header, payload);
 
-    UDPDatagram* dgram = new UDPDatagram;
-    dgram->buffer = buffer;
-    dgram->length = bufferLen;
-    dgram->address = addr;
-    dgram->addrLen = addrLen;
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    for (const FanOutPeer& peer : peers) {
+        QueuedFrame* frame = acquireFrame();
+        ::memcpy(frame->header, header, FRAME_HEADER_LENGTH);
+        __SET_UINT32(peer.peerId, frame->header, RTP_HEADER_LENGTH_BYTES + 12U);        // Peer ID
 
-    m_buffers.push_back(dgram);
+        frame->payload = payload;
+        frame->datagram.address = peer.address;
+        frame->datagram.addrLen = peer.addrLen;
+
+        m_queue.push_back(frame);
+    }
 }
 
 /// <summary>
@@ -239,38 +306,127 @@ void FrameQueue::enqueueMessage(const uint8_t* message, uint32_t length, uint32_
 /// <returns></returns>
 bool FrameQueue::flushQueue()
 {
-    if (m_buffers.empty()) {
+    // FNE packet workers may enqueue and flush concurrently
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    if (m_queue.empty()) {
         return false;
     }
 
-    // bryanb: this is the same as above -- but for some assinine reason prevents
-    // weirdness
-    if (m_buffers.size() == 0U) {
-        return false;
-    }
+    // LogDebug(LOG_NET, "m_queue len = %u", m_queue.size());
 
-    // LogDebug(LOG_NET, "m_buffers len = %u", m_buffers.size());
+    m_buffers.clear();
+    for (QueuedFrame* frame : m_queue) {
+        frame->datagram.buffer = frame->header;
+        frame->datagram.length = FRAME_HEADER_LENGTH;
+        frame->datagram.payload = frame->payload->data();
+        frame->datagram.payloadLength = frame->payload->length();
+        m_buffers.push_back(&frame->datagram);
+    }
 
     bool ret = true;
     if (!m_socket->write(m_buffers)) {
         LogError(LOG_NET, "Failed writing data to the network");
+        Metrics::add(METRIC_NET_SEND_ERRORS);
         ret = false;
     }
+    else {
+        Metrics::add(METRIC_NET_FRAMES_OUT, m_buffers.size());
+    }
+    m_buffers.clear();
 
-    for (auto& buffer : m_buffers) {
-        if (buffer != nullptr) {
-            // LogDebug(LOG_NET, "deleting buffer, addr %p len %u", buffer->buffer, buffer->length);
-            if (buffer->buffer != nullptr) {
-                delete buffer->buffer;
-                buffer->length = 0;
-                buffer->buffer = nullptr;
-            }
-
-            delete buffer;
-            buffer = nullptr;
+    // return the frames (and their payload references) for reuse
+    for (QueuedFrame* frame : m_queue) {
+        frame->payload->release();
+        frame->payload = nullptr;
+
+        if (m_freeFrames.size() < FRAME_QUEUE_MAX_FREE) {
+            m_freeFrames.push_back(frame);
+        }
+        else {
+            delete frame;
         }
     }
-    m_buffers.clear();
+    m_queue.clear();
 
     return ret;
 }
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Helper to get an unused queued frame.
+/// </summary>
+/// <remarks>This must be called with the queue mutex held.</remarks>
+/// <returns></returns>
+FrameQueue::QueuedFrame* FrameQueue::acquireFrame()
+{
+    if (m_freeFrames.empty()) {
+        QueuedFrame* frame = new QueuedFrame();
+        ::memset(frame, 0x00U, sizeof(QueuedFrame));
+        return frame;
+    }
+
+    QueuedFrame* frame = m_freeFrames.back();
+    m_freeFrames.pop_back();
+    return frame;
+}
+
+/// <summary>
+/// Helper to generate the frame header for a message.
+/// </summary>
+/// <param name="header">Buffer to write the frame header to.</param>
+/// <param name="message">Message buffer to frame.</param>
+/// <param name="length">Length of message.</param>
+/// <param name="streamId">Message stream ID.</param>
+/// <param name="peerId">Peer ID.</param>
+/// <param name="ssrc">RTP SSRC ID.</param>
+/// <param name="opcode">Opcode.</param>
+/// <param name="rtpSeq">RTP Sequence.</param>
+void FrameQueue::generateHeader(uint8_t* header, const uint8_t* message, uint32_t length, uint32_t streamId, uint32_t peerId,
+    uint32_t ssrc, OpcodePair opcode, uint16_t rtpSeq)
+{
+    ::memset(header, 0x00U, FRAME_HEADER_LENGTH);
+
+    RTPHeader rtpHeader = RTPHeader();
+    rtpHeader.setExtension(true);
+
+    rtpHeader.setPayloadType(DVM_RTP_PAYLOAD_TYPE);
+    rtpHeader.setSequence(rtpSeq);
+    rtpHeader.setSSRC(ssrc);
+
+    // properly flag control opcodes
+    if ((opcode.first == NET_FUNC_TRANSFER) || (opcode.first == NET_FUNC_GRANT_REQ)) {
+        rtpHeader.setPayloadType(DVM_CTRL_RTP_PAYLOAD_TYPE);
+        rtpHeader.setSequence(0U);
+    }
+
+    rtpHeader.encode(header);
+
+    RTPFNEHeader fneHeader = RTPFNEHeader();
+    fneHeader.setCRC(edac::CRC::createCRC16(message, length * 8U));
+    fneHeader.setStreamId(streamId);
+    fneHeader.setPeerId(peerId);
+    fneHeader.setMessageLength(length);
+
+    fneHeader.setFunction(opcode.first);
+    fneHeader.setSubFunction(opcode.second);
+
+    fneHeader.encode(header + RTP_HEADER_LENGTH_BYTES);
+}
+
+/// <summary>
+/// Helper to dump a framed message.
+/// </summary>
+/// <param name="header">Frame header.</param>
+/// <param name="payload">Frame payload.</param>
+void FrameQueue::dumpMessage(const uint8_t* header, const FrameBuffer* payload)
+{
+    uint32_t bufferLen = FRAME_HEADER_LENGTH + payload->length();
+    UInt8Array buffer = std::unique_ptr<uint8_t[]>(new uint8_t[bufferLen]);
+    ::memcpy(buffer.get(), header, FRAME_HEADER_LENGTH);
+    ::memcpy(buffer.get() + FRAME_HEADER_LENGTH, payload->data(), payload->length());
+
+    Utils::dump(1U, "FrameQueue::enqueueMessage() Buffered Message", buffer.get(), bufferLen);
+}
@@ -28,10 +28,14 @@
 
 #include "Defines.h"
 #include "network/UDPSocket.h"
+#include "network/FrameBufferPool.h"
 #include "network/RTPHeader.h"
 #include "network/RTPExtensionHeader.h"
 #include "network/RTPFNEHeader.h"
 
+#include <mutex>
+#include <vector>
+
 namespace network
 {
     // ---------------------------------------------------------------------------
@@ -39,10 +43,27 @@ namespace network
     // ---------------------------------------------------------------------------
 
     const uint32_t DATA_PACKET_LENGTH = 8192U;
+    const uint32_t FRAME_HEADER_LENGTH = RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES + RTP_FNE_HEADER_LENGTH_BYTES;
+    const uint32_t FRAME_QUEUE_MAX_FREE = 1024U;
     
     const uint8_t DVM_RTP_PAYLOAD_TYPE = 0x56U;
     const uint8_t DVM_CTRL_RTP_PAYLOAD_TYPE = 0x57U; // these are still RTP, but do not carry stream IDs or sequence data
 
+    // ---------------------------------------------------------------------------
+    //  Structure Declaration
+    //      This structure represents a destination for a fanned out message.
+    // ---------------------------------------------------------------------------
+
+    struct FanOutPeer {
+        uint32_t peerId;
+
+        sockaddr_storage address;
+        uint32_t addrLen;
+    };
+
+    /* Vector of destinations for a fanned out message */
+    typedef std::vector<FanOutPeer> FanOutVector;
+
     // ---------------------------------------------------------------------------
     //  Class Declaration
     //      Implements the network frame queuing logic.
@@ -59,6 +80,8 @@ namespace network
         /// <summary>Read message from the received UDP packet.</summary>
         UInt8Array read(int& messageLength, sockaddr_storage& address, uint32_t& addrLen,
                 frame::RTPHeader* rtpHeader = nullptr, frame::RTPFNEHeader* fneHeader = nullptr);
+        /// <summary>Gets whether datagrams received by the last batched read are still waiting to be read.</summary>
+        bool hasPending() const;
 
         /// <summary>Cache "message" to frame queue.</summary>
         void enqueueMessage(const uint8_t* message, uint32_t length, uint32_t streamId, uint32_t peerId,
@@ -67,9 +90,16 @@ namespace network
         void enqueueMessage(const uint8_t* message, uint32_t length, uint32_t streamId, uint32_t peerId,
             uint32_t ssrc, OpcodePair opcode, uint16_t rtpSeq, sockaddr_storage& addr, uint32_t addrLen);
 
+        /// <summary>Cache "message" to frame queue for each of the given destinations.</summary>
+        void enqueueFanOut(const uint8_t* message, uint32_t length, uint32_t streamId, const FanOutVector& peers,
+            uint32_t ssrc, OpcodePair opcode, uint16_t rtpSeq);
+
         /// <summary>Flush the message queue.</summary>
         bool flushQueue();
 
+        /// <summary>Gets the total number of payload buffers allocated from the heap.</summary>
+        uint64_t bufferAllocations() const { return m_bufferPool.allocations(); }
+
     private:
         uint32_t m_peerId;
 
@@ -77,9 +107,30 @@ namespace network
         uint32_t m_addrLen;
         UDPSocket* m_socket;
 
+        BufferVector m_rxBuffers;
+        size_t m_rxIndex;
+
+        class QueuedFrame {
+        public:
+            UDPDatagram datagram;
+            uint8_t header[FRAME_HEADER_LENGTH];
+            FrameBuffer* payload;
+        };
         BufferVector m_buffers;
+        std::vector<QueuedFrame*> m_queue;
+        std::vector<QueuedFrame*> m_freeFrames;
+        FrameBufferPool m_bufferPool;
+        std::mutex m_queueMutex;
 
         bool m_debug;
+
+        /// <summary>Helper to get an unused queued frame.</summary>
+        QueuedFrame* acquireFrame();
+        /// <summary>Helper to generate the frame header for a message.</summary>
+        void generateHeader(uint8_t* header, const uint8_t* message, uint32_t length, uint32_t streamId, uint32_t peerId,
+            uint32_t ssrc, OpcodePair opcode, uint16_t rtpSeq);
+        /// <summary>Helper to dump a framed message.</summary>
+        void dumpMessage(const uint8_t* header, const FrameBuffer* payload);
     };
 } // namespace network
 
@@ -0,0 +1,311 @@
+/**
+* Digital Voice Modem - Host Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software
+*
+*/
+/*
+*   Copyright (C) 2023 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#include "Defines.h"
+#include "network/JitterBuffer.h"
+#include "network/RTPHeader.h"
+
+using namespace network;
+
+#include <cassert>
+#include <cmath>
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Initializes a new instance of the JitterBuffer class.
+/// </summary>
+/// <param name="frameTime">Nominal time between frames of a stream in milliseconds.</param>
+/// <param name="minDepth">Minimum playout depth in frames.</param>
+/// <param name="maxDepth">Maximum playout depth in frames.</param>
+JitterBuffer::JitterBuffer(uint32_t frameTime, uint32_t minDepth, uint32_t maxDepth) :
+    m_frameTime(frameTime),
+    m_minDepth(minDepth),
+    m_maxDepth(maxDepth),
+    m_frames(JITTER_BUFFER_SLOTS),
+    m_count(0U),
+    m_streamId(0U),
+    m_hasSeq(false),
+    m_nextSeq(0U),
+    m_highSeq(0U),
+    m_now(0U),
+    m_firstArrival(0U),
+    m_playing(false),
+    m_gap(false),
+    m_gapStart(0U),
+    m_hasTransit(false),
+    m_lastArrivalTs(0U),
+    m_lastTimestamp(0U),
+    m_jitter(0.0),
+    m_depth(minDepth),
+    m_lateDrops(0U),
+    m_lost(0U),
+    m_reordered(0U)
+{
+    assert(frameTime > 0U);
+    assert(minDepth > 0U);
+    assert(maxDepth >= minDepth && maxDepth < JITTER_BUFFER_SLOTS / 2U);
+}
+
+/// <summary>
+/// Finalizes a instance of the JitterBuffer class.
+/// </summary>
+JitterBuffer::~JitterBuffer()
+{
+    /* stub */
+}
+
+/// <summary>
+/// Resets the stream state of the buffer, discarding any buffered frames.
+/// </summary>
+/// <remarks>The jitter estimate and statistics are kept; they describe the path to the master, not the stream.</remarks>
+void JitterBuffer::reset()
+{
+    for (JitterFrame& frame : m_frames) {
+        frame.data.reset();
+        frame.length = 0U;
+    }
+
+    m_count = 0U;
+    m_streamId = 0U;
+    m_hasSeq = false;
+    m_playing = false;
+    m_gap = false;
+    m_hasTransit = false;
+}
+
+/// <summary>
+/// Adds a received frame to the buffer.
+/// </summary>
+/// <remarks>A frame for a different stream resets the buffer; flush it first to keep its frames.</remarks>
+/// <param name="streamId">Stream ID.</param>
+/// <param name="seq">RTP sequence number.</param>
+/// <param name="timestamp">RTP timestamp.</param>
+/// <param name="data">Frame data (ownership is transferred to the buffer).</param>
+/// <param name="length">Length of frame data.</param>
+/// <returns>True, if the frame was buffered, otherwise false.</returns>
+bool JitterBuffer::addFrame(uint32_t streamId, uint16_t seq, uint32_t timestamp, UInt8Array& data, uint32_t length)
+{
+    if (streamId != m_streamId || !m_hasSeq) {
+        restart(streamId, seq);
+        m_playing = false;
+    }
+
+    int32_t offset = (int16_t)(seq - m_nextSeq);
+    if (offset < 0) {
+        // a frame can only be so late; anything further behind means the sender
+        // restarted its sequence mid-stream, so start over from this frame
+        if (offset > -(int32_t)(m_maxDepth * 2U)) {
+            m_lateDrops++;
+            return false;
+        }
+
+        m_lost += m_count;
+        restart(streamId, seq);
+    }
+
+    // a jump further ahead than the buffer can hold means the stream skipped (or the
+    // sender restarted its sequence); start over from this frame
+    if (offset >= (int32_t)JITTER_BUFFER_SLOTS) {
+        m_lost += m_count;
+        restart(streamId, seq);
+    }
+
+    JitterFrame& frame = m_frames[seq % JITTER_BUFFER_SLOTS];
+    if (frame.data != nullptr) {
+        m_lateDrops++;
+        return false;
+    }
+
+    if ((int16_t)(seq - m_highSeq) < 0) {
+        m_reordered++;
+    }
+    else {
+        m_highSeq = seq;
+        updateJitter(timestamp);
+    }
+
+    frame.data = std::move(data);
+    frame.length = length;
+    m_count++;
+
+    return true;
+}
+
+/// <summary>
+/// Gets the next frame that is due for playout.
+/// </summary>
+/// <remarks>
+/// A stream starts playing once the playout depth worth of frames (or time) is buffered.
+/// A missing frame is waited on for the playout depth worth of time and then skipped,
+/// leaving the protocol layer to conceal the gap.
+/// </remarks>
+/// <param name="length">Length of the returned frame data.</param>
+/// <param name="flush">Flag indicating that every buffered frame should be returned, ignoring playout timing.</param>
+/// <returns>Frame data, or nullptr if no frame is due.</returns>
+UInt8Array JitterBuffer::getFrame(uint32_t& length, bool flush)
+{
+    length = 0U;
+    if (m_count == 0U) {
+        return nullptr;
+    }
+
+    ulong64_t playoutTime = (ulong64_t)m_depth * m_frameTime;
+    if (!m_playing && !flush) {
+        if (m_count < m_depth && (m_now - m_firstArrival) < playoutTime) {
+            return nullptr;
+        }
+
+        m_playing = true;
+    }
+
+    while (true) {
+        JitterFrame& frame = m_frames[m_nextSeq % JITTER_BUFFER_SLOTS];
+        if (frame.data != nullptr) {
+            UInt8Array data = std::move(frame.data);
+            length = frame.length;
+            frame.length = 0U;
+
+            m_count--;
+            m_nextSeq++;
+            m_gap = false;
+            return data;
+        }
+
+        // the next frame is missing but a later one is waiting
+        if (!flush) {
+            if (!m_gap) {
+                m_gap = true;
+                m_gapStart = m_now;
+            }
+
+            if ((m_now - m_gapStart) < playoutTime) {
+                return nullptr;
+            }
+        }
+
+        m_lost++;
+        m_nextSeq++;
+    }
+}
+
+/// <summary>
+/// Updates the buffer by the passed number of milliseconds.
+/// </summary>
+/// <param name="ms"></param>
+void JitterBuffer::clock(uint32_t ms)
+{
+    m_now += ms;
+}
+
+/// <summary>
+/// Gets the time (in milliseconds) until the next frame is due for playout.
+/// </summary>
+/// <returns>Time until the next frame is due, or -1 if the buffer is empty.</returns>
+int32_t JitterBuffer::playoutDelay() const
+{
+    if (m_count == 0U) {
+        return -1;
+    }
+
+    ulong64_t playoutTime = (ulong64_t)m_depth * m_frameTime;
+    ulong64_t start = 0U;
+    if (!m_playing) {
+        if (m_count >= m_depth) {
+            return 0;
+        }
+
+        start = m_firstArrival;
+    }
+    else {
+        if (m_frames[m_nextSeq % JITTER_BUFFER_SLOTS].data != nullptr || !m_gap) {
+            return 0;
+        }
+
+        start = m_gapStart;
+    }
+
+    ulong64_t elapsed = m_now - start;
+    return (elapsed < playoutTime) ? (int32_t)(playoutTime - elapsed) : 0;
+}
+
+/// <summary>
+/// Gets the estimated inter-arrival jitter in milliseconds.
+/// </summary>
+/// <returns></returns>
+float JitterBuffer::jitter() const
+{
+    return (float)(m_jitter * 1000.0 / RTP_GENERIC_CLOCK_RATE);
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Helper to update the jitter estimate and playout depth.
+/// </summary>
+/// <param name="timestamp">RTP timestamp of the frame.</param>
+void JitterBuffer::updateJitter(uint32_t timestamp)
+{
+    if (timestamp == INVALID_TS) {
+        return;
+    }
+
+    // arrival time in RTP timestamp units
+    uint32_t arrivalTs = (uint32_t)(m_now * RTP_GENERIC_CLOCK_RATE / 1000U);
+    if (m_hasTransit) {
+        // interarrival jitter estimate (RFC 3550 section 6.4.1)
+        int32_t d = (int32_t)(arrivalTs - m_lastArrivalTs) - (int32_t)(timestamp - m_lastTimestamp);
+        m_jitter += (std::abs((double)d) - m_jitter) / 16.0;
+
+        // allow for roughly three times the mean deviation before a frame counts as late
+        uint32_t depth = m_minDepth + (uint32_t)std::ceil(3.0 * jitter() / m_frameTime);
+        m_depth = (depth > m_maxDepth) ? m_maxDepth : depth;
+    }
+
+    m_hasTransit = true;
+    m_lastArrivalTs = arrivalTs;
+    m_lastTimestamp = timestamp;
+}
+
+/// <summary>
+/// Helper to discard the buffered frames and restart the stream from the given frame.
+/// </summary>
+/// <param name="streamId">Stream ID.</param>
+/// <param name="seq">RTP sequence number of the frame starting the stream.</param>
+void JitterBuffer::restart(uint32_t streamId, uint16_t seq)
+{
+    reset();
+
+    m_streamId = streamId;
+    m_hasSeq = true;
+    m_nextSeq = seq;
+    m_highSeq = seq;
+    m_firstArrival = m_now;
+    m_playing = true;
+}
@@ -0,0 +1,132 @@
+/**
+* Digital Voice Modem - Host Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software
+*
+*/
+/*
+*   Copyright (C) 2023 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#if !defined(__JITTER_BUFFER_H__)
+#define __JITTER_BUFFER_H__
+
+#include "Defines.h"
+
+#include <vector>
+
+namespace network
+{
+    // ---------------------------------------------------------------------------
+    //  Constants
+    // ---------------------------------------------------------------------------
+
+    const uint32_t  JITTER_BUFFER_SLOTS = 64U;
+
+    const uint32_t  DMR_JITTER_FRAME_TIME = 60U;
+    const uint32_t  P25_JITTER_FRAME_TIME = 180U;
+    const uint32_t  NXDN_JITTER_FRAME_TIME = 80U;
+
+    const uint32_t  JITTER_BUFFER_MIN_DEPTH = 1U;
+    const uint32_t  JITTER_BUFFER_MAX_DEPTH = 8U;
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    //      Implements an adaptive playout buffer for the frames of a network
+    //      call stream. Frames are put back in RTP sequence order, and the
+    //      playout depth follows the measured inter-arrival jitter.
+    // ---------------------------------------------------------------------------
+
+    class HOST_SW_API JitterBuffer {
+    public:
+        /// <summary>Initializes a new instance of the JitterBuffer class.</summary>
+        JitterBuffer(uint32_t frameTime, uint32_t minDepth = JITTER_BUFFER_MIN_DEPTH, uint32_t maxDepth = JITTER_BUFFER_MAX_DEPTH);
+        /// <summary>Finalizes a instance of the JitterBuffer class.</summary>
+        ~JitterBuffer();
+
+        /// <summary>Resets the stream state of the buffer, discarding any buffered frames.</summary>
+        void reset();
+
+        /// <summary>Adds a received frame to the buffer.</summary>
+        bool addFrame(uint32_t streamId, uint16_t seq, uint32_t timestamp, UInt8Array& data, uint32_t length);
+        /// <summary>Gets the next frame that is due for playout.</summary>
+        UInt8Array getFrame(uint32_t& length, bool flush = false);
+
+        /// <summary>Updates the buffer by the passed number of milliseconds.</summary>
+        void clock(uint32_t ms);
+        /// <summary>Gets the time (in milliseconds) until the next frame is due for playout.</summary>
+        int32_t playoutDelay() const;
+
+        /// <summary>Flag indicating whether the buffer holds no frames.</summary>
+        bool isEmpty() const { return m_count == 0U; }
+        /// <summary>Gets the stream ID of the frames in the buffer.</summary>
+        uint32_t streamId() const { return m_streamId; }
+
+        /// <summary>Gets the estimated inter-arrival jitter in milliseconds.</summary>
+        float jitter() const;
+        /// <summary>Gets the current playout depth in frames.</summary>
+        uint32_t depth() const { return m_depth; }
+        /// <summary>Gets the count of frames dropped for arriving after their playout (or twice).</summary>
+        uint32_t lateDrops() const { return m_lateDrops; }
+        /// <summary>Gets the count of frames that never arrived in time for playout.</summary>
+        uint32_t lost() const { return m_lost; }
+        /// <summary>Gets the count of frames that arrived out of order.</summary>
+        uint32_t reordered() const { return m_reordered; }
+
+    private:
+        struct JitterFrame {
+            UInt8Array data;
+            uint32_t length;
+        };
+
+        uint32_t m_frameTime;
+        uint32_t m_minDepth;
+        uint32_t m_maxDepth;
+
+        std::vector<JitterFrame> m_frames;
+        uint32_t m_count;
+
+        uint32_t m_streamId;
+        bool m_hasSeq;
+        uint16_t m_nextSeq;
+        uint16_t m_highSeq;
+
+        ulong64_t m_now;
+        ulong64_t m_firstArrival;
+        bool m_playing;
+        bool m_gap;
+        ulong64_t m_gapStart;
+
+        bool m_hasTransit;
+        uint32_t m_lastArrivalTs;
+        uint32_t m_lastTimestamp;
+        double m_jitter;
+        uint32_t m_depth;
+
+        uint32_t m_lateDrops;
+        uint32_t m_lost;
+        uint32_t m_reordered;
+
+        /// <summary>Helper to update the jitter estimate and playout depth.</summary>
+        void updateJitter(uint32_t timestamp);
+        /// <summary>Helper to discard the buffered frames and restart the stream from the given frame.</summary>
+        void restart(uint32_t streamId, uint16_t seq);
+    };
+} // namespace network
+
+#endif // __JITTER_BUFFER_H__
@@ -0,0 +1,106 @@
+/**
+* Digital Voice Modem - Host Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software
+*
+*/
+/*
+*   Copyright (C) 2023 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#include "Defines.h"
+#include "network/MetricsServer.h"
+#include "Log.h"
+#include "Metrics.h"
+
+using namespace network::rest;
+using namespace network::rest::http;
+
+#include <cassert>
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Initializes a new instance of the MetricsServer class.
+/// </summary>
+/// <param name="address">Network Hostname/IP address to listen on.</param>
+/// <param name="port">Network port number.</param>
+/// <param name="debug"></param>
+MetricsServer::MetricsServer(const std::string& address, uint16_t port, bool debug) :
+    m_dispatcher(debug),
+    m_server(address, port)
+{
+    assert(!address.empty());
+    assert(port > 0U);
+}
+
+/// <summary>
+/// Finalizes a instance of the MetricsServer class.
+/// </summary>
+MetricsServer::~MetricsServer()
+{
+    /* stub */
+}
+
+/// <summary>
+/// Opens connection to the network.
+/// </summary>
+/// <returns></returns>
+bool MetricsServer::open()
+{
+    m_dispatcher.match(GET_METRICS).get(std::bind(&MetricsServer::restAPI_GetMetrics, this,
+        std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+    m_server.setHandler(m_dispatcher);
+
+    return run();
+}
+
+/// <summary>
+/// Closes connection to the network.
+/// </summary>
+void MetricsServer::close()
+{
+    m_server.stop();
+    wait();
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/// <summary>
+///
+/// </summary>
+void MetricsServer::entry()
+{
+    m_server.run();
+}
+
+/// <summary>
+///
+/// </summary>
+/// <param name="request"></param>
+/// <param name="reply"></param>
+/// <param name="match"></param>
+void MetricsServer::restAPI_GetMetrics(const HTTPPayload& request, HTTPPayload& reply, const RequestMatch& match)
+{
+    std::string content = Metrics::format();
+    reply.payload(content, HTTPPayload::OK, METRICS_CONTENT_TYPE);
+}
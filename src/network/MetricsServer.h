@@ -0,0 +1,75 @@
+/**
+* Digital Voice Modem - Host Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software
+*
+*/
+/*
+*   Copyright (C) 2023 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#if !defined(__METRICS_SERVER_H__)
+#define __METRICS_SERVER_H__
+
+#include "Defines.h"
+#include "network/RESTDefines.h"
+#include "network/rest/RequestDispatcher.h"
+#include "network/rest/http/HTTPServer.h"
+#include "Thread.h"
+
+#include <string>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t  METRICS_DEFAULT_PORT = 9991;
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+//      Implements a HTTP server that only serves the metrics endpoint, for
+//      services without a REST API.
+// ---------------------------------------------------------------------------
+
+class HOST_SW_API MetricsServer : private Thread {
+public:
+    /// <summary>Initializes a new instance of the MetricsServer class.</summary>
+    MetricsServer(const std::string& address, uint16_t port, bool debug);
+    /// <summary>Finalizes a instance of the MetricsServer class.</summary>
+    ~MetricsServer();
+
+    /// <summary>Opens connection to the network.</summary>
+    bool open();
+
+    /// <summary>Closes connection to the network.</summary>
+    void close();
+
+private:
+    typedef network::rest::RequestDispatcher<network::rest::http::HTTPPayload, network::rest::http::HTTPPayload> RESTDispatcherType;
+    typedef network::rest::http::HTTPPayload HTTPPayload;
+    RESTDispatcherType m_dispatcher;
+    network::rest::http::HTTPServer<RESTDispatcherType> m_server;
+
+    /// <summary></summary>
+    virtual void entry();
+
+    /// <summary></summary>
+    void restAPI_GetMetrics(const HTTPPayload& request, HTTPPayload& reply, const network::rest::RequestMatch& match);
+};
+
+#endif // __METRICS_SERVER_H__
@@ -83,6 +83,10 @@ Network::Network(const std::string& address, uint16_t port, uint16_t localPort,
     m_salt(nullptr),
     m_retryTimer(1000U, 10U),
     m_timeoutTimer(1000U, 60U),
+    m_rxDMRJitter1(DMR_JITTER_FRAME_TIME),
+    m_rxDMRJitter2(DMR_JITTER_FRAME_TIME),
+    m_rxP25Jitter(P25_JITTER_FRAME_TIME),
+    m_rxNXDNJitter(NXDN_JITTER_FRAME_TIME),
     m_pktSeq(0U),
     m_loginStreamId(0U),
     m_identity(),
@@ -99,7 +103,13 @@ Network::Network(const std::string& address, uint16_t port, uint16_t localPort,
     m_location(),
     m_restApiPassword(),
     m_restApiPort(0),
-    m_remotePeerId(0U)
+    m_remotePeerId(0U),
+    m_ridListVersion(0U),
+    m_ridListGeneration(0U),
+    m_ridListDelta(),
+    m_tgListVersion(0U),
+    m_tgListGeneration(0U),
+    m_tgListDelta()
 {
     assert(!address.empty());
     assert(port > 0U);
@@ -134,9 +144,11 @@ void Network::resetDMR(uint32_t slotNo)
     BaseNetwork::resetDMR(slotNo);
     if (slotNo == 1U) {
         m_rxDMRStreamId[0U] = 0U;
+        m_rxDMRJitter1.reset();
     }
     else {
         m_rxDMRStreamId[1U] = 0U;
+        m_rxDMRJitter2.reset();
     }
 }
 
@@ -147,6 +159,7 @@ void Network::resetP25()
 {
     BaseNetwork::resetP25();
     m_rxP25StreamId = 0U;
+    m_rxP25Jitter.reset();
 }
 
 /// <summary>
@@ -156,6 +169,7 @@ void Network::resetNXDN()
 {
     BaseNetwork::resetNXDN();
     m_rxNXDNStreamId = 0U;
+    m_rxNXDNJitter.reset();
 }
 
 /// <summary>
@@ -248,6 +262,11 @@ void Network::clock(uint32_t ms)
         return;
     }
 
+    m_rxDMRJitter1.clock(ms);
+    m_rxDMRJitter2.clock(ms);
+    m_rxP25Jitter.clock(ms);
+    m_rxNXDNJitter.clock(ms);
+
     sockaddr_storage address;
     uint32_t addrLen;
 
@@ -255,293 +274,396 @@ void Network::clock(uint32_t ms)
     frame::RTPFNEHeader fneHeader;
     int length = 0U;
 
-    // read message
-    UInt8Array buffer = m_frameQueue->read(length, address, addrLen, &rtpHeader, &fneHeader);
-    if (length > 0) {
-        if (!UDPSocket::match(m_addr, address)) {
-            LogError(LOG_NET, "Packet received from an invalid source");
-            return;
-        }
+    // read messages; a single batched read may return several datagrams, process all of them in this pass
+    do {
+        UInt8Array buffer = m_frameQueue->read(length, address, addrLen, &rtpHeader, &fneHeader);
+        if (length > 0) {
+            if (!UDPSocket::match(m_addr, address)) {
+                LogError(LOG_NET, "Packet received from an invalid source");
+                continue;
+            }
 
-        if (m_debug) {
-            LogDebug(LOG_NET, "RTP, peerId = %u, seq = %u, streamId = %u, func = %02X, subFunc = %02X", fneHeader.getPeerId(), rtpHeader.getSequence(),
-                fneHeader.getStreamId(), fneHeader.getFunction(), fneHeader.getSubFunction());
-        }
+            if (m_debug) {
+                LogDebug(LOG_NET, "RTP, peerId = %u, seq = %u, streamId = %u, func = %02X, subFunc = %02X", fneHeader.getPeerId(), rtpHeader.getSequence(),
+                    fneHeader.getStreamId(), fneHeader.getFunction(), fneHeader.getSubFunction());
+            }
 
-        // ensure the RTP synchronization source ID matches the FNE peer ID
-        if (m_remotePeerId != 0U && rtpHeader.getSSRC() != m_remotePeerId) {
-            LogWarning(LOG_NET, "RTP header and traffic session do not agree on remote peer ID? %u != %u", rtpHeader.getSSRC(), m_remotePeerId);
-            // should this be a fatal error?
-        }
+            // ensure the RTP synchronization source ID matches the FNE peer ID
+            if (m_remotePeerId != 0U && rtpHeader.getSSRC() != m_remotePeerId) {
+                LogWarning(LOG_NET, "RTP header and traffic session do not agree on remote peer ID? %u != %u", rtpHeader.getSSRC(), m_remotePeerId);
+                // should this be a fatal error?
+            }
 
-        // is this RTP packet destined for us?
-        uint32_t peerId = fneHeader.getPeerId();
-        if (m_peerId != peerId) {
-            LogError(LOG_NET, "Packet received was not destined for us? peerId = %u", peerId);
-            return;
-        }
+            // is this RTP packet destined for us?
+            uint32_t peerId = fneHeader.getPeerId();
+            if (m_peerId != peerId) {
+                LogError(LOG_NET, "Packet received was not destined for us? peerId = %u", peerId);
+                continue;
+            }
 
-        // peer connections should never encounter no stream ID
-        uint32_t streamId = fneHeader.getStreamId();
-        if (streamId == 0U) {
-            LogWarning(LOG_NET, "BUGBUG: strange RTP packet with no stream ID?");
-        }
+            // peer connections should never encounter no stream ID
+            uint32_t streamId = fneHeader.getStreamId();
+            if (streamId == 0U) {
+                LogWarning(LOG_NET, "BUGBUG: strange RTP packet with no stream ID?");
+            }
 
-        m_pktSeq = rtpHeader.getSequence();
-
-        // process incoming message frame opcodes
-        switch (fneHeader.getFunction()) {
-        case NET_FUNC_PROTOCOL:
-            {
-                if (fneHeader.getSubFunction() == NET_PROTOCOL_SUBFUNC_DMR) {           // Encapsulated DMR data frame
-#if defined(ENABLE_DMR)
-                    if (m_enabled && m_dmrEnabled) {
-                        uint32_t slotNo = (buffer[15U] & 0x80U) == 0x80U ? 2U : 1U;
-                        if (m_rxDMRStreamId[slotNo] == 0U) {
-                            m_rxDMRStreamId[slotNo] = streamId;
-                            m_pktLastSeq = m_pktSeq;
-                        }
-                        else {
-                            if (m_rxDMRStreamId[slotNo] == streamId) {
-                                if (m_pktSeq != 0U && m_pktLastSeq != 0U) {
-                                    if (m_pktSeq >= 1U && m_pktSeq != m_pktLastSeq + 1) {
-                                        LogWarning(LOG_NET, "DMR Stream %u out-of-sequence; %u != %u", streamId, m_pktSeq, m_pktLastSeq + 1);
+            m_pktSeq = rtpHeader.getSequence();
+
+            // process incoming message frame opcodes
+            switch (fneHeader.getFunction()) {
+            case NET_FUNC_PROTOCOL:
+                {
+                    if (fneHeader.getSubFunction() == NET_PROTOCOL_SUBFUNC_DMR) {           // Encapsulated DMR data frame
+    #if defined(ENABLE_DMR)
+                        if (m_enabled && m_dmrEnabled) {
+                            uint32_t slotNo = (buffer[15U] & 0x80U) == 0x80U ? 2U : 1U;
+                            if (m_rxDMRStreamId[slotNo] == 0U) {
+                                m_rxDMRStreamId[slotNo] = streamId;
+                                m_pktLastSeq = m_pktSeq;
+                            }
+                            else {
+                                if (m_rxDMRStreamId[slotNo] == streamId) {
+                                    if (m_pktSeq != 0U && m_pktLastSeq != 0U) {
+                                        if (m_pktSeq >= 1U && m_pktSeq != m_pktLastSeq + 1) {
+                                            LogWarning(LOG_NET, "DMR Stream %u out-of-sequence; %u != %u", streamId, m_pktSeq, m_pktLastSeq + 1);
+                                        }
                                     }
-                                }
         
-                                m_pktLastSeq = m_pktSeq;
+                                    m_pktLastSeq = m_pktSeq;
+                                }
                             }
-                        }
                        
-                        if (m_debug)
-                            Utils::dump(1U, "Network Received, DMR", buffer.get(), length);
+                            if (m_debug)
+                                Utils::dump(1U, "Network Received, DMR", buffer.get(), length);
 
-                        uint8_t len = length;
-                        m_rxDMRData.addData(&len, 1U);
-                        m_rxDMRData.addData(buffer.get(), len);
-                    }
-#endif // defined(ENABLE_DMR)
-                }
-                else if (fneHeader.getSubFunction() == NET_PROTOCOL_SUBFUNC_P25) {      // Encapsulated P25 data frame
-#if defined(ENABLE_P25)
-                    if (m_enabled && m_p25Enabled) {
-                        if (m_rxP25StreamId == 0U) {
-                            m_rxP25StreamId = streamId;
-                            m_pktLastSeq = m_pktSeq;
+                            bufferFrame((slotNo == 1U) ? m_rxDMRJitter1 : m_rxDMRJitter2, m_rxDMRData, streamId, m_pktSeq,
+                                rtpHeader.getTimestamp(), buffer, length);
                         }
-                        else {
-                            if (m_rxP25StreamId == streamId) {
-                                if (m_pktSeq != 0U && m_pktLastSeq != 0U) {
-                                    if (m_pktSeq >= 1U && m_pktSeq != m_pktLastSeq + 1) {
-                                        LogWarning(LOG_NET, "P25 Stream %u out-of-sequence; %u != %u", streamId, m_pktSeq, m_pktLastSeq + 1);
+    #endif // defined(ENABLE_DMR)
+                    }
+                    else if (fneHeader.getSubFunction() == NET_PROTOCOL_SUBFUNC_P25) {      // Encapsulated P25 data frame
+    #if defined(ENABLE_P25)
+                        if (m_enabled && m_p25Enabled) {
+                            if (m_rxP25StreamId == 0U) {
+                                m_rxP25StreamId = streamId;
+                                m_pktLastSeq = m_pktSeq;
+                            }
+                            else {
+                                if (m_rxP25StreamId == streamId) {
+                                    if (m_pktSeq != 0U && m_pktLastSeq != 0U) {
+                                        if (m_pktSeq >= 1U && m_pktSeq != m_pktLastSeq + 1) {
+                                            LogWarning(LOG_NET, "P25 Stream %u out-of-sequence; %u != %u", streamId, m_pktSeq, m_pktLastSeq + 1);
+                                        }
                                     }
-                                }
         
-                                m_pktLastSeq = m_pktSeq;
+                                    m_pktLastSeq = m_pktSeq;
+                                }
                             }
+
+                            if (m_debug)
+                                Utils::dump(1U, "Network Received, P25", buffer.get(), length);
+
+                            bufferFrame(m_rxP25Jitter, m_rxP25Data, streamId, m_pktSeq, rtpHeader.getTimestamp(), buffer, length);
                         }
+    #endif // defined(ENABLE_P25)
+                    }
+                    else if (fneHeader.getSubFunction() == NET_PROTOCOL_SUBFUNC_NXDN) {     // Encapsulated NXDN data frame
+    #if defined(ENABLE_NXDN)
+                        if (m_enabled && m_nxdnEnabled) {
+                            if (m_rxNXDNStreamId == 0U) {
+                                m_rxNXDNStreamId = streamId;
+                                m_pktLastSeq = m_pktSeq;
+                            }
+                            else {
+                                if (m_rxNXDNStreamId == streamId) {
+                                    if (m_pktSeq != 0U && m_pktLastSeq != 0U) {
+                                        if (m_pktSeq >= 1U && m_pktSeq != m_pktLastSeq + 1) {
+                                            LogWarning(LOG_NET, "NXDN Stream %u out-of-sequence; %u != %u", streamId, m_pktSeq, m_pktLastSeq + 1);
+                                        }
+                                    }
+        
+                                    m_pktLastSeq = m_pktSeq;
+                                }
+                            }
 
-                        if (m_debug)
-                            Utils::dump(1U, "Network Received, P25", buffer.get(), length);
+                            if (m_debug)
+                                Utils::dump(1U, "Network Received, NXDN", buffer.get(), length);
 
-                        uint8_t len = length;
-                        m_rxP25Data.addData(&len, 1U);
-                        m_rxP25Data.addData(buffer.get(), len);
+                            bufferFrame(m_rxNXDNJitter, m_rxNXDNData, streamId, m_pktSeq, rtpHeader.getTimestamp(), buffer, length);
+                        }
+    #endif // defined(ENABLE_NXDN)
+                    }
+                    else {
+                        Utils::dump("Unknown protocol opcode from the master", buffer.get(), length);
                     }
-#endif // defined(ENABLE_P25)
                 }
-                else if (fneHeader.getSubFunction() == NET_PROTOCOL_SUBFUNC_NXDN) {     // Encapsulated NXDN data frame
-#if defined(ENABLE_NXDN)
-                    if (m_enabled && m_nxdnEnabled) {
-                        if (m_rxNXDNStreamId == 0U) {
-                            m_rxNXDNStreamId = streamId;
-                            m_pktLastSeq = m_pktSeq;
+                break;
+
+            case NET_FUNC_MASTER:
+                {
+                    if (fneHeader.getSubFunction() == NET_MASTER_SUBFUNC_WL_RID) {          // Radio ID Whitelist
+                        if (m_enabled && m_updateLookup) {
+                            if (m_debug)
+                                Utils::dump(1U, "Network Received, WL RID", buffer.get(), length);
+
+                            if (m_ridLookup != nullptr) {
+                                // update RID lists
+                                uint32_t len = __GET_UINT16(buffer, 7U);
+                                uint32_t j = 0U;
+                                std::vector<uint32_t> ids;
+                                for (uint8_t i = 0; i < len; i++) {
+                                    uint32_t id = __GET_UINT16(buffer, 11U + j);
+                                    ids.push_back(id);
+                                    j += 4U;
+                                }
+
+                                // apply the whole list as a single table update
+                                m_ridLookup->toggleEntries(ids, true);
+                            }
                         }
-                        else {
-                            if (m_rxNXDNStreamId == streamId) {
-                                if (m_pktSeq != 0U && m_pktLastSeq != 0U) {
-                                    if (m_pktSeq >= 1U && m_pktSeq != m_pktLastSeq + 1) {
-                                        LogWarning(LOG_NET, "NXDN Stream %u out-of-sequence; %u != %u", streamId, m_pktSeq, m_pktLastSeq + 1);
-                                    }
+                    }
+                    else if (fneHeader.getSubFunction() == NET_MASTER_SUBFUNC_BL_RID) {     // Radio ID Blacklist
+                        if (m_enabled && m_updateLookup) {
+                            if (m_debug)
+                                Utils::dump(1U, "Network Received, BL RID", buffer.get(), length);
+
+                            if (m_ridLookup != nullptr) {
+                                // update RID lists
+                                uint32_t len = __GET_UINT16(buffer, 7U);
+                                uint32_t j = 0U;
+                                std::vector<uint32_t> ids;
+                                for (uint8_t i = 0; i < len; i++) {
+                                    uint32_t id = __GET_UINT16(buffer, 11U + j);
+                                    ids.push_back(id);
+                                    j += 4U;
                                 }
-        
-                                m_pktLastSeq = m_pktSeq;
+
+                                // apply the whole list as a single table update
+                                m_ridLookup->toggleEntries(ids, false);
                             }
                         }
+                    }
+                    else if (fneHeader.getSubFunction() == NET_MASTER_SUBFUNC_ACTIVE_TGS) { // Talkgroup Active IDs
+                        if (m_enabled && m_updateLookup) {
+                            if (m_debug)
+                                Utils::dump(1U, "Network Received, ACTIVE TGS", buffer.get(), length);
+
+                            if (m_tidLookup != nullptr) {
+                                // update TGID lists
+                                std::vector<std::pair<uint32_t, uint8_t>> activated;
+                                uint32_t len = __GET_UINT16(buffer, 7U);
+                                uint32_t j = 0U;
+                                for (uint8_t i = 0; i < len; i++) {
+                                    uint32_t id = __GET_UINT16(buffer, 11U + j);
+                                    uint8_t slot = (buffer[14U + j]);
+
+                                    lookups::TalkgroupRuleGroupVoice tid = m_tidLookup->find(id, slot);
+                                    if (tid.isInvalid()) {
+                                        LogMessage(LOG_NET, "Activated TG %u TS %u in TGID table", id, slot);
+                                        activated.push_back(std::make_pair(id, slot));
+                                    }
 
-                        if (m_debug)
-                            Utils::dump(1U, "Network Received, NXDN", buffer.get(), length);
+                                    j += 5U;
+                                }
 
-                        uint8_t len = length;
-                        m_rxNXDNData.addData(&len, 1U);
-                        m_rxNXDNData.addData(buffer.get(), len);
-                    }
-#endif // defined(ENABLE_NXDN)
-                }
-                else {
-                    Utils::dump("Unknown protocol opcode from the master", buffer.get(), length);
-                }
-            }
-            break;
-
-        case NET_FUNC_MASTER:
-            {
-                if (fneHeader.getSubFunction() == NET_MASTER_SUBFUNC_WL_RID) {          // Radio ID Whitelist
-                    if (m_enabled && m_updateLookup) {
-                        if (m_debug)
-                            Utils::dump(1U, "Network Received, WL RID", buffer.get(), length);
-
-                        if (m_ridLookup != nullptr) {
-                            // update RID lists
-                            uint32_t len = __GET_UINT16(buffer, 7U);
-                            uint32_t j = 0U;
-                            for (uint8_t i = 0; i < len; i++) {
-                                uint32_t id = __GET_UINT16(buffer, 11U + j);
-                                m_ridLookup->toggleEntry(id, true);
-                                j += 4U;
+                                // apply the whole list as a single table update
+                                m_tidLookup->addEntries(activated, true);
+                                LogMessage(LOG_NET, "Activated %u TGs; loaded %u entries into lookup table", len, m_tidLookup->snapshot()->size());
                             }
                         }
                     }
-                }
-                else if (fneHeader.getSubFunction() == NET_MASTER_SUBFUNC_BL_RID) {     // Radio ID Blacklist
-                    if (m_enabled && m_updateLookup) {
-                        if (m_debug)
-                            Utils::dump(1U, "Network Received, BL RID", buffer.get(), length);
-
-                        if (m_ridLookup != nullptr) {
-                            // update RID lists
-                            uint32_t len = __GET_UINT16(buffer, 7U);
-                            uint32_t j = 0U;
-                            for (uint8_t i = 0; i < len; i++) {
-                                uint32_t id = __GET_UINT16(buffer, 11U + j);
-                                m_ridLookup->toggleEntry(id, false);
-                                j += 4U;
+                    else if (fneHeader.getSubFunction() == NET_MASTER_SUBFUNC_DEACTIVE_TGS) { // Talkgroup Deactivated IDs
+                        if (m_enabled && m_updateLookup) {
+                            if (m_debug)
+                                Utils::dump(1U, "Network Received, DEACTIVE TGS", buffer.get(), length);
+
+                            if (m_tidLookup != nullptr) {
+                                // update TGID lists
+                                std::vector<std::pair<uint32_t, uint8_t>> deactivated;
+                                uint32_t len = __GET_UINT16(buffer, 7U);
+                                uint32_t j = 0U;
+                                for (uint8_t i = 0; i < len; i++) {
+                                    uint32_t id = __GET_UINT16(buffer, 11U + j);
+                                    uint8_t slot = (buffer[14U + j]);
+
+                                    lookups::TalkgroupRuleGroupVoice tid = m_tidLookup->find(id, slot);
+                                    if (!tid.isInvalid()) {
+                                        LogMessage(LOG_NET, "Deactivated TG %u TS %u in TGID table", id, slot);
+                                        deactivated.push_back(std::make_pair(id, slot));
+                                    }
+
+                                    j += 5U;
+                                }
+
+                                // apply the whole list as a single table update
+                                m_tidLookup->eraseEntries(deactivated);
+                                LogMessage(LOG_NET, "Deactivated %u TGs; loaded %u entries into lookup table", len, m_tidLookup->snapshot()->size());
                             }
                         }
                     }
-                }
-                else if (fneHeader.getSubFunction() == NET_MASTER_SUBFUNC_ACTIVE_TGS) { // Talkgroup Active IDs
-                    if (m_enabled && m_updateLookup) {
-                        if (m_debug)
-                            Utils::dump(1U, "Network Received, ACTIVE TGS", buffer.get(), length);
-
-                        if (m_tidLookup != nullptr) {
-                            // update TGID lists
-                            uint32_t len = __GET_UINT16(buffer, 7U);
-                            uint32_t j = 0U;
-                            for (uint8_t i = 0; i < len; i++) {
-                                uint32_t id = __GET_UINT16(buffer, 11U + j);
-                                uint8_t slot = (buffer[14U + j]);
-
-                                lookups::TalkgroupRuleGroupVoice tid = m_tidLookup->find(id, slot);
-                                if (tid.isInvalid()) {
-                                    if (!tid.config().active()) {
-                                        m_tidLookup->eraseEntry(id, slot);
+                    else if (fneHeader.getSubFunction() == NET_MASTER_SUBFUNC_RID_DELTA) {  // Radio ID List Delta
+                        if (m_enabled) {
+                            if (m_debug)
+                                Utils::dump(1U, "Network Received, RID DELTA", buffer.get(), length);
+
+                            uint32_t count = 0U;
+                            bool complete = false;
+                            if (trackListDelta(m_ridListDelta, m_ridListVersion, buffer.get(), length, LIST_DELTA_RID_RECORD_LEN, count, complete)) {
+                                if (m_updateLookup && m_ridLookup != nullptr) {
+                                    std::vector<uint32_t> whitelist, blacklist, removed;
+                                    const uint8_t* records = buffer.get() + 6U + LIST_DELTA_HEADER_LEN;
+                                    for (uint32_t i = 0U; i < count; i++) {
+                                        const uint8_t* record = records + (i * LIST_DELTA_RID_RECORD_LEN);
+                                        uint32_t id = __GET_UINT32(record, 0U);
+                                        switch (record[4U]) {
+                                        case LIST_DELTA_RID_WHITELIST:
+                                            whitelist.push_back(id);
+                                            break;
+                                        case LIST_DELTA_RID_BLACKLIST:
+                                            blacklist.push_back(id);
+                                            break;
+                                        default:
+                                            removed.push_back(id);
+                                            break;
+                                        }
+                                    }
+
+                                    m_ridLookup->addEntries(whitelist, true);
+                                    m_ridLookup->addEntries(blacklist, false);
+                                    m_ridLookup->eraseEntries(removed);
+                                    m_ridListGeneration = m_ridLookup->generation();
+
+                                    if (count > 0U) {
+                                        LogMessage(LOG_NET, "Whitelisted %u, blacklisted %u and removed %u RIDs; loaded %u entries into lookup table",
+                                            whitelist.size(), blacklist.size(), removed.size(), m_ridLookup->snapshot()->size());
                                     }
-                                    
-                                    LogMessage(LOG_NET, "Activated TG %u TS %u in TGID table", id, slot);
-                                    m_tidLookup->addEntry(id, slot, true);
                                 }
 
-                                j += 5U;
+                                if (complete) {
+                                    m_ridListVersion = m_ridListDelta.toVersion;
+                                    if (m_ridLookup != nullptr) {
+                                        m_ridListGeneration = m_ridLookup->generation();
+                                    }
+                                }
                             }
-                            LogMessage(LOG_NET, "Activated %u TGs; loaded %u entries into lookup table", len, m_tidLookup->groupVoice().size());
                         }
                     }
-                }
-                else if (fneHeader.getSubFunction() == NET_MASTER_SUBFUNC_DEACTIVE_TGS) { // Talkgroup Deactivated IDs
-                    if (m_enabled && m_updateLookup) {
-                        if (m_debug)
-                            Utils::dump(1U, "Network Received, DEACTIVE TGS", buffer.get(), length);
-
-                        if (m_tidLookup != nullptr) {
-                            // update TGID lists
-                            uint32_t len = __GET_UINT16(buffer, 7U);
-                            uint32_t j = 0U;
-                            for (uint8_t i = 0; i < len; i++) {
-                                uint32_t id = __GET_UINT16(buffer, 11U + j);
-                                uint8_t slot = (buffer[14U + j]);
-
-                                lookups::TalkgroupRuleGroupVoice tid = m_tidLookup->find(id, slot);
-                                if (!tid.isInvalid()) {
-                                    LogMessage(LOG_NET, "Deactivated TG %u TS %u in TGID table", id, slot);
-                                    m_tidLookup->eraseEntry(id, slot);
+                    else if (fneHeader.getSubFunction() == NET_MASTER_SUBFUNC_TG_DELTA) {   // Talkgroup List Delta
+                        if (m_enabled) {
+                            if (m_debug)
+                                Utils::dump(1U, "Network Received, TG DELTA", buffer.get(), length);
+
+                            uint32_t count = 0U;
+                            bool complete = false;
+                            if (trackListDelta(m_tgListDelta, m_tgListVersion, buffer.get(), length, LIST_DELTA_TG_RECORD_LEN, count, complete)) {
+                                if (m_updateLookup && m_tidLookup != nullptr) {
+                                    std::vector<std::pair<uint32_t, uint8_t>> activated, deactivated;
+                                    const uint8_t* records = buffer.get() + 6U + LIST_DELTA_HEADER_LEN;
+                                    for (uint32_t i = 0U; i < count; i++) {
+                                        const uint8_t* record = records + (i * LIST_DELTA_TG_RECORD_LEN);
+                                        uint32_t id = __GET_UINT32(record, 0U);
+                                        uint8_t slot = record[4U];
+
+                                        if (record[5U] == LIST_DELTA_TG_ACTIVATE) {
+                                            LogMessage(LOG_NET, "Activated TG %u TS %u in TGID table", id, slot);
+                                            activated.push_back(std::make_pair(id, slot));
+                                        }
+                                        else {
+                                            LogMessage(LOG_NET, "Deactivated TG %u TS %u in TGID table", id, slot);
+                                            deactivated.push_back(std::make_pair(id, slot));
+                                        }
+                                    }
+
+                                    // the log only carries the latest change of each talkgroup, so the order is irrelevant
+                                    m_tidLookup->addEntries(activated, true);
+                                    m_tidLookup->eraseEntries(deactivated);
+                                    m_tgListGeneration = m_tidLookup->generation();
                                 }
 
-                                j += 5U;
+                                if (complete) {
+                                    m_tgListVersion = m_tgListDelta.toVersion;
+                                    if (m_tidLookup != nullptr) {
+                                        m_tgListGeneration = m_tidLookup->generation();
+                                    }
+                                }
                             }
-                            LogMessage(LOG_NET, "Deactivated %u TGs; loaded %u entries into lookup table", len, m_tidLookup->groupVoice().size());
                         }
                     }
+                    else {
+                        Utils::dump("Unknown master control opcode from the master", buffer.get(), length);
+                    }
                 }
-                else {
-                    Utils::dump("Unknown master control opcode from the master", buffer.get(), length);
-                }
-            }
-            break;
+                break;
 
-        case NET_FUNC_NAK:                                                              // Master Negative Ack
-            {
-                if (m_status == NET_STAT_RUNNING) {
-                    LogWarning(LOG_NET, "Master returned a NAK; attemping to relogin ...");
-                    m_status = NET_STAT_WAITING_LOGIN;
-                    m_timeoutTimer.start();
-                    m_retryTimer.start();
+            case NET_FUNC_NAK:                                                              // Master Negative Ack
+                {
+                    if (m_status == NET_STAT_RUNNING) {
+                        LogWarning(LOG_NET, "Master returned a NAK; attemping to relogin ...");
+                        m_status = NET_STAT_WAITING_LOGIN;
+                        m_timeoutTimer.start();
+                        m_retryTimer.start();
+                    }
+                    else {
+                        LogError(LOG_NET, "Master returned a NAK; network reconnect ...");
+                        close();
+                        open();
+                        return;
+                    }
                 }
-                else {
-                    LogError(LOG_NET, "Master returned a NAK; network reconnect ...");
+                break;
+            case NET_FUNC_ACK:                                                              // Repeater Ack
+                {
+                    switch (m_status) {
+                        case NET_STAT_WAITING_LOGIN:
+                            LogDebug(LOG_NET, "Sending authorisation");
+                            ::memcpy(m_salt, buffer.get() + 6U, sizeof(uint32_t));
+                            writeAuthorisation();
+                            m_status = NET_STAT_WAITING_AUTHORISATION;
+                            m_timeoutTimer.start();
+                            m_retryTimer.start();
+                            break;
+                        case NET_STAT_WAITING_AUTHORISATION:
+                            LogDebug(LOG_NET, "Sending configuration");
+                            writeConfig();
+                            m_status = NET_STAT_WAITING_CONFIG;
+                            m_timeoutTimer.start();
+                            m_retryTimer.start();
+                            break;
+                        case NET_STAT_WAITING_CONFIG:
+                            LogMessage(LOG_NET, "Logged into the master successfully");
+                            m_loginStreamId = 0U;
+                            m_remotePeerId = rtpHeader.getSSRC();
+                            pktSeq(true);
+                            m_status = NET_STAT_RUNNING;
+                            m_timeoutTimer.start();
+                            m_retryTimer.start();
+                            break;
+                        default:
+                            break;
+                    }
+                }
+                break;
+            case NET_FUNC_MST_CLOSING:                                                      // Master Shutdown
+                {
+                    LogError(LOG_NET, "Master is closing down");
                     close();
                     open();
-                    return;
-                }
-            }
-            break;
-        case NET_FUNC_ACK:                                                              // Repeater Ack
-            {
-                switch (m_status) {
-                    case NET_STAT_WAITING_LOGIN:
-                        LogDebug(LOG_NET, "Sending authorisation");
-                        ::memcpy(m_salt, buffer.get() + 6U, sizeof(uint32_t));
-                        writeAuthorisation();
-                        m_status = NET_STAT_WAITING_AUTHORISATION;
-                        m_timeoutTimer.start();
-                        m_retryTimer.start();
-                        break;
-                    case NET_STAT_WAITING_AUTHORISATION:
-                        LogDebug(LOG_NET, "Sending configuration");
-                        writeConfig();
-                        m_status = NET_STAT_WAITING_CONFIG;
-                        m_timeoutTimer.start();
-                        m_retryTimer.start();
-                        break;
-                    case NET_STAT_WAITING_CONFIG:
-                        LogMessage(LOG_NET, "Logged into the master successfully");
-                        m_loginStreamId = 0U;
-                        m_remotePeerId = rtpHeader.getSSRC();
-                        pktSeq(true);
-                        m_status = NET_STAT_RUNNING;
-                        m_timeoutTimer.start();
-                        m_retryTimer.start();
-                        break;
-                    default:
-                        break;
                 }
+                break;
+            case NET_FUNC_PONG:                                                             // Master Ping Response
+                m_timeoutTimer.start();
+                break;
+            default:
+                Utils::dump("Unknown opcode from the master", buffer.get(), length);
             }
-            break;
-        case NET_FUNC_MST_CLOSING:                                                      // Master Shutdown
-            {
-                LogError(LOG_NET, "Master is closing down");
-                close();
-                open();
-            }
-            break;
-        case NET_FUNC_PONG:                                                             // Master Ping Response
-            m_timeoutTimer.start();
-            break;
-        default:
-            Utils::dump("Unknown opcode from the master", buffer.get(), length);
         }
-    }
+    } while (m_frameQueue->hasPending());
+
+    // hand the frames that are due for playout to the protocol ring buffers
+    playoutFrames(m_rxDMRJitter1, m_rxDMRData, false);
+    playoutFrames(m_rxDMRJitter2, m_rxDMRData, false);
+    playoutFrames(m_rxP25Jitter, m_rxP25Data, false);
+    playoutFrames(m_rxNXDNJitter, m_rxNXDNData, false);
 
     m_retryTimer.clock(ms);
     if (m_retryTimer.isRunning() && m_retryTimer.hasExpired()) {
@@ -605,6 +727,24 @@ void Network::enable(bool enabled)
     m_enabled = enabled;
 }
 
+/// <summary>
+/// Gets the time (in milliseconds) until the next buffered frame is due for playout.
+/// </summary>
+/// <returns>Time until the next frame is due, or -1 if no frames are buffered.</returns>
+int32_t Network::playoutDelay() const
+{
+    int32_t delay = -1;
+
+    const JitterBuffer* buffers[] = { &m_rxDMRJitter1, &m_rxDMRJitter2, &m_rxP25Jitter, &m_rxNXDNJitter };
+    for (const JitterBuffer* jitter : buffers) {
+        int32_t due = jitter->playoutDelay();
+        if (due >= 0 && (delay < 0 || due < delay))
+            delay = due;
+    }
+
+    return delay;
+}
+
 /// <summary>
 /// Closes connection to the network.
 /// </summary>
@@ -632,6 +772,51 @@ void Network::close()
 //  Private Class Members
 // ---------------------------------------------------------------------------
 
+/// <summary>
+/// Helper to buffer a received protocol frame in its stream jitter buffer.
+/// </summary>
+/// <param name="jitter">Jitter buffer for the stream.</param>
+/// <param name="ring">Protocol ring buffer.</param>
+/// <param name="streamId">Stream ID.</param>
+/// <param name="seq">RTP sequence number.</param>
+/// <param name="timestamp">RTP timestamp.</param>
+/// <param name="buffer">Frame data (ownership is transferred to the jitter buffer).</param>
+/// <param name="length">Length of frame data.</param>
+void Network::bufferFrame(JitterBuffer& jitter, RingBuffer<uint8_t>& ring, uint32_t streamId, uint16_t seq, uint32_t timestamp,
+    UInt8Array& buffer, uint32_t length)
+{
+    // a new stream takes over the buffer; whatever is left of the previous stream is played out now
+    if (jitter.streamId() != streamId) {
+        playoutFrames(jitter, ring, true);
+    }
+
+    if (!jitter.addFrame(streamId, seq, timestamp, buffer, length)) {
+        if (m_debug) {
+            LogDebug(LOG_NET, "Stream %u, dropped late frame, seq = %u, jitter = %.1fms, depth = %u", streamId, seq,
+                jitter.jitter(), jitter.depth());
+        }
+    }
+}
+
+/// <summary>
+/// Helper to move the frames due for playout from a jitter buffer into a protocol ring buffer.
+/// </summary>
+/// <param name="jitter">Jitter buffer for the stream.</param>
+/// <param name="ring">Protocol ring buffer.</param>
+/// <param name="flush">Flag indicating that every buffered frame should be played out.</param>
+void Network::playoutFrames(JitterBuffer& jitter, RingBuffer<uint8_t>& ring, bool flush)
+{
+    uint32_t length = 0U;
+    UInt8Array buffer = jitter.getFrame(length, flush);
+    while (buffer != nullptr) {
+        uint8_t len = length;
+        ring.addData(&len, 1U);
+        ring.addData(buffer.get(), len);
+
+        buffer = jitter.getFrame(length, flush);
+    }
+}
+
 /// <summary>
 /// Writes login request to the network.
 /// </summary>
@@ -733,6 +918,13 @@ bool Network::writeConfig()
 
     config["software"].set<std::string>(std::string(software));                     // Software ID
 
+    // list deltas
+    checkListVersions();
+    bool listDelta = true;
+    config["listDelta"].set<bool>(listDelta);                                       // Accepts List Deltas
+    config["ridListVersion"].set<uint32_t>(m_ridListVersion);                       // RID List Version Held
+    config["tgListVersion"].set<uint32_t>(m_tgListVersion);                         // TGID List Version Held
+
     json::value v = json::value(config);
     std::string json = v.serialize();
 
@@ -753,11 +945,91 @@ bool Network::writeConfig()
 /// </summary>
 bool Network::writePing()
 {
-    uint8_t buffer[1U];
-    ::memset(buffer, 0x00U, 1U);
+    uint8_t buffer[PING_LIST_VERSION_LEN];
+    ::memset(buffer, 0x00U, PING_LIST_VERSION_LEN);
+
+    // report the list versions held, so the master only sends list changes
+    checkListVersions();
+    __SET_UINT32(m_ridListVersion, buffer, 1U);
+    __SET_UINT32(m_tgListVersion, buffer, 5U);
 
     if (m_debug)
-        Utils::dump(1U, "Network Message, Ping", buffer, 11U);
+        Utils::dump(1U, "Network Message, Ping", buffer, PING_LIST_VERSION_LEN);
+
+    return writeMaster({ NET_FUNC_PING, NET_SUBFUNC_NOP }, buffer, PING_LIST_VERSION_LEN, 0U, createStreamId());
+}
+
+/// <summary>
+/// Helper to validate and track a received list delta chunk.
+/// </summary>
+/// <remarks>
+/// A delta from version 0 carries the full list and applies regardless of the version held; any
+/// other delta only applies to the version it was built from. The new version is only taken once
+/// every chunk of the delta has been received.
+/// </remarks>
+/// <param name="state">List delta tracking state.</param>
+/// <param name="heldVersion">Version of the list held.</param>
+/// <param name="data">Received message.</param>
+/// <param name="length">Length of received message.</param>
+/// <param name="recordLen">Length of a single delta record.</param>
+/// <param name="count">Number of delta records in this chunk.</param>
+/// <param name="complete">Flag indicating every chunk of the delta has been received.</param>
+/// <returns>True, if the delta records in this chunk should be applied, otherwise false.</returns>
+bool Network::trackListDelta(ListDeltaState& state, uint32_t heldVersion, const uint8_t* data, uint32_t length, uint32_t recordLen,
+    uint32_t& count, bool& complete)
+{
+    count = 0U;
+    complete = false;
+
+    if (length < 6U + LIST_DELTA_HEADER_LEN) {
+        return false;
+    }
 
-    return writeMaster({ NET_FUNC_PING, NET_SUBFUNC_NOP }, buffer, 1U, 0U, createStreamId());
+    const uint8_t* header = data + 6U;
+    uint32_t fromVersion = __GET_UINT32(header, 0U);
+    uint32_t toVersion = __GET_UINT32(header, 4U);
+    uint32_t chunk = (header[8U] << 8) | header[9U];
+    uint32_t chunks = (header[10U] << 8) | header[11U];
+    uint32_t records = __GET_UINT32(header, 12U);
+
+    if (chunks == 0U || chunk >= chunks || records > LIST_DELTA_MAX_RECORDS ||
+        length < 6U + LIST_DELTA_HEADER_LEN + (records * recordLen)) {
+        LogWarning(LOG_NET, "Master sent a malformed list delta");
+        return false;
+    }
+
+    if (fromVersion != 0U && fromVersion != heldVersion) {
+        return false; // stale; the master will resend from the version reported with the next ping
+    }
+
+    if (state.fromVersion != fromVersion || state.toVersion != toVersion || state.chunks.size() != chunks) {
+        state.fromVersion = fromVersion;
+        state.toVersion = toVersion;
+        state.chunks.assign(chunks, false);
+        state.received = 0U;
+    }
+
+    if (!state.chunks[chunk]) {
+        state.chunks[chunk] = true;
+        state.received++;
+    }
+
+    count = records;
+    complete = (state.received == chunks);
+    return true;
+}
+
+/// <summary>
+/// Helper to invalidate list versions whose lookup tables were changed by something other than a list delta.
+/// </summary>
+/// <remarks>A lookup table reloaded from its local file no longer matches the version received from the master.</remarks>
+void Network::checkListVersions()
+{
+    if (m_ridLookup != nullptr && m_ridLookup->generation() != m_ridListGeneration) {
+        m_ridListVersion = 0U;
+    }
+
+    if (m_tidLookup != nullptr && m_tidLookup->generation() != m_tgListGeneration) {
+        m_tgListVersion = 0U;
+    }
 }
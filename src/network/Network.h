@@ -33,11 +33,13 @@
 
 #include "Defines.h"
 #include "network/BaseNetwork.h"
+#include "network/JitterBuffer.h"
 #include "lookups/RadioIdLookup.h"
 #include "lookups/TalkgroupRulesLookup.h"
 
 #include <string>
 #include <cstdint>
+#include <vector>
 
 namespace network
 {
@@ -81,6 +83,15 @@ namespace network
         /// <summary>Sets flag enabling network communication.</summary>
         void enable(bool enabled);
 
+        /// <summary>Gets the jitter buffer for the given DMR slot.</summary>
+        const JitterBuffer& dmrJitterBuffer(uint32_t slotNo) const { return (slotNo == 1U) ? m_rxDMRJitter1 : m_rxDMRJitter2; }
+        /// <summary>Gets the P25 jitter buffer.</summary>
+        const JitterBuffer& p25JitterBuffer() const { return m_rxP25Jitter; }
+        /// <summary>Gets the NXDN jitter buffer.</summary>
+        const JitterBuffer& nxdnJitterBuffer() const { return m_rxNXDNJitter; }
+        /// <summary>Gets the time (in milliseconds) until the next buffered frame is due for playout.</summary>
+        int32_t playoutDelay() const;
+
     public:
         /// <summary>Last received RTP sequence number.</summary>
         __READONLY_PROPERTY_PLAIN(uint16_t, pktLastSeq, pktLastSeq);
@@ -111,6 +122,11 @@ namespace network
         uint32_t m_rxP25StreamId;
         uint32_t m_rxNXDNStreamId;
 
+        JitterBuffer m_rxDMRJitter1;
+        JitterBuffer m_rxDMRJitter2;
+        JitterBuffer m_rxP25Jitter;
+        JitterBuffer m_rxNXDNJitter;
+
         uint16_t m_pktSeq;
         uint32_t m_loginStreamId;
 
@@ -135,6 +151,32 @@ namespace network
 
         uint32_t m_remotePeerId;
 
+        class ListDeltaState {
+        public:
+            uint32_t fromVersion;
+            uint32_t toVersion;
+            std::vector<bool> chunks;
+            uint32_t received;
+        };
+        uint32_t m_ridListVersion;
+        uint32_t m_ridListGeneration;
+        ListDeltaState m_ridListDelta;
+        uint32_t m_tgListVersion;
+        uint32_t m_tgListGeneration;
+        ListDeltaState m_tgListDelta;
+
+        /// <summary>Helper to validate and track a received list delta chunk.</summary>
+        bool trackListDelta(ListDeltaState& state, uint32_t heldVersion, const uint8_t* data, uint32_t length, uint32_t recordLen,
+            uint32_t& count, bool& complete);
+        /// <summary>Helper to invalidate list versions whose lookup tables were changed by something other than a list delta.</summary>
+        void checkListVersions();
+
+        /// <summary>Helper to buffer a received protocol frame in its stream jitter buffer.</summary>
+        void bufferFrame(JitterBuffer& jitter, RingBuffer<uint8_t>& ring, uint32_t streamId, uint16_t seq, uint32_t timestamp,
+            UInt8Array& buffer, uint32_t length);
+        /// <summary>Helper to move the frames due for playout from a jitter buffer into a protocol ring buffer.</summary>
+        void playoutFrames(JitterBuffer& jitter, RingBuffer<uint8_t>& ring, bool flush);
+
         /// <summary>Writes login request to the network.</summary>
         bool writeLogin();
         /// <summary>Writes network authentication challenge.</summary>
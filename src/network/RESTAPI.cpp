@@ -36,9 +36,11 @@
 #include "modem/Modem.h"
 #include "host/Host.h"
 #include "network/json/json.h"
+#include "remote/RESTClientPool.h"
 #include "RESTAPI.h"
 #include "HostMain.h"
 #include "Log.h"
+#include "Metrics.h"
 #include "Thread.h"
 #include "Utils.h"
 
@@ -61,6 +63,13 @@ using namespace modem;
 
 #define REST_API_BIND(funcAddr, classInstance) std::bind(&funcAddr, classInstance, std::placeholders::_1,  std::placeholders::_2, std::placeholders::_3)
 
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t STATUS_STREAM_INTERVAL_MS = 100U;
+const uint32_t STATUS_STREAM_HEARTBEAT_MS = 5000U;
+
 // ---------------------------------------------------------------------------
 //  Global Functions
 // ---------------------------------------------------------------------------
@@ -109,6 +118,29 @@ void errorPayload(HTTPPayload& reply, std::string message, HTTPPayload::StatusTy
     reply.payload(response);
 }
 
+/// <summary>
+/// Helper to build the status of a network jitter buffer.
+/// </summary>
+/// <param name="jitter"></param>
+/// <returns></returns>
+json::object jitterBufferStatus(const network::JitterBuffer& jitter)
+{
+    json::object info = json::object();
+
+    float jitterMs = jitter.jitter();
+    info["jitterMs"].set<float>(jitterMs);
+    uint32_t depth = jitter.depth();
+    info["depth"].set<uint32_t>(depth);
+    uint32_t lateDrops = jitter.lateDrops();
+    info["lateDrops"].set<uint32_t>(lateDrops);
+    uint32_t lost = jitter.lost();
+    info["lost"].set<uint32_t>(lost);
+    uint32_t reordered = jitter.reordered();
+    info["reordered"].set<uint32_t>(reordered);
+
+    return info;
+}
+
 /// <summary>
 ///
 /// </summary>
@@ -156,7 +188,7 @@ bool parseRequestBody(const HTTPPayload& request, HTTPPayload& reply, json::obje
 /// <param name="debug"></param>
 RESTAPI::RESTAPI(const std::string& address, uint16_t port, const std::string& password, Host* host, bool debug) :
     m_dispatcher(debug),
-    m_restServer(address, port),
+    m_restServer(address, port, true),
     m_random(),
     m_p25MFId(p25::P25_MFG_STANDARD),
     m_password(password),
@@ -168,6 +200,11 @@ RESTAPI::RESTAPI(const std::string& address, uint16_t port, const std::string& p
     m_nxdn(nullptr),
     m_ridLookup(nullptr),
     m_tidLookup(nullptr),
+    m_streamStatus(),
+    m_streamIdleTime(0U),
+    m_p25VOC(false),
+    m_nxdnVOC(false),
+    m_peerId(0U),
     m_authTokens()
 {
     assert(!address.empty());
@@ -238,6 +275,14 @@ bool RESTAPI::open()
     initializeEndpoints();
     m_restServer.setHandler(m_dispatcher);
 
+    // configuration reported by the status stream doesn't change at runtime, look it up once
+    m_p25VOC = m_host->m_conf["protocols"]["p25"]["voiceOnControl"].as<bool>(false);
+    m_nxdnVOC = m_host->m_conf["protocols"]["nxdn"]["voiceOnControl"].as<bool>(false);
+    m_peerId = m_host->m_conf["network"]["id"].as<uint32_t>(0U);
+
+    m_streamStatus = statusStreamState();
+    m_restServer.setTimer(STATUS_STREAM_INTERVAL_MS, [this]() { statusStreamClock(); });
+
     return run();
 }
 
@@ -271,6 +316,8 @@ void RESTAPI::initializeEndpoints()
 
     m_dispatcher.match(GET_VERSION).get(REST_API_BIND(RESTAPI::restAPI_GetVersion, this));
     m_dispatcher.match(GET_STATUS).get(REST_API_BIND(RESTAPI::restAPI_GetStatus, this));
+    m_dispatcher.match(GET_STATUS_STREAM).get(REST_API_BIND(RESTAPI::restAPI_GetStatusStream, this));
+    m_dispatcher.match(GET_METRICS).get(REST_API_BIND(RESTAPI::restAPI_GetMetrics, this));
     m_dispatcher.match(GET_VOICE_CH).get(REST_API_BIND(RESTAPI::restAPI_GetVoiceCh, this));
 
     m_dispatcher.match(PUT_MDM_MODE).put(REST_API_BIND(RESTAPI::restAPI_PutModemMode, this));
@@ -317,11 +364,76 @@ void RESTAPI::initializeEndpoints()
     */
 
     m_dispatcher.match(GET_NXDN_CC).get(REST_API_BIND(RESTAPI::restAPI_GetNXDNCC, this));
-    m_dispatcher.match(GET_NXDN_DEBUG).get(REST_API_BIND(RESTAPI::restAPI_GetNXDNDebug, this));
-    m_dispatcher.match(GET_NXDN_DUMP_RCCH).get(REST_API_BIND(RESTAPI::restAPI_GetNXDNDumpRCCH, this));
+    m_dispatcher.match(GET_NXDN_DEBUG, true).get(REST_API_BIND(RESTAPI::restAPI_GetNXDNDebug, this));
+    m_dispatcher.match(GET_NXDN_DUMP_RCCH, true).get(REST_API_BIND(RESTAPI::restAPI_GetNXDNDumpRCCH, this));
     m_dispatcher.match(GET_NXDN_CC_DEDICATED).get(REST_API_BIND(RESTAPI::restAPI_GetNXDNCCEnable, this));
 }
 
+/// <summary>
+/// Helper to get the status reported by the status stream.
+/// </summary>
+/// <remarks>This is the subset of the status endpoint a monitor displays; it is cheap enough to sample
+/// every stream interval.</remarks>
+/// <returns></returns>
+json::object RESTAPI::statusStreamState()
+{
+    json::object state = json::object();
+
+    state["state"].set<uint8_t>(m_host->m_state);
+    state["peerId"].set<uint32_t>(m_peerId);
+
+    state["dmrTSCCEnable"].set<bool>(m_host->m_dmrTSCCData);
+    state["dmrCC"].set<bool>(m_host->m_dmrCtrlChannel);
+    state["p25CtrlEnable"].set<bool>(m_host->m_p25CCData);
+    state["p25CC"].set<bool>(m_host->m_p25CtrlChannel);
+    state["p25VOC"].set<bool>(m_p25VOC);
+    state["nxdnCtrlEnable"].set<bool>(m_host->m_nxdnCCData);
+    state["nxdnCC"].set<bool>(m_host->m_nxdnCtrlChannel);
+    state["nxdnVOC"].set<bool>(m_nxdnVOC);
+
+    state["tx"].set<bool>(m_host->m_modem->m_tx);
+
+    state["channelId"].set<uint8_t>(m_host->m_channelId);
+    state["channelNo"].set<uint32_t>(m_host->m_channelNo);
+
+    state["lastDstId"].set<uint32_t>(m_host->m_lastDstId);
+    state["lastSrcId"].set<uint32_t>(m_host->m_lastSrcId);
+
+    return state;
+}
+
+/// <summary>
+/// Helper to push status changes to the status stream clients.
+/// </summary>
+/// <remarks>This runs on the REST API thread every stream interval; only the values that changed since
+/// the last interval are pushed, with an empty update as a heartbeat when nothing has.</remarks>
+void RESTAPI::statusStreamClock()
+{
+    json::object state = statusStreamState();
+
+    json::object delta = json::object();
+    for (auto& entry : state) {
+        auto last = m_streamStatus.find(entry.first);
+        if (last == m_streamStatus.end() || last->second != entry.second) {
+            delta[entry.first] = entry.second;
+        }
+    }
+
+    m_streamStatus = state;
+
+    m_streamIdleTime += STATUS_STREAM_INTERVAL_MS;
+    if (delta.empty() && m_streamIdleTime < STATUS_STREAM_HEARTBEAT_MS) {
+        return;
+    }
+
+    m_streamIdleTime = 0U;
+    if (m_restServer.streams(GET_STATUS_STREAM) == 0U) {
+        return;
+    }
+
+    m_restServer.push(GET_STATUS_STREAM, json::value(delta).serialize());
+}
+
 /// <summary>
 ///
 /// </summary>
@@ -619,9 +731,76 @@ void RESTAPI::restAPI_GetStatus(const HTTPPayload& request, HTTPPayload& reply,
         response["modem"].set<json::object>(modemInfo);
     }
 
+    if (m_host->m_network != nullptr) {
+        // playout statistics of the streams received from the master
+        json::object jitterInfo = json::object();
+        json::object dmr1 = jitterBufferStatus(m_host->m_network->dmrJitterBuffer(1U));
+        jitterInfo["dmr1"].set<json::object>(dmr1);
+        json::object dmr2 = jitterBufferStatus(m_host->m_network->dmrJitterBuffer(2U));
+        jitterInfo["dmr2"].set<json::object>(dmr2);
+        json::object p25 = jitterBufferStatus(m_host->m_network->p25JitterBuffer());
+        jitterInfo["p25"].set<json::object>(p25);
+        json::object nxdn = jitterBufferStatus(m_host->m_network->nxdnJitterBuffer());
+        jitterInfo["nxdn"].set<json::object>(nxdn);
+
+        response["netJitter"].set<json::object>(jitterInfo);
+    }
+
+    RESTClientPool* restClient = RESTClientPool::instance();
+    if (restClient != nullptr) {
+        // grant-to-permit latency, as seen by this host when acting as a control channel
+        RESTClientLatency permit = restClient->latency(PUT_PERMIT_TG);
+
+        json::object permitInfo = json::object();
+        uint32_t count = (uint32_t)permit.count;
+        permitInfo["count"].set<uint32_t>(count);
+        uint32_t failures = (uint32_t)permit.failures;
+        permitInfo["failures"].set<uint32_t>(failures);
+        permitInfo["lastMs"].set<uint32_t>(permit.lastMs);
+        permitInfo["maxMs"].set<uint32_t>(permit.maxMs);
+        uint32_t avgMs = (permit.count > 0U) ? (uint32_t)(permit.totalMs / permit.count) : 0U;
+        permitInfo["avgMs"].set<uint32_t>(avgMs);
+
+        response["permitLatency"].set<json::object>(permitInfo);
+    }
+
     reply.payload(response);
 }
 
+/// <summary>
+///
+/// </summary>
+/// <param name="request"></param>
+/// <param name="reply"></param>
+/// <param name="match"></param>
+void RESTAPI::restAPI_GetStatusStream(const HTTPPayload& request, HTTPPayload& reply, const RequestMatch& match)
+{
+    if (!validateAuth(request, reply)) {
+        return;
+    }
+
+    // the stream starts with the full status, later chunks only carry what changed
+    json::object response = statusStreamState();
+    setResponseDefaultStatus(response);
+
+    std::string content = json::value(response).serialize();
+    reply.stream(content);
+}
+
+/// <summary>
+///
+/// </summary>
+/// <param name="request"></param>
+/// <param name="reply"></param>
+/// <param name="match"></param>
+void RESTAPI::restAPI_GetMetrics(const HTTPPayload& request, HTTPPayload& reply, const RequestMatch& match)
+{
+    // metrics are scraped without the token exchange (which Prometheus cannot perform); they
+    // only carry counters, no configuration or control
+    std::string content = Metrics::format();
+    reply.payload(content, HTTPPayload::OK, METRICS_CONTENT_TYPE);
+}
+
 /// <summary>
 ///
 /// </summary>
@@ -29,6 +29,7 @@
 #include "Defines.h"
 #include "network/UDPSocket.h"
 #include "network/RESTDefines.h"
+#include "network/json/json.h"
 #include "network/rest/RequestDispatcher.h"
 #include "network/rest/http/HTTPServer.h"
 #include "lookups/RadioIdLookup.h"
@@ -93,6 +94,12 @@ private:
     ::lookups::RadioIdLookup* m_ridLookup;
     ::lookups::TalkgroupRulesLookup* m_tidLookup;
 
+    json::object m_streamStatus;
+    uint32_t m_streamIdleTime;
+    bool m_p25VOC;
+    bool m_nxdnVOC;
+    uint32_t m_peerId;
+
     typedef std::unordered_map<std::string, uint64_t>::value_type AuthTokenValueType;
     std::unordered_map<std::string, uint64_t> m_authTokens;
 
@@ -102,6 +109,11 @@ private:
     /// <summary>Helper to initialize REST API endpoints.</summary>
     void initializeEndpoints();
 
+    /// <summary>Helper to get the status reported by the status stream.</summary>
+    json::object statusStreamState();
+    /// <summary>Helper to push status changes to the status stream clients.</summary>
+    void statusStreamClock();
+
     /// <summary></summary>
     void invalidateHostToken(const std::string host);
     /// <summary></summary>
@@ -115,6 +127,10 @@ private:
     /// <summary></summary>
     void restAPI_GetStatus(const HTTPPayload& request, HTTPPayload& reply, const network::rest::RequestMatch& match);
     /// <summary></summary>
+    void restAPI_GetStatusStream(const HTTPPayload& request, HTTPPayload& reply, const network::rest::RequestMatch& match);
+    /// <summary></summary>
+    void restAPI_GetMetrics(const HTTPPayload& request, HTTPPayload& reply, const network::rest::RequestMatch& match);
+    /// <summary></summary>
     void restAPI_GetVoiceCh(const HTTPPayload& request, HTTPPayload& reply, const network::rest::RequestMatch& match);
 
     /// <summary></summary>
@@ -38,6 +38,8 @@
 
 #define GET_VERSION                     "/version"
 #define GET_STATUS                      "/status"
+#define GET_STATUS_STREAM               "/status-stream"
+#define GET_METRICS                     "/metrics"
 #define GET_VOICE_CH                    "/voice-ch"
 
 #define PUT_MDM_MODE                    "/mdm/mode"
@@ -0,0 +1,262 @@
+/**
+* Digital Voice Modem - Host Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software
+*
+*/
+/*
+*   Copyright (C) 2023 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#include "Defines.h"
+#include "network/Reactor.h"
+#include "Log.h"
+
+using namespace network;
+
+#include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <algorithm>
+
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#else
+#include <poll.h>
+#endif
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+#if !defined(__linux__)
+/// <summary>
+/// Helper to get the current monotonic time in milliseconds.
+/// </summary>
+/// <returns></returns>
+static uint64_t monotonicNow()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+#endif
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Initializes a new instance of the Reactor class.
+/// </summary>
+Reactor::Reactor() :
+    m_tickInterval(0U),
+#if defined(__linux__)
+    m_epollFd(-1),
+    m_timerFd(-1)
+#else
+    m_fds(),
+    m_nextTick(0U)
+#endif
+{
+    /* stub */
+}
+
+/// <summary>
+/// Finalizes a instance of the Reactor class.
+/// </summary>
+Reactor::~Reactor()
+{
+    close();
+}
+
+/// <summary>
+/// Opens the reactor.
+/// </summary>
+/// <param name="tickInterval">Interval (in milliseconds) of the housekeeping tick.</param>
+/// <returns>True, if the reactor was opened, otherwise false.</returns>
+bool Reactor::open(uint32_t tickInterval)
+{
+    assert(tickInterval > 0U);
+    m_tickInterval = tickInterval;
+
+#if defined(__linux__)
+    m_epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    if (m_epollFd < 0) {
+        LogError(LOG_NET, "Cannot create the epoll instance, err: %d", errno);
+        return false;
+    }
+
+    m_timerFd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (m_timerFd < 0) {
+        LogError(LOG_NET, "Cannot create the housekeeping timer, err: %d", errno);
+        close();
+        return false;
+    }
+
+    struct itimerspec spec;
+    spec.it_interval.tv_sec = tickInterval / 1000U;
+    spec.it_interval.tv_nsec = (tickInterval % 1000U) * 1000000L;
+    spec.it_value = spec.it_interval;
+    if (::timerfd_settime(m_timerFd, 0, &spec, nullptr) < 0) {
+        LogError(LOG_NET, "Cannot start the housekeeping timer, err: %d", errno);
+        close();
+        return false;
+    }
+
+    if (!watch(m_timerFd)) {
+        close();
+        return false;
+    }
+#else
+    m_fds.clear();
+    m_nextTick = monotonicNow() + tickInterval;
+#endif
+
+    return true;
+}
+
+/// <summary>
+/// Closes the reactor.
+/// </summary>
+void Reactor::close()
+{
+#if defined(__linux__)
+    if (m_timerFd >= 0) {
+        ::close(m_timerFd);
+        m_timerFd = -1;
+    }
+
+    if (m_epollFd >= 0) {
+        ::close(m_epollFd);
+        m_epollFd = -1;
+    }
+#else
+    m_fds.clear();
+#endif
+}
+
+/// <summary>
+/// Watches the given descriptor for readability.
+/// </summary>
+/// <remarks>Watching an already watched descriptor is harmless; a closed descriptor stops being
+/// watched, so descriptors should be watched again after they are reopened.</remarks>
+/// <param name="fd">Descriptor to watch.</param>
+/// <returns>True, if the descriptor is watched, otherwise false.</returns>
+bool Reactor::watch(int fd)
+{
+    if (fd < 0) {
+        return false;
+    }
+
+#if defined(__linux__)
+    struct epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.fd = fd;
+    if (::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &ev) < 0 && errno != EEXIST) {
+        LogError(LOG_NET, "Cannot watch descriptor %d, err: %d", fd, errno);
+        return false;
+    }
+#else
+    if (std::find(m_fds.begin(), m_fds.end(), fd) == m_fds.end()) {
+        m_fds.push_back(fd);
+    }
+#endif
+
+    return true;
+}
+
+/// <summary>
+/// Waits for a watched descriptor to become readable or the housekeeping tick to expire.
+/// </summary>
+/// <param name="timeout">Maximum time (in milliseconds) to wait, or -1 to wait until an event occurs.</param>
+/// <param name="ticked">Flag indicating whether the housekeeping tick expired.</param>
+/// <returns>Number of readable descriptors, or -1 on error.</returns>
+int Reactor::wait(int timeout, bool& ticked)
+{
+    ticked = false;
+
+#if defined(__linux__)
+    struct epoll_event events[REACTOR_MAX_EVENTS];
+    int ret = ::epoll_wait(m_epollFd, events, REACTOR_MAX_EVENTS, timeout);
+    if (ret < 0) {
+        if (errno == EINTR)
+            return 0;
+
+        LogError(LOG_NET, "Error returned from epoll_wait, err: %d", errno);
+        return -1;
+    }
+
+    int ready = 0;
+    for (int i = 0; i < ret; i++) {
+        if (events[i].data.fd == m_timerFd) {
+            uint64_t expirations = 0U;
+            ssize_t len = ::read(m_timerFd, &expirations, sizeof(expirations));
+            (void)len;
+            ticked = true;
+        }
+        else {
+            ready++;
+        }
+    }
+
+    return ready;
+#else
+    uint64_t now = monotonicNow();
+    int tickTimeout = (m_nextTick > now) ? (int)(m_nextTick - now) : 0;
+    if (timeout < 0 || timeout > tickTimeout) {
+        timeout = tickTimeout;
+    }
+
+    struct pollfd pfd[REACTOR_MAX_EVENTS];
+    nfds_t n = 0U;
+    for (int fd : m_fds) {
+        if (n == REACTOR_MAX_EVENTS)
+            break;
+        pfd[n].fd = fd;
+        pfd[n].events = POLLIN;
+        pfd[n].revents = 0;
+        n++;
+    }
+
+    int ret = ::poll(pfd, n, timeout);
+    if (ret < 0 && errno != EINTR) {
+        LogError(LOG_NET, "Error returned from poll, err: %d", errno);
+        return -1;
+    }
+
+    int ready = 0;
+    for (nfds_t i = 0U; i < n && ret > 0; i++) {
+        if (pfd[i].revents & POLLNVAL) {
+            // descriptor was closed, stop watching it
+            m_fds.erase(std::remove(m_fds.begin(), m_fds.end(), pfd[i].fd), m_fds.end());
+        }
+        else if (pfd[i].revents & POLLIN) {
+            ready++;
+        }
+    }
+
+    now = monotonicNow();
+    if (now >= m_nextTick) {
+        m_nextTick = now + m_tickInterval;
+        ticked = true;
+    }
+
+    return ready;
+#endif
+}
@@ -0,0 +1,79 @@
+/**
+* Digital Voice Modem - Host Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software
+*
+*/
+/*
+*   Copyright (C) 2023 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#if !defined(__REACTOR_H__)
+#define __REACTOR_H__
+
+#include "Defines.h"
+
+#include <vector>
+
+namespace network
+{
+    // ---------------------------------------------------------------------------
+    //  Constants
+    // ---------------------------------------------------------------------------
+
+    const uint32_t  REACTOR_MAX_EVENTS = 16U;
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    //      Implements an event reactor that waits for watched descriptors to
+    //      become readable, or a periodic housekeeping tick to expire. (On Linux
+    //      this uses epoll and a timerfd, otherwise poll.)
+    // ---------------------------------------------------------------------------
+
+    class HOST_SW_API Reactor {
+    public:
+        /// <summary>Initializes a new instance of the Reactor class.</summary>
+        Reactor();
+        /// <summary>Finalizes a instance of the Reactor class.</summary>
+        ~Reactor();
+
+        /// <summary>Opens the reactor.</summary>
+        bool open(uint32_t tickInterval);
+        /// <summary>Closes the reactor.</summary>
+        void close();
+
+        /// <summary>Watches the given descriptor for readability.</summary>
+        bool watch(int fd);
+
+        /// <summary>Waits for a watched descriptor to become readable or the housekeeping tick to expire.</summary>
+        int wait(int timeout, bool& ticked);
+
+    private:
+        uint32_t m_tickInterval;
+
+#if defined(__linux__)
+        int m_epollFd;
+        int m_timerFd;
+#else
+        std::vector<int> m_fds;
+        uint64_t m_nextTick;
+#endif
+    };
+} // namespace network
+
+#endif // __REACTOR_H__
@@ -43,7 +43,7 @@ using namespace network;
 //  Constants
 // ---------------------------------------------------------------------------
 
-#define MAX_BUFFER_COUNT 16384
+#define MAX_BUFFER_COUNT 1024          // sendmmsg() will not send more then UIO_MAXIOV messages per call
 
 // ---------------------------------------------------------------------------
 //  Public Class Members
@@ -57,7 +57,11 @@ UDPSocket::UDPSocket(const std::string& address, uint16_t port) :
     m_address_save(address),
     m_port_save(port),
     m_isOpen(false),
-    m_counter(0U)
+    m_counter(0U),
+    m_datagramsSent(0U),
+    m_sendCalls(0U),
+    m_sendErrors(0U),
+    m_rxBatch(nullptr)
 {
     for (int i = 0; i < UDP_SOCKET_MAX; i++) {
         m_address[i] = "";
@@ -65,6 +69,10 @@ UDPSocket::UDPSocket(const std::string& address, uint16_t port) :
         m_af[i] = 0U;
         m_fd[i] = -1;
     }
+
+    for (uint32_t i = 0U; i < UDP_SOCKET_RX_HISTOGRAM_BUCKETS; i++) {
+        m_readBatchHistogram[i] = 0U;
+    }
 }
 
 /// <summary>
@@ -75,7 +83,11 @@ UDPSocket::UDPSocket(uint16_t port) :
     m_address_save(),
     m_port_save(port),
     m_isOpen(false),
-    m_counter(0U)
+    m_counter(0U),
+    m_datagramsSent(0U),
+    m_sendCalls(0U),
+    m_sendErrors(0U),
+    m_rxBatch(nullptr)
 {
     for (int i = 0; i < UDP_SOCKET_MAX; i++) {
         m_address[i] = "";
@@ -83,6 +95,10 @@ UDPSocket::UDPSocket(uint16_t port) :
         m_af[i] = 0U;
         m_fd[i] = -1;
     }
+
+    for (uint32_t i = 0U; i < UDP_SOCKET_RX_HISTOGRAM_BUCKETS; i++) {
+        m_readBatchHistogram[i] = 0U;
+    }
 }
 
 /// <summary>
@@ -90,7 +106,13 @@ UDPSocket::UDPSocket(uint16_t port) :
 /// </summary>
 UDPSocket::~UDPSocket()
 {
-    /* stub */
+    if (m_rxBatch != nullptr) {
+        for (uint32_t i = 0U; i < UDP_SOCKET_RX_BATCH_SIZE; i++) {
+            delete[] m_rxBatch[i].buffer;
+        }
+
+        delete[] m_rxBatch;
+    }
 }
 
 /// <summary>
@@ -238,6 +260,86 @@ int UDPSocket::read(uint8_t* buffer, uint32_t length, sockaddr_storage& address,
     return len;
 }
 
+/// <summary>
+/// Read a batch of datagrams from the UDP socket.
+/// </summary>
+/// <remarks>The returned datagrams reference receive buffers owned by the socket, and are only
+/// valid until the next batched read.</remarks>
+/// <param name="buffers">Vector filled with the datagrams read.</param>
+/// <returns>Number of datagrams read, or -1 on error.</returns>
+int UDPSocket::read(BufferVector& buffers)
+{
+    buffers.clear();
+
+    // receive buffers are preallocated once and reused by every batched read
+    if (m_rxBatch == nullptr) {
+        m_rxBatch = new UDPDatagram[UDP_SOCKET_RX_BATCH_SIZE];
+        for (uint32_t i = 0U; i < UDP_SOCKET_RX_BATCH_SIZE; i++) {
+            ::memset(&m_rxBatch[i], 0x00U, sizeof(UDPDatagram));
+            m_rxBatch[i].buffer = new uint8_t[UDP_SOCKET_RX_BUFFER_LENGTH];
+        }
+    }
+
+    struct mmsghdr headers[UDP_SOCKET_RX_BATCH_SIZE];
+    struct iovec chunks[UDP_SOCKET_RX_BATCH_SIZE];
+
+    for (int i = 0; i < UDP_SOCKET_MAX; i++) {
+        // round robin
+        int index = (i + m_counter) % UDP_SOCKET_MAX;
+        if (m_fd[index] < 0)
+            continue;
+
+        ::memset(headers, 0x00U, sizeof(headers));
+        for (uint32_t j = 0U; j < UDP_SOCKET_RX_BATCH_SIZE; j++) {
+            chunks[j].iov_base = m_rxBatch[j].buffer;
+            chunks[j].iov_len = UDP_SOCKET_RX_BUFFER_LENGTH;
+
+            headers[j].msg_hdr.msg_name = (void*)&m_rxBatch[j].address;
+            headers[j].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+            headers[j].msg_hdr.msg_iov = &chunks[j];
+            headers[j].msg_hdr.msg_iovlen = 1;
+        }
+
+        // return immediately with whatever datagrams are waiting
+        int ret = recvmmsg(m_fd[index], headers, UDP_SOCKET_RX_BATCH_SIZE, MSG_DONTWAIT, nullptr);
+        if (ret < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                continue;
+
+            LogError(LOG_NET, "Error returned from recvmmsg, err: %d", errno);
+
+            if (errno == ENOTSOCK) {
+                LogMessage(LOG_NET, "Re-opening UDP port on %u", m_port[index]);
+                close();
+                open();
+            }
+
+            return -1;
+        }
+
+        if (ret == 0)
+            continue;
+
+        for (int j = 0; j < ret; j++) {
+            m_rxBatch[j].length = headers[j].msg_len;
+            m_rxBatch[j].addrLen = headers[j].msg_hdr.msg_namelen;
+            buffers.push_back(&m_rxBatch[j]);
+        }
+
+        // bucket the batch size by power of two
+        uint32_t bucket = 0U;
+        for (uint32_t n = (uint32_t)ret; n > 1U && bucket < UDP_SOCKET_RX_HISTOGRAM_BUCKETS - 1U; n >>= 1) {
+            bucket++;
+        }
+        m_readBatchHistogram[bucket]++;
+
+        m_counter++;
+        return ret;
+    }
+
+    return 0;
+}
+
 /// <summary>
 /// Write data to the UDP socket.
 /// </summary>
@@ -259,14 +361,17 @@ bool UDPSocket::write(const uint8_t* buffer, uint32_t length, const sockaddr_sto
             continue;
 
         ssize_t sent = ::sendto(m_fd[i], (char*)buffer, length, 0, (sockaddr*)& address, addrLen);
+        m_sendCalls++;
         if (sent < 0) {
             LogError(LOG_NET, "Error returned from sendto, err: %d", errno);
+            m_sendErrors++;
 
             if (lenWritten != nullptr) {
                 *lenWritten = -1;
             }
         }
         else {
+            m_datagramsSent++;
             if (sent == ssize_t(length))
                 result = true;
 
@@ -282,11 +387,10 @@ bool UDPSocket::write(const uint8_t* buffer, uint32_t length, const sockaddr_sto
 /// <summary>
 /// Write data to the UDP socket.
 /// </summary>
+/// <remarks>A datagram that fails to send is skipped; the rest of the buffers are still sent.</remarks>
 /// <param name="buffers">Vector of buffers to write to socket.</param>
-/// <param name="address">IP address to write data to.</param>
-/// <param name="addrLen"></param>
-/// <param name="lenWritten">Total number of bytes written.</param>
-/// <returns>True if messages were sent, otherwise false.</returns>
+/// <param name="lenWritten">Total number of bytes written, or -1 if nothing was written.</param>
+/// <returns>True if any messages were sent, otherwise false.</returns>
 bool UDPSocket::write(BufferVector& buffers, int* lenWritten)
 {
     bool result = false;
@@ -302,70 +406,83 @@ bool UDPSocket::write(BufferVector& buffers, int* lenWritten)
 
     // LogDebug(LOG_NET, "buffers len = %u", buffers.size());
 
-    if (buffers.size() > UINT16_MAX) {
-        LogError(LOG_NET, "Trying to send too many buffers?");
-        return false;
-    }
-
-    // LogDebug(LOG_NET, "Sending message(s) (to %s:%u) addrLen %u", UDPSocket::address(address).c_str(), UDPSocket::port(address), addrLen);
-
     int sent = 0;
+    bool error = false;
     struct mmsghdr headers[MAX_BUFFER_COUNT];
-    struct iovec chunks[MAX_BUFFER_COUNT];
-
-    // create mmsghdrs from input buffers and send them at once
-    int size = buffers.size();
-    for (size_t i = 0; i < buffers.size(); ++i) {
-        if (buffers.at(i) == nullptr) {
-            --size;
-            continue;
-        }
-
-        chunks[i].iov_len = buffers.at(i)->length;
-        chunks[i].iov_base = buffers.at(i)->buffer;
-        sent += buffers.at(i)->length;
-
-        headers[i].msg_hdr.msg_name = (void*)&buffers.at(i)->address;
-        headers[i].msg_hdr.msg_namelen = buffers.at(i)->addrLen;
-        headers[i].msg_hdr.msg_iov = &chunks[i];
-        headers[i].msg_hdr.msg_iovlen = 1;
-        headers[i].msg_hdr.msg_control = 0;
-        headers[i].msg_hdr.msg_controllen = 0;
-    }
+    struct iovec chunks[MAX_BUFFER_COUNT * 2U];
 
     for (int i = 0; i < UDP_SOCKET_MAX; i++) {
         if (m_fd[i] < 0)
             continue;
 
-        bool skip = false;
-        for (auto& buffer : buffers) {
-            if (m_af[i] != buffer->address.ss_family) {
-                skip = true;
-                break;
+        // create mmsghdrs from the input buffers matching this sockets address family and send
+        // them in as few calls as possible
+        size_t idx = 0U;
+        while (idx < buffers.size()) {
+            uint32_t count = 0U;
+            for (; idx < buffers.size() && count < MAX_BUFFER_COUNT; ++idx) {
+                UDPDatagram* buffer = buffers.at(idx);
+                if (buffer == nullptr || buffer->buffer == nullptr || m_af[i] != buffer->address.ss_family) {
+                    continue;
+                }
+
+                struct iovec* iov = &chunks[count * 2U];
+                iov[0].iov_len = buffer->length;
+                iov[0].iov_base = buffer->buffer;
+
+                size_t iovLen = 1U;
+                if (buffer->payload != nullptr && buffer->payloadLength > 0U) {
+                    iov[1].iov_len = buffer->payloadLength;
+                    iov[1].iov_base = buffer->payload;
+                    iovLen = 2U;
+                }
+
+                ::memset(&headers[count], 0x00U, sizeof(struct mmsghdr));
+                headers[count].msg_hdr.msg_name = (void*)&buffer->address;
+                headers[count].msg_hdr.msg_namelen = buffer->addrLen;
+                headers[count].msg_hdr.msg_iov = iov;
+                headers[count].msg_hdr.msg_iovlen = iovLen;
+                headers[count].msg_hdr.msg_control = 0;
+                headers[count].msg_hdr.msg_controllen = 0;
+                count++;
             }
-        }
-        if (skip)
-            continue;
 
-        if (sendmmsg(m_fd[i], headers, size, 0) < 0) {
-            LogError(LOG_NET, "Error returned from sendmmsg, err: %d", errno);
-            if (lenWritten != nullptr) {
-                *lenWritten = -1;
+            // sendmmsg() may send fewer messages then requested, retry the remainder
+            uint32_t offset = 0U;
+            while (offset < count) {
+                int ret = sendmmsg(m_fd[i], headers + offset, count - offset, 0);
+#if defined(HAVE_SENDMSG) && !defined(HAVE_SENDMMSG)
+                // one sendmsg() per message sent, plus the one that failed (if any)
+                m_sendCalls += ((ret > 0) ? ret : 0) + ((ret < (int)(count - offset)) ? 1 : 0);
+#else
+                m_sendCalls++;
+#endif
+                // the message at the head of the batch failed; skip just that one so a single
+                // unreachable address doesn't stop delivery to the rest of the batch
+                if (ret <= 0) {
+                    LogError(LOG_NET, "Error returned from sendmmsg, err: %d", errno);
+                    m_sendErrors++;
+                    error = true;
+                    offset++;
+                    continue;
+                }
+
+                for (int j = 0; j < ret; j++) {
+                    struct msghdr& hdr = headers[offset + j].msg_hdr;
+                    for (size_t k = 0U; k < hdr.msg_iovlen; k++) {
+                        sent += hdr.msg_iov[k].iov_len;
+                    }
+                }
+
+                m_datagramsSent += ret;
+                offset += ret;
+                result = true;
             }
         }
+    }
 
-        if (sent < 0) {
-            LogError(LOG_NET, "Error returned from sendmmsg, err: %d", errno);
-            if (lenWritten != nullptr) {
-                *lenWritten = -1;
-            }
-        }
-        else {
-            result = true;
-            if (lenWritten != nullptr) {
-                *lenWritten = sent;
-            }
-        }
+    if (lenWritten != nullptr) {
+        *lenWritten = (error && !result) ? -1 : sent;
     }
 
     return result;
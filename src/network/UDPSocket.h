@@ -33,6 +33,7 @@
 
 #include "Defines.h"
 
+#include <atomic>
 #include <string>
 #include <vector>
 
@@ -57,20 +58,40 @@ enum IPMATCHTYPE {
 
 namespace network
 {
-#if defined(HAVE_SENDMSG) && !defined(HAVE_SENDMMSG)
+#if (defined(HAVE_SENDMSG) && !defined(HAVE_SENDMMSG)) || (defined(HAVE_RECVMSG) && !defined(HAVE_RECVMMSG))
     struct mmsghdr {
         struct msghdr msg_hdr;
         unsigned int msg_len;
     };
+#endif
 
+#if defined(HAVE_SENDMSG) && !defined(HAVE_SENDMMSG)
     static inline int sendmmsg(int sockfd, struct mmsghdr* msgvec, unsigned int vlen, int flags)
     {
-        ssize_t n = 0;
-        for (unsigned int i = 0; i < vlen; i++) {
-            ssize_t ret = sendmsg(sockfd, &msgvec[i].msg_hdr, flags);
+        unsigned int n = 0;
+        for (; n < vlen; n++) {
+            ssize_t ret = sendmsg(sockfd, &msgvec[n].msg_hdr, flags);
+            if (ret < 0)
+                break;
+            msgvec[n].msg_len = (unsigned int)ret;
+        }
+
+        if (n == 0)
+            return -1;
+
+        return int(n);
+    }
+#endif
+
+#if defined(HAVE_RECVMSG) && !defined(HAVE_RECVMMSG)
+    static inline int recvmmsg(int sockfd, struct mmsghdr* msgvec, unsigned int vlen, int flags, struct timespec* timeout)
+    {
+        unsigned int n = 0;
+        for (; n < vlen; n++) {
+            ssize_t ret = recvmsg(sockfd, &msgvec[n].msg_hdr, flags);
             if (ret < 0)
                 break;
-            n += ret;
+            msgvec[n].msg_len = (unsigned int)ret;
         }
 
         if (n == 0)
@@ -80,6 +101,14 @@ namespace network
     }
 #endif
 
+    // ---------------------------------------------------------------------------
+    //  Constants
+    // ---------------------------------------------------------------------------
+
+    const uint32_t  UDP_SOCKET_RX_BATCH_SIZE = 32U;
+    const uint32_t  UDP_SOCKET_RX_BUFFER_LENGTH = 8192U;
+    const uint32_t  UDP_SOCKET_RX_HISTOGRAM_BUCKETS = 6U;  // 1, 2-3, 4-7, 8-15, 16-31, 32+ datagrams
+
     // ---------------------------------------------------------------------------
     //  Structure Declaration
     //      This structure represents a container for a network buffer.
@@ -89,6 +118,10 @@ namespace network
         uint8_t* buffer;
         size_t length;
 
+        /* optional data sent (scatter/gather) after buffer in the same datagram */
+        uint8_t* payload;
+        size_t payloadLength;
+
         sockaddr_storage address;
         uint32_t addrLen;
 
@@ -121,6 +154,8 @@ namespace network
 
         /// <summary>Read data from the UDP socket.</summary>
         int read(uint8_t* buffer, uint32_t length, sockaddr_storage& address, uint32_t& addrLen);
+        /// <summary>Read a batch of datagrams from the UDP socket.</summary>
+        int read(BufferVector& buffers);
         /// <summary>Write data to the UDP socket.</summary>
         bool write(const uint8_t* buffer, uint32_t length, const sockaddr_storage& address, uint32_t addrLen, int* lenWritten = nullptr);
         /// <summary>Write data to the UDP socket.</summary>
@@ -133,6 +168,17 @@ namespace network
 
         /// <summary>Flag indicating the UDP socket(s) are open.</summary>
         bool isOpen() const { return m_isOpen; }
+        /// <summary>Gets the descriptor of the given UDP socket, or -1 if it is not open.</summary>
+        int fd(uint32_t index = 0U) const { return (index < UDP_SOCKET_MAX) ? m_fd[index] : -1; }
+
+        /// <summary>Gets the total number of datagrams written to the UDP socket(s).</summary>
+        uint64_t datagramsSent() const { return m_datagramsSent.load(); }
+        /// <summary>Gets the total number of send system calls issued to write datagrams.</summary>
+        uint64_t sendCalls() const { return m_sendCalls.load(); }
+        /// <summary>Gets the total number of datagrams that failed to be written to the UDP socket(s).</summary>
+        uint64_t sendErrors() const { return m_sendErrors.load(); }
+        /// <summary>Gets the number of batched reads that received a number of datagrams within the given histogram bucket.</summary>
+        uint64_t readBatchHistogram(uint32_t bucket) const { return (bucket < UDP_SOCKET_RX_HISTOGRAM_BUCKETS) ? m_readBatchHistogram[bucket].load() : 0U; }
 
         /// <summary>Helper to lookup a hostname and resolve it to an IP address.</summary>
         static int lookup(const std::string& hostName, uint16_t port, sockaddr_storage& address, uint32_t& addrLen);
@@ -161,6 +207,13 @@ namespace network
         int m_fd[UDP_SOCKET_MAX];
 
         uint32_t m_counter;
+
+        std::atomic<uint64_t> m_datagramsSent;
+        std::atomic<uint64_t> m_sendCalls;
+        std::atomic<uint64_t> m_sendErrors;
+
+        UDPDatagram* m_rxBatch;
+        std::atomic<uint64_t> m_readBatchHistogram[UDP_SOCKET_RX_HISTOGRAM_BUCKETS];
     };
 } // namespace network
 
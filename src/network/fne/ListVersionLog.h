@@ -0,0 +1,210 @@
+/**
+* Digital Voice Modem - Host Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software
+*
+*/
+/*
+*   Copyright (C) 2023 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#if !defined(__FNE__LIST_VERSION_LOG_H__)
+#define __FNE__LIST_VERSION_LOG_H__
+
+#include "Defines.h"
+
+#include <deque>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace network
+{
+    namespace fne
+    {
+        // ---------------------------------------------------------------------------
+        //  Constants
+        // ---------------------------------------------------------------------------
+
+        const uint32_t  LIST_VERSION_MAX_CHANGES = 16384U;
+
+        // ---------------------------------------------------------------------------
+        //  Class Declaration
+        //      Implements a versioned list of keyed values. Every update that
+        //      changes the list produces a new version, and the changes that
+        //      made up each of the most recent versions are kept so a holder of
+        //      an older version can be brought up to date with just the changes.
+        // ---------------------------------------------------------------------------
+
+        template <class K, class V>
+        class ListVersionLog {
+        public:
+            /// <summary>List of keyed values, sorted by key.</summary>
+            typedef std::vector<std::pair<K, V>> List;
+
+            /// <summary>Represents the change of a single key between two versions.</summary>
+            class Change {
+            public:
+                K key;
+                bool hadValue;
+                V oldValue;
+                bool hasValue;
+                V newValue;
+            };
+
+            /// <summary>Initializes a new instance of the ListVersionLog class.</summary>
+            ListVersionLog() :
+                m_version(1U),
+                m_list(),
+                m_history()
+            {
+                /* stub */
+            }
+
+            /// <summary>Discards the list and its history and restarts at the given version.</summary>
+            /// <remarks>Version 0 is reserved to mean "no version".</remarks>
+            /// <param name="version">Initial version.</param>
+            void reset(uint32_t version)
+            {
+                m_version = (version != 0U) ? version : 1U;
+                m_list.clear();
+                m_history.clear();
+            }
+
+            /// <summary>Replaces the list, recording the changes as a new version.</summary>
+            /// <param name="list">New list, sorted by key with unique keys.</param>
+            /// <returns>True, if the list changed, otherwise false.</returns>
+            bool update(List list)
+            {
+                std::vector<Change> changes;
+
+                // merge the old and new lists
+                auto oldIt = m_list.begin();
+                auto newIt = list.begin();
+                while (oldIt != m_list.end() || newIt != list.end()) {
+                    if (newIt == list.end() || (oldIt != m_list.end() && oldIt->first < newIt->first)) {
+                        changes.push_back(Change { oldIt->first, true, oldIt->second, false, V() });
+                        ++oldIt;
+                    }
+                    else if (oldIt == m_list.end() || newIt->first < oldIt->first) {
+                        changes.push_back(Change { newIt->first, false, V(), true, newIt->second });
+                        ++newIt;
+                    }
+                    else {
+                        if (!(oldIt->second == newIt->second)) {
+                            changes.push_back(Change { newIt->first, true, oldIt->second, true, newIt->second });
+                        }
+                        ++oldIt;
+                        ++newIt;
+                    }
+                }
+
+                m_list = std::move(list);
+                if (changes.empty()) {
+                    return false;
+                }
+
+                m_version = nextVersion(m_version);
+                for (Change& change : changes) {
+                    m_history.push_back(std::make_pair(m_version, std::move(change)));
+                }
+
+                // drop the oldest versions (whole versions at a time) once the history grows too large
+                while (m_history.size() > LIST_VERSION_MAX_CHANGES) {
+                    uint32_t oldest = m_history.front().first;
+                    while (!m_history.empty() && m_history.front().first == oldest) {
+                        m_history.pop_front();
+                    }
+                }
+
+                return true;
+            }
+
+            /// <summary>Gets the changes needed to bring a holder of the given version up to date.</summary>
+            /// <remarks>Several changes to the same key are collapsed into one; the changes are sorted by key.</remarks>
+            /// <param name="version">Version held.</param>
+            /// <param name="changes">Changes since the given version.</param>
+            /// <returns>True, if the changes are known, otherwise false (a full list is required).</returns>
+            bool changesSince(uint32_t version, std::vector<Change>& changes) const
+            {
+                changes.clear();
+                if (version == 0U) {
+                    return false;
+                }
+
+                if (version == m_version) {
+                    return true;
+                }
+
+                // versions only ever increase by one (wrapping), and every version in the history has at least one change
+                uint32_t next = nextVersion(version);
+                auto it = m_history.begin();
+                while (it != m_history.end() && it->first != next) {
+                    ++it;
+                }
+
+                if (it == m_history.end()) {
+                    return false;
+                }
+
+                std::map<K, Change> collapsed;
+                for (; it != m_history.end(); ++it) {
+                    const Change& change = it->second;
+                    auto existing = collapsed.find(change.key);
+                    if (existing == collapsed.end()) {
+                        collapsed.insert(std::make_pair(change.key, change));
+                    }
+                    else {
+                        existing->second.hasValue = change.hasValue;
+                        existing->second.newValue = change.newValue;
+                    }
+                }
+
+                for (auto& entry : collapsed) {
+                    const Change& change = entry.second;
+                    if (change.hadValue == change.hasValue && (!change.hasValue || change.oldValue == change.newValue)) {
+                        continue;
+                    }
+
+                    changes.push_back(change);
+                }
+
+                return true;
+            }
+
+            /// <summary>Gets the current version.</summary>
+            uint32_t version() const { return m_version; }
+            /// <summary>Gets the current list.</summary>
+            const List& list() const { return m_list; }
+
+        private:
+            uint32_t m_version;
+            List m_list;
+            std::deque<std::pair<uint32_t, Change>> m_history;
+
+            /// <summary>Helper to get the version following the given version.</summary>
+            static uint32_t nextVersion(uint32_t version)
+            {
+                ++version;
+                return (version != 0U) ? version : 1U;
+            }
+        };
+    } // namespace fne
+} // namespace network
+
+#endif // __FNE__LIST_VERSION_LOG_H__
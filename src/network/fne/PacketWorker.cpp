@@ -0,0 +1,182 @@
+/**
+* Digital Voice Modem - Host Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software
+*
+*/
+/*
+*   Copyright (C) 2023 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#include "Defines.h"
+#include "network/FNENetwork.h"
+#include "network/fne/PacketWorker.h"
+#include "Log.h"
+
+using namespace network;
+using namespace network::fne;
+
+#include <cassert>
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Initializes a new instance of the PacketWorker class.
+/// </summary>
+/// <param name="network">Instance of the FNENetwork class.</param>
+/// <param name="index">Index of this worker.</param>
+/// <param name="queueDepth">Maximum number of frames that may be waiting for this worker.</param>
+PacketWorker::PacketWorker(FNENetwork* network, uint32_t index, uint32_t queueDepth) :
+    Thread(),
+    m_network(network),
+    m_index(index),
+    m_maxQueueDepth(queueDepth),
+    m_queue(),
+    m_mutex(),
+    m_cond(),
+    m_running(false),
+    m_started(false),
+    m_framesProcessed(0U),
+    m_framesDropped(0U),
+    m_queueHighWater(0U)
+{
+    assert(network != nullptr);
+    assert(queueDepth > 0U);
+}
+
+/// <summary>
+/// Finalizes a instance of the PacketWorker class.
+/// </summary>
+PacketWorker::~PacketWorker()
+{
+    stop();
+}
+
+/// <summary>
+/// Queues a protocol frame for processing by this worker.
+/// </summary>
+/// <param name="subFunc">Protocol sub-function.</param>
+/// <param name="data">Network data buffer (ownership is transferred to the worker).</param>
+/// <param name="length">Length of data.</param>
+/// <param name="peerId">Peer ID</param>
+/// <param name="pktSeq"></param>
+/// <param name="streamId">Stream ID</param>
+/// <returns>True, if the frame was queued, otherwise false.</returns>
+bool PacketWorker::enqueue(uint8_t subFunc, UInt8Array& data, uint32_t length, uint32_t peerId, uint16_t pktSeq, uint32_t streamId)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_queue.size() >= m_maxQueueDepth) {
+            m_framesDropped++;
+            return false;
+        }
+
+        PacketWorkItem item;
+        item.subFunc = subFunc;
+        item.data = std::move(data);
+        item.length = length;
+        item.peerId = peerId;
+        item.pktSeq = pktSeq;
+        item.streamId = streamId;
+        m_queue.push_back(std::move(item));
+
+        uint32_t depth = (uint32_t)m_queue.size();
+        if (depth > m_queueHighWater.load()) {
+            m_queueHighWater = depth;
+        }
+    }
+
+    m_cond.notify_one();
+    return true;
+}
+
+/// <summary>
+/// Starts the worker thread.
+/// </summary>
+/// <returns>True, if thread started, otherwise false.</returns>
+bool PacketWorker::run()
+{
+    m_running = true;
+    m_started = Thread::run();
+    if (!m_started) {
+        m_running = false;
+    }
+
+    return m_started;
+}
+
+/// <summary>
+/// Worker thread main.
+/// </summary>
+void PacketWorker::entry()
+{
+    LogMessage(LOG_NET, "FNE packet worker %u started", m_index);
+
+    while (true) {
+        PacketWorkItem item;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cond.wait(lock, [this] { return !m_running || !m_queue.empty(); });
+            if (m_queue.empty()) {
+                break; // stopped and drained
+            }
+
+            item = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+
+        // frames are taken strictly in arrival order; as every frame of a stream hashes
+        // to the same worker this preserves per-stream ordering
+        m_network->processFrame(item.subFunc, item.data.get(), item.length, item.peerId, item.pktSeq, item.streamId);
+        m_framesProcessed++;
+    }
+
+    LogMessage(LOG_NET, "FNE packet worker %u stopped", m_index);
+}
+
+/// <summary>
+/// Stops the worker thread.
+/// </summary>
+void PacketWorker::stop()
+{
+    if (!m_started) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running = false;
+    }
+
+    m_cond.notify_all();
+    wait();
+
+    m_started = false;
+}
+
+/// <summary>
+/// Gets the number of frames waiting to be processed.
+/// </summary>
+/// <returns></returns>
+uint32_t PacketWorker::queueDepth()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return (uint32_t)m_queue.size();
+}
@@ -0,0 +1,116 @@
+/**
+* Digital Voice Modem - Host Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software
+*
+*/
+/*
+*   Copyright (C) 2023 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#if !defined(__FNE__PACKET_WORKER_H__)
+#define __FNE__PACKET_WORKER_H__
+
+#include "Defines.h"
+#include "Thread.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+// ---------------------------------------------------------------------------
+//  Class Prototypes
+// ---------------------------------------------------------------------------
+
+namespace network { class HOST_SW_API FNENetwork; }
+
+namespace network
+{
+    namespace fne
+    {
+        // ---------------------------------------------------------------------------
+        //  Constants
+        // ---------------------------------------------------------------------------
+
+        const uint32_t  PACKET_WORKER_QUEUE_DEPTH = 1024U;
+
+        // ---------------------------------------------------------------------------
+        //  Class Declaration
+        //      Implements a worker thread that processes protocol frames for a
+        //      shard of the FNE call streams.
+        // ---------------------------------------------------------------------------
+
+        class HOST_SW_API PacketWorker : public Thread {
+        public:
+            /// <summary>Initializes a new instance of the PacketWorker class.</summary>
+            PacketWorker(FNENetwork* network, uint32_t index, uint32_t queueDepth = PACKET_WORKER_QUEUE_DEPTH);
+            /// <summary>Finalizes a instance of the PacketWorker class.</summary>
+            ~PacketWorker();
+
+            /// <summary>Queues a protocol frame for processing by this worker.</summary>
+            bool enqueue(uint8_t subFunc, UInt8Array& data, uint32_t length, uint32_t peerId, uint16_t pktSeq, uint32_t streamId);
+
+            /// <summary>Starts the worker thread.</summary>
+            virtual bool run();
+            /// <summary>Worker thread main.</summary>
+            virtual void entry();
+            /// <summary>Stops the worker thread.</summary>
+            void stop();
+
+            /// <summary>Gets the number of frames waiting to be processed.</summary>
+            uint32_t queueDepth();
+
+            /// <summary>Gets the index of this worker.</summary>
+            uint32_t index() const { return m_index; }
+            /// <summary>Gets the total number of frames processed by this worker.</summary>
+            uint64_t framesProcessed() const { return m_framesProcessed.load(); }
+            /// <summary>Gets the total number of frames dropped due to a full queue.</summary>
+            uint64_t framesDropped() const { return m_framesDropped.load(); }
+            /// <summary>Gets the highest queue depth seen by this worker.</summary>
+            uint32_t queueHighWater() const { return m_queueHighWater.load(); }
+
+        private:
+            FNENetwork* m_network;
+            uint32_t m_index;
+            uint32_t m_maxQueueDepth;
+
+            class PacketWorkItem {
+            public:
+                uint8_t subFunc;
+                UInt8Array data;
+                uint32_t length;
+                uint32_t peerId;
+                uint16_t pktSeq;
+                uint32_t streamId;
+            };
+            std::deque<PacketWorkItem> m_queue;
+            std::mutex m_mutex;
+            std::condition_variable m_cond;
+
+            bool m_running;
+            bool m_started;
+
+            std::atomic<uint64_t> m_framesProcessed;
+            std::atomic<uint64_t> m_framesDropped;
+            std::atomic<uint32_t> m_queueHighWater;
+        };
+    } // namespace fne
+} // namespace network
+
+#endif // __FNE__PACKET_WORKER_H__
@@ -0,0 +1,316 @@
+/**
+* Digital Voice Modem - Host Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software
+*
+*/
+/*
+*   Copyright (C) 2023 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#if !defined(__FNE__PEER_TABLE_H__)
+#define __FNE__PEER_TABLE_H__
+
+#include "Defines.h"
+
+#include <cassert>
+#include <deque>
+#include <utility>
+#include <vector>
+
+namespace network
+{
+    namespace fne
+    {
+        // ---------------------------------------------------------------------------
+        //  Constants
+        // ---------------------------------------------------------------------------
+
+        const uint32_t  PEER_TABLE_INITIAL_CAPACITY = 64U;
+
+        // ---------------------------------------------------------------------------
+        //  Class Declaration
+        //      Implements a dense table of peer connections. Each peer lives in a
+        //      stable slot (slots are never moved once allocated), peer IDs are
+        //      mapped to slots by a small open-addressing hash, and the live peers
+        //      are kept in a packed array so fan-out is a linear scan.
+        // ---------------------------------------------------------------------------
+
+        template <class T>
+        class PeerTable {
+        public:
+            /// <summary>Entry yielded when iterating the table; first is the peer ID, second the peer.</summary>
+            typedef std::pair<const uint32_t, T&> Entry;
+
+            /// <summary>Iterator over the packed array of live peers.</summary>
+            class iterator {
+            public:
+                /// <summary>Initializes a new instance of the iterator class.</summary>
+                iterator(PeerTable* table, uint32_t index) : m_table(table), m_index(index) { /* stub */ }
+
+                /// <summary></summary>
+                Entry operator*() const
+                {
+                    const LiveEntry& live = m_table->m_live[m_index];
+                    return Entry(live.peerId, m_table->m_slots[live.slot]);
+                }
+                /// <summary></summary>
+                iterator& operator++() { ++m_index; return *this; }
+                /// <summary></summary>
+                bool operator==(const iterator& other) const { return m_index == other.m_index; }
+                /// <summary></summary>
+                bool operator!=(const iterator& other) const { return m_index != other.m_index; }
+
+            private:
+                PeerTable* m_table;
+                uint32_t m_index;
+            };
+
+            /// <summary>Initializes a new instance of the PeerTable class.</summary>
+            PeerTable() :
+                m_slots(),
+                m_slotLive(),
+                m_freeSlots(),
+                m_live(),
+                m_keys(PEER_TABLE_INITIAL_CAPACITY, 0U),
+                m_values(PEER_TABLE_INITIAL_CAPACITY, 0U),
+                m_generation(0U)
+            {
+                /* stub */
+            }
+
+            /// <summary>Gets the peer with the given peer ID.</summary>
+            /// <param name="peerId">Peer ID.</param>
+            /// <returns>Pointer to the peer, or nullptr if the peer ID is not in the table.</returns>
+            T* find(uint32_t peerId)
+            {
+                uint32_t slot = findSlot(peerId);
+                return (slot != INVALID_SLOT) ? &m_slots[slot] : nullptr;
+            }
+            /// <summary>Gets the peer with the given peer ID.</summary>
+            /// <param name="peerId">Peer ID.</param>
+            /// <returns>Pointer to the peer, or nullptr if the peer ID is not in the table.</returns>
+            const T* find(uint32_t peerId) const
+            {
+                uint32_t slot = findSlot(peerId);
+                return (slot != INVALID_SLOT) ? &m_slots[slot] : nullptr;
+            }
+
+            /// <summary>Adds (or replaces) the peer with the given peer ID.</summary>
+            /// <param name="peerId">Peer ID.</param>
+            /// <param name="peer">Peer.</param>
+            /// <returns>Reference to the peer stored in the table.</returns>
+            T& add(uint32_t peerId, const T& peer)
+            {
+                assert(peerId != 0U);
+
+                uint32_t slot = findSlot(peerId);
+                if (slot != INVALID_SLOT) {
+                    m_slots[slot] = peer;
+                    return m_slots[slot];
+                }
+
+                if (!m_freeSlots.empty()) {
+                    slot = m_freeSlots.back();
+                    m_freeSlots.pop_back();
+                    m_slots[slot] = peer;
+                }
+                else {
+                    slot = (uint32_t)m_slots.size();
+                    m_slots.push_back(peer);
+                    m_slotLive.push_back(0U);
+                }
+
+                m_slotLive[slot] = (uint32_t)m_live.size();
+                m_live.push_back(LiveEntry { peerId, slot });
+                m_generation++;
+
+                // keep the hash at most half full so probe sequences stay short
+                if ((m_live.size() * 2U) > m_keys.size()) {
+                    rehash((uint32_t)m_keys.size() * 2U);
+                }
+                else {
+                    insertKey(peerId, slot);
+                }
+
+                return m_slots[slot];
+            }
+
+            /// <summary>Removes the peer with the given peer ID.</summary>
+            /// <param name="peerId">Peer ID.</param>
+            /// <returns>True, if the peer was removed, otherwise false.</returns>
+            bool erase(uint32_t peerId)
+            {
+                if (peerId == 0U) {
+                    return false;
+                }
+
+                uint32_t mask = (uint32_t)m_keys.size() - 1U;
+                uint32_t pos = hash(peerId) & mask;
+                while (m_keys[pos] != peerId) {
+                    if (m_keys[pos] == 0U) {
+                        return false;
+                    }
+                    pos = (pos + 1U) & mask;
+                }
+
+                uint32_t slot = m_values[pos];
+                removeKey(pos);
+
+                // swap the last live entry into the vacated position of the packed array
+                uint32_t livePos = m_slotLive[slot];
+                const LiveEntry& last = m_live.back();
+                m_live[livePos] = last;
+                m_slotLive[last.slot] = livePos;
+                m_live.pop_back();
+
+                m_slots[slot] = T();
+                m_freeSlots.push_back(slot);
+                m_generation++;
+                return true;
+            }
+
+            /// <summary>Removes all peers from the table.</summary>
+            void clear()
+            {
+                m_slots.clear();
+                m_slotLive.clear();
+                m_freeSlots.clear();
+                m_live.clear();
+                m_keys.assign(PEER_TABLE_INITIAL_CAPACITY, 0U);
+                m_values.assign(PEER_TABLE_INITIAL_CAPACITY, 0U);
+                m_generation++;
+            }
+
+            /// <summary>Gets the number of peers in the table.</summary>
+            uint32_t size() const { return (uint32_t)m_live.size(); }
+            /// <summary>Gets whether the table is empty.</summary>
+            bool empty() const { return m_live.empty(); }
+            /// <summary>Gets the number of slots allocated by the table.</summary>
+            uint32_t slots() const { return (uint32_t)m_slots.size(); }
+            /// <summary>Gets the generation of the table; this changes whenever a peer is added or removed.</summary>
+            uint32_t generation() const { return m_generation; }
+
+            /// <summary>Gets the stable slot index of the peer with the given peer ID.</summary>
+            /// <param name="peerId">Peer ID.</param>
+            /// <returns>Slot index, or INVALID_SLOT if the peer ID is not in the table.</returns>
+            uint32_t slotOf(uint32_t peerId) const { return findSlot(peerId); }
+            /// <summary>Gets the peer stored in the given slot.</summary>
+            T& at(uint32_t slot) { assert(slot < m_slots.size()); return m_slots[slot]; }
+
+            /// <summary></summary>
+            iterator begin() { return iterator(this, 0U); }
+            /// <summary></summary>
+            iterator end() { return iterator(this, (uint32_t)m_live.size()); }
+
+            static const uint32_t INVALID_SLOT = 0xFFFFFFFFU;
+
+        private:
+            struct LiveEntry {
+                uint32_t peerId;
+                uint32_t slot;
+            };
+
+            // slots are held in a deque so references stay valid as the table grows
+            std::deque<T> m_slots;
+            std::vector<uint32_t> m_slotLive;
+            std::vector<uint32_t> m_freeSlots;
+
+            std::vector<LiveEntry> m_live;
+
+            // open-addressing (linear probing) map of peer ID to slot; peer ID 0 marks an empty bucket
+            std::vector<uint32_t> m_keys;
+            std::vector<uint32_t> m_values;
+
+            uint32_t m_generation;
+
+            /// <summary>Helper to hash a peer ID.</summary>
+            static uint32_t hash(uint32_t peerId)
+            {
+                uint32_t h = peerId * 0x9E3779B1U;
+                return h ^ (h >> 16);
+            }
+
+            /// <summary>Helper to find the slot of the given peer ID.</summary>
+            uint32_t findSlot(uint32_t peerId) const
+            {
+                if (peerId == 0U) {
+                    return INVALID_SLOT;
+                }
+
+                uint32_t mask = (uint32_t)m_keys.size() - 1U;
+                uint32_t pos = hash(peerId) & mask;
+                while (m_keys[pos] != 0U) {
+                    if (m_keys[pos] == peerId) {
+                        return m_values[pos];
+                    }
+                    pos = (pos + 1U) & mask;
+                }
+
+                return INVALID_SLOT;
+            }
+
+            /// <summary>Helper to insert a peer ID into the hash.</summary>
+            void insertKey(uint32_t peerId, uint32_t slot)
+            {
+                uint32_t mask = (uint32_t)m_keys.size() - 1U;
+                uint32_t pos = hash(peerId) & mask;
+                while (m_keys[pos] != 0U) {
+                    pos = (pos + 1U) & mask;
+                }
+
+                m_keys[pos] = peerId;
+                m_values[pos] = slot;
+            }
+
+            /// <summary>Helper to remove the key at the given bucket, shifting back any displaced keys.</summary>
+            void removeKey(uint32_t pos)
+            {
+                uint32_t mask = (uint32_t)m_keys.size() - 1U;
+                uint32_t next = (pos + 1U) & mask;
+                while (m_keys[next] != 0U) {
+                    uint32_t home = hash(m_keys[next]) & mask;
+
+                    // move the key back if its home bucket does not lie cyclically within (pos, next]
+                    if (((next - home) & mask) >= ((next - pos) & mask)) {
+                        m_keys[pos] = m_keys[next];
+                        m_values[pos] = m_values[next];
+                        pos = next;
+                    }
+
+                    next = (next + 1U) & mask;
+                }
+
+                m_keys[pos] = 0U;
+                m_values[pos] = 0U;
+            }
+
+            /// <summary>Helper to resize the hash and reinsert the live peers.</summary>
+            void rehash(uint32_t capacity)
+            {
+                m_keys.assign(capacity, 0U);
+                m_values.assign(capacity, 0U);
+                for (const LiveEntry& live : m_live) {
+                    insertKey(live.peerId, live.slot);
+                }
+            }
+        };
+    } // namespace fne
+} // namespace network
+
+#endif // __FNE__PEER_TABLE_H__
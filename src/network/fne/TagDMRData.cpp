@@ -55,6 +55,7 @@ TagDMRData::TagDMRData(FNENetwork* network, bool debug) :
     m_parrotFrames(),
     m_parrotFramesReady(false),
     m_status(),
+    m_lock(),
     m_debug(debug)
 {
     assert(network != nullptr);
@@ -119,10 +120,16 @@ bool TagDMRData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
         dmrData.setN(n);
     }
 
+    // precompiled repeat decision for this talkgroup
+    TalkgroupRoutePtr route = m_network->m_tgRouting->find(dstId);
+
     // is the stream valid?
-    if (validate(peerId, dmrData, streamId)) {
+    if (validate(peerId, *route, dmrData, streamId)) {
+        // call status and parrot state are shared between packet workers
+        std::unique_lock<std::mutex> lock(m_lock);
+
         // is this peer ignored?
-        if (!isPeerPermitted(peerId, dmrData, streamId)) {
+        if (!isPeerPermitted(peerId, *route, dmrData, streamId)) {
             return false;
         }
 
@@ -145,11 +152,12 @@ bool TagDMRData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
             }
 
             // is this a parrot talkgroup? if so, clear any remaining frames from the buffer
-            lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(dstId);
-            if (tg.config().parrot()) {
+            if (route->parrot()) {
                 if (m_parrotFrames.size() > 0) {
                     m_parrotFramesReady = true;
+                    lock.unlock();
                     Thread::sleep(m_network->m_parrotDelay);
+                    lock.lock();
                     LogMessage(LOG_NET, "DMR, Parrot Playback will Start, peer = %u, srcId = %u", peerId, srcId);
                 }
             }
@@ -172,8 +180,7 @@ bool TagDMRData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
             }
             else {
                 // is this a parrot talkgroup? if so, clear any remaining frames from the buffer
-                lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(dstId);
-                if (tg.config().parrot()) {
+                if (route->parrot()) {
                     m_parrotFramesReady = false;
                     if (m_parrotFrames.size() > 0) {
                         for (auto& pkt : m_parrotFrames) {
@@ -198,29 +205,31 @@ bool TagDMRData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
         }
 
         // is this a parrot talkgroup?
-        lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(dstId);
-        if (tg.config().parrot()) {
+        if (route->parrot()) {
             uint8_t* copy = new uint8_t[len];
             ::memcpy(copy, data, len);
             m_parrotFrames.push_back(std::make_tuple(copy, len, pktSeq, streamId));
         }
 
-        // repeat traffic to the connected peers
-        for (auto peer : m_network->m_peers) {
-            if (peerId != peer.first) {
-                // is this peer ignored?
-                if (!isPeerPermitted(peer.first, dmrData, streamId)) {
-                    continue;
-                }
+        lock.unlock();
 
-                m_network->writePeer(peer.first, { NET_FUNC_PROTOCOL, NET_PROTOCOL_SUBFUNC_DMR }, data, len, pktSeq, streamId, true);
+        // repeat traffic to the connected peers; the peers permitted on this talkgroup are compiled with its route
+        std::shared_lock<std::shared_timed_mutex> peerLock(m_network->m_peerMutex);
+        const std::vector<uint32_t>& targets = isRouted(dmrData) ? route->permittedPeers() : route->peers();
+        std::vector<uint32_t> peers;
+        peers.reserve(targets.size());
+        for (uint32_t dstPeerId : targets) {
+            if (peerId != dstPeerId) {
+                peers.push_back(dstPeerId);
                 if (m_network->m_debug) {
                     LogDebug(LOG_NET, "DMR, srcPeer = %u, dstPeer = %u, seqNo = %u, srcId = %u, dstId = %u, flco = $%02X, slotNo = %u, len = %u, pktSeq = %u, stream = %u", 
-                        peerId, peer.first, seqNo, srcId, dstId, flco, slotNo, len, pktSeq, streamId);
+                        peerId, dstPeerId, seqNo, srcId, dstId, flco, slotNo, len, pktSeq, streamId);
                 }
             }
         }
 
+        m_network->writePeers(peers, { NET_FUNC_PROTOCOL, NET_PROTOCOL_SUBFUNC_DMR }, data, len, pktSeq, streamId, true);
+
         // repeat traffic to upstream peers
         if (m_network->m_host->m_peerNetworks.size() > 0) {
             for (auto peer : m_network->m_host->m_peerNetworks) {
@@ -228,6 +237,8 @@ bool TagDMRData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
             }
         }
 
+        peerLock.unlock();
+
         m_network->m_frameQueue->flushQueue();
         return true;
     }
@@ -240,6 +251,7 @@ bool TagDMRData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
 /// </summary>
 void TagDMRData::playbackParrot()
 {
+    std::unique_lock<std::mutex> lock(m_lock);
     if (m_parrotFrames.size() == 0) {
         m_parrotFramesReady = false;
         return;
@@ -248,18 +260,24 @@ void TagDMRData::playbackParrot()
     auto& pkt = m_parrotFrames[0];
     if (std::get<0>(pkt) != nullptr) {
         // repeat traffic to the connected peers
-        for (auto peer : m_network->m_peers) {
-            m_network->writePeer(peer.first, { NET_FUNC_PROTOCOL, NET_PROTOCOL_SUBFUNC_DMR }, std::get<0>(pkt), std::get<1>(pkt), std::get<2>(pkt), std::get<3>(pkt), false);
+        std::shared_lock<std::shared_timed_mutex> peerLock(m_network->m_peerMutex);
+        std::vector<uint32_t> peers;
+        for (const auto& peer : m_network->m_peers) {
+            peers.push_back(peer.first);
             if (m_network->m_debug) {
                 LogDebug(LOG_NET, "DMR, parrot, dstPeer = %u, len = %u, pktSeq = %u, streamId = %u", 
                     peer.first, std::get<1>(pkt), std::get<2>(pkt), std::get<3>(pkt));
             }
         }
 
+        m_network->writePeers(peers, { NET_FUNC_PROTOCOL, NET_PROTOCOL_SUBFUNC_DMR }, std::get<0>(pkt), std::get<1>(pkt), std::get<2>(pkt), std::get<3>(pkt));
+
         delete std::get<0>(pkt);
     }
-    Thread::sleep(60);
     m_parrotFrames.pop_front();
+    lock.unlock();
+
+    Thread::sleep(60);
 }
 
 // ---------------------------------------------------------------------------
@@ -270,51 +288,45 @@ void TagDMRData::playbackParrot()
 /// Helper to determine if the peer is permitted for traffic.
 /// </summary>
 /// <param name="peerId">Peer ID</param>
+/// <param name="route">Precompiled route for the destination talkgroup.</param>
 /// <param name="data"></param>
 /// <param name="streamId">Stream ID</param>
 /// <returns></returns>
-bool TagDMRData::isPeerPermitted(uint32_t peerId, dmr::data::Data& data, uint32_t streamId)
+bool TagDMRData::isPeerPermitted(uint32_t peerId, const TalkgroupRoute& route, dmr::data::Data& data, uint32_t streamId)
 {
-    // private calls are always permitted
-    if (data.getDataType() == dmr::FLCO_PRIVATE) {
+    if (!isRouted(data)) {
         return true;
     }
 
-    // is this a group call?
-    if (data.getDataType() == dmr::FLCO_GROUP) {
-        lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(data.getDstId());
-
-        std::vector<uint32_t> inclusion = tg.config().inclusion();
-        std::vector<uint32_t> exclusion = tg.config().exclusion();
+    // peer inclusion lists take priority over exclusion lists
+    return route.isPeerPermitted(peerId);
+}
 
-        // peer inclusion lists take priority over exclusion lists
-        if (inclusion.size() > 0) {
-            auto it = std::find(inclusion.begin(), inclusion.end(), peerId);
-            if (it == inclusion.end()) {
-                return false;
-            }
-        }
-        else {
-            if (exclusion.size() > 0) {
-                auto it = std::find(exclusion.begin(), exclusion.end(), peerId);
-                if (it != exclusion.end()) {
-                    return false;
-                }
-            }
-        }
+/// <summary>
+/// Helper to determine if the talkgroup route decides which peers the traffic is repeated to.
+/// </summary>
+/// <param name="data"></param>
+/// <returns>True, if only the peers permitted by the route receive the traffic, otherwise false.</returns>
+bool TagDMRData::isRouted(dmr::data::Data& data)
+{
+    // private calls are always permitted
+    if (data.getDataType() == dmr::FLCO_PRIVATE) {
+        return false;
     }
 
-    return true;
+    // is this a group call?
+    return data.getDataType() == dmr::FLCO_GROUP;
 }
 
 /// <summary>
 /// Helper to validate the DMR call stream.
 /// </summary>
 /// <param name="peerId">Peer ID</param>
+/// <param name="route">Precompiled route for the destination talkgroup.</param>
 /// <param name="data"></param>
 /// <param name="streamId">Stream ID</param>
 /// <returns></returns>
-bool TagDMRData::validate(uint32_t peerId, dmr::data::Data& data, uint32_t streamId)
+bool TagDMRData::validate(uint32_t peerId, const TalkgroupRoute& route, dmr::data::Data& data, uint32_t streamId)
 {
     // is the source ID a blacklisted ID?
     lookups::RadioId rid = m_network->m_ridLookup->find(data.getSrcId());
@@ -341,14 +353,12 @@ bool TagDMRData::validate(uint32_t peerId, dmr::data::Data& data, uint32_t strea
 
     // is this a group call?
     if (data.getDataType() == dmr::FLCO_GROUP) {
-        lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(data.getDstId());
-
         // check the DMR slot number
-        if (tg.source().tgSlot() != data.getSlotNo()) {
+        if (route.tgSlot() != data.getSlotNo()) {
             return false;
         }
 
-        if (!tg.config().active()) {
+        if (!route.active()) {
             return false;
         }
     }
@@ -31,8 +31,10 @@
 #include "dmr/DMRDefines.h"
 #include "dmr/data/Data.h"
 #include "network/FNENetwork.h"
+#include "network/fne/TalkgroupRoutingTable.h"
 
 #include <deque>
+#include <mutex>
 
 namespace network
 {
@@ -56,7 +58,7 @@ namespace network
             /// <summary>Helper to playback a parrot frame to the network.</summary>
             void playbackParrot();
             /// <summary>Helper to determine if there are stored parrot frames.</summary>
-            bool hasParrotFrames() const { return m_parrotFramesReady && !m_parrotFrames.empty(); }
+            bool hasParrotFrames() const { std::lock_guard<std::mutex> lock(m_lock); return m_parrotFramesReady && !m_parrotFrames.empty(); }
 
         private:
             FNENetwork* m_network;
@@ -74,13 +76,16 @@ namespace network
             };
             typedef std::pair<const uint32_t, RxStatus> StatusMapPair;
             std::unordered_map<uint32_t, RxStatus> m_status;
+            mutable std::mutex m_lock;
 
             bool m_debug;
 
             /// <summary>Helper to determine if the peer is permitted for traffic.</summary>
-            bool isPeerPermitted(uint32_t peerId, dmr::data::Data& data, uint32_t streamId);
+            bool isPeerPermitted(uint32_t peerId, const TalkgroupRoute& route, dmr::data::Data& data, uint32_t streamId);
+            /// <summary>Helper to determine if the talkgroup route decides which peers the traffic is repeated to.</summary>
+            bool isRouted(dmr::data::Data& data);
             /// <summary>Helper to validate the DMR call stream.</summary>
-            bool validate(uint32_t peerId, dmr::data::Data& data, uint32_t streamId);
+            bool validate(uint32_t peerId, const TalkgroupRoute& route, dmr::data::Data& data, uint32_t streamId);
         };
     } // namespace fne
 } // namespace network
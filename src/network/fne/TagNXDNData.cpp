@@ -96,10 +96,16 @@ bool TagNXDNData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerI
     bool group = (data[15U] & 0x40U) == 0x40U ? false : true;
     lc.setGroup(group);
 
+    // precompiled repeat decision for this talkgroup
+    TalkgroupRoutePtr route = m_network->m_tgRouting->find(dstId);
+
     // is the stream valid?
-    if (validate(peerId, lc, messageType, streamId)) {
+    if (validate(peerId, *route, lc, messageType, streamId)) {
+        // call status and parrot state are shared between packet workers
+        std::unique_lock<std::mutex> lock(m_lock);
+
         // is this peer ignored?
-        if (!isPeerPermitted(peerId, lc, messageType, streamId)) {
+        if (!isPeerPermitted(peerId, *route, lc, messageType, streamId)) {
             return false;
         }
 
@@ -117,11 +123,12 @@ bool TagNXDNData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerI
                 }
 
                 // is this a parrot talkgroup? if so, clear any remaining frames from the buffer
-                lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(dstId);
-                if (tg.config().parrot()) {
+                if (route->parrot()) {
                     if (m_parrotFrames.size() > 0) {
                         m_parrotFramesReady = true;
+                        lock.unlock();
                         Thread::sleep(m_network->m_parrotDelay);
+                        lock.lock();
                         LogMessage(LOG_NET, "NXDN, Parrot Playback will Start, peer = %u, srcId = %u", peerId, srcId);
                     }
                 }
@@ -144,8 +151,7 @@ bool TagNXDNData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerI
                 }
                 else {
                     // is this a parrot talkgroup? if so, clear any remaining frames from the buffer
-                    lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(dstId);
-                    if (tg.config().parrot()) {                    
+                    if (route->parrot()) {                    
                         m_parrotFramesReady = false;
                         if (m_parrotFrames.size() > 0) {
                             for (auto& pkt : m_parrotFrames) {
@@ -170,29 +176,31 @@ bool TagNXDNData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerI
         }
 
         // is this a parrot talkgroup?
-        lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(dstId);
-        if (tg.config().parrot()) {
+        if (route->parrot()) {
             uint8_t *copy = new uint8_t[len];
             ::memcpy(copy, data, len);
             m_parrotFrames.push_back(std::make_tuple(copy, len, pktSeq, streamId));
         }
 
-        // repeat traffic to the connected peers
-        for (auto peer : m_network->m_peers) {
-            if (peerId != peer.first) {
-                // is this peer ignored?
-                if (!isPeerPermitted(peer.first, lc, messageType, streamId)) {
-                    continue;
-                }
+        lock.unlock();
 
-                m_network->writePeer(peer.first, { NET_FUNC_PROTOCOL, NET_PROTOCOL_SUBFUNC_NXDN }, data, len, pktSeq, streamId, true);
+        // repeat traffic to the connected peers; the peers permitted on this talkgroup are compiled with its route
+        std::shared_lock<std::shared_timed_mutex> peerLock(m_network->m_peerMutex);
+        const std::vector<uint32_t>& targets = isRouted(lc, messageType) ? route->permittedPeers() : route->peers();
+        std::vector<uint32_t> peers;
+        peers.reserve(targets.size());
+        for (uint32_t dstPeerId : targets) {
+            if (peerId != dstPeerId) {
+                peers.push_back(dstPeerId);
                 if (m_network->m_debug) {
                     LogDebug(LOG_NET, "NXDN, srcPeer = %u, dstPeer = %u, messageType = $%02X, srcId = %u, dstId = %u, len = %u, pktSeq = %u, streamId = %u", 
-                        peerId, peer.first, messageType, srcId, dstId, len, pktSeq, streamId);
+                        peerId, dstPeerId, messageType, srcId, dstId, len, pktSeq, streamId);
                 }
             }
         }
 
+        m_network->writePeers(peers, { NET_FUNC_PROTOCOL, NET_PROTOCOL_SUBFUNC_NXDN }, data, len, pktSeq, streamId, true);
+
         // repeat traffic to upstream peers
         if (m_network->m_host->m_peerNetworks.size() > 0) {
             for (auto peer : m_network->m_host->m_peerNetworks) {
@@ -200,6 +208,8 @@ bool TagNXDNData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerI
             }
         }
 
+        peerLock.unlock();
+
         m_network->m_frameQueue->flushQueue();
         return true;
     }
@@ -212,6 +222,7 @@ bool TagNXDNData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerI
 /// </summary>
 void TagNXDNData::playbackParrot()
 {
+    std::unique_lock<std::mutex> lock(m_lock);
     if (m_parrotFrames.size() == 0) {
         m_parrotFramesReady = false;
         return;
@@ -220,18 +231,24 @@ void TagNXDNData::playbackParrot()
     auto& pkt = m_parrotFrames[0];
     if (std::get<0>(pkt) != nullptr) {
         // repeat traffic to the connected peers
-        for (auto peer : m_network->m_peers) {
-            m_network->writePeer(peer.first, { NET_FUNC_PROTOCOL, NET_PROTOCOL_SUBFUNC_NXDN }, std::get<0>(pkt), std::get<1>(pkt), std::get<2>(pkt), std::get<3>(pkt), false);
+        std::shared_lock<std::shared_timed_mutex> peerLock(m_network->m_peerMutex);
+        std::vector<uint32_t> peers;
+        for (const auto& peer : m_network->m_peers) {
+            peers.push_back(peer.first);
             if (m_network->m_debug) {
                 LogDebug(LOG_NET, "NXDN, parrot, dstPeer = %u, len = %u, pktSeq = %u, streamId = %u", 
                     peer.first, std::get<1>(pkt), std::get<2>(pkt), std::get<3>(pkt));
             }
         }
 
+        m_network->writePeers(peers, { NET_FUNC_PROTOCOL, NET_PROTOCOL_SUBFUNC_NXDN }, std::get<0>(pkt), std::get<1>(pkt), std::get<2>(pkt), std::get<3>(pkt));
+
         delete std::get<0>(pkt);
     }
-    Thread::sleep(60);
     m_parrotFrames.pop_front();
+    lock.unlock();
+
+    Thread::sleep(60);
 }
 
 // ---------------------------------------------------------------------------
@@ -242,53 +259,43 @@ void TagNXDNData::playbackParrot()
 /// Helper to determine if the peer is permitted for traffic.
 /// </summary>
 /// <param name="peerId">Peer ID</param>
+/// <param name="route">Precompiled route for the destination talkgroup.</param>
 /// <param name="lc"></param>
 /// <param name="messageType"></param>
 /// <param name="streamId">Stream ID</param>
 /// <returns></returns>
-bool TagNXDNData::isPeerPermitted(uint32_t peerId, nxdn::lc::RTCH& lc, uint8_t messageType, uint32_t streamId)
+bool TagNXDNData::isPeerPermitted(uint32_t peerId, const TalkgroupRoute& route, nxdn::lc::RTCH& lc, uint8_t messageType, uint32_t streamId)
 {
-    // private calls are always permitted
-    if (!lc.getGroup()) {
+    if (!isRouted(lc, messageType)) {
         return true;
     }
 
-    // is this a group call?
-    if (lc.getGroup()) {
-        lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(lc.getDstId());
-
-        std::vector<uint32_t> inclusion = tg.config().inclusion();
-        std::vector<uint32_t> exclusion = tg.config().exclusion();
-
-        // peer inclusion lists take priority over exclusion lists
-        if (inclusion.size() > 0) {
-            auto it = std::find(inclusion.begin(), inclusion.end(), peerId);
-            if (it == inclusion.end()) {
-                return false;
-            }
-        }
-        else {
-            if (exclusion.size() > 0) {
-                auto it = std::find(exclusion.begin(), exclusion.end(), peerId);
-                if (it != exclusion.end()) {
-                    return false;
-                }
-            }
-        }
-    }
+    // peer inclusion lists take priority over exclusion lists
+    return route.isPeerPermitted(peerId);
+}
 
-    return true;
+/// <summary>
+/// Helper to determine if the talkgroup route decides which peers the traffic is repeated to.
+/// </summary>
+/// <param name="lc"></param>
+/// <param name="messageType"></param>
+/// <returns>True, if only the peers permitted by the route receive the traffic, otherwise false.</returns>
+bool TagNXDNData::isRouted(nxdn::lc::RTCH& lc, uint8_t messageType)
+{
+    // private calls are always permitted; is this a group call?
+    return lc.getGroup();
 }
 
 /// <summary>
 /// Helper to validate the DMR call stream.
 /// </summary>
 /// <param name="peerId">Peer ID</param>
+/// <param name="route">Precompiled route for the destination talkgroup.</param>
 /// <param name="lc"></param>
 /// <param name="messageType"></param>
 /// <param name="streamId">Stream ID</param>
 /// <returns></returns>
-bool TagNXDNData::validate(uint32_t peerId, nxdn::lc::RTCH& lc, uint8_t messageType, uint32_t streamId)
+bool TagNXDNData::validate(uint32_t peerId, const TalkgroupRoute& route, nxdn::lc::RTCH& lc, uint8_t messageType, uint32_t streamId)
 {
     // is the source ID a blacklisted ID?
     lookups::RadioId rid = m_network->m_ridLookup->find(lc.getSrcId());
@@ -315,8 +322,7 @@ bool TagNXDNData::validate(uint32_t peerId, nxdn::lc::RTCH& lc, uint8_t messageT
         return true;
     }
 
-    lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(lc.getDstId());
-    if (!tg.config().active()) {
+    if (!route.active()) {
         return false;
     }
 
@@ -56,6 +56,7 @@ TagP25Data::TagP25Data(FNENetwork* network, bool debug) :
     m_parrotFrames(),
     m_parrotFramesReady(false),
     m_status(),
+    m_lock(),
     m_debug(debug)
 {
     assert(network != nullptr);
@@ -137,10 +138,16 @@ bool TagP25Data::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
     lsd.setLSD1(lsd1);
     lsd.setLSD2(lsd2);
 
+    // precompiled repeat decision for this talkgroup
+    TalkgroupRoutePtr route = m_network->m_tgRouting->find(dstId);
+
     // is the stream valid?
-    if (validate(peerId, control, duid, streamId)) {
+    if (validate(peerId, *route, control, duid, streamId)) {
+        // call status and parrot state are shared between packet workers
+        std::unique_lock<std::mutex> lock(m_lock);
+
         // is this peer ignored?
-        if (!isPeerPermitted(peerId, control, duid, streamId)) {
+        if (!isPeerPermitted(peerId, *route, control, duid, streamId)) {
             return false;
         }
 
@@ -156,11 +163,12 @@ bool TagP25Data::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
                 }
 
                 // is this a parrot talkgroup? if so, clear any remaining frames from the buffer
-                lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(dstId);
-                if (tg.config().parrot()) {
+                if (route->parrot()) {
                     if (m_parrotFrames.size() > 0) {
                         m_parrotFramesReady = true;
+                        lock.unlock();
                         Thread::sleep(m_network->m_parrotDelay);
+                        lock.lock();
                         LogMessage(LOG_NET, "P25, Parrot Playback will Start, peer = %u, srcId = %u", peerId, srcId);
                     }
                 }
@@ -183,8 +191,7 @@ bool TagP25Data::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
                 }
                 else {
                     // is this a parrot talkgroup? if so, clear any remaining frames from the buffer
-                    lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(dstId);
-                    if (tg.config().parrot()) {
+                    if (route->parrot()) {
                         m_parrotFramesReady = false;
                         if (m_parrotFrames.size() > 0) {
                             for (auto& pkt : m_parrotFrames) {
@@ -209,29 +216,31 @@ bool TagP25Data::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
         }
 
         // is this a parrot talkgroup?
-        lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(dstId);
-        if (tg.config().parrot()) {
+        if (route->parrot()) {
             uint8_t *copy = new uint8_t[len];
             ::memcpy(copy, data, len);
             m_parrotFrames.push_back(std::make_tuple(copy, len, pktSeq, streamId));
         }
 
-        // repeat traffic to the connected peers
-        for (auto peer : m_network->m_peers) {
-            if (peerId != peer.first) {
-                // is this peer ignored?
-                if (!isPeerPermitted(peer.first, control, duid, streamId)) {
-                    continue;
-                }
+        lock.unlock();
 
-                m_network->writePeer(peer.first, { NET_FUNC_PROTOCOL, NET_PROTOCOL_SUBFUNC_P25 }, data, len, pktSeq, streamId, true);
+        // repeat traffic to the connected peers; the peers permitted on this talkgroup are compiled with its route
+        std::shared_lock<std::shared_timed_mutex> peerLock(m_network->m_peerMutex);
+        const std::vector<uint32_t>& targets = isRouted(control, duid) ? route->permittedPeers() : route->peers();
+        std::vector<uint32_t> peers;
+        peers.reserve(targets.size());
+        for (uint32_t dstPeerId : targets) {
+            if (peerId != dstPeerId) {
+                peers.push_back(dstPeerId);
                 if (m_network->m_debug) {
                     LogDebug(LOG_NET, "P25, srcPeer = %u, dstPeer = %u, duid = $%02X, lco = $%02X, MFId = $%02X, srcId = %u, dstId = %u, len = %u, pktSeq = %u, streamId = %u", 
-                        peerId, peer.first, duid, lco, MFId, srcId, dstId, len, pktSeq, streamId);
+                        peerId, dstPeerId, duid, lco, MFId, srcId, dstId, len, pktSeq, streamId);
                 }
             }
         }
 
+        m_network->writePeers(peers, { NET_FUNC_PROTOCOL, NET_PROTOCOL_SUBFUNC_P25 }, data, len, pktSeq, streamId, true);
+
         // repeat traffic to upstream peers
         if (m_network->m_host->m_peerNetworks.size() > 0) {
             for (auto peer : m_network->m_host->m_peerNetworks) {
@@ -239,6 +248,8 @@ bool TagP25Data::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
             }
         }
 
+        peerLock.unlock();
+
         m_network->m_frameQueue->flushQueue();
         return true;
     }
@@ -251,6 +262,7 @@ bool TagP25Data::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
 /// </summary>
 void TagP25Data::playbackParrot()
 {
+    std::unique_lock<std::mutex> lock(m_lock);
     if (m_parrotFrames.size() == 0) {
         m_parrotFramesReady = false;
         return;
@@ -259,18 +271,24 @@ void TagP25Data::playbackParrot()
     auto& pkt = m_parrotFrames[0];
     if (std::get<0>(pkt) != nullptr) {
         // repeat traffic to the connected peers
-        for (auto peer : m_network->m_peers) {
-            m_network->writePeer(peer.first, { NET_FUNC_PROTOCOL, NET_PROTOCOL_SUBFUNC_P25 }, std::get<0>(pkt), std::get<1>(pkt), std::get<2>(pkt), std::get<3>(pkt), false);
+        std::shared_lock<std::shared_timed_mutex> peerLock(m_network->m_peerMutex);
+        std::vector<uint32_t> peers;
+        for (const auto& peer : m_network->m_peers) {
+            peers.push_back(peer.first);
             if (m_network->m_debug) {
                 LogDebug(LOG_NET, "P25, parrot, dstPeer = %u, len = %u, pktSeq = %u, streamId = %u", 
                     peer.first, std::get<1>(pkt), std::get<2>(pkt), std::get<3>(pkt));
             }
         }
 
+        m_network->writePeers(peers, { NET_FUNC_PROTOCOL, NET_PROTOCOL_SUBFUNC_P25 }, std::get<0>(pkt), std::get<1>(pkt), std::get<2>(pkt), std::get<3>(pkt));
+
         delete std::get<0>(pkt);
     }
-    Thread::sleep(180);
     m_parrotFrames.pop_front();
+    lock.unlock();
+
+    Thread::sleep(180);
 }
 
 // ---------------------------------------------------------------------------
@@ -281,47 +299,43 @@ void TagP25Data::playbackParrot()
 /// Helper to determine if the peer is permitted for traffic.
 /// </summary>
 /// <param name="peerId">Peer ID</param>
+/// <param name="route">Precompiled route for the destination talkgroup.</param>
 /// <param name="control"></param>
 /// <param name="duid"></param>
 /// <param name="streamId">Stream ID</param>
 /// <returns></returns>
-bool TagP25Data::isPeerPermitted(uint32_t peerId, p25::lc::LC& control, uint8_t duid, uint32_t streamId)
+bool TagP25Data::isPeerPermitted(uint32_t peerId, const TalkgroupRoute& route, p25::lc::LC& control, uint8_t duid, uint32_t streamId)
+{
+    if (!isRouted(control, duid)) {
+        return true;
+    }
+
+    // peer inclusion lists take priority over exclusion lists
+    return route.isPeerPermitted(peerId);
+}
+
+/// <summary>
+/// Helper to determine if the talkgroup route decides which peers the traffic is repeated to.
+/// </summary>
+/// <param name="control"></param>
+/// <param name="duid"></param>
+/// <returns>True, if only the peers permitted by the route receive the traffic, otherwise false.</returns>
+bool TagP25Data::isRouted(p25::lc::LC& control, uint8_t duid)
 {
     // private calls are always permitted
     if (control.getLCO() == p25::LC_PRIVATE) {
-        return true;
+        return false;
     }
 
     // always permit a TSDU or PDU
     if (duid == p25::P25_DUID_TSDU || duid == p25::P25_DUID_PDU)
-        return true;
+        return false;
 
     // always permit a terminator
     if (duid == p25::P25_DUID_TDU || duid == p25::P25_DUID_TDULC)
-        return true;
-
-    // is this a group call?
-    lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(control.getDstId());
-
-    std::vector<uint32_t> inclusion = tg.config().inclusion();
-    std::vector<uint32_t> exclusion = tg.config().exclusion();
-
-    // peer inclusion lists take priority over exclusion lists
-    if (inclusion.size() > 0) {
-        auto it = std::find(inclusion.begin(), inclusion.end(), peerId);
-        if (it == inclusion.end()) {
-            return false;
-        }
-    }
-    else {
-        if (exclusion.size() > 0) {
-            auto it = std::find(exclusion.begin(), exclusion.end(), peerId);
-            if (it != exclusion.end()) {
-                return false;
-            }
-        }
-    }
+        return false;
 
+    // this is a group call
     return true;
 }
 
@@ -329,11 +343,12 @@ bool TagP25Data::isPeerPermitted(uint32_t peerId, p25::lc::LC& control, uint8_t
 /// Helper to validate the DMR call stream.
 /// </summary>
 /// <param name="peerId">Peer ID</param>
+/// <param name="route">Precompiled route for the destination talkgroup.</param>
 /// <param name="control"></param>
 /// <param name="duid"></param>
 /// <param name="streamId">Stream ID</param>
 /// <returns></returns>
-bool TagP25Data::validate(uint32_t peerId, p25::lc::LC& control, uint8_t duid, uint32_t streamId)
+bool TagP25Data::validate(uint32_t peerId, const TalkgroupRoute& route, p25::lc::LC& control, uint8_t duid, uint32_t streamId)
 {
     // is the source ID a blacklisted ID?
     lookups::RadioId rid = m_network->m_ridLookup->find(control.getSrcId());
@@ -364,8 +379,7 @@ bool TagP25Data::validate(uint32_t peerId, p25::lc::LC& control, uint8_t duid, u
         return true;
     }
 
-    lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(control.getDstId());
-    if (!tg.config().active()) {
+    if (!route.active()) {
         return false;
     }
 
@@ -29,6 +29,7 @@
 #include "Defines.h"
 #include "Clock.h"
 #include "network/FNENetwork.h"
+#include "network/fne/TalkgroupRoutingTable.h"
 #include "p25/P25Defines.h"
 #include "p25/data/DataHeader.h"
 #include "p25/data/LowSpeedData.h"
@@ -39,6 +40,7 @@
 #include "p25/lc/TDULC.h"
 
 #include <deque>
+#include <mutex>
 
 namespace network
 {
@@ -62,7 +64,7 @@ namespace network
             /// <summary>Helper to playback a parrot frame to the network.</summary>
             void playbackParrot();
             /// <summary>Helper to determine if there are stored parrot frames.</summary>
-            bool hasParrotFrames() const { return m_parrotFramesReady && !m_parrotFrames.empty(); }
+            bool hasParrotFrames() const { std::lock_guard<std::mutex> lock(m_lock); return m_parrotFramesReady && !m_parrotFrames.empty(); }
 
         private:
             FNENetwork* m_network;
@@ -79,13 +81,16 @@ namespace network
             };
             typedef std::pair<const uint32_t, RxStatus> StatusMapPair;
             std::unordered_map<uint32_t, RxStatus> m_status;
+            mutable std::mutex m_lock;
 
             bool m_debug;
 
             /// <summary>Helper to determine if the peer is permitted for traffic.</summary>
-            bool isPeerPermitted(uint32_t peerId, p25::lc::LC& control, uint8_t duid, uint32_t streamId);
+            bool isPeerPermitted(uint32_t peerId, const TalkgroupRoute& route, p25::lc::LC& control, uint8_t duid, uint32_t streamId);
+            /// <summary>Helper to determine if the talkgroup route decides which peers the traffic is repeated to.</summary>
+            bool isRouted(p25::lc::LC& control, uint8_t duid);
             /// <summary>Helper to validate the P25 call stream.</summary>
-            bool validate(uint32_t peerId, p25::lc::LC& control, uint8_t duid, uint32_t streamId);
+            bool validate(uint32_t peerId, const TalkgroupRoute& route, p25::lc::LC& control, uint8_t duid, uint32_t streamId);
         };
     } // namespace fne
 } // namespace network
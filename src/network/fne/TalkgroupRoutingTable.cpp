@@ -0,0 +1,226 @@
+/**
+* Digital Voice Modem - Host Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software
+*
+*/
+/*
+*   Copyright (C) 2023 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#include "Defines.h"
+#include "network/fne/TalkgroupRoutingTable.h"
+#include "Log.h"
+
+using namespace network::fne;
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Initializes a new instance of the TalkgroupRoute class.
+/// </summary>
+TalkgroupRoute::TalkgroupRoute() :
+    TalkgroupRoute(std::make_shared<const std::vector<uint32_t>>())
+{
+    /* stub */
+}
+
+/// <summary>
+/// Initializes a new instance of the TalkgroupRoute class.
+/// </summary>
+/// <remarks>This is the route of talkgroups without a rule; it is inactive and permits every peer.</remarks>
+/// <param name="peers">Sorted list of the connected peers.</param>
+TalkgroupRoute::TalkgroupRoute(PeerList peers) :
+    m_inclusive(false),
+    m_peers(),
+    m_connected(peers),
+    m_permitted(peers),
+    m_active(false),
+    m_parrot(false),
+    m_tgSlot(0U)
+{
+    assert(peers != nullptr);
+}
+
+/// <summary>
+/// Initializes a new instance of the TalkgroupRoute class.
+/// </summary>
+/// <param name="groupVoice">Talkgroup rule to compile.</param>
+/// <param name="peers">Sorted list of the connected peers.</param>
+TalkgroupRoute::TalkgroupRoute(const lookups::TalkgroupRuleGroupVoice& groupVoice, PeerList peers) :
+    TalkgroupRoute(peers)
+{
+    lookups::TalkgroupRuleConfig config = groupVoice.config();
+    m_active = config.active();
+    m_parrot = config.parrot();
+    m_tgSlot = groupVoice.source().tgSlot();
+
+    // peer inclusion lists take priority over exclusion lists
+    if (config.inclusion().size() > 0U) {
+        m_inclusive = true;
+        m_peers = config.inclusion();
+    }
+    else {
+        m_peers = config.exclusion();
+    }
+
+    std::sort(m_peers.begin(), m_peers.end());
+    m_peers.erase(std::unique(m_peers.begin(), m_peers.end()), m_peers.end());
+
+    // routes without a peer list share the list of connected peers
+    if (!m_peers.empty()) {
+        std::shared_ptr<std::vector<uint32_t>> permitted = std::make_shared<std::vector<uint32_t>>();
+        if (m_inclusive) {
+            std::set_intersection(peers->begin(), peers->end(), m_peers.begin(), m_peers.end(), std::back_inserter(*permitted));
+        }
+        else {
+            std::set_difference(peers->begin(), peers->end(), m_peers.begin(), m_peers.end(), std::back_inserter(*permitted));
+        }
+
+        m_permitted = permitted;
+    }
+}
+
+/// <summary>
+/// Helper to determine if traffic on this talkgroup may be repeated to the given peer.
+/// </summary>
+/// <param name="peerId">Peer ID.</param>
+/// <returns>True, if the peer is permitted, otherwise false.</returns>
+bool TalkgroupRoute::isPeerPermitted(uint32_t peerId) const
+{
+    if (m_peers.empty()) {
+        return true;
+    }
+
+    bool listed = std::binary_search(m_peers.begin(), m_peers.end(), peerId);
+    return m_inclusive ? listed : !listed;
+}
+
+/// <summary>
+/// Initializes a new instance of the TalkgroupRoutingTable class.
+/// </summary>
+/// <param name="rules">Instance of the TalkgroupRulesLookup class.</param>
+TalkgroupRoutingTable::TalkgroupRoutingTable(lookups::TalkgroupRulesLookup* rules) :
+    m_rules(rules),
+    m_cache(),
+    m_peers(std::make_shared<const std::vector<uint32_t>>()),
+    m_mutex(),
+    m_generation(0U),
+    m_rebuilds(0U)
+{
+    assert(rules != nullptr);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    rebuild();
+}
+
+/// <summary>
+/// Finds the route for the given talkgroup.
+/// </summary>
+/// <remarks>Like TalkgroupRulesLookup::find(), a slot of 0 matches the first rule for the talkgroup on any slot.</remarks>
+/// <param name="tgId">Talkgroup ID.</param>
+/// <param name="slot">DMR slot.</param>
+/// <returns>Route for the talkgroup; talkgroups without a rule get an inactive route that permits every peer.</returns>
+TalkgroupRoutePtr TalkgroupRoutingTable::find(uint32_t tgId, uint8_t slot) const
+{
+    std::shared_ptr<const RouteCache> cache = std::atomic_load(&m_cache);
+    auto it = cache->routes.find(key(tgId, slot));
+    if (it != cache->routes.end()) {
+        return it->second;
+    }
+
+    return cache->defaultRoute;
+}
+
+/// <summary>
+/// Recompiles the routing cache if the talkgroup rules have changed.
+/// </summary>
+/// <returns>True, if the routing cache was recompiled, otherwise false.</returns>
+bool TalkgroupRoutingTable::update()
+{
+    if (m_rules->generation() == m_generation.load()) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    rebuild();
+    return true;
+}
+
+/// <summary>
+/// Sets the connected peers and recompiles the routing cache.
+/// </summary>
+/// <param name="peers">Peer IDs of the connected peers.</param>
+/// <returns>True, if the routing cache was recompiled, otherwise false (the peers are unchanged).</returns>
+bool TalkgroupRoutingTable::setPeers(const std::vector<uint32_t>& peers)
+{
+    std::shared_ptr<std::vector<uint32_t>> sorted = std::make_shared<std::vector<uint32_t>>(peers);
+    std::sort(sorted->begin(), sorted->end());
+    sorted->erase(std::unique(sorted->begin(), sorted->end()), sorted->end());
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (*sorted == *m_peers) {
+        return false;
+    }
+
+    m_peers = sorted;
+    rebuild();
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Helper to recompile the routing cache from the talkgroup rules.
+/// </summary>
+/// <remarks>Must be called with the lock held.</remarks>
+void TalkgroupRoutingTable::rebuild()
+{
+    // the generation is read before the rules, so a change racing with this rebuild triggers another one
+    uint32_t generation = m_rules->generation();
+    std::shared_ptr<const std::vector<lookups::TalkgroupRuleGroupVoice>> groupVoice = m_rules->snapshot();
+
+    std::shared_ptr<RouteCache> cache = std::make_shared<RouteCache>();
+    cache->defaultRoute = std::make_shared<const TalkgroupRoute>(m_peers);
+    cache->routes.reserve(groupVoice->size() * 2U);
+    for (const lookups::TalkgroupRuleGroupVoice& entry : *groupVoice) {
+        if (entry.isInvalid()) {
+            continue;
+        }
+
+        uint32_t tgId = entry.source().tgId();
+        uint8_t slot = entry.source().tgSlot();
+
+        // the first rule for a talkgroup wins, matching the lookup table
+        TalkgroupRoutePtr route = std::make_shared<const TalkgroupRoute>(entry, m_peers);
+        cache->routes.emplace(key(tgId, slot), route);
+        cache->routes.emplace(key(tgId, 0U), route);
+    }
+
+    std::atomic_store(&m_cache, std::shared_ptr<const RouteCache>(cache));
+    m_generation = generation;
+    m_rebuilds++;
+}
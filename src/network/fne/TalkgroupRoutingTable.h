@@ -0,0 +1,135 @@
+/**
+* Digital Voice Modem - Host Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software
+*
+*/
+/*
+*   Copyright (C) 2023 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#if !defined(__FNE__TALKGROUP_ROUTING_TABLE_H__)
+#define __FNE__TALKGROUP_ROUTING_TABLE_H__
+
+#include "Defines.h"
+#include "lookups/TalkgroupRulesLookup.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace network
+{
+    namespace fne
+    {
+        // ---------------------------------------------------------------------------
+        //  Class Declaration
+        //      Represents the precompiled repeat decision for a single talkgroup.
+        // ---------------------------------------------------------------------------
+
+        class HOST_SW_API TalkgroupRoute {
+        public:
+            typedef std::shared_ptr<const std::vector<uint32_t>> PeerList;
+
+            /// <summary>Initializes a new instance of the TalkgroupRoute class.</summary>
+            TalkgroupRoute();
+            /// <summary>Initializes a new instance of the TalkgroupRoute class.</summary>
+            TalkgroupRoute(PeerList peers);
+            /// <summary>Initializes a new instance of the TalkgroupRoute class.</summary>
+            TalkgroupRoute(const lookups::TalkgroupRuleGroupVoice& groupVoice, PeerList peers);
+
+            /// <summary>Helper to determine if traffic on this talkgroup may be repeated to the given peer.</summary>
+            bool isPeerPermitted(uint32_t peerId) const;
+
+            /// <summary>Gets the connected peers, when this route was compiled.</summary>
+            const std::vector<uint32_t>& peers() const { return *m_connected; }
+            /// <summary>Gets the connected peers traffic on this talkgroup may be repeated to.</summary>
+            const std::vector<uint32_t>& permittedPeers() const { return *m_permitted; }
+
+        private:
+            bool m_inclusive;
+            std::vector<uint32_t> m_peers;
+
+            PeerList m_connected;
+            PeerList m_permitted;
+
+        public:
+            /// <summary>Flag indicating whether the rule is active.</summary>
+            __READONLY_PROPERTY_PLAIN(bool, active, active);
+            /// <summary>Flag indicating whether or not the talkgroup is a parrot.</summary>
+            __READONLY_PROPERTY_PLAIN(bool, parrot, parrot);
+            /// <summary>Talkgroup DMR slot.</summary>
+            __READONLY_PROPERTY_PLAIN(uint8_t, tgSlot, tgSlot);
+        };
+
+        typedef std::shared_ptr<const TalkgroupRoute> TalkgroupRoutePtr;
+
+        // ---------------------------------------------------------------------------
+        //  Class Declaration
+        //      Implements a routing cache built from the talkgroup rules. The rules
+        //      are compiled into a hash of (TGID, slot) to route, where each route
+        //      holds a sorted peer inclusion or exclusion list and the connected
+        //      peers it permits; the cache is only rebuilt when the rules or the
+        //      connected peers change, never on the frame path.
+        // ---------------------------------------------------------------------------
+
+        class HOST_SW_API TalkgroupRoutingTable {
+        public:
+            /// <summary>Initializes a new instance of the TalkgroupRoutingTable class.</summary>
+            TalkgroupRoutingTable(lookups::TalkgroupRulesLookup* rules);
+
+            /// <summary>Finds the route for the given talkgroup.</summary>
+            TalkgroupRoutePtr find(uint32_t tgId, uint8_t slot = 0U) const;
+
+            /// <summary>Recompiles the routing cache if the talkgroup rules have changed.</summary>
+            bool update();
+            /// <summary>Sets the connected peers and recompiles the routing cache.</summary>
+            bool setPeers(const std::vector<uint32_t>& peers);
+
+            /// <summary>Gets the number of routes in the routing cache.</summary>
+            uint32_t size() const { return (uint32_t)std::atomic_load(&m_cache)->routes.size(); }
+            /// <summary>Gets the number of times the routing cache has been rebuilt.</summary>
+            uint32_t rebuilds() const { return m_rebuilds.load(); }
+
+        private:
+            lookups::TalkgroupRulesLookup* m_rules;
+
+            typedef std::unordered_map<uint64_t, TalkgroupRoutePtr> RouteMap;
+            struct RouteCache {
+                RouteMap routes;
+                TalkgroupRoutePtr defaultRoute;
+            };
+            std::shared_ptr<const RouteCache> m_cache;
+            TalkgroupRoute::PeerList m_peers;
+
+            std::mutex m_mutex;
+            std::atomic<uint32_t> m_generation;
+            std::atomic<uint32_t> m_rebuilds;
+
+            /// <summary>Helper to recompile the routing cache from the talkgroup rules.</summary>
+            void rebuild();
+
+            /// <summary>Helper to generate the routing cache key for a talkgroup.</summary>
+            static uint64_t key(uint32_t tgId, uint8_t slot) { return ((uint64_t)tgId << 8) | slot; }
+        };
+    } // namespace fne
+} // namespace network
+
+#endif // __FNE__TALKGROUP_ROUTING_TABLE_H__
@@ -35,6 +35,8 @@
 #include <string>
 #include <regex>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace network
 {
@@ -45,11 +47,25 @@ namespace network
         //
         // ---------------------------------------------------------------------------
 
-        struct RequestMatch : std::smatch {
+        struct RequestMatch {
             /// <summary>Initializes a new instance of the RequestMatch structure.</summary>
-            RequestMatch(const std::smatch& m, const std::string& c) : std::smatch(m), content(c) { /* stub */ }
+            RequestMatch(const std::smatch& m, const std::string& c) : content(c), m_matches()
+            {
+                for (size_t i = 0; i < m.size(); i++)
+                    m_matches.push_back(m.str(i));
+            }
+            /// <summary>Initializes a new instance of the RequestMatch structure.</summary>
+            RequestMatch(const std::vector<std::string>& m, const std::string& c) : content(c), m_matches(m) { /* stub */ }
+
+            /// <summary>Gets the number of matches (the whole path followed by each path parameter).</summary>
+            size_t size() const { return m_matches.size(); }
+            /// <summary>Gets the given match.</summary>
+            std::string str(size_t n = 0) const { return (n < m_matches.size()) ? m_matches[n] : std::string(); }
 
             std::string content;
+
+        private:
+            std::vector<std::string> m_matches;
         };
 
         // ---------------------------------------------------------------------------
@@ -94,12 +110,11 @@ namespace network
             void setRegEx(bool regEx) { m_isRegEx = regEx; }
 
             /// <summary></summary>
-            void handleRequest(const Request& request, Reply& reply, const std::smatch &what) {
+            void handleRequest(const Request& request, Reply& reply, const RequestMatch& match) {
                 // dispatching to matching based on handler
-                RequestMatch match(what, request.content);
-                auto& handler = m_handlers[request.method];
-                if (handler) {
-                    handler(request, reply, match);
+                auto it = m_handlers.find(request.method);
+                if (it != m_handlers.end() && it->second) {
+                    it->second(request, reply, match);
                 }
             }
 
@@ -119,11 +134,11 @@ namespace network
             typedef RequestMatcher<Request, Reply> MatcherType;
         public:
             /// <summary>Initializes a new instance of the RequestDispatcher class.</summary>
-            RequestDispatcher() : m_basePath(), m_debug(false) { /* stub */ }
+            RequestDispatcher() : m_basePath(), m_debug(false) { reset(); }
             /// <summary>Initializes a new instance of the RequestDispatcher class.</summary>
-            RequestDispatcher(bool debug) : m_basePath(), m_debug(debug) { /* stub */ }
+            RequestDispatcher(bool debug) : m_basePath(), m_debug(debug) { reset(); }
             /// <summary>Initializes a new instance of the RequestDispatcher class.</summary>
-            RequestDispatcher(const std::string& basePath, bool debug) : m_basePath(basePath), m_debug(debug) { /* stub */ }
+            RequestDispatcher(const std::string& basePath, bool debug) : m_basePath(basePath), m_debug(debug) { reset(); }
 
             /// <summary></summary>
             MatcherType& match(const std::string& expression, bool regex = false)
@@ -134,40 +149,64 @@ namespace network
                         ::LogDebug(LOG_REST, "creating RequestDispatcher, expression = %s", expression.c_str());
                     }
                     p = std::make_shared<MatcherType>(expression);
+                    p->setRegEx(regex);
+                    compile();
                 } else {
                     if (m_debug) {
                         ::LogDebug(LOG_REST, "fetching RequestDispatcher, expression = %s", expression.c_str());
                     }
+
+                    if (p->regex() != regex) {
+                        p->setRegEx(regex);
+                        compile();
+                    }
                 }
 
-                p->setRegEx(regex);
                 return *p;
             }
 
             /// <summary></summary>
             void handleRequest(const Request& request, Reply& reply)
             {
-                for (const auto& matcher : m_matchers) {
+                // routes match against the path only
+                std::string path = request.uri;
+                size_t query = path.find('?');
+                if (query != std::string::npos) {
+                    path.erase(query);
+                }
+
+                auto it = m_staticRoutes.find(path);
+                if (it != m_staticRoutes.end()) {
+                    if (m_debug) {
+                        ::LogDebug(LOG_REST, "non-regex endpoint, uri = %s", request.uri.c_str());
+                    }
+
+                    it->second->handleRequest(request, reply, RequestMatch(std::vector<std::string>(1U, path), request.content));
+                    return;
+                }
+
+                std::vector<std::string> segments = splitPath(path);
+                std::vector<std::string> params;
+                params.push_back(path);
+                MatcherTypePtr matcher = findRoute(0U, segments, 0U, params);
+                if (matcher) {
+                    if (m_debug) {
+                        ::LogDebug(LOG_REST, "regex endpoint, uri = %s", request.uri.c_str());
+                    }
+
+                    matcher->handleRequest(request, reply, RequestMatch(params, request.content));
+                    return;
+                }
+
+                for (const auto& route : m_regexRoutes) {
                     std::smatch what;
-                    if (!matcher.second->regex()) {
-                        if (request.uri.find(matcher.first) != std::string::npos) {
-                            if (m_debug) {
-                                ::LogDebug(LOG_REST, "non-regex endpoint, uri = %s, expression = %s", request.uri.c_str(), matcher.first.c_str());
-                            }
-
-                            //what = matcher.first;
-                            matcher.second->handleRequest(request, reply, what);
-                            return;
+                    if (std::regex_match(path, what, route.first)) {
+                        if (m_debug) {
+                            ::LogDebug(LOG_REST, "regex endpoint, uri = %s", request.uri.c_str());
                         }
-                    } else {
-                        if (std::regex_match(request.uri, what, std::regex(matcher.first))) {
-                            if (m_debug) {
-                                ::LogDebug(LOG_REST, "regex endpoint, uri = %s, expression = %s", request.uri.c_str(), matcher.first.c_str());
-                            }
 
-                            matcher.second->handleRequest(request, reply, what);
-                            return;
-                        }
+                        route.second->handleRequest(request, reply, RequestMatch(what, request.content));
+                        return;
                     }
                 }
 
@@ -178,10 +217,163 @@ namespace network
         private:
             typedef std::shared_ptr<MatcherType> MatcherTypePtr;
 
+            /// <summary>
+            /// Node of the path segment trie; children are indexes into the node table.
+            /// </summary>
+            struct RouteNode {
+                /// <summary>Initializes a new instance of the RouteNode structure.</summary>
+                RouteNode() : literals(), numericParam(-1), stringParam(-1), matcher() { /* stub */ }
+
+                std::unordered_map<std::string, int32_t> literals;
+                int32_t numericParam;                       // (\d+)
+                int32_t stringParam;                        // ([^/]+)
+                MatcherTypePtr matcher;
+            };
+
             std::string m_basePath;
             std::map<std::string, MatcherTypePtr> m_matchers;
 
+            std::unordered_map<std::string, MatcherTypePtr> m_staticRoutes;
+            std::vector<RouteNode> m_routeNodes;
+            std::vector<std::pair<std::regex, MatcherTypePtr>> m_regexRoutes;
+
             bool m_debug;
+
+            /// <summary>Helper to clear the compiled routes.</summary>
+            void reset()
+            {
+                m_staticRoutes.clear();
+                m_routeNodes.clear();
+                m_routeNodes.push_back(RouteNode());
+                m_regexRoutes.clear();
+            }
+
+            /// <summary>Helper to split a path into its segments.</summary>
+            static std::vector<std::string> splitPath(const std::string& path)
+            {
+                std::vector<std::string> segments;
+                size_t start = 0U;
+                while (true) {
+                    size_t end = path.find('/', start);
+                    if (end == std::string::npos) {
+                        segments.push_back(path.substr(start));
+                        break;
+                    }
+
+                    segments.push_back(path.substr(start, end - start));
+                    start = end + 1U;
+                }
+
+                return segments;
+            }
+
+            /// <summary>Helper to compile the registered expressions into the route tables.</summary>
+            /// <remarks>Static expressions are matched exactly by hash; regular expressions made of literal,
+            /// (\d+) and ([^/]+) path segments are compiled into a trie, any other regular expression
+            /// is compiled once and tried in order after the trie.</remarks>
+            void compile()
+            {
+                reset();
+                for (const auto& matcher : m_matchers) {
+                    if (!matcher.second->regex()) {
+                        m_staticRoutes[matcher.first] = matcher.second;
+                        continue;
+                    }
+
+                    if (!addTrieRoute(matcher.first, matcher.second)) {
+                        m_regexRoutes.push_back(std::make_pair(std::regex(matcher.first), matcher.second));
+                    }
+                }
+            }
+
+            /// <summary>Helper to add a regular expression to the route trie.</summary>
+            bool addTrieRoute(const std::string& expression, MatcherTypePtr matcher)
+            {
+                std::vector<std::string> segments = splitPath(expression);
+                for (const std::string& segment : segments) {
+                    if (segment != "(\\d+)" && segment != "([^/]+)" &&
+                        segment.find_first_of("\\^$.|?*+()[]{}") != std::string::npos) {
+                        return false;
+                    }
+                }
+
+                int32_t node = 0;
+                for (const std::string& segment : segments) {
+                    int32_t next = -1;
+                    if (segment == "(\\d+)") {
+                        next = m_routeNodes[node].numericParam;
+                    } else if (segment == "([^/]+)") {
+                        next = m_routeNodes[node].stringParam;
+                    } else {
+                        auto it = m_routeNodes[node].literals.find(segment);
+                        if (it != m_routeNodes[node].literals.end()) {
+                            next = it->second;
+                        }
+                    }
+
+                    if (next < 0) {
+                        next = (int32_t)m_routeNodes.size();
+                        m_routeNodes.push_back(RouteNode());
+
+                        if (segment == "(\\d+)") {
+                            m_routeNodes[node].numericParam = next;
+                        } else if (segment == "([^/]+)") {
+                            m_routeNodes[node].stringParam = next;
+                        } else {
+                            m_routeNodes[node].literals[segment] = next;
+                        }
+                    }
+
+                    node = next;
+                }
+
+                if (m_routeNodes[node].matcher) {
+                    return false;                           // duplicate route; leave it to the regex list
+                }
+
+                m_routeNodes[node].matcher = matcher;
+                return true;
+            }
+
+            /// <summary>Helper to walk the route trie, collecting path parameters.</summary>
+            MatcherTypePtr findRoute(int32_t node, const std::vector<std::string>& segments, size_t idx, std::vector<std::string>& params) const
+            {
+                const RouteNode& n = m_routeNodes[node];
+                if (idx == segments.size()) {
+                    return n.matcher;
+                }
+
+                const std::string& segment = segments[idx];
+
+                // literal segments take precedence over parameters
+                auto it = n.literals.find(segment);
+                if (it != n.literals.end()) {
+                    MatcherTypePtr matcher = findRoute(it->second, segments, idx + 1U, params);
+                    if (matcher)
+                        return matcher;
+                }
+
+                if (segment.empty())
+                    return nullptr;
+
+                if (n.numericParam >= 0 && segment.find_first_not_of("0123456789") == std::string::npos) {
+                    params.push_back(segment);
+                    MatcherTypePtr matcher = findRoute(n.numericParam, segments, idx + 1U, params);
+                    if (matcher)
+                        return matcher;
+                    params.pop_back();
+                }
+
+                if (n.stringParam >= 0) {
+                    params.push_back(segment);
+                    MatcherTypePtr matcher = findRoute(n.stringParam, segments, idx + 1U, params);
+                    if (matcher)
+                        return matcher;
+                    params.pop_back();
+                }
+
+                return nullptr;
+            }
         };
 
         // ---------------------------------------------------------------------------
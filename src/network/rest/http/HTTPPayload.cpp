@@ -41,10 +41,12 @@
 
 using namespace network::rest::http;
 
+#include <cstdio>
 #include <string>
 
 namespace status_strings {
     const std::string ok = "HTTP/1.0 200 OK\r\n";
+    const std::string ok_stream = "HTTP/1.1 200 OK\r\n";
     const std::string created = "HTTP/1.0 201 Created\r\n";
     const std::string accepted = "HTTP/1.0 202 Accepted\r\n";
     const std::string no_content = "HTTP/1.0 204 No Content\r\n";
@@ -318,7 +320,11 @@ std::vector<asio::const_buffer> HTTPPayload::toBuffers()
         buffers.push_back(asio::buffer(misc_strings::crlf));
     }
     else {
-        buffers.push_back(status_strings::toBuffer(status));
+        // chunked transfer encoding is only defined for HTTP/1.1
+        if (isStream && status == HTTPPayload::OK)
+            buffers.push_back(asio::buffer(status_strings::ok_stream));
+        else
+            buffers.push_back(status_strings::toBuffer(status));
     }
 
     for (std::size_t i = 0; i < headers.size(); ++i) {
@@ -371,6 +377,23 @@ void HTTPPayload::payload(std::string& c, HTTPPayload::StatusType s, const std::
     ensureDefaultHeaders(contentType);
 }
 
+/// <summary>
+///
+/// </summary>
+/// <param name="c"></param>
+/// <param name="contentType"></param>
+void HTTPPayload::stream(std::string& c, const std::string& contentType)
+{
+    content = chunk(c);
+    status = HTTPPayload::OK;
+    isStream = true;
+
+    headers.add("Content-Type", std::string(contentType));
+    headers.add("Transfer-Encoding", "chunked");
+    headers.add("Server", std::string((__EXE_NAME__ "/" __VER__)));
+    headers.remove("Content-Length");
+}
+
 // ---------------------------------------------------------------------------
 //  Static Members
 // ---------------------------------------------------------------------------
@@ -409,6 +432,17 @@ HTTPPayload HTTPPayload::statusPayload(HTTPPayload::StatusType status, const std
 }
 
 
+/// <summary>
+/// Helper to frame content as a single chunk of a chunked stream.
+/// </summary>
+/// <param name="content"></param>
+std::string HTTPPayload::chunk(const std::string& content)
+{
+    char size[16U];
+    ::snprintf(size, sizeof(size), "%zx\r\n", content.size());
+    return std::string(size) + content + "\r\n";
+}
+
 /// <summary>
 ///
 /// </summary>
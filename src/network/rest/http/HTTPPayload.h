@@ -102,6 +102,7 @@ namespace network
                 int httpVersionMinor;
 
                 bool isClientPayload = false;
+                bool isStream = false;
 
                 /// <summary>Convert the payload into a vector of buffers. The buffers do not own the
                 /// underlying memory blocks, therefore the payload object must remain valid and
@@ -112,11 +113,15 @@ namespace network
                 void payload(json::object& obj, StatusType status = OK);
                 /// <summary>Prepares payload for transmission by finalizing status and content type.</summary>
                 void payload(std::string& content, StatusType status = OK, const std::string& contentType = "text/html");
+                /// <summary>Prepares payload as the start of a chunked stream, with the content as its first chunk.</summary>
+                void stream(std::string& content, const std::string& contentType = "application/json");
 
                 /// <summary>Get a request payload.</summary>
                 static HTTPPayload requestPayload(std::string method, std::string uri);
                 /// <summary>Get a status payload.</summary>
                 static HTTPPayload statusPayload(StatusType status, const std::string& contentType = "text/html");
+                /// <summary>Helper to frame content as a single chunk of a chunked stream.</summary>
+                static std::string chunk(const std::string& content);
 
                 /// <summary></summary>
                 void attachHostHeader(const asio::ip::tcp::endpoint remoteEndpoint);
@@ -44,6 +44,8 @@
 
 #include <asio.hpp>
 
+#include <chrono>
+#include <functional>
 #include <thread>
 #include <string>
 #include <signal.h>
@@ -66,12 +68,16 @@ namespace network
             class HTTPServer {
             public:
                 /// <summary>Initializes a new instance of the HTTPServer class.</summary>
-                explicit HTTPServer(const std::string& address, uint16_t port) :
+                explicit HTTPServer(const std::string& address, uint16_t port, bool persistent = false) :
                     m_ioService(),
                     m_acceptor(m_ioService),
                     m_connectionManager(),
                     m_socket(m_ioService),
-                    m_requestHandler()
+                    m_requestHandler(),
+                    m_timer(m_ioService),
+                    m_timerInterval(0U),
+                    m_timerHandler(),
+                    m_persistent(persistent)
                 {
                     // open the acceptor with the option to reuse the address (i.e. SO_REUSEADDR)
                     asio::ip::address ipAddress = asio::ip::address::from_string(address);
@@ -98,6 +104,26 @@ namespace network
                     m_requestHandler = RequestHandlerType(std::forward<Handler>(handler));
                 }
 
+                /// <summary>Helper to set a handler run periodically on the servers ASIO IO service loop.</summary>
+                void setTimer(uint32_t interval, std::function<void()> handler)
+                {
+                    m_timerInterval = interval;
+                    m_timerHandler = handler;
+                    startTimer();
+                }
+
+                /// <summary>Push content to every connection streaming the given path.</summary>
+                /// <remarks>This may be called from any thread.</remarks>
+                void push(const std::string& path, const std::string& content)
+                {
+                    asio::post(m_ioService, [this, path, content]() {
+                        m_connectionManager.push(path, HTTPPayload::chunk(content));
+                    });
+                }
+
+                /// <summary>Gets the number of connections streaming the given path.</summary>
+                uint32_t streams(const std::string& path) { return m_connectionManager.streams(path); }
+
                 /// <summary>Run the servers ASIO IO service loop.</summary>
                 void run()
                 {
@@ -113,9 +139,15 @@ namespace network
                 {
                     // the server is stopped by cancelling all outstanding asynchronous
                     // operations; once all operations have finished the m_ioService::run()
-                    // call will exit
-                    m_acceptor.close();
-                    m_connectionManager.stopAll();
+                    // call will exit -- the acceptor, connections and timer are owned by the
+                    // IO service loop, so they are cancelled there
+                    asio::post(m_ioService, [this]() {
+                        m_acceptor.close();
+                        m_connectionManager.stopAll();
+
+                        m_timerInterval = 0U;
+                        m_timer.cancel();
+                    });
                 }
 
             private:
@@ -130,13 +162,31 @@ namespace network
                         }
 
                         if (!ec) {
-                            m_connectionManager.start(std::make_shared<ConnectionType>(std::move(m_socket), m_connectionManager, m_requestHandler));
+                            m_connectionManager.start(std::make_shared<ConnectionType>(std::move(m_socket), m_connectionManager, m_requestHandler, m_persistent));
                         }
 
                         accept();
                     });
                 }
 
+                /// <summary>Arm the periodic handler timer.</summary>
+                void startTimer()
+                {
+                    if (m_timerInterval == 0U) {
+                        return;
+                    }
+
+                    m_timer.expires_after(std::chrono::milliseconds(m_timerInterval));
+                    m_timer.async_wait([this](const asio::error_code& ec) {
+                        if (ec || m_timerInterval == 0U) {
+                            return;
+                        }
+
+                        m_timerHandler();
+                        startTimer();
+                    });
+                }
+
                 typedef ConnectionImpl<RequestHandlerType> ConnectionType;
                 typedef std::shared_ptr<ConnectionType> ConnectionTypePtr;
 
@@ -148,6 +198,12 @@ namespace network
                 asio::ip::tcp::socket m_socket;
 
                 RequestHandlerType m_requestHandler;
+
+                asio::steady_timer m_timer;
+                uint32_t m_timerInterval;
+                std::function<void()> m_timerHandler;
+
+                bool m_persistent;
             };
         } // namespace http
     } // namespace rest
@@ -44,6 +44,7 @@
 #include "Utils.h"
 
 #include <array>
+#include <deque>
 #include <memory>
 #include <utility>
 #include <iterator>
@@ -61,6 +62,12 @@ namespace network
 
             template<class> class ServerConnectionManager;
 
+            // ---------------------------------------------------------------------------
+            //  Constants
+            // ---------------------------------------------------------------------------
+
+            const size_t SERVER_STREAM_MAX_QUEUE = 64U;
+
             // ---------------------------------------------------------------------------
             //  Class Declaration
             //      This class represents a single connection from a client.
@@ -103,15 +110,29 @@ namespace network
                     catch(const std::exception&) { /* ignore */ }
                 }
 
+                /// <summary>Queue a chunk for an asynchronous write to a streaming connection.</summary>
+                void push(const std::string& chunk)
+                {
+                    // a client that cannot keep up with the stream is dropped, rather than buffered without bound
+                    if (m_writeQueue.size() >= SERVER_STREAM_MAX_QUEUE) {
+                        ::LogError(LOG_REST, "stream client is not keeping up, closing connection");
+                        m_connectionManager.stop(this->shared_from_this());
+                        return;
+                    }
+
+                    m_writeQueue.push_back(chunk);
+                    if (m_writeQueue.size() == 1U) {
+                        writeStream();
+                    }
+                }
+
             private:
                 /// <summary>Perform an asynchronous read operation.</summary>
                 void read()
                 {
-                    if (!m_persistent) {
-                        auto self(this->shared_from_this());
-                    }
-
-                    m_socket.async_read_some(asio::buffer(m_buffer), [=](asio::error_code ec, std::size_t bytes_transferred) {
+                    // the pending operation keeps the connection alive, even once the manager has dropped it
+                    auto self(this->shared_from_this());
+                    m_socket.async_read_some(asio::buffer(m_buffer), [this, self](asio::error_code ec, std::size_t bytes_transferred) {
                         if (!ec) {
                             HTTPLexer::ResultType result;
                             char* content;
@@ -128,7 +149,12 @@ namespace network
 
                             if (result == HTTPLexer::GOOD) {
                                 m_requestHandler.handleRequest(m_request, m_reply);
-                                write();
+                                if (m_reply.isStream) {
+                                    startStream();
+                                }
+                                else {
+                                    write();
+                                }
                             }
                             else if (result == HTTPLexer::BAD) {
                                 m_reply = HTTPPayload::statusPayload(HTTPPayload::BAD_REQUEST);
@@ -139,7 +165,8 @@ namespace network
                             }
                         }
                         else if (ec != asio::error::operation_aborted) {
-                            if (ec) {
+                            // a persistent client closing its connection is not an error
+                            if (ec && ec != asio::error::eof) {
                                 ::LogError(LOG_REST, "%s, code = %u", ec.message().c_str(), ec.value());
                             }
                             m_connectionManager.stop(this->shared_from_this());
@@ -150,14 +177,13 @@ namespace network
                 /// <summary>Perform an asynchronous write operation.</summary>
                 void write()
                 {
-                    if (!m_persistent) {
-                        auto self(this->shared_from_this());
-                    } else {
+                    auto self(this->shared_from_this());
+                    if (m_persistent) {
                         m_reply.headers.add("Connection", "keep-alive");
                     }
 
                     auto buffers = m_reply.toBuffers();
-                    asio::async_write(m_socket, buffers, [=](asio::error_code ec, std::size_t) {
+                    asio::async_write(m_socket, buffers, [this, self](asio::error_code ec, std::size_t) {
                         if (m_persistent) {
                             m_lexer.reset();
                             m_reply.headers = HTTPHeaders();
@@ -183,6 +209,60 @@ namespace network
                     });
                 }
 
+                /// <summary>Start streaming the reply; the connection then only carries pushed chunks.</summary>
+                void startStream()
+                {
+                    std::string path = m_request.uri.substr(0, m_request.uri.find('?'));
+                    m_connectionManager.subscribe(this->shared_from_this(), path);
+
+                    // the headers and the first chunk go out as a single write
+                    std::string chunk = m_reply.content;
+                    m_reply.content = std::string();
+
+                    std::string header;
+                    for (auto& buffer : m_reply.toBuffers())
+                        header.append((const char*)buffer.data(), buffer.size());
+
+                    m_writeQueue.push_back(header + chunk);
+                    writeStream();
+
+                    readStream();
+                }
+
+                /// <summary>Perform an asynchronous read operation on a streaming connection.</summary>
+                /// <remarks>Nothing further is expected from the client; this only detects it going away.</remarks>
+                void readStream()
+                {
+                    auto self(this->shared_from_this());
+                    m_socket.async_read_some(asio::buffer(m_buffer), [this, self](asio::error_code ec, std::size_t) {
+                        if (!ec) {
+                            readStream();
+                        }
+                        else if (ec != asio::error::operation_aborted) {
+                            m_connectionManager.stop(self);
+                        }
+                    });
+                }
+
+                /// <summary>Perform an asynchronous write of the next queued chunk on a streaming connection.</summary>
+                void writeStream()
+                {
+                    auto self(this->shared_from_this());
+                    asio::async_write(m_socket, asio::buffer(m_writeQueue.front()), [this, self](asio::error_code ec, std::size_t) {
+                        if (ec) {
+                            if (ec != asio::error::operation_aborted) {
+                                m_connectionManager.stop(self);
+                            }
+                            return;
+                        }
+
+                        m_writeQueue.pop_front();
+                        if (!m_writeQueue.empty()) {
+                            writeStream();
+                        }
+                    });
+                }
+
                 asio::ip::tcp::socket m_socket;
 
                 ConnectionManagerType& m_connectionManager;
@@ -194,6 +274,8 @@ namespace network
                 HTTPLexer m_lexer;
                 HTTPPayload m_reply;
 
+                std::deque<std::string> m_writeQueue;
+
                 bool m_persistent;
             };
         } // namespace http
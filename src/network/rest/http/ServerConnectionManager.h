@@ -39,7 +39,10 @@
 
 #include "Defines.h"
 
+#include <map>
 #include <set>
+#include <string>
+#include <vector>
 #include <mutex>
 
 namespace network
@@ -82,6 +85,7 @@ namespace network
                     std::lock_guard<std::mutex> guard(m_lock);
                     {
                         m_connections.erase(c);
+                        m_streams.erase(c);
                     }
                     c->stop();
                 }
@@ -94,10 +98,50 @@ namespace network
 
                     std::lock_guard<std::mutex> guard(m_lock);
                     m_connections.clear();
+                    m_streams.clear();
+                }
+
+                /// <summary>Subscribe the specified connection to the stream for the given path.</summary>
+                void subscribe(ConnectionPtr c, const std::string& path)
+                {
+                    std::lock_guard<std::mutex> guard(m_lock);
+                    m_streams[c] = path;
+                }
+
+                /// <summary>Push a chunk to every connection subscribed to the stream for the given path.</summary>
+                void push(const std::string& path, const std::string& chunk)
+                {
+                    std::vector<ConnectionPtr> streams;
+                    {
+                        std::lock_guard<std::mutex> guard(m_lock);
+                        for (auto& stream : m_streams) {
+                            if (stream.second == path)
+                                streams.push_back(stream.first);
+                        }
+                    }
+
+                    // a connection may stop itself when pushed to, so this is done outside the lock
+                    for (auto c : streams)
+                        c->push(chunk);
+                }
+
+                /// <summary>Gets the number of connections subscribed to the stream for the given path.</summary>
+                uint32_t streams(const std::string& path)
+                {
+                    std::lock_guard<std::mutex> guard(m_lock);
+
+                    uint32_t count = 0U;
+                    for (auto& stream : m_streams) {
+                        if (stream.second == path)
+                            count++;
+                    }
+
+                    return count;
                 }
 
             private:
                 std::set<ConnectionPtr> m_connections;
+                std::map<ConnectionPtr, std::string> m_streams;
                 std::mutex m_lock;
             };
         } // namespace http
@@ -39,7 +39,7 @@
 #include "nxdn/Sync.h"
 #include "nxdn/NXDNUtils.h"
 #include "edac/AMBEFEC.h"
-#include "remote/RESTClient.h"
+#include "remote/RESTClientPool.h"
 #include "HostMain.h"
 #include "Log.h"
 #include "Utils.h"
@@ -308,8 +308,8 @@ void Control::setOptions(yaml::Node& conf, bool supervisor, const std::string cw
                 dstId = 0U; // clear TG value
                 req["dstId"].set<uint32_t>(dstId);
 
-                RESTClient::send(voiceChData.address(), voiceChData.port(), voiceChData.password(),
-                    HTTP_PUT, PUT_PERMIT_TG, req, m_debug);
+                RESTClientPool::send(voiceChData.address(), voiceChData.port(), voiceChData.password(),
+                    HTTP_PUT, PUT_PERMIT_TG, req, nullptr, m_debug);
             }
             else {
                 ::LogError(LOG_NXDN, "NXDN, " NXDN_RTCH_MSG_TYPE_VCALL_RESP ", failed to clear TG permit, chNo = %u", chNo);
@@ -1038,11 +1038,12 @@ void Control::notifyCC_ReleaseGrant(uint32_t dstId)
     req["state"].set<int>(state);
     req["dstId"].set<uint32_t>(dstId);
 
-    int ret = RESTClient::send(m_controlChData.address(), m_controlChData.port(), m_controlChData.password(),
-        HTTP_PUT, PUT_RELEASE_TG, req, m_debug);
-    if (ret != network::rest::http::HTTPPayload::StatusType::OK) {
-        ::LogError(LOG_NXDN, "failed to notify the CC %s:%u of the release of, dstId = %u", m_controlChData.address().c_str(), m_controlChData.port(), dstId);
-    }
+    RESTClientPool::send(m_controlChData.address(), m_controlChData.port(), m_controlChData.password(),
+        HTTP_PUT, PUT_RELEASE_TG, req, [=](int ret, const json::object&) {
+            if (ret != network::rest::http::HTTPPayload::StatusType::OK) {
+                ::LogError(LOG_NXDN, "failed to notify the CC %s:%u of the release of, dstId = %u", m_controlChData.address().c_str(), m_controlChData.port(), dstId);
+            }
+        }, m_debug);
 }
 
 /// <summary>
@@ -1069,11 +1070,12 @@ void Control::notifyCC_TouchGrant(uint32_t dstId)
     req["state"].set<int>(state);
     req["dstId"].set<uint32_t>(dstId);
 
-    int ret = RESTClient::send(m_controlChData.address(), m_controlChData.port(), m_controlChData.password(),
-        HTTP_PUT, PUT_TOUCH_TG, req, m_debug);
-    if (ret != network::rest::http::HTTPPayload::StatusType::OK) {
-        ::LogError(LOG_NXDN, "failed to notify the CC %s:%u of the touch of, dstId = %u", m_controlChData.address().c_str(), m_controlChData.port(), dstId);
-    }
+    RESTClientPool::send(m_controlChData.address(), m_controlChData.port(), m_controlChData.password(),
+        HTTP_PUT, PUT_TOUCH_TG, req, [=](int ret, const json::object&) {
+            if (ret != network::rest::http::HTTPPayload::StatusType::OK) {
+                ::LogError(LOG_NXDN, "failed to notify the CC %s:%u of the touch of, dstId = %u", m_controlChData.address().c_str(), m_controlChData.port(), dstId);
+            }
+        }, m_debug);
 }
 
 /// <summary>
@@ -39,6 +39,10 @@ using namespace nxdn::edac;
 #include <cstring>
 #include <cstdlib>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 // ---------------------------------------------------------------------------
 //  Constants
 // ---------------------------------------------------------------------------
@@ -126,18 +130,51 @@ uint32_t Convolution::chainback(uint8_t* out, uint32_t nBits)
 }
 
 /// <summary>
-///
+/// Runs one step of the Viterbi decoder.
 /// </summary>
-/// <param name="s0"></param>
-/// <param name="s1"></param>
+/// <remarks>
+/// s0 and s1 are soft bits; 0 is a 0, 2 is a 1 and 1 is an erasure (a punctured bit or
+/// a symbol the modem could not decide).
+/// </remarks>
+/// <param name="s0">First soft bit.</param>
+/// <param name="s1">Second soft bit.</param>
+/// <returns>True, if the step was decoded, otherwise false.</returns>
 bool Convolution::decode(uint8_t s0, uint8_t s1)
 {
+    uint16_t metrics[NUM_OF_STATES_D2];
+    for (uint8_t i = 0U; i < NUM_OF_STATES_D2; i++)
+        metrics[i] = std::abs(BRANCH_TABLE1[i] - s0) + std::abs(BRANCH_TABLE2[i] - s1);
+
+    // each butterfly i feeds states 2i and 2i + 1 from states i and i + 8; the
+    // decision bit for a state is set when the path from state i + 8 survives
+#if defined(__SSE2__)
+    __m128i lo = _mm_loadu_si128((const __m128i*)m_oldMetrics);
+    __m128i hi = _mm_loadu_si128((const __m128i*)(m_oldMetrics + NUM_OF_STATES_D2));
+    __m128i metric = _mm_loadu_si128((const __m128i*)metrics);
+    __m128i inverse = _mm_sub_epi16(_mm_set1_epi16(M), metric);
+
+    __m128i m0 = _mm_add_epi16(lo, metric);
+    __m128i m1 = _mm_add_epi16(hi, inverse);
+    __m128i keep0 = _mm_cmplt_epi16(m0, m1);
+    __m128i new0 = _mm_min_epi16(m0, m1);
+
+    m0 = _mm_add_epi16(lo, inverse);
+    m1 = _mm_add_epi16(hi, metric);
+    __m128i keep1 = _mm_cmplt_epi16(m0, m1);
+    __m128i new1 = _mm_min_epi16(m0, m1);
+
+    _mm_storeu_si128((__m128i*)m_newMetrics, _mm_unpacklo_epi16(new0, new1));
+    _mm_storeu_si128((__m128i*)(m_newMetrics + NUM_OF_STATES_D2), _mm_unpackhi_epi16(new0, new1));
+
+    __m128i keep = _mm_packs_epi16(_mm_unpacklo_epi16(keep0, keep1), _mm_unpackhi_epi16(keep0, keep1));
+    *m_dp = (uint64_t)(~_mm_movemask_epi8(keep) & 0xFFFF);
+#else
     *m_dp = 0U;
 
     for (uint8_t i = 0U; i < NUM_OF_STATES_D2; i++) {
         uint8_t j = i * 2U;
 
-        uint16_t metric = std::abs(BRANCH_TABLE1[i] - s0) + std::abs(BRANCH_TABLE2[i] - s1);
+        uint16_t metric = metrics[i];
 
         uint16_t m0 = m_oldMetrics[i] + metric;
         uint16_t m1 = m_oldMetrics[i + NUM_OF_STATES_D2] + (M - metric);
@@ -151,6 +188,7 @@ bool Convolution::decode(uint8_t s0, uint8_t s1)
 
         *m_dp |= (uint64_t(decision1) << (j + 1U)) | (uint64_t(decision0) << (j + 0U));
     }
+#endif
 
     ++m_dp;
 
@@ -37,8 +37,10 @@
 #include "nxdn/NXDNUtils.h"
 #include "edac/CRC.h"
 #include "remote/RESTClient.h"
+#include "remote/RESTClientPool.h"
 #include "HostMain.h"
 #include "Log.h"
+#include "Metrics.h"
 #include "Utils.h"
 
 using namespace nxdn;
@@ -342,6 +344,7 @@ Trunk::Trunk(Control* nxdn, network::BaseNetwork* network, bool debug, bool verb
     m_verifyAff(false),
     m_verifyReg(false),
     m_disableGrantSrcIdCheck(false),
+    m_pendingPermits(),
     m_lastRejectId(0U),
     m_verbose(verbose),
     m_debug(debug)
@@ -487,9 +490,7 @@ void Trunk::writeRF_Message(RCCH* rcch, bool noNetwork, bool clearBeforeWrite, b
 /// <returns></returns>
 bool Trunk::writeRF_Message_Grant(uint32_t srcId, uint32_t dstId, uint8_t serviceOptions, bool grp, bool net, bool skip, uint32_t chNo)
 {
-    bool emergency = ((serviceOptions & 0xFFU) & 0x80U) == 0x80U;           // Emergency Flag
-    bool encryption = ((serviceOptions & 0xFFU) & 0x40U) == 0x40U;          // Encryption Flag
-    uint8_t priority = ((serviceOptions & 0xFFU) & 0x07U);                  // Priority
+    MetricsScopedTimer grantTimer(METRIC_NXDN_GRANT_LATENCY);
 
     std::unique_ptr<rcch::MESSAGE_TYPE_VCALL_CONN> rcch = new_unique(rcch::MESSAGE_TYPE_VCALL_CONN);
 
@@ -594,13 +595,11 @@ bool Trunk::writeRF_Message_Grant(uint32_t srcId, uint32_t dstId, uint8_t servic
         }
     }
 
-    if (grp) {
-        if (!net) {
+    if (!net) {
+        if (grp) {
             ::ActivityLog("NXDN", true, "group grant request from %u to TG %u", srcId, dstId);
         }
-    }
-    else {
-        if (!net) {
+        else {
             ::ActivityLog("NXDN", true, "unit-to-unit grant request from %u to %u", srcId, dstId);
         }
     }
@@ -610,29 +609,89 @@ bool Trunk::writeRF_Message_Grant(uint32_t srcId, uint32_t dstId, uint8_t servic
         ::lookups::VoiceChData voiceChData = m_nxdn->m_affiliations.getRFChData(chNo);
         if (voiceChData.isValidCh() && !voiceChData.address().empty() && voiceChData.port() > 0 &&
             chNo != m_nxdn->m_siteData.channelNo()) {
+            // the radio retried its request while the permit is in flight; the grant goes out once it completes
+            auto pending = m_pendingPermits.find(dstId);
+            if (pending != m_pendingPermits.end() && pending->second == chNo) {
+                return true;
+            }
+
             json::object req = json::object();
             int state = modem::DVM_STATE::STATE_NXDN;
             req["state"].set<int>(state);
             req["dstId"].set<uint32_t>(dstId);
 
-            int ret = RESTClient::send(voiceChData.address(), voiceChData.port(), voiceChData.password(),
-                HTTP_PUT, PUT_PERMIT_TG, req, m_nxdn->m_debug);
-            if (ret != network::rest::http::HTTPPayload::StatusType::OK) {
-                ::LogError((net) ? LOG_NET : LOG_RF, "NXDN, %s, failed to permit TG for use, chNo = %u", rcch->toString().c_str(), chNo);
-                m_nxdn->m_affiliations.releaseGrant(dstId, false);
+            // the grant is held back until the voice channel accepts the permit, without blocking the
+            // RF path on the request; the completion then transmits either the grant or the deny
+            m_pendingPermits[dstId] = chNo;
+            std::string rcchName = rcch->toString();
+            uint64_t permitStart = Metrics::now();
+            RESTClientPool::CompletionCallback permitted = [this, rcchName, srcId, dstId, serviceOptions, grp, net, chNo, permitStart](int ret, const json::object&) {
+                Metrics::observe(METRIC_NXDN_PERMIT_LATENCY, Metrics::now() - permitStart);
+
+                // a later permit for the destination (on another channel) supersedes this one
+                auto pending = m_pendingPermits.find(dstId);
+                if (pending == m_pendingPermits.end() || pending->second != chNo) {
+                    return;
+                }
+                m_pendingPermits.erase(pending);
+
+                bool granted = m_nxdn->m_affiliations.getGrantedCh(dstId) == chNo;
+                if (ret == network::rest::http::HTTPPayload::StatusType::OK && granted) {
+                    writeRF_Message_VCall_Grant(srcId, dstId, serviceOptions, grp, net, chNo);
+                    return;
+                }
+
+                if (!granted) {
+                    ::LogWarning((net) ? LOG_NET : LOG_RF, "NXDN, %s, grant released before the TG was permitted, chNo = %u, dstId = %u", rcchName.c_str(), chNo, dstId);
+                }
+                else {
+                    ::LogError((net) ? LOG_NET : LOG_RF, "NXDN, %s, failed to permit TG for use, chNo = %u", rcchName.c_str(), chNo);
+                    m_nxdn->m_affiliations.releaseGrant(dstId, false);
+                }
+
                 if (!net) {
                     writeRF_Message_Deny(0U, srcId, NXDN_CAUSE_VD_QUE_GRP_BUSY, RTCH_MESSAGE_TYPE_VCALL);
-                    m_nxdn->m_rfState = RS_RF_REJECTED;
+
+                    // don't disturb traffic picked up since the request
+                    if (m_nxdn->m_rfState == RS_RF_LISTENING) {
+                        m_nxdn->m_rfState = RS_RF_REJECTED;
+                    }
                 }
+            };
 
-                return false;
+            if (!RESTClientPool::send(voiceChData.address(), voiceChData.port(), voiceChData.password(),
+                HTTP_PUT, PUT_PERMIT_TG, req, permitted, m_nxdn->m_debug)) {
+                permitted(ERRNO_INTERNAL_ERROR, json::object());
             }
+
+            // without a running client pool the completion has already run
+            return m_nxdn->m_affiliations.isGranted(dstId);
         }
         else {
             ::LogError((net) ? LOG_NET : LOG_RF, "NXDN, %s, failed to permit TG for use, chNo = %u", rcch->toString().c_str(), chNo);
         }
     }
 
+    writeRF_Message_VCall_Grant(srcId, dstId, serviceOptions, grp, net, chNo);
+    return true;
+}
+
+/// <summary>
+/// Helper to write a voice call grant packet for a permitted channel grant.
+/// </summary>
+/// <param name="srcId"></param>
+/// <param name="dstId"></param>
+/// <param name="serviceOptions"></param>
+/// <param name="grp"></param>
+/// <param name="net"></param>
+/// <param name="chNo"></param>
+void Trunk::writeRF_Message_VCall_Grant(uint32_t srcId, uint32_t dstId, uint8_t serviceOptions, bool grp, bool net, uint32_t chNo)
+{
+    bool emergency = ((serviceOptions & 0xFFU) & 0x80U) == 0x80U;           // Emergency Flag
+    bool encryption = ((serviceOptions & 0xFFU) & 0x40U) == 0x40U;          // Encryption Flag
+    uint8_t priority = ((serviceOptions & 0xFFU) & 0x07U);                  // Priority
+
+    std::unique_ptr<rcch::MESSAGE_TYPE_VCALL_CONN> rcch = new_unique(rcch::MESSAGE_TYPE_VCALL_CONN);
     rcch->setMessageType(RTCH_MESSAGE_TYPE_VCALL);
     rcch->setGrpVchNo(chNo);
     rcch->setGroup(grp);
@@ -650,7 +709,6 @@ bool Trunk::writeRF_Message_Grant(uint32_t srcId, uint32_t dstId, uint8_t servic
 
     // transmit group grant
     writeRF_Message_Imm(rcch.get(), net);
-    return true;
 }
 
 /// <summary>
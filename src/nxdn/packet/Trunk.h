@@ -37,6 +37,7 @@
 
 #include <cstdio>
 #include <string>
+#include <unordered_map>
 
 namespace nxdn
 {
@@ -84,6 +85,8 @@ namespace nxdn
 
             bool m_disableGrantSrcIdCheck;
 
+            std::unordered_map<uint32_t, uint32_t> m_pendingPermits;
+
             uint16_t m_lastRejectId;
 
             bool m_verbose;
@@ -107,6 +110,8 @@ namespace nxdn
 
             /// <summary>Helper to write a grant packet.</summary>
             bool writeRF_Message_Grant(uint32_t srcId, uint32_t dstId, uint8_t serviceOptions, bool grp, bool net = false, bool skip = false, uint32_t chNo = 0U);
+            /// <summary>Helper to write a voice call grant packet for a permitted channel grant.</summary>
+            void writeRF_Message_VCall_Grant(uint32_t srcId, uint32_t dstId, uint8_t serviceOptions, bool grp, bool net, uint32_t chNo);
             /// <summary>Helper to write a deny packet.</summary>
             void writeRF_Message_Deny(uint32_t srcId, uint32_t dstId, uint8_t reason, uint8_t service);
             /// <summary>Helper to write a group registration response packet.</summary>
@@ -38,6 +38,18 @@ using namespace p25;
 #include <cstdio>
 #include <cassert>
 
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t LDU_IMBE_FRAMES = 9U;
+
+// IMBE voice frame positions within a LDU
+const uint32_t LDU_IMBE_POSITIONS[LDU_IMBE_FRAMES][2U] = {
+    { 114U, 262U }, { 262U, 410U }, { 452U, 600U }, { 640U, 788U }, { 830U, 978U },
+    { 1020U, 1168U }, { 1208U, 1356U }, { 1398U, 1546U }, { 1578U, 1726U }
+};
+
 // ---------------------------------------------------------------------------
 //  Public Class Members
 // ---------------------------------------------------------------------------
@@ -68,45 +80,17 @@ uint32_t Audio::process(uint8_t* data)
 {
     assert(data != nullptr);
 
-    uint32_t errs = 0U;
-
-    uint8_t imbe[18U];
-
-    P25Utils::decode(data, imbe, 114U, 262U);
-    errs += m_fec.regenerateIMBE(imbe);
-    P25Utils::encode(imbe, data, 114U, 262U);
+    uint8_t imbe[edac::IMBE_FEC_LENGTH_BYTES * LDU_IMBE_FRAMES];
+    for (uint32_t n = 0U; n < LDU_IMBE_FRAMES; n++)
+        P25Utils::decode(data, imbe + (n * edac::IMBE_FEC_LENGTH_BYTES), LDU_IMBE_POSITIONS[n][0U], LDU_IMBE_POSITIONS[n][1U]);
 
-    P25Utils::decode(data, imbe, 262U, 410U);
-    errs += m_fec.regenerateIMBE(imbe);
-    P25Utils::encode(imbe, data, 262U, 410U);
+    uint32_t errs = m_fec.regenerateIMBE(imbe, LDU_IMBE_FRAMES);
 
-    P25Utils::decode(data, imbe, 452U, 600U);
-    errs += m_fec.regenerateIMBE(imbe);
-    P25Utils::encode(imbe, data, 452U, 600U);
-
-    P25Utils::decode(data, imbe, 640U, 788U);
-    errs += m_fec.regenerateIMBE(imbe);
-    P25Utils::encode(imbe, data, 640U, 788U);
-
-    P25Utils::decode(data, imbe, 830U, 978U);
-    errs += m_fec.regenerateIMBE(imbe);
-    P25Utils::encode(imbe, data, 830U, 978U);
-
-    P25Utils::decode(data, imbe, 1020U, 1168U);
-    errs += m_fec.regenerateIMBE(imbe);
-    P25Utils::encode(imbe, data, 1020U, 1168U);
-
-    P25Utils::decode(data, imbe, 1208U, 1356U);
-    errs += m_fec.regenerateIMBE(imbe);
-    P25Utils::encode(imbe, data, 1208U, 1356U);
-
-    P25Utils::decode(data, imbe, 1398U, 1546U);
-    errs += m_fec.regenerateIMBE(imbe);
-    P25Utils::encode(imbe, data, 1398U, 1546U);
-
-    P25Utils::decode(data, imbe, 1578U, 1726U);
-    errs += m_fec.regenerateIMBE(imbe);
-    P25Utils::encode(imbe, data, 1578U, 1726U);
+    // nothing is changed by the FEC when there were no errors
+    if (errs > 0U) {
+        for (uint32_t n = 0U; n < LDU_IMBE_FRAMES; n++)
+            P25Utils::encode(imbe + (n * edac::IMBE_FEC_LENGTH_BYTES), data, LDU_IMBE_POSITIONS[n][0U], LDU_IMBE_POSITIONS[n][1U]);
+    }
 
     return errs;
 }
@@ -35,7 +35,7 @@
 #include "p25/P25Utils.h"
 #include "p25/Sync.h"
 #include "edac/CRC.h"
-#include "remote/RESTClient.h"
+#include "remote/RESTClientPool.h"
 #include "HostMain.h"
 #include "Log.h"
 #include "Utils.h"
@@ -354,8 +354,8 @@ void Control::setOptions(yaml::Node& conf, bool supervisor, const std::string cw
                 dstId = 0U; // clear TG value
                 req["dstId"].set<uint32_t>(dstId);
 
-                RESTClient::send(voiceChData.address(), voiceChData.port(), voiceChData.password(),
-                    HTTP_PUT, PUT_PERMIT_TG, req, m_debug);
+                RESTClientPool::send(voiceChData.address(), voiceChData.port(), voiceChData.password(),
+                    HTTP_PUT, PUT_PERMIT_TG, req, nullptr, m_debug);
             }
             else {
                 ::LogError(LOG_P25, P25_TSDU_STR ", TSBK_IOSP_GRP_VCH (Group Voice Channel Grant), failed to clear TG permit, chNo = %u", chNo);
@@ -1352,11 +1352,12 @@ void Control::notifyCC_ReleaseGrant(uint32_t dstId)
     req["state"].set<int>(state);
     req["dstId"].set<uint32_t>(dstId);
 
-    int ret = RESTClient::send(m_controlChData.address(), m_controlChData.port(), m_controlChData.password(),
-        HTTP_PUT, PUT_RELEASE_TG, req, m_debug);
-    if (ret != network::rest::http::HTTPPayload::StatusType::OK) {
-        ::LogError(LOG_P25, "failed to notify the CC %s:%u of the release of, dstId = %u", m_controlChData.address().c_str(), m_controlChData.port(), dstId);
-    }
+    RESTClientPool::send(m_controlChData.address(), m_controlChData.port(), m_controlChData.password(),
+        HTTP_PUT, PUT_RELEASE_TG, req, [=](int ret, const json::object&) {
+            if (ret != network::rest::http::HTTPPayload::StatusType::OK) {
+                ::LogError(LOG_P25, "failed to notify the CC %s:%u of the release of, dstId = %u", m_controlChData.address().c_str(), m_controlChData.port(), dstId);
+            }
+        }, m_debug);
 }
 
 /// <summary>
@@ -1383,11 +1384,12 @@ void Control::notifyCC_TouchGrant(uint32_t dstId)
     req["state"].set<int>(state);
     req["dstId"].set<uint32_t>(dstId);
 
-    int ret = RESTClient::send(m_controlChData.address(), m_controlChData.port(), m_controlChData.password(),
-        HTTP_PUT, PUT_TOUCH_TG, req, m_debug);
-    if (ret != network::rest::http::HTTPPayload::StatusType::OK) {
-        ::LogError(LOG_P25, "failed to notify the CC %s:%u of the touch of, dstId = %u", m_controlChData.address().c_str(), m_controlChData.port(), dstId);
-    }
+    RESTClientPool::send(m_controlChData.address(), m_controlChData.port(), m_controlChData.password(),
+        HTTP_PUT, PUT_TOUCH_TG, req, [=](int ret, const json::object&) {
+            if (ret != network::rest::http::HTTPPayload::StatusType::OK) {
+                ::LogError(LOG_P25, "failed to notify the CC %s:%u of the touch of, dstId = %u", m_controlChData.address().c_str(), m_controlChData.port(), dstId);
+            }
+        }, m_debug);
 }
 
 /// <summary>
@@ -36,6 +36,98 @@ using namespace p25;
 #include <cstdio>
 #include <cassert>
 
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Reads up to 8 bits (MSB-first) starting at the given bit offset.
+/// </summary>
+/// <param name="in">Input buffer.</param>
+/// <param name="bit">Bit offset to start reading from.</param>
+/// <param name="count">Number of bits to read.</param>
+/// <returns>Bits read, right-aligned.</returns>
+static inline uint32_t readBits(const uint8_t* in, uint32_t bit, uint32_t count)
+{
+    const uint8_t* p = in + (bit >> 3);
+    uint32_t offset = bit & 7U;
+
+    uint32_t word = uint32_t(p[0U]) << 8;
+    if (offset + count > 8U)
+        word |= p[1U];
+
+    return (word >> (16U - offset - count)) & ((1U << count) - 1U);
+}
+
+/// <summary>
+/// Writes up to 8 bits (MSB-first) at the given bit offset, preserving all surrounding bits.
+/// </summary>
+/// <param name="out">Output buffer.</param>
+/// <param name="bit">Bit offset to start writing at.</param>
+/// <param name="count">Number of bits to write.</param>
+/// <param name="value">Bits to write, right-aligned.</param>
+static inline void writeBits(uint8_t* out, uint32_t bit, uint32_t count, uint32_t value)
+{
+    uint8_t* p = out + (bit >> 3);
+    uint32_t shift = 16U - (bit & 7U) - count;
+
+    uint32_t mask = ((1U << count) - 1U) << shift;
+    uint32_t word = value << shift;
+
+    p[0U] = (p[0U] & ~uint8_t(mask >> 8)) | uint8_t((word & mask) >> 8);
+    if ((mask & 0xFFU) != 0U)
+        p[1U] = (p[1U] & ~uint8_t(mask)) | uint8_t(word & mask);
+}
+
+/// <summary>
+/// Copies a run of bits between arbitrary bit offsets. The destination is first brought to a byte
+/// boundary, after which the run is moved a 64-bit word (then a byte) at a time.
+/// </summary>
+/// <param name="in">Input buffer.</param>
+/// <param name="inBit">Bit offset in the input buffer.</param>
+/// <param name="out">Output buffer.</param>
+/// <param name="outBit">Bit offset in the output buffer.</param>
+/// <param name="count">Number of bits to copy.</param>
+static inline void copyBits(const uint8_t* in, uint32_t inBit, uint8_t* out, uint32_t outBit, uint32_t count)
+{
+    uint32_t head = (8U - (outBit & 7U)) & 7U;
+    if (head > count)
+        head = count;
+
+    if (head > 0U) {
+        writeBits(out, outBit, head, readBits(in, inBit, head));
+        inBit += head;
+        outBit += head;
+        count -= head;
+    }
+
+    const uint8_t* src = in + (inBit >> 3);
+    uint8_t* dst = out + (outBit >> 3);
+    uint32_t shift = inBit & 7U;
+
+    // an unaligned source spans one byte more than the bits taken from it; that byte is always
+    // part of the run so no read goes past its end
+    for (; count >= 64U; count -= 64U, src += 8U, dst += 8U) {
+        uint64_t word = 0U;
+        for (uint32_t i = 0U; i < 8U; i++)
+            word = (word << 8) | src[i];
+
+        if (shift > 0U)
+            word = (word << shift) | (src[8U] >> (8U - shift));
+
+        for (uint32_t i = 0U; i < 8U; i++)
+            dst[i] = uint8_t(word >> (56U - (i * 8U)));
+    }
+
+    for (; count >= 8U; count -= 8U, src++, dst++) {
+        dst[0U] = (shift > 0U) ? uint8_t((src[0U] << shift) | (src[1U] >> (8U - shift))) : src[0U];
+    }
+
+    if (count > 0U) {
+        writeBits(dst, 0U, count, readBits(src, shift, count));
+    }
+}
+
 // ---------------------------------------------------------------------------
 //  Static Class Members
 // ---------------------------------------------------------------------------
@@ -66,18 +158,19 @@ void P25Utils::addBusyBits(uint8_t* data, uint32_t length, bool b1, bool b2)
 {
     assert(data != nullptr);
 
-    // insert the "10" (Unknown, use for inbound or outbound) status bits
-    for (uint32_t ss0Pos = P25_SS0_START; ss0Pos < length; ss0Pos += P25_SS_INCREMENT) {
-        uint32_t ss1Pos = ss0Pos + 1U;
-        WRITE_BIT(data, ss0Pos, true);  // 1
-        WRITE_BIT(data, ss1Pos, false); // 0
-    }
+    // every status symbol occupies the two least significant bits of a byte
+    static_assert((P25_SS0_START & 7U) == 6U && (P25_SS_INCREMENT & 7U) == 0U, "status symbols must be byte aligned");
+
+    // interleave the requested status bits (every other), the remainder are
+    // the "10" (Unknown, use for inbound or outbound) status bits
+    const uint8_t busy = (b1 ? 0x02U : 0x00U) | (b2 ? 0x01U : 0x00U);
+    const uint8_t unknown = 0x02U;
 
-    // interleave the requested status bits (every other)
-    for (uint32_t ss0Pos = P25_SS0_START; ss0Pos < length; ss0Pos += (P25_SS_INCREMENT * 2)) {
-        uint32_t ss1Pos = ss0Pos + 1U;
-        WRITE_BIT(data, ss0Pos, b1);
-        WRITE_BIT(data, ss1Pos, b2);
+    bool requested = true;
+    for (uint32_t ss0Pos = P25_SS0_START; ss0Pos < length; ss0Pos += P25_SS_INCREMENT) {
+        uint8_t& b = data[ss0Pos >> 3];
+        b = (b & 0xFCU) | (requested ? busy : unknown);
+        requested = !requested;
     }
 }
 
@@ -96,26 +189,21 @@ uint32_t P25Utils::decode(const uint8_t* in, uint8_t* out, uint32_t start, uint3
 
     // Move the SSx positions to the range needed
     uint32_t ss0Pos = P25_SS0_START;
-    uint32_t ss1Pos = P25_SS1_START;
-
     while (ss0Pos < start) {
         ss0Pos += P25_SS_INCREMENT;
-        ss1Pos += P25_SS_INCREMENT;
     }
 
+    // copy the runs of bits between the status symbols
     uint32_t n = 0U;
-    for (uint32_t i = start; i < stop; i++) {
-        if (i == ss0Pos) {
-            ss0Pos += P25_SS_INCREMENT;
-        }
-        else if (i == ss1Pos) {
-            ss1Pos += P25_SS_INCREMENT;
-        }
-        else {
-            bool b = READ_BIT(in, i);
-            WRITE_BIT(out, n, b);
-            n++;
-        }
+    uint32_t i = start;
+    while (i < stop) {
+        uint32_t runEnd = (ss0Pos < stop) ? ss0Pos : stop;
+        copyBits(in, i, out, n, runEnd - i);
+        n += runEnd - i;
+
+        // skip the 2 bit status symbol
+        i = ss0Pos + 2U;
+        ss0Pos += P25_SS_INCREMENT;
     }
 
     return n;
@@ -136,26 +224,21 @@ uint32_t P25Utils::encode(const uint8_t* in, uint8_t* out, uint32_t start, uint3
 
     // Move the SSx positions to the range needed
     uint32_t ss0Pos = P25_SS0_START;
-    uint32_t ss1Pos = P25_SS1_START;
-
     while (ss0Pos < start) {
         ss0Pos += P25_SS_INCREMENT;
-        ss1Pos += P25_SS_INCREMENT;
     }
 
+    // copy the runs of bits between the status symbols
     uint32_t n = 0U;
-    for (uint32_t i = start; i < stop; i++) {
-        if (i == ss0Pos) {
-            ss0Pos += P25_SS_INCREMENT;
-        }
-        else if (i == ss1Pos) {
-            ss1Pos += P25_SS_INCREMENT;
-        }
-        else {
-            bool b = READ_BIT(in, n);
-            WRITE_BIT(out, i, b);
-            n++;
-        }
+    uint32_t i = start;
+    while (i < stop) {
+        uint32_t runEnd = (ss0Pos < stop) ? ss0Pos : stop;
+        copyBits(in, n, out, i, runEnd - i);
+        n += runEnd - i;
+
+        // skip the 2 bit status symbol
+        i = ss0Pos + 2U;
+        ss0Pos += P25_SS_INCREMENT;
     }
 
     return n;
@@ -173,29 +256,26 @@ uint32_t P25Utils::encode(const uint8_t* in, uint8_t* out, uint32_t length)
     assert(in != nullptr);
     assert(out != nullptr);
 
-    // Move the SSx positions to the range needed
     uint32_t ss0Pos = P25_SS0_START;
-    uint32_t ss1Pos = P25_SS1_START;
 
+    // copy the runs of bits between the status symbols
     uint32_t n = 0U;
     uint32_t pos = 0U;
     while (n < length) {
-        if (pos == ss0Pos) {
-            ss0Pos += P25_SS_INCREMENT;
-
+        uint32_t run = ss0Pos - pos;
+        if (run > length - n) {
+            run = length - n;
         }
-        else if (pos == ss1Pos) {
-            ss1Pos += P25_SS_INCREMENT;
 
-        }
-        else {
-            bool b = READ_BIT(in, n);
-            WRITE_BIT(out, pos, b);
-            n++;
+        copyBits(in, n, out, pos, run);
+        n += run;
+        pos += run;
 
+        // skip the 2 bit status symbol
+        if (n < length) {
+            pos = ss0Pos + 2U;
+            ss0Pos += P25_SS_INCREMENT;
         }
-        pos++;
-
     }
 
     return pos;
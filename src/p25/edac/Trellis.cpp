@@ -25,7 +25,9 @@
 */
 #include "Defines.h"
 #include "p25/edac/Trellis.h"
+#include "edac/Viterbi.h"
 #include "Log.h"
+#include "Metrics.h"
 
 using namespace p25::edac;
 
@@ -58,6 +60,9 @@ const uint8_t ENCODE_TABLE_12[] = {
     13U,  2U,  1U, 14U,
     9U,   6U,  5U, 10U };
 
+// decoded paths which disagree with more received points than this are rejected
+const uint32_t MAX_POINT_ERRORS = 12U;
+
 // ---------------------------------------------------------------------------
 //  Public Class Members
 // ---------------------------------------------------------------------------
@@ -103,19 +108,34 @@ bool Trellis::decode34(const uint8_t* data, uint8_t* payload)
         return true;
     }
 
-    uint8_t savePoints[49U];
-    for (uint32_t i = 0U; i < 49U; i++)
-        savePoints[i] = points[i];
+    // Find the most likely path using the hard decisions
+    int8_t symbols[98U];
+    for (uint32_t i = 0U; i < 98U; i++)
+        symbols[i] = dibits[i] * ::edac::VITERBI_SYMBOL_SCALE;
 
-    bool ret = fixCode34(points, failPos, payload);
-    if (ret)
-        return true;
+    return decodeSymbols34(symbols, payload);
+}
 
-    if (failPos == 0U)
-        return false;
+/// <summary>
+/// Decodes 3/4 rate Trellis from soft symbols.
+/// </summary>
+/// <remarks>
+/// Symbols are in the order they were received, and are the received 4FSK symbol
+/// levels scaled by edac::VITERBI_SYMBOL_SCALE (i.e. +3 is +96, -1 is -32).
+/// </remarks>
+/// <param name="symbols">98 soft symbols.</param>
+/// <param name="payload">Output bytes.</param>
+/// <returns>True, if decoded, otherwise false.</returns>
+bool Trellis::decodeSoft34(const int8_t* symbols, uint8_t* payload)
+{
+    assert(symbols != nullptr);
+    assert(payload != nullptr);
+
+    int8_t deinterleaved[98U];
+    for (uint32_t i = 0U; i < 98U; i++)
+        deinterleaved[INTERLEAVE_TABLE[i]] = symbols[i];
 
-    // Backtrack one place for a last go
-    return fixCode34(savePoints, failPos - 1U, payload);
+    return decodeSymbols34(deinterleaved, payload);
 }
 
 /// <summary>
@@ -173,19 +193,34 @@ bool Trellis::decode12(const uint8_t* data, uint8_t* payload)
         return true;
     }
 
-    uint8_t savePoints[49U];
-    for (uint32_t i = 0U; i < 49U; i++)
-        savePoints[i] = points[i];
+    // Find the most likely path using the hard decisions
+    int8_t symbols[98U];
+    for (uint32_t i = 0U; i < 98U; i++)
+        symbols[i] = dibits[i] * ::edac::VITERBI_SYMBOL_SCALE;
 
-    bool ret = fixCode12(points, failPos, payload);
-    if (ret)
-        return true;
+    return decodeSymbols12(symbols, payload);
+}
 
-    if (failPos == 0U)
-        return false;
+/// <summary>
+/// Decodes 1/2 rate Trellis from soft symbols.
+/// </summary>
+/// <remarks>
+/// Symbols are in the order they were received, and are the received 4FSK symbol
+/// levels scaled by edac::VITERBI_SYMBOL_SCALE (i.e. +3 is +96, -1 is -32).
+/// </remarks>
+/// <param name="symbols">98 soft symbols.</param>
+/// <param name="payload">Output bytes.</param>
+/// <returns>True, if decoded, otherwise false.</returns>
+bool Trellis::decodeSoft12(const int8_t* symbols, uint8_t* payload)
+{
+    assert(symbols != nullptr);
+    assert(payload != nullptr);
+
+    int8_t deinterleaved[98U];
+    for (uint32_t i = 0U; i < 98U; i++)
+        deinterleaved[INTERLEAVE_TABLE[i]] = symbols[i];
 
-    // Backtrack one place for a last go
-    return fixCode12(savePoints, failPos - 1U, payload);
+    return decodeSymbols12(deinterleaved, payload);
 }
 
 /// <summary>
@@ -506,45 +541,28 @@ void Trellis::dibitsToBits(const uint8_t* dibits, uint8_t* payload) const
 }
 
 /// <summary>
-/// Helper to fix errors in Trellis coding.
+/// Helper to decode deinterleaved 3/4 rate soft symbols.
 /// </summary>
-/// <param name="points">4FSK constellation points.</param>
-/// <param name="failPos"></param>
+/// <param name="symbols">Deinterleaved soft symbols.</param>
 /// <param name="payload">Byte payload.</param>
-/// <returns>True, if error corrected, otherwise false.</returns>
-bool Trellis::fixCode34(uint8_t* points, uint32_t failPos, uint8_t* payload) const
+/// <returns>True, if decoded, otherwise false.</returns>
+bool Trellis::decodeSymbols34(const int8_t* symbols, uint8_t* payload) const
 {
+    uint8_t tribits[49U];
+    uint32_t errors = ::edac::Viterbi::decodeTrellis34(symbols, tribits);
 #if DEBUG_TRELLIS
-    ::LogDebug(LOG_HOST, "Trellis::fixCode34() failPos = %u, val = %01X", failPos, points[failPos]);
-#endif
-    for (unsigned j = 0U; j < 20U; j++) {
-        uint32_t bestPos = 0U;
-        uint32_t bestVal = 0U;
-
-        for (uint32_t i = 0U; i < 16U; i++) {
-            points[failPos] = i;
-
-            uint8_t tribits[49U];
-            uint32_t pos = checkCode34(points, tribits);
-            if (pos == 999U) {
-#if DEBUG_TRELLIS
-                ::LogDebug(LOG_HOST, "Trellis::fixCode34() fixed, failPos = %u, pos = %u, val = %01X", failPos, bestPos, bestVal);
+    ::LogDebug(LOG_HOST, "Trellis::decodeSymbols34() errors = %u", errors);
 #endif
-                tribitsToBits(tribits, payload);
-                return true;
-            }
-
-            if (pos > bestPos) {
-                bestPos = pos;
-                bestVal = i;
-            }
-        }
-
-        points[failPos] = bestVal;
-        failPos = bestPos;
+    if (errors > MAX_POINT_ERRORS) {
+        Metrics::add(METRIC_FEC_TRELLIS34_FAILED);
+        return false;
     }
 
-    return false;
+    if (errors > 0U)
+        Metrics::add(METRIC_FEC_TRELLIS34_CORRECTED);
+
+    tribitsToBits(tribits, payload);
+    return true;
 }
 
 /// <summary>
@@ -581,45 +599,28 @@ uint32_t Trellis::checkCode34(const uint8_t* points, uint8_t* tribits) const
 
 
 /// <summary>
-/// Helper to fix errors in Trellis coding.
+/// Helper to decode deinterleaved 1/2 rate soft symbols.
 /// </summary>
-/// <param name="points">4FSK constellation points.</param>
-/// <param name="failPos"></param>
+/// <param name="symbols">Deinterleaved soft symbols.</param>
 /// <param name="payload">Byte payload.</param>
-/// <returns>True, if error corrected, otherwise false.</returns>
-bool Trellis::fixCode12(uint8_t* points, uint32_t failPos, uint8_t* payload) const
+/// <returns>True, if decoded, otherwise false.</returns>
+bool Trellis::decodeSymbols12(const int8_t* symbols, uint8_t* payload) const
 {
+    uint8_t dibits[49U];
+    uint32_t errors = ::edac::Viterbi::decodeTrellis12(symbols, dibits);
 #if DEBUG_TRELLIS
-    ::LogDebug(LOG_HOST, "Trellis::fixCode12() failPos = %u, val = %01X", failPos, points[failPos]);
-#endif
-    for (unsigned j = 0U; j < 20U; j++) {
-        uint32_t bestPos = 0U;
-        uint32_t bestVal = 0U;
-
-        for (uint32_t i = 0U; i < 16U; i++) {
-            points[failPos] = i;
-
-            uint8_t dibits[49U];
-            uint32_t pos = checkCode12(points, dibits);
-            if (pos == 999U) {
-#if DEBUG_TRELLIS
-                ::LogDebug(LOG_HOST, "Trellis::fixCode12() fixed, failPos = %u, pos = %u, val = %01X", failPos, bestPos, bestVal);
+    ::LogDebug(LOG_HOST, "Trellis::decodeSymbols12() errors = %u", errors);
 #endif
-                dibitsToBits(dibits, payload);
-                return true;
-            }
-
-            if (pos > bestPos) {
-                bestPos = pos;
-                bestVal = i;
-            }
-        }
-
-        points[failPos] = bestVal;
-        failPos = bestPos;
+    if (errors > MAX_POINT_ERRORS) {
+        Metrics::add(METRIC_FEC_TRELLIS12_FAILED);
+        return false;
     }
 
-    return false;
+    if (errors > 0U)
+        Metrics::add(METRIC_FEC_TRELLIS12_CORRECTED);
+
+    dibitsToBits(dibits, payload);
+    return true;
 }
 
 /// <summary>
@@ -45,11 +45,15 @@ namespace p25
 
             /// <summary>Decodes 3/4 rate Trellis.</summary>
             bool decode34(const uint8_t* data, uint8_t* payload);
+            /// <summary>Decodes 3/4 rate Trellis from soft symbols.</summary>
+            bool decodeSoft34(const int8_t* symbols, uint8_t* payload);
             /// <summary>Encodes 3/4 rate Trellis.</summary>
             void encode34(const uint8_t* payload, uint8_t* data);
 
             /// <summary>Decodes 1/2 rate Trellis.</summary>
             bool decode12(const uint8_t* data, uint8_t* payload);
+            /// <summary>Decodes 1/2 rate Trellis from soft symbols.</summary>
+            bool decodeSoft12(const int8_t* symbols, uint8_t* payload);
             /// <summary>Encodes 1/2 rate Trellis.</summary>
             void encode12(const uint8_t* payload, uint8_t* data);
 
@@ -71,13 +75,13 @@ namespace p25
             /// <summary>Helper to convert dibits into a byte payload.</summary>
             void dibitsToBits(const uint8_t* dibits, uint8_t* payload) const;
 
-            /// <summary>Helper to fix errors in Trellis coding.</summary>
-            bool fixCode34(uint8_t* points, uint32_t failPos, uint8_t* payload) const;
+            /// <summary>Helper to decode deinterleaved 3/4 rate soft symbols.</summary>
+            bool decodeSymbols34(const int8_t* symbols, uint8_t* payload) const;
             /// <summary>Helper to detect errors in Trellis coding.</summary>
             uint32_t checkCode34(const uint8_t* points, uint8_t* tribits) const;
 
-            /// <summary>Helper to fix errors in Trellis coding.</summary>
-            bool fixCode12(uint8_t* points, uint32_t failPos, uint8_t* payload) const;
+            /// <summary>Helper to decode deinterleaved 1/2 rate soft symbols.</summary>
+            bool decodeSymbols12(const int8_t* symbols, uint8_t* payload) const;
             /// <summary>Helper to detect errors in Trellis coding.</summary>
             uint32_t checkCode12(const uint8_t* points, uint8_t* dibits) const;
         };
@@ -36,8 +36,10 @@
 #include "p25/Sync.h"
 #include "edac/CRC.h"
 #include "remote/RESTClient.h"
+#include "remote/RESTClientPool.h"
 #include "HostMain.h"
 #include "Log.h"
+#include "Metrics.h"
 #include "Thread.h"
 #include "Utils.h"
 
@@ -1219,6 +1221,7 @@ Trunk::Trunk(Control* p25, network::BaseNetwork* network, bool dumpTSBKData, boo
     m_sndcpChGrant(false),
     m_disableGrantSrcIdCheck(false),
     m_redundantGrant(false),
+    m_pendingPermits(),
     m_dumpTSBK(dumpTSBKData),
     m_verbose(verbose),
     m_debug(debug)
@@ -1880,7 +1883,7 @@ void Trunk::queueRF_TSBK_Ctrl(uint8_t lco)
 
                 bool noData = false;
                 uint8_t i = 0U;
-                std::unordered_map<uint32_t, uint32_t> grantTable = m_p25->m_affiliations.grantTable();
+                const std::unordered_map<uint32_t, uint32_t>& grantTable = m_p25->m_affiliations.grantTable();
                 for (auto entry : grantTable) {
                     // no good very bad way of skipping entries...
                     if (i != m_mbfGrpGrntCnt) {
@@ -2119,9 +2122,7 @@ void Trunk::queueRF_TSBK_Ctrl(uint8_t lco)
 /// <returns></returns>
 bool Trunk::writeRF_TSDU_Grant(uint32_t srcId, uint32_t dstId, uint8_t serviceOptions, bool grp, bool net, bool skip, uint32_t chNo)
 {
-    bool emergency = ((serviceOptions & 0xFFU) & 0x80U) == 0x80U;           // Emergency Flag
-    bool encryption = ((serviceOptions & 0xFFU) & 0x40U) == 0x40U;          // Encryption Flag
-    uint8_t priority = ((serviceOptions & 0xFFU) & 0x07U);                  // Priority
+    MetricsScopedTimer grantTimer(METRIC_P25_GRANT_LATENCY);
 
     if (dstId == P25_TGID_ALL) {
         return true; // do not generate grant packets for $FFFF (All Call) TGID
@@ -2245,123 +2246,137 @@ bool Trunk::writeRF_TSDU_Grant(uint32_t srcId, uint32_t dstId, uint8_t serviceOp
     }
 
     if (chNo > 0U) {
-        if (grp) {
-            if (!net) {
+        if (!net) {
+            if (grp) {
                 ::ActivityLog("P25", true, "group grant request from %u to TG %u", srcId, dstId);
             }
+            else {
+                ::ActivityLog("P25", true, "unit-to-unit grant request from %u to %u", srcId, dstId);
+            }
+        }
 
-            // callback REST API to permit the granted TG on the specified voice channel
-            if (m_p25->m_authoritative && m_p25->m_supervisor) {
-                ::lookups::VoiceChData voiceChData = m_p25->m_affiliations.getRFChData(chNo);
-                if (voiceChData.isValidCh() && !voiceChData.address().empty() && voiceChData.port() > 0 &&
-                    chNo != m_p25->m_siteData.channelNo()) {
-                    json::object req = json::object();
-                    int state = modem::DVM_STATE::STATE_P25;
-                    req["state"].set<int>(state);
-                    req["dstId"].set<uint32_t>(dstId);
-
-                    int ret = RESTClient::send(voiceChData.address(), voiceChData.port(), voiceChData.password(),
-                        HTTP_PUT, PUT_PERMIT_TG, req, m_p25->m_debug);
-                    if (ret != network::rest::http::HTTPPayload::StatusType::OK) {
-                        ::LogError((net) ? LOG_NET : LOG_RF, P25_TSDU_STR ", TSBK_IOSP_GRP_VCH (Group Voice Channel Grant), failed to permit TG for use, chNo = %u", chNo);
-                        m_p25->m_affiliations.releaseGrant(dstId, false);
-                        if (!net) {
-                            writeRF_TSDU_Deny(srcId, dstId, P25_DENY_RSN_PTT_BONK, (grp) ? TSBK_IOSP_GRP_VCH : TSBK_IOSP_UU_VCH);
-                            m_p25->m_rfState = RS_RF_REJECTED;
-                        }
-
-                        return false;
-                    }
-                }
-                else {
-                    ::LogError((net) ? LOG_NET : LOG_RF, P25_TSDU_STR ", TSBK_IOSP_GRP_VCH (Group Voice Channel Grant), failed to permit TG for use, chNo = %u", chNo);
+        // callback REST API to permit the granted TG on the specified voice channel
+        if (m_p25->m_authoritative && m_p25->m_supervisor) {
+            ::lookups::VoiceChData voiceChData = m_p25->m_affiliations.getRFChData(chNo);
+            if (voiceChData.isValidCh() && !voiceChData.address().empty() && voiceChData.port() > 0 &&
+                chNo != m_p25->m_siteData.channelNo()) {
+                // the radio retried its request while the permit is in flight; the grant goes out once it completes
+                auto pending = m_pendingPermits.find(dstId);
+                if (pending != m_pendingPermits.end() && pending->second == chNo) {
+                    return true;
                 }
-            }
 
-            std::unique_ptr<IOSP_GRP_VCH> iosp = new_unique(IOSP_GRP_VCH);
-            iosp->setMFId(m_lastMFID);
-            iosp->setSrcId(srcId);
-            iosp->setDstId(dstId);
-            iosp->setGrpVchNo(chNo);
-            iosp->setEmergency(emergency);
-            iosp->setEncrypted(encryption);
-            iosp->setPriority(priority);
-
-            if (m_verbose) {
-                LogMessage((net) ? LOG_NET : LOG_RF, P25_TSDU_STR ", %s, emerg = %u, encrypt = %u, prio = %u, chNo = %u, srcId = %u, dstId = %u",
-                    iosp->toString().c_str(), iosp->getEmergency(), iosp->getEncrypted(), iosp->getPriority(), iosp->getGrpVchNo(), iosp->getSrcId(), iosp->getDstId());
-            }
+                json::object req = json::object();
+                int state = modem::DVM_STATE::STATE_P25;
+                req["state"].set<int>(state);
+                req["dstId"].set<uint32_t>(dstId);
+
+                // the grant is held back until the voice channel accepts the permit, without blocking the
+                // RF path on the request; the completion then transmits either the grant or the deny
+                m_pendingPermits[dstId] = chNo;
+                uint64_t permitStart = Metrics::now();
+                RESTClientPool::CompletionCallback permitted = [this, srcId, dstId, serviceOptions, grp, net, chNo, permitStart](int ret, const json::object&) {
+                    Metrics::observe(METRIC_P25_PERMIT_LATENCY, Metrics::now() - permitStart);
+
+                    // a later permit for the destination (on another channel) supersedes this one
+                    auto pending = m_pendingPermits.find(dstId);
+                    if (pending == m_pendingPermits.end() || pending->second != chNo) {
+                        return;
+                    }
+                    m_pendingPermits.erase(pending);
 
-            // transmit group grant
-            writeRF_TSDU_SBF_Imm(iosp.get(), net);
-            if (m_redundantGrant) {
-                if (m_p25->m_dedicatedControl && m_p25->m_voiceOnControl) {
-                    for (int i = 0; i < 3; i++)
-                        writeRF_TSDU_SBF(iosp.get(), net);
-                }
-            }
-        }
-        else {
-            if (!net) {
-                ::ActivityLog("P25", true, "unit-to-unit grant request from %u to %u", srcId, dstId);
-            }
+                    bool granted = m_p25->m_affiliations.getGrantedCh(dstId) == chNo;
+                    if (ret == network::rest::http::HTTPPayload::StatusType::OK && granted) {
+                        writeRF_TSDU_Voice_Grant(srcId, dstId, serviceOptions, grp, net, chNo);
+                        return;
+                    }
 
-            // callback REST API to permit the granted TG on the specified voice channel
-            if (m_p25->m_authoritative && m_p25->m_supervisor) {
-                ::lookups::VoiceChData voiceChData = m_p25->m_affiliations.getRFChData(chNo);
-                if (voiceChData.isValidCh() && !voiceChData.address().empty() && voiceChData.port() > 0 &&
-                    chNo != m_p25->m_siteData.channelNo()) {
-                    json::object req = json::object();
-                    int state = modem::DVM_STATE::STATE_P25;
-                    req["state"].set<int>(state);
-                    req["dstId"].set<uint32_t>(dstId);
-
-                    int ret = RESTClient::send(voiceChData.address(), voiceChData.port(), voiceChData.password(),
-                        HTTP_PUT, PUT_PERMIT_TG, req, m_p25->m_debug);
-                    if (ret != network::rest::http::HTTPPayload::StatusType::OK) {
-                        ::LogError((net) ? LOG_NET : LOG_RF, P25_TSDU_STR ", TSBK_IOSP_UU_VCH (Unit-to-Unit Voice Channel Grant), failed to permit TG for use, chNo = %u", chNo);
+                    if (!granted) {
+                        ::LogWarning((net) ? LOG_NET : LOG_RF, P25_TSDU_STR ", %s, grant released before the TG was permitted, chNo = %u, dstId = %u",
+                            (grp) ? "TSBK_IOSP_GRP_VCH (Group Voice Channel Grant)" : "TSBK_IOSP_UU_VCH (Unit-to-Unit Voice Channel Grant)", chNo, dstId);
+                    }
+                    else {
+                        ::LogError((net) ? LOG_NET : LOG_RF, P25_TSDU_STR ", %s, failed to permit TG for use, chNo = %u",
+                            (grp) ? "TSBK_IOSP_GRP_VCH (Group Voice Channel Grant)" : "TSBK_IOSP_UU_VCH (Unit-to-Unit Voice Channel Grant)", chNo);
                         m_p25->m_affiliations.releaseGrant(dstId, false);
-                        if (!net) {
-                            writeRF_TSDU_Deny(srcId, dstId, P25_DENY_RSN_PTT_BONK, (grp) ? TSBK_IOSP_GRP_VCH : TSBK_IOSP_UU_VCH);
+                    }
+
+                    if (!net) {
+                        writeRF_TSDU_Deny(srcId, dstId, P25_DENY_RSN_PTT_BONK, (grp) ? TSBK_IOSP_GRP_VCH : TSBK_IOSP_UU_VCH);
+
+                        // don't disturb traffic picked up since the request
+                        if (m_p25->m_rfState == RS_RF_LISTENING) {
                             m_p25->m_rfState = RS_RF_REJECTED;
                         }
-
-                        return false;
                     }
+                };
+
+                if (!RESTClientPool::send(voiceChData.address(), voiceChData.port(), voiceChData.password(),
+                    HTTP_PUT, PUT_PERMIT_TG, req, permitted, m_p25->m_debug)) {
+                    permitted(ERRNO_INTERNAL_ERROR, json::object());
                 }
-                else {
-                    ::LogError((net) ? LOG_NET : LOG_RF, P25_TSDU_STR ", TSBK_IOSP_UU_VCH (Unit-to-Unit Voice Channel Grant), failed to permit TG for use, chNo = %u", chNo);
-                }
-            }
 
-            std::unique_ptr<IOSP_UU_VCH> iosp = new_unique(IOSP_UU_VCH);
-            iosp->setMFId(m_lastMFID);
-            iosp->setSrcId(srcId);
-            iosp->setDstId(dstId);
-            iosp->setGrpVchNo(chNo);
-            iosp->setEmergency(emergency);
-            iosp->setEncrypted(encryption);
-            iosp->setPriority(priority);
-
-            if (m_verbose) {
-                LogMessage((net) ? LOG_NET : LOG_RF, P25_TSDU_STR ", %s, emerg = %u, encrypt = %u, prio = %u, chNo = %u, srcId = %u, dstId = %u",
-                    iosp->toString().c_str(), iosp->getEmergency(), iosp->getEncrypted(), iosp->getPriority(), iosp->getGrpVchNo(), iosp->getSrcId(), iosp->getDstId());
+                // without a running client pool the completion has already run
+                return m_p25->m_affiliations.isGranted(dstId);
             }
-
-            // transmit private grant
-            writeRF_TSDU_SBF_Imm(iosp.get(), net);
-            if (m_redundantGrant) {
-                if (m_p25->m_dedicatedControl && m_p25->m_voiceOnControl) {
-                    for (int i = 0; i < 3; i++)
-                        writeRF_TSDU_SBF(iosp.get(), net);
-                }
+            else {
+                ::LogError((net) ? LOG_NET : LOG_RF, P25_TSDU_STR ", %s, failed to permit TG for use, chNo = %u",
+                    (grp) ? "TSBK_IOSP_GRP_VCH (Group Voice Channel Grant)" : "TSBK_IOSP_UU_VCH (Unit-to-Unit Voice Channel Grant)", chNo);
             }
         }
+
+        writeRF_TSDU_Voice_Grant(srcId, dstId, serviceOptions, grp, net, chNo);
     }
 
     return true;
 }
 
+/// <summary>
+/// Helper to write a voice channel grant packet for a permitted channel grant.
+/// </summary>
+/// <param name="srcId"></param>
+/// <param name="dstId"></param>
+/// <param name="serviceOptions"></param>
+/// <param name="grp"></param>
+/// <param name="net"></param>
+/// <param name="chNo"></param>
+void Trunk::writeRF_TSDU_Voice_Grant(uint32_t srcId, uint32_t dstId, uint8_t serviceOptions, bool grp, bool net, uint32_t chNo)
+{
+    bool emergency = ((serviceOptions & 0xFFU) & 0x80U) == 0x80U;           // Emergency Flag
+    bool encryption = ((serviceOptions & 0xFFU) & 0x40U) == 0x40U;          // Encryption Flag
+    uint8_t priority = ((serviceOptions & 0xFFU) & 0x07U);                  // Priority
+
+    std::unique_ptr<lc::TSBK> iosp = nullptr;
+    if (grp) {
+        iosp = new_unique(IOSP_GRP_VCH);
+    }
+    else {
+        iosp = new_unique(IOSP_UU_VCH);
+    }
+
+    iosp->setMFId(m_lastMFID);
+    iosp->setSrcId(srcId);
+    iosp->setDstId(dstId);
+    iosp->setGrpVchNo(chNo);
+    iosp->setEmergency(emergency);
+    iosp->setEncrypted(encryption);
+    iosp->setPriority(priority);
+
+    if (m_verbose) {
+        LogMessage((net) ? LOG_NET : LOG_RF, P25_TSDU_STR ", %s, emerg = %u, encrypt = %u, prio = %u, chNo = %u, srcId = %u, dstId = %u",
+            iosp->toString().c_str(), iosp->getEmergency(), iosp->getEncrypted(), iosp->getPriority(), iosp->getGrpVchNo(), iosp->getSrcId(), iosp->getDstId());
+    }
+
+    // transmit group/private grant
+    writeRF_TSDU_SBF_Imm(iosp.get(), net);
+    if (m_redundantGrant) {
+        if (m_p25->m_dedicatedControl && m_p25->m_voiceOnControl) {
+            for (int i = 0; i < 3; i++)
+                writeRF_TSDU_SBF(iosp.get(), net);
+        }
+    }
+}
+
 /// <summary>
 /// Helper to write a SNDCP grant packet.
 /// </summary>
@@ -152,6 +152,8 @@ namespace p25
             bool m_disableGrantSrcIdCheck;
             bool m_redundantGrant;
 
+            std::unordered_map<uint32_t, uint32_t> m_pendingPermits;
+
             bool m_dumpTSBK;
 
             bool m_verbose;
@@ -193,6 +195,8 @@ namespace p25
 
             /// <summary>Helper to write a grant packet.</summary>
             bool writeRF_TSDU_Grant(uint32_t srcId, uint32_t dstId, uint8_t serviceOptions, bool grp, bool net = false, bool skip = false, uint32_t chNo = 0U);
+            /// <summary>Helper to write a voice channel grant packet for a permitted channel grant.</summary>
+            void writeRF_TSDU_Voice_Grant(uint32_t srcId, uint32_t dstId, uint8_t serviceOptions, bool grp, bool net, uint32_t chNo);
             /// <summary>Helper to write a SNDCP grant packet.</summary>
             bool writeRF_TSDU_SNDCP_Grant(uint32_t srcId, uint32_t dstId, bool skip = false, bool net = false);
             /// <summary>Helper to write a unit to unit answer request packet.</summary>
@@ -32,6 +32,19 @@
 
 #include <string>
 
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+#define ERRNO_SOCK_OPEN 98
+#define ERRNO_BAD_API_RESPONSE 97
+#define ERRNO_API_CALL_TIMEOUT 96
+#define ERRNO_BAD_AUTH_RESPONSE 95
+#define ERRNO_INTERNAL_ERROR 100
+
+#define ERRNO_NO_ADDRESS 404
+#define ERRNO_NO_PASSWORD 403
+
 // ---------------------------------------------------------------------------
 //  Class Declaration
 //      This class implements the REST client logic.
@@ -0,0 +1,921 @@
+/**
+* Digital Voice Modem - Host Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software
+*
+*/
+/*
+*   Copyright (C) 2023 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#include "Defines.h"
+#include "edac/SHA256.h"
+#include "network/json/json.h"
+#include "network/RESTDefines.h"
+#include "remote/RESTClient.h"
+#include "remote/RESTClientPool.h"
+#include "Log.h"
+#include "Utils.h"
+
+using namespace network::rest::http;
+
+#include <cassert>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+// ---------------------------------------------------------------------------
+//  Static Class Members
+// ---------------------------------------------------------------------------
+
+RESTClientPool* RESTClientPool::m_instance = nullptr;
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Helper to generate the password SHA hash sent to authenticate.
+/// </summary>
+/// <param name="password"></param>
+/// <returns></returns>
+static std::string passwordHash(const std::string& password)
+{
+    uint8_t out[32U];
+    ::memset(out, 0x00U, 32U);
+
+    edac::SHA256 sha256;
+    sha256.buffer((const uint8_t*)password.c_str(), (uint32_t)password.size(), out);
+
+    std::stringstream ss;
+    ss << std::hex;
+    for (uint8_t i = 0; i < 32U; i++)
+        ss << std::setw(2) << std::setfill('0') << (int)out[i];
+
+    return ss.str();
+}
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Initializes a new instance of the RESTClientPool class.
+/// </summary>
+/// <param name="timeout">Time (in milliseconds) to wait for each connect, authenticate or request step.</param>
+/// <param name="debug">Flag indicating whether debug is enabled.</param>
+RESTClientPool::RESTClientPool(uint32_t timeout, bool debug) : Thread(),
+    m_timeout(timeout),
+    m_debug(debug),
+    m_ioContext(),
+    m_work(nullptr),
+    m_started(false),
+    m_channels(),
+    m_streams(),
+    m_completionLock(),
+    m_completions(),
+    m_latencyLock(),
+    m_latency()
+{
+    assert(timeout > 0U);
+}
+
+/// <summary>
+/// Finalizes a instance of the RESTClientPool class.
+/// </summary>
+RESTClientPool::~RESTClientPool()
+{
+    close();
+}
+
+/// <summary>
+/// Starts the client pool and makes it the process-wide instance.
+/// </summary>
+/// <returns>True, if the client pool was started, otherwise false.</returns>
+bool RESTClientPool::open()
+{
+    if (m_started) {
+        return true;
+    }
+
+    m_work = std::unique_ptr<asio::executor_work_guard<asio::io_context::executor_type>>(
+        new asio::executor_work_guard<asio::io_context::executor_type>(m_ioContext.get_executor()));
+
+    m_started = run();
+    if (!m_started) {
+        m_work.reset();
+        return false;
+    }
+
+    m_instance = this;
+    return true;
+}
+
+/// <summary>
+/// Stops the client pool, closing all connections and discarding pending completions.
+/// </summary>
+void RESTClientPool::close()
+{
+    if (!m_started) {
+        return;
+    }
+
+    if (m_instance == this) {
+        m_instance = nullptr;
+    }
+
+    m_work.reset();
+    m_ioContext.stop();
+    wait();
+
+    m_channels.clear();
+    m_streams.clear();
+    m_started = false;
+
+    std::lock_guard<std::mutex> lock(m_completionLock);
+    m_completions.clear();
+}
+
+/// <summary>
+/// Dispatches completed requests to their callbacks.
+/// </summary>
+/// <remarks>This is called from the host loop; callbacks are always executed on the calling thread.</remarks>
+void RESTClientPool::clock()
+{
+    std::deque<Completion> completions;
+    {
+        std::lock_guard<std::mutex> lock(m_completionLock);
+        if (m_completions.empty()) {
+            return;
+        }
+
+        completions.swap(m_completions);
+    }
+
+    for (Completion& completion : completions) {
+        completion.callback(completion.status, completion.response);
+    }
+}
+
+/// <summary>
+/// Queues a REST API request to the specified host on this client pool.
+/// </summary>
+/// <remarks>
+/// The request is sent from the worker thread, and the callback is invoked later from clock(),
+/// never from this call. If the pool has not been started, or the address, port or password is
+/// empty, nothing is queued and the callback is never invoked. A request dropped because the
+/// host's queue is full completes with ERRNO_INTERNAL_ERROR, and requests still pending when
+/// the pool is stopped are discarded without completing.
+/// </remarks>
+/// <param name="address">Network Hostname/IP address to connect to.</param>
+/// <param name="port">Network port number.</param>
+/// <param name="password">Authentication password.</param>
+/// <param name="method">REST API method.</param>
+/// <param name="endpoint">REST API endpoint.</param>
+/// <param name="payload">REST API endpoint payload.</param>
+/// <param name="callback">Callback invoked from clock() when the request completes.</param>
+/// <param name="debug">Flag indicating whether debug is enabled.</param>
+/// <returns>True, if the request was queued and the callback will be invoked, otherwise false
+/// and the callback will not be invoked.</returns>
+bool RESTClientPool::queue(const std::string& address, uint32_t port, const std::string& password, const std::string& method,
+    const std::string& endpoint, const json::object& payload, CompletionCallback callback, bool debug)
+{
+    if (!m_started || address.empty() || port == 0U || password.empty()) {
+        return false;
+    }
+
+    Request req;
+    req.method = method;
+    req.endpoint = endpoint;
+    req.payload = payload;
+    req.callback = callback;
+    req.debug = debug || m_debug;
+    req.retried = false;
+    req.queued = Clock::now();
+
+    asio::post(m_ioContext, [this, address, port, password, req]() {
+        std::string key = address + ":" + std::to_string(port);
+
+        auto it = m_channels.find(key);
+        if (it == m_channels.end()) {
+            std::unique_ptr<Channel> channel = std::unique_ptr<Channel>(new Channel(m_ioContext));
+            channel->address = address;
+            channel->port = port;
+            it = m_channels.emplace(key, std::move(channel)).first;
+        }
+
+        Channel* ch = it->second.get();
+
+        std::string hash = passwordHash(password);
+        if (ch->authHash != hash) {
+            ch->authHash = hash;
+            ch->token = "";
+        }
+
+        if (ch->requests.size() >= REST_CLIENT_POOL_MAX_QUEUE) {
+            ::LogError(LOG_REST, "REST client queue for %s:%u is full, dropping %s %s", address.c_str(), port,
+                req.method.c_str(), req.endpoint.c_str());
+            if (req.callback != nullptr) {
+                Completion completion;
+                completion.callback = req.callback;
+                completion.status = ERRNO_INTERNAL_ERROR;
+                completion.response = json::object();
+
+                std::lock_guard<std::mutex> lock(m_completionLock);
+                m_completions.push_back(completion);
+            }
+            return;
+        }
+
+        ch->requests.push_back(req);
+        process(ch);
+    });
+
+    return true;
+}
+
+/// <summary>
+/// Subscribes to a streaming REST API endpoint on the specified host.
+/// </summary>
+/// <remarks>The stream is kept on its own connection and reconnected whenever it fails; each update
+/// (or failure) is passed to the callback from clock().</remarks>
+/// <param name="address">Network Hostname/IP address to connect to.</param>
+/// <param name="port">Network port number.</param>
+/// <param name="password">Authentication password.</param>
+/// <param name="endpoint">REST API endpoint.</param>
+/// <param name="callback">Callback invoked from clock() for each update of the stream.</param>
+/// <param name="debug">Flag indicating whether debug is enabled.</param>
+/// <returns>True, if the subscription was queued, otherwise false.</returns>
+bool RESTClientPool::subscribe(const std::string& address, uint32_t port, const std::string& password, const std::string& endpoint,
+    CompletionCallback callback, bool debug)
+{
+    if (!m_started || address.empty() || port == 0U || password.empty() || callback == nullptr) {
+        return false;
+    }
+
+    bool streamDebug = debug || m_debug;
+    asio::post(m_ioContext, [this, address, port, password, endpoint, callback, streamDebug]() {
+        std::string key = address + ":" + std::to_string(port) + endpoint;
+
+        auto it = m_streams.find(key);
+        if (it == m_streams.end()) {
+            std::unique_ptr<Channel> channel = std::unique_ptr<Channel>(new Channel(m_ioContext));
+            channel->address = address;
+            channel->port = port;
+            channel->stream = true;
+            channel->endpoint = endpoint;
+            it = m_streams.emplace(key, std::move(channel)).first;
+        }
+
+        Channel* ch = it->second.get();
+        ch->authHash = passwordHash(password);
+        ch->streamCallback = callback;
+        ch->streamDebug = streamDebug;
+        ch->cancelled = false;
+
+        process(ch);
+    });
+
+    return true;
+}
+
+/// <summary>
+/// Cancels a subscription to a streaming REST API endpoint on the specified host.
+/// </summary>
+/// <param name="address">Network Hostname/IP address to connect to.</param>
+/// <param name="port">Network port number.</param>
+/// <param name="endpoint">REST API endpoint.</param>
+void RESTClientPool::unsubscribe(const std::string& address, uint32_t port, const std::string& endpoint)
+{
+    if (!m_started) {
+        return;
+    }
+
+    asio::post(m_ioContext, [this, address, port, endpoint]() {
+        auto it = m_streams.find(address + ":" + std::to_string(port) + endpoint);
+        if (it == m_streams.end()) {
+            return;
+        }
+
+        // the channel is kept, its aborted operations still reference it
+        Channel* ch = it->second.get();
+        ch->cancelled = true;
+        ch->busy = false;
+        stopTimer(ch);
+
+        asio::error_code ignored;
+        ch->resolver.cancel();
+        ch->socket.close(ignored);
+    });
+}
+
+/// <summary>
+/// Gets the latency statistics for the given REST API endpoint.
+/// </summary>
+/// <param name="endpoint">REST API endpoint.</param>
+/// <returns></returns>
+RESTClientLatency RESTClientPool::latency(const std::string& endpoint)
+{
+    std::lock_guard<std::mutex> lock(m_latencyLock);
+
+    auto it = m_latency.find(endpoint);
+    if (it == m_latency.end()) {
+        RESTClientLatency empty;
+        ::memset(&empty, 0x00U, sizeof(RESTClientLatency));
+        return empty;
+    }
+
+    return it->second;
+}
+
+/// <summary>
+/// Sends a REST API request through the process-wide client pool, or synchronously if there is none.
+/// </summary>
+/// <remarks>
+/// When a client pool has been started this is queue() on that pool; the callback is invoked
+/// later from its clock() and false is returned, without invoking the callback, if the request
+/// could not be queued. When no client pool exists (i.e. the command line tools, or before the
+/// host has opened its pool) the request is sent with the synchronous RESTClient, blocking the
+/// caller, and the callback is invoked inline before returning. Callers on the RF path rely on
+/// this, as whatever the callback changes is already in effect by the time send() returns.
+/// </remarks>
+/// <param name="address">Network Hostname/IP address to connect to.</param>
+/// <param name="port">Network port number.</param>
+/// <param name="password">Authentication password.</param>
+/// <param name="method">REST API method.</param>
+/// <param name="endpoint">REST API endpoint.</param>
+/// <param name="payload">REST API endpoint payload.</param>
+/// <param name="callback">Callback invoked when the request completes, with the HTTP status or an error number.</param>
+/// <param name="debug">Flag indicating whether debug is enabled.</param>
+/// <returns>True, if the request was queued, or sent synchronously (whatever its result), otherwise false
+/// and the callback will not be invoked.</returns>
+bool RESTClientPool::send(const std::string& address, uint32_t port, const std::string& password, const std::string& method,
+    const std::string& endpoint, const json::object& payload, CompletionCallback callback, bool debug)
+{
+    if (m_instance != nullptr) {
+        return m_instance->queue(address, port, password, method, endpoint, payload, callback, debug);
+    }
+
+    json::object rsp = json::object();
+    int ret = RESTClient::send(address, port, password, method, endpoint, payload, rsp, debug);
+    if (callback != nullptr) {
+        callback(ret, rsp);
+    }
+
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Worker thread main.
+/// </summary>
+void RESTClientPool::entry()
+{
+    try {
+        m_ioContext.run();
+    }
+    catch (std::exception& e) {
+        ::LogError(LOG_REST, "REST client pool stopped unexpectedly, %s", e.what());
+    }
+
+    for (auto& entry : m_channels) {
+        asio::error_code ec;
+        entry.second->socket.close(ec);
+    }
+
+    for (auto& entry : m_streams) {
+        asio::error_code ec;
+        entry.second->socket.close(ec);
+    }
+}
+
+/// <summary>
+/// Starts processing the next queued request on the given channel.
+/// </summary>
+/// <param name="ch"></param>
+void RESTClientPool::process(Channel* ch)
+{
+    if (ch->busy || ch->cancelled || (ch->requests.empty() && !ch->stream)) {
+        return;
+    }
+
+    ch->busy = true;
+    if (!ch->socket.is_open()) {
+        connect(ch);
+    }
+    else if (ch->token.empty()) {
+        authenticate(ch);
+    }
+    else {
+        transmit(ch);
+    }
+}
+
+/// <summary>
+/// Resolves and connects the given channel to its remote host.
+/// </summary>
+/// <param name="ch"></param>
+void RESTClientPool::connect(Channel* ch)
+{
+    ch->connecting = true;
+    ch->reused = false;
+    startTimer(ch);
+
+    ch->resolver.async_resolve(ch->address, std::to_string(ch->port), [this, ch](const asio::error_code& ec, asio::ip::tcp::resolver::results_type endpoints) {
+        if (ec) {
+            failed(ch, ERRNO_SOCK_OPEN);
+            return;
+        }
+
+        asio::async_connect(ch->socket, endpoints, [this, ch](const asio::error_code& ec, const asio::ip::tcp::endpoint&) {
+            if (ec) {
+                failed(ch, ERRNO_SOCK_OPEN);
+                return;
+            }
+
+            stopTimer(ch);
+            ch->connecting = false;
+
+            asio::error_code ignored;
+            ch->socket.set_option(asio::ip::tcp::no_delay(true), ignored);
+
+            if (ch->token.empty()) {
+                authenticate(ch);
+            }
+            else {
+                transmit(ch);
+            }
+        });
+    });
+}
+
+/// <summary>
+/// Acquires an authentication token for the given channel.
+/// </summary>
+/// <param name="ch"></param>
+void RESTClientPool::authenticate(Channel* ch)
+{
+    json::object request = json::object();
+    request["auth"].set<std::string>(ch->authHash);
+
+    HTTPPayload httpPayload = HTTPPayload::requestPayload(HTTP_PUT, PUT_AUTHENTICATE);
+    httpPayload.payload(request);
+
+    exchange(ch, httpPayload, [this](Channel* ch) {
+        json::value v;
+        std::string err = json::parse(v, ch->body);
+        if (!err.empty() || !v.is<json::object>()) {
+            failed(ch, ERRNO_BAD_API_RESPONSE);
+            return;
+        }
+
+        json::object rsp = v.get<json::object>();
+        if (!rsp["status"].is<int>() || rsp["status"].get<int>() != HTTPPayload::StatusType::OK || !rsp["token"].is<std::string>()) {
+            failed(ch, ERRNO_BAD_AUTH_RESPONSE);
+            return;
+        }
+
+        ch->token = rsp["token"].get<std::string>();
+
+        ch->busy = false;
+        process(ch);
+    });
+}
+
+/// <summary>
+/// Transmits the request at the head of the given channel's queue.
+/// </summary>
+/// <param name="ch"></param>
+void RESTClientPool::transmit(Channel* ch)
+{
+    if (ch->stream) {
+        openStream(ch);
+        return;
+    }
+
+    Request& req = ch->requests.front();
+
+    HTTPPayload httpPayload = HTTPPayload::requestPayload(req.method, req.endpoint);
+    httpPayload.headers.add("X-DVM-Auth-Token", ch->token);
+    httpPayload.payload(req.payload);
+
+    exchange(ch, httpPayload, [this](Channel* ch) {
+        Request& req = ch->requests.front();
+
+        json::value v;
+        std::string err = json::parse(v, ch->body);
+        if (!err.empty() || !v.is<json::object>()) {
+            failed(ch, ERRNO_BAD_API_RESPONSE);
+            return;
+        }
+
+        json::object rsp = v.get<json::object>();
+        int status = rsp["status"].is<int>() ? rsp["status"].get<int>() : (int)ch->response.status;
+
+        // the remote host only holds a single token per client address; if it has been
+        // replaced (i.e. by another client on this host) authenticate again and retry once
+        if (status == HTTPPayload::StatusType::UNAUTHORIZED && !req.retried) {
+            req.retried = true;
+            ch->token = "";
+
+            ch->busy = false;
+            process(ch);
+            return;
+        }
+
+        if (req.debug) {
+            ::LogDebug(LOG_REST, "REST Response: %s", ch->body.c_str());
+        }
+
+        complete(ch, status, rsp);
+
+        ch->busy = false;
+        process(ch);
+    });
+}
+
+/// <summary>
+/// Writes an HTTP request and reads the response on the given channel.
+/// </summary>
+/// <param name="ch"></param>
+/// <param name="request"></param>
+/// <param name="handler"></param>
+void RESTClientPool::exchange(Channel* ch, HTTPPayload request, std::function<void(Channel*)> handler)
+{
+    asio::error_code ec;
+    asio::ip::tcp::endpoint remote = ch->socket.remote_endpoint(ec);
+    if (ec) {
+        failed(ch, ERRNO_SOCK_OPEN);
+        return;
+    }
+
+    ch->request = request;
+    ch->request.attachHostHeader(remote);
+    ch->request.headers.add("Connection", "keep-alive");
+    ch->onResponse = handler;
+
+    startTimer(ch);
+    asio::async_write(ch->socket, ch->request.toBuffers(), [this, ch](const asio::error_code& ec, std::size_t) {
+        if (ec) {
+            failed(ch, ERRNO_SOCK_OPEN);
+            return;
+        }
+
+        ch->lexer.reset();
+        ch->response = HTTPPayload();
+        ch->headerDone = false;
+        ch->contentLength = 0U;
+        ch->body = "";
+
+        read(ch);
+    });
+}
+
+/// <summary>
+/// Reads a HTTP response on the given channel.
+/// </summary>
+/// <param name="ch"></param>
+void RESTClientPool::read(Channel* ch)
+{
+    ch->socket.async_read_some(asio::buffer(ch->buffer), [this, ch](const asio::error_code& ec, std::size_t bytes) {
+        if (ec) {
+            failed(ch, ERRNO_API_CALL_TIMEOUT);
+            return;
+        }
+
+        char* begin = ch->buffer.data();
+        char* end = ch->buffer.data() + bytes;
+
+        if (!ch->headerDone) {
+            HTTPLexer::ResultType result;
+            std::tie(result, begin) = ch->lexer.parse(ch->response, begin, end);
+            if (result == HTTPLexer::BAD) {
+                failed(ch, ERRNO_BAD_API_RESPONSE);
+                return;
+            }
+
+            if (result == HTTPLexer::INDETERMINATE) {
+                read(ch);
+                return;
+            }
+
+            ch->headerDone = true;
+
+            // a stream carries chunks for as long as the connection stays up
+            if (ch->stream && ::strtolower(ch->response.headers.find("Transfer-Encoding")) == "chunked") {
+                ch->body.assign(begin, end);
+                readStream(ch);
+                return;
+            }
+
+            std::string contentLength = ch->response.headers.find("Content-Length");
+            ch->contentLength = (contentLength != "") ? (size_t)::strtoul(contentLength.c_str(), NULL, 10) : 0U;
+        }
+
+        ch->body.append(begin, end);
+        if (ch->body.size() < ch->contentLength) {
+            read(ch);
+            return;
+        }
+
+        ch->body.resize(ch->contentLength);
+
+        stopTimer(ch);
+
+        // hosts that do not keep the connection alive will close it after responding
+        if (ch->response.headers.find("Connection") == "keep-alive") {
+            ch->reused = true;
+        }
+        else {
+            asio::error_code ignored;
+            ch->socket.close(ignored);
+        }
+
+        ch->onResponse(ch);
+    });
+}
+
+/// <summary>
+/// Handles an I/O failure on the given channel.
+/// </summary>
+/// <param name="ch"></param>
+/// <param name="status"></param>
+void RESTClientPool::failed(Channel* ch, int status)
+{
+    stopTimer(ch);
+    if (ch->timedOut) {
+        ch->timedOut = false;
+        status = ERRNO_API_CALL_TIMEOUT;
+    }
+
+    bool connecting = ch->connecting;
+    bool reused = ch->reused;
+
+    asio::error_code ignored;
+    ch->socket.close(ignored);
+    ch->connecting = false;
+    ch->reused = false;
+    ch->busy = false;
+
+    if (ch->stream) {
+        streamFailed(ch, status);
+        return;
+    }
+
+    if (ch->requests.empty()) {
+        return;
+    }
+
+    // the remote host may have dropped an idle keep-alive connection; reconnect and retry once
+    Request& req = ch->requests.front();
+    if (reused && !req.retried && status != ERRNO_API_CALL_TIMEOUT) {
+        req.retried = true;
+        process(ch);
+        return;
+    }
+
+    ::LogError(LOG_REST, "REST request %s %s to %s:%u failed, status = %d", req.method.c_str(), req.endpoint.c_str(),
+        ch->address.c_str(), ch->port, status);
+
+    // a host that cannot be reached fails everything queued for it, rather than timing out each request in turn
+    if (connecting) {
+        while (!ch->requests.empty()) {
+            complete(ch, status, json::object());
+        }
+        return;
+    }
+
+    complete(ch, status, json::object());
+    process(ch);
+}
+
+/// <summary>
+/// Completes the request at the head of the given channel's queue.
+/// </summary>
+/// <param name="ch"></param>
+/// <param name="status"></param>
+/// <param name="response"></param>
+void RESTClientPool::complete(Channel* ch, int status, const json::object& response)
+{
+    Request req = ch->requests.front();
+    ch->requests.pop_front();
+
+    uint32_t elapsed = (uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - req.queued).count();
+    {
+        std::lock_guard<std::mutex> lock(m_latencyLock);
+        RESTClientLatency& stats = m_latency[req.endpoint];
+        if (status == HTTPPayload::StatusType::OK) {
+            stats.count++;
+            stats.lastMs = elapsed;
+            stats.totalMs += elapsed;
+            if (elapsed > stats.maxMs) {
+                stats.maxMs = elapsed;
+            }
+        }
+        else {
+            stats.failures++;
+        }
+    }
+
+    if (req.debug) {
+        ::LogDebug(LOG_REST, "REST request %s %s to %s:%u completed, status = %d, latency = %ums", req.method.c_str(), req.endpoint.c_str(),
+            ch->address.c_str(), ch->port, status, elapsed);
+    }
+
+    if (req.callback != nullptr) {
+        Completion completion;
+        completion.callback = req.callback;
+        completion.status = status;
+        completion.response = response;
+
+        std::lock_guard<std::mutex> lock(m_completionLock);
+        m_completions.push_back(completion);
+    }
+
+}
+
+/// <summary>
+/// Requests the subscribed stream on the given channel.
+/// </summary>
+/// <param name="ch"></param>
+void RESTClientPool::openStream(Channel* ch)
+{
+    json::object payload = json::object();
+
+    HTTPPayload httpPayload = HTTPPayload::requestPayload(HTTP_GET, ch->endpoint);
+    httpPayload.headers.add("X-DVM-Auth-Token", ch->token);
+    httpPayload.payload(payload);
+
+    // a regular (non-chunked) response means the host refused the stream
+    exchange(ch, httpPayload, [this](Channel* ch) {
+        json::value v;
+        std::string err = json::parse(v, ch->body);
+        if (!err.empty() || !v.is<json::object>()) {
+            failed(ch, ERRNO_BAD_API_RESPONSE);
+            return;
+        }
+
+        json::object rsp = v.get<json::object>();
+        int status = rsp["status"].is<int>() ? rsp["status"].get<int>() : (int)ch->response.status;
+        failed(ch, (status == HTTPPayload::StatusType::OK) ? ERRNO_BAD_API_RESPONSE : status);
+    });
+}
+
+/// <summary>
+/// Reads the chunks of the subscribed stream on the given channel.
+/// </summary>
+/// <param name="ch"></param>
+void RESTClientPool::readStream(Channel* ch)
+{
+    // deliver every complete chunk received so far
+    while (true) {
+        size_t eol = ch->body.find("\r\n");
+        if (eol == std::string::npos) {
+            break;
+        }
+
+        size_t length = (size_t)::strtoul(ch->body.substr(0U, eol).c_str(), NULL, 16);
+        if (length == 0U) {
+            // the last chunk; the host ended the stream
+            failed(ch, ERRNO_SOCK_OPEN);
+            return;
+        }
+
+        if (ch->body.size() < eol + 2U + length + 2U) {
+            break;
+        }
+
+        std::string content = ch->body.substr(eol + 2U, length);
+        ch->body.erase(0U, eol + 2U + length + 2U);
+
+        json::value v;
+        std::string err = json::parse(v, content);
+        if (!err.empty() || !v.is<json::object>()) {
+            failed(ch, ERRNO_BAD_API_RESPONSE);
+            return;
+        }
+
+        if (ch->streamDebug) {
+            ::LogDebug(LOG_REST, "REST Stream %s:%u%s: %s", ch->address.c_str(), ch->port, ch->endpoint.c_str(), content.c_str());
+        }
+
+        notify(ch->streamCallback, HTTPPayload::StatusType::OK, v.get<json::object>());
+    }
+
+    // the host sends a heartbeat well within the stream timeout
+    startTimer(ch, REST_CLIENT_STREAM_TIMEOUT_MS);
+    ch->socket.async_read_some(asio::buffer(ch->buffer), [this, ch](const asio::error_code& ec, std::size_t bytes) {
+        if (ec) {
+            failed(ch, ERRNO_API_CALL_TIMEOUT);
+            return;
+        }
+
+        ch->body.append(ch->buffer.data(), bytes);
+        readStream(ch);
+    });
+}
+
+/// <summary>
+/// Handles an I/O failure on the given stream channel, scheduling it to reconnect.
+/// </summary>
+/// <param name="ch"></param>
+/// <param name="status"></param>
+void RESTClientPool::streamFailed(Channel* ch, int status)
+{
+    if (ch->cancelled) {
+        return;
+    }
+
+    ::LogError(LOG_REST, "REST stream %s from %s:%u failed, status = %d", ch->endpoint.c_str(), ch->address.c_str(), ch->port, status);
+    notify(ch->streamCallback, status, json::object());
+
+    // authenticate again on reconnect, the host may have restarted
+    ch->token = "";
+    ch->busy = true;
+
+    uint32_t seq = ++ch->timerSeq;
+    ch->timer.expires_after(std::chrono::milliseconds(REST_CLIENT_STREAM_RETRY_MS));
+    ch->timer.async_wait([this, ch, seq](const asio::error_code& ec) {
+        if (ec || seq != ch->timerSeq) {
+            return;
+        }
+
+        ch->busy = false;
+        process(ch);
+    });
+}
+
+/// <summary>
+/// Queues a callback to be invoked from clock().
+/// </summary>
+/// <param name="callback"></param>
+/// <param name="status"></param>
+/// <param name="response"></param>
+void RESTClientPool::notify(CompletionCallback callback, int status, const json::object& response)
+{
+    if (callback == nullptr) {
+        return;
+    }
+
+    Completion completion;
+    completion.callback = callback;
+    completion.status = status;
+    completion.response = response;
+
+    std::lock_guard<std::mutex> lock(m_completionLock);
+    m_completions.push_back(completion);
+}
+
+/// <summary>
+/// Arms the operation timeout for the given channel.
+/// </summary>
+/// <param name="ch"></param>
+/// <param name="timeout">Timeout in milliseconds; zero uses the pool timeout.</param>
+void RESTClientPool::startTimer(Channel* ch, uint32_t timeout)
+{
+    uint32_t seq = ++ch->timerSeq;
+    ch->timedOut = false;
+
+    ch->timer.expires_after(std::chrono::milliseconds((timeout > 0U) ? timeout : m_timeout));
+    ch->timer.async_wait([ch, seq](const asio::error_code& ec) {
+        if (ec || seq != ch->timerSeq) {
+            return;
+        }
+
+        // closing the socket aborts the outstanding operation, whose handler reports the timeout
+        ch->timedOut = true;
+
+        asio::error_code ignored;
+        ch->resolver.cancel();
+        ch->socket.cancel(ignored);
+        ch->socket.close(ignored);
+    });
+}
+
+/// <summary>
+/// Disarms the operation timeout for the given channel.
+/// </summary>
+/// <param name="ch"></param>
+void RESTClientPool::stopTimer(Channel* ch)
+{
+    ++ch->timerSeq;
+    ch->timer.cancel();
+}
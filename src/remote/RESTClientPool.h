@@ -0,0 +1,228 @@
+/**
+* Digital Voice Modem - Host Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software
+*
+*/
+/*
+*   Copyright (C) 2023 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#if !defined(__REST_CLIENT_POOL_H__)
+#define __REST_CLIENT_POOL_H__
+
+#include "Defines.h"
+#include "network/json/json.h"
+#include "network/rest/http/HTTPLexer.h"
+#include "network/rest/http/HTTPPayload.h"
+#include "Thread.h"
+
+#include <array>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <asio.hpp>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t  REST_CLIENT_POOL_TIMEOUT_MS = 500U;
+const uint32_t  REST_CLIENT_POOL_MAX_QUEUE = 64U;
+
+const uint32_t  REST_CLIENT_STREAM_TIMEOUT_MS = 15000U;
+const uint32_t  REST_CLIENT_STREAM_RETRY_MS = 5000U;
+
+// ---------------------------------------------------------------------------
+//  Structure Declaration
+//      Latency statistics for a REST API endpoint called through the pool.
+// ---------------------------------------------------------------------------
+
+struct RESTClientLatency {
+    uint64_t count;
+    uint64_t failures;
+    uint32_t lastMs;
+    uint32_t maxMs;
+    uint64_t totalMs;
+};
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+//      This class implements a non-blocking REST client that keeps a persistent
+//      connection per remote host, queues requests and delivers their
+//      completions (and the updates of any subscribed streams) back to the
+//      thread that calls clock().
+// ---------------------------------------------------------------------------
+
+class HOST_SW_API RESTClientPool : private Thread {
+public:
+    typedef std::function<void(int status, const json::object& response)> CompletionCallback;
+
+    /// <summary>Initializes a new instance of the RESTClientPool class.</summary>
+    RESTClientPool(uint32_t timeout = REST_CLIENT_POOL_TIMEOUT_MS, bool debug = false);
+    /// <summary>Finalizes a instance of the RESTClientPool class.</summary>
+    ~RESTClientPool();
+
+    /// <summary>Starts the client pool and makes it the process-wide instance.</summary>
+    bool open();
+    /// <summary>Stops the client pool, closing all connections and discarding pending completions.</summary>
+    void close();
+
+    /// <summary>Dispatches completed requests to their callbacks.</summary>
+    void clock();
+
+    /// <summary>Queues a REST API request to the specified host on this client pool.</summary>
+    bool queue(const std::string& address, uint32_t port, const std::string& password, const std::string& method,
+        const std::string& endpoint, const json::object& payload, CompletionCallback callback = nullptr, bool debug = false);
+
+    /// <summary>Subscribes to a streaming REST API endpoint on the specified host.</summary>
+    bool subscribe(const std::string& address, uint32_t port, const std::string& password, const std::string& endpoint,
+        CompletionCallback callback, bool debug = false);
+    /// <summary>Cancels a subscription to a streaming REST API endpoint on the specified host.</summary>
+    void unsubscribe(const std::string& address, uint32_t port, const std::string& endpoint);
+
+    /// <summary>Gets the latency statistics for the given REST API endpoint.</summary>
+    RESTClientLatency latency(const std::string& endpoint);
+
+    /// <summary>Sends a REST API request through the process-wide client pool, or synchronously if there is none.</summary>
+    static bool send(const std::string& address, uint32_t port, const std::string& password, const std::string& method,
+        const std::string& endpoint, const json::object& payload, CompletionCallback callback = nullptr, bool debug = false);
+    /// <summary>Gets the process-wide client pool.</summary>
+    static RESTClientPool* instance() { return m_instance; }
+
+private:
+    typedef network::rest::http::HTTPPayload HTTPPayload;
+    typedef network::rest::http::HTTPLexer HTTPLexer;
+    typedef std::chrono::steady_clock Clock;
+
+    class Request {
+    public:
+        std::string method;
+        std::string endpoint;
+        json::object payload;
+        CompletionCallback callback;
+        bool debug;
+        bool retried;
+        Clock::time_point queued;
+    };
+
+    class Channel {
+    public:
+        /// <summary>Initializes a new instance of the Channel class.</summary>
+        Channel(asio::io_context& ioContext) : resolver(ioContext), socket(ioContext), timer(ioContext),
+            lexer(true) { /* stub */ }
+
+        std::string address;
+        uint32_t port;
+        std::string authHash;
+
+        asio::ip::tcp::resolver resolver;
+        asio::ip::tcp::socket socket;
+        asio::steady_timer timer;
+        uint32_t timerSeq = 0U;
+        bool timedOut = false;
+
+        bool busy = false;
+        bool connecting = false;
+        bool reused = false;
+        std::string token;
+
+        std::deque<Request> requests;
+
+        bool stream = false;
+        bool cancelled = false;
+        std::string endpoint;
+        CompletionCallback streamCallback;
+        bool streamDebug = false;
+
+        HTTPPayload request;
+        HTTPPayload response;
+        HTTPLexer lexer;
+        bool headerDone = false;
+        size_t contentLength = 0U;
+        std::string body;
+        std::array<char, 8192> buffer;
+        std::function<void(Channel*)> onResponse;
+    };
+
+    class Completion {
+    public:
+        CompletionCallback callback;
+        int status;
+        json::object response;
+    };
+
+    uint32_t m_timeout;
+    bool m_debug;
+
+    asio::io_context m_ioContext;
+    std::unique_ptr<asio::executor_work_guard<asio::io_context::executor_type>> m_work;
+    bool m_started;
+
+    std::map<std::string, std::unique_ptr<Channel>> m_channels;
+    std::map<std::string, std::unique_ptr<Channel>> m_streams;
+
+    std::mutex m_completionLock;
+    std::deque<Completion> m_completions;
+
+    std::mutex m_latencyLock;
+    std::map<std::string, RESTClientLatency> m_latency;
+
+    static RESTClientPool* m_instance;
+
+    /// <summary>Worker thread main.</summary>
+    virtual void entry();
+
+    /// <summary>Starts processing the next queued request on the given channel.</summary>
+    void process(Channel* ch);
+    /// <summary>Resolves and connects the given channel to its remote host.</summary>
+    void connect(Channel* ch);
+    /// <summary>Acquires an authentication token for the given channel.</summary>
+    void authenticate(Channel* ch);
+    /// <summary>Transmits the request at the head of the given channel's queue.</summary>
+    void transmit(Channel* ch);
+    /// <summary>Writes an HTTP request and reads the response on the given channel.</summary>
+    void exchange(Channel* ch, HTTPPayload request, std::function<void(Channel*)> handler);
+    /// <summary>Reads a HTTP response on the given channel.</summary>
+    void read(Channel* ch);
+    /// <summary>Handles an I/O failure on the given channel.</summary>
+    void failed(Channel* ch, int status);
+    /// <summary>Completes the request at the head of the given channel's queue.</summary>
+    void complete(Channel* ch, int status, const json::object& response);
+
+    /// <summary>Requests the subscribed stream on the given channel.</summary>
+    void openStream(Channel* ch);
+    /// <summary>Reads the chunks of the subscribed stream on the given channel.</summary>
+    void readStream(Channel* ch);
+    /// <summary>Handles an I/O failure on the given stream channel, scheduling it to reconnect.</summary>
+    void streamFailed(Channel* ch, int status);
+    /// <summary>Queues a callback to be invoked from clock().</summary>
+    void notify(CompletionCallback callback, int status, const json::object& response);
+
+    /// <summary>Arms the operation timeout for the given channel.</summary>
+    void startTimer(Channel* ch, uint32_t timeout = 0U);
+    /// <summary>Disarms the operation timeout for the given channel.</summary>
+    void stopTimer(Channel* ch);
+};
+
+#endif // __REST_CLIENT_POOL_H__
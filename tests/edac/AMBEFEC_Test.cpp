@@ -0,0 +1,457 @@
+/**
+* Digital Voice Modem - Host Software (Test Suite)
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software / Test Suite
+*
+*/
+/*
+*   Copyright (C) 2023 Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#include "Defines.h"
+#include "edac/AMBEFEC.h"
+#include "edac/Golay24128.h"
+#include "edac/Hamming.h"
+#include "Log.h"
+#include "Utils.h"
+
+using namespace edac;
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t CROSS_CHECK_ITERATIONS = 20000U;
+const uint32_t BENCHMARK_ITERATIONS = 20000U;
+
+const uint32_t LDU_IMBE_FRAMES = 9U;
+
+// results are accumulated here so the compiler cannot elide the benchmarked calls
+static volatile uint32_t g_benchmarkSink = 0U;
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Reference bit-by-bit AMBE A/B/C word regeneration.
+/// </summary>
+static uint32_t referenceRegenerate(uint32_t& a, uint32_t& b, uint32_t& c)
+{
+    uint32_t old_a = a;
+    uint32_t old_b = b;
+
+    uint32_t data;
+    Golay24128::decode24128(a, data);
+
+    a = Golay24128::encode24128(data);
+
+    uint32_t p = PRNG_TABLE[data] >> 1;
+    b ^= p;
+
+    uint32_t datb = Golay24128::decode23127(b);
+    b = Golay24128::encode23127(datb) >> 1;
+
+    b ^= p;
+
+    uint32_t errsA = Utils::countBits32(a ^ old_a);
+    uint32_t errsB = Utils::countBits32(b ^ old_b);
+
+    if (errsA >= 4U || ((errsA + errsB) >= 6U && errsA >= 2U)) {
+        a = 0xF00292U;
+        b = 0x0E0B20U;
+        c = 0x000000U;
+    }
+
+    return errsA + errsB;
+}
+
+/// <summary>
+/// Returns the position of a bit of the given DMR AMBE frame.
+/// </summary>
+static uint32_t referenceDMRPos(uint32_t pos, uint32_t frame)
+{
+    if (frame == 1U) {
+        pos += 72U;
+        if (pos >= 108U)
+            pos += 48U;
+    }
+    else if (frame == 2U) {
+        pos += 192U;
+    }
+
+    return pos;
+}
+
+/// <summary>
+/// Reference bit-by-bit DMR AMBE FEC regeneration.
+/// </summary>
+static uint32_t referenceRegenerateDMR(uint8_t* bytes, bool write)
+{
+    uint32_t errors = 0U;
+    for (uint32_t n = 0U; n < 3U; n++) {
+        uint32_t a = 0U, b = 0U, c = 0U;
+        for (uint32_t i = 0U; i < 24U; i++)
+            if (READ_BIT(bytes, referenceDMRPos(AMBE_A_TABLE[i], n))) a |= 0x800000U >> i;
+        for (uint32_t i = 0U; i < 23U; i++)
+            if (READ_BIT(bytes, referenceDMRPos(AMBE_B_TABLE[i], n))) b |= 0x400000U >> i;
+        for (uint32_t i = 0U; i < 25U; i++)
+            if (READ_BIT(bytes, referenceDMRPos(AMBE_C_TABLE[i], n))) c |= 0x1000000U >> i;
+
+        errors += referenceRegenerate(a, b, c);
+        if (!write)
+            continue;
+
+        for (uint32_t i = 0U; i < 24U; i++)
+            WRITE_BIT(bytes, referenceDMRPos(AMBE_A_TABLE[i], n), a & (0x800000U >> i));
+        for (uint32_t i = 0U; i < 23U; i++)
+            WRITE_BIT(bytes, referenceDMRPos(AMBE_B_TABLE[i], n), b & (0x400000U >> i));
+        for (uint32_t i = 0U; i < 25U; i++)
+            WRITE_BIT(bytes, referenceDMRPos(AMBE_C_TABLE[i], n), c & (0x1000000U >> i));
+    }
+
+    return errors;
+}
+
+/// <summary>
+/// Reference bit-by-bit NXDN AMBE FEC regeneration.
+/// </summary>
+static uint32_t referenceRegenerateNXDN(uint8_t* bytes, bool write)
+{
+    uint32_t a = 0U, b = 0U, c = 0U;
+    for (uint32_t i = 0U; i < 24U; i++)
+        if (READ_BIT(bytes, AMBE_A_TABLE[i])) a |= 0x800000U >> i;
+    for (uint32_t i = 0U; i < 23U; i++)
+        if (READ_BIT(bytes, AMBE_B_TABLE[i])) b |= 0x400000U >> i;
+    for (uint32_t i = 0U; i < 24U; i++)
+        if (READ_BIT(bytes, AMBE_C_TABLE[i])) c |= 0x1000000U >> i;
+
+    uint32_t errors = referenceRegenerate(a, b, c);
+    if (!write)
+        return errors;
+
+    for (uint32_t i = 0U; i < 24U; i++)
+        WRITE_BIT(bytes, AMBE_A_TABLE[i], a & (0x800000U >> i));
+    for (uint32_t i = 0U; i < 23U; i++)
+        WRITE_BIT(bytes, AMBE_B_TABLE[i], b & (0x400000U >> i));
+    for (uint32_t i = 0U; i < 24U; i++)
+        WRITE_BIT(bytes, AMBE_C_TABLE[i], c & (0x1000000U >> i));
+
+    return errors;
+}
+
+/// <summary>
+/// Reference bit-by-bit Golay (23,12,7) regeneration of a de-interleaved IMBE codeword.
+/// </summary>
+static uint32_t referenceGolay(bool* bit)
+{
+    uint32_t g1 = 0U;
+    for (uint32_t i = 0U; i < 23U; i++)
+        g1 = (g1 << 1) | (bit[i] ? 0x01U : 0x00U);
+    uint32_t data = Golay24128::decode23127(g1);
+    uint32_t g2 = Golay24128::encode23127(data);
+    for (int i = 23; i >= 0; i--) {
+        bit[i] = (g2 & 0x01U) == 0x01U;
+        g2 >>= 1;
+    }
+
+    return data;
+}
+
+/// <summary>
+/// Reference bit-by-bit P25 IMBE FEC regeneration.
+/// </summary>
+static uint32_t referenceRegenerateIMBE(uint8_t* bytes, bool write)
+{
+    bool orig[144U];
+    bool temp[144U];
+
+    for (uint32_t i = 0U; i < 144U; i++)
+        orig[i] = temp[i] = READ_BIT(bytes, IMBE_INTERLEAVE[i]);
+
+    uint32_t c0data = referenceGolay(temp);
+
+    bool prn[114U];
+    uint32_t p = 16U * c0data;
+    for (uint32_t i = 0U; i < 114U; i++) {
+        p = (173U * p + 13849U) % 65536U;
+        prn[i] = p >= 32768U;
+    }
+
+    for (uint32_t i = 0U; i < 114U; i++)
+        temp[i + 23U] ^= prn[i];
+
+    referenceGolay(temp + 23U);
+    referenceGolay(temp + 46U);
+    referenceGolay(temp + 69U);
+
+    Hamming::decode15113_1(temp + 92U);
+    Hamming::decode15113_1(temp + 107U);
+    Hamming::decode15113_1(temp + 122U);
+
+    for (uint32_t i = 0U; i < 114U; i++)
+        temp[i + 23U] ^= prn[i];
+
+    uint32_t errors = 0U;
+    for (uint32_t i = 0U; i < 144U; i++) {
+        if (orig[i] != temp[i])
+            errors++;
+    }
+
+    if (write) {
+        for (uint32_t i = 0U; i < 144U; i++)
+            WRITE_BIT(bytes, IMBE_INTERLEAVE[i], temp[i]);
+    }
+
+    return errors;
+}
+
+/// <summary>
+/// Fills a buffer with random data.
+/// </summary>
+static void fillRandom(uint8_t* buffer, uint32_t length)
+{
+    for (uint32_t i = 0U; i < length; i++) {
+        buffer[i] = rand();
+    }
+}
+
+/// <summary>
+/// Prepares a test frame; either random data, or a regenerated frame with a few bit errors.
+/// </summary>
+static void makeFrame(uint8_t* buffer, uint32_t length, uint32_t iteration, uint32_t (*regenerate)(uint8_t*, bool))
+{
+    fillRandom(buffer, length);
+    if ((iteration & 1U) == 0U)
+        return;
+
+    regenerate(buffer, true);
+    uint32_t errors = rand() % 6;
+    for (uint32_t i = 0U; i < errors; i++) {
+        uint32_t n = rand() % (length * 8U);
+        buffer[n >> 3] ^= BIT_MASK_TABLE[n & 7U];
+    }
+}
+
+TEST_CASE("AMBEFEC", "[AMBE FEC Test]") {
+    SECTION("Golay_Test") {
+        bool failed = false;
+
+        INFO("Golay (23,12,7) / (24,12,8) Test");
+
+        // the (23,12,7) code is perfect; every 23-bit word lies within 3 bits of exactly one codeword
+        uint32_t patterns[2048U];
+        uint32_t n = 0U;
+        patterns[n++] = 0U;
+        for (uint32_t i = 0U; i < 23U; i++) {
+            patterns[n++] = 1U << i;
+            for (uint32_t j = i + 1U; j < 23U; j++) {
+                patterns[n++] = (1U << i) | (1U << j);
+                for (uint32_t k = j + 1U; k < 23U; k++)
+                    patterns[n++] = (1U << i) | (1U << j) | (1U << k);
+            }
+        }
+
+        for (uint32_t data = 0U; data < 4096U && !failed; data++) {
+            uint32_t code = Golay24128::encode23127(data) >> 1;
+            for (uint32_t i = 0U; i < n; i++) {
+                if (Golay24128::decode23127(code ^ patterns[i]) != data) {
+                    ::LogDebug("T", "Golay_Test, failed (23,12,7) decode, data = $%03X, error = $%06X", data, patterns[i]);
+                    failed = true;
+                    break;
+                }
+
+                uint32_t out = 0U;
+                bool valid = Golay24128::decode24128(Golay24128::encode24128(data) ^ (patterns[i] << 1), out);
+                if (!valid || out != data) {
+                    ::LogDebug("T", "Golay_Test, failed (24,12,8) decode, data = $%03X, error = $%06X", data, patterns[i] << 1);
+                    failed = true;
+                    break;
+                }
+            }
+        }
+
+        REQUIRE(failed==false);
+    }
+
+    SECTION("DMR_CrossCheck_Test") {
+        bool failed = false;
+
+        INFO("AMBEFEC DMR Regenerate Cross-Check Test");
+
+        srand((unsigned int)time(NULL));
+
+        AMBEFEC fec;
+        uint8_t expected[33U];
+        uint8_t actual[33U];
+        for (uint32_t i = 0U; i < CROSS_CHECK_ITERATIONS; i++) {
+            makeFrame(expected, 33U, i, referenceRegenerateDMR);
+            ::memcpy(actual, expected, 33U);
+
+            uint32_t measured = fec.measureDMRBER(actual);
+            uint32_t errs1 = referenceRegenerateDMR(expected, true);
+            uint32_t errs2 = fec.regenerateDMR(actual);
+            if (errs1 != errs2 || measured != errs1 || ::memcmp(expected, actual, 33U) != 0) {
+                ::LogDebug("T", "DMR_CrossCheck_Test, failed cross-check, errs1 = %u, errs2 = %u, measured = %u", errs1, errs2, measured);
+                Utils::dump(2U, "Expected", expected, 33U);
+                Utils::dump(2U, "Actual", actual, 33U);
+                failed = true;
+                break;
+            }
+        }
+
+        REQUIRE(failed==false);
+    }
+
+    SECTION("IMBE_CrossCheck_Test") {
+        bool failed = false;
+
+        INFO("AMBEFEC IMBE Regenerate Cross-Check Test");
+
+        srand((unsigned int)time(NULL));
+
+        AMBEFEC fec;
+        uint8_t expected[IMBE_FEC_LENGTH_BYTES * LDU_IMBE_FRAMES];
+        uint8_t actual[IMBE_FEC_LENGTH_BYTES * LDU_IMBE_FRAMES];
+        for (uint32_t i = 0U; i < CROSS_CHECK_ITERATIONS; i++) {
+            makeFrame(expected, IMBE_FEC_LENGTH_BYTES, i, referenceRegenerateIMBE);
+            ::memcpy(actual, expected, IMBE_FEC_LENGTH_BYTES);
+
+            uint32_t measured = fec.measureP25BER(actual);
+            uint32_t errs1 = referenceRegenerateIMBE(expected, true);
+            uint32_t errs2 = fec.regenerateIMBE(actual);
+            if (errs1 != errs2 || measured != errs1 || ::memcmp(expected, actual, IMBE_FEC_LENGTH_BYTES) != 0) {
+                ::LogDebug("T", "IMBE_CrossCheck_Test, failed cross-check, errs1 = %u, errs2 = %u, measured = %u", errs1, errs2, measured);
+                Utils::dump(2U, "Expected", expected, IMBE_FEC_LENGTH_BYTES);
+                Utils::dump(2U, "Actual", actual, IMBE_FEC_LENGTH_BYTES);
+                failed = true;
+                break;
+            }
+        }
+
+        // all 9 frames of a LDU in one call
+        for (uint32_t i = 0U; i < (CROSS_CHECK_ITERATIONS / LDU_IMBE_FRAMES) && !failed; i++) {
+            uint32_t errs1 = 0U;
+            for (uint32_t n = 0U; n < LDU_IMBE_FRAMES; n++) {
+                uint8_t* frame = expected + (n * IMBE_FEC_LENGTH_BYTES);
+                makeFrame(frame, IMBE_FEC_LENGTH_BYTES, i + n, referenceRegenerateIMBE);
+            }
+            ::memcpy(actual, expected, IMBE_FEC_LENGTH_BYTES * LDU_IMBE_FRAMES);
+
+            for (uint32_t n = 0U; n < LDU_IMBE_FRAMES; n++)
+                errs1 += referenceRegenerateIMBE(expected + (n * IMBE_FEC_LENGTH_BYTES), true);
+            uint32_t errs2 = fec.regenerateIMBE(actual, LDU_IMBE_FRAMES);
+            if (errs1 != errs2 || ::memcmp(expected, actual, IMBE_FEC_LENGTH_BYTES * LDU_IMBE_FRAMES) != 0) {
+                ::LogDebug("T", "IMBE_CrossCheck_Test, failed LDU cross-check, errs1 = %u, errs2 = %u", errs1, errs2);
+                failed = true;
+            }
+        }
+
+        REQUIRE(failed==false);
+    }
+
+    SECTION("NXDN_CrossCheck_Test") {
+        bool failed = false;
+
+        INFO("AMBEFEC NXDN Regenerate Cross-Check Test");
+
+        srand((unsigned int)time(NULL));
+
+        AMBEFEC fec;
+        uint8_t expected[9U];
+        uint8_t actual[9U];
+        for (uint32_t i = 0U; i < CROSS_CHECK_ITERATIONS; i++) {
+            makeFrame(expected, 9U, i, referenceRegenerateNXDN);
+            ::memcpy(actual, expected, 9U);
+
+            uint32_t measured = fec.measureNXDNBER(actual);
+            uint32_t errs1 = referenceRegenerateNXDN(expected, true);
+            uint32_t errs2 = fec.regenerateNXDN(actual);
+            if (errs1 != errs2 || measured != errs1 || ::memcmp(expected, actual, 9U) != 0) {
+                ::LogDebug("T", "NXDN_CrossCheck_Test, failed cross-check, errs1 = %u, errs2 = %u, measured = %u", errs1, errs2, measured);
+                Utils::dump(2U, "Expected", expected, 9U);
+                Utils::dump(2U, "Actual", actual, 9U);
+                failed = true;
+                break;
+            }
+        }
+
+        REQUIRE(failed==false);
+    }
+}
+
+// the benchmark is hidden; run it explicitly with: dvmtests "[AMBEFEC Benchmark]" -s
+TEST_CASE("AMBEFEC", "[.][AMBEFEC Benchmark]") {
+    SECTION("Regenerate_Benchmark") {
+        INFO("AMBEFEC Regenerate Benchmark");
+
+        srand((unsigned int)time(NULL));
+
+        AMBEFEC fec;
+
+        // frames carry a couple of bit errors, as a marginal RF signal would
+        uint8_t ldu[IMBE_FEC_LENGTH_BYTES * LDU_IMBE_FRAMES];
+        for (uint32_t n = 0U; n < LDU_IMBE_FRAMES; n++)
+            makeFrame(ldu + (n * IMBE_FEC_LENGTH_BYTES), IMBE_FEC_LENGTH_BYTES, 1U, referenceRegenerateIMBE);
+        uint8_t dmr[33U];
+        makeFrame(dmr, 33U, 1U, referenceRegenerateDMR);
+        uint8_t nxdn[9U];
+        makeFrame(nxdn, 9U, 1U, referenceRegenerateNXDN);
+
+        uint8_t work[IMBE_FEC_LENGTH_BYTES * LDU_IMBE_FRAMES];
+        auto run = [&](const char* name, const uint8_t* frame, uint32_t length, uint32_t (*func)(AMBEFEC&, uint8_t*)) {
+            uint32_t sink = 0U;
+            auto start = std::chrono::steady_clock::now();
+            for (uint32_t i = 0U; i < BENCHMARK_ITERATIONS; i++) {
+                ::memcpy(work, frame, length);
+                sink += func(fec, work);
+            }
+            auto end = std::chrono::steady_clock::now();
+
+            g_benchmarkSink = g_benchmarkSink + sink;
+            double ns = std::chrono::duration<double>(end - start).count() * 1000000000.0 / BENCHMARK_ITERATIONS;
+            ::LogMessage("T", "%-32s %8.1f ns/call", name, ns);
+            return ns;
+        };
+
+        double fast = run("IMBE LDU (packed)", ldu, sizeof(ldu), [](AMBEFEC& f, uint8_t* d) { return f.regenerateIMBE(d, LDU_IMBE_FRAMES); });
+        double slow = run("IMBE LDU (bit-by-bit)", ldu, sizeof(ldu), [](AMBEFEC&, uint8_t* d) {
+            uint32_t errs = 0U;
+            for (uint32_t n = 0U; n < LDU_IMBE_FRAMES; n++)
+                errs += referenceRegenerateIMBE(d + (n * IMBE_FEC_LENGTH_BYTES), true);
+            return errs;
+        });
+        ::LogMessage("T", "IMBE LDU speedup: %.1fx", slow / fast);
+
+        fast = run("DMR voice burst (packed)", dmr, sizeof(dmr), [](AMBEFEC& f, uint8_t* d) { return f.regenerateDMR(d); });
+        slow = run("DMR voice burst (bit-by-bit)", dmr, sizeof(dmr), [](AMBEFEC&, uint8_t* d) { return referenceRegenerateDMR(d, true); });
+        ::LogMessage("T", "DMR voice burst speedup: %.1fx", slow / fast);
+
+        fast = run("NXDN AMBE (packed)", nxdn, sizeof(nxdn), [](AMBEFEC& f, uint8_t* d) { return f.regenerateNXDN(d); });
+        slow = run("NXDN AMBE (bit-by-bit)", nxdn, sizeof(nxdn), [](AMBEFEC&, uint8_t* d) { return referenceRegenerateNXDN(d, true); });
+        ::LogMessage("T", "NXDN AMBE speedup: %.1fx", slow / fast);
+
+        REQUIRE(true);
+    }
+}
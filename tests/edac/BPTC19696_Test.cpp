@@ -0,0 +1,490 @@
+/**
+* Digital Voice Modem - Host Software (Test Suite)
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software / Test Suite
+*
+*/
+/*
+*   Copyright (C) 2023 Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#include "Defines.h"
+#include "edac/BPTC19696.h"
+#include "edac/Hamming.h"
+#include "Log.h"
+#include "Utils.h"
+
+using namespace edac;
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t CROSS_CHECK_ITERATIONS = 20000U;
+const uint32_t BENCHMARK_ITERATIONS = 100000U;
+
+const uint32_t BPTC_FRAME_LENGTH_BYTES = 33U;
+
+// working state of the reference bit-by-bit implementation
+static bool g_rawData[196U];
+static bool g_deInterData[196U];
+
+// results are accumulated here so the compiler cannot elide the benchmarked calls
+static volatile uint32_t g_benchmarkSink = 0U;
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+static void referenceDecodeExtractBinary(const uint8_t* in)
+{
+    // First block
+    Utils::byteToBitsBE(in[0U], g_rawData + 0U);
+    Utils::byteToBitsBE(in[1U], g_rawData + 8U);
+    Utils::byteToBitsBE(in[2U], g_rawData + 16U);
+    Utils::byteToBitsBE(in[3U], g_rawData + 24U);
+    Utils::byteToBitsBE(in[4U], g_rawData + 32U);
+    Utils::byteToBitsBE(in[5U], g_rawData + 40U);
+    Utils::byteToBitsBE(in[6U], g_rawData + 48U);
+    Utils::byteToBitsBE(in[7U], g_rawData + 56U);
+    Utils::byteToBitsBE(in[8U], g_rawData + 64U);
+    Utils::byteToBitsBE(in[9U], g_rawData + 72U);
+    Utils::byteToBitsBE(in[10U], g_rawData + 80U);
+    Utils::byteToBitsBE(in[11U], g_rawData + 88U);
+    Utils::byteToBitsBE(in[12U], g_rawData + 96U);
+
+    // Handle the two bits
+    bool bits[8U];
+    Utils::byteToBitsBE(in[20U], bits);
+    g_rawData[98U] = bits[6U];
+    g_rawData[99U] = bits[7U];
+
+    // Second block
+    Utils::byteToBitsBE(in[21U], g_rawData + 100U);
+    Utils::byteToBitsBE(in[22U], g_rawData + 108U);
+    Utils::byteToBitsBE(in[23U], g_rawData + 116U);
+    Utils::byteToBitsBE(in[24U], g_rawData + 124U);
+    Utils::byteToBitsBE(in[25U], g_rawData + 132U);
+    Utils::byteToBitsBE(in[26U], g_rawData + 140U);
+    Utils::byteToBitsBE(in[27U], g_rawData + 148U);
+    Utils::byteToBitsBE(in[28U], g_rawData + 156U);
+    Utils::byteToBitsBE(in[29U], g_rawData + 164U);
+    Utils::byteToBitsBE(in[30U], g_rawData + 172U);
+    Utils::byteToBitsBE(in[31U], g_rawData + 180U);
+    Utils::byteToBitsBE(in[32U], g_rawData + 188U);
+}
+
+static void referenceDecodeDeInterleave()
+{
+    for (uint32_t i = 0U; i < 196U; i++)
+        g_deInterData[i] = false;
+
+    // The first bit is R(3) which is not used so can be ignored
+    for (uint32_t a = 0U; a < 196U; a++) {
+        // Calculate the interleave sequence
+        uint32_t interleaveSequence = (a * 181U) % 196U;
+        // Shuffle the data
+        g_deInterData[a] = g_rawData[interleaveSequence];
+    }
+}
+
+static void referenceDecodeErrorCheck()
+{
+    bool fixing;
+    uint32_t count = 0U;
+    do {
+        fixing = false;
+
+        // Run through each of the 15 columns
+        bool col[13U];
+        for (uint32_t c = 0U; c < 15U; c++) {
+            uint32_t pos = c + 1U;
+            for (uint32_t a = 0U; a < 13U; a++) {
+                col[a] = g_deInterData[pos];
+                pos = pos + 15U;
+            }
+
+            if (Hamming::decode1393(col)) {
+                uint32_t pos = c + 1U;
+                for (uint32_t a = 0U; a < 13U; a++) {
+                    g_deInterData[pos] = col[a];
+                    pos = pos + 15U;
+                }
+
+                fixing = true;
+            }
+        }
+
+        // Run through each of the 9 rows containing data
+        for (uint32_t r = 0U; r < 9U; r++) {
+            uint32_t pos = (r * 15U) + 1U;
+            if (Hamming::decode15113_2(g_deInterData + pos))
+                fixing = true;
+        }
+
+        count++;
+    } while (fixing && count < 5U);
+}
+
+static void referenceDecodeExtractData(uint8_t* data)
+{
+    bool bData[96U];
+    uint32_t pos = 0U;
+    for (uint32_t a = 4U; a <= 11U; a++, pos++)
+        bData[pos] = g_deInterData[a];
+
+    for (uint32_t a = 16U; a <= 26U; a++, pos++)
+        bData[pos] = g_deInterData[a];
+
+    for (uint32_t a = 31U; a <= 41U; a++, pos++)
+        bData[pos] = g_deInterData[a];
+
+    for (uint32_t a = 46U; a <= 56U; a++, pos++)
+        bData[pos] = g_deInterData[a];
+
+    for (uint32_t a = 61U; a <= 71U; a++, pos++)
+        bData[pos] = g_deInterData[a];
+
+    for (uint32_t a = 76U; a <= 86U; a++, pos++)
+        bData[pos] = g_deInterData[a];
+
+    for (uint32_t a = 91U; a <= 101U; a++, pos++)
+        bData[pos] = g_deInterData[a];
+
+    for (uint32_t a = 106U; a <= 116U; a++, pos++)
+        bData[pos] = g_deInterData[a];
+
+    for (uint32_t a = 121U; a <= 131U; a++, pos++)
+        bData[pos] = g_deInterData[a];
+
+    Utils::bitsToByteBE(bData + 0U, data[0U]);
+    Utils::bitsToByteBE(bData + 8U, data[1U]);
+    Utils::bitsToByteBE(bData + 16U, data[2U]);
+    Utils::bitsToByteBE(bData + 24U, data[3U]);
+    Utils::bitsToByteBE(bData + 32U, data[4U]);
+    Utils::bitsToByteBE(bData + 40U, data[5U]);
+    Utils::bitsToByteBE(bData + 48U, data[6U]);
+    Utils::bitsToByteBE(bData + 56U, data[7U]);
+    Utils::bitsToByteBE(bData + 64U, data[8U]);
+    Utils::bitsToByteBE(bData + 72U, data[9U]);
+    Utils::bitsToByteBE(bData + 80U, data[10U]);
+    Utils::bitsToByteBE(bData + 88U, data[11U]);
+}
+
+static void referenceEncodeExtractData(const uint8_t* in)
+{
+    bool bData[96U];
+    Utils::byteToBitsBE(in[0U], bData + 0U);
+    Utils::byteToBitsBE(in[1U], bData + 8U);
+    Utils::byteToBitsBE(in[2U], bData + 16U);
+    Utils::byteToBitsBE(in[3U], bData + 24U);
+    Utils::byteToBitsBE(in[4U], bData + 32U);
+    Utils::byteToBitsBE(in[5U], bData + 40U);
+    Utils::byteToBitsBE(in[6U], bData + 48U);
+    Utils::byteToBitsBE(in[7U], bData + 56U);
+    Utils::byteToBitsBE(in[8U], bData + 64U);
+    Utils::byteToBitsBE(in[9U], bData + 72U);
+    Utils::byteToBitsBE(in[10U], bData + 80U);
+    Utils::byteToBitsBE(in[11U], bData + 88U);
+
+    for (uint32_t i = 0U; i < 196U; i++)
+        g_deInterData[i] = false;
+
+    uint32_t pos = 0U;
+    for (uint32_t a = 4U; a <= 11U; a++, pos++)
+        g_deInterData[a] = bData[pos];
+
+    for (uint32_t a = 16U; a <= 26U; a++, pos++)
+        g_deInterData[a] = bData[pos];
+
+    for (uint32_t a = 31U; a <= 41U; a++, pos++)
+        g_deInterData[a] = bData[pos];
+
+    for (uint32_t a = 46U; a <= 56U; a++, pos++)
+        g_deInterData[a] = bData[pos];
+
+    for (uint32_t a = 61U; a <= 71U; a++, pos++)
+        g_deInterData[a] = bData[pos];
+
+    for (uint32_t a = 76U; a <= 86U; a++, pos++)
+        g_deInterData[a] = bData[pos];
+
+    for (uint32_t a = 91U; a <= 101U; a++, pos++)
+        g_deInterData[a] = bData[pos];
+
+    for (uint32_t a = 106U; a <= 116U; a++, pos++)
+        g_deInterData[a] = bData[pos];
+
+    for (uint32_t a = 121U; a <= 131U; a++, pos++)
+        g_deInterData[a] = bData[pos];
+}
+
+static void referenceEncodeErrorCheck()
+{
+    // Run through each of the 9 rows containing data
+    for (uint32_t r = 0U; r < 9U; r++) {
+        uint32_t pos = (r * 15U) + 1U;
+        Hamming::encode15113_2(g_deInterData + pos);
+    }
+
+    // Run through each of the 15 columns
+    bool col[13U];
+    for (uint32_t c = 0U; c < 15U; c++) {
+        uint32_t pos = c + 1U;
+        for (uint32_t a = 0U; a < 13U; a++) {
+            col[a] = g_deInterData[pos];
+            pos = pos + 15U;
+        }
+
+        Hamming::encode1393(col);
+
+        pos = c + 1U;
+        for (uint32_t a = 0U; a < 13U; a++) {
+            g_deInterData[pos] = col[a];
+            pos = pos + 15U;
+        }
+    }
+}
+
+static void referenceEncodeInterleave()
+{
+    for (uint32_t i = 0U; i < 196U; i++)
+        g_rawData[i] = false;
+
+    // The first bit is R(3) which is not used so can be ignored
+    for (uint32_t a = 0U; a < 196U; a++) {
+        // Calculate the interleave sequence
+        uint32_t interleaveSequence = (a * 181U) % 196U;
+        // Unshuffle the data
+        g_rawData[interleaveSequence] = g_deInterData[a];
+    }
+}
+
+static void referenceEncodeExtractBinary(uint8_t* data)
+{
+    // First block
+    Utils::bitsToByteBE(g_rawData + 0U, data[0U]);
+    Utils::bitsToByteBE(g_rawData + 8U, data[1U]);
+    Utils::bitsToByteBE(g_rawData + 16U, data[2U]);
+    Utils::bitsToByteBE(g_rawData + 24U, data[3U]);
+    Utils::bitsToByteBE(g_rawData + 32U, data[4U]);
+    Utils::bitsToByteBE(g_rawData + 40U, data[5U]);
+    Utils::bitsToByteBE(g_rawData + 48U, data[6U]);
+    Utils::bitsToByteBE(g_rawData + 56U, data[7U]);
+    Utils::bitsToByteBE(g_rawData + 64U, data[8U]);
+    Utils::bitsToByteBE(g_rawData + 72U, data[9U]);
+    Utils::bitsToByteBE(g_rawData + 80U, data[10U]);
+    Utils::bitsToByteBE(g_rawData + 88U, data[11U]);
+
+    // Handle the two bits
+    uint8_t byte;
+    Utils::bitsToByteBE(g_rawData + 96U, byte);
+    data[12U] = (data[12U] & 0x3FU) | ((byte >> 0) & 0xC0U);
+    data[20U] = (data[20U] & 0xFCU) | ((byte >> 4) & 0x03U);
+
+    // Second block
+    Utils::bitsToByteBE(g_rawData + 100U, data[21U]);
+    Utils::bitsToByteBE(g_rawData + 108U, data[22U]);
+    Utils::bitsToByteBE(g_rawData + 116U, data[23U]);
+    Utils::bitsToByteBE(g_rawData + 124U, data[24U]);
+    Utils::bitsToByteBE(g_rawData + 132U, data[25U]);
+    Utils::bitsToByteBE(g_rawData + 140U, data[26U]);
+    Utils::bitsToByteBE(g_rawData + 148U, data[27U]);
+    Utils::bitsToByteBE(g_rawData + 156U, data[28U]);
+    Utils::bitsToByteBE(g_rawData + 164U, data[29U]);
+    Utils::bitsToByteBE(g_rawData + 172U, data[30U]);
+    Utils::bitsToByteBE(g_rawData + 180U, data[31U]);
+    Utils::bitsToByteBE(g_rawData + 188U, data[32U]);
+}
+
+/// <summary>
+/// Reference bit-by-bit BPTC (196,96) decode.
+/// </summary>
+static void referenceDecode(const uint8_t* in, uint8_t* out)
+{
+    referenceDecodeExtractBinary(in);
+    referenceDecodeDeInterleave();
+    referenceDecodeErrorCheck();
+    referenceDecodeExtractData(out);
+}
+
+/// <summary>
+/// Reference bit-by-bit BPTC (196,96) encode.
+/// </summary>
+static void referenceEncode(const uint8_t* in, uint8_t* out)
+{
+    referenceEncodeExtractData(in);
+    referenceEncodeErrorCheck();
+    referenceEncodeInterleave();
+    referenceEncodeExtractBinary(out);
+}
+
+/// <summary>
+/// Fills a buffer with random data.
+/// </summary>
+static void fillRandom(uint8_t* buffer, uint32_t length)
+{
+    for (uint32_t i = 0U; i < length; i++)
+        buffer[i] = (uint8_t)rand();
+}
+
+/// <summary>
+/// Prepares a test frame; either random data, or an encoded frame with a few bit errors.
+/// </summary>
+static void makeFrame(uint8_t* frame, uint32_t iteration)
+{
+    fillRandom(frame, BPTC_FRAME_LENGTH_BYTES);
+    if ((iteration & 1U) == 0U)
+        return;
+
+    uint8_t data[12U];
+    fillRandom(data, 12U);
+    referenceEncode(data, frame);
+
+    uint32_t errors = rand() % 8;
+    for (uint32_t i = 0U; i < errors; i++) {
+        // only flip bits which carry the BPTC codeword
+        uint32_t n = rand() % 196U;
+        if (n < 98U)
+            frame[n >> 3] ^= BIT_MASK_TABLE[n & 7U];
+        else if (n < 100U)
+            frame[20U] ^= BIT_MASK_TABLE[n - 92U];
+        else
+            frame[21U + ((n - 100U) >> 3)] ^= BIT_MASK_TABLE[(n - 100U) & 7U];
+    }
+}
+
+TEST_CASE("BPTC19696", "[BPTC 196,96 Test]") {
+    SECTION("Decode_CrossCheck_Test") {
+        bool failed = false;
+
+        INFO("BPTC 196,96 Decode Cross-Check Test");
+
+        srand((unsigned int)time(NULL));
+
+        BPTC19696 bptc;
+        for (uint32_t n = 0U; n < CROSS_CHECK_ITERATIONS; n++) {
+            uint8_t frame[BPTC_FRAME_LENGTH_BYTES];
+            makeFrame(frame, n);
+
+            uint8_t expected[12U], actual[12U];
+            referenceDecode(frame, expected);
+            bptc.decode(frame, actual);
+            if (::memcmp(expected, actual, 12U) != 0) {
+                Utils::dump(2U, "BPTC19696 Frame", frame, BPTC_FRAME_LENGTH_BYTES);
+                Utils::dump(2U, "BPTC19696 Expected", expected, 12U);
+                Utils::dump(2U, "BPTC19696 Actual", actual, 12U);
+                failed = true;
+                break;
+            }
+        }
+
+        REQUIRE(failed==false);
+    }
+
+    SECTION("Encode_CrossCheck_Test") {
+        bool failed = false;
+
+        INFO("BPTC 196,96 Encode Cross-Check Test");
+
+        srand((unsigned int)time(NULL));
+
+        BPTC19696 bptc;
+        for (uint32_t n = 0U; n < CROSS_CHECK_ITERATIONS; n++) {
+            uint8_t data[12U];
+            fillRandom(data, 12U);
+
+            // the bytes around the two bits must be preserved
+            uint8_t expected[BPTC_FRAME_LENGTH_BYTES], actual[BPTC_FRAME_LENGTH_BYTES];
+            fillRandom(expected, BPTC_FRAME_LENGTH_BYTES);
+            ::memcpy(actual, expected, BPTC_FRAME_LENGTH_BYTES);
+
+            referenceEncode(data, expected);
+            bptc.encode(data, actual);
+            if (::memcmp(expected, actual, BPTC_FRAME_LENGTH_BYTES) != 0) {
+                Utils::dump(2U, "BPTC19696 Data", data, 12U);
+                Utils::dump(2U, "BPTC19696 Expected", expected, BPTC_FRAME_LENGTH_BYTES);
+                Utils::dump(2U, "BPTC19696 Actual", actual, BPTC_FRAME_LENGTH_BYTES);
+                failed = true;
+                break;
+            }
+
+            uint8_t decoded[12U];
+            bptc.decode(actual, decoded);
+            if (::memcmp(data, decoded, 12U) != 0) {
+                Utils::dump(2U, "BPTC19696 Data", data, 12U);
+                Utils::dump(2U, "BPTC19696 Decoded", decoded, 12U);
+                failed = true;
+                break;
+            }
+        }
+
+        REQUIRE(failed==false);
+    }
+}
+
+// the benchmark is hidden; run it explicitly with: dvmtests "[BPTC Benchmark]" -s
+TEST_CASE("BPTC19696", "[.][BPTC Benchmark]") {
+    SECTION("Decode_Benchmark") {
+        INFO("BPTC 196,96 Decode Benchmark");
+
+        srand((unsigned int)time(NULL));
+
+        BPTC19696 bptc;
+
+        // the frame carries a few bit errors, as a marginal RF signal would
+        uint8_t frame[BPTC_FRAME_LENGTH_BYTES];
+        makeFrame(frame, 1U);
+
+        auto run = [&](const char* name, void (*func)(BPTC19696&, const uint8_t*, uint8_t*)) {
+            uint32_t sink = 0U;
+            uint8_t out[BPTC_FRAME_LENGTH_BYTES];
+            auto start = std::chrono::steady_clock::now();
+            for (uint32_t i = 0U; i < BENCHMARK_ITERATIONS; i++) {
+                func(bptc, frame, out);
+                sink += out[i % 12U];
+            }
+            auto end = std::chrono::steady_clock::now();
+
+            g_benchmarkSink = g_benchmarkSink + sink;
+            double ns = std::chrono::duration<double>(end - start).count() * 1000000000.0 / BENCHMARK_ITERATIONS;
+            ::LogMessage("T", "%-32s %8.1f ns/call", name, ns);
+            return ns;
+        };
+
+        double fast = run("BPTC decode (packed)", [](BPTC19696& b, const uint8_t* in, uint8_t* out) { b.decode(in, out); });
+        double slow = run("BPTC decode (bit-by-bit)", [](BPTC19696&, const uint8_t* in, uint8_t* out) { referenceDecode(in, out); });
+        ::LogMessage("T", "BPTC decode speedup: %.1fx", slow / fast);
+
+        uint8_t data[12U];
+        fillRandom(data, 12U);
+        ::memcpy(frame, data, 12U);
+
+        fast = run("BPTC encode (packed)", [](BPTC19696& b, const uint8_t* in, uint8_t* out) { b.encode(in, out); });
+        slow = run("BPTC encode (bit-by-bit)", [](BPTC19696&, const uint8_t* in, uint8_t* out) { referenceEncode(in, out); });
+        ::LogMessage("T", "BPTC encode speedup: %.1fx", slow / fast);
+
+        REQUIRE(true);
+    }
+}
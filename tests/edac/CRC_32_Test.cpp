@@ -34,6 +34,23 @@ using namespace edac;
 #include <stdlib.h>
 #include <time.h>
 
+/// <summary>
+/// Reference bit-by-bit 32-bit CRC (polynomial 0x04C11DB7) used to cross-check the table-driven
+/// and accelerated implementations.
+/// </summary>
+static uint32_t referenceCRC32(const uint8_t* in, uint32_t length)
+{
+    uint32_t crc = 0U;
+
+    for (uint32_t i = 0U; i < length; i++) {
+        crc ^= uint32_t(in[i]) << 24;
+        for (uint32_t j = 0U; j < 8U; j++)
+            crc = (crc & 0x80000000U) ? ((crc << 1) ^ 0x04C11DB7U) : (crc << 1);
+    }
+
+    return ~crc;
+}
+
 TEST_CASE("CRC", "[32-bit Test]") {
     SECTION("32_Sanity_Test") {
         bool failed = false;
@@ -77,4 +94,42 @@ cleanup:
         delete random;
         REQUIRE(failed==false);
     }
+
+    SECTION("32_CrossCheck_Test") {
+        bool failed = false;
+
+        INFO("CRC 32-bit CRC Cross-Check Test");
+        INFO("CRC-32 engine: " << CRC::getCRC32EngineName());
+
+        srand((unsigned int)time(NULL));
+
+        // long enough to run every folding and tail path of the accelerated implementations
+        const uint32_t len = 600U;
+        uint8_t* random = (uint8_t*)malloc(len);
+
+        for (uint32_t length = 5U; length <= len; length++) {
+            for (size_t i = 0; i < len; i++) {
+                random[i] = rand();
+            }
+
+            uint32_t expected = referenceCRC32(random, length - 4U);
+            CRC::addCRC32(random, length);
+
+            uint32_t crc = (random[length - 4U] << 24) | (random[length - 3U] << 16) | (random[length - 2U] << 8) | (random[length - 1U] << 0);
+            if (crc != expected) {
+                ::LogDebug("T", "32_CrossCheck_Test, failed CRC32 cross-check, len = %u, crc = $%08X, expected = $%08X", length, crc, expected);
+                failed = true;
+                break;
+            }
+
+            if (!CRC::checkCRC32(random, length)) {
+                ::LogDebug("T", "32_CrossCheck_Test, failed CRC32 check, len = %u", length);
+                failed = true;
+                break;
+            }
+        }
+
+        free(random);
+        REQUIRE(failed==false);
+    }
 }
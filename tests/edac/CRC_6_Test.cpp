@@ -34,6 +34,26 @@ using namespace edac;
 #include <stdlib.h>
 #include <time.h>
 
+/// <summary>
+/// Reference bit-by-bit 6-bit CRC used to cross-check the table-driven implementation.
+/// </summary>
+static uint8_t referenceCRC6(const uint8_t* in, uint32_t bitLength)
+{
+    uint8_t crc = 0x3FU;
+
+    for (uint32_t i = 0U; i < bitLength; i++) {
+        bool bit1 = READ_BIT(in, i) != 0x00U;
+        bool bit2 = (crc & 0x20U) == 0x20U;
+
+        crc <<= 1;
+
+        if (bit1 ^ bit2)
+            crc ^= 0x27U;
+    }
+
+    return crc & 0x3FU;
+}
+
 TEST_CASE("CRC", "[6-bit Test]") {
     SECTION("6_Sanity_Test") {
         bool failed = false;
@@ -78,4 +98,39 @@ cleanup:
         delete random;
         REQUIRE(failed==false);
     }
+
+    SECTION("6_CrossCheck_Test") {
+        bool failed = false;
+
+        INFO("CRC 6-bit CRC Cross-Check Test");
+
+        srand((unsigned int)time(NULL));
+
+        const uint32_t len = 32U;
+        uint8_t* random = (uint8_t*)malloc(len);
+
+        // cover whole-byte and partial-byte lengths
+        for (uint32_t bitLength = 1U; bitLength <= (len - 3U) * 8U; bitLength++) {
+            for (size_t i = 0; i < len; i++) {
+                random[i] = rand();
+            }
+
+            uint8_t expected = referenceCRC6(random, bitLength);
+            uint8_t crc = CRC::addCRC6(random, bitLength);
+            if (crc != expected) {
+                ::LogDebug("T", "6_CrossCheck_Test, failed CRC6 cross-check, bitlen = %u, crc = $%04X, expected = $%04X", bitLength, crc, expected);
+                failed = true;
+                break;
+            }
+
+            if (!CRC::checkCRC6(random, bitLength)) {
+                ::LogDebug("T", "6_CrossCheck_Test, failed CRC6 check, bitlen = %u", bitLength);
+                failed = true;
+                break;
+            }
+        }
+
+        free(random);
+        REQUIRE(failed==false);
+    }
 }
@@ -34,6 +34,22 @@ using namespace edac;
 #include <stdlib.h>
 #include <time.h>
 
+/// <summary>
+/// Reference bit-by-bit 8-bit CRC (polynomial 0x07) used to cross-check the table-driven implementation.
+/// </summary>
+static uint8_t referenceCRC8(const uint8_t* in, uint32_t length)
+{
+    uint8_t crc = 0U;
+
+    for (uint32_t i = 0U; i < length; i++) {
+        crc ^= in[i];
+        for (uint32_t j = 0U; j < 8U; j++)
+            crc = (crc & 0x80U) ? uint8_t((crc << 1) ^ 0x07U) : uint8_t(crc << 1);
+    }
+
+    return crc;
+}
+
 TEST_CASE("CRC", "[8-bit Test]") {
     SECTION("8_Sanity_Test") {
         bool failed = false;
@@ -69,4 +85,32 @@ cleanup:
         delete random;
         REQUIRE(failed==false);
     }
+
+    SECTION("8_CrossCheck_Test") {
+        bool failed = false;
+
+        INFO("CRC 8-bit CRC Cross-Check Test");
+
+        srand((unsigned int)time(NULL));
+
+        const uint32_t len = 64U;
+        uint8_t* random = (uint8_t*)malloc(len);
+
+        for (uint32_t length = 1U; length <= len; length++) {
+            for (size_t i = 0; i < len; i++) {
+                random[i] = rand();
+            }
+
+            uint8_t expected = referenceCRC8(random, length);
+            uint8_t crc = CRC::crc8(random, length);
+            if (crc != expected) {
+                ::LogDebug("T", "8_CrossCheck_Test, failed CRC8 cross-check, len = %u, crc = $%02X, expected = $%02X", length, crc, expected);
+                failed = true;
+                break;
+            }
+        }
+
+        free(random);
+        REQUIRE(failed==false);
+    }
 }
@@ -34,6 +34,17 @@ using namespace edac;
 #include <stdlib.h>
 #include <time.h>
 
+/// <summary>
+/// Fills a buffer with a repeatable pseudo-random sequence.
+/// </summary>
+static void fillSequence(uint8_t* buffer, uint32_t length, uint32_t seed)
+{
+    for (uint32_t i = 0U; i < length; i++) {
+        seed = seed * 1103515245U + 12345U;
+        buffer[i] = (uint8_t)(seed >> 16);
+    }
+}
+
 TEST_CASE("CRC", "[9-bit Test]") {
     SECTION("9_Sanity_Test") {
         bool failed = false;
@@ -74,4 +85,36 @@ cleanup:
         delete random;
         REQUIRE(failed==false);
     }
+
+    SECTION("9_CrossCheck_Test") {
+        bool failed = false;
+
+        INFO("CRC 9-bit CRC Cross-Check Test");
+
+        // expected values were generated by the original bit-by-bit implementation
+        const uint32_t vectors[][3U] = {
+            { 1U, 144U, 0x13DU },
+            { 2U, 144U, 0x036U },
+            { 3U, 144U, 0x025U },
+            { 4U, 144U, 0x177U },
+            { 5U, 135U, 0x19CU },
+            { 6U, 100U, 0x11CU },
+            { 7U, 23U, 0x0FDU },
+            { 8U, 7U, 0x127U }
+        };
+
+        uint8_t buffer[18U];
+        for (uint32_t i = 0U; i < 8U; i++) {
+            fillSequence(buffer, 18U, vectors[i][0U]);
+
+            uint16_t crc = edac::CRC::crc9(buffer, vectors[i][1U]);
+            if (crc != vectors[i][2U]) {
+                ::LogDebug("T", "9_CrossCheck_Test, failed CRC9 cross-check, bitlen = %u, crc = $%03X, expected = $%03X", vectors[i][1U], crc, vectors[i][2U]);
+                failed = true;
+                break;
+            }
+        }
+
+        REQUIRE(failed==false);
+    }
 }
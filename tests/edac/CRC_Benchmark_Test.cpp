@@ -0,0 +1,125 @@
+/**
+* Digital Voice Modem - Host Software (Test Suite)
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software / Test Suite
+*
+*/
+/*
+*   Copyright (C) 2023 Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#include "Defines.h"
+#include "edac/CRC.h"
+#include "Log.h"
+#include "Utils.h"
+
+using namespace edac;
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <stdlib.h>
+#include <time.h>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t BENCHMARK_ITERATIONS = 200000U;
+
+// results are accumulated here so the compiler cannot elide the benchmarked calls
+static volatile uint32_t g_benchmarkSink = 0U;
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Reference bit-by-bit 32-bit CRC (polynomial 0x04C11DB7) used as the throughput baseline.
+/// </summary>
+static uint32_t referenceCRC32(const uint8_t* in, uint32_t length)
+{
+    uint32_t crc = 0U;
+
+    for (uint32_t i = 0U; i < length; i++) {
+        crc ^= uint32_t(in[i]) << 24;
+        for (uint32_t j = 0U; j < 8U; j++)
+            crc = (crc & 0x80000000U) ? ((crc << 1) ^ 0x04C11DB7U) : (crc << 1);
+    }
+
+    return ~crc;
+}
+
+/// <summary>
+/// Runs the given CRC routine repeatedly over a buffer and logs its throughput.
+/// </summary>
+/// <param name="name">Name of the CRC routine.</param>
+/// <param name="length">Length of the buffer in bytes.</param>
+/// <param name="func">CRC routine; returns a value derived from the CRC.</param>
+/// <returns>Throughput in MB/s.</returns>
+template <typename F>
+static double benchmark(const char* name, uint32_t length, F func)
+{
+    uint32_t sink = 0U;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0U; i < BENCHMARK_ITERATIONS; i++)
+        sink += func();
+    auto end = std::chrono::steady_clock::now();
+    g_benchmarkSink = g_benchmarkSink + sink;
+
+    double secs = std::chrono::duration<double>(end - start).count();
+    double mbps = ((double)length * BENCHMARK_ITERATIONS) / (secs * 1000000.0);
+    double nsPerCall = (secs * 1000000000.0) / BENCHMARK_ITERATIONS;
+
+    ::LogMessage("T", "%-24s %4u bytes, %8.1f ns/call, %8.1f MB/s", name, length, nsPerCall, mbps);
+    return mbps;
+}
+
+// the benchmark is hidden; run it explicitly with: dvmtests "[CRC Benchmark]" -s
+TEST_CASE("CRC", "[.][CRC Benchmark]") {
+    SECTION("Throughput_Benchmark") {
+        INFO("CRC Throughput Benchmark");
+        ::LogMessage("T", "CRC-32 engine: %s", CRC::getCRC32EngineName());
+
+        srand((unsigned int)time(NULL));
+
+        const uint32_t len = 516U;
+        uint8_t* random = (uint8_t*)malloc(len);
+        for (size_t i = 0; i < len; i++) {
+            random[i] = rand();
+        }
+
+        // lengths are representative of the frames each CRC protects (TSBK/CSBK, PDU blocks, PDU user data)
+        benchmark("CCITT-162", 12U, [&]() { CRC::addCCITT162(random, 12U); return (uint32_t)random[11U]; });
+        benchmark("CCITT-161", 12U, [&]() { CRC::addCCITT161(random, 12U); return (uint32_t)random[11U]; });
+        benchmark("CRC-8", 12U, [&]() { return (uint32_t)CRC::crc8(random, 12U); });
+        benchmark("CRC-9", 18U, [&]() { return (uint32_t)CRC::crc9(random, 144U); });
+        benchmark("CRC-6", 10U, [&]() { return (uint32_t)CRC::addCRC6(random, 80U); });
+        benchmark("CRC-12", 12U, [&]() { return (uint32_t)CRC::addCRC12(random, 96U); });
+        benchmark("CRC-15", 12U, [&]() { return (uint32_t)CRC::addCRC15(random, 96U); });
+        benchmark("CRC-16", 12U, [&]() { return (uint32_t)CRC::addCRC16(random, 96U); });
+
+        for (uint32_t length : { 16U, 64U, 128U, 516U }) {
+            double fast = benchmark("CRC-32", length, [&]() { CRC::addCRC32(random, length); return (uint32_t)random[length - 1U]; });
+            double slow = benchmark("CRC-32 (bit-by-bit)", length, [&]() { return referenceCRC32(random, length - 4U); });
+            ::LogMessage("T", "CRC-32 speedup at %u bytes: %.1fx", length, fast / slow);
+        }
+
+        free(random);
+        REQUIRE(true);
+    }
+}
@@ -34,6 +34,22 @@ using namespace edac;
 #include <stdlib.h>
 #include <time.h>
 
+/// <summary>
+/// Reference bit-by-bit CCITT-161 (reflected polynomial 0x8408) used to cross-check the table-driven implementation.
+/// </summary>
+static uint16_t referenceCCITT161(const uint8_t* in, uint32_t length)
+{
+    uint16_t crc = 0xFFFFU;
+
+    for (uint32_t i = 0U; i < length; i++) {
+        crc ^= in[i];
+        for (uint32_t j = 0U; j < 8U; j++)
+            crc = (crc & 0x0001U) ? uint16_t((crc >> 1) ^ 0x8408U) : uint16_t(crc >> 1);
+    }
+
+    return ~crc;
+}
+
 TEST_CASE("CRC", "[16-bit CCITT-161 Test]") {
     SECTION("CCITT-161_Sanity_Test") {
         bool failed = false;
@@ -77,4 +93,40 @@ cleanup:
         delete random;
         REQUIRE(failed==false);
     }
+
+    SECTION("CCITT_161_CrossCheck_Test") {
+        bool failed = false;
+
+        INFO("CRC CCITT-161 CRC Cross-Check Test");
+
+        srand((unsigned int)time(NULL));
+
+        const uint32_t len = 64U;
+        uint8_t* random = (uint8_t*)malloc(len);
+
+        for (uint32_t length = 3U; length <= len; length++) {
+            for (size_t i = 0; i < len; i++) {
+                random[i] = rand();
+            }
+
+            uint16_t expected = referenceCCITT161(random, length - 2U);
+            CRC::addCCITT161(random, length);
+
+            uint16_t crc = (random[length - 1U] << 8) | (random[length - 2U] << 0);
+            if (crc != expected) {
+                ::LogDebug("T", "CCITT_161_CrossCheck_Test, failed CCITT-161 cross-check, len = %u, crc = $%04X, expected = $%04X", length, crc, expected);
+                failed = true;
+                break;
+            }
+
+            if (!CRC::checkCCITT161(random, length)) {
+                ::LogDebug("T", "CCITT_161_CrossCheck_Test, failed CCITT-161 check, len = %u", length);
+                failed = true;
+                break;
+            }
+        }
+
+        free(random);
+        REQUIRE(failed==false);
+    }
 }
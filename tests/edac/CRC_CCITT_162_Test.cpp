@@ -34,6 +34,22 @@ using namespace edac;
 #include <stdlib.h>
 #include <time.h>
 
+/// <summary>
+/// Reference bit-by-bit CCITT-162 (polynomial 0x1021) used to cross-check the table-driven implementation.
+/// </summary>
+static uint16_t referenceCCITT162(const uint8_t* in, uint32_t length)
+{
+    uint16_t crc = 0U;
+
+    for (uint32_t i = 0U; i < length; i++) {
+        crc ^= uint16_t(in[i] << 8);
+        for (uint32_t j = 0U; j < 8U; j++)
+            crc = (crc & 0x8000U) ? uint16_t((crc << 1) ^ 0x1021U) : uint16_t(crc << 1);
+    }
+
+    return ~crc;
+}
+
 TEST_CASE("CRC", "[16-bit CCITT-162 Test]") {
     SECTION("CCITT-162_Sanity_Test") {
         bool failed = false;
@@ -77,4 +93,40 @@ cleanup:
         delete random;
         REQUIRE(failed==false);
     }
+
+    SECTION("CCITT_162_CrossCheck_Test") {
+        bool failed = false;
+
+        INFO("CRC CCITT-162 CRC Cross-Check Test");
+
+        srand((unsigned int)time(NULL));
+
+        const uint32_t len = 64U;
+        uint8_t* random = (uint8_t*)malloc(len);
+
+        for (uint32_t length = 3U; length <= len; length++) {
+            for (size_t i = 0; i < len; i++) {
+                random[i] = rand();
+            }
+
+            uint16_t expected = referenceCCITT162(random, length - 2U);
+            CRC::addCCITT162(random, length);
+
+            uint16_t crc = (random[length - 2U] << 8) | (random[length - 1U] << 0);
+            if (crc != expected) {
+                ::LogDebug("T", "CCITT_162_CrossCheck_Test, failed CCITT-162 cross-check, len = %u, crc = $%04X, expected = $%04X", length, crc, expected);
+                failed = true;
+                break;
+            }
+
+            if (!CRC::checkCCITT162(random, length)) {
+                ::LogDebug("T", "CCITT_162_CrossCheck_Test, failed CCITT-162 check, len = %u", length);
+                failed = true;
+                break;
+            }
+        }
+
+        free(random);
+        REQUIRE(failed==false);
+    }
 }
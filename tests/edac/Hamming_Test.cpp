@@ -0,0 +1,531 @@
+/**
+* Digital Voice Modem - Host Software (Test Suite)
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software / Test Suite
+*
+*/
+/*
+*   Copyright (C) 2023 Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#include "Defines.h"
+#include "edac/Hamming.h"
+#include "Log.h"
+
+using namespace edac;
+
+#include <catch2/catch_test_macros.hpp>
+#include <cassert>
+#include <chrono>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t BENCHMARK_ITERATIONS = 1000000U;
+
+// results are accumulated here so the compiler cannot elide the benchmarked calls
+static volatile uint32_t g_benchmarkSink = 0U;
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Reference bit-by-bit decode Hamming (15,11,3).
+/// </summary>
+static bool referenceDecode15113_1(bool* d)
+{
+    assert(d != nullptr);
+
+    // Calculate the parity it should have
+    bool c0 = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[6];
+    bool c1 = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[7] ^ d[8] ^ d[9];
+    bool c2 = d[0] ^ d[1] ^ d[4] ^ d[5] ^ d[7] ^ d[8] ^ d[10];
+    bool c3 = d[0] ^ d[2] ^ d[4] ^ d[6] ^ d[7] ^ d[9] ^ d[10];
+
+    unsigned char n = 0U;
+    n |= (c0 != d[11]) ? 0x01U : 0x00U;
+    n |= (c1 != d[12]) ? 0x02U : 0x00U;
+    n |= (c2 != d[13]) ? 0x04U : 0x00U;
+    n |= (c3 != d[14]) ? 0x08U : 0x00U;
+
+    switch (n) {
+        // Parity bit errors
+        case 0x01U: d[11] = !d[11]; return true;
+        case 0x02U: d[12] = !d[12]; return true;
+        case 0x04U: d[13] = !d[13]; return true;
+        case 0x08U: d[14] = !d[14]; return true;
+
+        // Data bit errors
+        case 0x0FU: d[0] = !d[0];  return true;
+        case 0x07U: d[1] = !d[1];  return true;
+        case 0x0BU: d[2] = !d[2];  return true;
+        case 0x03U: d[3] = !d[3];  return true;
+        case 0x0DU: d[4] = !d[4];  return true;
+        case 0x05U: d[5] = !d[5];  return true;
+        case 0x09U: d[6] = !d[6];  return true;
+        case 0x0EU: d[7] = !d[7];  return true;
+        case 0x06U: d[8] = !d[8];  return true;
+        case 0x0AU: d[9] = !d[9];  return true;
+        case 0x0CU: d[10] = !d[10]; return true;
+
+        // No bit errors
+        default: return false;
+    }
+}
+
+/// <summary>
+/// Reference bit-by-bit encode Hamming (15,11,3).
+/// </summary>
+static void referenceEncode15113_1(bool* d)
+{
+    assert(d != nullptr);
+
+    // Calculate the checksum this row should have
+    d[11] = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[6];
+    d[12] = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[7] ^ d[8] ^ d[9];
+    d[13] = d[0] ^ d[1] ^ d[4] ^ d[5] ^ d[7] ^ d[8] ^ d[10];
+    d[14] = d[0] ^ d[2] ^ d[4] ^ d[6] ^ d[7] ^ d[9] ^ d[10];
+}
+
+/// <summary>
+/// Reference bit-by-bit decode Hamming (15,11,3).
+/// </summary>
+static bool referenceDecode15113_2(bool* d)
+{
+    assert(d != nullptr);
+
+    // Calculate the checksum this row should have
+    bool c0 = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[5] ^ d[7] ^ d[8];
+    bool c1 = d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[6] ^ d[8] ^ d[9];
+    bool c2 = d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[7] ^ d[9] ^ d[10];
+    bool c3 = d[0] ^ d[1] ^ d[2] ^ d[4] ^ d[6] ^ d[7] ^ d[10];
+
+    unsigned char n = 0x00U;
+    n |= (c0 != d[11]) ? 0x01U : 0x00U;
+    n |= (c1 != d[12]) ? 0x02U : 0x00U;
+    n |= (c2 != d[13]) ? 0x04U : 0x00U;
+    n |= (c3 != d[14]) ? 0x08U : 0x00U;
+
+    switch (n) {
+        // Parity bit errors
+        case 0x01U: d[11] = !d[11]; return true;
+        case 0x02U: d[12] = !d[12]; return true;
+        case 0x04U: d[13] = !d[13]; return true;
+        case 0x08U: d[14] = !d[14]; return true;
+
+        // Data bit errors
+        case 0x09U: d[0] = !d[0];  return true;
+        case 0x0BU: d[1] = !d[1];  return true;
+        case 0x0FU: d[2] = !d[2];  return true;
+        case 0x07U: d[3] = !d[3];  return true;
+        case 0x0EU: d[4] = !d[4];  return true;
+        case 0x05U: d[5] = !d[5];  return true;
+        case 0x0AU: d[6] = !d[6];  return true;
+        case 0x0DU: d[7] = !d[7];  return true;
+        case 0x03U: d[8] = !d[8];  return true;
+        case 0x06U: d[9] = !d[9];  return true;
+        case 0x0CU: d[10] = !d[10]; return true;
+
+        // No bit errors
+        default: return false;
+    }
+}
+
+/// <summary>
+/// Reference bit-by-bit encode Hamming (15,11,3).
+/// </summary>
+static void referenceEncode15113_2(bool* d)
+{
+    assert(d != nullptr);
+
+    // Calculate the checksum this row should have
+    d[11] = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[5] ^ d[7] ^ d[8];
+    d[12] = d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[6] ^ d[8] ^ d[9];
+    d[13] = d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[7] ^ d[9] ^ d[10];
+    d[14] = d[0] ^ d[1] ^ d[2] ^ d[4] ^ d[6] ^ d[7] ^ d[10];
+}
+
+/// <summary>
+/// Reference bit-by-bit decode Hamming (13,9,3).
+/// </summary>
+static bool referenceDecode1393(bool* d)
+{
+    assert(d != nullptr);
+
+    // Calculate the checksum this column should have
+    bool c0 = d[0] ^ d[1] ^ d[3] ^ d[5] ^ d[6];
+    bool c1 = d[0] ^ d[1] ^ d[2] ^ d[4] ^ d[6] ^ d[7];
+    bool c2 = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[5] ^ d[7] ^ d[8];
+    bool c3 = d[0] ^ d[2] ^ d[4] ^ d[5] ^ d[8];
+
+    unsigned char n = 0x00U;
+    n |= (c0 != d[9]) ? 0x01U : 0x00U;
+    n |= (c1 != d[10]) ? 0x02U : 0x00U;
+    n |= (c2 != d[11]) ? 0x04U : 0x00U;
+    n |= (c3 != d[12]) ? 0x08U : 0x00U;
+
+    switch (n) {
+        // Parity bit errors
+        case 0x01U: d[9] = !d[9];  return true;
+        case 0x02U: d[10] = !d[10]; return true;
+        case 0x04U: d[11] = !d[11]; return true;
+        case 0x08U: d[12] = !d[12]; return true;
+
+        // Data bit erros
+        case 0x0FU: d[0] = !d[0]; return true;
+        case 0x07U: d[1] = !d[1]; return true;
+        case 0x0EU: d[2] = !d[2]; return true;
+        case 0x05U: d[3] = !d[3]; return true;
+        case 0x0AU: d[4] = !d[4]; return true;
+        case 0x0DU: d[5] = !d[5]; return true;
+        case 0x03U: d[6] = !d[6]; return true;
+        case 0x06U: d[7] = !d[7]; return true;
+        case 0x0CU: d[8] = !d[8]; return true;
+
+        // No bit errors
+        default: return false;
+    }
+}
+
+/// <summary>
+/// Reference bit-by-bit encode Hamming (13,9,3).
+/// </summary>
+static void referenceEncode1393(bool* d)
+{
+    assert(d != nullptr);
+
+    // Calculate the checksum this column should have
+    d[9] = d[0] ^ d[1] ^ d[3] ^ d[5] ^ d[6];
+    d[10] = d[0] ^ d[1] ^ d[2] ^ d[4] ^ d[6] ^ d[7];
+    d[11] = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[5] ^ d[7] ^ d[8];
+    d[12] = d[0] ^ d[2] ^ d[4] ^ d[5] ^ d[8];
+}
+
+/// <summary>
+/// Reference bit-by-bit decode Hamming (10,6,3).
+/// </summary>
+static bool referenceDecode1063(bool* d)
+{
+    assert(d != nullptr);
+
+    // Calculate the checksum this column should have
+    bool c0 = d[0] ^ d[1] ^ d[2] ^ d[5];
+    bool c1 = d[0] ^ d[1] ^ d[3] ^ d[5];
+    bool c2 = d[0] ^ d[2] ^ d[3] ^ d[4];
+    bool c3 = d[1] ^ d[2] ^ d[3] ^ d[4];
+
+    unsigned char n = 0x00U;
+    n |= (c0 != d[6]) ? 0x01U : 0x00U;
+    n |= (c1 != d[7]) ? 0x02U : 0x00U;
+    n |= (c2 != d[8]) ? 0x04U : 0x00U;
+    n |= (c3 != d[9]) ? 0x08U : 0x00U;
+
+    switch (n) {
+        // Parity bit errors
+        case 0x01U: d[6] = !d[6]; return true;
+        case 0x02U: d[7] = !d[7]; return true;
+        case 0x04U: d[8] = !d[8]; return true;
+        case 0x08U: d[9] = !d[9]; return true;
+
+        // Data bit erros
+        case 0x07U: d[0] = !d[0]; return true;
+        case 0x0BU: d[1] = !d[1]; return true;
+        case 0x0DU: d[2] = !d[2]; return true;
+        case 0x0EU: d[3] = !d[3]; return true;
+        case 0x0CU: d[4] = !d[4]; return true;
+        case 0x03U: d[5] = !d[5]; return true;
+
+        // No bit errors
+        default: return false;
+    }
+}
+
+/// <summary>
+/// Reference bit-by-bit encode Hamming (10,6,3).
+/// </summary>
+static void referenceEncode1063(bool* d)
+{
+    assert(d != nullptr);
+
+    // Calculate the checksum this column should have
+    d[6] = d[0] ^ d[1] ^ d[2] ^ d[5];
+    d[7] = d[0] ^ d[1] ^ d[3] ^ d[5];
+    d[8] = d[0] ^ d[2] ^ d[3] ^ d[4];
+    d[9] = d[1] ^ d[2] ^ d[3] ^ d[4];
+}
+
+/// <summary>
+/// Reference bit-by-bit decode Hamming (16,11,4).
+/// </summary>
+static bool referenceDecode16114(bool* d)
+{
+    assert(d != nullptr);
+
+    // Calculate the checksum this column should have
+    bool c0 = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[5] ^ d[7] ^ d[8];
+    bool c1 = d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[6] ^ d[8] ^ d[9];
+    bool c2 = d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[7] ^ d[9] ^ d[10];
+    bool c3 = d[0] ^ d[1] ^ d[2] ^ d[4] ^ d[6] ^ d[7] ^ d[10];
+    bool c4 = d[0] ^ d[2] ^ d[5] ^ d[6] ^ d[8] ^ d[9] ^ d[10];
+
+    // Compare these with the actual bits
+    unsigned char n = 0x00U;
+    n |= (c0 != d[11]) ? 0x01U : 0x00U;
+    n |= (c1 != d[12]) ? 0x02U : 0x00U;
+    n |= (c2 != d[13]) ? 0x04U : 0x00U;
+    n |= (c3 != d[14]) ? 0x08U : 0x00U;
+    n |= (c4 != d[15]) ? 0x10U : 0x00U;
+
+    switch (n) {
+        // Parity bit errors
+        case 0x01U: d[11] = !d[11]; return true;
+        case 0x02U: d[12] = !d[12]; return true;
+        case 0x04U: d[13] = !d[13]; return true;
+        case 0x08U: d[14] = !d[14]; return true;
+        case 0x10U: d[15] = !d[15]; return true;
+
+        // Data bit errors
+        case 0x19U: d[0] = !d[0];  return true;
+        case 0x0BU: d[1] = !d[1];  return true;
+        case 0x1FU: d[2] = !d[2];  return true;
+        case 0x07U: d[3] = !d[3];  return true;
+        case 0x0EU: d[4] = !d[4];  return true;
+        case 0x15U: d[5] = !d[5];  return true;
+        case 0x1AU: d[6] = !d[6];  return true;
+        case 0x0DU: d[7] = !d[7];  return true;
+        case 0x13U: d[8] = !d[8];  return true;
+        case 0x16U: d[9] = !d[9];  return true;
+        case 0x1CU: d[10] = !d[10]; return true;
+
+        // No bit errors
+        case 0x00U: return true;
+
+        // Unrecoverable errors
+        default: return false;
+    }
+}
+
+/// <summary>
+/// Reference bit-by-bit encode Hamming (10,6,3).
+/// </summary>
+static void referenceEncode16114(bool* d)
+{
+    assert(d != nullptr);
+
+    d[11] = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[5] ^ d[7] ^ d[8];
+    d[12] = d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[6] ^ d[8] ^ d[9];
+    d[13] = d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[7] ^ d[9] ^ d[10];
+    d[14] = d[0] ^ d[1] ^ d[2] ^ d[4] ^ d[6] ^ d[7] ^ d[10];
+    d[15] = d[0] ^ d[2] ^ d[5] ^ d[6] ^ d[8] ^ d[9] ^ d[10];
+}
+
+/// <summary>
+/// Reference bit-by-bit decode Hamming (17,12,3).
+/// </summary>
+static bool referenceDecode17123(bool* d)
+{
+    assert(d != nullptr);
+
+    // Calculate the checksum this column should have
+    bool c0 = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[6] ^ d[7] ^ d[9];
+    bool c1 = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[7] ^ d[8] ^ d[10];
+    bool c2 = d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[8] ^ d[9] ^ d[11];
+    bool c3 = d[0] ^ d[1] ^ d[4] ^ d[5] ^ d[7] ^ d[10];
+    bool c4 = d[0] ^ d[1] ^ d[2] ^ d[5] ^ d[6] ^ d[8] ^ d[11];
+
+    // Compare these with the actual bits
+    unsigned char n = 0x00U;
+    n |= (c0 != d[12]) ? 0x01U : 0x00U;
+    n |= (c1 != d[13]) ? 0x02U : 0x00U;
+    n |= (c2 != d[14]) ? 0x04U : 0x00U;
+    n |= (c3 != d[15]) ? 0x08U : 0x00U;
+    n |= (c4 != d[16]) ? 0x10U : 0x00U;
+
+    switch (n) {
+        // Parity bit errors
+        case 0x01U: d[12] = !d[12]; return true;
+        case 0x02U: d[13] = !d[13]; return true;
+        case 0x04U: d[14] = !d[14]; return true;
+        case 0x08U: d[15] = !d[15]; return true;
+        case 0x10U: d[16] = !d[16]; return true;
+
+        // Data bit errors
+        case 0x1BU: d[0] = !d[0];  return true;
+        case 0x1FU: d[1] = !d[1];  return true;
+        case 0x17U: d[2] = !d[2];  return true;
+        case 0x07U: d[3] = !d[3];  return true;
+        case 0x0EU: d[4] = !d[4];  return true;
+        case 0x1CU: d[5] = !d[5];  return true;
+        case 0x11U: d[6] = !d[6];  return true;
+        case 0x0BU: d[7] = !d[7];  return true;
+        case 0x16U: d[8] = !d[8];  return true;
+        case 0x05U: d[9] = !d[9];  return true;
+        case 0x0AU: d[10] = !d[10]; return true;
+        case 0x14U: d[11] = !d[11]; return true;
+
+        // No bit errors
+        case 0x00U: return true;
+
+        // Unrecoverable errors
+        default: return false;
+    }
+}
+
+/// <summary>
+/// Reference bit-by-bit encode Hamming (17,12,3).
+/// </summary>
+static void referenceEncode17123(bool* d)
+{
+    assert(d != nullptr);
+
+    d[12] = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[6] ^ d[7] ^ d[9];
+    d[13] = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[7] ^ d[8] ^ d[10];
+    d[14] = d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[8] ^ d[9] ^ d[11];
+    d[15] = d[0] ^ d[1] ^ d[4] ^ d[5] ^ d[7] ^ d[10];
+    d[16] = d[0] ^ d[1] ^ d[2] ^ d[5] ^ d[6] ^ d[8] ^ d[11];
+}
+
+/// <summary>
+/// Describes a Hamming code along with its reference and packed implementations.
+/// </summary>
+struct HammingCode {
+    const char* name;
+    uint32_t length;
+    bool (*referenceDecode)(bool*);
+    void (*referenceEncode)(bool*);
+    bool (*decode)(bool*);
+    bool (*decodePacked)(uint32_t&);
+    void (*encodePacked)(uint32_t&);
+};
+
+const HammingCode HAMMING_CODES[] = {
+    { "Hamming (15,11,3) #1", 15U, referenceDecode15113_1, referenceEncode15113_1, Hamming::decode15113_1, Hamming::decode15113_1, Hamming::encode15113_1 },
+    { "Hamming (15,11,3) #2", 15U, referenceDecode15113_2, referenceEncode15113_2, Hamming::decode15113_2, Hamming::decode15113_2, Hamming::encode15113_2 },
+    { "Hamming (13,9,3)", 13U, referenceDecode1393, referenceEncode1393, Hamming::decode1393, Hamming::decode1393, Hamming::encode1393 },
+    { "Hamming (10,6,3)", 10U, referenceDecode1063, referenceEncode1063, Hamming::decode1063, Hamming::decode1063, Hamming::encode1063 },
+    { "Hamming (16,11,4)", 16U, referenceDecode16114, referenceEncode16114, Hamming::decode16114, Hamming::decode16114, Hamming::encode16114 },
+    { "Hamming (17,12,3)", 17U, referenceDecode17123, referenceEncode17123, Hamming::decode17123, Hamming::decode17123, Hamming::encode17123 }
+};
+
+/// <summary>
+/// Unpacks a MSB first packed codeword into a boolean bit array.
+/// </summary>
+static void unpackCodeword(uint32_t code, bool* d, uint32_t length)
+{
+    for (uint32_t i = 0U; i < length; i++)
+        d[i] = ((code >> (length - 1U - i)) & 0x01U) == 0x01U;
+}
+
+/// <summary>
+/// Packs a boolean bit array MSB first.
+/// </summary>
+static uint32_t packCodeword(const bool* d, uint32_t length)
+{
+    uint32_t code = 0U;
+    for (uint32_t i = 0U; i < length; i++)
+        code = (code << 1) | (d[i] ? 0x01U : 0x00U);
+
+    return code;
+}
+
+TEST_CASE("Hamming", "[Hamming Test]") {
+    SECTION("Exhaustive_CrossCheck_Test") {
+        bool failed = false;
+
+        INFO("Hamming Exhaustive Cross-Check Test");
+
+        // every possible received word of every code must decode and encode exactly as
+        // the reference bit-by-bit implementation does
+        for (const HammingCode& code : HAMMING_CODES) {
+            for (uint32_t word = 0U; word < (1U << code.length); word++) {
+                bool expected[32U], actual[32U];
+                unpackCodeword(word, expected, code.length);
+                unpackCodeword(word, actual, code.length);
+
+                bool expectedRet = code.referenceDecode(expected);
+                bool actualRet = code.decode(actual);
+
+                uint32_t packed = word;
+                bool packedRet = code.decodePacked(packed);
+
+                uint32_t expectedWord = packCodeword(expected, code.length);
+                if (expectedRet != actualRet || expectedRet != packedRet ||
+                    expectedWord != packCodeword(actual, code.length) || expectedWord != packed) {
+                    ::LogDebug("T", "%s decode mismatch, word = $%05X, expected = $%05X/%u, packed = $%05X/%u", code.name,
+                        word, expectedWord, expectedRet, packed, packedRet);
+                    failed = true;
+                    break;
+                }
+
+                unpackCodeword(word, expected, code.length);
+                code.referenceEncode(expected);
+
+                packed = word;
+                code.encodePacked(packed);
+                if (packCodeword(expected, code.length) != packed) {
+                    ::LogDebug("T", "%s encode mismatch, word = $%05X, expected = $%05X, packed = $%05X", code.name,
+                        word, packCodeword(expected, code.length), packed);
+                    failed = true;
+                    break;
+                }
+            }
+
+            if (failed)
+                break;
+        }
+
+        REQUIRE(failed==false);
+    }
+}
+
+// the benchmark is hidden; run it explicitly with: dvmtests "[Hamming Benchmark]" -s
+TEST_CASE("Hamming", "[.][Hamming Benchmark]") {
+    SECTION("Decode_Benchmark") {
+        INFO("Hamming Decode Benchmark");
+
+        for (const HammingCode& code : HAMMING_CODES) {
+            uint32_t mask = (1U << code.length) - 1U;
+
+            bool d[32U];
+            uint32_t sink = 0U;
+            auto start = std::chrono::steady_clock::now();
+            for (uint32_t i = 0U; i < BENCHMARK_ITERATIONS; i++) {
+                unpackCodeword((i * 2654435761U) & mask, d, code.length);
+                sink += code.referenceDecode(d) ? 1U : 0U;
+            }
+            auto end = std::chrono::steady_clock::now();
+            double refNs = std::chrono::duration<double>(end - start).count() * 1000000000.0 / BENCHMARK_ITERATIONS;
+
+            start = std::chrono::steady_clock::now();
+            for (uint32_t i = 0U; i < BENCHMARK_ITERATIONS; i++) {
+                uint32_t word = (i * 2654435761U) & mask;
+                sink += code.decodePacked(word) ? 1U : 0U;
+                sink += word;
+            }
+            end = std::chrono::steady_clock::now();
+            double ns = std::chrono::duration<double>(end - start).count() * 1000000000.0 / BENCHMARK_ITERATIONS;
+
+            g_benchmarkSink = g_benchmarkSink + sink;
+            ::LogMessage("T", "%-20s ref %5.1f ns, packed %5.1f ns", code.name, refNs, ns);
+        }
+
+        REQUIRE(true);
+    }
+}
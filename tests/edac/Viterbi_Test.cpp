@@ -0,0 +1,677 @@
+/**
+* Digital Voice Modem - Host Software (Test Suite)
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software / Test Suite
+*
+*/
+/*
+*   Copyright (C) 2023 Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#include "Defines.h"
+#include "dmr/edac/Trellis.h"
+#include "edac/Viterbi.h"
+#include "nxdn/edac/Convolution.h"
+#include "p25/edac/Trellis.h"
+#include "Log.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cmath>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t BER_FRAMES = 500U;
+const uint32_t BER_MAX_SYMBOL_ERRORS = 6U;
+const uint32_t SOFT_FRAMES = 1000U;
+const double SOFT_NOISE_SIGMA = 0.6;
+const uint32_t CROSS_CHECK_ITERATIONS = 2000U;
+const uint32_t BENCHMARK_ITERATIONS = 5000U;
+
+const uint32_t TRELLIS_SYMBOLS = 98U;
+const uint32_t TRELLIS_DATA_LENGTH_BYTES = 25U;
+const uint32_t DMR_DATA_LENGTH_BYTES = 33U;
+const uint32_t NXDN_STEPS = 100U;
+
+const uint32_t INTERLEAVE_TABLE[] = {
+    0U, 1U, 8U,   9U, 16U, 17U, 24U, 25U, 32U, 33U, 40U, 41U, 48U, 49U, 56U, 57U, 64U, 65U, 72U, 73U, 80U, 81U, 88U, 89U, 96U, 97U,
+    2U, 3U, 10U, 11U, 18U, 19U, 26U, 27U, 34U, 35U, 42U, 43U, 50U, 51U, 58U, 59U, 66U, 67U, 74U, 75U, 82U, 83U, 90U, 91U,
+    4U, 5U, 12U, 13U, 20U, 21U, 28U, 29U, 36U, 37U, 44U, 45U, 52U, 53U, 60U, 61U, 68U, 69U, 76U, 77U, 84U, 85U, 92U, 93U,
+    6U, 7U, 14U, 15U, 22U, 23U, 30U, 31U, 38U, 39U, 46U, 47U, 54U, 55U, 62U, 63U, 70U, 71U, 78U, 79U, 86U, 87U, 94U, 95U };
+
+const uint8_t ENCODE_TABLE_34[] = {
+    0U,  8U, 4U, 12U, 2U, 10U, 6U, 14U,
+    4U, 12U, 2U, 10U, 6U, 14U, 0U,  8U,
+    1U,  9U, 5U, 13U, 3U, 11U, 7U, 15U,
+    5U, 13U, 3U, 11U, 7U, 15U, 1U,  9U,
+    3U, 11U, 7U, 15U, 1U,  9U, 5U, 13U,
+    7U, 15U, 1U,  9U, 5U, 13U, 3U, 11U,
+    2U, 10U, 6U, 14U, 0U,  8U, 4U, 12U,
+    6U, 14U, 0U,  8U, 4U, 12U, 2U, 10U };
+
+const uint8_t ENCODE_TABLE_12[] = {
+    0U,  15U, 12U,  3U,
+    4U,  11U,  8U,  7U,
+    13U,  2U,  1U, 14U,
+    9U,   6U,  5U, 10U };
+
+// 4FSK dibit levels of each constellation point
+const int8_t POINT_LEVELS[16U][2U] = {
+    { +1, -1 }, { -1, -1 }, { +3, -3 }, { -3, -3 }, { -3, -1 }, { +3, -1 }, { -1, -3 }, { +1, -3 },
+    { -3, +3 }, { +3, +3 }, { -1, +1 }, { +1, +1 }, { +1, +3 }, { -1, +3 }, { +3, +1 }, { -3, +1 } };
+
+// results are accumulated here so the compiler cannot elide the benchmarked calls
+static volatile uint32_t g_benchmarkSink = 0U;
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Maps a 4FSK symbol level to its dibit.
+/// </summary>
+static uint8_t levelToDibit(int level)
+{
+    switch (level) {
+        case +3: return 0x01U;
+        case +1: return 0x00U;
+        case -1: return 0x02U;
+        default: return 0x03U;
+    }
+}
+
+/// <summary>
+/// Maps a dibit to its 4FSK symbol level.
+/// </summary>
+static int dibitToLevel(uint8_t dibit)
+{
+    static const int LEVELS[] = { +1, +3, -1, -3 };
+    return LEVELS[dibit & 0x03U];
+}
+
+/// <summary>
+/// Returns the bit position of a Trellis symbol, skipping the DMR sync when required.
+/// </summary>
+static uint32_t symbolPosition(uint32_t i, bool dmr)
+{
+    uint32_t n = i * 2U;
+    if (dmr && n >= 98U)
+        n += 68U;
+
+    return n;
+}
+
+/// <summary>
+/// Reads the 4FSK level of a Trellis symbol.
+/// </summary>
+static int readSymbol(const uint8_t* data, uint32_t i, bool dmr)
+{
+    uint32_t n = symbolPosition(i, dmr);
+    uint8_t dibit = (READ_BIT(data, n) ? 0x02U : 0x00U) | (READ_BIT(data, n + 1U) ? 0x01U : 0x00U);
+    return dibitToLevel(dibit);
+}
+
+/// <summary>
+/// Writes the 4FSK level of a Trellis symbol.
+/// </summary>
+static void writeSymbol(uint8_t* data, uint32_t i, int level, bool dmr)
+{
+    uint32_t n = symbolPosition(i, dmr);
+    uint8_t dibit = levelToDibit(level);
+    WRITE_BIT(data, n, (dibit & 0x02U) == 0x02U);
+    WRITE_BIT(data, n + 1U, (dibit & 0x01U) == 0x01U);
+}
+
+/// <summary>
+/// Moves a few random symbols to an adjacent 4FSK level, as noise on a marginal RF
+/// signal would.
+/// </summary>
+static void addSymbolErrors(uint8_t* data, uint32_t errors, bool dmr)
+{
+    for (uint32_t e = 0U; e < errors; e++) {
+        uint32_t i = rand() % TRELLIS_SYMBOLS;
+        int level = readSymbol(data, i, dmr);
+        if (level == +3)
+            level = +1;
+        else if (level == -3)
+            level = -1;
+        else
+            level += (rand() & 1) ? 2 : -2;
+
+        writeSymbol(data, i, level, dmr);
+    }
+}
+
+/// <summary>
+/// Returns a normally distributed random number.
+/// </summary>
+static double gaussian()
+{
+    double u1 = (rand() + 1.0) / (RAND_MAX + 2.0);
+    double u2 = (rand() + 1.0) / (RAND_MAX + 2.0);
+    return std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * M_PI * u2);
+}
+
+/// <summary>
+/// Makes noisy soft symbols for a Trellis coded block, along with the hard decisions
+/// a modem would make for the same symbols.
+/// </summary>
+static void makeSoftSymbols(const uint8_t* data, int8_t* symbols, uint8_t* hard)
+{
+    ::memcpy(hard, data, TRELLIS_DATA_LENGTH_BYTES);
+    for (uint32_t i = 0U; i < TRELLIS_SYMBOLS; i++) {
+        double level = readSymbol(data, i, false) + gaussian() * SOFT_NOISE_SIGMA;
+        if (level > 3.9)
+            level = 3.9;
+        if (level < -3.9)
+            level = -3.9;
+
+        symbols[i] = (int8_t)std::lround(level * edac::VITERBI_SYMBOL_SCALE);
+
+        int sliced = (level >= 2.0) ? +3 : (level >= 0.0) ? +1 : (level >= -2.0) ? -1 : -3;
+        writeSymbol(hard, i, sliced, false);
+    }
+}
+
+/// <summary>
+/// Reference Trellis code check; returns the first point which has no valid transition.
+/// </summary>
+static uint32_t referenceCheckCode(const uint8_t* points, uint8_t* inputs, const uint8_t* table, uint32_t numInputs)
+{
+    uint8_t state = 0U;
+    for (uint32_t i = 0U; i < 49U; i++) {
+        inputs[i] = 9U;
+        for (uint32_t j = 0U; j < numInputs; j++) {
+            if (points[i] == table[state * numInputs + j]) {
+                inputs[i] = j;
+                break;
+            }
+        }
+
+        if (inputs[i] == 9U)
+            return i;
+
+        state = inputs[i];
+    }
+
+    if (inputs[48U] != 0U)
+        return 48U;
+
+    return 999U;
+}
+
+/// <summary>
+/// Reference point substitution search used by the Trellis decoders before Viterbi decoding.
+/// </summary>
+static bool referenceFixCode(uint8_t* points, uint32_t failPos, uint8_t* inputs, const uint8_t* table, uint32_t numInputs)
+{
+    for (uint32_t j = 0U; j < 20U; j++) {
+        uint32_t bestPos = 0U;
+        uint32_t bestVal = 0U;
+
+        for (uint32_t i = 0U; i < 16U; i++) {
+            points[failPos] = i;
+
+            uint32_t pos = referenceCheckCode(points, inputs, table, numInputs);
+            if (pos == 999U)
+                return true;
+
+            if (pos > bestPos) {
+                bestPos = pos;
+                bestVal = i;
+            }
+        }
+
+        points[failPos] = bestVal;
+        failPos = bestPos;
+    }
+
+    return false;
+}
+
+/// <summary>
+/// Reference P25 Trellis decode using the point substitution search.
+/// </summary>
+static bool referenceDecode(const uint8_t* data, uint8_t* payload, bool rate34)
+{
+    const uint8_t* table = rate34 ? ENCODE_TABLE_34 : ENCODE_TABLE_12;
+    uint32_t numInputs = rate34 ? 8U : 4U;
+    uint32_t bitsPerInput = rate34 ? 3U : 2U;
+
+    int levels[TRELLIS_SYMBOLS];
+    for (uint32_t i = 0U; i < TRELLIS_SYMBOLS; i++)
+        levels[INTERLEAVE_TABLE[i]] = readSymbol(data, i, false);
+
+    uint8_t points[49U];
+    for (uint32_t i = 0U; i < 49U; i++) {
+        for (uint8_t p = 0U; p < 16U; p++) {
+            if (POINT_LEVELS[p][0U] == levels[i * 2U + 0U] && POINT_LEVELS[p][1U] == levels[i * 2U + 1U])
+                points[i] = p;
+        }
+    }
+
+    uint8_t inputs[49U];
+    uint32_t failPos = referenceCheckCode(points, inputs, table, numInputs);
+    bool ret = failPos == 999U;
+    if (!ret) {
+        uint8_t savePoints[49U];
+        ::memcpy(savePoints, points, 49U);
+
+        ret = referenceFixCode(points, failPos, inputs, table, numInputs);
+        if (!ret && failPos > 0U)
+            ret = referenceFixCode(savePoints, failPos - 1U, inputs, table, numInputs);
+    }
+
+    if (!ret)
+        return false;
+
+    for (uint32_t i = 0U; i < 48U; i++) {
+        for (uint32_t b = 0U; b < bitsPerInput; b++) {
+            uint32_t n = i * bitsPerInput + b;
+            WRITE_BIT(payload, n, ((inputs[i] >> (bitsPerInput - 1U - b)) & 0x01U) == 0x01U);
+        }
+    }
+
+    return true;
+}
+
+/// <summary>
+/// Reference scalar NXDN convolutional Viterbi decoder.
+/// </summary>
+class ReferenceConvolution {
+public:
+    /// <summary>Initializes a new instance of the ReferenceConvolution class.</summary>
+    ReferenceConvolution() : m_oldMetrics(m_metrics1), m_newMetrics(m_metrics2), m_dp(m_decisions)
+    {
+        ::memset(m_metrics1, 0x00U, sizeof(m_metrics1));
+        ::memset(m_metrics2, 0x00U, sizeof(m_metrics2));
+    }
+
+    /// <summary></summary>
+    void decode(uint8_t s0, uint8_t s1)
+    {
+        static const uint8_t BRANCH_TABLE1[] = { 0U, 0U, 0U, 0U, 2U, 2U, 2U, 2U };
+        static const uint8_t BRANCH_TABLE2[] = { 0U, 2U, 2U, 0U, 0U, 2U, 2U, 0U };
+
+        *m_dp = 0U;
+        for (uint8_t i = 0U; i < 8U; i++) {
+            uint8_t j = i * 2U;
+
+            uint16_t metric = std::abs(BRANCH_TABLE1[i] - s0) + std::abs(BRANCH_TABLE2[i] - s1);
+
+            uint16_t m0 = m_oldMetrics[i] + metric;
+            uint16_t m1 = m_oldMetrics[i + 8U] + (4U - metric);
+            uint8_t decision0 = (m0 >= m1) ? 1U : 0U;
+            m_newMetrics[j + 0U] = decision0 != 0U ? m1 : m0;
+
+            m0 = m_oldMetrics[i] + (4U - metric);
+            m1 = m_oldMetrics[i + 8U] + metric;
+            uint8_t decision1 = (m0 >= m1) ? 1U : 0U;
+            m_newMetrics[j + 1U] = decision1 != 0U ? m1 : m0;
+
+            *m_dp |= (uint64_t(decision1) << (j + 1U)) | (uint64_t(decision0) << (j + 0U));
+        }
+
+        ++m_dp;
+
+        uint16_t* tmp = m_oldMetrics;
+        m_oldMetrics = m_newMetrics;
+        m_newMetrics = tmp;
+    }
+
+    /// <summary></summary>
+    uint32_t chainback(uint8_t* out, uint32_t nBits)
+    {
+        uint32_t state = 0U;
+        while (nBits-- > 0) {
+            --m_dp;
+
+            uint32_t i = state >> 4;
+            uint8_t bit = uint8_t(*m_dp >> i) & 1;
+            state = (bit << 7) | (state >> 1);
+
+            WRITE_BIT(out, nBits, bit != 0U);
+        }
+
+        uint32_t minCost = m_oldMetrics[0];
+        for (uint32_t i = 0U; i < 16U; i++) {
+            if (m_oldMetrics[i] < minCost)
+                minCost = m_oldMetrics[i];
+        }
+
+        return minCost / 2U;
+    }
+
+private:
+    uint16_t m_metrics1[16U];
+    uint16_t m_metrics2[16U];
+    uint16_t* m_oldMetrics;
+    uint16_t* m_newMetrics;
+    uint64_t m_decisions[NXDN_STEPS];
+    uint64_t* m_dp;
+};
+
+/// <summary>
+/// Counts the frames the reference and Viterbi P25 decoders recover with a number of
+/// symbol errors.
+/// </summary>
+static void countRecovered(bool rate34, uint32_t errors, uint32_t frames, uint32_t& refOk, uint32_t& newOk)
+{
+    p25::edac::Trellis trellis;
+    uint32_t length = rate34 ? 18U : 12U;
+
+    refOk = newOk = 0U;
+    for (uint32_t n = 0U; n < frames; n++) {
+        uint8_t payload[18U];
+        for (uint32_t i = 0U; i < length; i++)
+            payload[i] = (uint8_t)rand();
+
+        uint8_t data[TRELLIS_DATA_LENGTH_BYTES];
+        ::memset(data, 0x00U, TRELLIS_DATA_LENGTH_BYTES);
+        if (rate34)
+            trellis.encode34(payload, data);
+        else
+            trellis.encode12(payload, data);
+
+        addSymbolErrors(data, errors, false);
+
+        uint8_t out[18U];
+        ::memset(out, 0x00U, sizeof(out));
+        if (referenceDecode(data, out, rate34) && ::memcmp(out, payload, length) == 0)
+            refOk++;
+
+        ::memset(out, 0x00U, sizeof(out));
+        bool ret = rate34 ? trellis.decode34(data, out) : trellis.decode12(data, out);
+        if (ret && ::memcmp(out, payload, length) == 0)
+            newOk++;
+    }
+}
+
+/// <summary>
+/// Counts the frames the P25 decoders recover from noisy symbols, using hard decisions
+/// and using soft symbols.
+/// </summary>
+static void countSoftRecovered(bool rate34, uint32_t frames, uint32_t& hardOk, uint32_t& softOk)
+{
+    p25::edac::Trellis trellis;
+    uint32_t length = rate34 ? 18U : 12U;
+
+    hardOk = softOk = 0U;
+    for (uint32_t n = 0U; n < frames; n++) {
+        uint8_t payload[18U];
+        for (uint32_t i = 0U; i < length; i++)
+            payload[i] = (uint8_t)rand();
+
+        uint8_t data[TRELLIS_DATA_LENGTH_BYTES];
+        ::memset(data, 0x00U, TRELLIS_DATA_LENGTH_BYTES);
+        if (rate34)
+            trellis.encode34(payload, data);
+        else
+            trellis.encode12(payload, data);
+
+        int8_t symbols[TRELLIS_SYMBOLS];
+        uint8_t hard[TRELLIS_DATA_LENGTH_BYTES];
+        makeSoftSymbols(data, symbols, hard);
+
+        uint8_t out[18U];
+        ::memset(out, 0x00U, sizeof(out));
+        bool ret = rate34 ? trellis.decode34(hard, out) : trellis.decode12(hard, out);
+        if (ret && ::memcmp(out, payload, length) == 0)
+            hardOk++;
+
+        ::memset(out, 0x00U, sizeof(out));
+        ret = rate34 ? trellis.decodeSoft34(symbols, out) : trellis.decodeSoft12(symbols, out);
+        if (ret && ::memcmp(out, payload, length) == 0)
+            softOk++;
+    }
+}
+
+TEST_CASE("Viterbi", "[Viterbi Test]") {
+    SECTION("P25_Trellis_BER_Test") {
+        bool failed = false;
+
+        INFO("P25 Trellis Viterbi BER Test");
+
+        srand((unsigned int)time(NULL));
+
+        // every clean or single symbol error frame must be recovered, and overall the
+        // Viterbi decoder must recover at least as many frames as the point search
+        for (uint32_t rate = 0U; rate < 2U; rate++) {
+            uint32_t refTotal = 0U, newTotal = 0U;
+            for (uint32_t errors = 0U; errors <= BER_MAX_SYMBOL_ERRORS; errors++) {
+                uint32_t refOk, newOk;
+                countRecovered(rate == 1U, errors, BER_FRAMES, refOk, newOk);
+                if (errors <= 1U && newOk != BER_FRAMES) {
+                    ::LogDebug("T", "P25 Trellis %s, %u symbol errors, recovered %u of %u", rate == 1U ? "3/4" : "1/2",
+                        errors, newOk, BER_FRAMES);
+                    failed = true;
+                }
+
+                refTotal += refOk;
+                newTotal += newOk;
+            }
+
+            if (newTotal < refTotal) {
+                ::LogDebug("T", "P25 Trellis %s, Viterbi recovered %u, point search recovered %u", rate == 1U ? "3/4" : "1/2",
+                    newTotal, refTotal);
+                failed = true;
+            }
+        }
+
+        REQUIRE(failed==false);
+    }
+
+    SECTION("P25_Trellis_Soft_Test") {
+        bool failed = false;
+
+        INFO("P25 Trellis Viterbi Soft Decision Test");
+
+        srand((unsigned int)time(NULL));
+
+        for (uint32_t rate = 0U; rate < 2U; rate++) {
+            uint32_t hardOk, softOk;
+            countSoftRecovered(rate == 1U, SOFT_FRAMES, hardOk, softOk);
+            if (softOk < hardOk) {
+                ::LogDebug("T", "P25 Trellis %s, soft recovered %u, hard recovered %u", rate == 1U ? "3/4" : "1/2",
+                    softOk, hardOk);
+                failed = true;
+            }
+        }
+
+        REQUIRE(failed==false);
+    }
+
+    SECTION("DMR_Trellis_Test") {
+        bool failed = false;
+
+        INFO("DMR Trellis Viterbi Test");
+
+        srand((unsigned int)time(NULL));
+
+        dmr::edac::Trellis trellis;
+        for (uint32_t n = 0U; n < CROSS_CHECK_ITERATIONS; n++) {
+            uint8_t payload[18U];
+            for (uint32_t i = 0U; i < 18U; i++)
+                payload[i] = (uint8_t)rand();
+
+            uint8_t data[DMR_DATA_LENGTH_BYTES];
+            for (uint32_t i = 0U; i < DMR_DATA_LENGTH_BYTES; i++)
+                data[i] = (uint8_t)rand();
+
+            trellis.encode(payload, data);
+            addSymbolErrors(data, n & 1U, true);
+
+            // the soft symbols carry the same hard decisions
+            int8_t symbols[TRELLIS_SYMBOLS];
+            for (uint32_t i = 0U; i < TRELLIS_SYMBOLS; i++)
+                symbols[i] = (int8_t)(readSymbol(data, i, true) * edac::VITERBI_SYMBOL_SCALE);
+
+            uint8_t out[18U], softOut[18U];
+            bool ret = trellis.decode(data, out);
+            bool softRet = trellis.decodeSoft(symbols, softOut);
+            if (!ret || !softRet || ::memcmp(out, payload, 18U) != 0 || ::memcmp(softOut, payload, 18U) != 0) {
+                ::LogDebug("T", "DMR Trellis, frame %u not recovered", n);
+                failed = true;
+                break;
+            }
+        }
+
+        REQUIRE(failed==false);
+    }
+
+    SECTION("NXDN_Convolution_CrossCheck_Test") {
+        bool failed = false;
+
+        INFO("NXDN Convolution Viterbi Cross-Check Test");
+
+        srand((unsigned int)time(NULL));
+
+        for (uint32_t n = 0U; n < CROSS_CHECK_ITERATIONS; n++) {
+            nxdn::edac::Convolution conv;
+            conv.start();
+            ReferenceConvolution ref;
+
+            for (uint32_t i = 0U; i < NXDN_STEPS; i++) {
+                uint8_t s0 = (uint8_t)(rand() % 3);
+                uint8_t s1 = (uint8_t)(rand() % 3);
+                conv.decode(s0, s1);
+                ref.decode(s0, s1);
+            }
+
+            uint8_t expected[NXDN_STEPS / 8U + 1U], actual[NXDN_STEPS / 8U + 1U];
+            ::memset(expected, 0x00U, sizeof(expected));
+            ::memset(actual, 0x00U, sizeof(actual));
+
+            uint32_t expectedCost = ref.chainback(expected, NXDN_STEPS);
+            uint32_t actualCost = conv.chainback(actual, NXDN_STEPS);
+            if (expectedCost != actualCost || ::memcmp(expected, actual, sizeof(expected)) != 0) {
+                ::LogDebug("T", "NXDN Convolution, cost = %u, expected = %u", actualCost, expectedCost);
+                failed = true;
+                break;
+            }
+        }
+
+        REQUIRE(failed==false);
+    }
+}
+
+// the benchmark is hidden; run it explicitly with: dvmtests "[Viterbi Benchmark]" -s
+TEST_CASE("Viterbi", "[.][Viterbi Benchmark]") {
+    SECTION("Decode_Benchmark") {
+        INFO("Viterbi Decode Benchmark");
+
+        srand((unsigned int)time(NULL));
+
+        // recovered frames per number of symbol errors
+        for (uint32_t rate = 0U; rate < 2U; rate++) {
+            for (uint32_t errors = 0U; errors <= BER_MAX_SYMBOL_ERRORS + 2U; errors++) {
+                uint32_t refOk, newOk;
+                countRecovered(rate == 1U, errors, BER_FRAMES, refOk, newOk);
+                ::LogMessage("T", "P25 Trellis %s, %u symbol errors: point search %5.1f%%, Viterbi %5.1f%%",
+                    rate == 1U ? "3/4" : "1/2", errors, 100.0 * refOk / BER_FRAMES, 100.0 * newOk / BER_FRAMES);
+            }
+
+            uint32_t hardOk, softOk;
+            countSoftRecovered(rate == 1U, SOFT_FRAMES, hardOk, softOk);
+            ::LogMessage("T", "P25 Trellis %s, noise sigma %.2f: hard %5.1f%%, soft %5.1f%%", rate == 1U ? "3/4" : "1/2",
+                SOFT_NOISE_SIGMA, 100.0 * hardOk / SOFT_FRAMES, 100.0 * softOk / SOFT_FRAMES);
+        }
+
+        // time per block with a few symbol errors, as a marginal RF signal would give
+        p25::edac::Trellis trellis;
+        uint8_t frames[2U][TRELLIS_DATA_LENGTH_BYTES];
+        for (uint32_t rate = 0U; rate < 2U; rate++) {
+            uint8_t payload[18U];
+            for (uint32_t i = 0U; i < 18U; i++)
+                payload[i] = (uint8_t)rand();
+
+            ::memset(frames[rate], 0x00U, TRELLIS_DATA_LENGTH_BYTES);
+            if (rate == 1U)
+                trellis.encode34(payload, frames[rate]);
+            else
+                trellis.encode12(payload, frames[rate]);
+            addSymbolErrors(frames[rate], 3U, false);
+        }
+
+        auto run = [&](const char* name, const uint8_t* frame, bool (*func)(p25::edac::Trellis&, const uint8_t*, uint8_t*)) {
+            uint32_t sink = 0U;
+            uint8_t out[18U];
+            auto start = std::chrono::steady_clock::now();
+            for (uint32_t i = 0U; i < BENCHMARK_ITERATIONS; i++) {
+                sink += func(trellis, frame, out) ? 1U : 0U;
+                sink += out[i % 12U];
+            }
+            auto end = std::chrono::steady_clock::now();
+
+            g_benchmarkSink = g_benchmarkSink + sink;
+            double ns = std::chrono::duration<double>(end - start).count() * 1000000000.0 / BENCHMARK_ITERATIONS;
+            ::LogMessage("T", "%-32s %8.1f ns/call", name, ns);
+            return ns;
+        };
+
+        double fast = run("Trellis 1/2 (Viterbi)", frames[0U], [](p25::edac::Trellis& t, const uint8_t* d, uint8_t* o) { return t.decode12(d, o); });
+        double slow = run("Trellis 1/2 (point search)", frames[0U], [](p25::edac::Trellis&, const uint8_t* d, uint8_t* o) { return referenceDecode(d, o, false); });
+        ::LogMessage("T", "Trellis 1/2 speedup: %.1fx", slow / fast);
+
+        fast = run("Trellis 3/4 (Viterbi)", frames[1U], [](p25::edac::Trellis& t, const uint8_t* d, uint8_t* o) { return t.decode34(d, o); });
+        slow = run("Trellis 3/4 (point search)", frames[1U], [](p25::edac::Trellis&, const uint8_t* d, uint8_t* o) { return referenceDecode(d, o, true); });
+        ::LogMessage("T", "Trellis 3/4 speedup: %.1fx", slow / fast);
+
+        // NXDN FACCH1 sized block
+        uint8_t bits[2U][NXDN_STEPS];
+        for (uint32_t i = 0U; i < NXDN_STEPS; i++) {
+            bits[0U][i] = (uint8_t)(rand() % 3);
+            bits[1U][i] = (uint8_t)(rand() % 3);
+        }
+
+        uint32_t sink = 0U;
+        uint8_t out[NXDN_STEPS / 8U + 1U];
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t n = 0U; n < BENCHMARK_ITERATIONS; n++) {
+            nxdn::edac::Convolution conv;
+            conv.start();
+            for (uint32_t i = 0U; i < NXDN_STEPS; i++)
+                conv.decode(bits[0U][i], bits[1U][i]);
+            sink += conv.chainback(out, NXDN_STEPS - 4U);
+        }
+        auto end = std::chrono::steady_clock::now();
+        fast = std::chrono::duration<double>(end - start).count() * 1000000000.0 / BENCHMARK_ITERATIONS;
+
+        start = std::chrono::steady_clock::now();
+        for (uint32_t n = 0U; n < BENCHMARK_ITERATIONS; n++) {
+            ReferenceConvolution ref;
+            for (uint32_t i = 0U; i < NXDN_STEPS; i++)
+                ref.decode(bits[0U][i], bits[1U][i]);
+            sink += ref.chainback(out, NXDN_STEPS - 4U);
+        }
+        end = std::chrono::steady_clock::now();
+        slow = std::chrono::duration<double>(end - start).count() * 1000000000.0 / BENCHMARK_ITERATIONS;
+
+        g_benchmarkSink = g_benchmarkSink + sink;
+        ::LogMessage("T", "%-32s %8.1f ns/call", "NXDN convolution (SIMD)", fast);
+        ::LogMessage("T", "%-32s %8.1f ns/call", "NXDN convolution (scalar)", slow);
+        ::LogMessage("T", "NXDN convolution speedup: %.1fx", slow / fast);
+
+        REQUIRE(true);
+    }
+}
@@ -0,0 +1,188 @@
+/**
+* Digital Voice Modem - Host Software (Test Suite)
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software / Test Suite
+*
+*/
+/*
+*   Copyright (C) 2023 Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#include "Defines.h"
+#include "lookups/AffiliationLookup.h"
+#include "Log.h"
+
+using namespace lookups;
+
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+TEST_CASE("AffiliationLookup", "[Affiliation Test]") {
+    SECTION("Registration_Affiliation_Test") {
+        INFO("AffiliationLookup registration and affiliation index test");
+
+        AffiliationLookup aff("Test Affiliation", false);
+
+        for (uint32_t srcId = 1U; srcId <= 1000U; srcId++) {
+            aff.unitReg(srcId);
+            aff.groupAff(srcId, 100U + (srcId % 4U));
+        }
+        aff.unitReg(1U);
+        REQUIRE(aff.unitRegSize() == 1000U);
+        REQUIRE(aff.grpAffSize() == 1000U);
+        REQUIRE(aff.isUnitReg(500U));
+        REQUIRE(!aff.isUnitReg(1001U));
+        REQUIRE(aff.isGroupAff(5U, 101U));
+        REQUIRE(!aff.isGroupAff(5U, 102U));
+
+        // moving a unit to another group must move it out of the old group
+        aff.groupAff(5U, 102U);
+        REQUIRE(aff.isGroupAff(5U, 102U));
+
+        std::vector<uint32_t> released = aff.clearGroupAff(101U, false);
+        REQUIRE(released.size() == 249U);
+        REQUIRE(std::find(released.begin(), released.end(), 5U) == released.end());
+        for (uint32_t srcId : released) {
+            REQUIRE(aff.isGroupAff(srcId, 101U));
+        }
+
+        released = aff.clearGroupAff(102U, false);
+        REQUIRE(released.size() == 251U);
+
+        // deregistration also removes the affiliation
+        REQUIRE(aff.unitDereg(5U));
+        REQUIRE(!aff.unitDereg(5U));
+        REQUIRE(!aff.isUnitReg(5U));
+        REQUIRE(!aff.isGroupAff(5U, 102U));
+        REQUIRE(aff.clearGroupAff(102U, false).size() == 250U);
+        REQUIRE(aff.clearGroupAff(0U, true).size() == 999U);
+    }
+
+    SECTION("Grant_Timeout_Test") {
+        INFO("AffiliationLookup grant timeout test");
+
+        AffiliationLookup aff("Test Affiliation", false);
+        aff.addRFCh(1U);
+        aff.addRFCh(2U);
+
+        std::vector<uint32_t> releasedCh;
+        aff.setReleaseGrantCallback([&](uint32_t chNo, uint32_t dstId, uint8_t slot) { releasedCh.push_back(chNo); });
+
+        REQUIRE(aff.grantCh(100U, 1U, 2U));
+        REQUIRE(aff.grantCh(200U, 2U, 2U));
+        REQUIRE(!aff.grantCh(300U, 3U, 2U));
+        REQUIRE(aff.grantSize() == 2U);
+
+        // clock at roughly the rate of the host main loop; the grant for 200 is kept alive
+        uint32_t elapsed = 0U;
+        uint32_t releasedAt = 0U;
+        while (elapsed < 5000U) {
+            aff.clock(20U);
+            elapsed += 20U;
+
+            if (elapsed <= 3000U && (elapsed % 500U) == 0U) {
+                aff.touchGrant(200U);
+            }
+
+            if (releasedAt == 0U && !aff.isGranted(100U)) {
+                releasedAt = elapsed;
+            }
+        }
+
+        REQUIRE(releasedAt >= 2000U);
+        REQUIRE(releasedAt <= 2100U);
+        REQUIRE(!aff.isGranted(200U));
+        REQUIRE(releasedCh.size() == 2U);
+        REQUIRE(aff.getRFChCnt() == 2U);
+        REQUIRE(aff.getGrantedRFChCnt() == 0U);
+
+        // an explicitly released grant must not expire later on a reused destination
+        REQUIRE(aff.grantCh(100U, 1U, 1U));
+        REQUIRE(aff.releaseGrant(100U, false));
+        REQUIRE(aff.grantCh(100U, 1U, 3U));
+        aff.clock(1500U);
+        REQUIRE(aff.isGranted(100U));
+        aff.clock(1600U);
+        REQUIRE(!aff.isGranted(100U));
+    }
+}
+
+// the benchmark is hidden; run it explicitly with: dvmtests "[Affiliation Benchmark]" -s
+TEST_CASE("AffiliationLookup", "[.][Affiliation Benchmark]") {
+    SECTION("Large_Site_Benchmark") {
+        INFO("AffiliationLookup operations with tens of thousands of registered units");
+
+        const uint32_t units = 50000U;
+        const uint32_t groups = 500U;
+
+        AffiliationLookup aff("Test Affiliation", false);
+        for (uint32_t ch = 1U; ch <= 32U; ch++) {
+            aff.addRFCh(ch);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t srcId = 1U; srcId <= units; srcId++) {
+            aff.unitReg(srcId);
+            aff.groupAff(srcId, 1U + (srcId % groups));
+        }
+        auto end = std::chrono::steady_clock::now();
+        double regNs = std::chrono::duration<double>(end - start).count() * 1000000000.0 / units;
+
+        uint32_t hits = 0U;
+        start = std::chrono::steady_clock::now();
+        for (uint32_t srcId = 1U; srcId <= units; srcId++) {
+            hits += aff.isUnitReg(srcId * 7U % units) ? 1U : 0U;
+        }
+        end = std::chrono::steady_clock::now();
+        double lookupNs = std::chrono::duration<double>(end - start).count() * 1000000000.0 / units;
+
+        start = std::chrono::steady_clock::now();
+        for (uint32_t dstId = 1U; dstId <= groups; dstId++) {
+            hits += (uint32_t)aff.clearGroupAff(dstId, false).size();
+        }
+        end = std::chrono::steady_clock::now();
+        double clearNs = std::chrono::duration<double>(end - start).count() * 1000000000.0 / groups;
+
+        for (uint32_t dstId = 1U; dstId <= 32U; dstId++) {
+            aff.grantCh(dstId, dstId, 30U);
+        }
+
+        const uint32_t ticks = 100000U;
+        start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0U; i < ticks; i++) {
+            aff.touchGrant(1U + (i % 32U));
+            aff.clock(1U);
+        }
+        end = std::chrono::steady_clock::now();
+        double clockNs = std::chrono::duration<double>(end - start).count() * 1000000000.0 / ticks;
+
+        start = std::chrono::steady_clock::now();
+        for (uint32_t srcId = 1U; srcId <= units; srcId++) {
+            aff.unitDereg(srcId);
+        }
+        end = std::chrono::steady_clock::now();
+        double deregNs = std::chrono::duration<double>(end - start).count() * 1000000000.0 / units;
+
+        ::LogMessage("T", "%u units: reg+aff %.1f ns, isUnitReg %.1f ns, dereg %.1f ns", units, regNs, lookupNs, deregNs);
+        ::LogMessage("T", "clearGroupAff %.1f ns/group, touch+clock %.1f ns/tick (%u)", clearNs, clockNs, hits);
+
+        REQUIRE(aff.unitRegSize() == 0U);
+    }
+}
@@ -0,0 +1,159 @@
+/**
+* Digital Voice Modem - Host Software (Test Suite)
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software / Test Suite
+*
+*/
+/*
+*   Copyright (C) 2023 Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#include "Defines.h"
+#include "lookups/RadioIdLookup.h"
+#include "Log.h"
+
+using namespace lookups;
+
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+TEST_CASE("RadioIdLookup Reload", "[Reload Test]") {
+    SECTION("Snapshot_Swap_Test") {
+        INFO("RadioIdLookup reload snapshot swap test");
+
+        std::string filename = "/tmp/dvmtests_rid_swap_" + std::to_string(::getpid()) + ".dat";
+        {
+            std::ofstream file(filename, std::ofstream::out | std::ofstream::trunc);
+            file << "1,1,\n2,0,\n3,1,\n";
+        }
+
+        RadioIdLookup lookup(filename, 0U, true);
+        REQUIRE(lookup.read());
+        REQUIRE(lookup.find(1U).radioEnabled());
+        REQUIRE(!lookup.find(2U).radioEnabled());
+
+        std::shared_ptr<const RadioIdLookup::TableMap> before = lookup.snapshot();
+        uint32_t generation = lookup.generation();
+
+        // the reloaded file disables 1, enables 2, drops 3 and adds 4
+        {
+            std::ofstream file(filename, std::ofstream::out | std::ofstream::trunc);
+            file << "1,0,\n2,1,\n4,1,\n# reloaded\n";
+        }
+        REQUIRE(lookup.read());
+        REQUIRE(lookup.generation() != generation);
+
+        REQUIRE(!lookup.find(1U).radioEnabled());
+        REQUIRE(lookup.find(2U).radioEnabled());
+        REQUIRE(!lookup.hasEntry(3U));
+        REQUIRE(lookup.find(4U).radioEnabled());
+
+        // a snapshot taken before the reload is left untouched
+        REQUIRE(before->size() == 3U);
+        REQUIRE(before->at(1U).radioEnabled());
+        REQUIRE(!before->at(2U).radioEnabled());
+        REQUIRE(before->find(4U) == before->end());
+
+        // as is one taken before a modification
+        std::shared_ptr<const RadioIdLookup::TableMap> reloaded = lookup.snapshot();
+        lookup.toggleEntry(4U, false);
+        REQUIRE(!lookup.find(4U).radioEnabled());
+        REQUIRE(reloaded->at(4U).radioEnabled());
+
+        ::remove(filename.c_str());
+        ::remove((filename + ".cache").c_str());
+    }
+}
+
+TEST_CASE("RadioIdLookup", "[.][Reload Benchmark]") {
+    SECTION("Find_During_Reload_Benchmark") {
+        INFO("RadioIdLookup find() latency during a 100k entry reload");
+
+        const uint32_t entries = 100000U;
+        const uint32_t reloads = 10U;
+
+        // generate a radio ID table; even IDs are enabled, odd IDs are disabled
+        std::string filename = "/tmp/dvmtests_rid_" + std::to_string(::getpid()) + ".dat";
+        {
+            std::ofstream file(filename, std::ofstream::out | std::ofstream::trunc);
+            for (uint32_t i = 1U; i <= entries; i++) {
+                file << i << "," << ((i % 2U) == 0U ? 1 : 0) << ",\n";
+            }
+        }
+
+        RadioIdLookup lookup(filename, 0U, true);
+        REQUIRE(lookup.read());
+
+        // reload the table continuously while this thread performs lookups; an unchanged file is
+        // not reloaded, so touch the contents before each reload
+        std::atomic<bool> reloading(true);
+        std::thread reloader([&]() {
+            for (uint32_t i = 0U; i < reloads; i++) {
+                {
+                    std::ofstream file(filename, std::ofstream::out | std::ofstream::app);
+                    file << "# reload " << i << "\n";
+                }
+
+                lookup.read();
+            }
+            reloading = false;
+        });
+
+        uint64_t lookups = 0U;
+        uint64_t misses = 0U;
+        uint64_t totalNs = 0U;
+        uint64_t maxNs = 0U;
+        uint32_t id = 1U;
+        while (reloading) {
+            auto start = std::chrono::steady_clock::now();
+            RadioId rid = lookup.find(id);
+            uint64_t ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+            // a lookup must never observe a partially loaded table
+            if (rid.radioDefault() || rid.radioEnabled() != ((id % 2U) == 0U)) {
+                misses++;
+            }
+
+            lookups++;
+            totalNs += ns;
+            if (ns > maxNs) {
+                maxNs = ns;
+            }
+
+            id = (id % entries) + 1U;
+        }
+
+        reloader.join();
+        ::remove(filename.c_str());
+        ::remove((filename + ".cache").c_str());
+
+        ::LogDebug("T", "Find_During_Reload_Benchmark, %u reloads, %llu lookups, avg = %llu ns, max = %llu ns, misses = %llu",
+            reloads, (unsigned long long)lookups, (unsigned long long)(lookups > 0U ? totalNs / lookups : 0U),
+            (unsigned long long)maxNs, (unsigned long long)misses);
+
+        REQUIRE(lookups > 0U);
+        REQUIRE(misses == 0U);
+    }
+}
@@ -0,0 +1,84 @@
+/**
+* Digital Voice Modem - Host Software (Test Suite)
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software / Test Suite
+*
+*/
+/*
+*   Copyright (C) 2023 Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#include "Defines.h"
+#include "lookups/TalkgroupRulesLookup.h"
+
+using namespace lookups;
+
+#include <catch2/catch_test_macros.hpp>
+#include <utility>
+#include <vector>
+
+TEST_CASE("TalkgroupRulesLookup", "[Talkgroup Rules Test]") {
+    SECTION("Batch_Update_Test") {
+        INFO("TalkgroupRulesLookup batched add and erase test");
+
+        TalkgroupRulesLookup lookup("", 0U, true);
+
+        std::vector<std::pair<uint32_t, uint8_t>> ids;
+        for (uint32_t id = 1U; id <= 100U; id++) {
+            ids.push_back(std::make_pair(id, (uint8_t)((id % 2U) + 1U)));
+        }
+
+        // the whole batch is published as a single update
+        uint32_t generation = lookup.generation();
+        lookup.addEntries(ids, true);
+        REQUIRE(lookup.generation() == generation + 1U);
+        REQUIRE(lookup.snapshot()->size() == 100U);
+        REQUIRE(lookup.find(10U, 1U).config().active());
+        REQUIRE(lookup.find(10U, 2U).isInvalid());
+        REQUIRE(lookup.find(10U).source().tgSlot() == 1U);
+
+        // existing rules are updated in place, new rules are appended once
+        std::vector<std::pair<uint32_t, uint8_t>> update;
+        update.push_back(std::make_pair(10U, 1U));
+        update.push_back(std::make_pair(200U, 2U));
+        update.push_back(std::make_pair(200U, 2U));
+        lookup.addEntries(update, false);
+        REQUIRE(lookup.snapshot()->size() == 101U);
+        REQUIRE(!lookup.find(10U, 1U).config().active());
+        REQUIRE(!lookup.find(200U, 2U).config().active());
+        REQUIRE(lookup.find(11U, 2U).config().active());
+
+        // only the rules matching both ID and slot are erased
+        std::vector<std::pair<uint32_t, uint8_t>> erase;
+        for (uint32_t id = 1U; id <= 50U; id++) {
+            erase.push_back(std::make_pair(id, 1U));
+        }
+
+        generation = lookup.generation();
+        lookup.eraseEntries(erase);
+        REQUIRE(lookup.generation() == generation + 1U);
+        REQUIRE(lookup.snapshot()->size() == 76U);
+        REQUIRE(lookup.find(10U).isInvalid());
+        REQUIRE(!lookup.find(11U).isInvalid());
+
+        // nothing to erase leaves the rules alone
+        generation = lookup.generation();
+        lookup.eraseEntries(erase);
+        REQUIRE(lookup.generation() == generation);
+    }
+}
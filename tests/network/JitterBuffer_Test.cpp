@@ -0,0 +1,176 @@
+/**
+* Digital Voice Modem - Host Software (Test Suite)
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software / Test Suite
+*
+*/
+/*
+*   Copyright (C) 2023 Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#include "Defines.h"
+#include "network/JitterBuffer.h"
+
+using namespace network;
+
+#include <catch2/catch_test_macros.hpp>
+#include <stdlib.h>
+#include <time.h>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Adds a single byte frame carrying its own sequence number to the buffer.
+/// </summary>
+static bool addFrame(JitterBuffer& jitter, uint16_t seq, uint32_t timestamp)
+{
+    UInt8Array data = std::unique_ptr<uint8_t[]>(new uint8_t[1U]);
+    data[0U] = (uint8_t)seq;
+    return jitter.addFrame(1U, seq, timestamp, data, 1U);
+}
+
+/// <summary>
+/// Takes all the frames that are due for playout from the buffer.
+/// </summary>
+static void playout(JitterBuffer& jitter, std::vector<uint8_t>& out)
+{
+    uint32_t length = 0U;
+    UInt8Array data = jitter.getFrame(length);
+    while (data != nullptr) {
+        out.push_back(data[0U]);
+        data = jitter.getFrame(length);
+    }
+}
+
+TEST_CASE("JitterBuffer", "[Jitter Buffer Test]") {
+    SECTION("Reorder_Test") {
+        INFO("JitterBuffer reorder and gap test");
+
+        JitterBuffer jitter(DMR_JITTER_FRAME_TIME);
+        std::vector<uint8_t> out;
+
+        addFrame(jitter, 0U, 0U);
+        addFrame(jitter, 2U, 960U);
+        playout(jitter, out);
+        addFrame(jitter, 1U, 480U);
+        addFrame(jitter, 3U, 1440U);
+        playout(jitter, out);
+        REQUIRE(out == std::vector<uint8_t>({ 0U, 1U, 2U, 3U }));
+        REQUIRE(jitter.reordered() == 1U);
+        REQUIRE(jitter.lost() == 0U);
+
+        // frame 4 never arrives; frame 5 is held for the playout depth and then played
+        REQUIRE(jitter.playoutDelay() == -1);
+        addFrame(jitter, 5U, 2400U);
+        playout(jitter, out);
+        REQUIRE(out.size() == 4U);
+        REQUIRE(jitter.playoutDelay() == (int32_t)(jitter.depth() * DMR_JITTER_FRAME_TIME));
+
+        jitter.clock(jitter.depth() * DMR_JITTER_FRAME_TIME);
+        playout(jitter, out);
+        REQUIRE(out.size() == 5U);
+        REQUIRE(out.back() == 5U);
+        REQUIRE(jitter.lost() == 1U);
+
+        // frame 4 turns up after all, too late to be played
+        REQUIRE(!addFrame(jitter, 4U, 1920U));
+        REQUIRE(!addFrame(jitter, 5U, 2400U));
+        REQUIRE(jitter.lateDrops() == 2U);
+    }
+
+    SECTION("Sequence_Restart_Test") {
+        INFO("JitterBuffer sequence restart test");
+
+        JitterBuffer jitter(DMR_JITTER_FRAME_TIME);
+        std::vector<uint8_t> out;
+
+        for (uint16_t seq = 0U; seq < 50U; seq++) {
+            addFrame(jitter, seq, seq * 480U);
+            playout(jitter, out);
+            jitter.clock(DMR_JITTER_FRAME_TIME);
+        }
+
+        // the sender restarts its sequence mid-stream (i.e. a sender sharing one sequence
+        // across streams starting a call on the other slot); the rest of the stream still plays
+        for (uint16_t seq = 0U; seq < 50U; seq++) {
+            addFrame(jitter, seq, (seq + 50U) * 480U);
+            playout(jitter, out);
+            jitter.clock(DMR_JITTER_FRAME_TIME);
+        }
+
+        jitter.clock(jitter.depth() * DMR_JITTER_FRAME_TIME);
+        playout(jitter, out);
+
+        REQUIRE(out.size() == 100U);
+        REQUIRE(jitter.lateDrops() == 0U);
+        REQUIRE(jitter.lost() == 0U);
+        for (uint32_t i = 0U; i < out.size(); i++) {
+            REQUIRE(out[i] == (uint8_t)(i % 50U));
+        }
+    }
+
+    SECTION("Adaptive_Depth_Test") {
+        INFO("JitterBuffer adaptive depth test");
+
+        srand((unsigned int)time(NULL));
+
+        const uint32_t frames = 200U;
+        const uint32_t maxDelay = 150U;
+
+        // frames sent every 60ms, each delayed in transit by up to 150ms
+        std::vector<uint32_t> arrival(frames);
+        for (uint32_t i = 0U; i < frames; i++) {
+            arrival[i] = i * DMR_JITTER_FRAME_TIME + (rand() % maxDelay);
+        }
+
+        JitterBuffer jitter(DMR_JITTER_FRAME_TIME);
+        std::vector<uint8_t> out;
+        std::vector<uint32_t> outSeq;
+        for (uint32_t now = 0U; now < frames * DMR_JITTER_FRAME_TIME + 1000U; now += 5U) {
+            for (uint32_t i = 0U; i < frames; i++) {
+                if (arrival[i] >= now && arrival[i] < now + 5U) {
+                    addFrame(jitter, (uint16_t)i, i * DMR_JITTER_FRAME_TIME * 8U);
+                }
+            }
+
+            out.clear();
+            playout(jitter, out);
+            for (uint8_t seq : out) {
+                outSeq.push_back(seq);
+            }
+
+            jitter.clock(5U);
+        }
+
+        // every frame is played exactly once or dropped as late, and always in order
+        REQUIRE(outSeq.size() + jitter.lateDrops() == frames);
+        for (uint32_t i = 1U; i < outSeq.size(); i++) {
+            REQUIRE((uint8_t)(outSeq[i] - outSeq[i - 1U]) >= 1U);
+        }
+
+        REQUIRE(jitter.jitter() > 0.0F);
+        REQUIRE(jitter.depth() > JITTER_BUFFER_MIN_DEPTH);
+        REQUIRE(jitter.depth() <= JITTER_BUFFER_MAX_DEPTH);
+
+        // once the depth has adapted to the jitter, late drops are rare
+        REQUIRE(jitter.lateDrops() < frames / 10U);
+    }
+}
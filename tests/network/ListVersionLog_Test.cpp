@@ -0,0 +1,147 @@
+/**
+* Digital Voice Modem - Host Software (Test Suite)
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software / Test Suite
+*
+*/
+/*
+*   Copyright (C) 2023 Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#include "Defines.h"
+#include "network/fne/ListVersionLog.h"
+
+using namespace network::fne;
+
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+typedef ListVersionLog<uint32_t, uint32_t> VersionLog;
+
+TEST_CASE("ListVersionLog", "[List Version Log Test]") {
+    SECTION("Version_Wrap_Test") {
+        INFO("ListVersionLog version wrap test");
+
+        VersionLog log;
+        log.reset(0xFFFFFFFEU);
+        REQUIRE(log.update({ { 1U, 10U } }));
+        REQUIRE(log.version() == 0xFFFFFFFFU);
+
+        // version 0 means "no version", so the version wraps to 1
+        REQUIRE(log.update({ { 1U, 10U }, { 2U, 20U } }));
+        REQUIRE(log.version() == 1U);
+
+        // an update that changes nothing does not produce a version
+        REQUIRE(!log.update({ { 1U, 10U }, { 2U, 20U } }));
+        REQUIRE(log.version() == 1U);
+
+        std::vector<VersionLog::Change> changes;
+        REQUIRE(log.changesSince(0xFFFFFFFEU, changes));
+        REQUIRE(changes.size() == 2U);
+        REQUIRE(changes[0U].key == 1U);
+        REQUIRE(!changes[0U].hadValue);
+        REQUIRE(changes[1U].key == 2U);
+        REQUIRE(changes[1U].newValue == 20U);
+
+        REQUIRE(log.changesSince(0xFFFFFFFFU, changes));
+        REQUIRE(changes.size() == 1U);
+        REQUIRE(changes[0U].key == 2U);
+
+        REQUIRE(log.changesSince(1U, changes));
+        REQUIRE(changes.empty());
+
+        REQUIRE(!log.changesSince(0U, changes));
+    }
+
+    SECTION("History_Truncation_Test") {
+        INFO("ListVersionLog history truncation test");
+
+        VersionLog log;
+        log.reset(1U);
+
+        // a version filling the history exactly is kept
+        VersionLog::List list;
+        for (uint32_t key = 1U; key <= LIST_VERSION_MAX_CHANGES; key++) {
+            list.push_back(std::make_pair(key, key));
+        }
+        REQUIRE(log.update(list));
+        REQUIRE(log.version() == 2U);
+
+        std::vector<VersionLog::Change> changes;
+        REQUIRE(log.changesSince(1U, changes));
+        REQUIRE(changes.size() == LIST_VERSION_MAX_CHANGES);
+
+        // one more change pushes the whole of version 2 out; a holder of version 1 needs the full list
+        list.push_back(std::make_pair(LIST_VERSION_MAX_CHANGES + 1U, 0U));
+        REQUIRE(log.update(list));
+        REQUIRE(log.version() == 3U);
+        REQUIRE(!log.changesSince(1U, changes));
+        REQUIRE(changes.empty());
+
+        REQUIRE(log.changesSince(2U, changes));
+        REQUIRE(changes.size() == 1U);
+        REQUIRE(changes[0U].key == LIST_VERSION_MAX_CHANGES + 1U);
+
+        // a single version larger than the history cannot be described by changes at all
+        for (std::pair<uint32_t, uint32_t>& entry : list) {
+            entry.second++;
+        }
+        REQUIRE(log.update(list));
+        REQUIRE(!log.changesSince(3U, changes));
+        REQUIRE(log.changesSince(log.version(), changes));
+        REQUIRE(changes.empty());
+
+        // versions the log never produced also need the full list
+        REQUIRE(!log.changesSince(100U, changes));
+    }
+
+    SECTION("Collapse_Test") {
+        INFO("ListVersionLog changesSince collapsing test");
+
+        VersionLog log;
+        log.reset(1U);
+        REQUIRE(log.update({ { 2U, 20U }, { 3U, 30U }, { 4U, 40U } }));
+        uint32_t base = log.version();
+
+        REQUIRE(log.update({ { 1U, 10U }, { 2U, 21U }, { 3U, 31U }, { 4U, 40U } }));
+        REQUIRE(log.update({ { 1U, 11U }, { 2U, 20U }, { 3U, 32U } }));
+        REQUIRE(log.update({ { 2U, 20U }, { 3U, 33U }, { 5U, 50U } }));
+
+        // key 1 was added and removed again, and key 2 changed back to its original value;
+        // neither is a change for a holder of the base version
+        std::vector<VersionLog::Change> changes;
+        REQUIRE(log.changesSince(base, changes));
+        REQUIRE(changes.size() == 3U);
+
+        REQUIRE(changes[0U].key == 3U);
+        REQUIRE(changes[0U].hadValue);
+        REQUIRE(changes[0U].oldValue == 30U);
+        REQUIRE(changes[0U].hasValue);
+        REQUIRE(changes[0U].newValue == 33U);
+
+        REQUIRE(changes[1U].key == 4U);
+        REQUIRE(changes[1U].hadValue);
+        REQUIRE(changes[1U].oldValue == 40U);
+        REQUIRE(!changes[1U].hasValue);
+
+        REQUIRE(changes[2U].key == 5U);
+        REQUIRE(!changes[2U].hadValue);
+        REQUIRE(changes[2U].hasValue);
+        REQUIRE(changes[2U].newValue == 50U);
+    }
+}
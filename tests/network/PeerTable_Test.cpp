@@ -0,0 +1,199 @@
+/**
+* Digital Voice Modem - Host Software (Test Suite)
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software / Test Suite
+*
+*/
+/*
+*   Copyright (C) 2023 Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#include "Defines.h"
+#include "network/fne/PeerTable.h"
+
+using namespace network::fne;
+
+#include <catch2/catch_test_macros.hpp>
+#include <map>
+#include <stdlib.h>
+#include <time.h>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Finds peer IDs sharing the given home bucket of a table with the initial capacity.
+/// </summary>
+/// <remarks>This mirrors the hash used by PeerTable.</remarks>
+static std::vector<uint32_t> collidingIds(uint32_t bucket, uint32_t count)
+{
+    std::vector<uint32_t> ids;
+    for (uint32_t peerId = 1U; ids.size() < count; peerId++) {
+        uint32_t h = peerId * 0x9E3779B1U;
+        if (((h ^ (h >> 16)) & (PEER_TABLE_INITIAL_CAPACITY - 1U)) == bucket) {
+            ids.push_back(peerId);
+        }
+    }
+
+    return ids;
+}
+
+/// <summary>
+/// Checks the table holds exactly the peers in the given reference map, both by lookup and by iteration.
+/// </summary>
+static bool matches(PeerTable<uint32_t>& table, const std::map<uint32_t, uint32_t>& expected)
+{
+    if (table.size() != expected.size()) {
+        return false;
+    }
+
+    for (auto& entry : expected) {
+        uint32_t* peer = table.find(entry.first);
+        if (peer == nullptr || *peer != entry.second) {
+            return false;
+        }
+    }
+
+    std::map<uint32_t, uint32_t> seen;
+    for (auto entry : table) {
+        if (!seen.insert({ entry.first, entry.second }).second) {
+            return false;
+        }
+    }
+
+    return seen == expected;
+}
+
+TEST_CASE("PeerTable", "[Peer Table Test]") {
+    SECTION("Collision_Test") {
+        INFO("PeerTable colliding peer ID insert/find/erase test");
+
+        // four peers sharing bucket 10, and one homed at bucket 11 that the cluster pushes along
+        std::vector<uint32_t> ids = collidingIds(10U, 4U);
+        ids.push_back(collidingIds(11U, 1U)[0U]);
+
+        PeerTable<uint32_t> table;
+        std::map<uint32_t, uint32_t> expected;
+        for (uint32_t peerId : ids) {
+            table.add(peerId, peerId * 3U);
+            expected[peerId] = peerId * 3U;
+        }
+        REQUIRE(matches(table, expected));
+
+        // erasing from the head of the cluster must shift the rest back so none are lost
+        for (uint32_t peerId : ids) {
+            REQUIRE(table.erase(peerId));
+            REQUIRE(table.find(peerId) == nullptr);
+            expected.erase(peerId);
+            REQUIRE(matches(table, expected));
+        }
+
+        REQUIRE(table.empty());
+        REQUIRE(!table.erase(ids[0U]));
+    }
+
+    SECTION("Backward_Shift_Test") {
+        INFO("PeerTable backward-shift delete in the middle of a cluster test");
+
+        std::vector<uint32_t> ids = collidingIds(63U, 3U);
+        std::vector<uint32_t> wrapped = collidingIds(0U, 2U);
+        ids.insert(ids.end(), wrapped.begin(), wrapped.end());
+
+        PeerTable<uint32_t> table;
+        std::map<uint32_t, uint32_t> expected;
+        for (uint32_t peerId : ids) {
+            table.add(peerId, peerId);
+            expected[peerId] = peerId;
+        }
+
+        // the cluster wraps from the last bucket around to the first; delete from its middle
+        REQUIRE(table.erase(ids[1U]));
+        expected.erase(ids[1U]);
+        REQUIRE(matches(table, expected));
+
+        REQUIRE(table.erase(ids[3U]));
+        expected.erase(ids[3U]);
+        REQUIRE(matches(table, expected));
+
+        // a reinserted peer is found again
+        table.add(ids[1U], 7U);
+        expected[ids[1U]] = 7U;
+        REQUIRE(matches(table, expected));
+    }
+
+    SECTION("Live_Compaction_Test") {
+        INFO("PeerTable live array compaction and slot reuse test");
+
+        PeerTable<uint32_t> table;
+        for (uint32_t peerId = 1U; peerId <= 5U; peerId++) {
+            table.add(peerId, peerId * 10U);
+        }
+
+        uint32_t* last = table.find(5U);
+        uint32_t slot = table.slotOf(3U);
+        uint32_t generation = table.generation();
+
+        // erasing from the middle moves the last live peer into its place, without moving the peer itself
+        REQUIRE(table.erase(3U));
+        REQUIRE(table.generation() != generation);
+        REQUIRE(table.find(5U) == last);
+        REQUIRE(matches(table, { { 1U, 10U }, { 2U, 20U }, { 4U, 40U }, { 5U, 50U } }));
+
+        // the next peer takes the freed slot
+        table.add(6U, 60U);
+        REQUIRE(table.slotOf(6U) == slot);
+        REQUIRE(table.slots() == 5U);
+        REQUIRE(matches(table, { { 1U, 10U }, { 2U, 20U }, { 4U, 40U }, { 5U, 50U }, { 6U, 60U } }));
+
+        // replacing a peer does not change the generation
+        generation = table.generation();
+        table.add(6U, 61U);
+        REQUIRE(table.generation() == generation);
+        REQUIRE(*table.find(6U) == 61U);
+        REQUIRE(table.size() == 5U);
+    }
+
+    SECTION("Random_Test") {
+        INFO("PeerTable random insert/erase against a reference map test");
+
+        srand((unsigned int)time(NULL));
+
+        PeerTable<uint32_t> table;
+        std::map<uint32_t, uint32_t> expected;
+
+        // enough peers to grow the hash several times
+        for (uint32_t i = 0U; i < 4000U; i++) {
+            uint32_t peerId = (uint32_t)(rand() % 600) + 1U;
+            if ((rand() % 3) != 0) {
+                table.add(peerId, i);
+                expected[peerId] = i;
+            }
+            else {
+                REQUIRE(table.erase(peerId) == (expected.erase(peerId) != 0U));
+            }
+        }
+        REQUIRE(matches(table, expected));
+
+        table.clear();
+        expected.clear();
+        REQUIRE(matches(table, expected));
+        REQUIRE(table.find(1U) == nullptr);
+    }
+}
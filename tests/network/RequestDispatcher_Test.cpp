@@ -0,0 +1,245 @@
+/**
+* Digital Voice Modem - Host Software (Test Suite)
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software / Test Suite
+*
+*/
+/*
+*   Copyright (C) 2023 Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#include "Defines.h"
+#include "network/RESTDefines.h"
+#include "network/rest/RequestDispatcher.h"
+
+using namespace network::rest;
+using namespace network::rest::http;
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <map>
+#include <regex>
+#include <string>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+struct TestRoute {
+    const char* expression;
+    bool regex;
+    const char* method;
+};
+
+static const TestRoute ROUTES[] = {
+    { PUT_AUTHENTICATE, false, HTTP_PUT },
+    { GET_VERSION, false, HTTP_GET },
+    { GET_STATUS, false, HTTP_GET },
+    { GET_VOICE_CH, false, HTTP_GET },
+    { PUT_MDM_MODE, false, HTTP_PUT },
+    { PUT_MDM_KILL, false, HTTP_PUT },
+    { PUT_SET_SUPERVISOR, false, HTTP_PUT },
+    { PUT_PERMIT_TG, false, HTTP_PUT },
+    { PUT_GRANT_TG, false, HTTP_PUT },
+    { GET_RELEASE_GRNTS, false, HTTP_GET },
+    { GET_RELEASE_AFFS, false, HTTP_GET },
+    { PUT_RELEASE_TG, false, HTTP_PUT },
+    { PUT_TOUCH_TG, false, HTTP_PUT },
+    { GET_RID_WHITELIST, true, HTTP_GET },
+    { GET_RID_BLACKLIST, true, HTTP_GET },
+    { GET_DMR_BEACON, false, HTTP_GET },
+    { GET_DMR_DEBUG, true, HTTP_GET },
+    { GET_DMR_DUMP_CSBK, true, HTTP_GET },
+    { PUT_DMR_RID, false, HTTP_PUT },
+    { GET_DMR_CC_DEDICATED, false, HTTP_GET },
+    { GET_DMR_CC_BCAST, false, HTTP_GET },
+    { PUT_DMR_TSCC_PAYLOAD_ACT, false, HTTP_PUT },
+    { GET_P25_CC, false, HTTP_GET },
+    { GET_P25_DEBUG, true, HTTP_GET },
+    { GET_P25_DUMP_TSBK, true, HTTP_GET },
+    { PUT_P25_RID, false, HTTP_PUT },
+    { GET_P25_CC_DEDICATED, false, HTTP_GET },
+    { GET_P25_CC_BCAST, false, HTTP_GET },
+    { PUT_P25_RAW_TSBK, false, HTTP_PUT },
+    { GET_NXDN_CC, false, HTTP_GET },
+    { GET_NXDN_DEBUG, true, HTTP_GET },
+    { GET_NXDN_DUMP_RCCH, true, HTTP_GET },
+    { GET_NXDN_CC_DEDICATED, false, HTTP_GET },
+};
+
+static const uint32_t ROUTE_COUNT = sizeof(ROUTES) / sizeof(TestRoute);
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Registers the host REST API routes; each handler records the route it was dispatched to.
+/// </summary>
+static void initializeRoutes(RequestDispatcher<HTTPPayload, HTTPPayload>& dispatcher, std::string& routed, std::vector<std::string>& params)
+{
+    for (uint32_t i = 0U; i < ROUTE_COUNT; i++) {
+        std::string expression = ROUTES[i].expression;
+        auto handler = [&routed, &params, expression](const HTTPPayload& request, HTTPPayload& reply, const RequestMatch& match) {
+            routed = expression;
+            params.clear();
+            for (size_t n = 1U; n < match.size(); n++)
+                params.push_back(match.str(n));
+        };
+
+        if (::strcmp(ROUTES[i].method, HTTP_GET) == 0)
+            dispatcher.match(expression, ROUTES[i].regex).get(handler);
+        else
+            dispatcher.match(expression, ROUTES[i].regex).put(handler);
+    }
+}
+
+/// <summary>
+/// Reference dispatch; the linear matcher walk the route table replaced.
+/// </summary>
+static std::string legacyDispatch(const std::map<std::string, bool>& matchers, const std::string& uri)
+{
+    for (const auto& matcher : matchers) {
+        std::smatch what;
+        if (!matcher.second) {
+            if (uri.find(matcher.first) != std::string::npos)
+                return matcher.first;
+        } else {
+            if (std::regex_match(uri, what, std::regex(matcher.first)))
+                return matcher.first;
+        }
+    }
+
+    return std::string();
+}
+
+TEST_CASE("RequestDispatcher", "[REST Dispatcher Test]") {
+    SECTION("Routes") {
+        bool failed = false;
+
+        RequestDispatcher<HTTPPayload, HTTPPayload> dispatcher;
+        std::string routed;
+        std::vector<std::string> params;
+        initializeRoutes(dispatcher, routed, params);
+
+        // the dispatcher is copied into the HTTP server, the copy must route identically
+        RequestDispatcher<HTTPPayload, HTTPPayload> copy = dispatcher;
+
+        struct {
+            const char* method;
+            const char* uri;
+            const char* expected;
+            std::vector<std::string> params;
+        } cases[] = {
+            { HTTP_GET, "/version", GET_VERSION, { } },
+            { HTTP_GET, "/status?detail=1", GET_STATUS, { } },
+            { HTTP_GET, "/p25/cc", GET_P25_CC, { } },
+            { HTTP_GET, "/p25/cc-enable", GET_P25_CC_DEDICATED, { } },
+            { HTTP_GET, "/dmr/cc-broadcast", GET_DMR_CC_BCAST, { } },
+            { HTTP_GET, "/rid-whitelist/1234567", GET_RID_WHITELIST, { "1234567" } },
+            { HTTP_GET, "/dmr/debug/1/0", GET_DMR_DEBUG, { "1", "0" } },
+            { HTTP_GET, "/p25/dump-tsbk/1", GET_P25_DUMP_TSBK, { "1" } },
+            { HTTP_GET, "/nxdn/debug/0/1", GET_NXDN_DEBUG, { "0", "1" } },
+            { HTTP_GET, "/dmr/debug/a/0", "", { } },
+            { HTTP_GET, "/dmr/debug/1", "", { } },
+            { HTTP_GET, "/dmr/debug/1/0/2", "", { } },
+            { HTTP_GET, "/unknown", "", { } },
+        };
+
+        for (auto& c : cases) {
+            for (RequestDispatcher<HTTPPayload, HTTPPayload>* d : { &dispatcher, &copy }) {
+                HTTPPayload request = HTTPPayload::requestPayload(c.method, c.uri);
+                HTTPPayload reply = HTTPPayload::statusPayload(HTTPPayload::OK);
+                routed.clear();
+                params.clear();
+
+                d->handleRequest(request, reply);
+                if (routed != c.expected || params != c.params) {
+                    ::LogDebug("T", "RequestDispatcher, uri = %s, routed = %s, expected = %s", c.uri, routed.c_str(), c.expected);
+                    failed = true;
+                }
+
+                if (routed.empty() && reply.status != HTTPPayload::BAD_REQUEST) {
+                    ::LogDebug("T", "RequestDispatcher, uri = %s, unknown endpoint not rejected", c.uri);
+                    failed = true;
+                }
+            }
+        }
+
+        // an expression outside the trie segment forms falls back to a precompiled regex
+        dispatcher.match("/tg/([a-z]+)-(\\d+)", true).get([&](const HTTPPayload& request, HTTPPayload& reply, const RequestMatch& match) {
+            routed = "tg";
+            params.clear();
+            for (size_t n = 1U; n < match.size(); n++)
+                params.push_back(match.str(n));
+        });
+
+        HTTPPayload request = HTTPPayload::requestPayload(HTTP_GET, "/tg/alpha-9");
+        HTTPPayload reply = HTTPPayload::statusPayload(HTTPPayload::OK);
+        dispatcher.handleRequest(request, reply);
+        if (routed != "tg" || params != std::vector<std::string>({ "alpha", "9" })) {
+            ::LogDebug("T", "RequestDispatcher, fallback regex route not matched");
+            failed = true;
+        }
+
+        REQUIRE(failed==false);
+    }
+}
+
+TEST_CASE("RequestDispatcherBenchmark", "[.][REST Dispatcher Benchmark]") {
+    const uint32_t iterations = 200000U;
+    const char* uris[] = { "/status", "/voice-ch", "/p25/cc-enable", "/rid-whitelist/1234567", "/dmr/debug/1/0", "/p25/dump-tsbk/1", "/nxdn/cc-enable" };
+    const uint32_t uriCount = sizeof(uris) / sizeof(char*);
+
+    std::map<std::string, bool> legacy;
+    for (uint32_t i = 0U; i < ROUTE_COUNT; i++)
+        legacy[ROUTES[i].expression] = ROUTES[i].regex;
+
+    RequestDispatcher<HTTPPayload, HTTPPayload> dispatcher;
+    std::string routed;
+    std::vector<std::string> params;
+    initializeRoutes(dispatcher, routed, params);
+
+    std::vector<HTTPPayload> requests;
+    for (uint32_t i = 0U; i < uriCount; i++)
+        requests.push_back(HTTPPayload::requestPayload(HTTP_GET, uris[i]));
+
+    uint32_t matched = 0U;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0U; i < iterations / 10U; i++) {
+        if (!legacyDispatch(legacy, uris[i % uriCount]).empty())
+            matched++;
+    }
+    double legacyTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0U; i < iterations; i++) {
+        HTTPPayload reply;
+        dispatcher.handleRequest(requests[i % uriCount], reply);
+        if (!routed.empty())
+            matched++;
+    }
+    double trieTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double legacyRate = (iterations / 10U) / legacyTime;
+    double trieRate = iterations / trieTime;
+    ::LogMessage("T", "REST dispatch, linear/regex = %.0f req/s, route table = %.0f req/s", legacyRate, trieRate);
+
+    REQUIRE(matched > 0U);
+}
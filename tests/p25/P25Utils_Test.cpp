@@ -0,0 +1,331 @@
+/**
+* Digital Voice Modem - Host Software (Test Suite)
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Host Software / Test Suite
+*
+*/
+/*
+*   Copyright (C) 2023 Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#include "Defines.h"
+#include "p25/P25Defines.h"
+#include "p25/P25Utils.h"
+#include "Log.h"
+#include "Utils.h"
+
+using namespace p25;
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t BENCHMARK_ITERATIONS = 20000U;
+
+// IMBE voice frame positions within a LDU
+const uint32_t LDU_IMBE_POSITIONS[][2U] = {
+    { 114U, 262U }, { 262U, 410U }, { 452U, 600U }, { 640U, 788U }, { 830U, 978U },
+    { 1020U, 1168U }, { 1208U, 1356U }, { 1398U, 1546U }, { 1578U, 1726U }
+};
+
+typedef uint32_t (*InterleaveFn)(const uint8_t* in, uint8_t* out, uint32_t start, uint32_t stop);
+
+// results are accumulated here so the compiler cannot elide the benchmarked calls
+static volatile uint32_t g_benchmarkSink = 0U;
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Reference bit-by-bit status symbol deinterleave.
+/// </summary>
+static uint32_t referenceDecode(const uint8_t* in, uint8_t* out, uint32_t start, uint32_t stop)
+{
+    uint32_t ss0Pos = P25_SS0_START;
+    uint32_t ss1Pos = P25_SS1_START;
+
+    while (ss0Pos < start) {
+        ss0Pos += P25_SS_INCREMENT;
+        ss1Pos += P25_SS_INCREMENT;
+    }
+
+    uint32_t n = 0U;
+    for (uint32_t i = start; i < stop; i++) {
+        if (i == ss0Pos) {
+            ss0Pos += P25_SS_INCREMENT;
+        }
+        else if (i == ss1Pos) {
+            ss1Pos += P25_SS_INCREMENT;
+        }
+        else {
+            bool b = READ_BIT(in, i);
+            WRITE_BIT(out, n, b);
+            n++;
+        }
+    }
+
+    return n;
+}
+
+/// <summary>
+/// Reference bit-by-bit status symbol interleave.
+/// </summary>
+static uint32_t referenceEncode(const uint8_t* in, uint8_t* out, uint32_t start, uint32_t stop)
+{
+    uint32_t ss0Pos = P25_SS0_START;
+    uint32_t ss1Pos = P25_SS1_START;
+
+    while (ss0Pos < start) {
+        ss0Pos += P25_SS_INCREMENT;
+        ss1Pos += P25_SS_INCREMENT;
+    }
+
+    uint32_t n = 0U;
+    for (uint32_t i = start; i < stop; i++) {
+        if (i == ss0Pos) {
+            ss0Pos += P25_SS_INCREMENT;
+        }
+        else if (i == ss1Pos) {
+            ss1Pos += P25_SS_INCREMENT;
+        }
+        else {
+            bool b = READ_BIT(in, n);
+            WRITE_BIT(out, i, b);
+            n++;
+        }
+    }
+
+    return n;
+}
+
+/// <summary>
+/// Reference bit-by-bit status symbol interleave for a given length.
+/// </summary>
+static uint32_t referenceEncode(const uint8_t* in, uint8_t* out, uint32_t length)
+{
+    uint32_t ss0Pos = P25_SS0_START;
+    uint32_t ss1Pos = P25_SS1_START;
+
+    uint32_t n = 0U;
+    uint32_t pos = 0U;
+    while (n < length) {
+        if (pos == ss0Pos) {
+            ss0Pos += P25_SS_INCREMENT;
+        }
+        else if (pos == ss1Pos) {
+            ss1Pos += P25_SS_INCREMENT;
+        }
+        else {
+            bool b = READ_BIT(in, n);
+            WRITE_BIT(out, pos, b);
+            n++;
+        }
+        pos++;
+    }
+
+    return pos;
+}
+
+/// <summary>
+/// Reference bit-by-bit busy status bit insertion.
+/// </summary>
+static void referenceAddBusyBits(uint8_t* data, uint32_t length, bool b1, bool b2)
+{
+    for (uint32_t ss0Pos = P25_SS0_START; ss0Pos < length; ss0Pos += P25_SS_INCREMENT) {
+        WRITE_BIT(data, ss0Pos, true);
+        WRITE_BIT(data, ss0Pos + 1U, false);
+    }
+
+    for (uint32_t ss0Pos = P25_SS0_START; ss0Pos < length; ss0Pos += (P25_SS_INCREMENT * 2)) {
+        WRITE_BIT(data, ss0Pos, b1);
+        WRITE_BIT(data, ss0Pos + 1U, b2);
+    }
+}
+
+/// <summary>
+/// Fills a buffer with random data.
+/// </summary>
+static void fillRandom(uint8_t* buffer, uint32_t length)
+{
+    for (uint32_t i = 0U; i < length; i++) {
+        buffer[i] = rand();
+    }
+}
+
+TEST_CASE("P25Utils", "[Status Symbol Interleave Test]") {
+    SECTION("Decode_CrossCheck_Test") {
+        bool failed = false;
+
+        INFO("P25Utils Status Symbol Deinterleave Cross-Check Test");
+
+        srand((unsigned int)time(NULL));
+
+        uint8_t frame[P25_LDU_FRAME_LENGTH_BYTES];
+        uint8_t expected[P25_LDU_FRAME_LENGTH_BYTES];
+        uint8_t actual[P25_LDU_FRAME_LENGTH_BYTES];
+
+        // every start/stop pair around the first few status symbols, then whole frames
+        for (uint32_t start = 0U; start < 300U && !failed; start++) {
+            for (uint32_t stop = start; stop < start + 300U; stop += 7U) {
+                fillRandom(frame, P25_LDU_FRAME_LENGTH_BYTES);
+                fillRandom(expected, P25_LDU_FRAME_LENGTH_BYTES);
+                ::memcpy(actual, expected, P25_LDU_FRAME_LENGTH_BYTES);
+
+                uint32_t n1 = referenceDecode(frame, expected, start, stop);
+                uint32_t n2 = P25Utils::decode(frame, actual, start, stop);
+                if (n1 != n2 || ::memcmp(expected, actual, P25_LDU_FRAME_LENGTH_BYTES) != 0) {
+                    ::LogDebug("T", "Decode_CrossCheck_Test, failed decode cross-check, start = %u, stop = %u", start, stop);
+                    failed = true;
+                    break;
+                }
+            }
+        }
+
+        fillRandom(frame, P25_LDU_FRAME_LENGTH_BYTES);
+        ::memset(expected, 0x00U, P25_LDU_FRAME_LENGTH_BYTES);
+        ::memset(actual, 0x00U, P25_LDU_FRAME_LENGTH_BYTES);
+        if (referenceDecode(frame, expected, 0U, P25_LDU_FRAME_LENGTH_BITS) != P25Utils::decode(frame, actual, 0U, P25_LDU_FRAME_LENGTH_BITS) ||
+            ::memcmp(expected, actual, P25_LDU_FRAME_LENGTH_BYTES) != 0) {
+            ::LogDebug("T", "Decode_CrossCheck_Test, failed full frame decode cross-check");
+            failed = true;
+        }
+
+        REQUIRE(failed==false);
+    }
+
+    SECTION("Encode_CrossCheck_Test") {
+        bool failed = false;
+
+        INFO("P25Utils Status Symbol Interleave Cross-Check Test");
+
+        srand((unsigned int)time(NULL));
+
+        uint8_t data[P25_LDU_FRAME_LENGTH_BYTES];
+        uint8_t expected[P25_LDU_FRAME_LENGTH_BYTES];
+        uint8_t actual[P25_LDU_FRAME_LENGTH_BYTES];
+
+        // the status symbols already in the output must be preserved
+        for (uint32_t start = 0U; start < 300U && !failed; start++) {
+            for (uint32_t stop = start; stop < start + 300U; stop += 7U) {
+                fillRandom(data, P25_LDU_FRAME_LENGTH_BYTES);
+                fillRandom(expected, P25_LDU_FRAME_LENGTH_BYTES);
+                ::memcpy(actual, expected, P25_LDU_FRAME_LENGTH_BYTES);
+
+                uint32_t n1 = referenceEncode(data, expected, start, stop);
+                uint32_t n2 = P25Utils::encode(data, actual, start, stop);
+                if (n1 != n2 || ::memcmp(expected, actual, P25_LDU_FRAME_LENGTH_BYTES) != 0) {
+                    ::LogDebug("T", "Encode_CrossCheck_Test, failed encode cross-check, start = %u, stop = %u", start, stop);
+                    failed = true;
+                    break;
+                }
+            }
+        }
+
+        for (uint32_t length = 0U; length <= P25_TSDU_FRAME_LENGTH_BITS && !failed; length++) {
+            fillRandom(data, P25_LDU_FRAME_LENGTH_BYTES);
+            fillRandom(expected, P25_LDU_FRAME_LENGTH_BYTES);
+            ::memcpy(actual, expected, P25_LDU_FRAME_LENGTH_BYTES);
+
+            uint32_t n1 = referenceEncode(data, expected, length);
+            uint32_t n2 = P25Utils::encode(data, actual, length);
+            if (n1 != n2 || ::memcmp(expected, actual, P25_LDU_FRAME_LENGTH_BYTES) != 0) {
+                ::LogDebug("T", "Encode_CrossCheck_Test, failed encode cross-check, length = %u", length);
+                failed = true;
+            }
+        }
+
+        REQUIRE(failed==false);
+    }
+
+    SECTION("BusyBits_CrossCheck_Test") {
+        bool failed = false;
+
+        INFO("P25Utils Busy Status Bits Cross-Check Test");
+
+        srand((unsigned int)time(NULL));
+
+        uint8_t expected[P25_LDU_FRAME_LENGTH_BYTES];
+        uint8_t actual[P25_LDU_FRAME_LENGTH_BYTES];
+
+        for (uint32_t length = 0U; length < P25_LDU_FRAME_LENGTH_BITS && !failed; length++) {
+            bool b1 = (rand() & 1) != 0;
+            bool b2 = (rand() & 1) != 0;
+
+            fillRandom(expected, P25_LDU_FRAME_LENGTH_BYTES);
+            ::memcpy(actual, expected, P25_LDU_FRAME_LENGTH_BYTES);
+
+            referenceAddBusyBits(expected, length, b1, b2);
+            P25Utils::addBusyBits(actual, length, b1, b2);
+            if (::memcmp(expected, actual, P25_LDU_FRAME_LENGTH_BYTES) != 0) {
+                ::LogDebug("T", "BusyBits_CrossCheck_Test, failed busy bits cross-check, length = %u", length);
+                failed = true;
+            }
+        }
+
+        REQUIRE(failed==false);
+    }
+}
+
+// the benchmark is hidden; run it explicitly with: dvmtests "[P25Utils Benchmark]" -s
+TEST_CASE("P25Utils", "[.][P25Utils Benchmark]") {
+    SECTION("LDU_Benchmark") {
+        INFO("P25Utils LDU Interleave Benchmark");
+
+        srand((unsigned int)time(NULL));
+
+        uint8_t ldu[P25_LDU_FRAME_LENGTH_BYTES];
+        fillRandom(ldu, P25_LDU_FRAME_LENGTH_BYTES);
+        uint8_t raw[P25_LDU_FRAME_LENGTH_BYTES];
+        uint8_t imbe[18U];
+
+        // deinterleave and re-interleave the 9 IMBE frames of a LDU, as the voice path does,
+        // then deinterleave the whole frame
+        auto runLDU = [&](InterleaveFn dec, InterleaveFn enc) {
+            uint32_t sink = 0U;
+            auto start = std::chrono::steady_clock::now();
+            for (uint32_t n = 0U; n < BENCHMARK_ITERATIONS; n++) {
+                for (uint32_t i = 0U; i < 9U; i++) {
+                    sink += dec(ldu, imbe, LDU_IMBE_POSITIONS[i][0U], LDU_IMBE_POSITIONS[i][1U]);
+                    sink += enc(imbe, ldu, LDU_IMBE_POSITIONS[i][0U], LDU_IMBE_POSITIONS[i][1U]);
+                }
+
+                sink += dec(ldu, raw, 0U, P25_LDU_FRAME_LENGTH_BITS);
+            }
+            auto end = std::chrono::steady_clock::now();
+
+            g_benchmarkSink = g_benchmarkSink + sink;
+            return std::chrono::duration<double>(end - start).count() * 1000000000.0 / BENCHMARK_ITERATIONS;
+        };
+
+        double fast = runLDU(&P25Utils::decode, static_cast<InterleaveFn>(&P25Utils::encode));
+        double slow = runLDU(&referenceDecode, static_cast<InterleaveFn>(&referenceEncode));
+
+        ::LogMessage("T", "LDU interleave (word-parallel) %8.1f ns/LDU", fast);
+        ::LogMessage("T", "LDU interleave (bit-by-bit)    %8.1f ns/LDU", slow);
+        ::LogMessage("T", "LDU interleave speedup: %.1fx", slow / fast);
+
+        REQUIRE(true);
+    }
+}